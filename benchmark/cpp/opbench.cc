@@ -0,0 +1,193 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2019 by Contributors
+ * \file opbench.cc
+ * \brief native microbenchmark harness for registered operators
+ *
+ *  Drives individual operators through Imperative::Invoke with
+ *  WaitToRead fencing per iteration, so the numbers are per-op
+ *  latencies rather than engine queueing artifacts. Build with
+ *  BUILD_OPERATOR_BENCHMARKS=ON.
+ *
+ *  Usage: mxnet_opbench [--gpu <id>] [--warmup N] [--iters N] [filter]
+ *  where filter is a substring matched against the benchmark name.
+ */
+#include <mxnet/base.h>
+#include <mxnet/engine.h>
+#include <mxnet/imperative.h>
+#include <mxnet/ndarray.h>
+#include <nnvm/op.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+  mxnet::Context ctx = mxnet::Context::CPU();
+  int warmup = 10;
+  int iters = 100;
+  std::string filter;
+};
+
+/*! \brief fill an ndarray with a small ramp so reductions don't overflow */
+void FillRamp(mxnet::NDArray *arr) {
+  const size_t size = arr->shape().Size();
+  std::vector<float> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<float>(i % 16) * 0.25f;
+  }
+  arr->SyncCopyFromCPU(data.data(), size);
+}
+
+/*!
+ * \brief Run one benchmark case and print its timing line.
+ * \param opts harness options (context, warmup/iteration counts, filter)
+ * \param bench_name name printed for the case and matched by the filter
+ * \param op_name registered operator name
+ * \param params operator parameters, as the frontends would pass them
+ * \param in_shapes shapes of the float32 inputs
+ * \param flops floating point operations per invocation, 0 if the op is
+ *              pure data movement
+ */
+void RunCase(const Options &opts,
+             const std::string &bench_name,
+             const std::string &op_name,
+             const std::map<std::string, std::string> &params,
+             const std::vector<mxnet::TShape> &in_shapes,
+             double flops) {
+  if (!opts.filter.empty() && bench_name.find(opts.filter) == std::string::npos) {
+    return;
+  }
+  const nnvm::Op *op = nnvm::Op::Get(op_name);
+  nnvm::NodeAttrs attrs;
+  attrs.op = op;
+  for (const auto &kv : params) {
+    attrs.dict[kv.first] = kv.second;
+  }
+  if (op->attr_parser) {
+    op->attr_parser(&attrs);
+  }
+
+  std::vector<mxnet::NDArray> in_arrays;
+  in_arrays.reserve(in_shapes.size());
+  for (const mxnet::TShape &shape : in_shapes) {
+    in_arrays.emplace_back(shape, opts.ctx);
+    FillRamp(&in_arrays.back());
+  }
+  std::vector<mxnet::NDArray*> inputs;
+  for (mxnet::NDArray &arr : in_arrays) {
+    inputs.push_back(&arr);
+  }
+  const int num_outputs = op->num_outputs;  // benchmarked ops have static counts
+  std::vector<mxnet::NDArray> out_arrays(num_outputs);
+  std::vector<mxnet::NDArray*> outputs;
+  for (mxnet::NDArray &arr : out_arrays) {
+    outputs.push_back(&arr);
+  }
+
+  mxnet::Imperative *imperative = mxnet::Imperative::Get();
+  for (int i = 0; i < opts.warmup; ++i) {
+    imperative->Invoke(opts.ctx, attrs, inputs, outputs);
+    for (mxnet::NDArray *out : outputs) {
+      out->WaitToRead();
+    }
+  }
+
+  const auto start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < opts.iters; ++i) {
+    imperative->Invoke(opts.ctx, attrs, inputs, outputs);
+    for (mxnet::NDArray *out : outputs) {
+      out->WaitToRead();
+    }
+  }
+  const auto stop = std::chrono::high_resolution_clock::now();
+  const double seconds_per_iter =
+      std::chrono::duration<double>(stop - start).count() / opts.iters;
+
+  // every input is read once and every output written once
+  size_t bytes = 0;
+  for (const mxnet::NDArray *arr : inputs) {
+    bytes += arr->shape().Size() * mshadow::mshadow_sizeof(arr->dtype());
+  }
+  for (const mxnet::NDArray *arr : outputs) {
+    bytes += arr->shape().Size() * mshadow::mshadow_sizeof(arr->dtype());
+  }
+
+  std::printf("%-40s %10.2f us", bench_name.c_str(), seconds_per_iter * 1e6);
+  if (flops > 0) {
+    std::printf(" %10.2f GFLOP/s", flops / seconds_per_iter * 1e-9);
+  } else {
+    std::printf(" %18s", "-");
+  }
+  std::printf(" %10.2f GB/s\n", bytes / seconds_per_iter * 1e-9);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  Options opts;
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "--gpu") && i + 1 < argc) {
+      opts.ctx = mxnet::Context::GPU(std::atoi(argv[++i]));
+    } else if (!std::strcmp(argv[i], "--warmup") && i + 1 < argc) {
+      opts.warmup = std::atoi(argv[++i]);
+    } else if (!std::strcmp(argv[i], "--iters") && i + 1 < argc) {
+      opts.iters = std::atoi(argv[++i]);
+    } else {
+      opts.filter = argv[i];
+    }
+  }
+  std::printf("%-40s %13s %18s %13s\n", "benchmark", "time/iter", "compute", "bandwidth");
+
+  using mxnet::TShape;
+  RunCase(opts, "broadcast_add/512x512x64+512x1x64", "broadcast_add", {},
+          {TShape({512, 512, 64}), TShape({512, 1, 64})},
+          512. * 512 * 64);
+  RunCase(opts, "broadcast_mul/64x1024x32+64x1024x1", "broadcast_mul", {},
+          {TShape({64, 1024, 32}), TShape({64, 1024, 1})},
+          64. * 1024 * 32);
+  RunCase(opts, "sum/axis1/64x512x512", "sum", {{"axis", "1"}},
+          {TShape({64, 512, 512})},
+          64. * 512 * 512);
+  RunCase(opts, "sum/all/16777216", "sum", {},
+          {TShape({16777216})},
+          16777216.);
+  RunCase(opts, "transpose/256x512x64", "transpose", {},
+          {TShape({256, 512, 64})},
+          0);
+  RunCase(opts, "transpose/axes021/256x512x64", "transpose", {{"axes", "(0, 2, 1)"}},
+          {TShape({256, 512, 64})},
+          0);
+  RunCase(opts, "dot/1024x1024x1024", "dot", {},
+          {TShape({1024, 1024}), TShape({1024, 1024})},
+          2. * 1024 * 1024 * 1024);
+  RunCase(opts, "relu/16777216", "relu", {},
+          {TShape({16777216})},
+          0);
+
+  mxnet::Engine::Get()->WaitForAll();
+  return 0;
+}
@@ -0,0 +1,271 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2019 by Contributors
+ * \file predict_latency.cc
+ * \brief end-to-end inference latency benchmark over the C predict API
+ *
+ *  Loads a symbol + params checkpoint, replays requests at a
+ *  configurable aggregate arrival rate from multiple threads (each
+ *  thread owns its predictor), and reports percentile latencies and
+ *  throughput. With a rate set, the harness runs open-loop: latency is
+ *  measured from the scheduled arrival, so queueing delay under
+ *  overload is visible in the tail. Build with
+ *  BUILD_OPERATOR_BENCHMARKS=ON.
+ *
+ *  Usage: mxnet_predict_latency --symbol model-symbol.json
+ *         --params model-0000.params [--shape 1,3,224,224]...
+ *         [--threads N] [--rate req/s] [--requests N] [--gpu <id>]
+ */
+#include <mxnet/c_predict_api.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+struct Options {
+  std::string symbol_file;
+  std::string params_file;
+  std::vector<std::vector<mx_uint>> shapes;
+  int threads = 1;
+  double rate = 0;        // aggregate requests/s, 0 = closed loop
+  int requests = 1000;    // total across all threads
+  int warmup = 20;        // per thread, not measured
+  int dev_type = 1;       // 1 = cpu, 2 = gpu
+  int dev_id = 0;
+};
+
+bool ReadFile(const std::string &path, std::string *out) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) return false;
+  std::ostringstream ss;
+  ss << file.rdbuf();
+  *out = ss.str();
+  return true;
+}
+
+std::vector<mx_uint> ParseShape(const char *str) {
+  std::vector<mx_uint> shape;
+  std::stringstream ss(str);
+  std::string dim;
+  while (std::getline(ss, dim, ',')) {
+    shape.push_back(static_cast<mx_uint>(std::atoi(dim.c_str())));
+  }
+  return shape;
+}
+
+size_t ShapeSize(const std::vector<mx_uint> &shape) {
+  size_t size = 1;
+  for (mx_uint dim : shape) size *= dim;
+  return size;
+}
+
+PredictorHandle CreatePredictor(const Options &opts,
+                                const std::string &symbol_json,
+                                const std::string &param_bytes,
+                                const std::vector<mx_uint> &shape) {
+  const char *input_key = "data";
+  std::vector<mx_uint> indptr = {0, static_cast<mx_uint>(shape.size())};
+  PredictorHandle handle = nullptr;
+  if (MXPredCreate(symbol_json.c_str(),
+                   param_bytes.data(),
+                   static_cast<int>(param_bytes.size()),
+                   opts.dev_type, opts.dev_id,
+                   1, &input_key,
+                   indptr.data(), shape.data(),
+                   &handle) != 0) {
+    std::fprintf(stderr, "MXPredCreate failed: %s\n", MXGetLastError());
+    std::exit(1);
+  }
+  return handle;
+}
+
+/*!
+ * \brief Worker: replays its share of the requests and records latencies.
+ *
+ *  Request shapes rotate through the configured list; a shape change is
+ *  served with MXPredReshape, which deployments sending mixed batch
+ *  sizes hit on their hot path too.
+ */
+void Worker(const Options &opts,
+            const std::string &symbol_json,
+            const std::string &param_bytes,
+            int num_requests,
+            Clock::time_point start_time,
+            std::vector<double> *latencies_ms) {
+  PredictorHandle handle =
+      CreatePredictor(opts, symbol_json, param_bytes, opts.shapes.front());
+  size_t cur_shape = 0;
+  std::vector<float> input(ShapeSize(opts.shapes.front()), 0.5f);
+  std::vector<float> output;
+
+  auto run_once = [&](size_t shape_idx) {
+    const std::vector<mx_uint> &shape = opts.shapes[shape_idx];
+    if (shape_idx != cur_shape) {
+      const char *input_key = "data";
+      std::vector<mx_uint> indptr = {0, static_cast<mx_uint>(shape.size())};
+      PredictorHandle reshaped = nullptr;
+      if (MXPredReshape(1, &input_key, indptr.data(), shape.data(),
+                        handle, &reshaped) != 0) {
+        std::fprintf(stderr, "MXPredReshape failed: %s\n", MXGetLastError());
+        std::exit(1);
+      }
+      MXPredFree(handle);
+      handle = reshaped;
+      cur_shape = shape_idx;
+      input.resize(ShapeSize(shape), 0.5f);
+    }
+    MXPredSetInput(handle, "data", input.data(), static_cast<mx_uint>(input.size()));
+    MXPredForward(handle);
+    mx_uint *out_shape = nullptr;
+    mx_uint out_dim = 0;
+    MXPredGetOutputShape(handle, 0, &out_shape, &out_dim);
+    size_t out_size = 1;
+    for (mx_uint i = 0; i < out_dim; ++i) out_size *= out_shape[i];
+    output.resize(out_size);
+    // GetOutput synchronizes, so the request is complete when it returns
+    MXPredGetOutput(handle, 0, output.data(), static_cast<mx_uint>(out_size));
+  };
+
+  for (int i = 0; i < opts.warmup; ++i) {
+    run_once(i % opts.shapes.size());
+  }
+
+  // with a rate, requests are scheduled at fixed aggregate intervals
+  // spread over the threads; latency counts from the scheduled arrival
+  const double interval_s =
+      opts.rate > 0 ? opts.threads / opts.rate : 0;
+  latencies_ms->reserve(num_requests);
+  for (int i = 0; i < num_requests; ++i) {
+    Clock::time_point arrival = Clock::now();
+    if (interval_s > 0) {
+      arrival = start_time + std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(i * interval_s));
+      std::this_thread::sleep_until(arrival);
+    }
+    run_once(i % opts.shapes.size());
+    latencies_ms->push_back(
+        std::chrono::duration<double, std::milli>(Clock::now() - arrival).count());
+  }
+  MXPredFree(handle);
+}
+
+double Percentile(const std::vector<double> &sorted, double p) {
+  const size_t idx = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+  return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  Options opts;
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "--symbol") && i + 1 < argc) {
+      opts.symbol_file = argv[++i];
+    } else if (!std::strcmp(argv[i], "--params") && i + 1 < argc) {
+      opts.params_file = argv[++i];
+    } else if (!std::strcmp(argv[i], "--shape") && i + 1 < argc) {
+      opts.shapes.push_back(ParseShape(argv[++i]));
+    } else if (!std::strcmp(argv[i], "--threads") && i + 1 < argc) {
+      opts.threads = std::atoi(argv[++i]);
+    } else if (!std::strcmp(argv[i], "--rate") && i + 1 < argc) {
+      opts.rate = std::atof(argv[++i]);
+    } else if (!std::strcmp(argv[i], "--requests") && i + 1 < argc) {
+      opts.requests = std::atoi(argv[++i]);
+    } else if (!std::strcmp(argv[i], "--warmup") && i + 1 < argc) {
+      opts.warmup = std::atoi(argv[++i]);
+    } else if (!std::strcmp(argv[i], "--gpu") && i + 1 < argc) {
+      opts.dev_type = 2;
+      opts.dev_id = std::atoi(argv[++i]);
+    } else {
+      std::fprintf(stderr, "unknown argument: %s\n", argv[i]);
+      return 1;
+    }
+  }
+  if (opts.symbol_file.empty() || opts.params_file.empty()) {
+    std::fprintf(stderr,
+                 "usage: mxnet_predict_latency --symbol <json> --params <params> "
+                 "[--shape d0,d1,...]... [--threads N] [--rate req/s] "
+                 "[--requests N] [--gpu <id>]\n");
+    return 1;
+  }
+  if (opts.shapes.empty()) {
+    opts.shapes.push_back({1, 3, 224, 224});
+  }
+
+  std::string symbol_json, param_bytes;
+  if (!ReadFile(opts.symbol_file, &symbol_json)) {
+    std::fprintf(stderr, "cannot read %s\n", opts.symbol_file.c_str());
+    return 1;
+  }
+  if (!ReadFile(opts.params_file, &param_bytes)) {
+    std::fprintf(stderr, "cannot read %s\n", opts.params_file.c_str());
+    return 1;
+  }
+
+  std::vector<std::vector<double>> latencies(opts.threads);
+  std::vector<std::thread> threads;
+  const int per_thread = opts.requests / opts.threads;
+  const Clock::time_point start_time =
+      Clock::now() + std::chrono::milliseconds(100);  // let all threads arm
+  const auto bench_start = Clock::now();
+  for (int t = 0; t < opts.threads; ++t) {
+    threads.emplace_back(Worker, std::cref(opts), std::cref(symbol_json),
+                         std::cref(param_bytes), per_thread, start_time,
+                         &latencies[t]);
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  const double elapsed_s =
+      std::chrono::duration<double>(Clock::now() - bench_start).count();
+
+  std::vector<double> all;
+  for (const std::vector<double> &lat : latencies) {
+    all.insert(all.end(), lat.begin(), lat.end());
+  }
+  if (all.empty()) {
+    std::fprintf(stderr, "no requests completed\n");
+    return 1;
+  }
+  std::sort(all.begin(), all.end());
+  double sum = 0;
+  for (double lat : all) sum += lat;
+
+  std::printf("requests:   %zu over %d thread(s)\n", all.size(), opts.threads);
+  std::printf("throughput: %.1f req/s\n", all.size() / elapsed_s);
+  std::printf("mean:       %.3f ms\n", sum / all.size());
+  std::printf("p50:        %.3f ms\n", Percentile(all, 0.50));
+  std::printf("p90:        %.3f ms\n", Percentile(all, 0.90));
+  std::printf("p99:        %.3f ms\n", Percentile(all, 0.99));
+  std::printf("p999:       %.3f ms\n", Percentile(all, 0.999));
+  std::printf("max:        %.3f ms\n", all.back());
+  return 0;
+}
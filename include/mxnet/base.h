@@ -70,6 +70,26 @@
 #define MXNET_PREDICT_ONLY 0
 #endif
 
+/*!
+ * \brief whether to keep per-call validation checks on the imperative
+ *  hot path (TBlob accessors and the like). These re-verify device,
+ *  dtype and shape invariants that shape/dtype inference has already
+ *  established before a kernel runs; building with
+ *  USE_HOTPATH_CHECKS=0 compiles them out. Checks guarding genuinely
+ *  external input stay unconditional.
+ */
+#ifndef MXNET_HOTPATH_CHECKS
+#define MXNET_HOTPATH_CHECKS 1
+#endif
+
+#if MXNET_HOTPATH_CHECKS
+#define MXNET_HOT_CHECK CHECK
+#define MXNET_HOT_CHECK_EQ CHECK_EQ
+#else
+#define MXNET_HOT_CHECK(x) while (false) CHECK(x)
+#define MXNET_HOT_CHECK_EQ(x, y) while (false) CHECK_EQ(x, y)
+#endif
+
 /*! \brief major version */
 #define MXNET_MAJOR 1
 /*! \brief minor version */
@@ -108,6 +108,8 @@ typedef void (*EngineAsyncFunc)(void*, void*, void*);
 typedef void (*EngineSyncFunc)(void*, void*);
 /*! \brief Callback to free the param for EngineAsyncFunc/EngineSyncFunc */
 typedef void (*EngineFuncParamDeleter)(void*);
+/*! \brief Callback to release an external buffer wrapped by an NDArray */
+typedef void (*NDArrayBufferDeleter)(void* data, void* deleter_param);
 typedef void (*ExecutorMonitorCallback)(const char*,
                                         NDArrayHandle,
                                         void*);
@@ -269,6 +271,28 @@ MXNET_DLL int MXRandomSeedContext(int seed, int dev_type, int dev_id);
  */
 MXNET_DLL int MXNotifyShutdown();
 
+/*!
+ * \brief Stop the engine's worker pools after draining all pending operations.
+ *
+ *  Intended for preforking servers: call before fork(2) so no engine
+ *  threads or per-thread device state exist in the child, then have each
+ *  worker call MXEngineRestart when it first needs the engine. Loaded
+ *  model pages stay shared copy-on-write across the workers.
+ *  All asynchronous operations are waited for, so outstanding reads and
+ *  writes are complete when this returns.
+ * \return 0 when success, -1 when failure happens.
+ */
+MXNET_DLL int MXEngineStop();
+
+/*!
+ * \brief Respawn the engine's worker pools after MXEngineStop.
+ *
+ *  Safe to call in a forked child; worker threads and device streams are
+ *  recreated from scratch in the calling process.
+ * \return 0 when success, -1 when failure happens.
+ */
+MXNET_DLL int MXEngineRestart();
+
 /*!
  * \brief Set up configuration of profiler for the process passed as profile_process in keys
  * \param num_params Number of parameters
@@ -485,6 +509,40 @@ MXNET_DLL int MXSetNumOMPThreads(int thread_num);
  */
 MXNET_DLL int MXEngineSetBulkSize(int bulk_size, int* prev_bulk_size);
 
+/*!
+ * \brief dump the engine's ring buffer of recently executed ops.
+ *  Each line holds sequence number, timestamp (ns), thread id, device,
+ *  var counts and op name, oldest entry first. The buffer size is
+ *  controlled by MXNET_ENGINE_TRACE_SIZE.
+ * \param out_trace the formatted trace, valid until the next call
+ *                  from the same thread
+ * \return 0 when success, -1 when failure happens.
+ */
+MXNET_DLL int MXEngineDumpExecTrace(const char** out_trace);
+
+/*!
+ * \brief dump the always-on runtime counters as a JSON string.
+ *  Covers engine queue depth, completed op count and wall time per op
+ *  class, storage allocation count and bytes, and GPU pool hit/miss
+ *  counts. Collection is controlled by MXNET_RUNTIME_STATS.
+ * \param out_stats the JSON snapshot, valid until the next call
+ *                  from the same thread
+ * \param reset whether to zero the cumulative counters after reading
+ * \return 0 when success, -1 when failure happens.
+ */
+MXNET_DLL int MXRuntimeStatsDump(const char** out_stats, int reset);
+
+/*!
+ * \brief dump the engine's recorded dependency graph as DOT and clear it.
+ *  Node labels carry per-op execution time and the critical path is
+ *  highlighted. Recording is off by default; enable it with
+ *  MXNET_ENGINE_DEP_GRAPH_SIZE.
+ * \param out_graph the DOT text, valid until the next call
+ *                  from the same thread
+ * \return 0 when success, -1 when failure happens.
+ */
+MXNET_DLL int MXEngineDumpDependencyGraph(const char** out_graph);
+
 /*!
  * \brief Get the number of GPUs.
  * \param pointer to int that will hold the number of GPUs available.
@@ -686,6 +744,30 @@ MXNET_DLL int MXNDArraySave(const char* fname,
                             uint32_t num_args,
                             NDArrayHandle* args,
                             const char** keys);
+/*!
+ * \brief Save list of narray into the file without blocking the caller.
+ *  The arrays are snapshotted through engine read dependencies and written
+ *  to disk on a background thread, so training may keep updating them while
+ *  the checkpoint is in flight. Use MXNDArraySaveAsyncWaitAll to ensure a
+ *  checkpoint has reached disk.
+ * \param fname name of the file.
+ * \param num_args number of arguments to save.
+ * \param args the array of NDArrayHandles to be saved.
+ * \param keys the name of the NDArray, optional unless delta_only is set.
+ * \param delta_only if nonzero, only save arrays whose content version
+ *  changed since the last asynchronous save that included the same key.
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXNDArraySaveAsync(const char* fname,
+                                 uint32_t num_args,
+                                 NDArrayHandle* args,
+                                 const char** keys,
+                                 int delta_only);
+/*!
+ * \brief Wait until every checkpoint queued by MXNDArraySaveAsync is on disk.
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXNDArraySaveAsyncWaitAll();
 /*!
  * \brief Load list of narray from the file.
  * \param fname name of the file.
@@ -751,6 +833,51 @@ MXNET_DLL int MXNDArraySyncCopyToCPU(NDArrayHandle handle,
                                      void *data,
                                      size_t size);
 
+/*! \brief Callback invoked from an engine thread when an async copy to CPU completes */
+typedef void (*MXNDArrayCopyCompleteCallback)(void *callback_arg);
+
+/*!
+ * \brief Perform an asynchronize copy to a contiguous CPU memory region.
+ *
+ *  The copy is enqueued on the dependency engine and this function returns
+ *  immediately; callback is invoked from an engine thread once the data has
+ *  landed in the destination buffer. The caller must keep the buffer alive
+ *  until then, and must not block inside the callback.
+ *
+ * \param handle the NDArray handle
+ * \param data the data source to copy into.
+ * \param size the memory size we want to copy into.
+ * \param callback invoked once the copy has completed
+ * \param callback_arg passed through to the callback
+ */
+MXNET_DLL int MXNDArrayAsyncCopyToCPU(NDArrayHandle handle,
+                                      void *data,
+                                      size_t size,
+                                      MXNDArrayCopyCompleteCallback callback,
+                                      void *callback_arg);
+
+/*!
+ * \brief Perform asynchronize copies of several NDArrays to CPU memory
+ *  regions with a single completion callback.
+ *
+ *  Each copy is enqueued on the dependency engine and this function returns
+ *  immediately; the copies proceed independently and callback is invoked
+ *  from an engine thread once the last of them has completed.
+ *
+ * \param num number of arrays to copy
+ * \param handles the NDArray handles
+ * \param data the data destinations, one per array.
+ * \param sizes the memory sizes we want to copy into, one per array.
+ * \param callback invoked once all copies have completed
+ * \param callback_arg passed through to the callback
+ */
+MXNET_DLL int MXNDArrayAsyncCopyToCPUBatch(uint32_t num,
+                                           NDArrayHandle *handles,
+                                           void **data,
+                                           const size_t *sizes,
+                                           MXNDArrayCopyCompleteCallback callback,
+                                           void *callback_arg);
+
 /*!
  * \brief Copy src.data() to dst.data() if i = -1, else dst.aux_data(i) if i >= 0
  * This function blocks. Do not use it in performance critical code.
@@ -1165,6 +1292,38 @@ MXNET_DLL int MXImperativeInvokeEx(AtomicSymbolCreator creator,
                                    const char **param_keys,
                                    const char **param_vals,
                                    const int **out_stypes);
+/*!
+ * \brief enqueue a nnvm op invocation on the imperative dispatch queue and
+ *  return immediately, letting the frontend run ahead of argument
+ *  marshalling and graph construction. Output handles are placeholders
+ *  that become valid once the queue has drained; call
+ *  MXImperativeFlushAsync before reading their shape, dtype or contents,
+ *  before freeing them, and before running autograd on them.
+ * \param creator the op
+ * \param num_inputs number of input NDArrays
+ * \param inputs input NDArrays
+ * \param num_outputs number of output NDArrays
+ * \param outputs output NDArrays
+ * \param num_params number of keyword parameters
+ * \param param_keys keys for keyword parameters
+ * \param param_vals values for keyword parameters
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXImperativeInvokeAsync(AtomicSymbolCreator creator,
+                                      int num_inputs,
+                                      NDArrayHandle *inputs,
+                                      int *num_outputs,
+                                      NDArrayHandle **outputs,
+                                      int num_params,
+                                      const char **param_keys,
+                                      const char **param_vals);
+/*!
+ * \brief wait until every call queued through MXImperativeInvokeAsync has
+ *  been dispatched to the engine, then report the first error raised by a
+ *  queued call, if any.
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXImperativeFlushAsync();
 /*!
  * \brief set whether to record operator for autograd
  * \param is_recording 1 when recording, 0 when not recording.
@@ -1303,6 +1462,65 @@ MXNET_DLL int MXInvokeCachedOpEx(CachedOpHandle handle,
                                  NDArrayHandle **outputs,
                                  const int** out_stypes);
 
+/*!
+ * \brief run one data-parallel training step over context-replicated cached
+ *  ops without returning to the frontend between stages: record forward on
+ *  every replica, run backward on every replica, then push each parameter's
+ *  gradients to the kvstore and pull the updated weights back. Overlap
+ *  between remaining backward work and gradient reduction follows from the
+ *  engine's dataflow dependencies. Parameters must have gradients attached
+ *  (see MXAutogradMarkVariables); all replica-major arrays are laid out as
+ *  array[replica * count + index].
+ * \param num_replicas number of device replicas
+ * \param op_handles one cached op per replica
+ * \param num_inputs number of inputs per replica
+ * \param inputs replica-major input NDArrays
+ * \param num_outputs number of outputs per replica
+ * \param outputs replica-major preallocated output NDArrays
+ * \param num_params number of parameters per replica
+ * \param params replica-major parameter NDArrays, or NULL to skip the update
+ * \param grads replica-major gradient NDArrays, or NULL to skip the update
+ * \param param_keys kvstore key of each parameter, or NULL to skip the update
+ * \param kv_handle kvstore performing reduction and update, or NULL to skip
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXCachedOpParallelStep(int num_replicas,
+                                     CachedOpHandle *op_handles,
+                                     int num_inputs,
+                                     NDArrayHandle *inputs,
+                                     int num_outputs,
+                                     NDArrayHandle *outputs,
+                                     int num_params,
+                                     NDArrayHandle *params,
+                                     NDArrayHandle *grads,
+                                     const int *param_keys,
+                                     KVStoreHandle kv_handle);
+
+/*!
+ * \brief run one gradient-accumulation step over K micro-batches of a cached op.
+ *
+ *  Runs forward and backward for each micro-batch, interleaving the
+ *  queueing so that micro-batch k+1's forward is scheduled before
+ *  micro-batch k's backward; independent micro-batch subgraphs can then
+ *  fill engine bubbles left by the serial graph latency. Gradients of
+ *  marked variables accumulate across micro-batches, so parameters
+ *  should be marked with grad req "add" and their gradient buffers
+ *  zeroed before the step.
+ * \param handle the handle to the cached op
+ * \param num_micro_batches number of micro-batches K
+ * \param num_inputs number of inputs per micro-batch
+ * \param inputs input slices, micro-batch major: inputs[k * num_inputs + i]
+ * \param num_outputs number of outputs per micro-batch
+ * \param outputs preallocated output arrays, micro-batch major
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXCachedOpMicroBatchStep(CachedOpHandle handle,
+                                       int num_micro_batches,
+                                       int num_inputs,
+                                       NDArrayHandle *inputs,
+                                       int num_outputs,
+                                       NDArrayHandle *outputs);
+
 /*!
  * \brief cached op set monitor callback
  */
@@ -2066,6 +2284,23 @@ MXNET_DLL int MXExecutorFree(ExecutorHandle handle);
  * \return 0 when success, -1 when failure happens
  */
 MXNET_DLL int MXExecutorPrint(ExecutorHandle handle, const char **out_str);
+/*!
+ * \brief Get the row_sparse prefetch plan of a bound executor: pairs of a
+ *  row_sparse parameter name and the name of the graph input that supplies
+ *  the row ids its consumers gather. Frontends use the plan to pull the
+ *  parameter rows from a kvstore as soon as the index data of a batch is
+ *  known, overlapping the fetch with upstream compute.
+ * \param handle the executor.
+ * \param num_pairs number of entries in the plan.
+ * \param param_names names of the row_sparse parameters.
+ * \param index_names names of the inputs carrying the row ids, aligned
+ *  with param_names.
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXExecutorGetRowSparsePullPlan(ExecutorHandle handle,
+                                             uint32_t *num_pairs,
+                                             const char ***param_names,
+                                             const char ***index_names);
 /*!
  * \brief Executor forward method
  *
@@ -2520,6 +2755,29 @@ MXNET_DLL int MXDataIterGetPadNum(DataIterHandle handle,
  */
 MXNET_DLL int MXDataIterGetLabel(DataIterHandle handle,
                                  NDArrayHandle *out);
+/*!
+ * \brief Push one batch into a PushIter.
+ *  Only the NDArray handles are transferred, the content is not copied.
+ *  Blocks while the iterator already buffers `capacity` batches.
+ *  Fails on iterators that were not created from the PushIter creator.
+ * \param handle the handle pointer to the data iterator
+ * \param data handle to the data NDArray of the batch
+ * \param label handle to the label NDArray of the batch
+ * \param pad number of padded instances at the end of the batch
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXDataIterPushNDArray(DataIterHandle handle,
+                                    NDArrayHandle data,
+                                    NDArrayHandle label,
+                                    int pad);
+/*!
+ * \brief Signal a PushIter that no further batch follows in this epoch.
+ *  After all buffered batches are consumed, iterator.Next returns false
+ *  until iterator.Reset is called.
+ * \param handle the handle pointer to the data iterator
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXDataIterPushEndOfData(DataIterHandle handle);
 //--------------------------------------------
 // Part 6: basic KVStore interface
 //--------------------------------------------
@@ -2555,6 +2813,18 @@ MXNET_DLL int MXKVStoreSetGradientCompression(KVStoreHandle handle,
                                               const char** keys,
                                               const char** vals);
 
+/*!
+ * \brief Set the global gradient-norm clipping threshold.
+ *  Gradient norms are computed as part of the aggregation and the merged
+ *  gradients are rescaled during pull, so no extra passes over the
+ *  gradients are needed. Zero disables clipping.
+ * \param handle handle to the kvstore
+ * \param max_norm maximum allowed global gradient norm
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXKVStoreSetGradientClipping(KVStoreHandle handle,
+                                           float max_norm);
+
 /*!
  * \brief Delete a KVStore handle.
  * \param handle handle to the kvstore
@@ -3119,6 +3389,30 @@ MXNET_DLL int MXNDArrayCreateFromSharedMem(int shared_pid, int shared_id, const
  */
 MXNET_DLL int MXStorageEmptyCache(int dev_type, int dev_id);
 
+/*!
+ * \brief Query memory pool statistics of a device's storage manager
+ * \param dev_type device type, specify device we want to take
+ * \param dev_id the device id of the specific device
+ * \param used_bytes bytes handed out to live allocations, rounding included
+ * \param cached_bytes bytes held in the pool for reuse
+ * \param fragmentation_bytes bytes lost to size rounding across live allocations
+ */
+MXNET_DLL int MXStorageGetMemoryPoolStats(int dev_type, int dev_id,
+                                          uint64_t* used_bytes,
+                                          uint64_t* cached_bytes,
+                                          uint64_t* fragmentation_bytes);
+
+/*!
+ * \brief Set a hard cap on the bytes the device's memory pool may hold.
+ *  Allocations beyond the cap fail even if the device has free memory,
+ *  so several processes can partition a device deterministically.
+ * \param dev_type device type, specify device we want to take
+ * \param dev_id the device id of the specific device
+ * \param cap_bytes the cap in bytes, 0 removes the cap
+ */
+MXNET_DLL int MXStorageSetMemoryPoolCap(int dev_type, int dev_id,
+                                        uint64_t cap_bytes);
+
 /*!
  * \brief Reconstruct NDArray from shared memory handle
  * \param shared_pid shared PID
@@ -3131,6 +3425,28 @@ MXNET_DLL int MXStorageEmptyCache(int dev_type, int dev_id);
 MXNET_DLL int MXNDArrayCreateFromSharedMemEx(int shared_pid, int shared_id, const int *shape,
                                              int ndim, int dtype, NDArrayHandle *out);
 
+/*!
+ * \brief Create an NDArray that wraps an externally owned buffer, zero-copy.
+ *  The buffer must stay valid until the deleter is called. The deleter is
+ *  invoked from the engine once the array is freed and every operation
+ *  reading or writing it has completed, so it is safe to release the buffer
+ *  from the callback.
+ * \param data pointer to the externally owned buffer
+ * \param shape pointer to NDArray dimensions
+ * \param ndim number of NDArray dimensions
+ * \param dev_type device type of the buffer
+ * \param dev_id the device id of the specific device
+ * \param dtype data type of NDArray
+ * \param deleter callback releasing the buffer, may be NULL if the caller
+ *        guarantees the buffer outlives the NDArray by other means
+ * \param deleter_param opaque parameter passed through to the deleter
+ * \param out constructed NDArray
+ */
+MXNET_DLL int MXNDArrayCreateFromBuffer(void* data, const uint32_t* shape, uint32_t ndim,
+                                        int dev_type, int dev_id, int dtype,
+                                        NDArrayBufferDeleter deleter, void* deleter_param,
+                                        NDArrayHandle* out);
+
 /*!
   * \brief Push an asynchronous operation to the engine.
   * \param async_func Execution function whici takes a parameter on_complete
@@ -3156,6 +3472,70 @@ MXNET_DLL int MXEnginePushAsync(EngineAsyncFunc async_func, void* func_param,
                                 int priority DEFAULT(0), const char* opr_name DEFAULT(NULL),
                                 bool wait DEFAULT(false));
 
+/*!
+  * \brief Try to push an asynchronous operation to the engine, failing
+  *        fast instead of queueing when the target scheduling lane is at
+  *        its configured depth limit (see
+  *        MXNET_ENGINE_MAX_PENDING_BACKGROUND/DEFAULT/REALTIME).
+  *        On rejection nothing is scheduled; func_param's deleter, when
+  *        given, is still invoked.
+  * \param async_func Execution function as in MXEnginePushAsync.
+  * \param func_param The parameter set on calling async_func, can be NULL.
+  * \param deleter The callback to free func_param, can be NULL.
+  * \param ctx_handle Execution context.
+  * \param const_vars_handle The variables that current operation will use
+  *                          but not mutate.
+  * \param num_const_vars The number of const_vars_handle.
+  * \param mutable_vars_handle The variables that current operation will mutate.
+  * \param num_mutable_vars The number of mutable_vars_handle.
+  * \param prop_handle Property of the function.
+  * \param priority Priority of the action, as hint to the engine.
+  * \param opr_name The operation name.
+  * \param wait Whether this is a WaitForVar operation.
+  * \param out_accepted 1 if the operation was scheduled, 0 if it would block.
+  */
+MXNET_DLL int MXEngineTryPushAsync(EngineAsyncFunc async_func, void* func_param,
+                                   EngineFuncParamDeleter deleter, ContextHandle ctx_handle,
+                                   EngineVarHandle const_vars_handle, int num_const_vars,
+                                   EngineVarHandle mutable_vars_handle, int num_mutable_vars,
+                                   EngineFnPropertyHandle prop_handle, int priority,
+                                   const char* opr_name, bool wait,
+                                   int* out_accepted);
+
+/*!
+  * \brief Push a batch of asynchronous operations to the engine
+  *        with a single API crossing.
+  * \param num_oprs The number of operations in the batch.
+  * \param async_funcs Execution functions, one per operation. Each takes
+  *                    a parameter on_complete that must be called when the
+  *                    execution completes.
+  * \param func_params The parameters set on calling each async_func,
+  *                    entries can be NULL.
+  * \param deleters The callbacks to free each func_param, entries can be
+  *                 NULL. The whole array can be NULL.
+  * \param ctx_handle Execution context shared by all operations.
+  * \param const_vars_handle Flattened array of the variables the operations
+  *                          will use but not mutate.
+  * \param num_const_vars Per-operation counts into const_vars_handle.
+  * \param mutable_vars_handle Flattened array of the variables the
+  *                            operations will mutate.
+  * \param num_mutable_vars Per-operation counts into mutable_vars_handle.
+  * \param prop_handle Property of the functions, shared by all operations.
+  * \param priority Priority of the actions, as hint to the engine.
+  * \param opr_name The operation name, shared by all operations.
+  */
+MXNET_DLL int MXEnginePushAsyncBatch(int num_oprs,
+                                     EngineAsyncFunc* async_funcs, void** func_params,
+                                     EngineFuncParamDeleter* deleters,
+                                     ContextHandle ctx_handle,
+                                     EngineVarHandle const_vars_handle,
+                                     const int* num_const_vars,
+                                     EngineVarHandle mutable_vars_handle,
+                                     const int* num_mutable_vars,
+                                     EngineFnPropertyHandle prop_handle DEFAULT(NULL),
+                                     int priority DEFAULT(0),
+                                     const char* opr_name DEFAULT(NULL));
+
 /*!
   * \brief Push a synchronous operation to the engine.
   * \param sync_func Execution function that executes the operation.
@@ -166,6 +166,12 @@ MXNET_DLL int MXPredCreatePartialOut(const char* symbol_json_str,
 
 /*!
  * \brief create predictors for multiple threads. One predictor for a thread.
+ *  All predictors share one copy of the weights and auxiliary states, so
+ *  per-thread memory grows only with the inputs, outputs and intermediate
+ *  workspace of each session. Each predictor owns private, pre-faulted
+ *  input buffers, so MXPredSetInput and MXPredForward may run concurrently
+ *  on distinct handles; a single handle must not be used from two threads
+ *  at once. Requires MXNET_ENGINE_TYPE=NaiveEngine.
  * \param symbol_json_str The JSON string of the symbol.
  * \param param_bytes The in-memory raw bytes of parameter ndarray file.
  * \param param_size The size of parameter ndarray file.
@@ -257,6 +263,9 @@ MXNET_DLL int MXPredSetInput(PredictorHandle handle,
                              uint32_t size);
 /*!
  * \brief Run a forward pass to get the output.
+ *  Thread safety: calls on distinct handles created by
+ *  MXPredCreateMultiThread may run concurrently; calls touching the same
+ *  handle must be externally serialized.
  * \param handle The handle of the predictor.
  * \return 0 when success, -1 when failure.
  */
@@ -290,6 +299,24 @@ MXNET_DLL int MXPredGetOutput(PredictorHandle handle,
                               uint32_t index,
                               float* data,
                               uint32_t size);
+/*!
+ * \brief Register a caller-owned buffer to receive an output of prediction.
+ *  The pointer and size are validated once against the bound output shape;
+ *  every subsequent MXPredForward then copies that output into the buffer
+ *  before returning, so no MXPredGetOutput call is needed. The buffer must
+ *  stay valid and must not be read while a forward pass is running. Passing
+ *  a NULL data pointer removes a previous registration. Registrations do
+ *  not carry over to handles returned by MXPredReshape.
+ * \param handle The handle of the predictor.
+ * \param index The index of output node, set to 0 if there is only one output.
+ * \param data User allocated buffer to hold the output, or NULL to unregister.
+ * \param size The size of data array, used for safe checking.
+ * \return 0 when success, -1 when failure.
+ */
+MXNET_DLL int MXPredSetOutputBuffer(PredictorHandle handle,
+                                    uint32_t index,
+                                    float* data,
+                                    uint32_t size);
 /*!
  * \brief Free a predictor handle.
  * \param handle The handle of the predictor.
@@ -179,6 +179,17 @@ class MXNET_API Engine {
    * operations using this operator are completed.
    */
   virtual void DeleteOperator(OprHandle op) = 0;
+  /*!
+   * \brief Attach an estimated execution cost to an operator.
+   *
+   *  The hint lets engines decide whether dispatching the operator is
+   *  worth more than running it inline on the pushing thread. Engines
+   *  without such a policy ignore the hint.
+   *
+   * \param op The operator to annotate.
+   * \param cost_hint Estimated execution cost in microseconds.
+   */
+  virtual void SetOprCostHint(OprHandle op, int cost_hint) {}
   /*!
    * \brief Push an operator to the engine.
    * \param op The operator to push.
@@ -208,6 +219,76 @@ class MXNET_API Engine {
                          int priority = 0,
                          const char* opr_name = nullptr,
                          bool wait = false) = 0;
+  /*!
+   * \brief Try to push an asynchronous operation, failing fast under
+   *  overload instead of queueing.
+   *
+   *  Engines with admission control refuse the push without scheduling
+   *  anything when the target scheduling lane is at its configured depth
+   *  limit, so a serving frontend can shed load before queues grow.
+   *  Engines without admission limits always accept. The depth check is
+   *  advisory: concurrent pushers may momentarily overshoot a limit.
+   *
+   * \param exec_fun Execution function as in PushAsync.
+   * \param exec_ctx Execution context.
+   * \param const_vars The variables that current operation will use but not
+   *                   mutate.
+   * \param mutable_vars The variables that current operation will mutate.
+   * \param prop Property of the function.
+   * \param priority Priority of the action, as hint to the engine.
+   * \param opr_name The operator name.
+   * \param wait Whether this is a WaitForVar operation
+   * \return whether the operation was accepted; false means it would
+   *         block and nothing was scheduled.
+   */
+  virtual bool TryPushAsync(AsyncFn exec_fun, Context exec_ctx,
+                            std::vector<VarHandle> const& const_vars,
+                            std::vector<VarHandle> const& mutable_vars,
+                            FnProperty prop = FnProperty::kNormal,
+                            int priority = 0,
+                            const char* opr_name = nullptr,
+                            bool wait = false) {
+    this->PushAsync(std::move(exec_fun), exec_ctx, const_vars, mutable_vars,
+                    prop, priority, opr_name, wait);
+    return true;
+  }
+  /*!
+   * \brief A single operation of a PushAsyncBatch call.
+   */
+  struct AsyncOprEntry {
+    /*! \brief execution function, takes on_complete as in PushAsync */
+    AsyncFn exec_fun;
+    /*! \brief the variables the operation reads but does not mutate */
+    std::vector<VarHandle> const_vars;
+    /*! \brief the variables the operation mutates */
+    std::vector<VarHandle> mutable_vars;
+    /*! \brief property of the function */
+    FnProperty prop = FnProperty::kNormal;
+    /*! \brief priority of the action, as hint to the engine */
+    int priority = 0;
+    /*! \brief the operator name */
+    const char* opr_name = nullptr;
+  };
+  /*!
+   * \brief Push a batch of asynchronous operations to the engine.
+   *
+   *  Equivalent to calling PushAsync once per entry, but engines may
+   *  amortize per-push overhead (validation, profiling checks, queue
+   *  signalling) over the whole batch. Entries are scheduled in order;
+   *  dependency tracking between entries behaves exactly as with
+   *  individual pushes.
+   *
+   * \param entries The operations to push. Execution functions are
+   *                moved out of the entries.
+   * \param exec_ctx Execution context shared by all entries.
+   */
+  virtual void PushAsyncBatch(std::vector<AsyncOprEntry>* entries, Context exec_ctx) {
+    for (AsyncOprEntry& entry : *entries) {
+      this->PushAsync(std::move(entry.exec_fun), exec_ctx,
+                      entry.const_vars, entry.mutable_vars,
+                      entry.prop, entry.priority, entry.opr_name);
+    }
+  }
   /*!
    * \brief Schedule the deletion of a variable.
    *
@@ -222,6 +303,30 @@ class MXNET_API Engine {
   virtual void DeleteVariable(SyncFn delete_fn,
                               Context exec_ctx,
                               VarHandle var) = 0;
+  /*!
+   * \brief Schedule the deletion of a batch of variables.
+   *
+   *  Equivalent to deleting each variable individually with a shared
+   *  delete_fn that runs once after all the variables' pending
+   *  operations complete, but engines may service the whole batch with
+   *  a single scheduled operation.
+   *
+   * \param delete_fn A function called once, after every variable in
+   *                  the batch has completed its pending operations.
+   * \param exec_ctx Execution context.
+   * \param vars The variables to be deleted.
+   */
+  virtual void DeleteVariables(SyncFn delete_fn,
+                               Context exec_ctx,
+                               std::vector<VarHandle> const& vars) {
+    this->PushAsync([delete_fn](RunContext ctx, CallbackOnComplete on_complete) {
+        delete_fn(ctx);
+        on_complete();
+      }, exec_ctx, {}, vars, FnProperty::kDeleteVar, 0, "DeleteVariables");
+    for (VarHandle var : vars) {
+      this->DeleteVariable([](RunContext) {}, exec_ctx, var);
+    }
+  }
   /*!
    * \brief Wait for a variable.
    * \param var The variable we should wait for. This function returns when the
@@ -234,6 +339,31 @@ class MXNET_API Engine {
   virtual void WaitForAll() = 0;
   /*!\brief Throw if threre are associated exception with var */
   virtual void Throw(VarHandle var) = 0;
+  /*!
+   * \brief Named scheduling lanes, expressed as push priorities.
+   *
+   *  Engines with priority-aware queues dequeue higher values first, so
+   *  an op pushed on the realtime lane overtakes queued default and
+   *  background work (running ops are never interrupted). Any int is
+   *  accepted as a priority; these constants define the conventional
+   *  lanes used when inference and background training share a process.
+   */
+  static constexpr int kBackgroundPriority = -100;
+  /*! \brief the default scheduling lane */
+  static constexpr int kDefaultPriority = 0;
+  /*! \brief the latency-critical scheduling lane */
+  static constexpr int kRealtimePriority = 100;
+  /*!
+   * \brief Thread-local default priority.
+   *
+   *  Pushes that do not specify an explicit priority (priority == 0)
+   *  inherit this value, letting a caller route everything scheduled
+   *  from the current thread (e.g. one CachedOp::Forward) onto a lane
+   *  without threading a priority argument through every push site.
+   *
+   * \return mutable reference to the calling thread's default priority.
+   */
+  static int& ThreadLocalDefaultPriority();
   /*!\brief virtual destructor */
   virtual ~Engine() noexcept(false) {}
   /*!
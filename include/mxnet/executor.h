@@ -31,6 +31,7 @@
 #include <memory>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include "./base.h"
 #include "./c_api.h"
@@ -103,6 +104,17 @@ class Executor {
    * \return aux state map in the executor.
    */
   virtual const std::unordered_map<std::string, NDArray>& aux_state_map() const = 0;
+  /*!
+   * \brief get the row_sparse prefetch plan: for each row_sparse parameter
+   *  whose consumers gather rows named by a graph input, the name of that
+   *  input. Frontends use the plan to issue kvstore row_sparse pulls as soon
+   *  as the index data is available, so the fetch overlaps upstream compute.
+   * \return map from parameter name to index input name
+   */
+  virtual const std::unordered_map<std::string, std::string>& row_sparse_pull_plan() const {
+    static const std::unordered_map<std::string, std::string> empty;
+    return empty;
+  }
   /*!
    * \brief Return a new executor with the same symbol and shared memory,
    *  but different input/output shapes.
@@ -176,15 +176,23 @@ class Imperative {
   static bool PreferBulkExecTrain() {
     return dmlc::GetEnv("MXNET_EXEC_BULK_EXEC_TRAIN", true);
   }
-  /*! \brief The max number of op nodes in a bulk during forward pass of training. */
-  static int BulkExecMaxNodeTrainFwd() {
+  /*!
+   * \brief The max number of op nodes in a bulk during forward pass of training.
+   * \param dflt default when neither environment variable is set; callers may
+   *  pass a profiler-derived tuning hint here.
+   */
+  static int BulkExecMaxNodeTrainFwd(int dflt = 15) {
     return dmlc::GetEnv("MXNET_EXEC_BULK_EXEC_MAX_NODE_TRAIN_FWD",
-                        dmlc::GetEnv("MXNET_EXEC_BULK_EXEC_MAX_NODE_TRAIN", 15));
+                        dmlc::GetEnv("MXNET_EXEC_BULK_EXEC_MAX_NODE_TRAIN", dflt));
   }
-  /*! \brief The max number of op nodes in a bulk during backward pass of training. */
-  static int BulkExecMaxNodeTrainBwd() {
+  /*!
+   * \brief The max number of op nodes in a bulk during backward pass of training.
+   * \param dflt default when neither environment variable is set; callers may
+   *  pass a profiler-derived tuning hint here.
+   */
+  static int BulkExecMaxNodeTrainBwd(int dflt = 15) {
     return dmlc::GetEnv("MXNET_EXEC_BULK_EXEC_MAX_NODE_TRAIN_BWD",
-                        dmlc::GetEnv("MXNET_EXEC_BULK_EXEC_MAX_NODE_TRAIN", 15));
+                        dmlc::GetEnv("MXNET_EXEC_BULK_EXEC_MAX_NODE_TRAIN", dflt));
   }
 
  private:
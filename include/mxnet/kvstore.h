@@ -86,6 +86,23 @@ class KVStore {
   virtual void SetGradientCompression(const std::vector<std::pair<std::string, std::string> >
                                       & kwargs) = 0;
 
+  /**
+   * \brief Set the global gradient-norm clipping threshold.
+   *
+   * When set to a positive value, the squared norm of each gradient is
+   * computed as part of the aggregation and the merged gradients are
+   * rescaled during the following pull so that the global norm does not
+   * exceed the threshold. Zero disables clipping.
+   *
+   * Because the rescale happens on pull, clipping cannot be combined with
+   * an updater (update_on_kvstore): the updater would consume the merged
+   * gradients before they are clipped. Stores enforce this.
+   * \param max_norm maximum allowed global gradient norm
+   */
+  virtual void SetGradientClipping(float max_norm) {
+    LOG(FATAL) << "fused gradient clipping is not supported by kvstore type " << type_;
+  }
+
   /*!
    * \brief Initialize a list of key-value pair to the store.
    *
@@ -249,6 +266,37 @@ class KVStore {
                              const std::vector<std::pair<NDArray*, NDArray>>& val_rowids,
                              int priority = 0) = 0;
 
+  /*!
+   * \brief gather equally shaped parts living on different devices into the
+   *        full array on every device, concatenating along the first axis;
+   *        part i becomes rows [i*n, (i+1)*n) of each output. Used to
+   *        combine the partial outputs of tensor-parallel layers.
+   * \param key the identifier key
+   * \param values one part per device
+   * \param outs one full-size output per device
+   * \param priority the priority of the action
+   */
+  virtual void AllGather(int key, const std::vector<NDArray>& values,
+                         const std::vector<NDArray*>& outs,
+                         int priority = 0) {
+    LOG(FATAL) << "allgather is not supported by kvstore type " << type_;
+  }
+
+  /*!
+   * \brief reduce values across devices and leave each device with an
+   *        equally sized slice of the sum along the first axis: outs[i]
+   *        receives rows [i*n, (i+1)*n) of the reduction.
+   * \param key the identifier key
+   * \param values one full-size source per device
+   * \param outs one part per device
+   * \param priority the priority of the action
+   */
+  virtual void ReduceScatter(int key, const std::vector<NDArray>& values,
+                             const std::vector<NDArray*>& outs,
+                             int priority = 0) {
+    LOG(FATAL) << "reduce-scatter is not supported by kvstore type " << type_;
+  }
+
   /**
    * \brief the prototype of user-defined updater
    */
@@ -154,6 +154,7 @@ enum : unsigned {
   CPU_SSE4A,  // AMD extensions to SSE4
   CPU_AVX,
   CPU_AVX2,
+  CPU_AVX512F,
 
 
   // Multiprocessing / CPU / System
@@ -217,5 +218,22 @@ struct LibInfo {
  */
 bool is_enabled(unsigned feat);
 
+/*!
+ * \brief Whether the host CPU this process runs on supports a feature.
+ *  For ISA features (CPU_SSE .. CPU_AVX512F, F16C) this queries the
+ *  processor at runtime via cpuid; the compile-time bits only say what the
+ *  binary was built for. Non-ISA features always return true.
+ * \param feat the feature to query
+ * \return true if the host can execute code using the feature
+ */
+bool is_supported_on_host(unsigned feat);
+
+/*!
+ * \brief Warn if the compile-time ISA baseline of this binary exceeds the
+ *  capabilities of the host CPU, which would lead to illegal instruction
+ *  failures on part of a heterogeneous fleet. Called once at library load.
+ */
+void check_host_cpu_features();
+
 }  // namespace features
 }  // namespace mxnet
@@ -32,10 +32,12 @@
 #include <dmlc/registry.h>
 #include <nnvm/node.h>
 #include <vector>
+#include <functional>
 #include <map>
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <utility>
 #include <algorithm>
 #if MXNET_USE_MKLDNN == 1
 #include <mkldnn.hpp>
@@ -43,6 +45,7 @@
 #include "./base.h"
 #include "./storage.h"
 #include "./engine.h"
+#include "./pooled_allocator.h"
 // check c++11
 #if DMLC_USE_CXX11 == 0
 #error "cxx11 was required for ndarray module"
@@ -94,7 +97,7 @@ class NDArray {
    */
   NDArray(const mxnet::TShape &shape, Context ctx,
           bool delay_alloc = false, int dtype = mshadow::default_type_flag)
-      : ptr_(std::make_shared<Chunk>(shape, ctx, delay_alloc, dtype)),
+      : ptr_(MakeChunk(shape, ctx, delay_alloc, dtype)),
         shape_(shape),
         dtype_(dtype),
         storage_type_(kDefaultStorage),
@@ -113,7 +116,7 @@ class NDArray {
    * \param dtype data type of this ndarray
    */
   explicit NDArray(Context ctx, int dtype = mshadow::default_type_flag)
-      : ptr_(std::make_shared<Chunk>(mxnet::TShape(mshadow::Shape1(0)), ctx, true, dtype)),
+      : ptr_(MakeChunk(mxnet::TShape(mshadow::Shape1(0)), ctx, true, dtype)),
         shape_(),
         dtype_(dtype),
         storage_type_(kDefaultStorage),
@@ -127,7 +130,7 @@ class NDArray {
    * \param dev_id the device id this tensor sits at
    */
   NDArray(const TBlob &data, int dev_id)
-      : ptr_(std::make_shared<Chunk>(data, dev_id)),
+      : ptr_(MakeChunk(data, dev_id)),
         shape_(data.shape_),
         dtype_(data.type_flag_),
         storage_type_(kDefaultStorage),
@@ -136,25 +139,25 @@ class NDArray {
 
   /*!
    * \brief constructing a static NDArray that shares data with TBlob which is with deleter
-   *  Use with caution: allocate ONLY ONE NDArray for each TBlob,
-   *  make sure the memory region is available through out the life of NDArray
+   *  Use with caution: allocate ONLY ONE NDArray for each TBlob.
+   *  The deleter is invoked from the engine once the variable is destroyed
+   *  and all operations reading or writing the array have completed, so the
+   *  memory region must stay valid until then, but not longer.
    * \param data the memory content of static data
    * \param dev_id the device id this tensor sits at
    * \param deleter the function pointer of custom deleter
    */
   NDArray(const TBlob &data, int dev_id, const std::function<void()>& deleter)
-      : ptr_(new Chunk(data, dev_id), [deleter](Chunk *p) {
-            deleter();    // call custom deleter
-            delete p;     // delete Chunk object
-        }),
+      : ptr_(MakeChunk(data, dev_id)),
         shape_(data.shape_),
         dtype_(data.type_flag_), storage_type_(kDefaultStorage),
         entry_(nullptr) {
+    ptr_->external_deleter = deleter;
   }
 
   /*! \brief create ndarray from shared memory */
   NDArray(int shared_pid, int shared_id, const mxnet::TShape& shape, int dtype)
-      : ptr_(std::make_shared<Chunk>(shared_pid, shared_id, shape, dtype)),
+      : ptr_(MakeChunk(shared_pid, shared_id, shape, dtype)),
         shape_(shape),
         dtype_(dtype),
         storage_type_(kDefaultStorage),
@@ -173,7 +176,7 @@ class NDArray {
    */
   NDArray(const NDArrayStorageType stype, const mxnet::TShape &shape,
           const TBlob &data, const std::vector<TBlob> &aux_data, int dev_id)
-      : ptr_(std::make_shared<Chunk>(stype, data, aux_data, dev_id)),
+      : ptr_(MakeChunk(stype, data, aux_data, dev_id)),
         shape_(shape),
         dtype_(data.type_flag_),
         storage_type_(stype),
@@ -510,6 +513,19 @@ class NDArray {
    * \param size the memory size we want to copy into, in sizeof(DType) not raw btyes.
    */
   void SyncCopyToCPU(void *data, size_t size) const;
+  /*!
+   * \brief Do an asynchronize copy to a contiguous CPU memory region.
+   *
+   *  The copy is pushed to the dependency engine and the calling thread
+   *  returns immediately; callback is invoked from the engine thread once
+   *  the data has landed in the destination buffer. The caller must keep
+   *  the buffer alive until then.
+   *
+   * \param data the data source to copy into.
+   * \param size the memory size we want to copy into, in sizeof(DType) not raw btyes.
+   * \param callback invoked once the copy has completed
+   */
+  void AsyncCopyToCPU(void *data, size_t size, std::function<void()> callback) const;
   /*!
   * \brief check whether the NDArray format is valid
   * \param full_check if `True`, rigorous check, O(N) operations
@@ -808,6 +824,40 @@ class NDArray {
   static void Load(dmlc::Stream* fi,
                    std::vector<NDArray>* data,
                    std::vector<std::string>* keys);
+  /*!
+   * \brief Load list of ndarray from a local file by memory-mapping it.
+   *  The file is mapped copy-on-write and dense CPU arrays point straight
+   *  into the mapping, so no data is copied at load time, pages fault in
+   *  lazily and co-located processes share page-cache-resident weights.
+   *  Only attempted when MXNET_MMAP_NDARRAY_LOAD is set.
+   * \param fname name of a local file in the NDArray list format.
+   * \param data the NDArrays to be loaded
+   * \param keys the name of the NDArray, if saved in the file.
+   * \return whether the file was loaded this way; on false the caller
+   *  should fall back to the stream-based Load.
+   */
+  static bool LoadMemoryMapped(const std::string& fname,
+                               std::vector<NDArray>* data,
+                               std::vector<std::string>* keys);
+  /*!
+   * \brief Save list of ndarray into a file without blocking the caller.
+   *  Each array is snapshotted by an engine copy with a read dependency, so
+   *  the checkpoint reflects the values at call time while training keeps
+   *  mutating the originals; the copies are streamed to disk on a background
+   *  thread. At most two snapshots are staged at once, so a slow disk
+   *  throttles checkpoint frequency rather than growing memory unboundedly.
+   * \param fname name of the output file.
+   * \param data the NDArrays to be saved.
+   * \param names the name of the NDArray, optional unless delta_only is set.
+   * \param delta_only if true, only save arrays whose engine version changed
+   *  since the last SaveAsync that saw the same name.
+   */
+  static void SaveAsync(const std::string& fname,
+                        const std::vector<NDArray>& data,
+                        const std::vector<std::string>& names,
+                        bool delta_only = false);
+  /*! \brief Block until every checkpoint queued by SaveAsync is on disk. */
+  static void WaitAllSaveAsync();
 
  private:
   friend class Imperative;
@@ -838,6 +888,11 @@ class NDArray {
      */
     /*! \brief construct from static data */
     bool static_data;
+    /*!
+     * \brief deleter for externally owned data, invoked from the engine
+     *  after the variable is destroyed; empty for MXNet-owned storage
+     */
+    std::function<void()> external_deleter;
     /*! \brief whether data allocation is delayed. This doesn't indicate whether aux data
                allocation is delayed. */
     bool delay_alloc;
@@ -1085,6 +1140,20 @@ class NDArray {
     ~Chunk();
   };  // struct Chunk
 
+  /*!
+   * \brief Allocate a Chunk from the per-thread control block pool.
+   *  Imperative mode creates and frees one Chunk per output tensor, so the
+   *  combined shared_ptr allocation goes through the pooled allocator
+   *  instead of a heap malloc/free pair.
+   * \param args arguments forwarded to the Chunk constructor.
+   * \return shared pointer owning the new Chunk.
+   */
+  template<typename... Args>
+  static std::shared_ptr<Chunk> MakeChunk(Args&&... args) {
+    return std::allocate_shared<Chunk>(common::PooledThreadLocalAllocator<Chunk>(),
+                                       std::forward<Args>(args)...);
+  }
+
   void SetTBlob() const;
 
   /*! \brief internal data of NDArray */
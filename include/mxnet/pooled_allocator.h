@@ -0,0 +1,132 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file pooled_allocator.h
+ * \brief Thread-local pooled STL allocator for small, frequently recycled
+ *  control blocks such as NDArray chunks. Single-object allocations come
+ *  from a per-thread free list of uniform-size blocks, so the steady-state
+ *  cost of creating and destroying a small object is a pointer pop and push
+ *  instead of a malloc/free pair. Blocks may be freed on a different thread
+ *  than they were allocated on; each thread's list is capped and overflow
+ *  falls back to operator delete.
+ */
+#ifndef MXNET_POOLED_ALLOCATOR_H_
+#define MXNET_POOLED_ALLOCATOR_H_
+
+#include <cstddef>
+#include <new>
+
+namespace mxnet {
+namespace common {
+
+/*!
+ * \brief STL-compatible allocator backed by a per-thread free list.
+ * \tparam T the allocated type; block size is derived from T, and the
+ *  rebound allocator for another type uses that type's own free list.
+ */
+template <typename T>
+class PooledThreadLocalAllocator {
+ public:
+  /*! \brief allocated value type */
+  typedef T value_type;
+
+  PooledThreadLocalAllocator() = default;
+  template <typename U>
+  PooledThreadLocalAllocator(const PooledThreadLocalAllocator<U>&) {}  // NOLINT(runtime/explicit)
+
+  /*!
+   * \brief Allocate space for n objects of type T.
+   *  Only single-object requests are pooled.
+   */
+  T* allocate(std::size_t n) {
+    if (n == 1) {
+      FreeList* list = GetFreeList();
+      if (list->head != nullptr) {
+        Block* block = list->head;
+        list->head = block->next;
+        --list->size;
+        return reinterpret_cast<T*>(block);
+      }
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+  /*!
+   * \brief Return space for n objects of type T.
+   *  Single blocks go back to the calling thread's free list unless
+   *  the list is full.
+   */
+  void deallocate(T* ptr, std::size_t n) {
+    if (n == 1) {
+      FreeList* list = GetFreeList();
+      if (list->size < kMaxFreeListSize) {
+        Block* block = reinterpret_cast<Block*>(ptr);
+        block->next = list->head;
+        list->head = block;
+        ++list->size;
+        return;
+      }
+    }
+    ::operator delete(ptr);
+  }
+
+ private:
+  /*! \brief freed block, reusing the object storage for the link */
+  struct Block {
+    Block* next;
+  };
+  /*! \brief per-thread list of reusable blocks */
+  struct FreeList {
+    Block* head{nullptr};
+    std::size_t size{0};
+    ~FreeList() {
+      while (head != nullptr) {
+        Block* next = head->next;
+        ::operator delete(head);
+        head = next;
+      }
+    }
+  };
+  /*! \brief cap per thread; overflow goes back to the system allocator */
+  static constexpr std::size_t kMaxFreeListSize = 1 << 10;
+
+  static FreeList* GetFreeList() {
+    static thread_local FreeList list;
+    return &list;
+  }
+
+  static_assert(sizeof(T) >= sizeof(Block*), "type too small to pool");
+};
+
+template <typename T, typename U>
+inline bool operator==(const PooledThreadLocalAllocator<T>&,
+                       const PooledThreadLocalAllocator<U>&) {
+  return true;
+}
+template <typename T, typename U>
+inline bool operator!=(const PooledThreadLocalAllocator<T>&,
+                       const PooledThreadLocalAllocator<U>&) {
+  return false;
+}
+
+}  // namespace common
+}  // namespace mxnet
+
+#endif  // MXNET_POOLED_ALLOCATOR_H_
@@ -27,6 +27,8 @@
 
 #include <random>
 #include <new>
+#include <atomic>
+
 #include "./base.h"
 
 #if MXNET_USE_CUDA
@@ -41,6 +43,16 @@ namespace random {
 template<typename Device, typename DType MSHADOW_DEFAULT_DTYPE>
 class RandGenerator;
 
+/*!
+ * \brief Host-side ticket distinguishing counter-based sampling launches.
+ *  Every launch draws a fresh ticket, so the Philox streams derived from it
+ *  never overlap those of any other launch.
+ */
+inline uint32_t NextCounterTicket() {
+  static std::atomic<uint32_t> ticket(0);
+  return ++ticket;
+}
+
 template<typename DType>
 class RandGenerator<cpu, DType> {
  public:
@@ -93,11 +105,23 @@ class RandGenerator<cpu, DType> {
   }
 
   MSHADOW_XINLINE void Seed(mshadow::Stream<cpu> *, uint32_t seed) {
+    seed_ = seed;
     for (int i = 0; i < kNumRandomStates; ++i) (states_ + i)->seed(seed + i);
   }
 
+  // counter-based per-launch streams are a GPU feature; see the GPU class
+  static constexpr bool kCounterStreams = false;
+  MSHADOW_XINLINE void SetCounterTicket(uint32_t) {}
+
+  /*! \brief the seed the states were initialized with, for counter-based
+   *  consumers that derive their own streams from it */
+  uint32_t GetSeed() const {
+    return seed_;
+  }
+
  private:
   std::mt19937 *states_;
+  uint32_t seed_{0};
 };  // class RandGenerator<cpu, DType>
 
 template<typename DType>
@@ -129,12 +153,25 @@ class RandGenerator<gpu, DType> {
     // Copy state to local memory for efficiency.
     __device__ explicit Impl(RandGenerator<gpu, DType> *gen, int state_idx)
         : global_gen_(gen),
-          global_state_idx_(state_idx),
-          state_(*(gen->states_ + state_idx)) {}
+          global_state_idx_(state_idx) {
+      if (gen->use_counter_) {
+        // counter-based launch: derive a private Philox stream from the
+        // seed, the launch ticket and the thread id; the shared state
+        // array is neither read nor written back
+        curand_init(gen->seed_,
+                    (static_cast<uint64_t>(gen->ticket_) << 32) |
+                        static_cast<uint32_t>(state_idx),
+                    0, &state_);
+      } else {
+        state_ = *(gen->states_ + state_idx);
+      }
+    }
 
     __device__ ~Impl() {
       // store the curand state back into global memory
-      global_gen_->states_[global_state_idx_] = state_;
+      if (!global_gen_->use_counter_) {
+        global_gen_->states_[global_state_idx_] = state_;
+      }
     }
 
     MSHADOW_FORCE_INLINE __device__ int rand() {
@@ -165,8 +202,35 @@ class RandGenerator<gpu, DType> {
 
   void Seed(mshadow::Stream<gpu> *s, uint32_t seed);
 
+  // Philox is a counter-based generator, so per-launch streams can be
+  // derived without any shared state; see SetCounterTicket.
+  static constexpr bool kCounterStreams = true;
+
+  /*!
+   * \brief Switch this (by-value) copy of the generator to a counter-based
+   *  launch: kernel threads derive private Philox streams from the seed,
+   *  the given ticket and their thread id instead of loading and storing
+   *  the shared state array. Launch width is then unbounded.
+   */
+  MSHADOW_XINLINE void SetCounterTicket(uint32_t ticket) {
+    ticket_ = ticket;
+    use_counter_ = true;
+  }
+
+  /*! \brief the seed the states were initialized with, for counter-based
+   *  consumers that derive their own streams from it */
+  uint32_t GetSeed() const {
+    return seed_;
+  }
+
  private:
   curandStatePhilox4_32_10_t *states_;
+  // seed the shared states were initialized with, reused by counter launches
+  uint32_t seed_{0};
+  // per-launch ticket separating counter-based streams
+  uint32_t ticket_{0};
+  // whether this copy runs a counter-based launch
+  bool use_counter_{false};
 };  // class RandGenerator<gpu, DType>
 
 template<>
@@ -185,12 +249,23 @@ class RandGenerator<gpu, double> {
     // Copy state to local memory for efficiency.
     __device__ explicit Impl(RandGenerator<gpu, double> *gen, int state_idx)
         : global_gen_(gen),
-          global_state_idx_(state_idx),
-          state_(*(gen->states_ + state_idx)) {}
+          global_state_idx_(state_idx) {
+      if (gen->use_counter_) {
+        // counter-based launch; see RandGenerator<gpu, DType>::Impl
+        curand_init(gen->seed_,
+                    (static_cast<uint64_t>(gen->ticket_) << 32) |
+                        static_cast<uint32_t>(state_idx),
+                    0, &state_);
+      } else {
+        state_ = *(gen->states_ + state_idx);
+      }
+    }
 
     __device__ ~Impl() {
       // store the curand state back into global memory
-      global_gen_->states_[global_state_idx_] = state_;
+      if (!global_gen_->use_counter_) {
+        global_gen_->states_[global_state_idx_] = state_;
+      }
     }
 
     MSHADOW_FORCE_INLINE __device__ int rand() {
@@ -215,8 +290,24 @@ class RandGenerator<gpu, double> {
     curandStatePhilox4_32_10_t state_;
   };  // class RandGenerator<gpu, double>::Impl
 
+  static constexpr bool kCounterStreams = true;
+
+  MSHADOW_XINLINE void SetCounterTicket(uint32_t ticket) {
+    ticket_ = ticket;
+    use_counter_ = true;
+  }
+
+  uint32_t GetSeed() const {
+    return seed_;
+  }
+
  private:
+  // field layout must match RandGenerator<gpu, DType>, the resource holds
+  // one object that is cast between the instantiations
   curandStatePhilox4_32_10_t *states_;
+  uint32_t seed_{0};
+  uint32_t ticket_{0};
+  bool use_counter_{false};
 };  // class RandGenerator<gpu, double>
 
 #endif  // MXNET_USE_CUDA
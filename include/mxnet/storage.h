@@ -103,6 +103,31 @@ class Storage {
   * For non-pool memory managers this has no effect.
   */
   virtual void ReleaseAll(Context ctx) = 0;
+  /*!
+   * \brief Query pool statistics of the device's storage manager.
+   *
+   * All outputs are zero for devices without a pooled storage manager or
+   * whose manager has not been created yet.
+   *
+   * \param ctx Context information about the device and ID.
+   * \param used_bytes bytes handed out to live allocations, rounding included
+   * \param cached_bytes bytes held in the pool for reuse
+   * \param fragmentation_bytes bytes lost to size rounding across live allocations
+   */
+  virtual void GetMemoryPoolStats(Context ctx, size_t* used_bytes,
+                                  size_t* cached_bytes,
+                                  size_t* fragmentation_bytes) = 0;
+  /*!
+   * \brief Set a hard cap on the device bytes the pooled storage manager of
+   * the given device may hold, live and cached together. Allocations past
+   * the cap fail even if the device has free memory, so several processes
+   * can partition a device deterministically. 0 removes the cap. Takes
+   * effect immediately if the manager exists, otherwise when it is created.
+   *
+   * \param ctx Context information about the device and ID.
+   * \param cap_bytes the cap in bytes
+   */
+  virtual void SetMemoryPoolCap(Context ctx, size_t cap_bytes) = 0;
   /*!
    * \brief Destructor.
    */
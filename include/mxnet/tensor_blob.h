@@ -72,6 +72,12 @@ class TBlob {
   mxnet::TShape shape_;
   /*! \brief type flag of the tensor blob */
   int type_flag_;
+  /*!
+   * \brief explicit element strides per dimension; an empty shape means the
+   *  tensor is compact row-major. Only stride-aware kernels may consume a
+   *  non-compact TBlob; everything else must check CheckContiguous first.
+   */
+  mxnet::TShape strides_;
 
   /*! \brief default constructor, default copy assign will work */
   TBlob(void)
@@ -104,6 +110,22 @@ class TBlob {
       : dptr_(dptr), shape_(shape), type_flag_(type_flag) {
     SetDLTensor(dev_mask, dev_id);
   }
+  /*!
+   * \brief constructor that construct TBlob from strided memory
+   * \param dptr the pointer to the memory
+   * \param shape the shape of the data
+   * \param strides the element stride of each dimension
+   * \param dev_mask the device mask, can be cpu::kDevMask or gpu::kDevMask
+   * \param type_flag the type flag. Can be one of enum mshadow::dtype
+   * \param dev_id the device id
+   */
+  TBlob(void *dptr, const mxnet::TShape &shape, const mxnet::TShape &strides,
+        int dev_mask, int type_flag, int dev_id = -1)
+      : dptr_(dptr), shape_(shape), type_flag_(type_flag), strides_(strides) {
+    CHECK_EQ(strides_.ndim(), shape_.ndim())
+        << "strides must have one entry per dimension";
+    SetDLTensor(dev_mask, dev_id);
+  }
   /*!
    * \brief constructor that construct TBlob from DLTensor
    * \param DLTensor Object
@@ -113,26 +135,25 @@ class TBlob {
         shape_(mxnet::TShape(dltensor.shape, dltensor.shape + dltensor.ndim)),
         type_flag_(DLDataTypeTransform(dltensor.dtype)),
         dltensor_(dltensor) {
-    // compactness check for DLTensor
+    // record explicit strides when the DLTensor is not compact
     if (dltensor.strides != nullptr) {
-      // check strides
       const int &ndim = dltensor.ndim;
       const int64_t *shape = dltensor.shape;
       const int64_t *strides = dltensor.strides;
       if (ndim >= 1) {
-        bool err = false;
+        bool compact = true;
         if (strides[ndim - 1] != 1) {
-          err = true;
+          compact = false;
         } else {
           for (int i = ndim - 2; i >= 0; --i) {
             if (strides[i] != shape[i + 1] * strides[i + 1]) {
-              err = true;
+              compact = false;
               break;
             }
           }
         }
-        if (err) {
-          LOG(FATAL) << "Unsupported DLPack because MXNet only support compact tensor now";
+        if (!compact) {
+          strides_ = mxnet::TShape(strides, strides + ndim);
         }
       }
     }
@@ -152,7 +173,8 @@ class TBlob {
    * \brief constructor from TBlob (copy constructor)
    * \param src source TBlob
    */
-  TBlob(const TBlob &src): dptr_(src.dptr_), shape_(src.shape_), type_flag_(src.type_flag_) {
+  TBlob(const TBlob &src): dptr_(src.dptr_), shape_(src.shape_), type_flag_(src.type_flag_),
+                           strides_(src.strides_) {
     this->SetDLTensor(src.dev_mask(), src.dev_id());
   }
   /*!
@@ -168,6 +190,7 @@ class TBlob {
     dptr_ = src.dptr_;
     shape_ = src.shape_;
     type_flag_ = mshadow::DataType<DType>::kFlag;
+    strides_ = mxnet::TShape();
     SetDLTensor(Device::kDevMask, -1);
     return *this;
   }
@@ -180,6 +203,7 @@ class TBlob {
     dptr_ = src.dptr_;
     shape_ = src.shape_;
     type_flag_ = src.type_flag_;
+    strides_ = src.strides_;
     SetDLTensor(src.dev_mask(), src.dev_id());
     return *this;
   }
@@ -187,6 +211,12 @@ class TBlob {
    * \return whether the tensor's memory is continuous
    */
   inline bool CheckContiguous(void) const {
+    if (strides_.ndim() <= 0) return true;
+    dim_t expected = 1;
+    for (int i = shape_.ndim() - 1; i >= 0; --i) {
+      if (shape_[i] != 1 && strides_[i] != expected) return false;
+      expected *= shape_[i];
+    }
     return true;
   }
   /*!
@@ -195,8 +225,9 @@ class TBlob {
    * \return reshaped blob
    */
   inline TBlob reshape(const mxnet::TShape& shape) const {
-    CHECK_EQ(this->shape_.Size(), shape.Size()) << "Shape size mismatch "
+    MXNET_HOT_CHECK_EQ(this->shape_.Size(), shape.Size()) << "Shape size mismatch "
     << this->shape_.Size() << " v.s. "  << shape.Size();
+    MXNET_HOT_CHECK(CheckContiguous()) << "reshape requires a compact tensor";
     TBlob ret(this->dptr_, shape, this->dev_mask(), this->type_flag_, this->dev_id());
     return ret;
   }
@@ -210,9 +241,9 @@ class TBlob {
   template<typename Device, typename DType>
   inline mshadow::Tensor<Device, 2, DType> FlatTo2D(
     mshadow::Stream<Device> *stream = NULL) const {
-    CHECK(Device::kDevMask == this->dev_mask())
+    MXNET_HOT_CHECK(Device::kDevMask == this->dev_mask())
       << "TBlob.get: device type do not match specified type";
-    CHECK(mshadow::DataType<DType>::kFlag == type_flag_)
+    MXNET_HOT_CHECK(mshadow::DataType<DType>::kFlag == type_flag_)
       << "TBlob.get_with_shape: data type do not match specified type."
       << "Expected: " << type_flag_ << " v.s. given " << mshadow::DataType<DType>::kFlag;
     return mshadow::Tensor<Device, 2, DType>(static_cast<DType*>(dptr_),
@@ -252,7 +283,7 @@ class TBlob {
   /*! \brief get pointer in dtype */
   template<typename DType>
   inline DType* dptr() const {
-    CHECK(mshadow::DataType<DType>::kFlag == type_flag_)
+    MXNET_HOT_CHECK(mshadow::DataType<DType>::kFlag == type_flag_)
       << "TBlob.get_with_shape: data type do not match specified type."
       << "Expected: " << type_flag_ << " v.s. given " << mshadow::DataType<DType>::kFlag;
     return static_cast<DType*>(dptr_);
@@ -284,7 +315,7 @@ class TBlob {
    */
   template<typename Device, int dim, typename DType>
   inline mshadow::Tensor<Device, dim, DType> get(mshadow::Stream<Device> *stream = NULL) const {
-    CHECK(Device::kDevMask == this->dev_mask())
+    MXNET_HOT_CHECK(Device::kDevMask == this->dev_mask())
       << "TBlob.get: device type do not match specified type";
     return mshadow::Tensor<Device, dim, DType>(dptr<DType>(),
         shape_.get<dim>(), shape_[shape_.ndim() - 1], stream);
@@ -303,10 +334,10 @@ class TBlob {
   inline mshadow::Tensor<Device, dim, DType> get_with_shape(
       const mshadow::Shape<dim> &shape,
       mshadow::Stream<Device> *stream = NULL) const {
-    CHECK(Device::kDevMask == this->dev_mask())
+    MXNET_HOT_CHECK(Device::kDevMask == this->dev_mask())
       << "TBlob.get: device type do not match specified type";
-    CHECK_EQ(this->CheckContiguous(), true) << "TBlob.get_reshape: must be contiguous";
-    CHECK_EQ(this->shape_.Size(), static_cast<size_t>(shape.Size()))
+    MXNET_HOT_CHECK_EQ(this->CheckContiguous(), true) << "TBlob.get_reshape: must be contiguous";
+    MXNET_HOT_CHECK_EQ(this->shape_.Size(), static_cast<size_t>(shape.Size()))
       << "TBlob.get_with_shape: new and old shape do not match total elements";
     return mshadow::Tensor<Device, dim, DType>(dptr<DType>(), shape,
                                                shape[dim - 1], stream);
@@ -426,7 +457,7 @@ class TBlob {
     dltensor_.ndim = shape_.ndim();
     dltensor_.dtype = DTypeTransform(type_flag_);
     dltensor_.shape = shape_.data();
-    dltensor_.strides = nullptr;
+    dltensor_.strides = strides_.ndim() > 0 ? strides_.data() : nullptr;
     dltensor_.byte_offset = 0;
   }
 
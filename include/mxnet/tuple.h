@@ -357,8 +357,9 @@ class Tuple {
   inline bool Load(TStream *strm);
 
  protected:
-  // stack cache size
-  static const int kStackCache = 4;
+  // stack cache size; covers the 5-6D shapes common in video and NDHWC
+  // workloads, so shape inference temporaries stay off the heap
+  static const int kStackCache = 6;
   /*! \brief number of dimension of the tuple */
   int ndim_{0};
   /*! \brief number of cells allocated in data_heap_ */
@@ -86,6 +86,9 @@ USE_CUDNN = 0
 # whether to use NVTX when profiling
 USE_NVTX = 0
 
+# whether to decode JPEGs on the GPU with nvJPEG in the record iterators
+USE_NVJPEG = 0
+
 #whether to use NCCL library
 USE_NCCL = 0
 #add the path to NCCL library
@@ -188,6 +191,11 @@ USE_S3 = 0
 # Use operator tuning
 USE_OPERATOR_TUNING = 1
 
+# whether to keep per-call tensor validation checks (device/dtype/shape)
+# on the imperative hot path; set to 0 for release builds that rely on
+# the validation done by shape/dtype inference
+USE_HOTPATH_CHECKS = 1
+
 # Use gperftools if found
 # Disable because of #8968
 USE_GPERFTOOLS = 0
@@ -512,6 +512,29 @@ class Executor(object):
             self.handle, ctypes.byref(debug_str)))
         return py_str(debug_str.value)
 
+    def row_sparse_pull_plan(self):
+        """Get the row_sparse prefetch plan of the executor.
+
+        For each `row_sparse` parameter whose consumers gather rows named by a
+        graph input (e.g. the data input of an Embedding), the plan records the
+        name of that input. A frontend can use it to pull exactly the needed
+        parameter rows from a KVStore as soon as the index data of a batch is
+        known, overlapping the fetch with upstream compute.
+
+        Returns
+        -------
+        plan : dict of str -> str
+            Mapping from `row_sparse` parameter name to index input name.
+        """
+        num_pairs = mx_uint()
+        param_names = ctypes.POINTER(ctypes.c_char_p)()
+        index_names = ctypes.POINTER(ctypes.c_char_p)()
+        check_call(_LIB.MXExecutorGetRowSparsePullPlan(
+            self.handle, ctypes.byref(num_pairs),
+            ctypes.byref(param_names), ctypes.byref(index_names)))
+        return {py_str(param_names[i]): py_str(index_names[i])
+                for i in range(num_pairs.value)}
+
     def get_optimized_symbol(self):
         """Get an optimized version of the symbol from the executor.
 
@@ -122,6 +122,7 @@ class Module(BaseModule):
         self._exec_group = None
         self._data_shapes = None
         self._label_shapes = None
+        self._rsp_pull_plan = None
 
     @staticmethod
     def load(prefix, epoch, load_optimizer_states=False, **kwargs):
@@ -190,6 +191,7 @@ class Module(BaseModule):
         self._exec_group = None
         self._data_shapes = None
         self._label_shapes = None
+        self._rsp_pull_plan = None
 
     @property
     def data_names(self):
@@ -849,6 +851,10 @@ class Module(BaseModule):
             str -> NDArray. The resulting dict is used for pulling row_sparse
             parameters from the kvstore, where the str key is the name of the param,
             and the value is the row id of the param to pull.
+            When no callback is given, `row_sparse` parameters whose consumers
+            gather rows named by a data input (e.g. the indices of an Embedding)
+            are pulled automatically using that input's values from `data_batch`,
+            based on the bound executor's prefetch plan.
         '''
         assert self.binded
         if sparse_row_id_fn is not None:
@@ -868,3 +874,22 @@ class Module(BaseModule):
                     else:
                         self._kvstore.row_sparse_pull(param_name, param_val, row_ids=row_id,
                                                       priority=-param_idx)
+        elif self._kvstore and self._update_on_kvstore:
+            # without an explicit callback, pull according to the executor's
+            # prefetch plan: the rows a parameter's consumers gather are named
+            # by a data input, so issuing the pull here lets the network fetch
+            # overlap all compute that does not depend on the parameter
+            if self._rsp_pull_plan is None:
+                plan = self._exec_group.execs[0].row_sparse_pull_plan()
+                self._rsp_pull_plan = {
+                    param: index for param, index in plan.items()
+                    if param in self._exec_group.param_names and index in self._data_names}
+            for param_name, index_name in self._rsp_pull_plan.items():
+                param_idx = self._exec_group.param_names.index(param_name)
+                param_val = self._exec_group.param_arrays[param_idx]
+                if param_val[0].stype != 'row_sparse':
+                    continue
+                row_id = data_batch.data[self._data_names.index(index_name)]
+                row_id = row_id.reshape((-1,)).astype('int64')
+                self._kvstore.row_sparse_pull(param_name, param_val, row_ids=row_id,
+                                              priority=-param_idx)
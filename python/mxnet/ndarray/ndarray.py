@@ -2549,7 +2549,7 @@ fixed-size items.
             raise ValueError("The current array is not a scalar")
         return self.asnumpy()[0]
 
-    def astype(self, dtype, copy=True):
+    def astype(self, dtype, copy=True, ctx=None):
         """Returns a copy of the array after casting to a specified type.
 
         Parameters
@@ -2560,7 +2560,14 @@ fixed-size items.
             Default `True`. By default, astype always returns a newly
             allocated ndarray on the same context. If this is set to
             `False`, and the dtype requested is the same as the ndarray's
-            dtype, the ndarray is returned instead of a copy.
+            dtype and the context matches, the ndarray is returned instead
+            of a copy.
+        ctx : Context, optional
+            Device context of the returned array. Defaults to the context
+            of this array. When a different context is given, the cast and
+            the device transfer are fused into one pass over the data,
+            which is cheaper than chaining ``astype`` and
+            ``as_in_context``.
 
         Returns
         -------
@@ -2576,11 +2583,13 @@ fixed-size items.
         >>> y.dtype
         <type 'numpy.int32'>
         """
+        if ctx is None:
+            ctx = self.context
 
-        if not copy and np.dtype(dtype) == self.dtype:
+        if not copy and np.dtype(dtype) == self.dtype and ctx == self.context:
             return self
 
-        res = empty(self.shape, ctx=self.context, dtype=dtype)
+        res = empty(self.shape, ctx=ctx, dtype=dtype)
         self.copyto(res)
         return res
 
@@ -25,6 +25,7 @@
 #include <vector>
 #include <sstream>
 #include <string>
+#include <atomic>
 #include <mutex>
 #include <memory>
 #include <functional>
@@ -51,7 +52,12 @@
 #include "../operator/custom/custom-inl.h"
 #include "../operator/tensor/matrix_op-inl.h"
 #include "../operator/tvmop/op_module.h"
+#include "../common/temp_space_arena.h"
 #include "../common/utils.h"
+#include "../engine/exec_trace.h"
+#include "../engine/dep_graph.h"
+#include "../profiler/runtime_stats.h"
+#include "../io/iter_push.h"
 
 using namespace mxnet;
 
@@ -134,6 +140,21 @@ int MXNotifyShutdown() {
   API_END();
 }
 
+int MXEngineStop() {
+  API_BEGIN();
+  mxnet::op::custom::CustomOperator::Get()->Stop();
+  Engine::Get()->WaitForAll();
+  Engine::Get()->Stop();
+  API_END();
+}
+
+int MXEngineRestart() {
+  API_BEGIN();
+  Engine::Get()->Start();
+  mxnet::op::custom::CustomOperator::Get()->Start();
+  API_END();
+}
+
 int MXSetNumOMPThreads(int thread_num) {
   API_BEGIN();
   omp_set_num_threads(thread_num);
@@ -146,6 +167,30 @@ int MXEngineSetBulkSize(int bulk_size, int* prev_bulk_size) {
   API_END();
 }
 
+int MXEngineDumpExecTrace(const char** out_trace) {
+  API_BEGIN();
+  MXAPIThreadLocalEntry<>* ret = MXAPIThreadLocalStore<>::Get();
+  ret->ret_str = mxnet::engine::EngineExecTrace::Get()->Dump();
+  *out_trace = ret->ret_str.c_str();
+  API_END();
+}
+
+int MXRuntimeStatsDump(const char** out_stats, int reset) {
+  API_BEGIN();
+  MXAPIThreadLocalEntry<>* ret = MXAPIThreadLocalStore<>::Get();
+  ret->ret_str = mxnet::profiler::RuntimeStats::Get()->Dump(reset != 0);
+  *out_stats = ret->ret_str.c_str();
+  API_END();
+}
+
+int MXEngineDumpDependencyGraph(const char** out_graph) {
+  API_BEGIN();
+  MXAPIThreadLocalEntry<>* ret = MXAPIThreadLocalStore<>::Get();
+  ret->ret_str = mxnet::engine::EngineDepGraph::Get()->DumpDot();
+  *out_graph = ret->ret_str.c_str();
+  API_END();
+}
+
 int MXGetGPUCount(int* out) {
   API_BEGIN();
   *out = Context::GetGPUCount();
@@ -344,6 +389,44 @@ int MXNDArraySyncCopyToCPU(NDArrayHandle handle,
   API_END();
 }
 
+int MXNDArrayAsyncCopyToCPU(NDArrayHandle handle,
+                            void *data,
+                            size_t size,
+                            MXNDArrayCopyCompleteCallback callback,
+                            void *callback_arg) {
+  API_BEGIN();
+  static_cast<NDArray*>(handle)->AsyncCopyToCPU(data, size,
+    [callback, callback_arg]() {
+      callback(callback_arg);
+    });
+  API_END();
+}
+
+int MXNDArrayAsyncCopyToCPUBatch(uint32_t num,
+                                 NDArrayHandle *handles,
+                                 void **data,
+                                 const size_t *sizes,
+                                 MXNDArrayCopyCompleteCallback callback,
+                                 void *callback_arg) {
+  API_BEGIN();
+  if (num == 0) {
+    callback(callback_arg);
+  } else {
+    // the copies run independently on their own streams; the last one to
+    // finish fires the user callback
+    auto remaining = std::make_shared<std::atomic<uint32_t> >(num);
+    for (uint32_t i = 0; i < num; ++i) {
+      static_cast<NDArray*>(handles[i])->AsyncCopyToCPU(data[i], sizes[i],
+        [remaining, callback, callback_arg]() {
+          if (remaining->fetch_sub(1) == 1) {
+            callback(callback_arg);
+          }
+        });
+    }
+  }
+  API_END();
+}
+
 /*!
  * \brief Copy src.data() to dst.data() if i = -1, else dst.aux_data(i) if i >= 0
  * This function blocks. Do not use it in performance critical code.
@@ -383,6 +466,11 @@ int MXNDArrayWaitToWrite(NDArrayHandle handle) {
 int MXNDArrayWaitAll() {
   API_BEGIN();
   Engine::Get()->WaitForAll();
+  // the engine is quiescent here, so it is safe to rewind the per-thread
+  // temp space arenas for the next iteration
+  if (mxnet::common::TempSpaceArena::Enabled()) {
+    mxnet::common::TempSpaceArena::ResetAll();
+  }
   API_END();
 }
 
@@ -409,6 +497,33 @@ int MXNDArraySave(const char* fname,
   API_END();
 }
 
+int MXNDArraySaveAsync(const char* fname,
+                       uint32_t num_args,
+                       NDArrayHandle* args,
+                       const char** keys,
+                       int delta_only) {
+  API_BEGIN();
+  std::vector<NDArray> data(num_args);
+  std::vector<std::string> names;
+  for (uint32_t i = 0; i < num_args; ++i) {
+    data[i] = *static_cast<NDArray*>(args[i]);
+  }
+  if (keys != nullptr) {
+    names.resize(num_args);
+    for (uint32_t i = 0; i < num_args; ++i) {
+      names[i] = keys[i];
+    }
+  }
+  mxnet::NDArray::SaveAsync(fname, data, names, delta_only != 0);
+  API_END();
+}
+
+int MXNDArraySaveAsyncWaitAll() {
+  API_BEGIN();
+  mxnet::NDArray::WaitAllSaveAsync();
+  API_END();
+}
+
 int MXNDArrayLoad(const char* fname,
                   uint32_t *out_size,
                   NDArrayHandle** out_arr,
@@ -419,7 +534,7 @@ int MXNDArrayLoad(const char* fname,
   API_BEGIN();
   std::vector<NDArray> data;
   std::vector<std::string> &names = ret->ret_vec_str;
-  {
+  if (!mxnet::NDArray::LoadMemoryMapped(fname, &data, &names)) {
     std::unique_ptr<dmlc::Stream> fi(dmlc::Stream::Create(fname, "r"));
     mxnet::NDArray::Load(fi.get(), &data, &names);
   }
@@ -983,6 +1098,29 @@ int MXDataIterGetPadNum(DataIterHandle handle, int *pad) {
   API_END();
 }
 
+int MXDataIterPushNDArray(DataIterHandle handle,
+                          NDArrayHandle data,
+                          NDArrayHandle label,
+                          int pad) {
+  API_BEGIN();
+  auto *iter = dynamic_cast<mxnet::io::PushDataIter*>(
+      static_cast<IIterator<DataBatch>* >(handle));
+  CHECK(iter != nullptr)
+      << "MXDataIterPushNDArray: the iterator is not a PushIter";
+  iter->Push(*static_cast<NDArray*>(data), *static_cast<NDArray*>(label), pad);
+  API_END();
+}
+
+int MXDataIterPushEndOfData(DataIterHandle handle) {
+  API_BEGIN();
+  auto *iter = dynamic_cast<mxnet::io::PushDataIter*>(
+      static_cast<IIterator<DataBatch>* >(handle));
+  CHECK(iter != nullptr)
+      << "MXDataIterPushEndOfData: the iterator is not a PushIter";
+  iter->SignalEndOfData();
+  API_END();
+}
+
 int MXKVStoreCreate(const char *type,
                     KVStoreHandle *out) {
   API_BEGIN();
@@ -1004,6 +1142,12 @@ int MXKVStoreSetGradientCompression(KVStoreHandle handle, uint32_t num_params,
   API_END();
 }
 
+int MXKVStoreSetGradientClipping(KVStoreHandle handle, float max_norm) {
+  API_BEGIN();
+  static_cast<KVStore*>(handle)->SetGradientClipping(max_norm);
+  API_END();
+}
+
 int MXKVStoreFree(KVStoreHandle handle) {
   API_BEGIN();
   delete static_cast<KVStore*>(handle);
@@ -1620,6 +1764,26 @@ int MXNDArrayCreateFromSharedMemEx(int shared_pid, int shared_id, const int *sha
   API_END();
 }
 
+int MXNDArrayCreateFromBuffer(void* data, const uint32_t* shape, uint32_t ndim,
+                              int dev_type, int dev_id, int dtype,
+                              NDArrayBufferDeleter deleter, void* deleter_param,
+                              NDArrayHandle* out) {
+  API_BEGIN();
+  CHECK(data != nullptr) << "Cannot wrap a null buffer";
+  mxnet::TShape requested_shape(shape, shape + ndim);
+  const int dev_mask =
+      dev_type == Context::kGPU ? gpu::kDevMask : cpu::kDevMask;
+  TBlob blob(data, requested_shape, dev_mask, dtype, dev_id);
+  if (deleter != nullptr) {
+    *out = new NDArray(blob, dev_id, [deleter, data, deleter_param]() {
+        deleter(data, deleter_param);
+      });
+  } else {
+    *out = new NDArray(blob, dev_id);
+  }
+  API_END();
+}
+
 typedef Engine::VarHandle VarHandle;
 typedef Engine::CallbackOnComplete CallbackOnComplete;
 
@@ -1669,6 +1833,110 @@ int MXEnginePushAsync(EngineAsyncFunc async_func, void* func_param,
   API_END();
 }
 
+int MXEngineTryPushAsync(EngineAsyncFunc async_func, void* func_param,
+                         EngineFuncParamDeleter deleter, ContextHandle ctx_handle,
+                         EngineVarHandle const_vars_handle, int num_const_vars,
+                         EngineVarHandle mutable_vars_handle, int num_mutable_vars,
+                         EngineFnPropertyHandle prop_handle, int priority,
+                         const char* opr_name, bool wait,
+                         int* out_accepted) {
+  API_BEGIN();
+
+  auto exec_ctx = *static_cast<const Context*>(ctx_handle);
+  auto const_vars = static_cast<VarHandle*>(const_vars_handle);
+  auto mutable_vars = static_cast<VarHandle*>(mutable_vars_handle);
+  auto prop = FnProperty::kNormal;
+  if (prop_handle) {
+    prop = *static_cast<const FnProperty*>(prop_handle);
+  }
+
+  Engine::AsyncFn exec_fn;
+  if (deleter == nullptr) {
+    exec_fn = [async_func, func_param](RunContext rctx,
+                                       CallbackOnComplete on_complete) {
+      async_func(&rctx, &on_complete, func_param);
+    };
+  } else {
+    // Wrap func_param in a shared_ptr with deleter such that deleter
+    // will be called when the lambda goes out of scope; on a rejected
+    // push the lambda is destroyed here, so the caller's param is freed
+    // either way.
+    std::shared_ptr<void> shared_func_param(func_param, deleter);
+    exec_fn = [async_func, shared_func_param](RunContext rctx,
+                                              CallbackOnComplete on_complete) {
+      async_func(&rctx, &on_complete, shared_func_param.get());
+    };
+  }
+
+  AssertValidNumberVars(num_const_vars, num_mutable_vars);
+  std::vector<VarHandle> const_var_vec(const_vars, const_vars + num_const_vars);
+  std::vector<VarHandle> mutable_var_vec(mutable_vars, mutable_vars + num_mutable_vars);
+  const bool accepted =
+      Engine::Get()->TryPushAsync(exec_fn, exec_ctx, const_var_vec, mutable_var_vec,
+                                  prop, priority, opr_name, wait);
+  *out_accepted = accepted ? 1 : 0;
+
+  API_END();
+}
+
+int MXEnginePushAsyncBatch(int num_oprs,
+                           EngineAsyncFunc* async_funcs, void** func_params,
+                           EngineFuncParamDeleter* deleters,
+                           ContextHandle ctx_handle,
+                           EngineVarHandle const_vars_handle,
+                           const int* num_const_vars,
+                           EngineVarHandle mutable_vars_handle,
+                           const int* num_mutable_vars,
+                           EngineFnPropertyHandle prop_handle, int priority,
+                           const char* opr_name) {
+  API_BEGIN();
+
+  CHECK_GE(num_oprs, 0) << "Non-negative number of operations expected.";
+  auto exec_ctx = *static_cast<const Context*>(ctx_handle);
+  auto const_vars = static_cast<VarHandle*>(const_vars_handle);
+  auto mutable_vars = static_cast<VarHandle*>(mutable_vars_handle);
+  auto prop = FnProperty::kNormal;
+  if (prop_handle) {
+    prop = *static_cast<const FnProperty*>(prop_handle);
+  }
+
+  std::vector<Engine::AsyncOprEntry> entries(num_oprs);
+  size_t const_offset = 0, mutable_offset = 0;
+  for (int i = 0; i < num_oprs; ++i) {
+    EngineAsyncFunc async_func = async_funcs[i];
+    void* func_param = func_params ? func_params[i] : nullptr;
+    EngineFuncParamDeleter deleter = deleters ? deleters[i] : nullptr;
+    Engine::AsyncOprEntry& entry = entries[i];
+    if (deleter == nullptr) {
+      entry.exec_fun = [async_func, func_param](RunContext rctx,
+                                                CallbackOnComplete on_complete) {
+        async_func(&rctx, &on_complete, func_param);
+      };
+    } else {
+      // Wrap func_param in a shared_ptr with deleter such that deleter
+      // will be called when the lambda goes out of scope.
+      std::shared_ptr<void> shared_func_param(func_param, deleter);
+      entry.exec_fun = [async_func, shared_func_param](RunContext rctx,
+                                                       CallbackOnComplete on_complete) {
+        async_func(&rctx, &on_complete, shared_func_param.get());
+      };
+    }
+    AssertValidNumberVars(num_const_vars[i], num_mutable_vars[i]);
+    entry.const_vars.assign(const_vars + const_offset,
+                            const_vars + const_offset + num_const_vars[i]);
+    entry.mutable_vars.assign(mutable_vars + mutable_offset,
+                              mutable_vars + mutable_offset + num_mutable_vars[i]);
+    const_offset += num_const_vars[i];
+    mutable_offset += num_mutable_vars[i];
+    entry.prop = prop;
+    entry.priority = priority;
+    entry.opr_name = opr_name;
+  }
+  Engine::Get()->PushAsyncBatch(&entries, exec_ctx);
+
+  API_END();
+}
+
 int MXEnginePushSync(EngineSyncFunc sync_func, void* func_param,
                      EngineFuncParamDeleter deleter, ContextHandle ctx_handle,
                      EngineVarHandle const_vars_handle, int num_const_vars,
@@ -1755,6 +2023,27 @@ int MXStorageEmptyCache(int dev_type, int dev_id) {
   API_END();
 }
 
+int MXStorageGetMemoryPoolStats(int dev_type, int dev_id,
+                                uint64_t* used_bytes,
+                                uint64_t* cached_bytes,
+                                uint64_t* fragmentation_bytes) {
+  API_BEGIN();
+  Context ctx = Context::Create(static_cast<Context::DeviceType>(dev_type), dev_id);
+  size_t used, cached, fragmentation;
+  Storage::Get()->GetMemoryPoolStats(ctx, &used, &cached, &fragmentation);
+  *used_bytes = used;
+  *cached_bytes = cached;
+  *fragmentation_bytes = fragmentation;
+  API_END();
+}
+
+int MXStorageSetMemoryPoolCap(int dev_type, int dev_id, uint64_t cap_bytes) {
+  API_BEGIN();
+  Context ctx = Context::Create(static_cast<Context::DeviceType>(dev_type), dev_id);
+  Storage::Get()->SetMemoryPoolCap(ctx, static_cast<size_t>(cap_bytes));
+  API_END();
+}
+
 int MXShallowCopyNDArray(NDArrayHandle src_handle, NDArrayHandle* out) {
   NDArray* ret = nullptr;
   API_BEGIN();
@@ -41,6 +41,35 @@ int MXExecutorPrint(ExecutorHandle handle, const char **out_str) {
   API_END();
 }
 
+int MXExecutorGetRowSparsePullPlan(ExecutorHandle handle,
+                                   uint32_t *num_pairs,
+                                   const char ***param_names,
+                                   const char ***index_names) {
+  Executor *exec = static_cast<Executor*>(handle);
+  MXAPIThreadLocalEntry<> *ret = MXAPIThreadLocalStore<>::Get();
+  API_BEGIN();
+  const auto& plan = exec->row_sparse_pull_plan();
+  const size_t num = plan.size();
+  ret->ret_vec_str.clear();
+  ret->ret_vec_str.reserve(num * 2);
+  // parameter names first, index names in the second half
+  for (const auto& kv : plan) {
+    ret->ret_vec_str.push_back(kv.first);
+  }
+  for (size_t i = 0; i < num; ++i) {
+    ret->ret_vec_str.push_back(plan.at(ret->ret_vec_str[i]));
+  }
+  ret->ret_vec_charp.clear();
+  ret->ret_vec_charp.reserve(num * 2);
+  for (const auto& s : ret->ret_vec_str) {
+    ret->ret_vec_charp.push_back(s.c_str());
+  }
+  *num_pairs = static_cast<uint32_t>(num);
+  *param_names = dmlc::BeginPtr(ret->ret_vec_charp);
+  *index_names = dmlc::BeginPtr(ret->ret_vec_charp) + num;
+  API_END();
+}
+
 int MXExecutorFree(ExecutorHandle handle) {
   API_BEGIN();
   delete static_cast<Executor*>(handle);
@@ -29,9 +29,17 @@
 #include <mxnet/operator_util.h>
 #include <mxnet/op_attr_types.h>
 #include <mxnet/imperative.h>
+#include <mxnet/kvstore.h>
 #include <nnvm/node.h>
 #include <nnvm/op_attr_types.h>
+#include <dmlc/concurrency.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 #include "./c_api_common.h"
 #include "../common/utils.h"
 #include "../common/exec_utils.h"
@@ -158,6 +166,156 @@ int MXImperativeInvokeEx(AtomicSymbolCreator creator,
   API_END();
 }
 
+namespace {
+
+/*!
+ * \brief Command queue decoupling the frontend from imperative dispatch.
+ *
+ * MXImperativeInvokeAsync packs the call into a command and returns
+ * placeholder output handles right away; a dedicated dispatcher thread
+ * drains the queue into Imperative::Invoke. The frontend thus pays only
+ * for argument packing per call and can run ahead of shape inference and
+ * graph construction, which is what small-op-dominated workloads need.
+ * Inputs are held by value so the frontend may drop its references while
+ * a command is in flight; output handles stay owned by the frontend and
+ * must not be freed before the queue is flushed.
+ */
+class ImperativeInvokeRing {
+ public:
+  struct Command {
+    nnvm::NodeAttrs attrs;
+    std::vector<NDArray> inputs;
+    // visible outputs are owned by the frontend, hidden ones by the command
+    std::vector<NDArray*> outputs;
+    int num_visible_outputs;
+    // the autograd flags are thread-local and have to travel with the call
+    bool recording;
+    bool training;
+  };
+
+  static ImperativeInvokeRing* Get() {
+    static ImperativeInvokeRing inst;
+    return &inst;
+  }
+
+  void Push(Command* cmd) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++pending_;
+    }
+    queue_.Push(cmd);
+  }
+
+  /*! \brief wait until the queue has drained, then rethrow the first error */
+  void Flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return pending_ == 0; });
+    if (exception_) {
+      auto eptr = exception_;
+      exception_ = nullptr;
+      std::rethrow_exception(eptr);
+    }
+  }
+
+ private:
+  ImperativeInvokeRing() {
+    dispatcher_ = std::thread([this]() { this->DispatchLoop(); });
+  }
+
+  ~ImperativeInvokeRing() {
+    queue_.SignalForKill();
+    dispatcher_.join();
+  }
+
+  void DispatchLoop() {
+    Command* cmd = nullptr;
+    while (queue_.Pop(&cmd)) {
+      std::unique_ptr<Command> guard(cmd);
+      try {
+        Imperative::Get()->set_is_recording(cmd->recording);
+        Imperative::Get()->set_is_training(cmd->training);
+        std::vector<NDArray*> ndinputs;
+        ndinputs.reserve(cmd->inputs.size());
+        for (NDArray& nd : cmd->inputs) ndinputs.push_back(&nd);
+        auto state = Imperative::Get()->Invoke(Context::CPU(), cmd->attrs,
+                                               ndinputs, cmd->outputs);
+        if (cmd->recording) {
+          Imperative::Get()->RecordOp(std::move(cmd->attrs), ndinputs,
+                                      cmd->outputs, state);
+        }
+      } catch (const dmlc::Error&) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!exception_) exception_ = std::current_exception();
+      }
+      for (size_t i = cmd->num_visible_outputs; i < cmd->outputs.size(); ++i) {
+        delete cmd->outputs[i];
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --pending_;
+      }
+      cv_.notify_all();
+    }
+  }
+
+  dmlc::ConcurrentBlockingQueue<Command*> queue_;
+  std::thread dispatcher_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t pending_{0};
+  std::exception_ptr exception_{nullptr};
+};
+
+}  // namespace
+
+int MXImperativeInvokeAsync(AtomicSymbolCreator creator,
+                            int num_inputs,
+                            NDArrayHandle *inputs,
+                            int *num_outputs,
+                            NDArrayHandle **outputs,
+                            int num_params,
+                            const char **param_keys,
+                            const char **param_vals) {
+  const nnvm::Op* op = static_cast<nnvm::Op*>(creator);
+  MXAPIThreadLocalEntry<> *ret = MXAPIThreadLocalStore<>::Get();
+  API_BEGIN();
+  nnvm::NodeAttrs attrs = imperative::ParseAttrs(op, num_inputs, num_params,
+                                                 param_keys, param_vals);
+
+  int infered_num_outputs;
+  int num_visible_outputs;
+  imperative::SetNumOutputs(op, attrs, num_inputs, &infered_num_outputs, &num_visible_outputs);
+
+  std::vector<NDArray*> ndinputs, ndoutputs;
+  SetNDInputsOutputs(op, &ndinputs, &ndoutputs, num_inputs, inputs,
+      num_outputs, infered_num_outputs, num_visible_outputs, outputs);
+
+  auto cmd = std::unique_ptr<ImperativeInvokeRing::Command>(
+      new ImperativeInvokeRing::Command());
+  cmd->attrs = std::move(attrs);
+  cmd->inputs.reserve(ndinputs.size());
+  for (NDArray* nd : ndinputs) cmd->inputs.push_back(*nd);
+  cmd->outputs = std::move(ndoutputs);
+  cmd->num_visible_outputs = *num_outputs;
+  cmd->recording = Imperative::Get()->is_recording();
+  cmd->training = Imperative::Get()->is_training();
+
+  if (*outputs == nullptr) {
+    ret->ret_handles.clear();
+    ret->ret_handles.reserve(*num_outputs);
+    for (int i = 0; i < *num_outputs; ++i) ret->ret_handles.push_back(cmd->outputs[i]);
+    *outputs = reinterpret_cast<NDArrayHandle*>(dmlc::BeginPtr(ret->ret_handles));
+  }
+  ImperativeInvokeRing::Get()->Push(cmd.release());
+  API_END();
+}
+
+int MXImperativeFlushAsync() {
+  API_BEGIN();
+  ImperativeInvokeRing::Get()->Flush();
+  API_END();
+}
+
 int MXCreateCachedOp(SymbolHandle handle,
                      CachedOpHandle *out) {
   nnvm::Symbol* sym = static_cast<nnvm::Symbol*>(handle);
@@ -258,6 +416,128 @@ int MXInvokeCachedOpEx(CachedOpHandle handle,
   API_END();
 }
 
+int MXCachedOpParallelStep(int num_replicas,
+                           CachedOpHandle *op_handles,
+                           int num_inputs,
+                           NDArrayHandle *inputs,
+                           int num_outputs,
+                           NDArrayHandle *outputs,
+                           int num_params,
+                           NDArrayHandle *params,
+                           NDArrayHandle *grads,
+                           const int *param_keys,
+                           KVStoreHandle kv_handle) {
+  API_BEGIN();
+  CHECK_GT(num_replicas, 0);
+  // forward every replica under recording, then backward every replica.
+  // All of this only queues work on the engine; the actual device compute,
+  // reduction and update overlap according to their data dependencies.
+  const bool prev_recording = Imperative::Get()->set_is_recording(true);
+  const bool prev_training = Imperative::Get()->set_is_training(true);
+  for (int r = 0; r < num_replicas; ++r) {
+    CachedOpPtr op = *static_cast<CachedOpPtr*>(op_handles[r]);
+    CHECK_EQ(op->num_outputs(), num_outputs)
+        << "CachedOp expects " << op->num_outputs() << " outputs, but "
+        << num_outputs << " was given.";
+    std::vector<NDArray*> ndinputs, ndoutputs;
+    ndinputs.reserve(num_inputs);
+    ndoutputs.reserve(num_outputs);
+    for (int i = 0; i < num_inputs; ++i) {
+      ndinputs.push_back(reinterpret_cast<NDArray*>(inputs[r * num_inputs + i]));
+    }
+    for (int i = 0; i < num_outputs; ++i) {
+      ndoutputs.push_back(reinterpret_cast<NDArray*>(outputs[r * num_outputs + i]));
+    }
+    op->Forward(op, ndinputs, ndoutputs);
+  }
+  for (int r = 0; r < num_replicas; ++r) {
+    std::vector<NDArray*> heads;
+    heads.reserve(num_outputs);
+    for (int i = 0; i < num_outputs; ++i) {
+      heads.push_back(reinterpret_cast<NDArray*>(outputs[r * num_outputs + i]));
+    }
+    // null head gradients stand for ones, like autograd.backward
+    std::vector<NDArray*> ograds(num_outputs, nullptr);
+    Imperative::Get()->Backward(heads, ograds, std::vector<NDArray*>(),
+                                true, false, false);
+  }
+  Imperative::Get()->set_is_recording(prev_recording);
+  Imperative::Get()->set_is_training(prev_training);
+
+  if (kv_handle != nullptr && params != nullptr && grads != nullptr &&
+      param_keys != nullptr) {
+    KVStore* kv = static_cast<KVStore*>(kv_handle);
+    // one push/pull group per parameter so each reduction only waits for
+    // that parameter's gradients; later parameters get higher priority
+    // since backward produces their gradients first
+    for (int p = 0; p < num_params; ++p) {
+      std::vector<int> keys(num_replicas, param_keys[p]);
+      std::vector<NDArray> grad_vals;
+      std::vector<NDArray*> param_ptrs;
+      grad_vals.reserve(num_replicas);
+      param_ptrs.reserve(num_replicas);
+      for (int r = 0; r < num_replicas; ++r) {
+        grad_vals.push_back(*reinterpret_cast<NDArray*>(grads[r * num_params + p]));
+        param_ptrs.push_back(reinterpret_cast<NDArray*>(params[r * num_params + p]));
+      }
+      kv->Push(keys, grad_vals, p);
+      kv->Pull(keys, param_ptrs, p, true);
+    }
+  }
+  API_END();
+}
+
+int MXCachedOpMicroBatchStep(CachedOpHandle handle,
+                             int num_micro_batches,
+                             int num_inputs,
+                             NDArrayHandle *inputs,
+                             int num_outputs,
+                             NDArrayHandle *outputs) {
+  API_BEGIN();
+  CHECK_GT(num_micro_batches, 0);
+  CachedOpPtr op = *static_cast<CachedOpPtr*>(handle);
+  CHECK_EQ(op->num_outputs(), num_outputs)
+      << "CachedOp expects " << op->num_outputs() << " outputs, but "
+      << num_outputs << " was given.";
+  const bool prev_recording = Imperative::Get()->set_is_recording(true);
+  const bool prev_training = Imperative::Get()->set_is_training(true);
+  auto forward = [&](int k) {
+    std::vector<NDArray*> ndinputs, ndoutputs;
+    ndinputs.reserve(num_inputs);
+    ndoutputs.reserve(num_outputs);
+    for (int i = 0; i < num_inputs; ++i) {
+      ndinputs.push_back(reinterpret_cast<NDArray*>(inputs[k * num_inputs + i]));
+    }
+    for (int i = 0; i < num_outputs; ++i) {
+      ndoutputs.push_back(reinterpret_cast<NDArray*>(outputs[k * num_outputs + i]));
+    }
+    op->Forward(op, ndinputs, ndoutputs);
+  };
+  auto backward = [&](int k) {
+    std::vector<NDArray*> heads;
+    heads.reserve(num_outputs);
+    for (int i = 0; i < num_outputs; ++i) {
+      heads.push_back(reinterpret_cast<NDArray*>(outputs[k * num_outputs + i]));
+    }
+    // null head gradients stand for ones, like autograd.backward
+    std::vector<NDArray*> ograds(num_outputs, nullptr);
+    Imperative::Get()->Backward(heads, ograds, std::vector<NDArray*>(),
+                                true, false, false);
+  };
+  // software pipeline: queue micro-batch k+1's forward before micro-batch
+  // k's backward so the engine always has an independent subgraph in
+  // flight while gradient accumulation of the previous slice drains
+  forward(0);
+  for (int k = 1; k < num_micro_batches; ++k) {
+    forward(k);
+    backward(k - 1);
+  }
+  backward(num_micro_batches - 1);
+  Imperative::Get()->set_is_recording(prev_recording);
+  Imperative::Get()->set_is_training(prev_training);
+  API_END();
+}
+
 int MXAutogradIsTraining(bool* curr) {
   API_BEGIN();
   *curr = Imperative::Get()->is_training();
@@ -30,9 +30,12 @@
 #include <dmlc/logging.h>
 #include <dmlc/thread_group.h>
 #include <mxnet/kvstore.h>
+#include <fstream>
 #include <stack>
+#include <string>
 #include "./c_api_common.h"
 #include "../profiler/profiler.h"
+#include "../profiler/storage_profiler.h"
 
 namespace mxnet {
 
@@ -323,12 +326,18 @@ int MXAggregateProfileStatsPrintEx(const char **out_str, int reset, int format,
     std::shared_ptr<profiler::AggregateStats> stats = profiler->GetAggregateStats();
     std::ostringstream os;
     if (stats) {
-      if (static_cast<PrintFormat>(format) == PrintFormat::table)
+      if (static_cast<PrintFormat>(format) == PrintFormat::table) {
         stats->DumpTable(os, sort_by, ascending);
-      else if (static_cast<PrintFormat>(format) == PrintFormat::json)
+        // memory profiling also attributes live bytes to operators;
+        // appended only to the table format to keep the json output valid
+        if (profiler->IsProfiling(profiler::Profiler::kMemory)) {
+          storage::DeviceStorageProfiler::DumpHeapBreakdown(os);
+        }
+      } else if (static_cast<PrintFormat>(format) == PrintFormat::json) {
         stats->DumpJson(os, sort_by, ascending);
-      else
+      } else {
         LOG(FATAL) << "Invalid value for parameter format";
+      }
     }
     if (reset != 0)
       stats->clear();
@@ -381,6 +390,27 @@ int MXSetProcessProfilerState(int state, int profile_process, KVStoreHandle kvSt
         break;
     }
     profiler::Profiler::Get()->SetState(profiler::Profiler::ProfilerState(state));
+    if (state == profiler::Profiler::kNotRunning) {
+      // when a hints file is configured, each profiled run refreshes the
+      // tuning hints that the next startup will consume
+      static const std::string hints_file =
+          dmlc::GetEnv("MXNET_TUNING_HINTS_FILE", std::string());
+      if (!hints_file.empty()) {
+        profiler::Profiler *profiler = profiler::Profiler::Get();
+        if (profiler->IsEnableOutput()) {
+          profiler->DumpProfile(false);
+        }
+        std::shared_ptr<profiler::AggregateStats> stats = profiler->GetAggregateStats();
+        if (stats) {
+          std::ofstream os(hints_file.c_str());
+          if (os.good()) {
+            stats->DumpTuningHints(os);
+          } else {
+            LOG(WARNING) << "Cannot write tuning hints to " << hints_file;
+          }
+        }
+      }
+    }
   }
   API_END();
 }
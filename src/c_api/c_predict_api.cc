@@ -31,6 +31,7 @@
 #include <memory>
 #include <unordered_set>
 #include <unordered_map>
+#include <utility>
 #include "./c_api_common.h"
 #include "../operator/operator_common.h"
 #include "../executor/exec_pass.h"
@@ -54,14 +55,38 @@ struct MXAPIPredictor {
   std::vector<uint32_t> out_shapes_buffer;
   // key to arguments
   std::unordered_map<std::string, size_t> key2arg;
-  // executor
-  std::unique_ptr<Executor> exec;
+  // caller-owned output buffers registered by MXPredSetOutputBuffer,
+  // filled at the end of each forward pass
+  std::unordered_map<uint32_t, std::pair<float*, uint32_t>> output_buffers;
+  // executor, shared with the entries of reshape_cache
+  std::shared_ptr<Executor> exec;
+  // executors already planned by MXPredReshape, keyed by input-shape
+  // signature, so bucketed inputs only bind once per novel shape
+  std::unordered_map<std::string, std::shared_ptr<MXAPIPredictor>> reshape_cache;
   // symbol
   nnvm::Symbol sym;
   // Context
   Context ctx;
 };
 
+// canonical "name:dim0xdim1;..." signature of a reshape request, used as the
+// key of MXAPIPredictor::reshape_cache
+inline std::string ShapeSignature(
+    const std::unordered_map<std::string, mxnet::TShape>& shapes) {
+  std::map<std::string, mxnet::TShape> ordered(shapes.begin(), shapes.end());
+  std::string sig;
+  for (const auto& kv : ordered) {
+    sig += kv.first;
+    sig += ':';
+    for (int i = 0; i < kv.second.ndim(); ++i) {
+      if (i) sig += 'x';
+      sig += std::to_string(kv.second[i]);
+    }
+    sig += ';';
+  }
+  return sig;
+}
+
 struct MXAPINDList {
   std::vector<std::string> keys;
   mxnet::ShapeVector shapes;
@@ -289,15 +314,31 @@ int _CreatePartialOut(const char* symbol_json_str,
     ret->aux_arrays = aux_arrays;
     ret->out_shapes = out_shapes;
     ret->out_dtypes = result_out_types;
+    if (num_threads > 1) {
+      // Each session gets private copies of the non-parameter arguments (the
+      // model inputs): MXPredSetInput on one handle must not write through a
+      // buffer another thread's forward pass is reading. The weights and aux
+      // states keep sharing one store across all sessions. Zero-filling the
+      // private inputs here also pre-faults their pages, so the first
+      // request doesn't pay for them.
+      for (size_t j = 0; j < arg_names.size(); ++j) {
+        if (arg_params.count(arg_names[j]) == 0) {
+          NDArray priv(ret->arg_arrays[j].shape(), ctx, false,
+                       ret->arg_arrays[j].dtype());
+          priv = 0.0f;
+          ret->arg_arrays[j] = priv;
+        }
+      }
+    }
 
     if (!lazy) {
       std::map<std::string, Context> ctx_map;
       std::vector<NDArray> grad_store(arg_arrays.size());
       std::vector<OpReqType> grad_req(arg_arrays.size(), kNullOp);
       ret->exec.reset(Executor::Bind(sym, ctx, ctx_map,
-                                     arg_arrays,
+                                     ret->arg_arrays,
                                      grad_store, grad_req,
-                                     aux_arrays));
+                                     ret->aux_arrays));
       ret->out_arrays = ret->exec->outputs();
     }
     out[i] = ret.release();
@@ -452,74 +493,82 @@ int MXPredReshape(uint32_t num_input_nodes,
         mxnet::TShape(input_shape_data + input_shape_indptr[i],
             input_shape_data + input_shape_indptr[i + 1]);
   }
-  ret->sym = p->sym;
-  std::vector<std::string> arg_names = ret->sym.ListInputNames(Symbol::kReadOnlyArgs);
-  std::vector<std::string> aux_names = ret->sym.ListInputNames(Symbol::kAuxiliaryStates);
-  mxnet::ShapeVector out_shapes(ret->sym.ListOutputNames().size());
-  mxnet::ShapeVector aux_shapes(aux_names.size());
-  mxnet::ShapeVector arg_shapes;
-  ret->key2arg = p->key2arg;
+  // a shape seen before reuses its planned executor without rebinding
+  const std::string signature = ShapeSignature(new_shape);
+  auto cached = p->reshape_cache.find(signature);
+  if (cached != p->reshape_cache.end()) {
+    *ret = *cached->second;
+  } else {
+    ret->sym = p->sym;
+    std::vector<std::string> arg_names = ret->sym.ListInputNames(Symbol::kReadOnlyArgs);
+    std::vector<std::string> aux_names = ret->sym.ListInputNames(Symbol::kAuxiliaryStates);
+    mxnet::ShapeVector out_shapes(ret->sym.ListOutputNames().size());
+    mxnet::ShapeVector aux_shapes(aux_names.size());
+    mxnet::ShapeVector arg_shapes;
+    ret->key2arg = p->key2arg;
+
+    try {
+      mxnet::ShapeVector in_shapes;
+      in_shapes.reserve(arg_names.size());
+      for (std::string key : ret->sym.ListInputNames(Symbol::kAll)) {
+        if (new_shape.count(key) != 0) {
+          in_shapes.push_back(new_shape[key]);
+        } else {
+          in_shapes.emplace_back();
+        }
+      }
+      nnvm::Graph g; g.outputs = ret->sym.outputs;
+      g = mxnet::exec::InferShape(std::move(g), std::move(in_shapes), "__shape__");
+      bool infer_complete = (g.GetAttr<size_t>("shape_num_unknown_nodes") == 0);
+      CHECK(infer_complete)
+        << "The shape information of is not enough to get the shapes";
+      CopyAttr(g.indexed_graph(),
+               g.GetAttr<mxnet::ShapeVector>("shape"),
+               &arg_shapes, &out_shapes, &aux_shapes);
+    } catch (const mxnet::op::InferShapeError &err) {
+      throw dmlc::Error(err.msg);
+    }
 
-  try {
-    mxnet::ShapeVector in_shapes;
-    in_shapes.reserve(arg_names.size());
-    for (std::string key : ret->sym.ListInputNames(Symbol::kAll)) {
-      if (new_shape.count(key) != 0) {
-        in_shapes.push_back(new_shape[key]);
+    ret->arg_arrays = p->arg_arrays;
+    ret->ctx = p->ctx;
+    for (size_t i=0; i < arg_names.size(); ++i) {
+      mxnet::TShape newShape = arg_shapes[i];
+      NDArray &arr = p->arg_arrays[i];
+      if (new_shape.count(arg_names[i]) != 0) {
+        ret->arg_arrays[i].ReshapeAndAlloc(newShape);
       } else {
-        in_shapes.emplace_back();
+         CHECK_EQ(newShape.Size(), arr.shape().Size())
+          << "arg " << arg_names[i]
+          << " shape has been changed, only allow to change the shape of input data.";
       }
     }
-    nnvm::Graph g; g.outputs = ret->sym.outputs;
-    g = mxnet::exec::InferShape(std::move(g), std::move(in_shapes), "__shape__");
-    bool infer_complete = (g.GetAttr<size_t>("shape_num_unknown_nodes") == 0);
-    CHECK(infer_complete)
-      << "The shape information of is not enough to get the shapes";
-    CopyAttr(g.indexed_graph(),
-             g.GetAttr<mxnet::ShapeVector>("shape"),
-             &arg_shapes, &out_shapes, &aux_shapes);
-  } catch (const mxnet::op::InferShapeError &err) {
-    throw dmlc::Error(err.msg);
-  }
 
-  ret->arg_arrays = p->arg_arrays;
-  ret->ctx = p->ctx;
-  for (size_t i=0; i < arg_names.size(); ++i) {
-    mxnet::TShape newShape = arg_shapes[i];
-    NDArray &arr = p->arg_arrays[i];
-    if (new_shape.count(arg_names[i]) != 0) {
-      ret->arg_arrays[i].ReshapeAndAlloc(newShape);
-    } else {
-       CHECK_EQ(newShape.Size(), arr.shape().Size())
-        << "arg " << arg_names[i]
+    for (size_t i=0; i < aux_names.size(); ++i) {
+      mxnet::TShape newShape = aux_shapes[i];
+      NDArray &arr = p->aux_arrays[i];
+      CHECK_EQ(newShape.Size(), arr.shape().Size())
+        << "aux " << aux_names[i]
         << " shape has been changed, only allow to change the shape of input data.";
     }
-  }
+    ret->aux_arrays = p->aux_arrays;
 
-  for (size_t i=0; i < aux_names.size(); ++i) {
-    mxnet::TShape newShape = aux_shapes[i];
-    NDArray &arr = p->aux_arrays[i];
-    CHECK_EQ(newShape.Size(), arr.shape().Size())
-      << "aux " << aux_names[i]
-      << " shape has been changed, only allow to change the shape of input data.";
-  }
-  ret->aux_arrays = p->aux_arrays;
+    // bind
+    {
+      std::map<std::string, Context> ctx_map;
+      std::vector<NDArray> grad_store;
+      grad_store.reserve(ret->arg_arrays.size());
+      std::vector<OpReqType> grad_req(ret->arg_arrays.size(), kNullOp);
 
-  // bind
-  {
-    std::map<std::string, Context> ctx_map;
-    std::vector<NDArray> grad_store;
-    grad_store.reserve(ret->arg_arrays.size());
-    std::vector<OpReqType> grad_req(ret->arg_arrays.size(), kNullOp);
-
-    ret->exec.reset(Executor::Bind(ret->sym, ret->ctx, ctx_map,
-                                   ret->arg_arrays,
-                                   grad_store, grad_req,
-                                   ret->aux_arrays,
-                                   p->exec.get()));
-    ret->out_shapes = out_shapes;
-    ret->out_arrays = ret->exec->outputs();
-    ret->out_dtypes = p->out_dtypes;
+      ret->exec.reset(Executor::Bind(ret->sym, ret->ctx, ctx_map,
+                                     ret->arg_arrays,
+                                     grad_store, grad_req,
+                                     ret->aux_arrays,
+                                     p->exec.get()));
+      ret->out_shapes = out_shapes;
+      ret->out_arrays = ret->exec->outputs();
+      ret->out_dtypes = p->out_dtypes;
+    }
+    p->reshape_cache[signature] = std::make_shared<MXAPIPredictor>(*ret);
   }
   *out = ret.release();
   API_END();
@@ -578,6 +627,9 @@ int MXPredForward(PredictorHandle handle) {
   MXAPIPredictor* p = static_cast<MXAPIPredictor*>(handle);
   API_BEGIN();
   p->exec->Forward(false);
+  for (const auto& kv : p->output_buffers) {
+    p->out_arrays[kv.first].SyncCopyToCPU(kv.second.first, kv.second.second);
+  }
   API_END();
 }
 
@@ -602,6 +654,28 @@ int MXPredGetOutput(PredictorHandle handle,
   API_END();
 }
 
+int MXPredSetOutputBuffer(PredictorHandle handle,
+                          uint32_t index,
+                          float* data,
+                          uint32_t size) {
+  MXAPIPredictor* p = static_cast<MXAPIPredictor*>(handle);
+  API_BEGIN();
+  CHECK_LT(index, p->out_arrays.size())
+      << "Output index out of range";
+  if (data == nullptr) {
+    p->output_buffers.erase(index);
+  } else {
+    const NDArray& nd = p->out_arrays[index];
+    CHECK_EQ(nd.dtype(), mshadow::kFloat32)
+        << "Output buffers are only supported for float32 outputs";
+    CHECK_EQ(static_cast<size_t>(size), nd.shape().Size())
+        << "Buffer size mismatch for output " << index
+        << ": expected " << nd.shape().Size() << ", got " << size;
+    p->output_buffers[index] = std::make_pair(data, size);
+  }
+  API_END();
+}
+
 int MXPredFree(PredictorHandle handle) {
   API_BEGIN();
   delete static_cast<MXAPIPredictor*>(handle);
@@ -47,6 +47,9 @@ __global__ void rand_generator_seed_kernel(curandStatePhilox4_32_10_t *states_,
 template<>
 void RandGenerator<gpu, float>::Seed(mshadow::Stream<gpu> *s, uint32_t seed) {
   using namespace mshadow::cuda;
+  // kept on the host side for counter-based launches, which derive their
+  // streams from the seed instead of the state array
+  seed_ = seed;
   int ngrid = std::min(kMaxGridNum,
                        (RandGenerator<gpu, float>::kNumRandomStates + kBaseThreadNum - 1) /
                          kBaseThreadNum);
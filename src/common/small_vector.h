@@ -0,0 +1,121 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2020 by Contributors
+ * \file small_vector.h
+ * \brief Vector with inline storage for the common small case.
+ *
+ * Per-invoke bookkeeping on the imperative path (input vars, output
+ * requests) almost always holds fewer than eight elements, yet a
+ * std::vector pays a heap allocation for each of them. SmallVector keeps
+ * the first kInline elements in the object itself and only touches the
+ * heap when that capacity is exceeded. It intentionally supports only
+ * trivially copyable element types (pointers, handles, enums, ints), which
+ * covers the dependency-tracking uses and keeps growth a plain copy.
+ *
+ * Note this type cannot replace the containers that cross the FCompute,
+ * FInferShape or Engine interfaces — those are std::vector by public
+ * signature.
+ */
+#ifndef MXNET_COMMON_SMALL_VECTOR_H_
+#define MXNET_COMMON_SMALL_VECTOR_H_
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace mxnet {
+namespace common {
+
+/*!
+ * \brief vector keeping its first kInline elements in inline storage
+ * \tparam T element type, must be trivially copyable
+ * \tparam kInline number of elements stored without heap allocation
+ */
+template<typename T, size_t kInline>
+class SmallVector {
+  static_assert(std::is_trivial<T>::value,
+                "SmallVector only supports trivial element types");
+
+ public:
+  SmallVector() = default;
+  ~SmallVector() {
+    delete[] heap_;
+  }
+  SmallVector(const SmallVector&) = delete;
+  SmallVector& operator=(const SmallVector&) = delete;
+
+  inline void push_back(const T& val) {
+    if (size_ == capacity_) Grow();
+    data()[size_++] = val;
+  }
+  inline void clear() {
+    size_ = 0;
+  }
+  inline size_t size() const {
+    return size_;
+  }
+  inline bool empty() const {
+    return size_ == 0;
+  }
+  inline T& operator[](size_t i) {
+    return data()[i];
+  }
+  inline const T& operator[](size_t i) const {
+    return data()[i];
+  }
+  inline T* begin() {
+    return data();
+  }
+  inline T* end() {
+    return data() + size_;
+  }
+  inline const T* begin() const {
+    return data();
+  }
+  inline const T* end() const {
+    return data() + size_;
+  }
+  inline T* data() {
+    return heap_ != nullptr ? heap_ : inline_;
+  }
+  inline const T* data() const {
+    return heap_ != nullptr ? heap_ : inline_;
+  }
+
+ private:
+  void Grow() {
+    const size_t new_capacity = capacity_ * 2;
+    T* new_heap = new T[new_capacity];
+    std::memcpy(new_heap, data(), size_ * sizeof(T));
+    delete[] heap_;
+    heap_ = new_heap;
+    capacity_ = new_capacity;
+  }
+
+  T inline_[kInline];
+  T* heap_{nullptr};
+  size_t size_{0};
+  size_t capacity_{kInline};
+};  // class SmallVector
+
+}  // namespace common
+}  // namespace mxnet
+#endif  // MXNET_COMMON_SMALL_VECTOR_H_
@@ -0,0 +1,81 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2019 by Contributors
+ * \file spin_lock.h
+ * \brief Simple test-and-test-and-set spinlock for very short critical sections.
+ */
+#ifndef MXNET_COMMON_SPIN_LOCK_H_
+#define MXNET_COMMON_SPIN_LOCK_H_
+
+#include <dmlc/base.h>
+#include <atomic>
+#include <thread>
+
+namespace mxnet {
+namespace common {
+
+/*!
+ * \brief A CAS-based spinlock satisfying BasicLockable, so it can be used
+ *  with std::lock_guard as a drop-in replacement for std::mutex.
+ *
+ *  Intended for critical sections of a few instructions (e.g. pointer
+ *  manipulation on the engine dependency queues), where the cost of a
+ *  futex sleep/wake exceeds the cost of briefly spinning.  Spins with an
+ *  exponential pause and yields to the OS after repeated failures so a
+ *  preempted lock holder cannot livelock its waiters.
+ */
+class SpinLock {
+ public:
+  SpinLock() = default;
+
+  inline void lock() {
+    int spins = 0;
+    while (true) {
+      // test-and-test-and-set: spin on a plain load to avoid cache-line
+      // ping-pong between waiters, only attempt the CAS when it looks free
+      if (!locked_.load(std::memory_order_relaxed) &&
+          !locked_.exchange(true, std::memory_order_acquire)) {
+        return;
+      }
+      if (++spins >= kYieldThreshold) {
+        std::this_thread::yield();
+        spins = 0;
+      }
+    }
+  }
+
+  inline void unlock() {
+    locked_.store(false, std::memory_order_release);
+  }
+
+ private:
+  /*! \brief number of failed spins before yielding the processor */
+  static constexpr int kYieldThreshold = 128;
+  /*! \brief lock word */
+  std::atomic<bool> locked_{false};
+
+  DISALLOW_COPY_AND_ASSIGN(SpinLock);
+};
+
+}  // namespace common
+}  // namespace mxnet
+
+#endif  // MXNET_COMMON_SPIN_LOCK_H_
@@ -0,0 +1,166 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2019 by Contributors
+ * \file temp_space_arena.h
+ * \brief Per-thread bump-pointer arena for CPU temporary workspace.
+ */
+#ifndef MXNET_COMMON_TEMP_SPACE_ARENA_H_
+#define MXNET_COMMON_TEMP_SPACE_ARENA_H_
+
+#include <dmlc/parameter.h>
+#include <mxnet/base.h>
+#include <mxnet/storage.h>
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace mxnet {
+namespace common {
+
+/*!
+ * \brief Per-thread bump-pointer arena for CPU temporary workspace.
+ *
+ * Serving kTempSpace requests from an arena makes each request a fresh
+ * pointer-bump instead of a round trip through the shared SpaceAllocator,
+ * which matters for ops that grab thousands of small reduce workspaces per
+ * step. Memory is never handed back individually; ResetAll() rewinds every
+ * thread's arena wholesale at an iteration boundary.
+ *
+ * ResetAll() must only be called when no operator is executing, e.g. right
+ * after Engine::WaitForAll(), since outstanding workspace pointers become
+ * invalid for reuse once the arena rewinds.
+ *
+ * Enabled with MXNET_CPU_TEMP_SPACE_ARENA=1; the minimum block size is set
+ * by MXNET_CPU_TEMP_SPACE_ARENA_MIN_BLOCK_MB.
+ */
+class TempSpaceArena {
+ public:
+  /*! \brief whether the arena is enabled through MXNET_CPU_TEMP_SPACE_ARENA */
+  static bool Enabled() {
+    static const bool enabled = dmlc::GetEnv("MXNET_CPU_TEMP_SPACE_ARENA", 0) != 0;
+    return enabled;
+  }
+
+  /*! \brief get the calling thread's arena, creating and registering it on first use */
+  static TempSpaceArena* Get() {
+    static MX_THREAD_LOCAL TempSpaceArena* arena = nullptr;
+    if (arena == nullptr) {
+      arena = new TempSpaceArena();
+      std::lock_guard<std::mutex> lock(registry_mutex());
+      registry().push_back(arena);
+    }
+    return arena;
+  }
+
+  /*!
+   * \brief rewind every thread's arena; requires engine quiescence
+   */
+  static void ResetAll() {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    for (TempSpaceArena* arena : registry()) {
+      arena->Reset();
+    }
+  }
+
+  /*!
+   * \brief allocate temporary space valid until the next ResetAll
+   * \param size requested size in bytes
+   * \return pointer to the space
+   */
+  void* Alloc(size_t size) {
+    size = RoundToMultiple(size, kAlign);
+    while (cur_block_ < blocks_.size() &&
+           offset_ + size > blocks_[cur_block_].size) {
+      ++cur_block_;
+      offset_ = 0;
+    }
+    if (cur_block_ == blocks_.size()) {
+      size_t block_size = min_block_size_;
+      if (!blocks_.empty()) block_size = blocks_.back().size * 2;
+      block_size = std::max(block_size, size);
+      blocks_.push_back(Storage::Get()->Alloc(block_size, Context::CPU()));
+      offset_ = 0;
+    }
+    void* ret = static_cast<char*>(blocks_[cur_block_].dptr) + offset_;
+    offset_ += size;
+    used_ += size;
+    high_water_ = std::max(high_water_, used_);
+    return ret;
+  }
+
+ private:
+  TempSpaceArena() {
+    min_block_size_ = static_cast<size_t>(
+        dmlc::GetEnv("MXNET_CPU_TEMP_SPACE_ARENA_MIN_BLOCK_MB", 16)) << 20;
+  }
+
+  /*! \brief rewind this arena, consolidating multiple blocks into one */
+  void Reset() {
+    const size_t target = RoundToMultiple(high_water_, min_block_size_);
+    if (blocks_.size() > 1 ||
+        (blocks_.size() == 1 && blocks_[0].size < target)) {
+      for (auto& block : blocks_) {
+        Storage::Get()->DirectFree(block);
+      }
+      blocks_.clear();
+      if (target > 0) {
+        blocks_.push_back(Storage::Get()->Alloc(target, Context::CPU()));
+      }
+    }
+    cur_block_ = 0;
+    offset_ = 0;
+    used_ = 0;
+  }
+
+  static size_t RoundToMultiple(size_t x, size_t multiple) {
+    return ((x + multiple - 1) / multiple) * multiple;
+  }
+
+  static std::mutex& registry_mutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+  static std::vector<TempSpaceArena*>& registry() {
+    static std::vector<TempSpaceArena*> arenas;
+    return arenas;
+  }
+
+  /*! \brief alignment of returned pointers, matches cache line size */
+  static const size_t kAlign = 64;
+  /*! \brief backing blocks, bump-allocated front to back */
+  std::vector<Storage::Handle> blocks_;
+  /*! \brief block currently being bump-allocated */
+  size_t cur_block_ = 0;
+  /*! \brief bump offset into the current block */
+  size_t offset_ = 0;
+  /*! \brief bytes handed out since the last reset */
+  size_t used_ = 0;
+  /*! \brief most bytes ever live at once, used to size the consolidated block */
+  size_t high_water_ = 0;
+  /*! \brief minimum size of a newly allocated block */
+  size_t min_block_size_;
+  DISALLOW_COPY_AND_ASSIGN(TempSpaceArena);
+};  // class TempSpaceArena
+
+}  // namespace common
+}  // namespace mxnet
+
+#endif  // MXNET_COMMON_TEMP_SPACE_ARENA_H_
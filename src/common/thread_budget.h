@@ -0,0 +1,142 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2020 by Contributors
+ * \file thread_budget.h
+ * \brief Per-subsystem CPU core budgets declared through MXNET_CPU_CORE_SETS.
+ */
+#ifndef MXNET_COMMON_THREAD_BUDGET_H_
+#define MXNET_COMMON_THREAD_BUDGET_H_
+
+#include <dmlc/common.h>
+#include <mxnet/base.h>
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace mxnet {
+namespace common {
+
+/*!
+ * \brief CPU core sets per subsystem, declared through MXNET_CPU_CORE_SETS.
+ *
+ * The spec is a ';'-separated list of "name:cores" entries, where cores is
+ * a ','-separated list of cpu ids and a-b ranges, e.g. "io:0-3;engine:4-15".
+ * Subsystems bind the threads they create to their declared set, so
+ * data-loading decode and engine compute stop migrating onto each other's
+ * cores. Subsystems without a declared set are unrestricted, and sets may
+ * overlap when cores are meant to be shared.
+ */
+class ThreadCoreBudget {
+ public:
+  static ThreadCoreBudget* Get() {
+    static ThreadCoreBudget inst;
+    return &inst;
+  }
+
+  /*!
+   * \brief the declared core set of a subsystem
+   * \param subsystem name used in MXNET_CPU_CORE_SETS
+   * \return the cpu id list, or nullptr if no set was declared
+   */
+  const std::vector<int>* Cores(const std::string& subsystem) const {
+    const auto it = sets_.find(subsystem);
+    return it == sets_.end() ? nullptr : &it->second;
+  }
+
+  /*!
+   * \brief clamp a requested thread count to the subsystem's core budget
+   * \param subsystem name used in MXNET_CPU_CORE_SETS
+   * \param requested the thread count the subsystem would use on its own
+   * \return requested, or the core set size if that is smaller
+   */
+  int Threads(const std::string& subsystem, int requested) const {
+    const std::vector<int>* cores = Cores(subsystem);
+    if (cores == nullptr) return requested;
+    return std::min(requested, static_cast<int>(cores->size()));
+  }
+
+  /*!
+   * \brief Bind the calling thread to the subsystem's core set. OMP teams
+   *  spawned by the thread afterwards inherit the mask. No-op when the
+   *  subsystem has no declared set, or off Linux.
+   * \param subsystem name used in MXNET_CPU_CORE_SETS
+   */
+  static void ApplyToCurrentThread(const std::string& subsystem) {
+#if defined(__linux__)
+    const std::vector<int>* cores = Get()->Cores(subsystem);
+    if (cores == nullptr) return;
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (int cpu : *cores) CPU_SET(cpu, &cpuset);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+#endif
+  }
+
+ private:
+  ThreadCoreBudget() {
+    Parse(dmlc::GetEnv("MXNET_CPU_CORE_SETS", std::string()));
+  }
+
+  void Parse(const std::string& spec) {
+    size_t begin = 0;
+    while (begin < spec.size()) {
+      size_t end = spec.find(';', begin);
+      if (end == std::string::npos) end = spec.size();
+      const std::string entry = spec.substr(begin, end - begin);
+      begin = end + 1;
+      if (entry.empty()) continue;
+      const size_t colon = entry.find(':');
+      CHECK_NE(colon, std::string::npos)
+        << "malformed MXNET_CPU_CORE_SETS entry \"" << entry
+        << "\", expected name:cores";
+      std::vector<int>& cores = sets_[entry.substr(0, colon)];
+      for (const std::string& tok : dmlc::Split(entry.substr(colon + 1), ',')) {
+        const size_t dash = tok.find('-');
+        if (dash == std::string::npos) {
+          cores.push_back(std::stoi(tok));
+        } else {
+          const int lo = std::stoi(tok.substr(0, dash));
+          const int hi = std::stoi(tok.substr(dash + 1));
+          CHECK_LE(lo, hi) << "malformed core range \"" << tok
+            << "\" in MXNET_CPU_CORE_SETS";
+          for (int cpu = lo; cpu <= hi; ++cpu) {
+            cores.push_back(cpu);
+          }
+        }
+      }
+      CHECK(!cores.empty())
+        << "empty core set for \"" << entry.substr(0, colon)
+        << "\" in MXNET_CPU_CORE_SETS";
+    }
+  }
+
+  std::unordered_map<std::string, std::vector<int> > sets_;
+};
+
+}  // namespace common
+}  // namespace mxnet
+
+#endif  // MXNET_COMMON_THREAD_BUDGET_H_
@@ -25,6 +25,7 @@
 #ifndef MXNET_COMMON_UTILS_H_
 #define MXNET_COMMON_UTILS_H_
 
+#include <dmlc/json.h>
 #include <dmlc/logging.h>
 #include <dmlc/omp.h>
 #include <nnvm/graph.h>
@@ -35,6 +36,8 @@
 #include <mxnet/graph_attr_types.h>
 #include <nnvm/graph_attr_types.h>
 
+#include <fstream>
+#include <map>
 #include <memory>
 #include <vector>
 #include <type_traits>
@@ -455,6 +458,31 @@ inline std::string operator_string(const nnvm::NodeAttrs& attrs,
   return result;
 }
 
+/*!
+ * \brief Look up an integer tuning hint emitted by a previous profiling run.
+ *
+ *  Hints are read once from the JSON file named by MXNET_TUNING_HINTS_FILE
+ *  (written by the profiler on stop); unknown keys and a missing or unset
+ *  file fall back to the given default, so hints only shift defaults and
+ *  explicit environment settings keep the last word.
+ */
+inline int TuningHint(const std::string& key, int dflt) {
+  static const std::map<std::string, int> hints = []() {
+    std::map<std::string, int> ret;
+    const std::string path = dmlc::GetEnv("MXNET_TUNING_HINTS_FILE", std::string());
+    if (!path.empty()) {
+      std::ifstream is(path.c_str());
+      if (is.good()) {
+        dmlc::JSONReader reader(&is);
+        reader.Read(&ret);
+      }
+    }
+    return ret;
+  }();
+  auto it = hints.find(key);
+  return it == hints.end() ? dflt : it->second;
+}
+
 /*! \brief log message once. Intended for storage fallback warning messages. */
 inline void LogOnce(const std::string& message) {
   typedef dmlc::ThreadLocalStore<std::unordered_set<std::string>> LogStore;
@@ -494,6 +522,15 @@ inline void LogStorageFallback(const nnvm::NodeAttrs& attrs,
 #endif
 }
 
+/*!
+ * \brief whether MXNET_ENFORCE_DETERMINISM is set. Operators consult this to
+ *        select bitwise-reproducible (but possibly slower) implementations.
+ */
+inline bool EnforceDeterminism() {
+  static const bool enforce = dmlc::GetEnv("MXNET_ENFORCE_DETERMINISM", false);
+  return enforce;
+}
+
 // heuristic to dermine number of threads per GPU
 inline int GetNumThreadsPerGPU() {
   // This is resource efficient option.
@@ -747,6 +784,25 @@ inline void ParallelCopy(DType* dst, const DType* src, index_t size) {
   }
 }
 
+/*!
+ * \brief parallelize a dtype-converting copy by OpenMP.
+ * The loop body is a plain element-wise cast so the compiler can vectorize it.
+ */
+template<typename DstDType, typename SrcDType>
+inline void ParallelCastCopy(DstDType* dst, const SrcDType* src, index_t size) {
+  static index_t copy_block_size = dmlc::GetEnv("MXNET_CPU_PARALLEL_COPY_SIZE", 200000);
+  if (size >= copy_block_size) {
+    #pragma omp parallel for num_threads(engine::OpenMP::Get()->GetRecommendedOMPThreadCount())
+    for (index_t i = 0; i < size; ++i) {
+      dst[i] = static_cast<DstDType>(src[i]);
+    }
+  } else {
+    for (index_t i = 0; i < size; ++i) {
+      dst[i] = static_cast<DstDType>(src[i]);
+    }
+  }
+}
+
 /*!
  * \brief If numpy compatibility is turned off (default), the shapes passed in
  * by users follow the legacy shape definition:
@@ -0,0 +1,232 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2019 by Contributors
+ * \file dep_graph.h
+ * \brief Optional recorder of the engine's var-to-op dependency edges.
+ */
+#ifndef MXNET_ENGINE_DEP_GRAPH_H_
+#define MXNET_ENGINE_DEP_GRAPH_H_
+
+#include <dmlc/parameter.h>
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mxnet {
+namespace engine {
+
+/*!
+ * \brief Records which op waited on which, derived from the engine's
+ *  read/write var registrations, plus execution timestamps per op.
+ *
+ *  Unlike the exec trace this is a debugging aid, not an always-on
+ *  facility: recording takes a mutex per pushed op, so it is off by
+ *  default and bounded by MXNET_ENGINE_DEP_GRAPH_SIZE ops (0 disables).
+ *  When the window fills, further ops are ignored until the graph is
+ *  dumped. DumpDot() renders the recorded window as DOT with the
+ *  critical path (the dependency chain with the largest summed
+ *  execution time) highlighted, then clears the window so the next
+ *  step can be captured.
+ */
+class EngineDepGraph {
+ public:
+  /*! \return the singleton recorder */
+  static EngineDepGraph* Get() {
+    static EngineDepGraph inst;
+    return &inst;
+  }
+
+  /*! \return whether dependency recording is enabled */
+  inline bool enabled() const {
+    return max_ops_ > 0;
+  }
+
+  /*!
+   * \brief Record a pushed op and its dependency edges.
+   * \param name op name, may be null
+   * \param const_vars vars the op reads, identified by address
+   * \param mutable_vars vars the op writes, identified by address
+   * \return a nonzero id to pass to RecordStart/RecordComplete,
+   *         or 0 if the window is full
+   */
+  template<typename VarType>
+  uint64_t RecordPush(const char* name,
+                      const std::vector<VarType*>& const_vars,
+                      const std::vector<VarType*>& mutable_vars) {
+    std::lock_guard<std::mutex> lock(m_);
+    if (ops_.size() >= max_ops_) return 0;
+    const size_t idx = ops_.size();
+    ops_.emplace_back();
+    OpNode& op = ops_.back();
+    op.name = name ? name : "<unnamed>";
+    op.push_ns = NowNs();
+    for (VarType* var : const_vars) {
+      AddEdgeFromWriter(var, idx);
+      readers_[var].push_back(idx);
+    }
+    for (VarType* var : mutable_vars) {
+      AddEdgeFromWriter(var, idx);
+      for (size_t reader : readers_[var]) {
+        if (reader != idx) ops_[idx].preds.push_back(reader);
+      }
+      readers_[var].clear();
+      last_writer_[var] = idx + 1;
+    }
+    return idx + 1;
+  }
+
+  /*! \brief Record that the op started executing. */
+  void RecordStart(uint64_t id) {
+    std::lock_guard<std::mutex> lock(m_);
+    ops_[id - 1].start_ns = NowNs();
+  }
+
+  /*! \brief Record that the op completed. */
+  void RecordComplete(uint64_t id) {
+    std::lock_guard<std::mutex> lock(m_);
+    ops_[id - 1].complete_ns = NowNs();
+  }
+
+  /*!
+   * \brief Render the recorded window as a DOT digraph and clear it.
+   *
+   *  Node labels carry the execution time; the critical path is drawn
+   *  in red. Ops that never completed (still queued or executing at
+   *  dump time) count as zero-cost path members.
+   * \return the DOT text
+   */
+  std::string DumpDot() {
+    std::lock_guard<std::mutex> lock(m_);
+    const size_t n = ops_.size();
+    // Longest path by summed execution time. Predecessors always have a
+    // smaller index, so one forward pass suffices.
+    std::vector<uint64_t> path_cost(n, 0);
+    std::vector<size_t> path_pred(n, n);
+    size_t path_end = n;
+    uint64_t best_cost = 0;
+    for (size_t i = 0; i < n; ++i) {
+      uint64_t cost = 0;
+      for (size_t pred : ops_[i].preds) {
+        if (path_cost[pred] > cost) {
+          cost = path_cost[pred];
+          path_pred[i] = pred;
+        }
+      }
+      path_cost[i] = cost + OpCostNs(ops_[i]);
+      if (path_cost[i] >= best_cost) {
+        best_cost = path_cost[i];
+        path_end = i;
+      }
+    }
+    std::vector<bool> on_path(n, false);
+    for (size_t i = path_end; i != n; i = path_pred[i]) {
+      on_path[i] = true;
+    }
+    std::ostringstream os;
+    os << "digraph engine_deps {\n"
+       << "  // critical path: " << best_cost / 1000 << " us\n"
+       << "  rankdir=LR;\n"
+       << "  node [shape=box, fontsize=10];\n";
+    for (size_t i = 0; i < n; ++i) {
+      os << "  op" << i << " [label=\"" << Escape(ops_[i].name)
+         << "\\n" << OpCostNs(ops_[i]) / 1000 << "us\"";
+      if (on_path[i]) os << ", color=red, penwidth=2.0";
+      os << "];\n";
+    }
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t pred : ops_[i].preds) {
+        os << "  op" << pred << " -> op" << i;
+        if (on_path[i] && pred == path_pred[i]) os << " [color=red, penwidth=2.0]";
+        os << ";\n";
+      }
+    }
+    os << "}\n";
+    ops_.clear();
+    last_writer_.clear();
+    readers_.clear();
+    return os.str();
+  }
+
+ private:
+  /*! \brief A recorded op and its incoming dependency edges. */
+  struct OpNode {
+    /*! \brief op name */
+    std::string name;
+    /*! \brief nanoseconds at push, execution start and completion */
+    uint64_t push_ns{0};
+    uint64_t start_ns{0};
+    uint64_t complete_ns{0};
+    /*! \brief indices of the ops this op waited on */
+    std::vector<size_t> preds;
+  };
+
+  EngineDepGraph()
+    : max_ops_(dmlc::GetEnv("MXNET_ENGINE_DEP_GRAPH_SIZE", 0)) {}
+
+  static inline uint64_t NowNs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  /*! \return the op's execution time, zero if it never completed */
+  static inline uint64_t OpCostNs(const OpNode& op) {
+    return op.complete_ns > op.start_ns ? op.complete_ns - op.start_ns : 0;
+  }
+
+  /*! \brief add an edge from the last writer of var, if recorded */
+  inline void AddEdgeFromWriter(const void* var, size_t idx) {
+    auto it = last_writer_.find(var);
+    if (it != last_writer_.end() && it->second != idx + 1) {
+      ops_[idx].preds.push_back(it->second - 1);
+    }
+  }
+
+  /*! \brief escape a name for use inside a DOT string literal */
+  static std::string Escape(const std::string& name) {
+    std::string out;
+    out.reserve(name.size());
+    for (char c : name) {
+      if (c == '"' || c == '\\') out += '\\';
+      out += c;
+    }
+    return out;
+  }
+
+  /*! \brief guards all recorder state */
+  std::mutex m_;
+  /*! \brief max ops per recorded window (MXNET_ENGINE_DEP_GRAPH_SIZE) */
+  const size_t max_ops_;
+  /*! \brief recorded ops, in push order */
+  std::vector<OpNode> ops_;
+  /*! \brief var address -> index + 1 of its last recorded writer */
+  std::unordered_map<const void*, size_t> last_writer_;
+  /*! \brief var address -> readers recorded since the last write */
+  std::unordered_map<const void*, std::vector<size_t>> readers_;
+};
+
+}  // namespace engine
+}  // namespace mxnet
+
+#endif  // MXNET_ENGINE_DEP_GRAPH_H_
@@ -43,6 +43,8 @@ inline Engine* CreateEngine() {
     ret = CreateThreadedEnginePooled();
   } else if (stype == "ThreadedEnginePerDevice") {
     ret = CreateThreadedEnginePerDevice();
+  } else if (stype == "ThreadedEnginePerDeviceWorkStealing") {
+    ret = CreateThreadedEnginePerDeviceWorkStealing();
   }
   #else
   ret = CreateNaiveEngine();
@@ -67,4 +69,9 @@ Engine* Engine::Get() {
   static Engine *inst = _GetSharedRef().get();
   return inst;
 }
+
+int& Engine::ThreadLocalDefaultPriority() {
+  static MX_THREAD_LOCAL int priority = 0;
+  return priority;
+}
 }  // namespace mxnet
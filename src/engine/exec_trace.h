@@ -0,0 +1,158 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2019 by Contributors
+ * \file exec_trace.h
+ * \brief Always-on ring buffer recording the last ops executed by the engine.
+ */
+#ifndef MXNET_ENGINE_EXEC_TRACE_H_
+#define MXNET_ENGINE_EXEC_TRACE_H_
+
+#include <dmlc/parameter.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mxnet {
+namespace engine {
+
+/*!
+ * \brief Lock-free ring buffer of recently executed engine ops.
+ *
+ *  Each ExecuteOprBlock claims a slot with one relaxed fetch_add and
+ *  fills it without synchronization, so the cost per op is a few
+ *  nanoseconds and the trace can stay enabled in production. A dump
+ *  taken while the engine is running may contain a handful of torn
+ *  entries; for post-mortem inspection of a stalled engine this is
+ *  acceptable. The buffer size is set with MXNET_ENGINE_TRACE_SIZE
+ *  (rounded up to a power of two, 0 disables tracing).
+ */
+class EngineExecTrace {
+ public:
+  /*! \brief A single recorded op execution. */
+  struct Entry {
+    /*! \brief monotonically increasing sequence number */
+    uint64_t seq;
+    /*! \brief nanoseconds since steady_clock epoch at execution start */
+    uint64_t timestamp_ns;
+    /*! \brief hash of the executing thread id */
+    uint64_t thread_id;
+    /*! \brief device type of the op's context */
+    int dev_type;
+    /*! \brief device id of the op's context */
+    int dev_id;
+    /*! \brief number of const vars of the op */
+    uint32_t num_const_vars;
+    /*! \brief number of mutable vars of the op */
+    uint32_t num_mutable_vars;
+    /*! \brief truncated copy of the op name */
+    char name[64];
+  };
+
+  /*! \return the singleton trace */
+  static EngineExecTrace* Get() {
+    static EngineExecTrace inst;
+    return &inst;
+  }
+
+  /*! \return whether tracing is enabled */
+  inline bool enabled() const {
+    return !entries_.empty();
+  }
+
+  /*!
+   * \brief Record one op execution.
+   * \param name op name, may be null
+   * \param dev_type device type of the op context
+   * \param dev_id device id of the op context
+   * \param num_const_vars number of const vars
+   * \param num_mutable_vars number of mutable vars
+   */
+  inline void Record(const char* name, int dev_type, int dev_id,
+                     uint32_t num_const_vars, uint32_t num_mutable_vars) {
+    const uint64_t seq = next_seq_.fetch_add(1, std::memory_order_relaxed);
+    Entry& e = entries_[seq & mask_];
+    e.seq = seq;
+    e.timestamp_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    e.thread_id = std::hash<std::thread::id>()(std::this_thread::get_id());
+    e.dev_type = dev_type;
+    e.dev_id = dev_id;
+    e.num_const_vars = num_const_vars;
+    e.num_mutable_vars = num_mutable_vars;
+    if (name) {
+      std::strncpy(e.name, name, sizeof(e.name) - 1);
+      e.name[sizeof(e.name) - 1] = '\0';
+    } else {
+      e.name[0] = '\0';
+    }
+  }
+
+  /*!
+   * \brief Dump the buffered entries, oldest first, one per line.
+   * \return the formatted trace
+   */
+  std::string Dump() const {
+    std::ostringstream os;
+    const uint64_t end = next_seq_.load(std::memory_order_relaxed);
+    const uint64_t size = entries_.size();
+    const uint64_t begin = end > size ? end - size : 0;
+    for (uint64_t seq = begin; seq < end; ++seq) {
+      const Entry& e = entries_[seq & mask_];
+      // skip slots overwritten while dumping
+      if (e.seq < begin || e.seq >= end) continue;
+      os << e.seq << '\t' << e.timestamp_ns << '\t'
+         << std::hex << e.thread_id << std::dec << '\t'
+         << "dev=" << e.dev_type << ':' << e.dev_id << '\t'
+         << "const=" << e.num_const_vars << '\t'
+         << "mutable=" << e.num_mutable_vars << '\t'
+         << (e.name[0] ? e.name : "<unnamed>") << '\n';
+    }
+    return os.str();
+  }
+
+ private:
+  EngineExecTrace() {
+    size_t size = dmlc::GetEnv("MXNET_ENGINE_TRACE_SIZE", 1024);
+    if (size > 0) {
+      size_t rounded = 1;
+      while (rounded < size) rounded <<= 1;
+      entries_.resize(rounded);
+      mask_ = rounded - 1;
+    }
+  }
+
+  /*! \brief preallocated slots, empty when tracing is disabled */
+  std::vector<Entry> entries_;
+  /*! \brief size - 1, for power-of-two wrap-around */
+  uint64_t mask_{0};
+  /*! \brief next sequence number to claim */
+  std::atomic<uint64_t> next_seq_{0};
+};
+
+}  // namespace engine
+}  // namespace mxnet
+
+#endif  // MXNET_ENGINE_EXEC_TRACE_H_
@@ -30,6 +30,7 @@
 #include "./openmp.h"
 #include "../common/object_pool.h"
 #include "../profiler/custom_op_profiler.h"
+#include "../profiler/storage_profiler.h"
 
 namespace mxnet {
 namespace engine {
@@ -179,6 +180,8 @@ class NaiveEngine final : public Engine {
       opr->opr_profile.reset(new profiler::ProfileOperator(opr->opr_name, attrs.release()));
       opr->opr_profile->startForDevice(exec_ctx.dev_type, exec_ctx.dev_id);
     }
+    // attribute allocations made during execution to this operator
+    storage::DeviceStorageProfiler::CurrentScope() = opr_name;
     if (exec_ctx.dev_mask() == gpu::kDevMask) {
 #if MXNET_USE_CUDA
       size_t dev_id = static_cast<size_t>(exec_ctx.dev_id);
@@ -198,6 +201,7 @@ class NaiveEngine final : public Engine {
     } else {
       exec_fun(RunContext{exec_ctx, &cpu_stream_, nullptr, false}, callback);
     }
+    storage::DeviceStorageProfiler::CurrentScope() = nullptr;
     // increment mutable var version
     for (auto var : mutable_vars) {
       ++var->version_;
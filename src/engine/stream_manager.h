@@ -24,11 +24,13 @@
 #define MXNET_ENGINE_STREAM_MANAGER_H_
 
 #include <dmlc/base.h>
+#include <dmlc/parameter.h>
 #include <mxnet/base.h>
 #include <cstddef>
 #include <array>
 #include <string>
 #include <mutex>
+#include <vector>
 #include "../common/cuda_utils.h"
 
 namespace mxnet {
@@ -57,8 +59,13 @@ class StreamManager {
       gpu_streams_;
   std::array<std::array<GPUAuxStream*, kStreams>, kNumGpus>
       gpu_aux_streams_;
-  std::array<mshadow::Stream<gpu>*, kNumGpus> gpu_io_streams_;
+  // pool of copy streams per GPU so independent transfers can overlap;
+  // sized by MXNET_GPU_COPY_STREAMS and dispatched round-robin
+  std::array<std::vector<mshadow::Stream<gpu>*>, kNumGpus> gpu_io_streams_;
+  std::array<int, kNumGpus> gpu_io_cnt_;
   std::array<int, kNumGpus> gpu_cnt_;
+  /*! \brief number of copy streams allocated per GPU */
+  int num_io_streams_;
 #endif  // MXNET_USE_CUDA
   DISALLOW_COPY_AND_ASSIGN(StreamManager);
 };  // class StreamManager
@@ -117,14 +124,22 @@ RunContext StreamManager<kNumGpus, kStreams>::GetIORunContext(
       break;
     case gpu::kDevMask: {
 #if MXNET_USE_CUDA
+      std::size_t use_counter;
       {
         std::lock_guard<std::mutex> lock{mutex_};
-        if (gpu_io_streams_.at(ctx.dev_id) == nullptr) {
+        auto&& io_streams = gpu_io_streams_.at(ctx.dev_id);
+        if (io_streams.empty()) {
           mxnet::common::cuda::DeviceStore device_store(ctx.dev_id);
-          gpu_io_streams_.at(ctx.dev_id) = mshadow::NewStream<gpu>(false, false, ctx.dev_id);
+          io_streams.reserve(num_io_streams_);
+          for (int i = 0; i < num_io_streams_; ++i) {
+            io_streams.push_back(mshadow::NewStream<gpu>(false, false, ctx.dev_id));
+          }
         }
+        auto&& counter = gpu_io_cnt_.at(ctx.dev_id);
+        use_counter = counter;
+        counter = (counter + 1) % num_io_streams_;
       }
-      ret = RunContext{ctx, gpu_io_streams_.at(ctx.dev_id), nullptr, false};
+      ret = RunContext{ctx, gpu_io_streams_.at(ctx.dev_id).at(use_counter), nullptr, false};
       break;
 #else
       LOG(FATAL) << MXNET_GPU_NOT_ENABLED_ERROR;
@@ -139,11 +154,11 @@ RunContext StreamManager<kNumGpus, kStreams>::GetIORunContext(
 template <std::size_t kNumGpus, std::size_t kStreams>
 StreamManager<kNumGpus, kStreams>::StreamManager() {
 #if MXNET_USE_CUDA
+  num_io_streams_ = dmlc::GetEnv("MXNET_GPU_COPY_STREAMS", 1);
+  CHECK_GE(num_io_streams_, 1) << "MXNET_GPU_COPY_STREAMS must be at least 1";
   for (std::size_t i = 0; i < kNumGpus; ++i) {
     gpu_cnt_.at(i) = -1;
-  }
-  for (auto&& i : gpu_io_streams_) {
-    i = nullptr;
+    gpu_io_cnt_.at(i) = 0;
   }
 #endif  // MXNET_USE_CUDA
 }
@@ -162,6 +177,11 @@ void StreamManager<kNumGpus, kStreams>::Finalize() {
       }
       gpu_cnt_.at(i) = -1;
     }
+    for (auto&& io_stream : gpu_io_streams_.at(i)) {
+      // Catch exception for CUDA driver shutdown
+      MSHADOW_CATCH_ERROR(mshadow::DeleteStream<gpu>(io_stream));
+    }
+    gpu_io_streams_.at(i).clear();
   }
 #endif  // MXNET_USE_CUDA
 }
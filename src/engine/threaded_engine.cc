@@ -49,7 +49,7 @@ ThreadedVar::ThreadedVar(VersionedVarBlock* head) : head_{head} {
 }
 
 inline void ThreadedVar::AppendReadDependency(OprBlock* opr_block) {
-  std::lock_guard<std::mutex> lock{mutex_};
+  std::lock_guard<VarMutex> lock{mutex_};
   if (pending_write_ == nullptr) {
     // invariant: is_ready_to_read()
     CHECK_GE(num_pending_reads_, 0);
@@ -71,7 +71,7 @@ inline void ThreadedVar::AppendReadDependency(OprBlock* opr_block) {
 
 inline void ThreadedVar::AppendWriteDependency(OprBlock* opr_block) {
   auto&& new_var_block = VersionedVarBlock::New();
-  std::lock_guard<std::mutex> lock{mutex_};
+  std::lock_guard<VarMutex> lock{mutex_};
   // invariant.
   assert(head_->next == nullptr);
   assert(head_->trigger == nullptr);
@@ -85,6 +85,7 @@ inline void ThreadedVar::AppendWriteDependency(OprBlock* opr_block) {
   if (pending_write_ == nullptr) {
     // invariant: is_ready_to_read()
     pending_write_ = head_;
+    ready_flag_.store(false, std::memory_order_relaxed);
     CHECK_GE(num_pending_reads_, 0);
     if (num_pending_reads_ == 0) {
       // STATE CHANGE
@@ -102,7 +103,7 @@ inline void ThreadedVar::CompleteReadDependency(Dispatcher dispatcher) {
   OprBlock *trigger = nullptr;
   {
     // this is lock scope
-    std::lock_guard<std::mutex> lock{mutex_};
+    std::lock_guard<VarMutex> lock{mutex_};
     CHECK_GT(num_pending_reads_, 0);
 
     if (--num_pending_reads_ == 0) {
@@ -124,7 +125,7 @@ inline bool ThreadedVar::CompleteWriteDependency(Dispatcher dispatcher) {
   VersionedVarBlock *old_pending_write, *end_of_read_chain;
   OprBlock* trigger_write = nullptr;
   {
-    std::lock_guard<std::mutex> lock{mutex_};
+    std::lock_guard<VarMutex> lock{mutex_};
     // invariants
     assert(head_->next == nullptr);
     assert(pending_write_ != nullptr);
@@ -154,6 +155,9 @@ inline bool ThreadedVar::CompleteWriteDependency(Dispatcher dispatcher) {
     }
     if (end_of_read_chain == head_) {
       pending_write_ = nullptr;
+      // release pairs with the acquire load in ready_to_read(), so a waiter
+      // taking the lock-free path observes all writes made by completed ops
+      ready_flag_.store(true, std::memory_order_release);
     } else {
       // check if there is pending reads, if not trigger write
       assert(end_of_read_chain->write == true);
@@ -190,17 +194,23 @@ inline bool ThreadedVar::CompleteWriteDependency(Dispatcher dispatcher) {
 }
 
 inline void ThreadedVar::SetToDelete() {
-  std::lock_guard<std::mutex> lock{mutex_};
+  std::lock_guard<VarMutex> lock{mutex_};
   to_delete_ = true;
 }
 
 inline bool ThreadedVar::ready_to_read() {
-  std::lock_guard<std::mutex> lock{mutex_};
+  // lock-free fast path: a true flag means a write-complete transition has
+  // been observed with nothing re-appended at that point, which is exactly
+  // as strong a guarantee as checking under the lock gives a racing caller
+  if (ready_flag_.load(std::memory_order_acquire)) {
+    return true;
+  }
+  std::lock_guard<VarMutex> lock{mutex_};
   return this->is_ready_to_read();
 }
 
 inline size_t ThreadedVar::version() {
-  std::lock_guard<std::mutex> lock{mutex_};
+  std::lock_guard<VarMutex> lock{mutex_};
   return this->version_;
 }
 
@@ -292,6 +302,9 @@ void ThreadedEngine::Push(OprHandle op, Context exec_ctx, int priority, bool pro
     threaded_opr->opr_name =
         profiler::CustomOpProfiler::Get()->GenerateDisplayName(threaded_opr->opr_name);
   }
+  // carry the pushing request's memory budget to the worker thread that
+  // will run the op
+  threaded_opr->mem_budget = storage::MemoryBudget::CurrentScope();
   OprBlock* opr_block = OprBlock::New();
   opr_block->opr = threaded_opr;
 
@@ -302,6 +315,15 @@ void ThreadedEngine::Push(OprHandle op, Context exec_ctx, int priority, bool pro
   opr_block->priority = priority;
   opr_block->profiling = profiling;
   ++pending_;
+  profiler::RuntimeStats::Get()->LanePushed(
+      profiler::RuntimeStats::LaneOf(priority));
+  if (profiler::RuntimeStats::Get()->enabled()) {
+    profiler::RuntimeStats::Get()->OpPushed();
+  }
+  if (EngineDepGraph::Get()->enabled()) {
+    opr_block->dep_graph_id = EngineDepGraph::Get()->RecordPush(
+        threaded_opr->opr_name, threaded_opr->const_vars, threaded_opr->mutable_vars);
+  }
   // Add read dependencies.
   for (auto&& i : threaded_opr->const_vars) {
     i->AppendReadDependency(opr_block);
@@ -311,7 +333,18 @@ void ThreadedEngine::Push(OprHandle op, Context exec_ctx, int priority, bool pro
     i->AppendWriteDependency(opr_block);
   }
   if (opr_block->decr_wait() == 0) {
-    this->PushToExecute(opr_block, true);
+    // Inline bypass: for CPU ops declared cheaper than the dispatch
+    // overhead whose vars are all immediately ready, skip the queue
+    // round-trip and run on the pushing thread.
+    if (inline_bypass_threshold_ > 0 &&
+        threaded_opr->cost_hint > 0 &&
+        threaded_opr->cost_hint <= inline_bypass_threshold_ &&
+        exec_ctx.dev_mask() == cpu::kDevMask &&
+        threaded_opr->prop == FnProperty::kNormal) {
+      this->ExecuteOprBlock(RunContext{exec_ctx, nullptr, nullptr, false}, opr_block);
+    } else {
+      this->PushToExecute(opr_block, true);
+    }
   }
 }
 
@@ -340,9 +373,95 @@ void ThreadedEngine::PushAsync(AsyncFn fn, Context exec_ctx,
   ThreadedOpr *opr = NewOperator(std::move(fn), const_vars, mutable_vars,
                                  prop, opr_name, wait);
   opr->temporary = true;
+  // unprioritized pushes inherit the calling thread's scheduling lane
+  if (priority == 0) priority = ThreadLocalDefaultPriority();
   Push(opr, exec_ctx, priority, profiling);
 }
 
+bool ThreadedEngine::TryPushAsync(AsyncFn fn, Context exec_ctx,
+                                  std::vector<VarHandle> const& const_vars,
+                                  std::vector<VarHandle> const& mutable_vars,
+                                  FnProperty prop,
+                                  int priority,
+                                  const char* opr_name,
+                                  bool wait) {
+  // classify by the lane the push would land on, including the
+  // thread-local default substituted by PushAsync
+  if (priority == 0) priority = ThreadLocalDefaultPriority();
+  const int lane = profiler::RuntimeStats::LaneOf(priority);
+  const int limit = lane_limit_[lane];
+  if (limit > 0 &&
+      profiler::RuntimeStats::Get()->LaneDepth(lane) >= limit) {
+    profiler::RuntimeStats::Get()->PushRejected();
+    return false;
+  }
+  this->PushAsync(std::move(fn), exec_ctx, const_vars, mutable_vars,
+                  prop, priority, opr_name, wait);
+  return true;
+}
+
+void ThreadedEngine::PushAsyncBatch(std::vector<AsyncOprEntry>* entries,
+                                    Context exec_ctx) {
+#if MXNET_USE_CUDA
+  if (exec_ctx.dev_mask() == gpu::kDevMask) {
+    if (device_count_ < 0) {
+      int tmp = -1;
+      cudaGetDeviceCount(&tmp);
+      device_count_ = tmp;
+      CHECK_GT(device_count_, 0) << "GPU usage requires at least 1 GPU";
+    }
+    CHECK_LT(exec_ctx.dev_id, device_count_)
+        << "Invalid GPU Id: " << exec_ctx.dev_id
+        << ", Valid device id should be less than device_count: "
+        << device_count_;
+  }
+#endif
+  // Flush any pending bulk once; the per-entry pushes below bypass Push()
+  // so the context check and profiling lookup are paid once per batch.
+  BulkFlush();
+  const bool profiling = profiler_->IsProfiling(profiler::Profiler::kImperative);
+  for (AsyncOprEntry& entry : *entries) {
+    ThreadedOpr* threaded_opr =
+        NewOperator(std::move(entry.exec_fun), entry.const_vars,
+                    entry.mutable_vars, entry.prop, entry.opr_name);
+    threaded_opr->temporary = true;
+    threaded_opr->mem_budget = storage::MemoryBudget::CurrentScope();
+    if (profiling) {
+      threaded_opr->opr_name =
+          profiler::CustomOpProfiler::Get()->GenerateDisplayName(threaded_opr->opr_name);
+    }
+    OprBlock* opr_block = OprBlock::New();
+    opr_block->opr = threaded_opr;
+    opr_block->wait.store(static_cast<int>(
+        threaded_opr->const_vars.size() +
+        threaded_opr->mutable_vars.size() + 1));
+    opr_block->ctx = exec_ctx;
+    opr_block->priority = entry.priority;
+    opr_block->profiling = profiling;
+    ++pending_;
+    profiler::RuntimeStats::Get()->LanePushed(
+        profiler::RuntimeStats::LaneOf(entry.priority));
+    if (profiler::RuntimeStats::Get()->enabled()) {
+      profiler::RuntimeStats::Get()->OpPushed();
+    }
+    if (EngineDepGraph::Get()->enabled()) {
+      opr_block->dep_graph_id = EngineDepGraph::Get()->RecordPush(
+          threaded_opr->opr_name, threaded_opr->const_vars, threaded_opr->mutable_vars);
+    }
+    // Add read dependencies.
+    for (auto&& i : threaded_opr->const_vars) {
+      i->AppendReadDependency(opr_block);
+    }
+    // Add write dependencies.
+    for (auto&& i : threaded_opr->mutable_vars) {
+      i->AppendWriteDependency(opr_block);
+    }
+    if (opr_block->decr_wait() == 0) {
+      this->PushToExecute(opr_block, true);
+    }
+  }
+}
+
 void ThreadedEngine::PushSync(SyncFn exec_fn, Context exec_ctx,
                               std::vector<VarHandle> const& const_vars,
                               std::vector<VarHandle> const& mutable_vars,
@@ -376,6 +495,26 @@ void ThreadedEngine::DeleteVariable(SyncFn delete_fn,
     "DeleteVariable");
 }
 
+void ThreadedEngine::DeleteVariables(SyncFn delete_fn,
+                                     Context exec_ctx,
+                                     std::vector<VarHandle> const& vars) {
+  std::vector<ThreadedVar*> threaded_vars(vars.size());
+  std::transform(vars.begin(), vars.end(),
+                 threaded_vars.begin(), ThreadedVar::CastFromBase);
+  // One op mutating all vars: it runs once every var has drained its
+  // pending operations, marks them all as orphans and frees the memory,
+  // instead of one scheduler round-trip per var.
+  this->PushAsync([delete_fn, threaded_vars](RunContext ctx,
+                                             CallbackOnComplete on_complete) {
+      for (ThreadedVar* threaded_var : threaded_vars) {
+        threaded_var->SetToDelete();
+      }
+      delete_fn(ctx);
+      on_complete();
+    }, exec_ctx, {}, vars, FnProperty::kDeleteVar, 0,
+    "DeleteVariables");
+}
+
 void ThreadedEngine::WaitForVar(VarHandle var) {
   BulkFlush();
   ThreadedVar* threaded_var = ThreadedVar::CastFromBase(var);
@@ -489,8 +628,31 @@ inline void ThreadedEngine::OnComplete(ThreadedOpr* threaded_opr) {
 
   // delete operator if it is temperory
   if (is_temporary_opr) {
-    ThreadedOpr::Delete(threaded_opr);
+    if (epoch_reclaim_) {
+      RetireTemporaryOpr(threaded_opr, npending == 0);
+    } else {
+      ThreadedOpr::Delete(threaded_opr);
+    }
+  }
+}
+
+inline void ThreadedEngine::RetireTemporaryOpr(ThreadedOpr* threaded_opr,
+                                               bool quiescent) {
+  std::vector<Engine::AsyncFn> sealed;
+  {
+    std::lock_guard<std::mutex> lock{epoch_garbage_m_};
+    epoch_garbage_.push_back(std::move(threaded_opr->fn));
+    if (quiescent || epoch_garbage_.size() >= kReclaimEpochSize) {
+      sealed.swap(epoch_garbage_);
+    }
   }
+  // the opr itself goes back to the object pool right away; only its
+  // closure, which owns the captured NDArray references, is parked
+  ThreadedOpr::Delete(threaded_opr);
+  // destroying a sealed epoch here releases all its captured chunks on
+  // this one thread; without the parking every worker would drop its own
+  // op's references, bouncing the refcount cache lines across cores
+  sealed.clear();
 }
 
 inline void ThreadedEngine::ThrowException(ThreadedVar* threaded_var) {
@@ -519,6 +681,16 @@ void ThreadedEngine::OnCompleteStatic(Engine *engine, void *opr_block_,
     // record operator end timestamp
     opr_block->opr_profile->stop();
   }
+  profiler::RuntimeStats* stats = profiler::RuntimeStats::Get();
+  if (stats->enabled()) {
+    const uint64_t start = opr_block->stats_start_ns;
+    stats->OpCompleted(static_cast<int>(threaded_opr->prop),
+                       start ? profiler::RuntimeStats::NowNs() - start : 0);
+  }
+  if (opr_block->dep_graph_id) {
+    EngineDepGraph::Get()->RecordComplete(opr_block->dep_graph_id);
+  }
+  stats->LaneCompleted(profiler::RuntimeStats::LaneOf(opr_block->priority));
   static_cast<ThreadedEngine*>(engine)->OnComplete(threaded_opr);
   OprBlock::Delete(opr_block);
 }
@@ -31,8 +31,10 @@
 #include <dmlc/logging.h>
 #include <dmlc/omp.h>
 #include <mxnet/storage.h>
+#include <algorithm>
 #include <vector>
 #include <functional>
+#include <chrono>
 #include <condition_variable>
 #include <atomic>
 #include <utility>
@@ -43,11 +45,30 @@
 #include "../profiler/profiler.h"
 #include "./openmp.h"
 #include "../common/object_pool.h"
+#include "../common/spin_lock.h"
 #include "../profiler/custom_op_profiler.h"
+#include "../profiler/storage_profiler.h"
+#include "../storage/memory_budget.h"
+#include "../profiler/runtime_stats.h"
+#include "./exec_trace.h"
+#include "./dep_graph.h"
 
 namespace mxnet {
 namespace engine {
 
+/*!
+ * \brief Lock type protecting the per-var dependency queue.
+ *  The critical sections only splice a few pointers, so an opt-in build
+ *  (USE_ENGINE_VAR_SPINLOCK) replaces the futex-based std::mutex with a
+ *  CAS spinlock to reduce scheduling cost when many frontend threads
+ *  push ops on thousands of small NDArrays.
+ */
+#if MXNET_ENGINE_VAR_SPINLOCK
+typedef common::SpinLock VarMutex;
+#else
+typedef std::mutex VarMutex;
+#endif
+
 // Define helper macros for debug information.
 #if ENGINE_DEBUG
 #define DEFINE_ENGINE_DEBUG_INFO(Type)                          \
@@ -83,6 +104,10 @@ struct OprBlock : public common::ObjectPoolAllocatable<OprBlock> {
   bool profiling{false};
   /*! \brief operator execution statistics */
   std::unique_ptr<profiler::ProfileOperator> opr_profile;
+  /*! \brief execution start time for the runtime stats counters */
+  uint64_t stats_start_ns{0};
+  /*! \brief id in the dependency-graph recorder, 0 if not recorded */
+  uint64_t dep_graph_id{0};
   // define possible debug information
   DEFINE_ENGINE_DEBUG_INFO(OprBlock);
   /*!
@@ -189,10 +214,9 @@ class ThreadedVar final
   ExceptionRef var_exception;
 
  private:
-  // TODO(hotpxl) change this to spinlock for faster runtime
   // TODO(hotpxl) consider rename head
   /*! \brief internal mutex of the ThreadedVar */
-  std::mutex mutex_;
+  VarMutex mutex_;
   /*!
    * \brief number of pending reads operation in the variable.
    *  will be marked as -1 when there is a already triggered pending write.
@@ -219,6 +243,13 @@ class ThreadedVar final
   bool to_delete_{false};
   /*! \brief special const on num_pending_reads_ to mark write being triggered */
   static constexpr int kWriteTriggered = -1;
+  /*!
+   * \brief lock-free mirror of is_ready_to_read(), updated under mutex_ at
+   *  every pending_write_ transition. Lets ready_to_read() return without
+   *  taking the lock on already-complete variables, which is the common
+   *  case for WaitForVar on serving paths.
+   */
+  std::atomic<bool> ready_flag_{true};
   /*!
    * \brief derived invariant of ready to ready, without lock.
    * \return whether the current variable is ready to read.
@@ -252,6 +283,17 @@ struct ThreadedOpr final : public Opr,
    * \brief Whether this is a WaitForVar operation
    */
   bool wait{false};
+  /*!
+   * \brief Estimated execution cost in microseconds, 0 if unknown.
+   *  Ops whose cost is below the engine's inline bypass threshold are
+   *  executed on the pushing thread when all their vars are ready.
+   */
+  int cost_hint{0};
+  /*!
+   * \brief Memory budget of the invocation that pushed the op, if any.
+   *  Allocations made while the op executes are charged to it.
+   */
+  std::shared_ptr<storage::MemoryBudget> mem_budget;
   /*!
    * \brief Cast a Opr pointer to ThreadedOpr pointer
    * \param ptr pointer from base.
@@ -290,6 +332,9 @@ class ThreadedEngine : public Engine {
                            const char* opr_name = nullptr,
                            bool wait = false) override;
   void DeleteOperator(OprHandle op) override;
+  void SetOprCostHint(OprHandle op, int cost_hint) override {
+    ThreadedOpr::CastFromBase(op)->cost_hint = cost_hint;
+  }
   void Push(OprHandle op, Context exec_ctx, int priority = 0, bool profiling = false) override;
   void PushAsync(AsyncFn exec_fun, Context exec_ctx,
                  std::vector<VarHandle> const& const_vars,
@@ -298,6 +343,14 @@ class ThreadedEngine : public Engine {
                  int priority = 0,
                  const char* opr_name = nullptr,
                  bool wait = false) override;
+  bool TryPushAsync(AsyncFn exec_fun, Context exec_ctx,
+                    std::vector<VarHandle> const& const_vars,
+                    std::vector<VarHandle> const& mutable_vars,
+                    FnProperty prop = FnProperty::kNormal,
+                    int priority = 0,
+                    const char* opr_name = nullptr,
+                    bool wait = false) override;
+  void PushAsyncBatch(std::vector<AsyncOprEntry>* entries, Context exec_ctx) override;
   void PushSync(SyncFn exec_fn, Context exec_ctx,
                 std::vector<VarHandle> const& const_vars,
                 std::vector<VarHandle> const& mutable_vars,
@@ -305,6 +358,8 @@ class ThreadedEngine : public Engine {
                 int priority = 0,
                 const char* opr_name = nullptr) override;
   void DeleteVariable(SyncFn delete_fn, Context exec_ctx, VarHandle var) override;
+  void DeleteVariables(SyncFn delete_fn, Context exec_ctx,
+                       std::vector<VarHandle> const& vars) override;
   void WaitForVar(VarHandle var) override;
   void WaitForAll() override;
   void Throw(VarHandle var) override;
@@ -314,6 +369,21 @@ class ThreadedEngine : public Engine {
 
   ThreadedEngine() {
     engine_info_ = dmlc::GetEnv("MXNET_ENGINE_INFO", false);
+    // MXNET_ENGINE_INLINE_BYPASS_THRESHOLD: ops with a cost hint at or
+    // below this many microseconds run inline on the pushing thread when
+    // all their vars are immediately ready. 0 disables the bypass.
+    inline_bypass_threshold_ = dmlc::GetEnv("MXNET_ENGINE_INLINE_BYPASS_THRESHOLD", 0);
+    // MXNET_ENGINE_EPOCH_RECLAIM: park the closures of completed temporary
+    // operators and destroy them in per-epoch batches on a single thread,
+    // instead of dropping the captured NDArray references on whichever
+    // worker happened to finish each op.
+    epoch_reclaim_ = dmlc::GetEnv("MXNET_ENGINE_EPOCH_RECLAIM", false);
+    // MXNET_ENGINE_MAX_PENDING_{BACKGROUND,DEFAULT,REALTIME}: per-lane
+    // depth limits enforced by TryPushAsync. 0 leaves a lane unlimited;
+    // regular pushes never block on these.
+    lane_limit_[0] = dmlc::GetEnv("MXNET_ENGINE_MAX_PENDING_BACKGROUND", 0);
+    lane_limit_[1] = dmlc::GetEnv("MXNET_ENGINE_MAX_PENDING_DEFAULT", 0);
+    lane_limit_[2] = dmlc::GetEnv("MXNET_ENGINE_MAX_PENDING_REALTIME", 0);
 
     objpool_opr_ref_    = common::ObjectPool<ThreadedOpr>::_GetSharedRef();
     objpool_blk_ref_    = common::ObjectPool<OprBlock>::_GetSharedRef();
@@ -351,6 +421,19 @@ class ThreadedEngine : public Engine {
    */
   void ExecuteOprBlock(RunContext run_ctx, OprBlock* opr_block) {
     ThreadedOpr* threaded_opr = opr_block->opr;
+    EngineExecTrace* trace = EngineExecTrace::Get();
+    if (trace->enabled()) {
+      trace->Record(threaded_opr->opr_name,
+                    opr_block->ctx.dev_type, opr_block->ctx.dev_id,
+                    static_cast<uint32_t>(threaded_opr->const_vars.size()),
+                    static_cast<uint32_t>(threaded_opr->mutable_vars.size()));
+    }
+    if (profiler::RuntimeStats::Get()->enabled()) {
+      opr_block->stats_start_ns = profiler::RuntimeStats::NowNs();
+    }
+    if (opr_block->dep_graph_id) {
+      EngineDepGraph::Get()->RecordStart(opr_block->dep_graph_id);
+    }
     if (opr_block->profiling && threaded_opr->opr_name) {
       std::unique_ptr<profiler::ProfileOperator::Attributes> attrs;
       if (profiler_->AggregateEnabled()) {
@@ -368,6 +451,17 @@ class ThreadedEngine : public Engine {
       LOG(INFO) << "ExecuteOprBlock " << opr_block
                 << "shutdown_phase=" << shutdown_phase_;
     }
+    // attribute allocations made during execution to this operator
+    storage::DeviceStorageProfiler::CurrentScope() = threaded_opr->opr_name;
+    // charge them to the budget of the request that pushed the op; saved and
+    // restored because inline bypass runs on the pushing thread, whose own
+    // scope must survive
+    std::shared_ptr<storage::MemoryBudget> saved_budget;
+    const bool budgeted = threaded_opr->mem_budget != nullptr;
+    if (budgeted) {
+      saved_budget = std::move(storage::MemoryBudget::CurrentScope());
+      storage::MemoryBudget::CurrentScope() = threaded_opr->mem_budget;
+    }
     // still run cleanup in shutdown_phase
     if (!shutdown_phase_ || threaded_opr->prop == FnProperty::kDeleteVar) {
       try {
@@ -409,6 +503,12 @@ class ThreadedEngine : public Engine {
     } else {
       callback();
     }
+    // threaded_opr may already be recycled here for completed temporary ops,
+    // so the restore is keyed on the flag read before execution
+    if (budgeted) {
+      storage::MemoryBudget::CurrentScope() = std::move(saved_budget);
+    }
+    storage::DeviceStorageProfiler::CurrentScope() = nullptr;
   }
 
   int bulk_size() const override {
@@ -434,6 +534,10 @@ class ThreadedEngine : public Engine {
     int bulk_size = 0;
     /*! \brief current number of ops in bulk */
     int count = 0;
+    /*! \brief adaptive bulk window, in [1, bulk_size]; 0 = not initialized */
+    int adaptive_size = 0;
+    /*! \brief steady-clock time of the last append, in ns */
+    uint64_t last_append_ns = 0;
     /*! \brief context of current ops */
     Context ctx;
     /*! \brief current op functions */
@@ -446,6 +550,40 @@ class ThreadedEngine : public Engine {
   /*! thread local store for bulk */
   typedef dmlc::ThreadLocalStore<BulkStatus> BulkStatusStore;
 
+  /*! \return whether adaptive bulking (MXNET_ENGINE_ADAPTIVE_BULK) is on */
+  static bool AdaptiveBulkEnabled() {
+    static bool enabled = dmlc::GetEnv("MXNET_ENGINE_ADAPTIVE_BULK", false);
+    return enabled;
+  }
+
+  /*!
+   * \brief Number of appended ops that triggers a flush for this bulk.
+   *
+   *  With adaptive bulking the window follows the op arrival rate:
+   *  back-to-back appends grow it toward bulk_size so steady streams
+   *  keep full bulks, while a gap above kSlowArrivalNs halves it so a
+   *  slow producer is not left waiting on a half-filled bulk.
+   * \param bulk_status the calling thread's bulk state
+   * \return the current flush threshold, in [1, bulk_size]
+   */
+  static int EffectiveBulkSize(BulkStatus* bulk_status) {
+    if (!AdaptiveBulkEnabled()) return bulk_status->bulk_size;
+    static constexpr uint64_t kSlowArrivalNs = 50000;  // 50us
+    const uint64_t now = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    if (bulk_status->adaptive_size == 0) {
+      bulk_status->adaptive_size = std::max(1, bulk_status->bulk_size / 4);
+    } else if (bulk_status->last_append_ns &&
+               now - bulk_status->last_append_ns > kSlowArrivalNs) {
+      bulk_status->adaptive_size = std::max(1, bulk_status->adaptive_size / 2);
+    } else if (bulk_status->adaptive_size < bulk_status->bulk_size) {
+      ++bulk_status->adaptive_size;
+    }
+    bulk_status->last_append_ns = now;
+    return bulk_status->adaptive_size;
+  }
+
   /*!
    * \brief check if thee is duplication in const_vars and mutable_vars.
    * \param const_vars the variables to read from.
@@ -459,6 +597,13 @@ class ThreadedEngine : public Engine {
    * On operation completion, this will trigger subsequent operations.
    */
   inline void OnComplete(ThreadedOpr* threaded_opr);
+  /*!
+   * \brief Park the closure of a completed temporary operator for
+   *  epoch-based reclamation instead of destroying it in place.
+   * \param threaded_opr the completed temporary operator
+   * \param quiescent whether this completion left no pending operations
+   */
+  inline void RetireTemporaryOpr(ThreadedOpr* threaded_opr, bool quiescent);
   /*!
    * \brief rethrow caught exception in WaitForVar
    * \param threaded_var the var that we are waiting to read
@@ -522,7 +667,7 @@ class ThreadedEngine : public Engine {
     bulk_status.mutable_vars.insert(
         bulk_status.mutable_vars.end(), mutable_vars.begin(), mutable_vars.end());
 
-    if (bulk_status.count >= bulk_status.bulk_size) BulkFlush();
+    if (bulk_status.count >= EffectiveBulkSize(&bulk_status)) BulkFlush();
   }
   /*! \brief flush current bulk to execution */
   inline void BulkFlush() {
@@ -560,6 +705,18 @@ class ThreadedEngine : public Engine {
   std::atomic<bool> shutdown_phase_{false};
   /*!\brief show more information from engine actions */
   bool engine_info_{false};
+  /*! \brief max cost hint (us) for inline bypass execution, 0 = disabled */
+  int inline_bypass_threshold_{0};
+  /*! \brief per-lane pending op limits for TryPushAsync, 0 = unlimited */
+  int lane_limit_[profiler::RuntimeStats::kNumLanes]{};
+  /*! \brief whether closures of completed temporary ops are reclaimed in epochs */
+  bool epoch_reclaim_{false};
+  /*! \brief number of parked closures that seals the current epoch */
+  static constexpr size_t kReclaimEpochSize = 64;
+  /*! \brief closures of the current epoch awaiting batched destruction */
+  std::vector<Engine::AsyncFn> epoch_garbage_;
+  /*! \brief protects epoch_garbage_ */
+  std::mutex epoch_garbage_m_;
   /*! \brief debug information about wait for var. */
   std::atomic<ThreadedVar*> debug_wait_var_{nullptr};
   /*! \brief debug information about wait for var. */
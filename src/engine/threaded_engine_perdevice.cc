@@ -31,11 +31,66 @@
 #include "../initialize.h"
 #include "./threaded_engine.h"
 #include "./thread_pool.h"
+#include "./work_stealing_queue.h"
 #include "../common/lazy_alloc_array.h"
+#include "../common/thread_budget.h"
 #include "../common/utils.h"
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#endif
 
 namespace mxnet {
 namespace engine {
+
+#if defined(__linux__)
+/*!
+ * \brief Discover the NUMA topology from sysfs.
+ * \return list of cpu id lists, one per NUMA node; empty if unavailable.
+ */
+static std::vector<std::vector<int>> GetNumaNodeCpus() {
+  std::vector<std::vector<int>> nodes;
+  for (int node = 0; ; ++node) {
+    std::ostringstream path;
+    path << "/sys/devices/system/node/node" << node << "/cpulist";
+    std::ifstream fin(path.str().c_str());
+    if (!fin.good()) break;
+    std::string cpulist;
+    std::getline(fin, cpulist);
+    std::vector<int> cpus;
+    std::istringstream iss(cpulist);
+    std::string range;
+    while (std::getline(iss, range, ',')) {
+      const size_t dash = range.find('-');
+      if (dash == std::string::npos) {
+        cpus.push_back(std::atoi(range.c_str()));
+      } else {
+        const int lo = std::atoi(range.substr(0, dash).c_str());
+        const int hi = std::atoi(range.substr(dash + 1).c_str());
+        for (int cpu = lo; cpu <= hi; ++cpu) cpus.push_back(cpu);
+      }
+    }
+    if (!cpus.empty()) nodes.push_back(std::move(cpus));
+  }
+  return nodes;
+}
+
+/*!
+ * \brief Bind the calling thread to a set of cpus.
+ * \param cpus cpu ids the thread may run on.
+ */
+static void SetCurrentThreadAffinity(const std::vector<int>& cpus) {
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (int cpu : cpus) CPU_SET(cpu, &cpuset);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+}
+#endif  // __linux__
 /*!
  * \brief ThreadedEngine uses per device threads.
  * The policy of this Engine:
@@ -52,7 +107,8 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
   static auto constexpr kPriorityQueue = kPriority;
   static auto constexpr kWorkerQueue = kFIFO;
 
-  ThreadedEnginePerDevice() noexcept(false) {
+  explicit ThreadedEnginePerDevice(bool cpu_work_stealing = false) noexcept(false)
+      : cpu_work_stealing_(cpu_work_stealing) {
     this->Start();
   }
   ~ThreadedEnginePerDevice() noexcept(false) {
@@ -65,6 +121,8 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
     gpu_priority_workers_.Clear();
     gpu_copy_workers_.Clear();
     cpu_normal_workers_.Clear();
+    cpu_ws_workers_.Clear();
+    cpu_numa_workers_.clear();
     cpu_priority_worker_.reset(nullptr);
   }
 
@@ -86,8 +144,35 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
     cpu_priority_worker_->pool.reset(new ThreadPool(
         cpu_priority_nthreads,
         [this](std::shared_ptr<dmlc::ManualEvent> ready_event) {
+          common::ThreadCoreBudget::ApplyToCurrentThread("engine");
           this->CPUWorker(Context(), cpu_priority_worker_.get(), ready_event);
         }, true));
+#if defined(__linux__)
+    // MXNET_CPU_NUMA_AWARE: create one CPU worker pool per NUMA node with
+    // the pool's threads bound to that node, and route each op to the pool
+    // owning its first mutable var. With first-touch allocation this keeps
+    // a tensor and the workers that process it on the same node.
+    if (dmlc::GetEnv("MXNET_CPU_NUMA_AWARE", false)) {
+      numa_node_cpus_ = GetNumaNodeCpus();
+      if (numa_node_cpus_.size() > 1) {
+        const size_t nnodes = numa_node_cpus_.size();
+        const size_t nthread_per_node =
+            std::max(static_cast<size_t>(1), cpu_worker_nthreads_ / nnodes);
+        for (size_t node = 0; node < nnodes; ++node) {
+          auto blk = new ThreadWorkerBlock<kWorkerQueue>();
+          const std::vector<int>& cpus = numa_node_cpus_[node];
+          blk->pool.reset(new ThreadPool(nthread_per_node,
+              [this, blk, cpus](std::shared_ptr<dmlc::ManualEvent> ready_event) {
+                // the per-node binding is narrower than any "engine" core
+                // set from MXNET_CPU_CORE_SETS, so it is kept as is
+                SetCurrentThreadAffinity(cpus);
+                this->CPUWorker(Context(), blk, ready_event);
+              }, true));
+          cpu_numa_workers_.emplace_back(blk);
+        }
+      }
+    }
+#endif
     // GPU tasks will be created lazily
   }
 
@@ -107,6 +192,39 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
         // CPU execution.
         if (opr_block->opr->prop == FnProperty::kCPUPrioritized) {
           cpu_priority_worker_->task_queue.Push(opr_block, opr_block->priority);
+        } else if (!cpu_numa_workers_.empty()) {
+          // route to the pool on the NUMA node owning the first mutable var;
+          // ops without mutable vars go round-robin by opr address
+          const auto& mvars = opr_block->opr->mutable_vars;
+          const size_t key = mvars.empty()
+              ? reinterpret_cast<size_t>(opr_block->opr)
+              : reinterpret_cast<size_t>(mvars[0]);
+          auto* blk = cpu_numa_workers_[(key >> 6) % cpu_numa_workers_.size()].get();
+          if (opr_block->opr->prop == FnProperty::kDeleteVar) {
+            blk->task_queue.PushFront(opr_block, opr_block->priority);
+          } else {
+            blk->task_queue.Push(opr_block, opr_block->priority);
+          }
+        } else if (cpu_work_stealing_) {
+          // Work-stealing mode: per-worker deques instead of one shared queue.
+          int dev_id = ctx.dev_id;
+          int nthread = cpu_worker_nthreads_;
+          auto ptr = cpu_ws_workers_.Get(dev_id, [this, ctx, nthread]() {
+            auto blk = new WSThreadWorkerBlock(nthread);
+            blk->pool.reset(new ThreadPool(nthread,
+                [this, ctx, blk](std::shared_ptr<dmlc::ManualEvent> ready_event) {
+                  common::ThreadCoreBudget::ApplyToCurrentThread("engine");
+                  this->CPUWorkerWS(ctx, blk, ready_event);
+                }, true));
+            return blk;
+          });
+          if (ptr) {
+            if (opr_block->opr->prop == FnProperty::kDeleteVar) {
+              ptr->task_queue.PushFront(opr_block);
+            } else {
+              ptr->task_queue.Push(opr_block);
+            }
+          }
         } else {
           int dev_id = ctx.dev_id;
           int nthread = cpu_worker_nthreads_;
@@ -115,6 +233,7 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
               auto blk = new ThreadWorkerBlock<kWorkerQueue>();
               blk->pool.reset(new ThreadPool(nthread,
                   [this, ctx, blk](std::shared_ptr<dmlc::ManualEvent> ready_event) {
+                    common::ThreadCoreBudget::ApplyToCurrentThread("engine");
                     this->CPUWorker(ctx, blk, ready_event);
                   }, true));
             return blk;
@@ -214,8 +333,25 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
     ~ThreadWorkerBlock() noexcept(false) {}
   };
 
+  // working unit for work-stealing CPU workers.
+  struct WSThreadWorkerBlock {
+    // per-worker task deques with steal-on-empty
+    WorkStealingTaskQueue<OprBlock*> task_queue;
+    // thread pool that works on this task
+    std::unique_ptr<ThreadPool> pool;
+    // cursor assigning a deque to each worker thread
+    std::atomic<size_t> next_worker_id;
+    // constructor
+    explicit WSThreadWorkerBlock(size_t nworkers)
+        : task_queue(nworkers), next_worker_id(0) {}
+    // destructor
+    ~WSThreadWorkerBlock() noexcept(false) {}
+  };
+
   /*! \brief whether this is a worker thread. */
   static MX_THREAD_LOCAL bool is_worker_;
+  /*! \brief whether CPU normal workers use work-stealing deques */
+  bool cpu_work_stealing_;
   /*! \brief number of concurrent thread cpu worker uses */
   size_t cpu_worker_nthreads_;
   /*! \brief number of concurrent thread each gpu worker uses */
@@ -224,6 +360,12 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
   size_t gpu_copy_nthreads_;
   // cpu worker
   common::LazyAllocArray<ThreadWorkerBlock<kWorkerQueue> > cpu_normal_workers_;
+  // cpu worker in work-stealing mode
+  common::LazyAllocArray<WSThreadWorkerBlock> cpu_ws_workers_;
+  // per-NUMA-node cpu workers (empty unless MXNET_CPU_NUMA_AWARE is set)
+  std::vector<std::unique_ptr<ThreadWorkerBlock<kWorkerQueue> > > cpu_numa_workers_;
+  // cpu id lists per NUMA node
+  std::vector<std::vector<int> > numa_node_cpus_;
   // cpu priority worker
   std::unique_ptr<ThreadWorkerBlock<kPriorityQueue> > cpu_priority_worker_;
   // workers doing normal works on GPU
@@ -303,6 +445,32 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
     }
   }
 
+  /*!
+   * \brief CPU worker that pops from its own deque and steals when empty.
+   * \param ctx context of the worker
+   * \param block The task block of the worker.
+   */
+  inline void CPUWorkerWS(Context ctx,
+                          WSThreadWorkerBlock *block,
+                          const std::shared_ptr<dmlc::ManualEvent>& ready_event) {
+    this->is_worker_ = true;
+    const size_t worker_id =
+        block->next_worker_id.fetch_add(1, std::memory_order_relaxed);
+    auto* task_queue = &(block->task_queue);
+    RunContext run_ctx{ctx, nullptr, nullptr, false};
+
+    // execute task
+    OprBlock* opr_block;
+    ready_event->signal();
+
+    // Set default number of threads for OMP parallel regions initiated by this thread
+    OpenMP::Get()->on_start_worker_thread(true);
+
+    while (task_queue->Pop(&opr_block, worker_id)) {
+      this->ExecuteOprBlock(run_ctx, opr_block);
+    }
+  }
+
   /*!
    * \brief Get number of cores this engine should reserve for its own use
    * \param using_gpu Whether there is GPU usage
@@ -338,6 +506,10 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
     SignalQueueForKill(&gpu_normal_workers_);
     SignalQueueForKill(&gpu_copy_workers_);
     SignalQueueForKill(&cpu_normal_workers_);
+    SignalQueueForKill(&cpu_ws_workers_);
+    for (auto& blk : cpu_numa_workers_) {
+      blk->task_queue.SignalForKill();
+    }
     if (cpu_priority_worker_) {
       cpu_priority_worker_->task_queue.SignalForKill();
     }
@@ -348,6 +520,10 @@ Engine *CreateThreadedEnginePerDevice() {
   return new ThreadedEnginePerDevice();
 }
 
+Engine *CreateThreadedEnginePerDeviceWorkStealing() {
+  return new ThreadedEnginePerDevice(true);
+}
+
 MX_THREAD_LOCAL bool ThreadedEnginePerDevice::is_worker_ = false;
 
 }  // namespace engine
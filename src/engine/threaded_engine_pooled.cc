@@ -46,6 +46,8 @@ namespace engine {
  */
 class ThreadedEnginePooled : public ThreadedEngine {
  public:
+  static auto constexpr kPriority = dmlc::ConcurrentQueueType::kPriority;
+
   ThreadedEnginePooled() {
     this->Start();
   }
@@ -72,8 +74,8 @@ class ThreadedEnginePooled : public ThreadedEngine {
 
   void Start() override {
     streams_.reset(new StreamManager<kMaxNumGpus, kNumStreamsPerGpu>());
-    task_queue_.reset(new dmlc::ConcurrentBlockingQueue<OprBlock*>());
-    io_task_queue_.reset(new dmlc::ConcurrentBlockingQueue<OprBlock*>());
+    task_queue_.reset(new dmlc::ConcurrentBlockingQueue<OprBlock*, kPriority>());
+    io_task_queue_.reset(new dmlc::ConcurrentBlockingQueue<OprBlock*, kPriority>());
     thread_pool_.reset(new ThreadPool(kNumWorkingThreads,
                                       [this](std::shared_ptr<dmlc::ManualEvent> ready_event) {
                                         ThreadWorker(task_queue_, ready_event); },
@@ -107,8 +109,8 @@ class ThreadedEnginePooled : public ThreadedEngine {
   /*!
    * \brief Task queues.
    */
-  std::shared_ptr<dmlc::ConcurrentBlockingQueue<OprBlock*>> task_queue_;
-  std::shared_ptr<dmlc::ConcurrentBlockingQueue<OprBlock*>> io_task_queue_;
+  std::shared_ptr<dmlc::ConcurrentBlockingQueue<OprBlock*, kPriority>> task_queue_;
+  std::shared_ptr<dmlc::ConcurrentBlockingQueue<OprBlock*, kPriority>> io_task_queue_;
   /*!
    * \brief Thread pools.
    */
@@ -120,7 +122,7 @@ class ThreadedEnginePooled : public ThreadedEngine {
    *
    * The method to pass to thread pool to parallelize.
    */
-  void ThreadWorker(std::shared_ptr<dmlc::ConcurrentBlockingQueue<OprBlock*>> task_queue,
+  void ThreadWorker(std::shared_ptr<dmlc::ConcurrentBlockingQueue<OprBlock*, kPriority>> task_queue,
                     const std::shared_ptr<dmlc::ManualEvent>& ready_event) {
     OprBlock* opr_block;
     ready_event->signal();
@@ -159,11 +161,11 @@ class ThreadedEnginePooled : public ThreadedEngine {
     switch (opr_block->opr->prop) {
       case FnProperty::kCopyFromGPU:
       case FnProperty::kCopyToGPU: {
-        io_task_queue_->Push(opr_block);
+        io_task_queue_->Push(opr_block, opr_block->priority);
         break;
       }
       default: {
-        task_queue_->Push(opr_block);
+        task_queue_->Push(opr_block, opr_block->priority);
         break;
       }
     }
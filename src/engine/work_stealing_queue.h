@@ -0,0 +1,171 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2019 by Contributors
+ * \file work_stealing_queue.h
+ * \brief A set of per-worker task deques with steal-on-empty semantics.
+ */
+#ifndef MXNET_ENGINE_WORK_STEALING_QUEUE_H_
+#define MXNET_ENGINE_WORK_STEALING_QUEUE_H_
+
+#include <dmlc/base.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace mxnet {
+namespace engine {
+
+/*!
+ * \brief A blocking task queue made of per-worker deques.
+ *
+ * Producers distribute tasks round-robin over the deques, each of which
+ * is guarded by its own mutex, so concurrent pushes from many frontend
+ * threads mostly hit different locks.  A worker pops from the front of
+ * its own deque and, when that is empty, steals from the back of the
+ * other deques before going to sleep.  This avoids the single shared
+ * queue lock becoming a bottleneck for bursts of small ops.
+ */
+template <typename T>
+class WorkStealingTaskQueue {
+ public:
+  /*! \brief Constructor. \param nworkers number of worker deques */
+  explicit WorkStealingTaskQueue(size_t nworkers)
+      : queues_(nworkers), next_queue_(0), pending_(0), exit_now_(false) {}
+
+  /*!
+   * \brief Push a task onto one of the deques (round-robin).
+   * \param value the task to push
+   */
+  void Push(T value) {
+    const size_t idx =
+        next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    {
+      std::lock_guard<std::mutex> lock(queues_[idx].mutex);
+      queues_[idx].tasks.push_back(value);
+    }
+    pending_.fetch_add(1, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(wait_mutex_);
+    wait_cv_.notify_one();
+  }
+
+  /*!
+   * \brief Push a task to the front of one of the deques.
+   *  Used for tasks that should bypass normal FIFO order (e.g. var deletion).
+   * \param value the task to push
+   */
+  void PushFront(T value) {
+    const size_t idx =
+        next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    {
+      std::lock_guard<std::mutex> lock(queues_[idx].mutex);
+      queues_[idx].tasks.push_front(value);
+    }
+    pending_.fetch_add(1, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(wait_mutex_);
+    wait_cv_.notify_one();
+  }
+
+  /*!
+   * \brief Pop a task, blocking until one is available or the queue is killed.
+   * \param rv output task
+   * \param worker_id id of the calling worker, in [0, nworkers)
+   * \return true if a task was popped, false if the queue was killed
+   */
+  bool Pop(T* rv, size_t worker_id) {
+    while (true) {
+      if (TryPop(worker_id, rv)) return true;
+      if (TrySteal(worker_id, rv)) return true;
+      std::unique_lock<std::mutex> lock(wait_mutex_);
+      if (exit_now_.load(std::memory_order_acquire) &&
+          pending_.load(std::memory_order_acquire) == 0) {
+        return false;
+      }
+      wait_cv_.wait(lock, [this] {
+        return pending_.load(std::memory_order_acquire) > 0 ||
+               exit_now_.load(std::memory_order_acquire);
+      });
+    }
+  }
+
+  /*! \brief Wake all workers and make subsequent Pop calls return false. */
+  void SignalForKill() {
+    {
+      std::lock_guard<std::mutex> lock(wait_mutex_);
+      exit_now_.store(true, std::memory_order_release);
+    }
+    wait_cv_.notify_all();
+  }
+
+ private:
+  /*! \brief One worker-local deque and its lock. */
+  struct LocalQueue {
+    std::mutex mutex;
+    std::deque<T> tasks;
+  };
+
+  /*! \brief Pop from the front of the worker's own deque. */
+  bool TryPop(size_t worker_id, T* rv) {
+    LocalQueue& q = queues_[worker_id % queues_.size()];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty()) return false;
+    *rv = q.tasks.front();
+    q.tasks.pop_front();
+    pending_.fetch_sub(1, std::memory_order_release);
+    return true;
+  }
+
+  /*! \brief Steal from the back of another worker's deque. */
+  bool TrySteal(size_t worker_id, T* rv) {
+    const size_t n = queues_.size();
+    for (size_t i = 1; i < n; ++i) {
+      LocalQueue& q = queues_[(worker_id + i) % n];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if (q.tasks.empty()) continue;
+      *rv = q.tasks.back();
+      q.tasks.pop_back();
+      pending_.fetch_sub(1, std::memory_order_release);
+      return true;
+    }
+    return false;
+  }
+
+  /*! \brief per-worker deques */
+  std::vector<LocalQueue> queues_;
+  /*! \brief round-robin producer cursor */
+  std::atomic<size_t> next_queue_;
+  /*! \brief total number of queued tasks */
+  std::atomic<int64_t> pending_;
+  /*! \brief whether the queue has been killed */
+  std::atomic<bool> exit_now_;
+  /*! \brief mutex for sleeping workers */
+  std::mutex wait_mutex_;
+  /*! \brief condition variable for sleeping workers */
+  std::condition_variable wait_cv_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkStealingTaskQueue);
+};
+
+}  // namespace engine
+}  // namespace mxnet
+
+#endif  // MXNET_ENGINE_WORK_STEALING_QUEUE_H_
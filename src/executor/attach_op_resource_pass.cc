@@ -43,11 +43,38 @@ void AttachOpResources(
   const auto& vdispatch = g.GetAttr<DispatchModeVector>("dispatch_mode");
   const auto& dev_masks = g.GetAttr<DevMaskVector>("dev_mask");
   const auto& idx = g.indexed_graph();
-  // Use global resource pool for each executor for now.
-  std::map<Context, Resource> cached_temp;
+  // Temp space is handed out per dependency chain: ops that are ordered by
+  // a path through the graph share one resource, so their workspaces fold
+  // into one arena slot sized to the largest request on the chain — the
+  // earlier op's workspace is dead by the time the later one runs. Ops on
+  // parallel branches get different copies from the manager's pool so the
+  // shared engine var does not serialize them. Ancestor tracking uses a
+  // per-node bitmask over slots, so at most 64 chains are distinguished;
+  // the pool size (MXNET_{CPU,GPU}_TEMP_COPY) still bounds the number of
+  // distinct buffers backing those slots.
+  static const size_t kMaxTempSlots = 64;
+  std::vector<uint64_t> ancestor_slots(idx.num_nodes(), 0);
+  std::vector<int> node_slot(idx.num_nodes(), -1);
+  std::vector<Resource> slot_rsc;
+  std::vector<Context> slot_ctx;
   // Resource allocation
   for (uint32_t nid = start_nid; nid < end_nid; ++nid) {
     const auto& inode = idx[nid];
+    // propagate which slots were last used by an ancestor of this node
+    uint64_t amask = 0;
+    for (const auto& e : inode.inputs) {
+      amask |= ancestor_slots[e.node_id];
+      if (node_slot[e.node_id] >= 0) {
+        amask |= static_cast<uint64_t>(1) << node_slot[e.node_id];
+      }
+    }
+    for (const uint32_t cid : inode.control_deps) {
+      amask |= ancestor_slots[cid];
+      if (node_slot[cid] >= 0) {
+        amask |= static_cast<uint64_t>(1) << node_slot[cid];
+      }
+    }
+    ancestor_slots[nid] = amask;
     if (inode.source->is_variable()) continue;
     const Context &ctx = vctx[nid];
     auto& requested = op_execs[nid]->op_ctx.requested;
@@ -64,14 +91,32 @@ void AttachOpResources(
       for (const ResourceRequest& req : reqs) {
         switch (req.type) {
           case ResourceRequest::kTempSpace: {
-            // the scope is needed when there's new declaration of variable.
-            if (cached_temp.count(ctx) != 0) {
-              requested.push_back(cached_temp.at(ctx));
-            } else {
-              Resource r = ResourceManager::Get()->Request(ctx, req);
-              requested.push_back(r);
-              cached_temp[ctx] = r;
+            if (node_slot[nid] < 0) {
+              // prefer a slot whose previous user already precedes this op
+              int slot = -1;
+              for (size_t s = 0; s < slot_rsc.size(); ++s) {
+                if (((amask >> s) & 1) && slot_ctx[s] == ctx) {
+                  slot = static_cast<int>(s);
+                  break;
+                }
+              }
+              if (slot < 0 && slot_rsc.size() < kMaxTempSlots) {
+                slot = static_cast<int>(slot_rsc.size());
+                slot_rsc.push_back(ResourceManager::Get()->Request(ctx, req));
+                slot_ctx.push_back(ctx);
+              }
+              if (slot < 0) {
+                // out of slot bits; fall back to the context's first slot
+                for (size_t s = 0; s < slot_rsc.size(); ++s) {
+                  if (slot_ctx[s] == ctx) {
+                    slot = static_cast<int>(s);
+                    break;
+                  }
+                }
+              }
+              node_slot[nid] = slot;
             }
+            requested.push_back(slot_rsc[node_slot[nid]]);
             break;
           }
           case ResourceRequest::kRandom: {
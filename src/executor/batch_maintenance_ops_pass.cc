@@ -0,0 +1,147 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2020 by Contributors
+ * \file batch_maintenance_ops_pass.cc
+ * \brief Pass merging groups of per-tensor maintenance ops (all_finite,
+ *        reset_arrays) into their existing multi-tensor variants, so one
+ *        launch covers all the tensors instead of one launch per tensor.
+ */
+
+#include <mxnet/base.h>
+#include <nnvm/graph.h>
+#include <nnvm/node.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "./exec_pass.h"
+
+namespace mxnet {
+namespace exec {
+namespace {
+
+using nnvm::Node;
+using nnvm::NodePtr;
+
+// Groups are keyed on the target multi-tensor op plus the attribute values
+// that must agree across merged nodes (all_finite's init_output).
+using GroupKey = std::pair<const nnvm::Op*, std::string>;
+
+/*!
+ * \brief Whether a node is safe to merge with its siblings: all of its data
+ *  inputs are variables, so no ordering constraint can exist between group
+ *  members through the data flow.
+ */
+bool OnlyVariableInputs(const Node* n) {
+  for (const auto& entry : n->inputs) {
+    if (!entry.node->is_variable()) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+Graph BatchMaintenanceOps(Graph&& g) {
+  const nnvm::Op* all_finite_op = nnvm::Op::Get("all_finite");
+  const nnvm::Op* multi_all_finite_op = nnvm::Op::Get("multi_all_finite");
+  const nnvm::Op* reset_arrays_op = nnvm::Op::Get("reset_arrays");
+
+  // Collect mergeable nodes in DFS order and group them by target op and
+  // the attributes that have to agree within a group.
+  std::map<GroupKey, std::vector<NodePtr> > groups;
+  nnvm::DFSVisit(g.outputs, [&](const NodePtr& n) {
+    if (n->is_variable() || !OnlyVariableInputs(n.get())) return;
+    if (n->op() == all_finite_op) {
+      const auto it = n->attrs.dict.find("init_output");
+      groups[{multi_all_finite_op,
+              it != n->attrs.dict.end() ? it->second : std::string()}].push_back(n);
+    } else if (n->op() == reset_arrays_op) {
+      groups[{reset_arrays_op, std::string()}].push_back(n);
+    }
+  });
+
+  std::unordered_map<const Node*, NodePtr> replaced;
+  std::vector<NodePtr> fused_nodes;
+  for (const auto& kv : groups) {
+    const std::vector<NodePtr>& members = kv.second;
+    if (members.size() < 2) continue;
+    NodePtr fused = Node::Create();
+    fused->attrs.op = kv.first.first;
+    fused->attrs.name = members.front()->attrs.name + "_batched";
+    for (const NodePtr& member : members) {
+      fused->inputs.insert(fused->inputs.end(),
+                           member->inputs.begin(), member->inputs.end());
+      fused->control_deps.insert(fused->control_deps.end(),
+                                 member->control_deps.begin(),
+                                 member->control_deps.end());
+      replaced[member.get()] = fused;
+    }
+    fused->attrs.dict["num_arrays"] = std::to_string(fused->inputs.size());
+    if (!kv.first.second.empty()) {
+      fused->attrs.dict["init_output"] = kv.first.second;
+    }
+    fused->op()->attr_parser(&(fused->attrs));
+    fused_nodes.push_back(fused);
+  }
+  if (replaced.empty()) return g;
+
+  // Rewire readers of the merged nodes.  The multi-tensor variants have at
+  // most one output, so every consumed entry maps to entry 0 of the fused
+  // node, and multiple dependencies on one group collapse to a single one.
+  std::vector<NodePtr> nodes = fused_nodes;
+  nnvm::DFSVisit(g.outputs, [&nodes](const NodePtr& n) {
+    nodes.push_back(n);
+  });
+  for (const NodePtr& n : nodes) {
+    for (auto& entry : n->inputs) {
+      const auto it = replaced.find(entry.node.get());
+      if (it != replaced.end()) {
+        entry.node = it->second;
+        entry.index = 0;
+      }
+    }
+    // remap control dependencies, collapsing duplicates onto one group and
+    // dropping dependencies between merged siblings
+    std::vector<NodePtr> deps;
+    for (const NodePtr& dep : n->control_deps) {
+      const auto it = replaced.find(dep.get());
+      const NodePtr& target = it != replaced.end() ? it->second : dep;
+      if (target != n &&
+          std::find(deps.begin(), deps.end(), target) == deps.end()) {
+        deps.push_back(target);
+      }
+    }
+    n->control_deps = std::move(deps);
+  }
+  for (auto& entry : g.outputs) {
+    const auto it = replaced.find(entry.node.get());
+    if (it != replaced.end()) {
+      entry.node = it->second;
+      entry.index = 0;
+    }
+  }
+  return g;
+}
+
+}  // namespace exec
+}  // namespace mxnet
@@ -0,0 +1,134 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2020 by Contributors
+ * \file batch_norm_relu_fusion_pass.cc
+ * \brief Pass folding a relu activation into a preceding inference-mode
+ *        BatchNorm by setting the operator's fuse_relu parameter.
+ */
+
+#include <mxnet/base.h>
+#include <nnvm/graph.h>
+#include <nnvm/node.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "./exec_pass.h"
+#include "../operator/nn/batch_norm-inl.h"
+
+namespace mxnet {
+namespace exec {
+namespace {
+
+bool IsReluNode(const nnvm::Node *n) {
+  if (n->op() == nullptr || n->inputs.size() != 1)
+    return false;
+  if (n->op() == nnvm::Op::Get("relu"))
+    return true;
+  if (n->op() == nnvm::Op::Get("Activation")) {
+    const auto it = n->attrs.dict.find("act_type");
+    return it != n->attrs.dict.end() && it->second == "relu";
+  }
+  return false;
+}
+
+}  // namespace
+
+Graph FuseBatchNormRelu(Graph &&g) {
+  const nnvm::Op *bn_op = nnvm::Op::Get("BatchNorm");
+
+  // Count the consumers of every node entry.  A BatchNorm data output that
+  // feeds anything besides the activation cannot be rewritten, since
+  // fuse_relu would clamp the values those readers see as well.
+  nnvm::NodeEntryMap<size_t> entry_refs;
+  DFSVisit(g.outputs, [&entry_refs](const nnvm::NodePtr &n) {
+    for (const auto &e : n->inputs) {
+      ++entry_refs[e];
+    }
+  });
+  for (const auto &e : g.outputs) {
+    ++entry_refs[e];
+  }
+
+  // Map each foldable activation to the BatchNorm node that absorbs it.
+  std::unordered_map<nnvm::Node *, nnvm::NodePtr> fused;
+  std::unordered_set<nnvm::Node *> fused_bns;
+  DFSVisit(g.outputs, [&](const nnvm::NodePtr &n) {
+    if (!IsReluNode(n.get()))
+      return;
+    const nnvm::NodeEntry &in = n->inputs[0];
+    if (in.node->op() != bn_op || in.index != op::batchnorm::kOut)
+      return;
+    if (in.node->attrs.dict.count("fuse_relu")
+        && in.node->attrs.dict.at("fuse_relu") == "true")
+      return;
+    if (entry_refs.at(in) != 1)
+      return;
+    fused[n.get()] = in.node;
+    fused_bns.insert(in.node.get());
+  });
+  if (fused.empty())
+    return std::move(g);
+
+  // Rebuild the graph, replacing each BatchNorm+relu pair with a single
+  // BatchNorm node carrying fuse_relu=true.  Consumers of the activation
+  // read the data output of the fused BatchNorm instead.
+  std::unordered_map<nnvm::Node *, nnvm::NodePtr> mirror_map;
+  DFSVisit(g.outputs, [&](const nnvm::NodePtr &node) {
+    nnvm::NodePtr new_node = nnvm::Node::Create();
+    new_node->attrs = node->attrs;
+    if (fused_bns.count(node.get())) {
+      new_node->attrs.dict["fuse_relu"] = "true";
+      new_node->op()->attr_parser(&(new_node->attrs));
+    }
+    for (const auto &e : node->inputs) {
+      const auto fit = fused.find(e.node.get());
+      if (fit != fused.end()) {
+        new_node->inputs.emplace_back(
+          nnvm::NodeEntry{mirror_map.at(fit->second.get()), op::batchnorm::kOut, 0});
+      } else {
+        new_node->inputs.emplace_back(
+          nnvm::NodeEntry{mirror_map.at(e.node.get()), e.index, e.version});
+      }
+    }
+    for (const auto &cd : node->control_deps) {
+      new_node->control_deps.push_back(mirror_map.at(cd.get()));
+    }
+    mirror_map[node.get()] = std::move(new_node);
+  });
+
+  Graph ret;
+  ret.outputs.reserve(g.outputs.size());
+  for (const auto &e : g.outputs) {
+    const auto fit = fused.find(e.node.get());
+    if (fit != fused.end()) {
+      ret.outputs.emplace_back(
+        nnvm::NodeEntry{mirror_map.at(fit->second.get()), op::batchnorm::kOut, 0});
+    } else {
+      ret.outputs.emplace_back(
+        nnvm::NodeEntry{mirror_map.at(e.node.get()), e.index, e.version});
+    }
+  }
+  return ret;
+}
+
+}  // namespace exec
+}  // namespace mxnet
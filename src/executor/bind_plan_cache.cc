@@ -0,0 +1,159 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file bind_plan_cache.cc
+ * \brief on-disk cache of the memory plan computed while binding a graph
+ */
+#include "./bind_plan_cache.h"
+
+#include <mxnet/base.h>
+#include <dmlc/io.h>
+#include <dmlc/common.h>
+#include <dmlc/logging.h>
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <utility>
+#include <vector>
+#include "./exec_pass.h"
+
+namespace mxnet {
+namespace exec {
+
+namespace {
+/*! \brief file magic, bumped when the plan layout changes */
+const uint64_t kPlanMagic = 0x6d786e6574706c31ULL;  // "mxnetpl1"
+}  // namespace
+
+BindPlanCache* BindPlanCache::Get() {
+  static BindPlanCache inst;
+  return &inst;
+}
+
+BindPlanCache::BindPlanCache() {
+  dir_ = dmlc::GetEnv("MXNET_EXEC_BIND_CACHE", std::string());
+}
+
+std::string BindPlanCache::PlanPath(uint64_t signature) const {
+  std::ostringstream os;
+  os << dir_ << "/mxnet_plan_" << std::hex << signature << ".bin";
+  return os.str();
+}
+
+uint64_t BindPlanCache::GraphSignature(const nnvm::Graph& g) {
+  const auto& idx = g.indexed_graph();
+  std::hash<std::string> str_hash;
+  size_t sig = idx.num_node_entries();
+  // graph structure: operators, their attributes and their wiring
+  for (uint32_t nid = 0; nid < idx.num_nodes(); ++nid) {
+    const auto& inode = idx[nid];
+    sig = dmlc::HashCombine(sig, inode.source->op() != nullptr
+        ? str_hash(inode.source->op()->name) : size_t(0));
+    // node attribute dicts are unordered, hash them in a stable order
+    std::vector<std::pair<std::string, std::string> > attrs(
+        inode.source->attrs.dict.begin(), inode.source->attrs.dict.end());
+    std::sort(attrs.begin(), attrs.end());
+    for (const auto& kv : attrs) {
+      sig = dmlc::HashCombine(sig, str_hash(kv.first));
+      sig = dmlc::HashCombine(sig, str_hash(kv.second));
+    }
+    for (const auto& e : inode.inputs) {
+      sig = dmlc::HashCombine(sig, idx.entry_id(e));
+    }
+  }
+  for (const auto& e : idx.outputs()) {
+    sig = dmlc::HashCombine(sig, idx.entry_id(e));
+  }
+  // everything the plan depends on besides the structure
+  const auto& shapes = g.GetAttr<mxnet::ShapeVector>("shape");
+  for (const mxnet::TShape& s : shapes) {
+    sig = dmlc::HashCombine(sig, s.ndim());
+    for (int i = 0; i < s.ndim(); ++i) {
+      sig = dmlc::HashCombine(sig, s[i]);
+    }
+  }
+  const auto& dtypes = g.GetAttr<nnvm::DTypeVector>("dtype");
+  for (int t : dtypes) sig = dmlc::HashCombine(sig, t);
+  const auto& stypes = g.GetAttr<StorageTypeVector>("storage_type");
+  for (int t : stypes) sig = dmlc::HashCombine(sig, t);
+  const auto& seed = g.GetAttr<nnvm::StorageVector>("storage");
+  for (int t : seed) sig = dmlc::HashCombine(sig, t);
+  if (g.attrs.count("context") != 0) {
+    const auto& ctxes = g.GetAttr<ContextVector>("context");
+    for (const Context& ctx : ctxes) {
+      sig = dmlc::HashCombine(sig, static_cast<int>(ctx.dev_type));
+      sig = dmlc::HashCombine(sig, ctx.dev_id);
+    }
+  }
+  return static_cast<uint64_t>(sig);
+}
+
+bool BindPlanCache::Load(uint64_t signature, nnvm::Graph* g) const {
+  std::unique_ptr<dmlc::Stream> strm(
+      dmlc::Stream::Create(PlanPath(signature).c_str(), "r", true));
+  if (strm == nullptr) return false;
+  uint64_t magic = 0, sig = 0, num_entries = 0, allocated_bytes = 0, not_allocated = 0;
+  nnvm::StorageVector storage_id;
+  std::vector<int> storage_inplace_index;
+  if (!strm->Read(&magic) || magic != kPlanMagic) return false;
+  if (!strm->Read(&sig) || sig != signature) return false;
+  if (!strm->Read(&num_entries)) return false;
+  if (num_entries != g->indexed_graph().num_node_entries()) return false;
+  if (!strm->Read(&storage_id) || storage_id.size() != num_entries) return false;
+  if (!strm->Read(&storage_inplace_index) ||
+      storage_inplace_index.size() != num_entries) {
+    return false;
+  }
+  if (!strm->Read(&allocated_bytes) || !strm->Read(&not_allocated)) return false;
+  g->attrs["storage_id"] = std::make_shared<dmlc::any>(std::move(storage_id));
+  g->attrs["storage_inplace_index"] =
+      std::make_shared<dmlc::any>(std::move(storage_inplace_index));
+  g->attrs["storage_allocated_bytes"] =
+      std::make_shared<dmlc::any>(static_cast<size_t>(allocated_bytes));
+  g->attrs["storage_num_not_allocated"] =
+      std::make_shared<dmlc::any>(static_cast<size_t>(not_allocated));
+  return true;
+}
+
+void BindPlanCache::Save(uint64_t signature, const nnvm::Graph& g) const {
+  const std::string path = PlanPath(signature);
+  const std::string tmp = path + ".tmp";
+  std::unique_ptr<dmlc::Stream> strm(dmlc::Stream::Create(tmp.c_str(), "w", true));
+  if (strm == nullptr) {
+    LOG(INFO) << "BindPlanCache: cannot write to " << tmp
+              << ", memory plans will not be cached";
+    return;
+  }
+  strm->Write(kPlanMagic);
+  strm->Write(signature);
+  strm->Write(static_cast<uint64_t>(g.indexed_graph().num_node_entries()));
+  strm->Write(g.GetAttr<nnvm::StorageVector>("storage_id"));
+  strm->Write(g.GetAttr<std::vector<int> >("storage_inplace_index"));
+  strm->Write(static_cast<uint64_t>(g.GetAttr<size_t>("storage_allocated_bytes")));
+  strm->Write(static_cast<uint64_t>(g.GetAttr<size_t>("storage_num_not_allocated")));
+  strm.reset();
+  // publish atomically so a concurrent bind never sees a partial plan
+  std::rename(tmp.c_str(), path.c_str());
+}
+
+}  // namespace exec
+}  // namespace mxnet
@@ -0,0 +1,75 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file bind_plan_cache.h
+ * \brief on-disk cache of the memory plan computed while binding a graph
+ */
+#ifndef MXNET_EXECUTOR_BIND_PLAN_CACHE_H_
+#define MXNET_EXECUTOR_BIND_PLAN_CACHE_H_
+
+#include <nnvm/graph.h>
+#include <string>
+
+namespace mxnet {
+namespace exec {
+
+/*!
+ * \brief Persists the result of the MXPlanMemory pass so a warm process
+ *  restart can bind a known model without re-running the allocation search.
+ *  Plans are stored as one file per graph under the directory given by
+ *  MXNET_EXEC_BIND_CACHE, keyed by a signature over the graph structure,
+ *  the inferred shapes, dtypes and storage types, the device assignment and
+ *  the external-storage seeding, so a cached plan is only replayed into a
+ *  graph it was computed for. Disabled unless the directory is set.
+ */
+class BindPlanCache {
+ public:
+  /*! \brief singleton, reads MXNET_EXEC_BIND_CACHE once */
+  static BindPlanCache* Get();
+  /*! \brief whether a cache directory was configured */
+  bool enabled() const {
+    return !dir_.empty();
+  }
+  /*!
+   * \brief signature of a graph about to be memory planned; the graph must
+   *  already carry the shape, dtype, storage_type and storage attributes
+   */
+  static uint64_t GraphSignature(const nnvm::Graph& g);
+  /*!
+   * \brief inject a cached plan into the graph, returns false when no valid
+   *  plan of this signature is on disk
+   */
+  bool Load(uint64_t signature, nnvm::Graph* g) const;
+  /*! \brief write the plan attributes of a planned graph to disk */
+  void Save(uint64_t signature, const nnvm::Graph& g) const;
+
+ private:
+  BindPlanCache();
+  /*! \brief file holding the plan of one signature */
+  std::string PlanPath(uint64_t signature) const;
+  /*! \brief cache directory, empty when disabled */
+  std::string dir_;
+};
+
+}  // namespace exec
+}  // namespace mxnet
+
+#endif  // MXNET_EXECUTOR_BIND_PLAN_CACHE_H_
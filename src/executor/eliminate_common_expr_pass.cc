@@ -27,8 +27,10 @@
 #include <mxnet/base.h>
 #include <mxnet/op_attr_types.h>
 
+#include <algorithm>
 #include <vector>
 #include <map>
+#include <unordered_set>
 #include <utility>
 #include <sstream>
 
@@ -94,7 +96,13 @@ bool NodeEqual(const Node* n, const Node* m) {
 }
 
 // Graph traversal to create a list of pairs of identical-function nodes that can be combined.
-std::vector<std::pair<NodePtr, NodePtr> > GetCommonNodes(const Graph& g) {
+// When `fwd_nodes` is given, the graph is a combined forward + backward graph and the set
+// contains the nodes of its forward section. In that case forward nodes are never eliminated,
+// so the outputs of the forward section stay valid, and backward nodes are merged into
+// forward ones only when that keeps the forward section self-contained.
+std::vector<std::pair<NodePtr, NodePtr> > GetCommonNodes(
+    const Graph& g,
+    const std::unordered_set<const Node*>* fwd_nodes = nullptr) {
   std::vector<std::pair<NodePtr, NodePtr> > ret;
   // A map between a vector of inputs and those nodes that have those inputs
   std::map<std::vector<NodeInput>, std::vector<const NodePtr*> > grouped_nodes;
@@ -106,8 +114,15 @@ std::vector<std::pair<NodePtr, NodePtr> > GetCommonNodes(const Graph& g) {
   });
   // Now check for identical node ops within the node groups (having identical inputs)
   for (const auto& pair : grouped_nodes) {
-    auto &node_group = pair.second;  // Group of nodes that share the same vector of inputs
+    auto node_group = pair.second;  // Group of nodes that share the same vector of inputs
     if (node_group.size() > 1) {
+      if (fwd_nodes != nullptr) {
+        // Put forward nodes first so that they are always picked as the surviving 'src'.
+        std::stable_sort(node_group.begin(), node_group.end(),
+                         [fwd_nodes](const NodePtr* a, const NodePtr* b) {
+                           return fwd_nodes->count(a->get()) > fwd_nodes->count(b->get());
+                         });
+      }
       std::unordered_set<size_t> visited;
       for (size_t i = 0; i < node_group.size(); ++i) {
         if (visited.count(i)) continue;
@@ -115,9 +130,26 @@ std::vector<std::pair<NodePtr, NodePtr> > GetCommonNodes(const Graph& g) {
           // If the two Nodes have equal function, then one Node (called the 'replaced') can
           // be eliminated in favor of the other Node (the 'src').
           if (NodeEqual(node_group[i]->get(), node_group[j]->get())) {
-            visited.insert(j);
             NodePtr src = *node_group[i];
             NodePtr replaced = *node_group[j];
+            if (fwd_nodes != nullptr) {
+              // Never eliminate a node of the forward section.
+              if (fwd_nodes->count(replaced.get())) continue;
+              // Merging a backward node into a forward one adds the backward node's
+              // control dependencies to the forward node, so only allow it when all
+              // of those dependencies already live in the forward section.
+              if (fwd_nodes->count(src.get())) {
+                bool deps_in_fwd = true;
+                for (const auto& dep : replaced->control_deps) {
+                  if (!fwd_nodes->count(dep.get())) {
+                    deps_in_fwd = false;
+                    break;
+                  }
+                }
+                if (!deps_in_fwd) continue;
+              }
+            }
+            visited.insert(j);
             ret.emplace_back(src, replaced);
           }
         }
@@ -205,12 +237,29 @@ void EliminateCommonNodes(Graph* g,
 
 /*!
  * \brief Simplify a graph by iteratively eliminating Nodes with identical inputs and function.
+ *
+ * If the graph carries the `num_forward_outputs` attribute it is treated as a combined
+ * forward + backward graph: nodes of the forward section (everything reachable from the
+ * first `num_forward_outputs` outputs) are never eliminated, and backward nodes are
+ * deduplicated against them so the backward section reuses forward intermediates.
  */
 nnvm::Graph EliminateCommonExpr(nnvm::Graph&& g) {
   using nnvm::NodePtr;
+  const bool has_fwd_section = g.attrs.count("num_forward_outputs") != 0;
   bool keep_running = true;
   while (keep_running) {
-    const auto& common_nodes = GetCommonNodes(g);
+    // recompute the forward section every iteration, since elimination rewrites the graph
+    std::unordered_set<const Node*> fwd_nodes;
+    if (has_fwd_section) {
+      const auto& num_forward_outputs = g.GetAttr<size_t>("num_forward_outputs");
+      CHECK_LE(num_forward_outputs, g.outputs.size());
+      std::vector<nnvm::NodeEntry> fwd_outputs(g.outputs.begin(),
+                                               g.outputs.begin() + num_forward_outputs);
+      nnvm::DFSVisit(fwd_outputs, [&fwd_nodes](const NodePtr& n) {
+        fwd_nodes.insert(n.get());
+      });
+    }
+    const auto& common_nodes = GetCommonNodes(g, has_fwd_section ? &fwd_nodes : nullptr);
     if (common_nodes.empty()) {
       keep_running = false;
     } else {
@@ -34,6 +34,7 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <tuple>
 
@@ -194,6 +195,24 @@ void AttachOpResources(const Graph& g,
  */
 Graph DetectInplaceAddTo(Graph g);
 
+/*!
+ * \brief Map each row_sparse parameter to the graph input supplying the
+ *        indices of the ops that gather from it.
+ *
+ * A parameter qualifies when every consumer is a sparse-index op
+ * (Embedding, SparseEmbedding, take) whose index argument is itself a
+ * graph input, so a frontend can issue the kvstore row_sparse_pull as
+ * soon as that input is available and overlap the network fetch with
+ * upstream dense compute. Parameters consumed by any other op, or whose
+ * indices are produced by intermediate compute, are left out — their
+ * rows cannot be known before the graph runs.
+ *
+ * \param g input graph with the "storage_type" attribute inferred
+ *
+ * \return map from row_sparse parameter name to index input name
+ */
+std::unordered_map<std::string, std::string> GetRowSparsePullPlan(const Graph& g);
+
 /*!
  * \brief Eliminate common expressions in the graph.
  *
@@ -207,19 +226,49 @@ Graph EliminateCommonExpr(Graph && g);
  * \brief Fuse pointwise operations in the forward pass.
  *
  * \param g input graph (needs to be entire graph, not just forward part)
+ * \param for_gpu whether the fused regions run through the generated GPU
+ *                kernels or the interpreted CPU path, which supports a
+ *                smaller set of operators
  *
  * \return graph with fused pointwise operations in the forward pass
  */
-Graph FusePointwiseForward(Graph&& g);
+Graph FusePointwiseForward(Graph&& g, bool for_gpu);
 
 /*!
  * \brief Fuse pointwise operations in the backward pass.
  *
  * \param g input graph (needs to be entire graph, not just forward part)
+ * \param for_gpu whether the fused regions run through the generated GPU
+ *                kernels or the interpreted CPU path, which supports a
+ *                smaller set of operators
  *
  * \return graph with fused pointwise operations in the backward pass
  */
-Graph FusePointwiseBackward(Graph&& g);
+Graph FusePointwiseBackward(Graph&& g, bool for_gpu);
+
+/*!
+ * \brief Fold relu activations into preceding BatchNorm nodes by setting
+ *        the operator's fuse_relu parameter. Only valid on inference
+ *        graphs: no backward pass may read the pre-activation output.
+ *
+ * \param g input forward graph
+ *
+ * \return graph with BatchNorm+relu pairs collapsed into fused BatchNorm nodes
+ */
+Graph FuseBatchNormRelu(Graph&& g);
+
+/*!
+ * \brief Combine groups of per-tensor maintenance ops (all_finite,
+ *        reset_arrays) operating on independent tensors into single
+ *        multi-tensor nodes, so that N small launches become one.
+ *        Batched all_finite checks report a group verdict instead of
+ *        per-tensor results.
+ *
+ * \param g input graph
+ *
+ * \return graph with batchable maintenance ops merged
+ */
+Graph BatchMaintenanceOps(Graph&& g);
 
 /*!
  * \brief Infer shapes in the graph given the information.
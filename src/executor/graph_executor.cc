@@ -23,12 +23,22 @@
  * \brief graph executor
  */
 #include <mxnet/base.h>
+#include <mxnet/op_attr_types.h>
 #include <nnvm/graph.h>
 #include <nnvm/pass_functions.h>
 #include <vector>
 #include <set>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "./bind_plan_cache.h"
 #include "./exec_pass.h"
 #include "./graph_executor.h"
 #include "../profiler/profiler.h"
@@ -213,6 +223,10 @@ const std::unordered_map<std::string, NDArray>& GraphExecutor::aux_state_map() c
   return aux_state_map_;
 }
 
+const std::unordered_map<std::string, std::string>& GraphExecutor::row_sparse_pull_plan() const {
+  return row_sparse_pull_plan_;
+}
+
 static nnvm::NodeEntry AttrHint(nnvm::NodeEntry src, nnvm::NodeEntry like) {
   static const Op* id_like = Op::Get("_identity_with_attr_like_rhs");
   nnvm::NodePtr n = nnvm::Node::Create();
@@ -260,6 +274,39 @@ nnvm::NodeEntry AggregateGradient(std::vector<nnvm::NodeEntry>&& v) {
       sum_node->inputs = std::move(v);
       return nnvm::NodeEntry(std::move(sum_node), 0, 0);
     } else {
+      static const bool blocked_sum = dmlc::GetEnv("MXNET_EXEC_BLOCKED_GRAD_SUM", false);
+      if (blocked_sum) {
+        // fused accumulation: sum chunks of inplace_sum_cap contributions
+        // with one ElementWiseSum kernel each and fold only the chunk
+        // results with the in-place chain below. This cuts the kernel count
+        // and the reads of the accumulation buffer from one per
+        // contribution to one per chunk, while at most inplace_sum_cap
+        // contributions are alive at a time, the same bound the single
+        // ElementWiseSum branch above already accepts.
+        std::vector<nnvm::NodeEntry> chunks;
+        chunks.reserve((v.size() + inplace_sum_cap - 1) / inplace_sum_cap);
+        for (size_t first = 0; first < v.size(); first += inplace_sum_cap) {
+          const size_t last = std::min(first + inplace_sum_cap, v.size());
+          if (last - first == 1) {
+            chunks.push_back(v[first]);
+            continue;
+          }
+          std::ostringstream os;
+          os << "sum_grad_blk_" << chunks.size();
+          nnvm::NodePtr sum_node = nnvm::Node::Create();
+          sum_node->attrs.op = ewise_sum_op;
+          sum_node->attrs.name = os.str();
+          sum_node->attrs.dict["num_args"] = std::to_string(last - first);
+          sum_node->attrs.op->attr_parser(&(sum_node->attrs));
+          sum_node->inputs.assign(v.begin() + first, v.begin() + last);
+          chunks.emplace_back(std::move(sum_node), 0, 0);
+        }
+        // every entry of a chunk comes later in backward order than every
+        // entry of the previous chunks, so ordering the chunk results with
+        // the control dependencies below keeps the invariant of the chain
+        v = std::move(chunks);
+        if (v.size() == 1) return std::move(v[0]);
+      }
       // use a stream line of plus instead
       nnvm::NodeEntry ret = v[0];
       for (size_t i = 1; i < v.size(); ++i) {
@@ -317,6 +364,50 @@ inline ValueType get_node_attr(
   }
 }
 
+// whether a node is cheap enough to recompute during backward
+// instead of keeping its output alive from the forward pass
+static bool MirrorableNode(const nnvm::Node& node) {
+  if (node.is_variable()) return false;
+  const std::string& type = node.attrs.op->name;
+  // Dropout is not deterministic, recomputing it would change the result
+  if (type == "Dropout") return false;
+  if (get_node_attr(node, "__force_mirroring__", false)) return true;
+  if (type == "Convolution") return false;
+  if (type == "FullyConnected") return false;
+  if (type == "Concat") return false;
+  if (type == "SoftmaxOutput") return false;
+  if (type == "BatchNorm") return false;
+  if (type == "CuDNNBatchNorm") return false;
+  return true;
+}
+
+std::unordered_set<const nnvm::Node*> SelectMirrorNodes(
+    const std::vector<nnvm::NodeEntry>& outputs, uint32_t max_depth) {
+  std::unordered_set<const nnvm::Node*> mirrored;
+  // length of the recompute chain ending at each node;
+  // stored activations (checkpoints) and variables count as zero
+  std::unordered_map<const nnvm::Node*, uint32_t> chain_depth;
+  nnvm::DFSVisit(outputs, [&](const nnvm::NodePtr& n) {
+    if (!MirrorableNode(*n)) {
+      chain_depth[n.get()] = 0;
+      return;
+    }
+    uint32_t depth = 0;
+    for (const auto& e : n->inputs) {
+      depth = std::max(depth, chain_depth[e.node.get()]);
+    }
+    ++depth;
+    if (depth > max_depth && !get_node_attr(*n, "__force_mirroring__", false)) {
+      // the chain is long enough, store this output as a checkpoint
+      chain_depth[n.get()] = 0;
+      return;
+    }
+    chain_depth[n.get()] = depth;
+    mirrored.insert(n.get());
+  });
+  return mirrored;
+}
+
 /*!
  * \brief Create the graph for backward pass.
  * This is triggered by both simple_bind and bind flows.
@@ -354,19 +445,18 @@ nnvm::Graph GraphExecutor::InitFullGraph(nnvm::Symbol symbol,
   }
 
   int do_mirror = dmlc::GetEnv("MXNET_BACKWARD_DO_MIRROR", 0);
-  auto need_mirror = [do_mirror](const nnvm::Node& node) -> int {
+  uint32_t mirror_depth = dmlc::GetEnv("MXNET_BACKWARD_MIRROR_DEPTH", 0);
+  std::unordered_set<const nnvm::Node*> mirrored;
+  if (do_mirror == 0 && mirror_depth > 0) {
+    mirrored = SelectMirrorNodes(symbol.outputs, mirror_depth);
+  }
+  auto need_mirror = [do_mirror, mirrored](const nnvm::Node& node) -> int {
     if (node.is_variable()) return 0;
-    const std::string& type = node.attrs.op->name;
-    if (type == "Dropout") return false;
+    if (node.attrs.op->name == "Dropout") return false;
     if (get_node_attr(node, "__force_mirroring__", false)) return true;
-    if (do_mirror == 0) return false;
-    if (type == "Convolution") return false;
-    if (type == "FullyConnected") return false;
-    if (type == "Concat") return false;
-    if (type == "SoftmaxOutput") return false;
-    if (type == "BatchNorm") return false;
-    if (type == "CuDNNBatchNorm") return false;
-    return true;
+    // selective recomputation bounded by MXNET_BACKWARD_MIRROR_DEPTH
+    if (do_mirror == 0) return mirrored.count(&node) > 0;
+    return MirrorableNode(node);
   };
 
   std::vector<const nnvm::Op*> zero_ops;
@@ -386,6 +476,157 @@ nnvm::Graph GraphExecutor::InitFullGraph(nnvm::Symbol symbol,
   return g;
 }
 
+// whether an op node may be evaluated once at bind time and replaced by its
+// result; mirrors the safety checks of the common-expression elimination pass
+static bool FoldableOp(const nnvm::Node* n) {
+  static auto& fmutate_inputs = Op::GetAttr<nnvm::FMutateInputs>("FMutateInputs");
+  static auto& fstateful = Op::GetAttr<FCreateOpState>("FCreateOpState");
+  static auto& deterministic_output =
+      Op::GetAttr<THasDeterministicOutput>("THasDeterministicOutput");
+  static auto& resource_request = Op::GetAttr<FResourceRequest>("FResourceRequest");
+  static auto& resource_request_ex = Op::GetAttr<FResourceRequestEx>("FResourceRequestEx");
+  if (n->is_variable()) return false;
+  if (fmutate_inputs.get(n->op(), nullptr) != nullptr) return false;
+  if (fstateful.get(n->op(), nullptr) != nullptr) return false;
+  if (deterministic_output.contains(n->op())) return deterministic_output[n->op()];
+  if (resource_request.get(n->op(), nullptr) != nullptr) return false;
+  if (resource_request_ex.get(n->op(), nullptr) != nullptr) return false;
+  return true;
+}
+
+/*!
+ * \brief Fold subgraphs that only depend on constants at bind time.
+ *
+ * A node is foldable when its op is a pure stateless function and every input
+ * is either another foldable node or a variable that is marked constant with
+ * the __const__ attribute and does not require gradient. Zero-input operators
+ * such as shape constants and arange are always candidates. Each foldable
+ * entry consumed by a non-foldable node is evaluated once imperatively and
+ * replaced by a new variable holding the materialized result, which prunes
+ * the subtree from the graph; the argument lists are rebuilt to match.
+ * \return whether anything was folded.
+ */
+static bool FoldConstantSubgraphs(const nnvm::Symbol& src,
+                                  const Context& default_ctx,
+                                  const std::vector<NDArray>& in_args,
+                                  const std::vector<NDArray>& arg_grad_store,
+                                  const std::vector<OpReqType>& grad_req_types,
+                                  nnvm::Symbol* folded_symbol,
+                                  std::vector<NDArray>* folded_args,
+                                  std::vector<NDArray>* folded_arg_grads,
+                                  std::vector<OpReqType>* folded_grad_reqs) {
+  using nnvm::NodePtr;
+  // copy the graph so that the caller's symbol is not rewritten
+  nnvm::Symbol symbol = src.Copy();
+  const std::vector<NodePtr> args = symbol.ListInputs(nnvm::Symbol::kReadOnlyArgs);
+  CHECK_EQ(args.size(), in_args.size());
+  std::unordered_map<const nnvm::Node*, size_t> arg_index;
+  for (size_t i = 0; i < args.size(); ++i) arg_index[args[i].get()] = i;
+
+  auto is_const_var = [&](const nnvm::Node* n) {
+    auto it = arg_index.find(n);
+    if (it == arg_index.end()) return false;
+    return grad_req_types[it->second] == kNullOp &&
+           get_node_attr(*n, "__const__", false);
+  };
+
+  // nodes whose transitive inputs are all constant
+  std::unordered_set<const nnvm::Node*> foldable;
+  nnvm::DFSVisit(symbol.outputs, [&](const NodePtr& n) {
+    if (!FoldableOp(n.get())) return;
+    for (const auto& e : n->inputs) {
+      if (e.node->is_variable() ? !is_const_var(e.node.get())
+                                : foldable.count(e.node.get()) == 0) {
+        return;
+      }
+    }
+    foldable.insert(n.get());
+  });
+  if (foldable.empty()) return false;
+
+  // evaluate foldable nodes on demand, memoized per node
+  std::unordered_map<const nnvm::Node*, std::vector<NDArray> > values;
+  std::function<void(const NodePtr&)> evaluate = [&](const NodePtr& n) {
+    if (values.count(n.get())) return;
+    for (const auto& e : n->inputs) {
+      if (!e.node->is_variable()) evaluate(e.node);
+    }
+    std::vector<NDArray> input_bufs;
+    input_bufs.reserve(n->inputs.size());
+    for (const auto& e : n->inputs) {
+      if (e.node->is_variable()) {
+        input_bufs.push_back(in_args[arg_index.at(e.node.get())]);
+      } else {
+        input_bufs.push_back(values.at(e.node.get())[e.index]);
+      }
+    }
+    std::vector<NDArray*> inputs, outputs;
+    for (auto& nd : input_bufs) inputs.push_back(&nd);
+    std::vector<NDArray>& outs = values[n.get()];
+    outs.resize(n->num_outputs());
+    for (auto& nd : outs) outputs.push_back(&nd);
+    Imperative::Get()->Invoke(default_ctx, n->attrs, inputs, outputs);
+  };
+
+  // collect the consumers first, then rewrite, so that the traversal
+  // does not run over a graph that is being modified
+  std::vector<NodePtr> consumers;
+  nnvm::DFSVisit(symbol.outputs, [&](const NodePtr& n) {
+    if (foldable.count(n.get())) return;
+    for (const auto& e : n->inputs) {
+      if (!e.node->is_variable() && foldable.count(e.node.get())) {
+        consumers.push_back(n);
+        return;
+      }
+    }
+  });
+
+  bool folded = false;
+  std::unordered_map<const nnvm::Node*, std::vector<NodePtr> > const_vars;
+  std::unordered_map<const nnvm::Node*, NDArray> const_values;
+  for (const NodePtr& n : consumers) {
+    for (auto& e : n->inputs) {
+      if (e.node->is_variable() || foldable.count(e.node.get()) == 0) continue;
+      auto& vars = const_vars[e.node.get()];
+      if (vars.empty()) vars.resize(e.node->num_outputs());
+      NodePtr& var = vars[e.index];
+      if (var == nullptr) {
+        var = nnvm::Node::Create();
+        var->attrs.name = e.node->attrs.name + "_fold" + std::to_string(e.index);
+        evaluate(e.node);
+        const_values[var.get()] = values.at(e.node.get())[e.index];
+      }
+      e.node = var;
+      e.index = 0;
+      e.version = 0;
+      folded = true;
+    }
+  }
+  if (!folded) return false;
+
+  // rebuild the argument lists to match the input order of the rewritten graph
+  *folded_symbol = std::move(symbol);
+  const std::vector<NodePtr> new_args =
+      folded_symbol->ListInputs(nnvm::Symbol::kReadOnlyArgs);
+  folded_args->reserve(new_args.size());
+  folded_arg_grads->reserve(new_args.size());
+  folded_grad_reqs->reserve(new_args.size());
+  for (const NodePtr& arg : new_args) {
+    auto cit = const_values.find(arg.get());
+    if (cit != const_values.end()) {
+      folded_args->push_back(cit->second);
+      folded_arg_grads->push_back(NDArray());
+      folded_grad_reqs->push_back(kNullOp);
+    } else {
+      const size_t i = arg_index.at(arg.get());
+      folded_args->push_back(in_args[i]);
+      folded_arg_grads->push_back(arg_grad_store[i]);
+      folded_grad_reqs->push_back(grad_req_types[i]);
+    }
+  }
+  return true;
+}
+
 /*!
  * \brief GraphExecutor initializer for regular bind flow in which
  * input arguments and gradients are provided by users. This initializer
@@ -400,6 +641,22 @@ void GraphExecutor::Init(nnvm::Symbol symbol,
                          const std::vector<NDArray>& aux_states,
                          Executor* shared_exec,
                          const nnvm::NodeEntryMap<NDArray>& feed_dict) {
+  // fold constant subgraphs once and bind the rewritten graph instead;
+  // feed_dict keys reference nodes of the original symbol, so skip when set
+  static const bool const_fold = dmlc::GetEnv("MXNET_EXEC_CONST_FOLD", false);
+  if (const_fold && feed_dict.size() == 0U) {
+    nnvm::Symbol folded_symbol;
+    std::vector<NDArray> folded_args, folded_arg_grads;
+    std::vector<OpReqType> folded_reqs;
+    if (FoldConstantSubgraphs(symbol, default_ctx, in_args, arg_grad_store,
+                              grad_req_types, &folded_symbol, &folded_args,
+                              &folded_arg_grads, &folded_reqs)) {
+      this->Init(std::move(folded_symbol), default_ctx, ctx_map, folded_args,
+                 folded_arg_grads, folded_reqs, aux_states, shared_exec,
+                 feed_dict);
+      return;
+    }
+  }
   // create in_arg_ctxes, arg_grad_ctxes, aux_state_ctxes
   auto get_ctx1 = [](const NDArray& nd) { return nd.ctx(); };
   auto get_ctx2 = [default_ctx](const NDArray& nd) -> Context {
@@ -415,7 +672,25 @@ void GraphExecutor::Init(nnvm::Symbol symbol,
 
   nnvm::Graph g = InitGraph(symbol, default_ctx, ctx_map, in_arg_ctxes,
                             arg_grad_ctxes, aux_state_ctxes, grad_req_types);
+  InitBindings(symbol, std::move(g), in_args, arg_grad_store, grad_req_types,
+               aux_states, shared_exec, feed_dict);
+}
 
+/*!
+ * \brief Shared tail of the regular bind flow: populate the input data
+ * entries and gradient stores from the user-provided arrays, run shape,
+ * dtype and storage inference against them, and finish graph
+ * initialization. Also used by the incremental reshape path, which arrives
+ * here with a reused graph instead of a freshly transformed one.
+ */
+void GraphExecutor::InitBindings(const nnvm::Symbol& symbol,
+                                 nnvm::Graph&& g,
+                                 const std::vector<NDArray>& in_args,
+                                 const std::vector<NDArray>& arg_grad_store,
+                                 const std::vector<OpReqType>& grad_req_types,
+                                 const std::vector<NDArray>& aux_states,
+                                 Executor* shared_exec,
+                                 const nnvm::NodeEntryMap<NDArray>& feed_dict) {
   // create arg_shapes and arg_dtypes for shape and type inferences
   const auto& idx = g.indexed_graph();
   const auto& mutable_nodes = idx.mutable_input_nodes();
@@ -489,6 +764,38 @@ void GraphExecutor::Init(nnvm::Symbol symbol,
   FinishInitGraph(symbol, g, shared_exec, feed_dict);
 }
 
+/*!
+ * \brief Incremental initializer for Reshape. The source executor's fully
+ * transformed graph is reused as is: gradient construction, common
+ * expression elimination, fusion, context assignment and node priorities
+ * are all shape-invariant, so only the shape-dependent stages (shape,
+ * dtype and storage inference, memory planning, op setup) run against the
+ * new shapes.
+ */
+void GraphExecutor::InitReshape(GraphExecutor* src,
+                                const nnvm::Symbol& symbol,
+                                const std::vector<NDArray>& in_args,
+                                const std::vector<NDArray>& arg_grad_store,
+                                const std::vector<OpReqType>& grad_req_types,
+                                const std::vector<NDArray>& aux_states) {
+  nnvm::Graph g;
+  g.outputs = src->graph_.outputs;
+  for (const char* attr : {"context", "device"}) {
+    auto it = src->graph_.attrs.find(attr);
+    if (it != src->graph_.attrs.end()) {
+      g.attrs[attr] = it->second;
+    }
+  }
+  num_forward_inputs_ = src->num_forward_inputs_;
+  num_forward_outputs_ = src->num_forward_outputs_;
+  num_forward_nodes_ = src->num_forward_nodes_;
+  need_grad_ = src->need_grad_;
+  head_grad_entry_ = src->head_grad_entry_;
+  head_grad_map_ = src->head_grad_map_;
+  InitBindings(symbol, std::move(g), in_args, arg_grad_store, grad_req_types,
+               aux_states, src, nnvm::NodeEntryMap<NDArray>());
+}
+
 /*!
  * \brief Initialize in_args, arg_grads, and aux_states
  * and their data_entry_ of the executor. This function
@@ -710,6 +1017,10 @@ void GraphExecutor::FinishInitGraph(nnvm::Symbol symbol,
   const auto& idx = g.indexed_graph();
   const auto& vstorage_type = g.GetAttr<StorageTypeVector>("storage_type");
 
+  // record which row_sparse parameters a frontend can pull from a kvstore
+  // before running the graph, keyed by the input that carries their row ids
+  row_sparse_pull_plan_ = GetRowSparsePullPlan(g);
+
   // data entries for output gradients
   for (size_t j = num_forward_outputs_; j < idx.outputs().size(); ++j) {
     data_entry_[idx.entry_id(idx.outputs()[j])] = grad_store_[j - num_forward_outputs_].second;
@@ -730,7 +1041,18 @@ void GraphExecutor::FinishInitGraph(nnvm::Symbol symbol,
       if (vstorage_type[i] != kDefaultStorage) arg_storage_id[i] = kDynamicStorageID;
     }
     g.attrs["storage"] = std::make_shared<dmlc::any>(std::move(arg_storage_id));
-    g = nnvm::ApplyPass(g, "MXPlanMemory");
+    // a warm restart replays the memory plan of a previous bind of the same
+    // graph instead of re-running the allocation search
+    BindPlanCache* plan_cache = BindPlanCache::Get();
+    if (plan_cache->enabled()) {
+      const uint64_t plan_sig = BindPlanCache::GraphSignature(g);
+      if (!plan_cache->Load(plan_sig, &g)) {
+        g = nnvm::ApplyPass(g, "MXPlanMemory");
+        plan_cache->Save(plan_sig, g);
+      }
+    } else {
+      g = nnvm::ApplyPass(g, "MXPlanMemory");
+    }
   }
   g = DetectInplaceAddTo(g);
 
@@ -767,6 +1089,40 @@ void GraphExecutor::FinishInitGraph(nnvm::Symbol symbol,
   }
   this->InitCachedOps();
   this->InitOpSegs();
+  static bool prefetch_param_pages = dmlc::GetEnv("MXNET_PREFETCH_PARAM_PAGES", false);
+  if (prefetch_param_pages) {
+    this->PrefetchParameterPages();
+  }
+}
+
+void GraphExecutor::PrefetchParameterPages() {
+#if defined(__linux__)
+  const auto& idx = graph_.indexed_graph();
+  const uintptr_t page_mask = ~(static_cast<uintptr_t>(sysconf(_SC_PAGESIZE)) - 1);
+  std::vector<bool> prefetched(idx.num_node_entries(), false);
+  // walk the nodes in topological order and advise each parameter's pages
+  // when its first consumer is reached, so the kernel's asynchronous
+  // page-in follows the same order in which the first forward will fault
+  for (size_t nid = 0; nid < idx.num_nodes(); ++nid) {
+    const auto& inode = idx[nid];
+    if (inode.source->is_variable()) continue;
+    for (const auto& e : inode.inputs) {
+      if (!idx[e.node_id].source->is_variable()) continue;
+      const uint32_t eid = idx.entry_id(e);
+      if (prefetched[eid]) continue;
+      prefetched[eid] = true;
+      const NDArray& nd = data_entry_[eid];
+      if (nd.is_none() || nd.storage_type() != kDefaultStorage ||
+          nd.ctx().dev_mask() != cpu::kDevMask) {
+        continue;
+      }
+      const uintptr_t dptr = reinterpret_cast<uintptr_t>(nd.data().dptr_);
+      const uintptr_t begin = dptr & page_mask;
+      const size_t nbytes = nd.shape().Size() * mshadow::mshadow_sizeof(nd.dtype());
+      madvise(reinterpret_cast<void*>(begin), dptr + nbytes - begin, MADV_WILLNEED);
+    }
+  }
+#endif  // defined(__linux__)
 }
 
 /*!
@@ -978,9 +1334,17 @@ Executor* GraphExecutor::Reshape(const bool partial_shaping,
     }
   }
   auto exec = new GraphExecutor();
-  exec->Init(symbol, default_ctx, ctx_map,
-             *in_args, *arg_grads, grad_req_types, *aux_states,
-             this);
+  // the symbol is unchanged by a reshape, so by default the new executor
+  // reuses this executor's transformed graph and reruns only the
+  // shape-dependent initialization stages
+  static const bool incremental = dmlc::GetEnv("MXNET_INCREMENTAL_RESHAPE", true);
+  if (incremental) {
+    exec->InitReshape(this, symbol, *in_args, *arg_grads, grad_req_types, *aux_states);
+  } else {
+    exec->Init(symbol, default_ctx, ctx_map,
+               *in_args, *arg_grads, grad_req_types, *aux_states,
+               this);
+  }
   return exec;
 }
 
@@ -1001,16 +1365,35 @@ Graph GraphExecutor::InitGraph(nnvm::Symbol symbol,
   // setup gradient
   nnvm::Graph g = InitFullGraph(symbol, grad_req_types);
 
-#if MXNET_USE_CUDA && !defined(_WIN32)
-  if (default_ctx.dev_mask() == Context::kGPU && dmlc::GetEnv("MXNET_USE_FUSION", true)) {
+  // Clamping inside BatchNorm is only valid when no backward pass will read
+  // the pre-activation output, so the rewrite is restricted to inference binds
+  if (!need_grad_ && dmlc::GetEnv("MXNET_FUSE_BN_RELU", false)) {
+    g = FuseBatchNormRelu(std::move(g));
+  }
+
+  // Batching all_finite checks coarsens their results to one verdict for the
+  // whole group, so the rewrite is opt-in
+  if (dmlc::GetEnv("MXNET_BATCH_MAINTENANCE_OPS", false)) {
+    g = BatchMaintenanceOps(std::move(g));
+  }
+
+#if !defined(_WIN32)
+  const bool fuse_for_gpu = default_ctx.dev_mask() == Context::kGPU;
+  // GPU fusion needs the runtime compiler; the interpreted CPU path is
+  // opt-in since it only pays off on elementwise-heavy graphs, so its
+  // default follows the profiler-derived tuning hint when one is present
+  const bool use_fusion = fuse_for_gpu ?
+      (MXNET_USE_CUDA && dmlc::GetEnv("MXNET_USE_FUSION", true)) :
+      dmlc::GetEnv("MXNET_USE_FUSION_CPU", common::TuningHint("fuse_pointwise", 0) != 0);
+  if (use_fusion) {
     nnvm::Graph unoptimized_graph;
     common::CopyGraph(&unoptimized_graph, g, false);
 
     if (common::CheckForInputNameDuplicates(unoptimized_graph.indexed_graph())) {
       g.attrs["num_forward_outputs"] = std::make_shared<nnvm::any>(num_forward_outputs_);
-      g = FusePointwiseForward(std::move(g));
+      g = FusePointwiseForward(std::move(g), fuse_for_gpu);
       g.attrs["num_forward_outputs"] = std::make_shared<nnvm::any>(num_forward_outputs_);
-      g = FusePointwiseBackward(std::move(g));
+      g = FusePointwiseBackward(std::move(g), fuse_for_gpu);
       // Check the topological order of inputs
       const auto &original_inputs = unoptimized_graph.indexed_graph().input_nodes();
       const auto &new_inputs = g.indexed_graph().input_nodes();
@@ -1034,7 +1417,7 @@ Graph GraphExecutor::InitGraph(nnvm::Symbol symbol,
         << "Graph contains duplicate names for some of its inputs - fusion is NOT enabled!";
      }
   }
-#endif  // MXNET_USE_CUDA
+#endif  // !defined(_WIN32)
 
   // create "device" and "context" attrs for the graph
   g = AssignContext(g, default_ctx, ctx_map,
@@ -1224,6 +1607,13 @@ void GraphExecutor::InitCachedOps() {
   const auto& vctx = graph_.GetAttr<ContextVector>("context");
   const auto& addto_entry = graph_.GetAttr<std::vector<int> >("addto_entry");
   const auto& skip_plus_node = graph_.GetAttr<std::vector<int> >("skip_plus_node");
+  // when MXNET_PROFILE_NODE_NAMES is set, engine operators are named after the
+  // graph node and its output shapes instead of the bare op type, so the
+  // NVTX/VTune ranges emitted by the profiler map 1:1 to graph nodes
+  static const bool profile_node_names =
+      dmlc::GetEnv("MXNET_PROFILE_NODE_NAMES", false);
+  const mxnet::ShapeVector* node_shapes = graph_.attrs.count("shape") ?
+      &graph_.GetAttr<mxnet::ShapeVector>("shape") : nullptr;
 
   op_nodes_.resize(idx.num_nodes());
   // setup the array and requirements.
@@ -1231,6 +1621,17 @@ void GraphExecutor::InitCachedOps() {
     const auto& inode = idx[nid];
     if (inode.source->is_variable()) continue;
     op_nodes_[nid].opr_name = inode.source->op()->name.c_str();
+    if (profile_node_names && !inode.source->attrs.name.empty()) {
+      std::ostringstream name_os;
+      name_os << inode.source->op()->name << "::" << inode.source->attrs.name;
+      if (node_shapes != nullptr) {
+        name_os << " ";
+        for (uint32_t index = 0; index < inode.source->num_outputs(); ++index) {
+          name_os << (*node_shapes)[idx.entry_id(nid, index)];
+        }
+      }
+      op_nodes_[nid].opr_name = node_opr_names_.insert(name_os.str()).first->c_str();
+    }
     if (skip_plus_node.at(nid)) {
       op_nodes_[nid].skip_exec_node = true; continue;
     }
@@ -1328,8 +1729,30 @@ void GraphExecutor::InitCachedOps() {
   }
 }
 
+void GraphExecutor::InitNodePriorities() {
+  node_priority_.clear();
+  static const bool critical_path_priority =
+      dmlc::GetEnv("MXNET_EXEC_CRITICAL_PATH_PRIORITY", false);
+  if (!critical_path_priority) return;
+  // Longest path (in operators) from each node to a graph output. Pushing ops
+  // on the critical path with higher priority lets priority-aware engine
+  // queues dequeue them first, so independent branches can fill the remaining
+  // GPU worker streams instead of queueing behind the critical path.
+  const auto& idx = graph_.indexed_graph();
+  node_priority_.assign(idx.num_nodes(), 0);
+  for (size_t nid = idx.num_nodes(); nid-- > 0;) {
+    const auto& inode = idx[nid];
+    if (inode.source->is_variable()) continue;
+    for (const auto& e : inode.inputs) {
+      node_priority_[e.node_id] = std::max(node_priority_[e.node_id],
+                                           node_priority_[nid] + 1);
+    }
+  }
+}
+
 void GraphExecutor::InitOpSegs() {
   size_t total_num_nodes = graph_.indexed_graph().num_nodes();
+  this->InitNodePriorities();
   cached_seg_opr_.clear();
   CachedSegOpr p;
   cached_seg_opr_.resize(total_num_nodes, p);
@@ -1349,10 +1772,13 @@ void GraphExecutor::InitOpSegs() {
   bool is_training = num_forward_nodes_ != total_num_nodes;
 
   if (prefer_bulk_exec_train && is_training) {
+    // Bulk segment max sizes default from profiler-derived tuning hints when present
+    const int hinted_bulk = common::TuningHint("bulk_size", 15);
     // Bulk the forward portion of the graph per the bulk segment max size for forward training
-    this->BulkOpSegs(0, num_forward_nodes_, Imperative::BulkExecMaxNodeTrainFwd());
+    this->BulkOpSegs(0, num_forward_nodes_, Imperative::BulkExecMaxNodeTrainFwd(hinted_bulk));
     // Bulk the backward portion of the graph per the bulk segment max size for backward training
-    this->BulkOpSegs(num_forward_nodes_, total_num_nodes, Imperative::BulkExecMaxNodeTrainBwd());
+    this->BulkOpSegs(num_forward_nodes_, total_num_nodes,
+                     Imperative::BulkExecMaxNodeTrainBwd(hinted_bulk));
   }
 
   if (prefer_bulk_exec_inference && !is_training) {
@@ -1445,7 +1871,13 @@ void GraphExecutor::RunOps(bool is_train, size_t topo_start, size_t topo_end) {
     // Check segments first
     if (monitor_callback_ == nullptr && seg_op.opr != nullptr && seg_op.topo_end <= topo_end) {
       bool profiling = profiler::Profiler::Get()->GetState() == profiler::Profiler::kRunning;
-      Engine::Get()->Push(seg_op.opr, seg_op.ctx, 0, profiling);
+      int priority = 0;
+      if (!node_priority_.empty()) {
+        for (size_t i = nid; i < seg_op.topo_end; ++i) {
+          priority = std::max(priority, node_priority_[i]);
+        }
+      }
+      Engine::Get()->Push(seg_op.opr, seg_op.ctx, priority, profiling);
       nid = seg_op.topo_end - 1;
       continue;
     }
@@ -1535,7 +1967,8 @@ void GraphExecutor::RunOps(bool is_train, size_t topo_start, size_t topo_end) {
       opnode.exec->Run(opnode.exec->op_ctx.run_ctx, false);
     } else if (opnode.cached_opr != nullptr) {
       bool profiling = profiler::Profiler::Get()->GetState() == profiler::Profiler::kRunning;
-      Engine::Get()->Push(opnode.cached_opr, opnode.ctx, 0, profiling);
+      const int priority = node_priority_.empty() ? 0 : node_priority_[nid];
+      Engine::Get()->Push(opnode.cached_opr, opnode.ctx, priority, profiling);
       if (this->is_dynamic_) {
         for (NDArray &array : opnode.exec->out_array) {
           array.WaitToRead();
@@ -1579,6 +2012,10 @@ GraphExecutor::CachedSegOpr GraphExecutor::CreateCachedSegOpr(size_t topo_start,
   if (topo_end <= topo_start) {
     return ret;
   }
+  // node names instead of op types under MXNET_PROFILE_NODE_NAMES, so bulked
+  // segments in a profiler timeline can still be traced back to graph nodes
+  static const bool profile_node_names =
+      dmlc::GetEnv("MXNET_PROFILE_NODE_NAMES", false);
   std::string opr_names = "[";
 
   const auto& idx = graph_.indexed_graph();
@@ -1601,7 +2038,8 @@ GraphExecutor::CachedSegOpr GraphExecutor::CreateCachedSegOpr(size_t topo_start,
     std::copy(op_node.use_vars.begin(), op_node.use_vars.end(),
               std::inserter(use_vars, use_vars.end()));
     ret.exec_list.push_back(exec);
-    opr_names += inode.source->op()->name + ",";
+    opr_names += (profile_node_names && !inode.source->attrs.name.empty() ?
+                  inode.source->attrs.name : inode.source->op()->name) + ",";
   }
 
   if (pctx == nullptr) return ret;
@@ -53,6 +53,20 @@ using nnvm::Graph;
 
 nnvm::NodeEntry AggregateGradient(std::vector<nnvm::NodeEntry>&& v);
 
+/*!
+ * \brief Select forward nodes to recompute (mirror) during the backward pass
+ *  instead of keeping their outputs alive from forward.
+ *
+ *  Only operators that are cheap to recompute are considered, and every chain
+ *  of recomputed operators between two stored activations is limited to
+ *  max_depth nodes, which bounds the recompute cost per backward node.
+ * \param outputs outputs of the forward graph.
+ * \param max_depth maximum length of a recompute chain.
+ * \return the set of nodes to be mirrored.
+ */
+std::unordered_set<const nnvm::Node*> SelectMirrorNodes(
+    const std::vector<nnvm::NodeEntry>& outputs, uint32_t max_depth);
+
 // graph executors
 class GraphExecutor : public Executor {
  public:
@@ -67,6 +81,7 @@ class GraphExecutor : public Executor {
   const std::unordered_map<std::string, NDArray>& in_arg_map() const override;
   const std::unordered_map<std::string, NDArray>& arg_grad_map() const override;
   const std::unordered_map<std::string, NDArray>& aux_state_map() const override;
+  const std::unordered_map<std::string, std::string>& row_sparse_pull_plan() const override;
   void Print(std::ostream &os) const override; // NOLINT(*)
   nnvm::Symbol GetOptimizedSymbol();
   void SetMonitorCallback(const MonitorCallback& callback, bool monitor_all = false) override;
@@ -181,6 +196,24 @@ class GraphExecutor : public Executor {
                              std::vector<NDArray>* arg_grad_vec,
                              std::vector<NDArray>* aux_state_vec);
 
+  // shared tail of the regular bind flow: populate input data entries and
+  // gradient stores, run shape/dtype/storage inference and finish the graph
+  void InitBindings(const nnvm::Symbol& symbol,
+                    nnvm::Graph&& g,
+                    const std::vector<NDArray>& in_args,
+                    const std::vector<NDArray>& arg_grad_store,
+                    const std::vector<OpReqType>& grad_req_types,
+                    const std::vector<NDArray>& aux_states,
+                    Executor* shared_exec,
+                    const nnvm::NodeEntryMap<NDArray>& feed_dict);
+  // incremental initializer for Reshape: reuse the source executor's
+  // transformed graph and rerun only the shape-dependent stages
+  void InitReshape(GraphExecutor* src,
+                   const nnvm::Symbol& symbol,
+                   const std::vector<NDArray>& in_args,
+                   const std::vector<NDArray>& arg_grad_store,
+                   const std::vector<OpReqType>& grad_req_types,
+                   const std::vector<NDArray>& aux_states);
   // internal initialization of the graph for simple bind
   Graph InitGraph(nnvm::Symbol symbol,
                   const Context& default_ctx,
@@ -216,6 +249,11 @@ class GraphExecutor : public Executor {
   void ExecuteMonOutputCallback(size_t nid);
   // peform bulking and segmentation on the region [from_node, up_to_node) of a graph
   void BulkOpSegs(size_t from_node, size_t up_to_node, size_t segment_num_nodes_max);
+  // compute per-node engine priorities from a critical-path analysis of the graph
+  void InitNodePriorities();
+  // ask the kernel to fault in cold parameter pages in execution order,
+  // overlapping the page-in I/O with early-layer compute on the first forward
+  void PrefetchParameterPages();
   // When infer shape fails, fall back to ensure dynamic-shaped operators executed correctly.
   bool is_dynamic_;
   // indicate whether there is a backward graph for gradients.
@@ -237,6 +275,8 @@ class GraphExecutor : public Executor {
   std::unordered_map<std::string, NDArray> arg_grad_map_;
   // aux state map, key is aux state name, value is aux state NDArray
   std::unordered_map<std::string, NDArray> aux_state_map_;
+  // row_sparse parameter name -> index input name, for kvstore prefetch
+  std::unordered_map<std::string, std::string> row_sparse_pull_plan_;
   // gradient store
   std::vector<std::pair<OpReqType, NDArray> > grad_store_;
   // array to hold head gradient.
@@ -257,10 +297,17 @@ class GraphExecutor : public Executor {
   bool monitor_all_{false};
   // whether to enable bulk execution
   bool prefer_bulk_execution_;
+  // per-node engine priority (length of the longest path to a graph output),
+  // empty unless critical-path scheduling is enabled
+  std::vector<int> node_priority_;
   // cached segment operator
   std::vector<CachedSegOpr> cached_seg_opr_;
   // cached segment operator name (needs a longer lifecycle than cached_seg_opr_)
   std::unordered_set<std::string> cached_seg_opr_names_;
+  // per-node profiler display names built from node names and output shapes
+  // when MXNET_PROFILE_NODE_NAMES is set (needs a longer lifecycle than the
+  // engine operators that reference them)
+  std::unordered_set<std::string> node_opr_names_;
   // verbose logging
   bool log_verbose_ = false;
   // subgraph property name
@@ -25,6 +25,10 @@
 #include <mxnet/op_attr_types.h>
 #include <mxnet/graph_attr_types.h>
 #include <mxnet/imperative.h>
+#include <dmlc/common.h>
+#include <dmlc/omp.h>
+#include <algorithm>
+#include <limits>
 #include "./exec_pass.h"
 #include "../operator/operator_common.h"
 #include "../common/exec_utils.h"
@@ -213,6 +217,79 @@ void ProvideAttrToFusion(const uint32_t nid,
   provide(inode.source->attrs, inode.source->control_deps, in_attrs, out_attrs);
 }
 
+/*!
+ * \brief Topological levels of a node range for the parallel forward
+ *  inference sweep: a node lands one level below the deepest producer of its
+ *  inputs, so nodes of one level never consume each other's outputs and can
+ *  be inferred concurrently. Every consumer writes its input entries back,
+ *  so nodes sharing an input entry with another node of their level, and
+ *  nodes that assign through another node (backward nodes reading their
+ *  forward node, fusion nodes providing attributes to their subgraph), are
+ *  placed on the serial list of the level and run in graph order after the
+ *  parallel batch, which keeps the sequential semantics for them.
+ */
+struct InferLevels {
+  /*! \brief per level, nodes that can be inferred concurrently */
+  std::vector<std::vector<uint32_t> > parallel;
+  /*! \brief per level, nodes that must keep the serial order */
+  std::vector<std::vector<uint32_t> > serial;
+};
+
+inline InferLevels BuildInferLevels(const nnvm::IndexedGraph& idx,
+                                    uint32_t node_start, uint32_t node_end,
+                                    bool bwd_identity_assign) {
+  using nnvm::Op;
+  static auto& is_backward = Op::GetAttr<nnvm::TIsBackward>("TIsBackward");
+  static auto& is_fusion = Op::GetAttr<exec::TIsFusion>("TIsFusion");
+  std::vector<uint32_t> level(node_end, 0);
+  uint32_t num_levels = 1;
+  for (uint32_t nid = node_start; nid < node_end; ++nid) {
+    uint32_t lvl = 0;
+    for (const auto& e : idx[nid].inputs) {
+      lvl = std::max(lvl, level[e.node_id] + 1);
+    }
+    level[nid] = lvl;
+    num_levels = std::max(num_levels, lvl + 1);
+  }
+  // an input entry consumed twice within one level would be written
+  // concurrently; its consumers stay serial
+  std::vector<uint32_t> stamp(idx.num_node_entries(),
+                              std::numeric_limits<uint32_t>::max());
+  std::vector<uint32_t> first_consumer(idx.num_node_entries(), 0);
+  std::vector<bool> serial_node(node_end, false);
+  for (uint32_t nid = node_start; nid < node_end; ++nid) {
+    const auto& inode = idx[nid];
+    if (inode.source->op() != nullptr &&
+        ((is_backward.get(inode.source->op(), false) &&
+          inode.source->control_deps.size() && bwd_identity_assign) ||
+         is_fusion.get(inode.source->op(), false))) {
+      serial_node[nid] = true;
+      continue;
+    }
+    for (const auto& e : inode.inputs) {
+      const uint32_t eid = idx.entry_id(e);
+      if (stamp[eid] == level[nid]) {
+        serial_node[nid] = true;
+        serial_node[first_consumer[eid]] = true;
+      } else {
+        stamp[eid] = level[nid];
+        first_consumer[eid] = nid;
+      }
+    }
+  }
+  InferLevels out;
+  out.parallel.resize(num_levels);
+  out.serial.resize(num_levels);
+  for (uint32_t nid = node_start; nid < node_end; ++nid) {
+    if (serial_node[nid]) {
+      out.serial[level[nid]].push_back(nid);
+    } else {
+      out.parallel[level[nid]].push_back(nid);
+    }
+  }
+  return out;
+}
+
 /*!\brief
  * This is a duplicate of the InferAttr function in nnvm with minor modification
  * to support inferring storage type whose function signature is different from
@@ -338,8 +415,13 @@ nnvm::Graph InferAttr(nnvm::Graph &&ret,
   // Temp space for shape inference.
   std::vector<AttrType> ishape, oshape;
 
-  // inference step function for nid
-  auto infer_step = [&](uint32_t nid, bool last_iter) {
+  // inference step function for nid; the caller owns the temp buffers so the
+  // parallel sweep can run one step per thread
+  auto infer_step = [&](uint32_t nid, bool last_iter,
+                        std::vector<AttrType>* ishape_buf,
+                        std::vector<AttrType>* oshape_buf) {
+    std::vector<AttrType>& ishape = *ishape_buf;
+    std::vector<AttrType>& oshape = *oshape_buf;
     const auto& inode = idx[nid];
     const uint32_t num_inputs = inode.inputs.size();
     const uint32_t num_outputs = inode.source->num_outputs();
@@ -423,6 +505,16 @@ nnvm::Graph InferAttr(nnvm::Graph &&ret,
     }
   };
 
+  // levelized parallel forward sweep, worthwhile on large graphs only
+  const bool parallel_infer =
+      dmlc::GetEnv("MXNET_INFER_ATTR_PARALLEL", false) &&
+      node_end - node_start >= static_cast<uint32_t>(
+          dmlc::GetEnv("MXNET_INFER_ATTR_PARALLEL_MIN_NODES", 1000));
+  InferLevels levels;
+  if (parallel_infer) {
+    levels = BuildInferLevels(idx, node_start, node_end, bwd_identity_assign);
+  }
+
   size_t last_num_unknown;
   size_t num_unknown_dispatch_mode = dispatch_mode_name ? node_end - node_start : 0;
   size_t num_unknown_entry_attr = entry_end - entry_start;
@@ -430,13 +522,31 @@ nnvm::Graph InferAttr(nnvm::Graph &&ret,
   int i = 0;
   do {
     if (i % 2 == 0) {
-      for (uint32_t nid = node_start; nid < node_end; ++nid) {
-        infer_step(nid, false);
+      if (parallel_infer) {
+        dmlc::OMPException omp_exc;
+        for (size_t lvl = 0; lvl < levels.parallel.size(); ++lvl) {
+          const std::vector<uint32_t>& batch = levels.parallel[lvl];
+          #pragma omp parallel for
+          for (int k = 0; k < static_cast<int>(batch.size()); ++k) {
+            omp_exc.Run([&] {
+              std::vector<AttrType> ishape_tmp, oshape_tmp;
+              infer_step(batch[k], false, &ishape_tmp, &oshape_tmp);
+            });
+          }
+          omp_exc.Rethrow();
+          for (uint32_t nid : levels.serial[lvl]) {
+            infer_step(nid, false, &ishape, &oshape);
+          }
+        }
+      } else {
+        for (uint32_t nid = node_start; nid < node_end; ++nid) {
+          infer_step(nid, false, &ishape, &oshape);
+        }
       }
     } else {
       // backward inference
       for (uint32_t i = node_end; i != node_start; --i) {
-        infer_step(i - 1, false);
+        infer_step(i - 1, false, &ishape, &oshape);
       }
     }
     last_num_unknown = num_unknown;
@@ -587,13 +697,22 @@ nnvm::Graph InferShapeAttr(nnvm::Graph &&ret,
   // whether a shape is dynamic
   std::vector<int> is_dynamic(rshape.size(), 0);
 
+  // evaluated once so the parallel sweep does not consult the thread-local
+  // numpy-shape flag from its worker threads
+  const bool is_np_shape = Imperative::Get()->is_np_shape();
+
   // convert to numpy compatible shape to use operator's infer shape function
-  if (!Imperative::Get()->is_np_shape()) {
+  if (!is_np_shape) {
     common::ConvertToNumpyShape(&rshape);
   }
 
-  // inference step function for nid
-  auto infer_step = [&](uint32_t nid, bool last_iter) {
+  // inference step function for nid; the caller owns the temp buffers so the
+  // parallel sweep can run one step per thread
+  auto infer_step = [&](uint32_t nid, bool last_iter,
+                        std::vector<AttrType>* ishape_buf,
+                        std::vector<AttrType>* oshape_buf) {
+    std::vector<AttrType>& ishape = *ishape_buf;
+    std::vector<AttrType>& oshape = *oshape_buf;
     const auto& inode = idx[nid];
     const std::string name = inode.source->attrs.name;
     const uint32_t num_inputs = inode.inputs.size();
@@ -608,7 +727,7 @@ nnvm::Graph InferShapeAttr(nnvm::Graph &&ret,
         if (it != inode.source->attrs.dict.end()) {
           std::istringstream is(it->second);
           CHECK(is >> rshape[out_ent_id]) << "Invalid attribute";
-          if (!Imperative::Get()->is_np_shape()) {
+          if (!is_np_shape) {
             common::ConvertToNumpyShape(&rshape[out_ent_id]);
           }
         }
@@ -693,6 +812,16 @@ nnvm::Graph InferShapeAttr(nnvm::Graph &&ret,
     }
   };
 
+  // levelized parallel forward sweep, worthwhile on large graphs only
+  const bool parallel_infer =
+      dmlc::GetEnv("MXNET_INFER_ATTR_PARALLEL", false) &&
+      node_end - node_start >= static_cast<uint32_t>(
+          dmlc::GetEnv("MXNET_INFER_ATTR_PARALLEL_MIN_NODES", 1000));
+  InferLevels levels;
+  if (parallel_infer) {
+    levels = BuildInferLevels(idx, node_start, node_end, bwd_identity_assign);
+  }
+
   size_t last_num_unknown;
   size_t num_unknown = static_cast<size_t>(-1);  // Infinity
 
@@ -700,13 +829,31 @@ nnvm::Graph InferShapeAttr(nnvm::Graph &&ret,
   do {
     if (i % 2 == 0) {
       // forward inference
-      for (uint32_t nid = node_start; nid < node_end; ++nid) {
-        infer_step(nid, false);
+      if (parallel_infer) {
+        dmlc::OMPException omp_exc;
+        for (size_t lvl = 0; lvl < levels.parallel.size(); ++lvl) {
+          const std::vector<uint32_t>& batch = levels.parallel[lvl];
+          #pragma omp parallel for
+          for (int k = 0; k < static_cast<int>(batch.size()); ++k) {
+            omp_exc.Run([&] {
+              std::vector<AttrType> ishape_tmp, oshape_tmp;
+              infer_step(batch[k], false, &ishape_tmp, &oshape_tmp);
+            });
+          }
+          omp_exc.Rethrow();
+          for (uint32_t nid : levels.serial[lvl]) {
+            infer_step(nid, false, &ishape, &oshape);
+          }
+        }
+      } else {
+        for (uint32_t nid = node_start; nid < node_end; ++nid) {
+          infer_step(nid, false, &ishape, &oshape);
+        }
       }
     } else {
       // backward inference
       for (uint32_t i = node_end; i != node_start; --i) {
-        infer_step(i - 1, false);
+        infer_step(i - 1, false, &ishape, &oshape);
       }
     }
     last_num_unknown = num_unknown;
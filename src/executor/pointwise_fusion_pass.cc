@@ -36,16 +36,24 @@
 #include "../operator/fusion/fused_op.h"
 #include "../operator/operator_common.h"
 
-#if MXNET_USE_CUDA
-
 namespace mxnet {
 namespace exec {
 namespace {
-  bool IsFusionCompatible(nnvm::Node* n) {
+  bool ExtendedFusionEnabled() {
+    static const bool enabled = dmlc::GetEnv("MXNET_FUSION_EXTENDED", false);
+    return enabled;
+  }
+
+  bool IsFusionCompatible(nnvm::Node* n, const bool for_gpu) {
     using namespace mxnet::fusion;
     if (n->op() == nullptr)
       return false;
     std::string op_name = n->op()->name;
+    if (!for_gpu) {
+      // the CPU interpreter covers same-shape pointwise chains only;
+      // no variable-arity ops, slices or reductions
+      return ops_desc.count(op_name) && SupportedByCPUInterpreter(op_name);
+    }
     if (ops_desc.count(op_name))
       return true;
     if (slice_ops.count(op_name))
@@ -75,9 +83,34 @@ namespace {
       }
       return true;
     }
+    if (fusion::broadcast_ops.count(op_name)) {
+      return ExtendedFusionEnabled();
+    }
     return false;
   }
 
+  bool IsFusableReduction(nnvm::Node* n) {
+    using namespace mxnet::fusion;
+    if (!ExtendedFusionEnabled())
+      return false;
+    if (n->op() == nullptr)
+      return false;
+    if (!reduce_ops.count(n->op()->name))
+      return false;
+    // only reductions over the innermost axis keep the flat indexing
+    // of the fused kernel; the axis has to be given as -1 since the
+    // number of dimensions is not known at this point
+    const auto axis = n->attrs.dict.find("axis");
+    if (axis == n->attrs.dict.end() ||
+        (axis->second != "-1" && axis->second != "(-1,)" && axis->second != "[-1]"))
+      return false;
+    const auto exclude = n->attrs.dict.find("exclude");
+    if (exclude != n->attrs.dict.end() &&
+        !(exclude->second == "False" || exclude->second == "0"))
+      return false;
+    return true;
+  }
+
   nnvm::NodePtr CreateSubgraphNode(const Graph& subgraph, size_t inputs_size) {
     nnvm::Symbol subgraph_sym;
     auto node = nnvm::Node::Create();
@@ -267,21 +300,73 @@ void AddInputsOnlyCompatible(const Graph &g,
   }
 }
 
-Graph FusePointwiseForward(Graph &&g) {
+/* \brief Add a reduction over the innermost axis as the final node of a
+ *        subgraph. The reduction has to be the only consumer of the
+ *        subgraph, since after adding it the fused kernel parallelizes
+ *        over the reduced output instead of the pointwise shape.
+ */
+void AddTailReductions(const Graph& g,
+                       std::vector<std::unordered_set<nnvm::Node*> >* subsets) {
+  if (!ExtendedFusionEnabled()) return;
+  std::unordered_map<nnvm::Node*, uint32_t> node2setidx;
+  for (size_t i = 0; i < subsets->size(); ++i) {
+    for (auto& n : (*subsets)[i]) {
+      node2setidx.insert({n, i});
+    }
+  }
+  // the candidate reduction per subset, reset to nullptr again when any
+  // other consumer of the subset (including graph outputs) shows up
+  std::vector<nnvm::Node*> candidate(subsets->size(), nullptr);
+  std::vector<bool> valid(subsets->size(), true);
+  DFSVisit(g.outputs, [&node2setidx, &candidate, &valid](const nnvm::NodePtr& n) {
+    const auto& self = node2setidx.find(n.get());
+    for (auto& e : n->inputs) {
+      const auto& it = node2setidx.find(e.node.get());
+      if (it == node2setidx.end()) continue;
+      if (self != node2setidx.end() && self->second == it->second) continue;
+      const uint32_t idx = it->second;
+      if (candidate[idx] == nullptr && IsFusableReduction(n.get())) {
+        candidate[idx] = n.get();
+      } else {
+        valid[idx] = false;
+      }
+    }
+  });
+  for (auto& e : g.outputs) {
+    const auto& it = node2setidx.find(e.node.get());
+    if (it != node2setidx.end()) {
+      valid[it->second] = false;
+    }
+  }
+  for (size_t i = 0; i < subsets->size(); ++i) {
+    if (valid[i] && candidate[i] != nullptr) {
+      (*subsets)[i].insert(candidate[i]);
+    }
+  }
+}
+
+Graph FusePointwiseForward(Graph &&g, const bool for_gpu) {
   Graph ret;
   g.indexed_graph();
   const auto& num_forward_outputs = g.GetAttr<size_t>("num_forward_outputs");
   Graph fg;
   fg.outputs.insert(fg.outputs.begin(), g.outputs.begin(),
                     g.outputs.begin() + num_forward_outputs);
-  auto subsets = GetCompatibleSubsets(fg, IsFusionCompatible);
-  AddInputsOnlyCompatible(fg, &subsets, IsInputsOnlyCompatible);
+  auto subsets = GetCompatibleSubsets(fg, [for_gpu](nnvm::Node* n) {
+    return IsFusionCompatible(n, for_gpu);
+  });
+  if (for_gpu) {
+    AddInputsOnlyCompatible(fg, &subsets, IsInputsOnlyCompatible);
+    // consumers of a subset may also live in the backward part of the
+    // graph, so the tail reductions are validated against the full graph
+    AddTailReductions(g, &subsets);
+  }
   g = ReplaceSubgraphsPointwise(std::move(g), subsets, CreateSubgraphNode);
   ret.outputs = g.outputs;
   return ret;
 }
 
-Graph FusePointwiseBackward(Graph &&g) {
+Graph FusePointwiseBackward(Graph &&g, const bool for_gpu) {
   Graph ret;
   g.indexed_graph();
   const auto& num_forward_outputs = g.GetAttr<size_t>("num_forward_outputs");
@@ -292,10 +377,10 @@ Graph FusePointwiseBackward(Graph &&g) {
   DFSVisit(fg.outputs, [&exclusion_set](const nnvm::NodePtr& n) {
     exclusion_set.insert(n.get());
   });
-  auto subsets = GetCompatibleSubsets(g, [&exclusion_set](nnvm::Node* n) {
+  auto subsets = GetCompatibleSubsets(g, [&exclusion_set, for_gpu](nnvm::Node* n) {
     if (exclusion_set.count(n))
       return false;
-    return IsFusionCompatible(n);
+    return IsFusionCompatible(n, for_gpu);
   });
   g = ReplaceSubgraphsPointwise(std::move(g), subsets, CreateSubgraphNode);
   ret.outputs = g.outputs;
@@ -304,5 +389,3 @@ Graph FusePointwiseBackward(Graph &&g) {
 
 }  // namespace exec
 }  // namespace mxnet
-
-#endif  // MXNET_USE_CUDA
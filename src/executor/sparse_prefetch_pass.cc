@@ -0,0 +1,89 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2020 by Contributors
+ * \file sparse_prefetch_pass.cc
+ * \brief Analysis pass computing which row_sparse parameters can be pulled
+ *  from a kvstore ahead of execution, and from which graph input the row
+ *  ids come.
+ */
+#include <mxnet/op_attr_types.h>
+#include <unordered_set>
+#include "./exec_pass.h"
+
+namespace mxnet {
+namespace exec {
+
+std::unordered_map<std::string, std::string> GetRowSparsePullPlan(const Graph& g) {
+  std::unordered_map<std::string, std::string> plan;
+  const auto& stypes = g.GetAttr<StorageTypeVector>("storage_type");
+  const auto& idx = g.indexed_graph();
+  // Sparse-index consumers and the positions of their weight and index
+  // inputs. Only ops that read exactly the rows named by their index
+  // argument qualify: for anything else the set of rows touched cannot be
+  // derived from an input ahead of time.
+  struct SlotPair { uint32_t weight; uint32_t index; };
+  static const std::unordered_map<std::string, SlotPair> kSparseConsumers = {
+    {"Embedding", {1, 0}},
+    {"_contrib_SparseEmbedding", {1, 0}},
+    {"take", {0, 1}},
+  };
+  // weight node id -> index input name; nodes in `rejected` have at least
+  // one consumer whose rows cannot be planned, which disqualifies the
+  // parameter entirely.
+  std::unordered_map<uint32_t, std::string> weight_index;
+  std::unordered_set<uint32_t> rejected;
+  for (uint32_t nid = 0; nid < idx.num_nodes(); ++nid) {
+    const auto& inode = idx[nid];
+    if (inode.source->is_variable()) continue;
+    const auto cit = kSparseConsumers.find(inode.source->op()->name);
+    for (uint32_t i = 0; i < inode.inputs.size(); ++i) {
+      const auto& e = inode.inputs[i];
+      if (!idx[e.node_id].source->is_variable()) continue;
+      if (stypes[idx.entry_id(e)] != kRowSparseStorage) continue;
+      bool planned = false;
+      if (cit != kSparseConsumers.end() && i == cit->second.weight) {
+        const auto& ie = inode.inputs[cit->second.index];
+        const auto* isrc = idx[ie.node_id].source;
+        if (isrc->is_variable()) {
+          const std::string& index_name = isrc->attrs.name;
+          auto wit = weight_index.find(e.node_id);
+          if (wit == weight_index.end()) {
+            weight_index.emplace(e.node_id, index_name);
+            planned = true;
+          } else if (wit->second == index_name) {
+            planned = true;
+          }
+          // two consumers with different index inputs would need a union
+          // of the rows; fall through to rejection
+        }
+      }
+      if (!planned) rejected.insert(e.node_id);
+    }
+  }
+  for (const auto& kv : weight_index) {
+    if (rejected.count(kv.first)) continue;
+    plan.emplace(idx[kv.first].source->attrs.name, kv.second);
+  }
+  return plan;
+}
+
+}  // namespace exec
+}  // namespace mxnet
@@ -18,10 +18,12 @@
  */
 #include <unordered_set>
 #include <iostream>
+#include <chrono>
 #include "./imperative_utils.h"
 #include "./cached_op.h"
 #include "../executor/exec_pass.h"
 #include "../profiler/profiler.h"
+#include "../storage/memory_budget.h"
 #include "../operator/operator_common.h"
 #include "../operator/subgraph/common.h"
 
@@ -62,6 +64,12 @@ struct CachedOp::DynamicRuntime {
   GraphInfo info;
   std::vector<NDArray> buff;
   std::vector<OpStatePtr> op_states;
+  // retained-graph replay bookkeeping: signature of the previous backward
+  // call and the reqs/ref counts it derived, so identical repeat backwards
+  // skip graph setup entirely
+  std::string bwd_signature;
+  std::vector<uint32_t> bwd_ref_count;
+  std::vector<OpReqType> bwd_array_reqs;
 };
 
 void CreateFullGraph(const nnvm::Symbol& sym,
@@ -69,7 +77,8 @@ void CreateFullGraph(const nnvm::Symbol& sym,
                      nnvm::Graph* grad_graph,
                      nnvm::Graph* full_graph,
                      std::vector<nnvm::NodeEntry>* ograd_entries,
-                     std::unordered_map<uint32_t, uint32_t>* fwd_input_to_grad_output) {
+                     std::unordered_map<uint32_t, uint32_t>* fwd_input_to_grad_output,
+                     uint32_t backward_mirror_depth) {
   using namespace nnvm;
   static const std::vector<const Op*> zero_ops{Op::Get("zeros_like"), Op::Get("_zeros")};
   static const auto _copy_op = Op::Get("_copy");
@@ -119,9 +128,19 @@ void CreateFullGraph(const nnvm::Symbol& sym,
     CHECK(!xs.empty())
         << "There are no inputs in computation graph that require gradients.";
 
+    // selective recomputation of cheap activations during backward
+    std::function<int(const nnvm::Node&)> mirror_fun = nullptr;
+    if (backward_mirror_depth > 0) {
+      const auto mirrored = exec::SelectMirrorNodes(fwd_graph->outputs,
+                                                    backward_mirror_depth);
+      mirror_fun = [mirrored](const nnvm::Node& node) -> int {
+        return mirrored.count(&node) > 0;
+      };
+    }
+
     *grad_graph = pass::MXGradient(
         *fwd_graph, fwd_graph->outputs, xs, *ograd_entries,
-        exec::AggregateGradient, nullptr, nullptr,
+        exec::AggregateGradient, mirror_fun, nullptr,
         zero_ops, "_copy");
   }
 
@@ -129,6 +148,18 @@ void CreateFullGraph(const nnvm::Symbol& sym,
   {
     full_graph->outputs = fwd_graph->outputs;
     for (const auto& i : grad_graph->outputs) full_graph->outputs.emplace_back(i);
+    if (do_elim_common_expr &&
+        dmlc::GetEnv("MXNET_ELIMINATE_COMMON_EXPR_FULL_GRAPH", false)) {
+      // Deduplicate the backward section against the forward one, so backward
+      // reuses forward intermediates (e.g. transposes and reshapes) instead of
+      // recomputing them. The pass never eliminates forward nodes, so
+      // fwd_graph stays valid; refresh grad_graph from the rewritten outputs.
+      full_graph->attrs["num_forward_outputs"] =
+          std::make_shared<dmlc::any>(fwd_graph->outputs.size());
+      *full_graph = exec::EliminateCommonExpr(std::move(*full_graph));
+      grad_graph->outputs.assign(full_graph->outputs.begin() + fwd_graph->outputs.size(),
+                                 full_graph->outputs.end());
+    }
   }
 }
 
@@ -167,18 +198,22 @@ void SetRefCounts(nnvm::Graph* fwd_graph, const nnvm::Graph& full_graph) {
 
 void OptimizeGraph(nnvm::Graph * full_graph, nnvm::Graph * fwd_graph, nnvm::Graph * grad_graph,
                    const Context& context, size_t num_forward_outputs, const bool inlining) {
-#if MXNET_USE_CUDA && !defined(_WIN32)
-  if (context.dev_mask() == kGPU &&
-      !inlining &&
-      dmlc::GetEnv("MXNET_USE_FUSION", true)) {
+#if !defined(_WIN32)
+  const bool fuse_for_gpu = context.dev_mask() == kGPU;
+  // GPU fusion needs the runtime compiler; the interpreted CPU path is
+  // opt-in since it only pays off on elementwise-heavy graphs
+  const bool use_fusion = fuse_for_gpu ?
+      (MXNET_USE_CUDA && dmlc::GetEnv("MXNET_USE_FUSION", true)) :
+      dmlc::GetEnv("MXNET_USE_FUSION_CPU", false);
+  if (!inlining && use_fusion) {
     nnvm::Graph unoptimized_graph;
     common::CopyGraph(&unoptimized_graph, *full_graph, false);
 
     if (common::CheckForInputNameDuplicates(unoptimized_graph.indexed_graph())) {
       full_graph->attrs["num_forward_outputs"] = std::make_shared<nnvm::any>(num_forward_outputs);
-      *full_graph = exec::FusePointwiseForward(std::move(*full_graph));
+      *full_graph = exec::FusePointwiseForward(std::move(*full_graph), fuse_for_gpu);
       full_graph->attrs["num_forward_outputs"] = std::make_shared<nnvm::any>(num_forward_outputs);
-      *full_graph = exec::FusePointwiseBackward(std::move(*full_graph));
+      *full_graph = exec::FusePointwiseBackward(std::move(*full_graph), fuse_for_gpu);
       // Check the topological order of inputs
       const auto &original_inputs = unoptimized_graph.indexed_graph().input_nodes();
       const auto &new_inputs = full_graph->indexed_graph().input_nodes();
@@ -202,7 +237,7 @@ void OptimizeGraph(nnvm::Graph * full_graph, nnvm::Graph * fwd_graph, nnvm::Grap
         << "Graph contains duplicate names for some of its inputs - fusion is NOT enabled!";
      }
   }
-#endif  // MXNET_USE_CUDA
+#endif  // !defined(_WIN32)
 
   *fwd_graph = nnvm::Graph();
   fwd_graph->outputs = std::vector<nnvm::NodeEntry>(full_graph->outputs.begin(),
@@ -219,13 +254,15 @@ struct CachedOp::CachedOpState {
   CachedOpState(const Context& context_,
                 const nnvm::Graph& fwd_graph_,
                 const nnvm::Graph& full_graph_,
-                const bool inlining_) {
+                const bool inlining_,
+                const uint32_t backward_mirror_depth_) {
     context = context_;
     nnvm::Symbol sym;
     sym.outputs = fwd_graph_.outputs;
     CreateFullGraph(sym.Copy(), &info.fwd_graph, &info.grad_graph,
                     &info.full_graph, &info.ograd_entries,
-                    &info.fwd_input_to_grad_output);
+                    &info.fwd_input_to_grad_output,
+                    backward_mirror_depth_);
 
     OptimizeGraph(&info.full_graph, &info.fwd_graph, &info.grad_graph,
                   context_, fwd_graph_.outputs.size(), inlining_);
@@ -249,6 +286,8 @@ struct CachedOp::CachedOpState {
   std::mutex mutex;
   Context context;
   GraphInfo info;
+  // LRU cache of planned forward-graph attributes keyed by input signature
+  PlanCache plan_cache;
 
   bool recording = false;
   bool fwd_alloc = false;
@@ -283,7 +322,8 @@ CachedOp::CachedOp(
   auto grad_graph = nnvm::Graph();
   std::unordered_map<uint32_t, uint32_t> fwd_input_to_grad_output;
   CreateFullGraph(sym.Copy(), &fwd_graph_, &grad_graph, &full_graph_,
-                  &ograd_entries_, &fwd_input_to_grad_output);
+                  &ograd_entries_, &fwd_input_to_grad_output,
+                  config_.backward_mirror_depth);
 
   {
     const auto& idx = fwd_graph_.indexed_graph();
@@ -414,12 +454,47 @@ bool CachedOp::CheckDynamicShapeExists(const Context& default_ctx,
 bool CachedOp::SetForwardGraph(
     GraphInfo* info,
     const bool recording,
-    const std::vector<NDArray*>& inputs) {
+    const std::vector<NDArray*>& inputs,
+    PlanCache* plan_cache) {
   using namespace nnvm;
   using namespace imperative;
   CHECK_EQ(inputs.size(), num_inputs());
   nnvm::Graph& g = info->fwd_graph;
 
+  // look up a ready plan for this input signature
+  static const size_t plan_cache_size =
+      dmlc::GetEnv("MXNET_CACHED_OP_PLAN_CACHE_SIZE", 8);
+  std::string signature;
+  if (plan_cache != nullptr && plan_cache_size != 0) {
+    std::ostringstream sig;
+    sig << recording;
+    for (auto input : inputs) {
+      sig << ';' << input->shape() << ',' << input->dtype()
+          << ',' << input->storage_type();
+    }
+    signature = sig.str();
+    for (auto it = plan_cache->begin(); it != plan_cache->end(); ++it) {
+      if (it->first != signature) continue;
+      // a returning signature hits a fully inferred and planned set of
+      // graph attributes with zero inference cost
+      bool same = true;
+      for (const char* key : {"shape", "dtype", "storage_type"}) {
+        auto cur = g.attrs.find(key);
+        same = same && cur != g.attrs.end() && cur->second == it->second.at(key);
+      }
+      if (!same) g.attrs = it->second;
+      plan_cache->splice(plan_cache->begin(), *plan_cache, it);
+      // only report a match when the restored plan is the one the caller
+      // already set its buffers up for, so a shape change still re-inits
+      return same;
+    }
+  }
+  auto remember_plan = [&]() {
+    if (plan_cache == nullptr || plan_cache_size == 0) return;
+    plan_cache->emplace_front(signature, g.attrs);
+    if (plan_cache->size() > plan_cache_size) plan_cache->pop_back();
+  };
+
   ShapeVector shape_inputs;
   DTypeVector dtype_inputs;
   StorageTypeVector storage_type_inputs;
@@ -452,6 +527,7 @@ bool CachedOp::SetForwardGraph(
     g.attrs.erase(AddPrefix(FORWARD, MEM_PLAN));
     g.attrs.erase(AddPrefix(FULL, MEM_PLAN));
   } else if (g.attrs.count(AddPrefix(prefix, MEM_PLAN))) {
+    remember_plan();
     return true;
   }
 
@@ -475,6 +551,7 @@ bool CachedOp::SetForwardGraph(
       AddPrefix(prefix, STORAGE_PLAN));
   g.attrs[AddPrefix(prefix, MEM_PLAN)] =
       std::make_shared<dmlc::any>(std::move(mem_plan));
+  remember_plan();
 
   return false;
 }
@@ -614,13 +691,15 @@ OpStatePtr CachedOp::GetCachedOpState(
     const Context& ctx) {
   std::lock_guard<std::mutex> lock(mutex_);
   for (const auto& i : cached_op_states_[ctx]) {
-    // only create one state per device when not using static memory
-    if (!config_.static_alloc || i.unique()) {
+    // only create one state per device when not using static memory;
+    // in thread-safe mode states are pooled per concurrent invocation
+    if ((!config_.static_alloc && !config_.thread_safe) || i.unique()) {
       return i;
     }
   }
   auto state_ptr = OpStatePtr::Create<CachedOpState>(ctx, fwd_graph_, full_graph_,
-                                                     inlining_);
+                                                     inlining_,
+                                                     config_.backward_mirror_depth);
 
   cached_op_states_[ctx].push_back(state_ptr);
   return state_ptr;
@@ -681,9 +760,32 @@ void CachedOp::StaticAllocMemory(
   }
 
   auto& reuse_pool = keep_fwd ? state.bwd_reuse_pool : state.fwd_reuse_pool;
-  reuse_pool = imperative::AllocateMemory(
-      g, idx, default_ctx, start_eid, end_eid, mem_plan,
-      state.arrays, &state.array_reqs, std::move(reuse_pool));
+  static const bool static_arena_enabled =
+      dmlc::GetEnv("MXNET_CACHED_OP_STATIC_ARENA", false);
+  if (static_arena_enabled) {
+    // Lease activation chunks from a process-wide per-context arena so model
+    // replicas that never run concurrently share one set of buffers instead
+    // of each allocating its own. Sharing is safe because every chunk carries
+    // an engine variable: replicas that do overlap are serialized by the
+    // dependency engine rather than corrupting each other's activations.
+    static std::mutex arena_mutex;
+    static std::unordered_map<Context, std::multimap<size_t, NDArray> > arenas;
+    std::lock_guard<std::mutex> arena_lock(arena_mutex);
+    auto& arena = arenas[default_ctx];
+    for (const auto& chunk : arena) reuse_pool.insert(chunk);
+    reuse_pool = imperative::AllocateMemory(
+        g, idx, default_ctx, start_eid, end_eid, mem_plan,
+        state.arrays, &state.array_reqs, std::move(reuse_pool));
+    std::unordered_set<const void*> known_chunks;
+    for (const auto& chunk : arena) known_chunks.insert(chunk.second.var());
+    for (const auto& chunk : reuse_pool) {
+      if (!known_chunks.count(chunk.second.var())) arena.insert(chunk);
+    }
+  } else {
+    reuse_pool = imperative::AllocateMemory(
+        g, idx, default_ctx, start_eid, end_eid, mem_plan,
+        state.arrays, &state.array_reqs, std::move(reuse_pool));
+  }
 
   state.recording = recording;
   if (keep_fwd) {
@@ -757,8 +859,24 @@ void CachedOp::StaticInitExec(
         bulk_size = 0;
     }
 
+    // Explicit segment boundaries requested at creation time, e.g. at
+    // parameter-sync points so bulking does not delay kvstore overlap.
+    std::unordered_set<size_t> boundary_nids;
+    if (!config_.bulk_boundaries.empty()) {
+      std::unordered_set<std::string> boundary_names;
+      std::istringstream names(config_.bulk_boundaries);
+      std::string name;
+      while (std::getline(names, name, ',')) {
+        if (!name.empty()) boundary_names.insert(name);
+      }
+      for (size_t i = start_nid; i < end_nid; ++i) {
+        if (boundary_names.count(idx[i].source->attrs.name)) boundary_nids.insert(i);
+      }
+    }
+
     CreateEngineOpSeg(idx, default_ctx, start_nid, end_nid, bulk_size,
-                      state.execs, skip_plus_node, &state.opr_segs);
+                      state.execs, skip_plus_node, &state.opr_segs,
+                      boundary_nids.empty() ? nullptr : &boundary_nids);
   }
 
   if (keep_fwd) {
@@ -870,7 +988,7 @@ OpStatePtr CachedOp::StaticForward(
   auto& state = state_ptr.get_state<CachedOpState>();
   std::lock_guard<std::mutex> lock(state.mutex);
 
-  bool match = SetForwardGraph(&state.info, recording, inputs);
+  bool match = SetForwardGraph(&state.info, recording, inputs, &state.plan_cache);
   match = match && state.recording == recording;
 
   nnvm::Graph& g = state.info.fwd_graph;
@@ -947,7 +1065,7 @@ OpStatePtr CachedOp::DynamicForward(
     auto state_ptr = GetCachedOpState(default_ctx);
     auto& state = state_ptr.get_state<CachedOpState>();
     std::lock_guard<std::mutex> lock(state.mutex);
-    SetForwardGraph(&state.info, recording, inputs);
+    SetForwardGraph(&state.info, recording, inputs, &state.plan_cache);
     runtime.info.fwd_graph = state.info.fwd_graph;
   }
   nnvm::Graph& g = runtime.info.fwd_graph;
@@ -1020,7 +1138,7 @@ OpStatePtr CachedOp::DynamicForward(
   return op_state;
 }
 
-OpStatePtr CachedOp::Forward(
+OpStatePtr CachedOp::ForwardImpl(
     const std::shared_ptr<CachedOp>& op_ptr,
     const std::vector<NDArray*>& inputs,
     const std::vector<NDArray*>& outputs) {
@@ -1029,10 +1147,10 @@ OpStatePtr CachedOp::Forward(
   CHECK_EQ(inputs.size(), num_inputs());
 
   Context default_ctx = inputs[0]->ctx();
-  auto state_ptr = GetCachedOpState(default_ctx);
-  auto& state = state_ptr.get_state<CachedOpState>();
-
-  const auto& idx = state.info.fwd_graph.indexed_graph();
+  // fwd_graph_ is read-only after construction, so the context check does not
+  // need to grab a state; holding one here would also make the pooled states
+  // of thread-safe mode look busy to the nested GetCachedOpState calls
+  const auto& idx = fwd_graph_.indexed_graph();
   for (size_t i = 0; i < inputs.size(); ++i) {
     CHECK_EQ(inputs[i]->ctx(), default_ctx)
         << "CachedOp requires all inputs to live on the same context. But "
@@ -1043,10 +1161,24 @@ OpStatePtr CachedOp::Forward(
   }
 
   int prev_bulk_size = Engine::Get()->set_bulk_size(config_.forward_bulk_size);
+  // route all ops scheduled by this forward pass onto the configured lane
+  int prev_priority = Engine::ThreadLocalDefaultPriority();
+  Engine::ThreadLocalDefaultPriority() = config_.priority;
 
   OpStatePtr op_state;
   try {
-    if (config_.is_dynamic || CheckDynamicShapeExists(default_ctx, inputs, true)) {
+    if (config_.thread_safe) {
+      // Reentrant mode: skip the one-time dynamic-shape detection, which
+      // rewrites shared graph state without holding the state lock, and do
+      // not cache its result in config_, which other threads may be reading.
+      if (config_.is_dynamic) {
+        op_state = DynamicForward(default_ctx, inputs, outputs, true);
+      } else if (config_.static_alloc) {
+        op_state = StaticForward(default_ctx, inputs, outputs);
+      } else {
+        op_state = DynamicForward(default_ctx, inputs, outputs, false);
+      }
+    } else if (config_.is_dynamic || CheckDynamicShapeExists(default_ctx, inputs, true)) {
       config_.is_dynamic = true;
       config_.static_alloc = false;
       op_state = DynamicForward(default_ctx, inputs, outputs, true);
@@ -1057,10 +1189,12 @@ OpStatePtr CachedOp::Forward(
     }
   } catch (const dmlc::Error& e) {
     Engine::Get()->set_bulk_size(prev_bulk_size);
+    Engine::ThreadLocalDefaultPriority() = prev_priority;
     throw e;
   }
 
   Engine::Get()->set_bulk_size(prev_bulk_size);
+  Engine::ThreadLocalDefaultPriority() = prev_priority;
 
   if (Imperative::Get()->is_recording() && !inlining_) {
     nnvm::NodeAttrs attrs;
@@ -1074,6 +1208,155 @@ OpStatePtr CachedOp::Forward(
   return op_state;
 }
 
+struct CachedOp::BatchRequest {
+  const std::vector<NDArray*>* inputs;
+  const std::vector<NDArray*>* outputs;
+  bool taken{false};
+  bool done{false};
+  bool failed{false};
+};
+
+void CachedOp::RunBatch(
+    const std::shared_ptr<CachedOp>& op_ptr,
+    std::unique_lock<std::mutex>* lock) {
+  static const nnvm::Op* concat_op = nnvm::Op::Get("Concat");
+  static const nnvm::Op* slice_axis_op = nnvm::Op::Get("slice_axis");
+
+  std::vector<BatchRequest*> batch;
+  batch.swap(batch_queue_);
+  for (BatchRequest* r : batch) r->taken = true;
+  lock->unlock();
+
+  try {
+    if (batch.size() == 1) {
+      ForwardImpl(op_ptr, *batch[0]->inputs, *batch[0]->outputs);
+    } else {
+      const Context default_ctx = (*batch[0]->inputs)[0]->ctx();
+      // gather: stack each input of the queued requests along the batch axis
+      std::vector<NDArray> batched_in(num_inputs());
+      std::vector<NDArray*> in_ptrs(num_inputs());
+      for (size_t i = 0; i < batched_in.size(); ++i) {
+        std::vector<NDArray*> parts;
+        parts.reserve(batch.size());
+        for (BatchRequest* r : batch) parts.push_back((*r->inputs)[i]);
+        nnvm::NodeAttrs attrs;
+        attrs.op = concat_op;
+        attrs.dict["num_args"] = std::to_string(parts.size());
+        attrs.dict["dim"] = "0";
+        attrs.op->attr_parser(&attrs);
+        std::vector<NDArray*> concat_out = {&batched_in[i]};
+        Imperative::Get()->Invoke(default_ctx, attrs, parts, concat_out);
+        in_ptrs[i] = &batched_in[i];
+      }
+
+      std::vector<NDArray> batched_out(num_outputs());
+      std::vector<NDArray*> out_ptrs(num_outputs());
+      for (size_t i = 0; i < batched_out.size(); ++i) out_ptrs[i] = &batched_out[i];
+      ForwardImpl(op_ptr, in_ptrs, out_ptrs);
+
+      // scatter: slice each output back to the caller of every request
+      for (size_t i = 0; i < batched_out.size(); ++i) {
+        CHECK(shape_is_known(batched_out[i].shape()))
+            << "Dynamic batching requires statically inferrable output shapes";
+        CHECK_EQ(batched_out[i].shape()[0] % batch.size(), 0U);
+        const nnvm::dim_t rows = batched_out[i].shape()[0] / batch.size();
+        for (size_t j = 0; j < batch.size(); ++j) {
+          nnvm::NodeAttrs attrs;
+          attrs.op = slice_axis_op;
+          attrs.dict["axis"] = "0";
+          attrs.dict["begin"] = std::to_string(j * rows);
+          attrs.dict["end"] = std::to_string((j + 1) * rows);
+          attrs.op->attr_parser(&attrs);
+          std::vector<NDArray*> slice_in = {&batched_out[i]};
+          std::vector<NDArray*> slice_out = {(*batch[j]->outputs)[i]};
+          Imperative::Get()->Invoke(default_ctx, attrs, slice_in, slice_out);
+        }
+      }
+    }
+  } catch (const dmlc::Error& e) {
+    lock->lock();
+    for (BatchRequest* r : batch) {
+      r->failed = true;
+      r->done = true;
+    }
+    batch_cv_.notify_all();
+    throw e;
+  }
+
+  lock->lock();
+  for (BatchRequest* r : batch) r->done = true;
+  batch_cv_.notify_all();
+}
+
+OpStatePtr CachedOp::BatchedForward(
+    const std::shared_ptr<CachedOp>& op_ptr,
+    const std::vector<NDArray*>& inputs,
+    const std::vector<NDArray*>& outputs) {
+  std::ostringstream sig;
+  sig << inputs[0]->ctx();
+  for (const NDArray* i : inputs) {
+    sig << ';' << i->shape() << ',' << i->dtype() << ',' << i->storage_type();
+  }
+  const std::string signature = sig.str();
+
+  BatchRequest req;
+  req.inputs = &inputs;
+  req.outputs = &outputs;
+
+  std::unique_lock<std::mutex> lock(batch_mutex_);
+  if (!batch_queue_.empty() && batch_signature_ != signature) {
+    // requests with different descriptors cannot be stacked; run this one
+    // alone rather than flushing the batch that is still filling up
+    lock.unlock();
+    return ForwardImpl(op_ptr, inputs, outputs);
+  }
+  batch_signature_ = signature;
+  batch_queue_.push_back(&req);
+
+  if (batch_queue_.size() >= config_.dynamic_batching) {
+    RunBatch(op_ptr, &lock);
+  } else {
+    const auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::microseconds(config_.dynamic_batching_timeout);
+    while (!req.done) {
+      if (req.taken) {
+        // a leader is running our batch; all that is left is to wait
+        batch_cv_.wait(lock);
+      } else if (batch_cv_.wait_until(lock, deadline) == std::cv_status::timeout &&
+                 !req.done && !req.taken) {
+        // deadline fired first: lead whatever has been queued so far
+        RunBatch(op_ptr, &lock);
+      }
+    }
+  }
+  CHECK(!req.failed)
+      << "Batched execution failed for a concurrent CachedOp request";
+  return OpStatePtr();
+}
+
+OpStatePtr CachedOp::Forward(
+    const std::shared_ptr<CachedOp>& op_ptr,
+    const std::vector<NDArray*>& inputs,
+    const std::vector<NDArray*>& outputs) {
+  // allocations made for this call, here or on the engine workers running
+  // the pushed ops, are tallied against the budget; the budget outlives the
+  // scope through the engine ops that captured it
+  std::unique_ptr<storage::MemoryBudgetScope> budget_scope;
+  if (config_.mem_budget > 0) {
+    budget_scope.reset(
+        new storage::MemoryBudgetScope(config_.mem_budget, "CachedOp::Forward"));
+  }
+  if (config_.dynamic_batching > 1 && inputs.size() > 0 &&
+      !config_.is_dynamic && !Imperative::Get()->is_recording()) {
+    bool dense = true;
+    for (const NDArray* i : inputs) {
+      dense = dense && i->storage_type() == kDefaultStorage;
+    }
+    if (dense) return BatchedForward(op_ptr, inputs, outputs);
+  }
+  return ForwardImpl(op_ptr, inputs, outputs);
+}
+
 void CachedOp::DynamicBackward(
     const bool retain_graph,
     const OpStatePtr& op_state,
@@ -1086,7 +1369,25 @@ void CachedOp::DynamicBackward(
   // Initialize
   Context default_ctx = outputs[0]->ctx();
   auto& runtime = op_state.get_state<DynamicRuntime>();
-  {
+  // A retained-graph replay runs the same backward graph again; when the
+  // request signature matches the previous call on this runtime, skip the
+  // graph rebuild, attribute inference and req/ref-count recomputation and
+  // go straight to binding arrays and pushing ops.
+  static const bool replay_enabled =
+      dmlc::GetEnv("MXNET_CACHED_OP_BACKWARD_REPLAY", false);
+  std::string signature;
+  bool replay = false;
+  if (replay_enabled) {
+    std::ostringstream sig;
+    sig << retain_graph;
+    for (const auto& r : reqs) sig << ',' << r;
+    for (const auto& i : inputs) {
+      sig << ';' << i->shape() << ',' << i->dtype() << ',' << i->storage_type();
+    }
+    signature = sig.str();
+    replay = !runtime.bwd_signature.empty() && runtime.bwd_signature == signature;
+  }
+  if (!replay) {
     auto state_ptr = GetCachedOpState(default_ctx);
     auto& state = state_ptr.get_state<CachedOpState>();
     std::lock_guard<std::mutex> lock(state.mutex);
@@ -1125,20 +1426,32 @@ void CachedOp::DynamicBackward(
   }
 
   // Allocate NDArrays
-  auto ref_count = g.GetAttr<std::vector<uint32_t> >(AddPrefix(BACKWARD, REF_COUNT));
-  if (retain_graph) {
-    for (size_t i = 0; i < num_forward_entries; ++i) ++ref_count[i];
-  }
+  std::vector<uint32_t> ref_count;
+  std::vector<OpReqType> array_reqs;
+  if (replay) {
+    ref_count = runtime.bwd_ref_count;
+    array_reqs = runtime.bwd_array_reqs;
+  } else {
+    ref_count = g.GetAttr<std::vector<uint32_t> >(AddPrefix(BACKWARD, REF_COUNT));
+    if (retain_graph) {
+      for (size_t i = 0; i < num_forward_entries; ++i) ++ref_count[i];
+    }
 
-  std::vector<OpReqType> array_reqs(arrays.size(), kWriteTo);
-  // set output reqs
-  for (size_t i = 0, j = num_forward_outputs; i < reqs.size(); ++i) {
-    if (reqs[i] == kNullOp) continue;
-    array_reqs[idx.entry_id(idx.outputs()[j++])] = reqs[i];
-  }
-  // set null reqs based on ref counts
-  for (size_t i = num_forward_entries; i < idx.num_node_entries(); ++i) {
-    if (ref_count[i] == 0) array_reqs[i] = kNullOp;
+    array_reqs.assign(arrays.size(), kWriteTo);
+    // set output reqs
+    for (size_t i = 0, j = num_forward_outputs; i < reqs.size(); ++i) {
+      if (reqs[i] == kNullOp) continue;
+      array_reqs[idx.entry_id(idx.outputs()[j++])] = reqs[i];
+    }
+    // set null reqs based on ref counts
+    for (size_t i = num_forward_entries; i < idx.num_node_entries(); ++i) {
+      if (ref_count[i] == 0) array_reqs[i] = kNullOp;
+    }
+    if (replay_enabled && retain_graph) {
+      runtime.bwd_ref_count = ref_count;
+      runtime.bwd_array_reqs = array_reqs;
+      runtime.bwd_signature = signature;
+    }
   }
 
   const auto& mem_plan = g.GetAttr<MemoryPlanVector >(AddPrefix(BACKWARD, MEM_PLAN));
@@ -1156,6 +1469,7 @@ void CachedOp::DynamicBackward(
   } else {
     buff.clear();
     states.clear();
+    runtime.bwd_signature.clear();
   }
 }
 
@@ -1259,6 +1573,8 @@ void CachedOp::Backward(
       << "do not use hybridize.";
 
   int prev_bulk_size = Engine::Get()->set_bulk_size(config_.backward_bulk_size);
+  int prev_priority = Engine::ThreadLocalDefaultPriority();
+  Engine::ThreadLocalDefaultPriority() = config_.priority;
 
   try {
     if (config_.static_alloc) {
@@ -1268,10 +1584,12 @@ void CachedOp::Backward(
     }
   } catch (const dmlc::Error& e) {
     Engine::Get()->set_bulk_size(prev_bulk_size);
+    Engine::ThreadLocalDefaultPriority() = prev_priority;
     throw e;
   }
 
   Engine::Get()->set_bulk_size(prev_bulk_size);
+  Engine::ThreadLocalDefaultPriority() = prev_priority;
 }
 
 /*
@@ -23,9 +23,12 @@
 #include <mxnet/imperative.h>
 #include <vector>
 #include <atomic>
+#include <condition_variable>
+#include <list>
 #include <utility>
 #include <string>
 #include <unordered_map>
+#include "../common/utils.h"
 
 namespace mxnet {
 /*! \brief CachedOp Parameters */
@@ -33,11 +36,18 @@ struct CachedOpConfig : public dmlc::Parameter<CachedOpConfig> {
   uint32_t inline_limit;
   uint32_t forward_bulk_size;
   uint32_t backward_bulk_size;
+  uint32_t backward_mirror_depth;
+  uint32_t dynamic_batching;
+  uint32_t dynamic_batching_timeout;
+  int priority;
+  uint64_t mem_budget;
   bool static_alloc;
   bool static_shape;
   bool is_dynamic;
   mxnet::Tuple<uint32_t> data_indices;
   mxnet::Tuple<uint32_t> param_indices;
+  bool thread_safe;
+  std::string bulk_boundaries;
   std::string subgraph;
   DMLC_DECLARE_PARAMETER(CachedOpConfig) {
     DMLC_DECLARE_FIELD(static_alloc)
@@ -53,17 +63,62 @@ struct CachedOpConfig : public dmlc::Parameter<CachedOpConfig> {
     .set_default(2)
     .describe("Maximum number of operators that can be inlined.");
     DMLC_DECLARE_FIELD(forward_bulk_size)
-    .set_default(Imperative::BulkExecMaxNodeTrainFwd())
+    .set_default(Imperative::BulkExecMaxNodeTrainFwd(common::TuningHint("bulk_size", 15)))
     .describe("Segment size of bulk execution during forward pass.");
     DMLC_DECLARE_FIELD(backward_bulk_size)
-    .set_default(Imperative::BulkExecMaxNodeTrainBwd())
+    .set_default(Imperative::BulkExecMaxNodeTrainBwd(common::TuningHint("bulk_size", 15)))
     .describe("Segment size of bulk execution during backward pass.");
+    DMLC_DECLARE_FIELD(backward_mirror_depth)
+    .set_default(0)
+    .describe("Recompute cheap forward activations during the backward pass "
+              "instead of keeping them alive, trading compute for memory. "
+              "Each recompute chain is limited to this many operators. "
+              "0 disables recomputation.");
+    DMLC_DECLARE_FIELD(dynamic_batching)
+    .set_default(0)
+    .describe("Maximum dynamic batch size. If greater than 1, concurrent "
+              "Forward calls with identical input descriptors are queued, "
+              "concatenated along the first axis and executed as one batch "
+              "when either this many requests are waiting or "
+              "dynamic_batching_timeout expires; outputs are sliced back to "
+              "the callers. Inference only; recording calls and "
+              "dynamic-shape graphs run unbatched.");
+    DMLC_DECLARE_FIELD(dynamic_batching_timeout)
+    .set_default(200)
+    .describe("Time in microseconds a queued Forward call waits for the "
+              "dynamic batch to fill before running with whatever requests "
+              "have arrived.");
+    DMLC_DECLARE_FIELD(priority)
+    .set_default(0)
+    .describe("Engine scheduling lane for ops pushed by this CachedOp. "
+              "Higher values are dequeued first by priority-aware engine "
+              "queues (100 = realtime, 0 = default, -100 = background).");
+    DMLC_DECLARE_FIELD(mem_budget)
+    .set_default(0)
+    .describe("Hard limit in bytes on the memory one Forward call may hold "
+              "live, including allocations the engine makes on its behalf. "
+              "A call exceeding the limit fails with an error instead of "
+              "exhausting the device for the whole process. 0 disables it.");
     DMLC_DECLARE_FIELD(data_indices)
     .set_default(mxnet::Tuple<uint32_t>())
     .describe("Position of argument variables.");
     DMLC_DECLARE_FIELD(param_indices)
     .set_default(mxnet::Tuple<uint32_t>())
     .describe("Position of parameters.");
+    DMLC_DECLARE_FIELD(thread_safe)
+    .set_default(false)
+    .describe("Allow concurrent Forward calls from multiple threads. "
+              "Intermediate buffers are pooled per concurrent invocation "
+              "while parameters stay shared, so one model instance can "
+              "serve several threads. Graphs containing dynamic-shape "
+              "operators must set is_dynamic explicitly in this mode.");
+    DMLC_DECLARE_FIELD(bulk_boundaries)
+    .set_default(std::string(""))
+    .describe("Comma-separated list of node names at which bulk execution "
+              "segments must break; each named node starts a new segment. "
+              "Use this to align segment boundaries with parameter "
+              "synchronization points so bulking does not delay overlapped "
+              "kvstore communication. Only effective with static_shape.");
     DMLC_DECLARE_FIELD(subgraph)
     .set_default(std::string(""))
     .describe("JSON string of a subgraph.");
@@ -151,12 +206,28 @@ class CachedOp {
   struct GraphInfo;
   struct DynamicRuntime;
   struct CachedOpState;
+  struct BatchRequest;
+  // snapshot of fully inferred and planned graph attributes
+  using GraphAttrs = std::unordered_map<std::string, std::shared_ptr<dmlc::any> >;
+  using PlanCache = std::list<std::pair<std::string, GraphAttrs> >;
 
   OpStatePtr GetCachedOpState(const Context& ctx);
+  OpStatePtr ForwardImpl(
+      const std::shared_ptr<CachedOp>& op_ptr,
+      const std::vector<NDArray*>& inputs,
+      const std::vector<NDArray*>& outputs);
+  OpStatePtr BatchedForward(
+      const std::shared_ptr<CachedOp>& op_ptr,
+      const std::vector<NDArray*>& inputs,
+      const std::vector<NDArray*>& outputs);
+  void RunBatch(
+      const std::shared_ptr<CachedOp>& op_ptr,
+      std::unique_lock<std::mutex>* lock);
   bool SetForwardGraph(
       GraphInfo* info,
       const bool recording,
-      const std::vector<NDArray*>& inputs);
+      const std::vector<NDArray*>& inputs,
+      PlanCache* plan_cache = nullptr);
   bool SetBackwardGraph(
       GraphInfo* info,
       const std::vector<OpReqType>& reqs,
@@ -218,6 +289,11 @@ class CachedOp {
 
   std::mutex mutex_;
   std::unordered_map<Context, std::vector<OpStatePtr> > cached_op_states_;
+
+  std::mutex batch_mutex_;
+  std::condition_variable batch_cv_;
+  std::vector<BatchRequest*> batch_queue_;
+  std::string batch_signature_;
 };
 
 using CachedOpPtr = std::shared_ptr<CachedOp>;
@@ -226,8 +226,35 @@ void Imperative::RecordOp(
   if (p_save_inputs == nullptr) {
     p_save_inputs = &(local_buff->save_inputs);
     p_save_outputs = &(local_buff->save_outputs);
-    GetBackwardDependency(
-        node, inputs.size(), outputs.size(), p_save_inputs, p_save_outputs);
+    // Which inputs/outputs the backward pass needs is a pure function of the
+    // op, its attributes and its arity, so the FGradient call and graph walk
+    // in GetBackwardDependency can be memoized instead of re-run per call.
+    static const bool dep_cache_enabled =
+        dmlc::GetEnv("MXNET_IMPERATIVE_BACKWARD_DEP_CACHE", false);
+    using BackwardDepCache =
+        std::unordered_map<std::string, std::pair<std::vector<bool>, std::vector<bool> > >;
+    if (dep_cache_enabled && node->attrs.subgraphs.empty()) {
+      std::ostringstream sig;
+      sig << node->op()->name << ';' << inputs.size() << ';' << outputs.size();
+      for (const auto& kv : node->attrs.dict) {
+        sig << ';' << kv.first << '=' << kv.second;
+      }
+      BackwardDepCache* dep_cache = dmlc::ThreadLocalStore<BackwardDepCache>::Get();
+      auto it = dep_cache->find(sig.str());
+      if (it != dep_cache->end()) {
+        *p_save_inputs = it->second.first;
+        *p_save_outputs = it->second.second;
+        node->inputs.resize(inputs.size());
+      } else {
+        GetBackwardDependency(
+            node, inputs.size(), outputs.size(), p_save_inputs, p_save_outputs);
+        if (dep_cache->size() >= 4096) dep_cache->clear();
+        (*dep_cache)[sig.str()] = std::make_pair(*p_save_inputs, *p_save_outputs);
+      }
+    } else {
+      GetBackwardDependency(
+          node, inputs.size(), outputs.size(), p_save_inputs, p_save_outputs);
+    }
   } else {
     node->inputs.resize(inputs.size());
   }
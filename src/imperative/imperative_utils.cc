@@ -23,46 +23,49 @@
 
 namespace {
 
-std::vector<NDArray*> NodeInputs(const nnvm::IndexedGraph& idx,
-                                 const int node_idx,
-                                 const std::vector<NDArray*>& arrays) {
+// The fill helpers below reuse caller-provided vectors so the per-node
+// loops of RunGraph do not pay a heap allocation per operator: after the
+// first few nodes the capacity of the hoisted vectors covers every arity
+// in the graph.
+void NodeInputs(const nnvm::IndexedGraph& idx,
+                const int node_idx,
+                const std::vector<NDArray*>& arrays,
+                std::vector<NDArray*>* ndinputs) {
   const nnvm::IndexedGraph::Node& node = idx[node_idx];
-  const size_t num_inputs = node.inputs.size();
-  std::vector<NDArray*> ndinputs;
-  ndinputs.reserve(num_inputs);
+  ndinputs->clear();
+  ndinputs->reserve(node.inputs.size());
   for (const auto& j : node.inputs) {
     const size_t eid = idx.entry_id(j);
-    ndinputs.emplace_back(arrays[eid]);
+    ndinputs->emplace_back(arrays[eid]);
   }
-  return ndinputs;
 }
 
-std::vector<NDArray*> NodeOutputs(const nnvm::IndexedGraph& idx,
-                                  const int node_idx,
-                                  const std::vector<NDArray*>& arrays) {
+void NodeOutputs(const nnvm::IndexedGraph& idx,
+                 const int node_idx,
+                 const std::vector<NDArray*>& arrays,
+                 std::vector<NDArray*>* ndoutputs) {
   const nnvm::IndexedGraph::Node& node = idx[node_idx];
   const size_t num_outputs = node.source->num_outputs();
-  std::vector<NDArray*> ndoutputs;
-  ndoutputs.reserve(num_outputs);
+  ndoutputs->clear();
+  ndoutputs->reserve(num_outputs);
   for (size_t j = 0; j < num_outputs; ++j) {
     const size_t eid = idx.entry_id(node_idx, j);
-    ndoutputs.emplace_back(arrays[eid]);
+    ndoutputs->emplace_back(arrays[eid]);
   }
-  return ndoutputs;
 }
 
-std::vector<OpReqType> NodeReq(const nnvm::IndexedGraph& idx,
-                               const int node_idx,
-                               const std::vector<OpReqType>& array_reqs) {
+void NodeReq(const nnvm::IndexedGraph& idx,
+             const int node_idx,
+             const std::vector<OpReqType>& array_reqs,
+             std::vector<OpReqType>* req) {
   const nnvm::IndexedGraph::Node& node = idx[node_idx];
   const size_t num_outputs = node.source->num_outputs();
-  std::vector<OpReqType> req;
-  req.reserve(num_outputs);
+  req->clear();
+  req->reserve(num_outputs);
   for (size_t j = 0; j < num_outputs; ++j) {
     const size_t eid = idx.entry_id(node_idx, j);
-    req.push_back(array_reqs[eid]);
+    req->push_back(array_reqs[eid]);
   }
-  return req;
 }
 
 void InvokeOperator(const nnvm::IndexedGraph& idx,
@@ -141,14 +144,16 @@ void RunGraph(
     const imperative::CachedOpMonCallback& callback,
     const bool monitor_all) {
   CHECK(shapes == nullptr);
+  std::vector<NDArray*> ndinputs, ndoutputs;
+  std::vector<OpReqType> req;
   for (size_t i = node_start; i < node_end; ++i) {
     const nnvm::IndexedGraph::Node& node = idx[i];
     if (node.source->op() == nullptr) {
       continue;
     }
-    std::vector<NDArray*> ndinputs = NodeInputs(idx, i, arrays);
-    std::vector<NDArray*> ndoutputs = NodeOutputs(idx, i, arrays);
-    std::vector<OpReqType> req = NodeReq(idx, i, array_reqs);
+    NodeInputs(idx, i, arrays, &ndinputs);
+    NodeOutputs(idx, i, arrays, &ndoutputs);
+    NodeReq(idx, i, array_reqs, &req);
     Context ctx = ndoutputs[0]->ctx();
     if (callback && monitor_all) {
         mxnet::common::ExecuteMonInputCallback(idx, arrays, i, callback);
@@ -184,14 +189,16 @@ void NaiveRunGraph(
     mxnet::ShapeVector *shapes,
     const imperative::CachedOpMonCallback& callback,
     const bool monitor_all) {
+  std::vector<NDArray*> ndinputs, ndoutputs;
+  std::vector<OpReqType> req;
   for (size_t i = node_start; i < node_end; ++i) {
     const nnvm::IndexedGraph::Node& node = idx[i];
     if (node.source->op() == nullptr) {
       continue;
     }
-    std::vector<NDArray*> ndinputs = NodeInputs(idx, i, arrays);
-    std::vector<NDArray*> ndoutputs = NodeOutputs(idx, i, arrays);
-    std::vector<OpReqType> req;
+    NodeInputs(idx, i, arrays, &ndinputs);
+    NodeOutputs(idx, i, arrays, &ndoutputs);
+    req.clear();
     Context ctx = GetContext(node.source->attrs, ndinputs, ndoutputs, default_ctx);
     if (callback && monitor_all) {
         mxnet::common::ExecuteMonInputCallback(idx, arrays, i, callback);
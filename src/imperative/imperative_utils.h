@@ -22,14 +22,19 @@
 #include <nnvm/pass_functions.h>
 #include <utility>
 #include <algorithm>
+#include <mutex>
 #include <vector>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include "../executor/graph_executor.h"
 #include "../executor/exec_pass.h"
 #include "../c_api/c_api_common.h"
 #include "../common/utils.h"
 #include "../common/exec_utils.h"
+#include "../common/cuda_utils.h"
+#include "../common/small_vector.h"
 #include "../operator/nn/mkldnn/mkldnn_base-inl.h"
 #include "../operator/operator_common.h"
 
@@ -61,6 +66,25 @@ struct EngineOprSeg {
 using MemoryPlanVector = std::vector<MemoryPlanInfo>;
 using CachedOpMonCallback = std::function<void(const char*, const char*, void*)>;
 
+/*!
+ * \brief the display name the engine operator of a node is pushed under.
+ *  By default this is the op type; when MXNET_PROFILE_NODE_NAMES is set and
+ *  the node has a name (e.g. when executing a CachedOp graph), the profiler
+ *  ranges are named "op_type::node_name" instead, so they map back to graph
+ *  nodes. Names are interned because the engine keeps the raw pointer.
+ */
+inline const char* ProfileNodeName(const nnvm::Op* op, const nnvm::NodeAttrs& attrs) {
+  static const bool profile_node_names =
+      dmlc::GetEnv("MXNET_PROFILE_NODE_NAMES", false);
+  if (!profile_node_names || attrs.name.empty()) {
+    return op->name.c_str();
+  }
+  static std::mutex mutex;
+  static std::unordered_set<std::string> names;
+  std::lock_guard<std::mutex> lock(mutex);
+  return names.insert(op->name + "::" + attrs.name).first->c_str();
+}
+
 inline Context GetContext(const nnvm::NodeAttrs& attrs,
                 const std::vector<NDArray*>& inputs,
                 const std::vector<NDArray*>& outputs,
@@ -96,6 +120,15 @@ inline Context GetContext(const nnvm::NodeAttrs& attrs,
   return ctx;
 }
 
+// Cached result of attribute inference for one imperative dispatch signature
+struct DispatchInferCacheEntry {
+  mxnet::ShapeVector out_shapes;
+  std::vector<int> out_types;
+  std::vector<int> out_storage_types;
+  DispatchMode dispatch_mode;
+};
+using DispatchInferCache = std::unordered_map<std::string, DispatchInferCacheEntry>;
+
 // Set the shape, dtype, storage type and dispatch mode via the attribute inference functions
 inline void SetShapeType(const Context& ctx,
                          const nnvm::NodeAttrs& attrs,
@@ -113,6 +146,69 @@ inline void SetShapeType(const Context& ctx,
   for (auto& i : inputs) {
     in_shapes.push_back(i->shape());
   }
+  // Repeated imperative calls mostly dispatch the same op on the same input
+  // descriptors; remember the inference results per thread so a returning
+  // signature skips the shape/type/storage inference functions entirely.
+  static const bool dispatch_cache_enabled =
+      dmlc::GetEnv("MXNET_IMPERATIVE_DISPATCH_CACHE", false);
+  std::string signature;
+  DispatchInferCache* dispatch_cache = nullptr;
+  if (dispatch_cache_enabled && infershape.count(attrs.op) && attrs.subgraphs.empty()) {
+    std::ostringstream sig;
+    sig << attrs.op->name << ';' << Imperative::Get()->is_np_shape() << ';' << ctx;
+    for (const auto& kv : attrs.dict) {
+      sig << ';' << kv.first << '=' << kv.second;
+    }
+    for (auto& i : inputs) {
+      sig << '|' << i->shape() << ',' << i->dtype() << ',' << i->storage_type();
+    }
+    for (auto& i : outputs) {
+      sig << '#';
+      if (!i->is_none()) {
+        sig << i->shape() << ',' << i->dtype() << ',' << i->storage_type();
+      }
+    }
+    signature = sig.str();
+    dispatch_cache = dmlc::ThreadLocalStore<DispatchInferCache>::Get();
+    auto it = dispatch_cache->find(signature);
+    if (it != dispatch_cache->end()) {
+      const DispatchInferCacheEntry& entry = it->second;
+      *dispatch_mode = entry.dispatch_mode;
+      // stateful op creation reads the input descriptors back from the
+      // thread-local buffers, so refresh them even though inference is skipped
+      if (!Imperative::Get()->is_np_shape()) {
+        common::ConvertToNumpyShape(&in_shapes);
+      }
+      std::vector<int>& arg_types = ret->arg_types;
+      arg_types.clear();
+      arg_types.reserve(inputs.size());
+      for (auto& i : inputs) {
+        arg_types.push_back(i->dtype());
+      }
+      for (size_t i = 0; i < outputs.size(); ++i) {
+        NDArrayStorageType storage_type =
+            static_cast<NDArrayStorageType>(entry.out_storage_types[i]);
+        if (outputs[i]->is_none() || mxnet::op::shape_is_none(outputs[i]->shape())) {
+          if (storage_type == kDefaultStorage) {
+            *outputs[i] = NDArray(entry.out_shapes[i], ctx, true, entry.out_types[i]);
+          } else {
+            *outputs[i] = NDArray(storage_type, entry.out_shapes[i], ctx, true,
+                                  entry.out_types[i]);
+          }
+        } else {
+          CHECK_EQ(outputs[i]->shape(), entry.out_shapes[i])
+            << i << "-th output has invalid shape. "
+            << "Expecting " << entry.out_shapes[i] << " got "
+            << outputs[i]->shape() << " in operator " << attrs.op->name;
+          CHECK_EQ(outputs[i]->dtype(), entry.out_types[i])
+            << i << "-th output has invalid shape. "
+            << "Expecting " << entry.out_types[i] << " got "
+            << outputs[i]->dtype()  << " in operator " << attrs.op->name;
+        }
+      }
+      return;
+    }
+  }
   mxnet::ShapeVector& out_shapes = ret->out_shapes;
   out_shapes.clear();
   out_shapes.reserve(outputs.size());
@@ -200,6 +296,16 @@ inline void SetShapeType(const Context& ctx,
   CHECK_EQ(out_storage_types.size(), outputs.size());
   CHECK(*dispatch_mode != DispatchMode::kUndefined);
 
+  if (dispatch_cache != nullptr && !is_dynamic_shape_existing) {
+    // unordered eviction is fine; the cache only saves recomputation
+    if (dispatch_cache->size() >= 4096) dispatch_cache->clear();
+    DispatchInferCacheEntry& entry = (*dispatch_cache)[signature];
+    entry.out_shapes = out_shapes;
+    entry.out_types = out_types;
+    entry.out_storage_types = out_storage_types;
+    entry.dispatch_mode = *dispatch_mode;
+  }
+
   for (size_t i = 0; i < outputs.size(); ++i) {
     NDArrayStorageType storage_type = static_cast<NDArrayStorageType>(out_storage_types[i]);
     if (outputs[i]->is_none() || mxnet::op::shape_is_none(outputs[i]->shape())) {
@@ -300,16 +406,17 @@ inline void SetDependency(const nnvm::NodeAttrs& attrs,
 inline void SetWriteInplaceReq(const std::vector<NDArray*>& inputs,
                         const std::vector<NDArray*>& outputs,
                         std::vector<OpReqType> *req) {
-  std::unordered_set<engine::VarHandle> in_vars;
-  in_vars.reserve(inputs.size());
+  // op arity is almost always single digits, so a linear scan over an
+  // inline-storage vector beats allocating a hash set per invoke
+  common::SmallVector<engine::VarHandle, 8> in_vars;
   for (auto &i : inputs) {
-    in_vars.insert(i->var());
+    in_vars.push_back(i->var());
   }
   req->clear();
   req->resize(outputs.size(), kWriteTo);
   for (size_t i = 0; i < outputs.size(); i++) {
     // output NDArray shares the memory with the input NDArray
-    if (in_vars.find(outputs[i]->var()) != in_vars.end()) {
+    if (std::find(in_vars.begin(), in_vars.end(), outputs[i]->var()) != in_vars.end()) {
       req->at(i) = kWriteInplace;
     }
   }
@@ -330,6 +437,43 @@ inline nnvm::NodeAttrs ParseAttrs(const nnvm::Op *op,
                                   const char **param_keys,
                                   const char **param_vals) {
   static auto& num_args = nnvm::Op::GetAttr<std::string>("key_var_num_args");
+  static const bool use_cache = dmlc::GetEnv("MXNET_IMPERATIVE_ATTR_CACHE", true);
+
+  if (use_cache && op->attr_parser != nullptr) {
+    // Scalar and other small imperative ops pay dmlc::Parameter::Init string
+    // parsing on every invoke. Identical raw param dicts hit this per-thread
+    // cache and reuse the parsed attrs instead.
+    thread_local std::unordered_map<std::string, nnvm::NodeAttrs> attr_cache;
+    std::string key;
+    key.reserve(64);
+    key += op->name;
+    for (int i = 0; i < num_params; ++i) {
+      key += '\n';
+      key += param_keys[i];
+      key += '\v';
+      key += param_vals[i];
+    }
+    if (num_args.count(op)) {
+      key += '\f';
+      key += std::to_string(num_inputs);
+    }
+    auto it = attr_cache.find(key);
+    if (it != attr_cache.end()) return it->second;
+    nnvm::NodeAttrs attrs;
+    attrs.op = op;
+    attrs.dict.reserve(num_params+1);
+    for (int i = 0; i < num_params; ++i) {
+      attrs.dict.emplace(param_keys[i], param_vals[i]);
+    }
+    if (num_args.count(op)) {
+      attrs.dict.emplace(num_args[op], std::to_string(num_inputs));
+    }
+    op->attr_parser(&attrs);
+    // e.g. a sweep of distinct scalar values; keep the cache bounded
+    if (attr_cache.size() >= 512) attr_cache.clear();
+    attr_cache.emplace(std::move(key), attrs);
+    return attrs;
+  }
 
   nnvm::NodeAttrs attrs;
   attrs.op = op;
@@ -446,7 +590,7 @@ inline void PushFCompute(const FCompute& fn,
         rctx.get_stream<gpu>()->Wait();
       }
     }, ctx, read_vars, write_vars, FnProperty::kNormal,
-    0, op->name.c_str());
+    0, ProfileNodeName(op, attrs));
 }
 
 inline void PushFComputeEx(const FComputeEx& fn,
@@ -499,7 +643,7 @@ inline void PushFComputeEx(const FComputeEx& fn,
   } else {
     CHECK(exec_type == ExecType::kSync);
     Engine::Get()->PushSync(run, ctx, read_vars, write_vars, FnProperty::kNormal,
-                            0, op->name.c_str());
+                            0, ProfileNodeName(op, attrs));
   }
 }
 
@@ -568,12 +712,12 @@ inline void PushOperator(const OpStatePtr& state,
       Engine::Get()->PushSync(
           [=](RunContext rctx) { run(rctx, engine::CallbackOnComplete()); },
           ctx, read_vars, write_vars, FnProperty::kNormal, 0,
-          op->name.c_str());
+          ProfileNodeName(op, attrs));
     } else {
       CHECK(exec_type == ExecType::kAsync);
       Engine::Get()->PushAsync(run, ctx, read_vars, write_vars,
                                FnProperty::kAsync, 0,
-                               op->name.c_str());
+                               ProfileNodeName(op, attrs));
     }
   } else {
     CHECK(fcompute != nullptr)
@@ -624,12 +768,12 @@ inline void PushOperator(const OpStatePtr& state,
           [=](RunContext rctx) {
             run(rctx, engine::CallbackOnComplete());
           }, ctx, read_vars, write_vars, FnProperty::kNormal,
-          0, op->name.c_str());
+          0, ProfileNodeName(op, attrs));
     } else {
       CHECK(exec_type == ExecType::kAsync);
       Engine::Get()->PushAsync(
           run, ctx, read_vars, write_vars, FnProperty::kAsync,
-          0, op->name.c_str());
+          0, ProfileNodeName(op, attrs));
     }
   }
 }
@@ -954,6 +1098,89 @@ inline void SetupOpExec(
   exec->Setup();
 }
 
+#if MXNET_USE_CUDA && CUDA_VERSION >= 10010
+/*!
+ * \brief Replays a bulked segment of synchronous GPU ops with a single
+ *        cudaGraphLaunch per step. The segment is run eagerly for a few
+ *        warmup iterations so that lazy initialization inside the ops
+ *        (cuDNN algo selection, temporary space allocation) settles, then
+ *        its launch sequence is captured from the stream into a CUDA graph.
+ *        The capture lives as long as the engine operator of the segment,
+ *        which CachedOp recreates whenever the static exec state is
+ *        reinitialized, so a shape change invalidates it naturally.
+ */
+class CudaGraphsExec {
+ public:
+  explicit CudaGraphsExec(const std::vector<std::shared_ptr<exec::OpExecutor> >& execs)
+    : execs_(execs) {}
+
+  ~CudaGraphsExec() {
+    if (graph_exec_ != nullptr) {
+      cudaGraphExecDestroy(graph_exec_);
+    }
+  }
+
+  void Run(const RunContext& rctx) {
+    cudaStream_t stream = mshadow::Stream<gpu>::GetStream(rctx.get_stream<gpu>());
+    if (graph_exec_ != nullptr) {
+      if (execs_[0]->op_ctx.is_train == captured_is_train_) {
+        CUDA_CALL(cudaGraphLaunch(graph_exec_, stream));
+        return;
+      }
+      // is_train is baked into the captured kernels, recapture
+      CUDA_CALL(cudaGraphExecDestroy(graph_exec_));
+      graph_exec_ = nullptr;
+    }
+    if (disabled_ || ++run_count_ <= kWarmupRuns || !CaptureAndLaunch(rctx, stream)) {
+      for (const auto& exec : execs_) exec->Run(rctx, true);
+    }
+  }
+
+ private:
+  /*! \brief Capture the segment into a CUDA graph and launch it once so
+   *         this step still produces its outputs. Returns false and leaves
+   *         the stream in normal mode when the segment is not capturable.
+   */
+  bool CaptureAndLaunch(const RunContext& rctx, cudaStream_t stream) {
+    if (cudaStreamBeginCapture(stream, cudaStreamCaptureModeThreadLocal) != cudaSuccess) {
+      disabled_ = true;
+      return false;
+    }
+    for (const auto& exec : execs_) exec->Run(rctx, true);
+    cudaGraph_t graph;
+    if (cudaStreamEndCapture(stream, &graph) != cudaSuccess) {
+      LOG(WARNING) << "Could not capture a CUDA graph of the op segment, "
+                   << "falling back to eager kernel launches. "
+                   << "Set MXNET_ENABLE_CUDA_GRAPHS=0 to silence this warning.";
+      disabled_ = true;
+      return false;
+    }
+    const cudaError_t status = cudaGraphInstantiate(&graph_exec_, graph, nullptr, nullptr, 0);
+    CUDA_CALL(cudaGraphDestroy(graph));
+    if (status != cudaSuccess) {
+      graph_exec_ = nullptr;
+      disabled_ = true;
+      return false;
+    }
+    captured_is_train_ = execs_[0]->op_ctx.is_train;
+    if (dmlc::GetEnv("MXNET_CUDA_GRAPHS_VERBOSE", false)) {
+      LOG(INFO) << "Replaying a segment of " << execs_.size()
+                << " ops with a CUDA graph";
+    }
+    CUDA_CALL(cudaGraphLaunch(graph_exec_, stream));
+    return true;
+  }
+
+  static const int kWarmupRuns = 2;
+
+  std::vector<std::shared_ptr<exec::OpExecutor> > execs_;
+  cudaGraphExec_t graph_exec_{nullptr};
+  bool captured_is_train_{false};
+  bool disabled_{false};
+  int run_count_{0};
+};
+#endif  // MXNET_USE_CUDA && CUDA_VERSION >= 10010
+
 inline Engine::OprHandle CreateEngineOp(
     const Context& default_ctx,
     const std::vector<std::shared_ptr<exec::OpExecutor> >& execs) {
@@ -984,6 +1211,23 @@ inline Engine::OprHandle CreateEngineOp(
   bool is_gpu = default_ctx.dev_mask() == gpu::kDevMask;
   bool is_async = execs.size() > 1 ? false : execs[0]->exec_type() == ExecType::kAsync;
 
+#if MXNET_USE_CUDA && CUDA_VERSION >= 10010
+  static const bool use_cuda_graphs = dmlc::GetEnv("MXNET_ENABLE_CUDA_GRAPHS", false);
+  if (use_cuda_graphs && is_gpu && !is_async &&
+      execs[0]->exec_type() == ExecType::kSync) {
+    auto graphs_exec = std::make_shared<CudaGraphsExec>(execs);
+    auto graphs_fun = [graphs_exec] (
+        RunContext ctx, Engine::CallbackOnComplete on_complete) {
+      graphs_exec->Run(ctx);
+      // Wait GPU kernel to finish.
+      ctx.get_stream<gpu>()->Wait();
+      on_complete();
+    };
+    return Engine::Get()->NewOperator(
+        graphs_fun, use_vars, mutate_vars, FnProperty::kNormal);
+  }
+#endif  // MXNET_USE_CUDA && CUDA_VERSION >= 10010
+
   auto exec_fun = [execs, is_async, is_gpu] (
       RunContext ctx, Engine::CallbackOnComplete on_complete) {
     if (is_async) {
@@ -1016,7 +1260,8 @@ inline void CreateEngineOpSeg(
     const size_t bulk_size,
     const std::vector<std::shared_ptr<exec::OpExecutor> >& execs,
     const std::vector<int> skip_plus_node,
-    std::vector<EngineOprSeg> *opr_segs) {
+    std::vector<EngineOprSeg> *opr_segs,
+    const std::unordered_set<size_t>* boundary_nids = nullptr) {
   size_t seg_start = start_nid;
   std::vector<std::shared_ptr<exec::OpExecutor> > seg_execs;
   for (size_t nid = start_nid; nid < end_nid; ++nid) {
@@ -1027,8 +1272,10 @@ inline void CreateEngineOpSeg(
     bool is_async = exec->exec_type() != ExecType::kSync;
     bool valid = exec->out_array.size() > 0;
 
-    // Stop at async nodes and invalid node (due to input/output is not allocated)
-    bool stop = is_async || !valid || seg_execs.size() >= bulk_size;
+    // Stop at async nodes, invalid nodes (due to input/output is not allocated)
+    // and explicitly requested segment boundaries
+    bool stop = is_async || !valid || seg_execs.size() >= bulk_size ||
+                (boundary_nids != nullptr && boundary_nids->count(nid));
 
     // Create opr segment for previous nodes.
     if (stop && nid > seg_start) {
@@ -26,6 +26,7 @@
 #include <signal.h>
 #include <dmlc/logging.h>
 #include <mxnet/engine.h>
+#include <mxnet/libinfo.h>
 #include "./engine/openmp.h"
 #include "./operator/custom/custom-inl.h"
 #if MXNET_USE_OPENCV
@@ -95,6 +96,7 @@ LibraryInitializer::LibraryInitializer()
   engine::OpenMP::Get();   // force OpenMP initialization
   install_signal_handlers();
   install_pthread_atfork_handlers();
+  features::check_host_cpu_features();
 }
 
 LibraryInitializer::~LibraryInitializer() {
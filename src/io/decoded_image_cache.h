@@ -0,0 +1,108 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file decoded_image_cache.h
+ * \brief byte-bounded LRU cache of decoded images, keyed by record id
+ */
+#ifndef MXNET_IO_DECODED_IMAGE_CACHE_H_
+#define MXNET_IO_DECODED_IMAGE_CACHE_H_
+
+#if MXNET_USE_OPENCV
+
+#include <opencv2/opencv.hpp>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace mxnet {
+namespace io {
+
+/*!
+ * \brief Keeps decoded images across epochs so repeat passes over the hot
+ *  part of a dataset skip JPEG decode. Bounded in bytes with LRU eviction;
+ *  safe to share between the parser's preprocessing threads. Lookups hand
+ *  out a private copy of the pixels since augmentation downstream may write
+ *  into the image in place.
+ */
+class DecodedImageCache {
+ public:
+  explicit DecodedImageCache(size_t capacity_bytes)
+      : capacity_bytes_(capacity_bytes) {}
+
+  /*!
+   * \brief copy of the cached image of a record, or an empty cv::Mat
+   *  when the record is not cached
+   */
+  cv::Mat Get(size_t record_id) {
+    cv::Mat img;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = cache_.find(record_id);
+      if (it == cache_.end()) return cv::Mat();
+      lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+      // cv::Mat headers share pixels with an atomic refcount, so the clone
+      // can happen outside the lock even if the entry is evicted meanwhile
+      img = it->second.img;
+    }
+    return img.clone();
+  }
+
+  /*! \brief cache the image of a record, evicting least recently used entries */
+  void Put(size_t record_id, const cv::Mat& img) {
+    const size_t nbytes = img.total() * img.elemSize();
+    if (nbytes == 0 || nbytes > capacity_bytes_) return;
+    cv::Mat copy = img.clone();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cache_.find(record_id) != cache_.end()) return;
+    while (used_bytes_ + nbytes > capacity_bytes_) {
+      auto victim = cache_.find(lru_.back());
+      used_bytes_ -= victim->second.bytes;
+      cache_.erase(victim);
+      lru_.pop_back();
+    }
+    lru_.push_front(record_id);
+    cache_[record_id] = Entry{std::move(copy), nbytes, lru_.begin()};
+    used_bytes_ += nbytes;
+  }
+
+ private:
+  struct Entry {
+    cv::Mat img;
+    size_t bytes;
+    std::list<size_t>::iterator lru_it;
+  };
+  /*! \brief protects the map, the list and the byte counter */
+  std::mutex mutex_;
+  /*! \brief record ids, most recently used first */
+  std::list<size_t> lru_;
+  /*! \brief cached entries by record id */
+  std::unordered_map<size_t, Entry> cache_;
+  /*! \brief capacity and current size in bytes of cached pixels */
+  size_t capacity_bytes_;
+  size_t used_bytes_{0};
+};  // class DecodedImageCache
+
+}  // namespace io
+}  // namespace mxnet
+
+#endif  // MXNET_USE_OPENCV
+#endif  // MXNET_IO_DECODED_IMAGE_CACHE_H_
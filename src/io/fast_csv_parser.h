@@ -0,0 +1,277 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file fast_csv_parser.h
+ * \brief block-wise CSV parsing with SIMD line scanning and parallel row parse
+ */
+#ifndef MXNET_IO_FAST_CSV_PARSER_H_
+#define MXNET_IO_FAST_CSV_PARSER_H_
+
+#include <dmlc/logging.h>
+#include <dmlc/omp.h>
+#include <dmlc/common.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mxnet {
+namespace io {
+
+/*!
+ * \brief find the offsets of all newline characters in a buffer,
+ *  32 or 16 bytes at a time when AVX2 or SSE2 is available
+ */
+inline int CSVTrailingZeros(uint32_t x) {
+#if defined(_MSC_VER)
+  unsigned long idx;  // NOLINT(*)
+  _BitScanForward(&idx, x);
+  return static_cast<int>(idx);
+#else
+  return __builtin_ctz(x);
+#endif
+}
+
+inline void FindNewlines(const char* data, size_t size, std::vector<size_t>* out) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  const __m256i nl = _mm256_set1_epi8('\n');
+  for (; i + 32 <= size; i += 32) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, nl));
+    while (mask != 0) {
+      out->push_back(i + CSVTrailingZeros(mask));
+      mask &= mask - 1;
+    }
+  }
+#elif defined(__SSE2__)
+  const __m128i nl = _mm_set1_epi8('\n');
+  for (; i + 16 <= size; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    uint32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, nl));
+    while (mask != 0) {
+      out->push_back(i + CSVTrailingZeros(mask));
+      mask &= mask - 1;
+    }
+  }
+#endif
+  for (; i < size; ++i) {
+    if (data[i] == '\n') out->push_back(i);
+  }
+}
+
+/*!
+ * \brief Reads a local CSV file of fixed-width numeric rows block by block.
+ *  Each block is split into lines with a SIMD newline scan and the lines are
+ *  parsed into a dense row buffer in parallel; the common digits-and-dot
+ *  number format takes a near branch-free path and anything else (exponents,
+ *  inf/nan, overlong mantissas) falls back to strtod.
+ */
+template <typename DType>
+class FastCSVChunkReader {
+ public:
+  FastCSVChunkReader(const std::string& path, size_t row_len)
+      : path_(path), row_len_(row_len) {
+    CHECK_GT(row_len_, 0U);
+    fin_.open(path.c_str(), std::ios::binary);
+    CHECK(fin_.is_open()) << "FastCSVChunkReader: cannot open " << path;
+  }
+
+  void BeforeFirst() {
+    fin_.clear();
+    fin_.seekg(0);
+    carry_.clear();
+    rows_ = 0;
+    row_ptr_ = 0;
+  }
+
+  /*!
+   * \brief next parsed row, or nullptr at the end of the file;
+   *  the pointer stays valid until the next block is parsed
+   */
+  const DType* NextRow() {
+    while (row_ptr_ >= rows_) {
+      if (!FillBlock()) return nullptr;
+    }
+    return buf_.data() + (row_ptr_++) * row_len_;
+  }
+
+ private:
+  static const size_t kBlockSize = 32 << 20;
+
+  bool FillBlock() {
+    block_.swap(carry_);
+    carry_.clear();
+    const size_t old_size = block_.size();
+    block_.resize(old_size + kBlockSize);
+    fin_.read(block_.data() + old_size, kBlockSize);
+    block_.resize(old_size + static_cast<size_t>(fin_.gcount()));
+    const bool at_eof = static_cast<size_t>(fin_.gcount()) < kBlockSize;
+    if (block_.empty()) return false;
+
+    newlines_.clear();
+    FindNewlines(block_.data(), block_.size(), &newlines_);
+    size_t parse_end = block_.size();
+    if (!at_eof) {
+      if (newlines_.empty()) {
+        // no complete line in this block, read more next round
+        carry_.swap(block_);
+        rows_ = row_ptr_ = 0;
+        return true;
+      }
+      // the unterminated tail belongs to the next block
+      parse_end = newlines_.back() + 1;
+      carry_.assign(block_.begin() + parse_end, block_.end());
+    }
+
+    // line ranges, skipping empty lines; a missing final newline at the end
+    // of the file still yields a row
+    lines_.clear();
+    size_t begin = 0;
+    for (size_t nl : newlines_) {
+      if (nl > begin) lines_.emplace_back(begin, nl);
+      begin = nl + 1;
+    }
+    if (at_eof && parse_end > begin) lines_.emplace_back(begin, parse_end);
+
+    rows_ = lines_.size();
+    row_ptr_ = 0;
+    buf_.resize(rows_ * row_len_);
+    #pragma omp parallel for
+    for (int i = 0; i < static_cast<int>(rows_); ++i) {
+      omp_exc_.Run([&] {
+        const char* p = block_.data() + lines_[i].first;
+        const char* end = block_.data() + lines_[i].second;
+        if (end > p && end[-1] == '\r') --end;
+        ParseLine(p, end, buf_.data() + static_cast<size_t>(i) * row_len_);
+      });
+    }
+    omp_exc_.Rethrow();
+    return true;
+  }
+
+  void ParseLine(const char* p, const char* end, DType* out) const {
+    size_t col = 0;
+    while (true) {
+      const char* comma =
+          static_cast<const char*>(memchr(p, ',', end - p));
+      const char* field_end = comma != nullptr ? comma : end;
+      CHECK_LT(col, row_len_)
+          << "The data size in CSV do not match size of shape: "
+          << "csv row of " << path_ << " has extra columns";
+      out[col++] = ParseValue(p, field_end);
+      if (comma == nullptr) break;
+      p = comma + 1;
+    }
+    CHECK_EQ(col, row_len_)
+        << "The data size in CSV do not match size of shape: "
+        << "expected " << row_len_ << " columns in " << path_
+        << ", the csv row has " << col;
+  }
+
+  static DType ParseValue(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) ++p;
+    while (end > p && (end[-1] == ' ' || end[-1] == '\t')) --end;
+    const char* begin = p;
+    bool neg = false;
+    if (p < end && (*p == '+' || *p == '-')) {
+      neg = (*p == '-');
+      ++p;
+    }
+    uint64_t mant = 0;
+    int digits = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+      mant = mant * 10 + static_cast<uint64_t>(*p - '0');
+      ++digits;
+      ++p;
+    }
+    int frac = 0;
+    if (!std::is_integral<DType>::value && p < end && *p == '.') {
+      ++p;
+      while (p < end && *p >= '0' && *p <= '9') {
+        mant = mant * 10 + static_cast<uint64_t>(*p - '0');
+        ++digits;
+        ++frac;
+        ++p;
+      }
+    }
+    if (p != end || digits == 0 || digits > 18) {
+      // exponents, inf/nan, overlong mantissas: let the libc parser decide
+      return SlowParse(begin, end);
+    }
+    if (std::is_integral<DType>::value) {
+      const int64_t v = static_cast<int64_t>(mant);
+      return static_cast<DType>(neg ? -v : v);
+    }
+    const double v = static_cast<double>(mant) * kNegPow10(frac);
+    return static_cast<DType>(neg ? -v : v);
+  }
+
+  static DType SlowParse(const char* p, const char* end) {
+    char tmp[64];
+    const size_t n = std::min(static_cast<size_t>(end - p), sizeof(tmp) - 1);
+    memcpy(tmp, p, n);
+    tmp[n] = '\0';
+    return static_cast<DType>(strtod(tmp, nullptr));
+  }
+
+  static double kNegPow10(int i) {
+    static const double tbl[19] = {
+        1e0,  1e-1, 1e-2,  1e-3,  1e-4,  1e-5,  1e-6,  1e-7,  1e-8, 1e-9,
+        1e-10, 1e-11, 1e-12, 1e-13, 1e-14, 1e-15, 1e-16, 1e-17, 1e-18};
+    return tbl[i];
+  }
+
+  /*! \brief path of the file, for error messages */
+  std::string path_;
+  /*! \brief number of values per row */
+  size_t row_len_;
+  /*! \brief input stream over the file */
+  std::ifstream fin_;
+  /*! \brief current block being parsed */
+  std::vector<char> block_;
+  /*! \brief unterminated tail carried into the next block */
+  std::vector<char> carry_;
+  /*! \brief newline offsets within the block */
+  std::vector<size_t> newlines_;
+  /*! \brief (begin, end) of each line within the block */
+  std::vector<std::pair<size_t, size_t> > lines_;
+  /*! \brief parsed rows of the block */
+  std::vector<DType> buf_;
+  /*! \brief number of parsed rows in buf_ */
+  size_t rows_{0};
+  /*! \brief next row to serve */
+  size_t row_ptr_{0};
+  /*! \brief rethrows parse errors raised inside the omp region */
+  dmlc::OMPException omp_exc_;
+};  // class FastCSVChunkReader
+
+}  // namespace io
+}  // namespace mxnet
+
+#endif  // MXNET_IO_FAST_CSV_PARSER_H_
@@ -221,6 +221,7 @@ class DefaultImageAugmenter : public ImageAugmenter {
           }
         }
     }
+    fused_crop_resize_ = dmlc::GetEnv("MXNET_IMAGE_FUSED_CROP_RESIZE", false);
   }
   /*!
    * \brief get interpolation method with given inter_method, 0-CV_INTER_NN 1-CV_INTER_LINEAR 2-CV_INTER_CUBIC
@@ -243,6 +244,73 @@ class DefaultImageAugmenter : public ImageAugmenter {
       return inter_method;
     }
   }
+  /*!
+   * \brief fused shorter-edge resize + crop. The staged path resamples the
+   *  whole image to the resize target and then throws most of it away in the
+   *  crop; here the crop window drawn in resized coordinates is mapped back
+   *  onto the source image and only the surviving pixels go through a single
+   *  cv::resize straight to data_shape. Returns false whenever an augmentation
+   *  that has to observe the intermediate resized image is requested, in which
+   *  case the caller runs the staged path unchanged.
+   */
+  bool FusedCropResize(const cv::Mat &src, float min_aspect_ratio,
+                       float max_aspect_ratio, common::RANDOM_ENGINE *prnd,
+                       cv::Mat *out) {
+    using mshadow::index_t;
+    if (param_.resize == -1 || param_.random_resized_crop) return false;
+    if (param_.max_rotate_angle > 0 || param_.max_shear_ratio > 0.0f
+        || param_.rotate > 0 || rotate_list_.size() > 0
+        || param_.max_random_scale != 1.0f || param_.min_random_scale != 1.0f
+        || min_aspect_ratio != 1.0f || max_aspect_ratio != 1.0f
+        || param_.max_img_size != 1e10f || param_.min_img_size != 0.0f) {
+      return false;
+    }
+    if (param_.pad > 0
+        || param_.max_crop_size != -1 || param_.min_crop_size != -1) {
+      return false;
+    }
+    int new_height, new_width;
+    if (src.rows > src.cols) {
+      new_height = param_.resize*src.rows/src.cols;
+      new_width = param_.resize;
+    } else {
+      new_height = param_.resize;
+      new_width = param_.resize*src.cols/src.rows;
+    }
+    if (new_height < static_cast<int>(param_.data_shape[1]) ||
+        new_width < static_cast<int>(param_.data_shape[2])) {
+      return false;
+    }
+    CHECK((param_.inter_method >= 0 && param_.inter_method <= 4) ||
+     (param_.inter_method >= 9 && param_.inter_method <= 10))
+      << "invalid inter_method: valid value 0,1,2,3,9,10";
+    // crop offset is drawn in resized coordinates, exactly as the staged path
+    index_t y = new_height - param_.data_shape[1];
+    index_t x = new_width - param_.data_shape[2];
+    if (param_.rand_crop != 0) {
+      y = std::uniform_int_distribution<index_t>(0, y)(*prnd);
+      x = std::uniform_int_distribution<index_t>(0, x)(*prnd);
+    } else {
+      y /= 2; x /= 2;
+    }
+    const float to_src_x = static_cast<float>(src.cols) / new_width;
+    const float to_src_y = static_cast<float>(src.rows) / new_height;
+    int sx = static_cast<int>(x * to_src_x);
+    int sy = static_cast<int>(y * to_src_y);
+    int sw = std::max(1, static_cast<int>(std::round(param_.data_shape[2] * to_src_x)));
+    int sh = std::max(1, static_cast<int>(std::round(param_.data_shape[1] * to_src_y)));
+    sx = std::min(sx, src.cols - 1);
+    sy = std::min(sy, src.rows - 1);
+    sw = std::min(sw, src.cols - sx);
+    sh = std::min(sh, src.rows - sy);
+    cv::Rect roi(sx, sy, sw, sh);
+    int interpolation_method = GetInterMethod(param_.inter_method, sw, sh,
+                                              param_.data_shape[2],
+                                              param_.data_shape[1], prnd);
+    cv::resize(src(roi), *out, cv::Size(param_.data_shape[2], param_.data_shape[1]),
+               0, 0, interpolation_method);
+    return true;
+  }
   cv::Mat Process(const cv::Mat &src, std::vector<float> *label,
                   common::RANDOM_ENGINE *prnd) override {
     using mshadow::index_t;
@@ -259,7 +327,10 @@ class DefaultImageAugmenter : public ImageAugmenter {
     }
 
     cv::Mat res;
-    if (param_.resize != -1) {
+    if (fused_crop_resize_ &&
+        FusedCropResize(src, min_aspect_ratio, max_aspect_ratio, prnd, &res)) {
+      is_cropped = true;
+    } else if (param_.resize != -1) {
       int new_height, new_width;
       if (src.rows > src.cols) {
         new_height = param_.resize*src.rows/src.cols;
@@ -549,6 +620,8 @@ class DefaultImageAugmenter : public ImageAugmenter {
   DefaultImageAugmentParam param_;
   /*! \brief list of possible rotate angle */
   std::vector<int> rotate_list_;
+  /*! \brief whether the fused resize+crop fast path may be taken */
+  bool fused_crop_resize_{false};
 };
 
 ImageAugmenter* ImageAugmenter::Create(const std::string& name) {
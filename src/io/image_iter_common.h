@@ -353,6 +353,9 @@ struct PrefetcherParam : public dmlc::Parameter<PrefetcherParam> {
   /*! \brief Context data loader optimized for */
   int ctx;
 
+  /*! \brief device the batches are copied to ahead of time, if any */
+  dmlc::optional<int> prefetch_device;
+
   /*! \brief data type */
   dmlc::optional<int> dtype;
 
@@ -364,6 +367,11 @@ struct PrefetcherParam : public dmlc::Parameter<PrefetcherParam> {
         .add_enum("cpu", kCPU)
         .add_enum("gpu", kGPU)
         .describe("Context data loader optimized for.");
+    DMLC_DECLARE_FIELD(prefetch_device)
+      .set_default(dmlc::optional<int>())
+      .describe("If set, prefetched batches are staged through pinned memory "
+                "and copied asynchronously to this GPU, so Next() returns "
+                "device-resident arrays and the copy overlaps compute.");
     DMLC_DECLARE_FIELD(dtype)
       .add_enum("float32", mshadow::kFloat32)
       .add_enum("float64", mshadow::kFloat64)
@@ -23,6 +23,7 @@
 #include <dmlc/registry.h>
 #include "./image_augmenter.h"
 #include "./image_iter_common.h"
+#include "./iter_bucket_batchloader.h"
 
 // Registers
 namespace dmlc {
@@ -33,6 +34,7 @@ namespace mxnet {
 namespace io {
 // Register parameters in header files
 DMLC_REGISTER_PARAMETER(BatchParam);
+DMLC_REGISTER_PARAMETER(BucketBatchParam);
 DMLC_REGISTER_PARAMETER(PrefetcherParam);
 DMLC_REGISTER_PARAMETER(ImageNormalizeParam);
 DMLC_REGISTER_PARAMETER(ImageRecParserParam);
@@ -0,0 +1,268 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file iter_bucket_batchloader.h
+ * \brief batch adapter that groups variable-length instances into buckets
+ */
+#ifndef MXNET_IO_ITER_BUCKET_BATCHLOADER_H_
+#define MXNET_IO_ITER_BUCKET_BATCHLOADER_H_
+
+#include <mxnet/io.h>
+#include <mxnet/base.h>
+#include <dmlc/logging.h>
+#include <mshadow/tensor.h>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include <string>
+#include "./inst_vector.h"
+#include "./image_iter_common.h"
+
+namespace mxnet {
+namespace io {
+
+/*! \brief bucketing parameters */
+struct BucketBatchParam : public dmlc::Parameter<BucketBatchParam> {
+  /*! \brief ascending bucket lengths */
+  mxnet::Tuple<int> buckets;
+  /*! \brief maximum number of buffered instances before a partial bucket is emitted */
+  int bucket_max_pending;
+  // declare parameters
+  DMLC_DECLARE_PARAMETER(BucketBatchParam) {
+    DMLC_DECLARE_FIELD(buckets)
+        .describe("Ascending list of bucket lengths. Each instance goes to the "
+                  "smallest bucket whose length covers the leading dimension "
+                  "of its data and is padded with zeros up to that length.");
+    DMLC_DECLARE_FIELD(bucket_max_pending).set_default(0)
+        .describe("Maximum number of instances buffered across partial buckets "
+                  "before the fullest bucket is emitted padded. 0 means "
+                  "batch_size times the number of buckets.");
+  }
+};
+
+/*!
+ * \brief Creates fixed bucket-length batches from a variable-length instance
+ *  iterator. Instances are grouped by the leading dimension of their data
+ *  blob into per-bucket batch buffers and padded with zeros to the bucket
+ *  length, so each batch only carries the padding of its own bucket instead
+ *  of the global maximum length. Full buckets are emitted preferentially;
+ *  a bucket is emitted partially filled (with num_batch_padd set) when the
+ *  buffered instances exceed bucket_max_pending or the source is exhausted,
+ *  which bounds how long an instance can be held back.
+ *  Blobs past the first (for example labels) must be of fixed size.
+ */
+class BucketBatchLoader : public IIterator<TBlobBatch> {
+ public:
+  explicit BucketBatchLoader(IIterator<DataInst> *base): base_(base) {
+  }
+
+  virtual ~BucketBatchLoader(void) {
+    delete base_;
+  }
+
+  inline void Init(const std::vector<std::pair<std::string, std::string> >& kwargs) {
+    batch_param_.InitAllowUnknown(kwargs);
+    param_.InitAllowUnknown(kwargs);
+    CHECK_GT(param_.buckets.ndim(), 0) << "buckets must not be empty";
+    for (int i = 0; i < param_.buckets.ndim(); ++i) {
+      CHECK_GT(param_.buckets[i], 0) << "bucket lengths must be positive";
+      CHECK(i == 0 || param_.buckets[i] > param_.buckets[i - 1])
+          << "buckets must be strictly ascending";
+    }
+    max_pending_ = param_.bucket_max_pending > 0
+        ? param_.bucket_max_pending
+        : batch_param_.batch_size * param_.buckets.ndim();
+    buckets_.resize(param_.buckets.ndim());
+    out_.inst_index = new unsigned[batch_param_.batch_size];
+    out_.batch_size = batch_param_.batch_size;
+    base_->Init(kwargs);
+  }
+
+  virtual void BeforeFirst(void) {
+    for (Bucket& b : buckets_) b.count = 0;
+    pending_ = 0;
+    end_of_data_ = false;
+    base_->BeforeFirst();
+  }
+
+  virtual bool Next(void) {
+    while (!end_of_data_) {
+      if (!base_->Next()) {
+        end_of_data_ = true;
+        break;
+      }
+      const DataInst& d = base_->Value();
+      if (!initialized_) this->InitBuckets(d);
+      const index_t len = d.data[0].shape_[0];
+      const int b = this->FindBucket(len);
+      this->FillInstance(b, d);
+      ++pending_;
+      if (buckets_[b].count == batch_param_.batch_size) {
+        this->Emit(b);
+        return true;
+      }
+      if (pending_ >= max_pending_) {
+        this->Emit(this->FullestBucket());
+        return true;
+      }
+    }
+    // source exhausted: drain the remaining partial buckets one per call
+    for (int b = 0; b < static_cast<int>(buckets_.size()); ++b) {
+      if (buckets_[b].count != 0) {
+        this->Emit(b);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  virtual const TBlobBatch &Value(void) const {
+    return out_;
+  }
+
+ private:
+  /*! \brief batch buffers of one bucket */
+  struct Bucket {
+    /*! \brief number of instances currently buffered */
+    index_t count{0};
+    /*! \brief tensors holding the batch, indexed like DataInst::data */
+    std::vector<TBlobContainer> data;
+    /*! \brief batch shapes of the tensors */
+    mxnet::ShapeVector shape;
+    /*! \brief source indices of the buffered instances */
+    std::vector<unsigned> inst_index;
+  };
+
+  // set up the per-bucket buffers from the first instance; blobs past the
+  // first are fixed size, the first is padded to the bucket length
+  inline void InitBuckets(const DataInst& first_inst) {
+    const size_t nblob = first_inst.data.size();
+    unit_size_.resize(nblob);
+    for (size_t i = 0; i < nblob; ++i) {
+      const mxnet::TShape& src_shape = first_inst.data[i].shape_;
+      unit_size_[i] = i == 0 ? src_shape.Size() / src_shape[0] : src_shape.Size();
+    }
+    for (size_t b = 0; b < buckets_.size(); ++b) {
+      Bucket& bucket = buckets_[b];
+      bucket.data.resize(nblob);
+      bucket.shape.resize(nblob);
+      bucket.inst_index.resize(batch_param_.batch_size);
+      for (size_t i = 0; i < nblob; ++i) {
+        const mxnet::TShape& src_shape = first_inst.data[i].shape_;
+        std::vector<index_t> shape_vec;
+        shape_vec.push_back(batch_param_.batch_size);
+        for (index_t dim = 0; dim < src_shape.ndim(); ++dim) {
+          shape_vec.push_back(i == 0 && dim == 0
+              ? static_cast<index_t>(param_.buckets[b]) : src_shape[dim]);
+        }
+        mxnet::TShape dst_shape(shape_vec.begin(), shape_vec.end());
+        bucket.shape[i] = dst_shape;
+        bucket.data[i].resize(mshadow::Shape1(dst_shape.Size()),
+                              first_inst.data[i].type_flag_);
+      }
+    }
+    initialized_ = true;
+  }
+
+  /*! \brief smallest bucket covering an instance length */
+  inline int FindBucket(index_t len) const {
+    for (int b = 0; b < param_.buckets.ndim(); ++b) {
+      if (static_cast<index_t>(param_.buckets[b]) >= len) return b;
+    }
+    LOG(FATAL) << "instance of length " << len
+               << " exceeds the largest bucket " << param_.buckets;
+    return -1;
+  }
+
+  /*! \brief copy one instance into its bucket, zero-padding the data blob */
+  inline void FillInstance(int b, const DataInst& d) {
+    Bucket& bucket = buckets_[b];
+    const index_t top = bucket.count++;
+    bucket.inst_index[top] = d.index;
+    for (size_t i = 0; i < d.data.size(); ++i) {
+      const size_t slot = i == 0
+          ? static_cast<size_t>(param_.buckets[b]) * unit_size_[i]
+          : unit_size_[i];
+      const size_t valid = d.data[i].Size();
+      CHECK_LE(valid, slot);
+      MSHADOW_TYPE_SWITCH(bucket.data[i].type_flag_, DType, {
+          mshadow::Copy(
+            bucket.data[i].get<cpu, 1, DType>().Slice(top * slot,
+                                                      top * slot + valid),
+            d.data[i].get_with_shape<cpu, 1, DType>(mshadow::Shape1(valid)));
+          if (valid < slot) {
+            std::memset(bucket.data[i].get<cpu, 1, DType>().dptr_ + top * slot + valid,
+                        0, (slot - valid) * sizeof(DType));
+          }
+        });
+    }
+  }
+
+  /*! \brief index of the bucket holding the most instances */
+  inline int FullestBucket(void) const {
+    int best = 0;
+    for (int b = 1; b < static_cast<int>(buckets_.size()); ++b) {
+      if (buckets_[b].count > buckets_[best].count) best = b;
+    }
+    return best;
+  }
+
+  /*! \brief serve a bucket as the next batch and recycle its buffers */
+  inline void Emit(int b) {
+    Bucket& bucket = buckets_[b];
+    out_.data.clear();
+    for (size_t i = 0; i < bucket.data.size(); ++i) {
+      out_.data.push_back(TBlob(bucket.data[i].dptr_, bucket.shape[i],
+                                cpu::kDevMask, bucket.data[i].type_flag_, 0));
+    }
+    std::copy(bucket.inst_index.begin(),
+              bucket.inst_index.begin() + bucket.count, out_.inst_index);
+    out_.batch_size = batch_param_.batch_size;
+    out_.num_batch_padd = batch_param_.batch_size - bucket.count;
+    pending_ -= bucket.count;
+    bucket.count = 0;
+  }
+
+  /*! \brief batch parameters */
+  BatchParam batch_param_;
+  /*! \brief bucketing parameters */
+  BucketBatchParam param_;
+  /*! \brief base iterator */
+  IIterator<DataInst> *base_;
+  /*! \brief output batch, aliasing the emitted bucket */
+  TBlobBatch out_;
+  /*! \brief per-bucket batch buffers */
+  std::vector<Bucket> buckets_;
+  /*! \brief per-instance element counts; for the data blob per length unit */
+  std::vector<size_t> unit_size_;
+  /*! \brief instances buffered across partial buckets */
+  index_t pending_{0};
+  /*! \brief resolved bucket_max_pending */
+  index_t max_pending_{0};
+  /*! \brief whether the bucket buffers are set up */
+  bool initialized_{false};
+  /*! \brief whether the source is exhausted */
+  bool end_of_data_{false};
+};  // class BucketBatchLoader
+}  // namespace io
+}  // namespace mxnet
+#endif  // MXNET_IO_ITER_BUCKET_BATCHLOADER_H_
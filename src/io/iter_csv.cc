@@ -27,8 +27,12 @@
 #include <dmlc/logging.h>
 #include <dmlc/parameter.h>
 #include <dmlc/data.h>
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
 #include "./iter_prefetcher.h"
 #include "./iter_batchloader.h"
+#include "./fast_csv_parser.h"
 
 namespace mxnet {
 namespace io {
@@ -161,6 +165,66 @@ class CSVIterTyped: public CSVIterBase {
   std::unique_ptr<dmlc::Parser<uint32_t, DType> > data_parser_;
 };
 
+/*!
+ * \brief CSV iterator over the block-wise parallel parser, selected with
+ *  MXNET_CSV_FAST_PARSER=1 for local single-file inputs
+ */
+template <typename DType>
+class FastCSVIterTyped : public CSVIterBase {
+ public:
+  virtual ~FastCSVIterTyped() {}
+
+  virtual void Init(const std::vector<std::pair<std::string, std::string> >& kwargs) {
+    param_.InitAllowUnknown(kwargs);
+    data_reader_.reset(
+        new FastCSVChunkReader<DType>(param_.data_csv, param_.data_shape.Size()));
+    if (param_.label_csv != "NULL") {
+      label_reader_.reset(
+          new FastCSVChunkReader<DType>(param_.label_csv, param_.label_shape.Size()));
+    } else {
+      dummy_label.set_pad(false);
+      dummy_label.Resize(mshadow::Shape1(1));
+      dummy_label = 0;
+    }
+  }
+
+  virtual void BeforeFirst() {
+    data_reader_->BeforeFirst();
+    if (label_reader_.get() != nullptr) {
+      label_reader_->BeforeFirst();
+    }
+    inst_counter_ = 0;
+    end_ = false;
+  }
+
+  virtual bool Next() {
+    if (end_) return false;
+    const DType* row = data_reader_->NextRow();
+    if (row == nullptr) {
+      end_ = true;
+      return false;
+    }
+    out_.index = inst_counter_++;
+    out_.data[0] = TBlob(const_cast<DType*>(row), param_.data_shape, cpu::kDevMask, 0);
+    if (label_reader_.get() != nullptr) {
+      const DType* label_row = label_reader_->NextRow();
+      CHECK(label_row != nullptr)
+          << "Data CSV's row is smaller than the number of rows in label_csv";
+      out_.data[1] = TBlob(const_cast<DType*>(label_row), param_.label_shape,
+                           cpu::kDevMask, 0);
+    } else {
+      out_.data[1] = dummy_label;
+    }
+    return true;
+  }
+
+ private:
+  // dummy label
+  mshadow::TensorContainer<cpu, 1, DType> dummy_label;
+  std::unique_ptr<FastCSVChunkReader<DType> > data_reader_;
+  std::unique_ptr<FastCSVChunkReader<DType> > label_reader_;
+};
+
 class CSVIter: public IIterator<DataInst> {
  public:
   CSVIter() {}
@@ -185,7 +249,23 @@ class CSVIter: public IIterator<DataInst> {
         }
       }
     }
-    if (dtype_has_value && target_dtype == mshadow::kInt32) {
+    bool fast_parser = dmlc::GetEnv("MXNET_CSV_FAST_PARSER", false);
+    if (fast_parser &&
+        !(IsLocalRegularFile(param_.data_csv) &&
+          (param_.label_csv == "NULL" || IsLocalRegularFile(param_.label_csv)))) {
+      LOG(INFO) << "MXNET_CSV_FAST_PARSER only applies to local single-file "
+                   "inputs, falling back to the dmlc parser";
+      fast_parser = false;
+    }
+    if (fast_parser) {
+      if (dtype_has_value && target_dtype == mshadow::kInt32) {
+        iterator_.reset(new FastCSVIterTyped<int32_t>());
+      } else if (dtype_has_value && target_dtype == mshadow::kInt64) {
+        iterator_.reset(new FastCSVIterTyped<int64_t>());
+      } else if (!dtype_has_value || target_dtype == mshadow::kFloat32) {
+        iterator_.reset(new FastCSVIterTyped<float>());
+      }
+    } else if (dtype_has_value && target_dtype == mshadow::kInt32) {
       iterator_.reset(reinterpret_cast<CSVIterBase*>(new CSVIterTyped<int32_t>()));
     } else if (dtype_has_value && target_dtype == mshadow::kInt64) {
       iterator_.reset(reinterpret_cast<CSVIterBase*>(new CSVIterTyped<int64_t>()));
@@ -208,6 +288,16 @@ class CSVIter: public IIterator<DataInst> {
   }
 
  private:
+  static bool IsLocalRegularFile(const std::string& path) {
+    if (path.find("://") != std::string::npos) return false;
+#ifndef _WIN32
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+#else
+    return false;
+#endif
+  }
+
   CSVIterParam param_;
   std::unique_ptr<CSVIterBase> iterator_;
 };
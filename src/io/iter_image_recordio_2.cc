@@ -41,6 +41,15 @@
 #include "./image_augmenter.h"
 #include "./image_iter_common.h"
 #include "./inst_vector.h"
+#include "./mmap_recordio_split.h"
+#include "./shuffled_recordio_split.h"
+#if MXNET_USE_OPENCV
+#include "./decoded_image_cache.h"
+#endif
+#if MXNET_USE_NVJPEG
+#include "./nvjpeg_image_decoder.h"
+#endif
+#include "../common/thread_budget.h"
 #include "../common/utils.h"
 
 namespace mxnet {
@@ -92,7 +101,13 @@ class ImageRecordIOParser2 {
   #if MXNET_USE_OPENCV
   /*! \brief augmenters */
   std::vector<std::vector<std::unique_ptr<ImageAugmenter> > > augmenters_;
+  /*! \brief decoded image cache shared by the threads, nullptr when disabled */
+  std::unique_ptr<DecodedImageCache> decode_cache_;
   #endif
+#if MXNET_USE_NVJPEG
+  /*! \brief per-thread GPU JPEG decoders, empty when GPU decode is disabled */
+  std::vector<std::unique_ptr<NVJPEGDecoder> > nvjpeg_decoders_;
+#endif
   /*! \brief random samplers */
   std::vector<std::unique_ptr<common::RANDOM_ENGINE> > prnds_;
   common::RANDOM_ENGINE rnd_;
@@ -154,6 +169,9 @@ inline void ImageRecordIOParser2<DType>::Init(
       threadget = omp_get_num_threads();
     }
   }
+  // an "io" entry in MXNET_CPU_CORE_SETS caps the decode team at its core
+  // budget; the binding itself happens on the producer thread in ParseChunk
+  threadget = common::ThreadCoreBudget::Get()->Threads("io", threadget);
   param_.preprocess_threads = threadget;
 
   std::vector<std::string> aug_names = dmlc::Split(param_.aug_seq, ',');
@@ -167,6 +185,32 @@ inline void ImageRecordIOParser2<DType>::Init(
     }
     prnds_.emplace_back(new common::RANDOM_ENGINE((i + 1) * kRandMagic));
   }
+#if MXNET_USE_NVJPEG
+  nvjpeg_decoders_.clear();
+  if (dmlc::GetEnv("MXNET_IMAGE_NVJPEG_DECODE", true)) {
+    // augmentation still runs on the CPU over cv::Mat, so the decoders hand
+    // the decoded pixels back to the host; only the decode itself moves to
+    // the GPU
+    const int decode_dev = param_.device_id == -1 ? 0 : param_.device_id;
+    for (int i = 0; i < threadget; ++i) {
+      nvjpeg_decoders_.emplace_back(new NVJPEGDecoder(decode_dev));
+    }
+    if (param_.verbose) {
+      LOG(INFO) << "ImageRecordIOParser2: decoding JPEGs with nvJPEG on GPU "
+                << decode_dev;
+    }
+  }
+#endif
+  decode_cache_.reset();
+  const int decode_cache_mb = dmlc::GetEnv("MXNET_IMAGE_DECODE_CACHE_MB", 0);
+  if (decode_cache_mb > 0) {
+    decode_cache_.reset(
+        new DecodedImageCache(static_cast<size_t>(decode_cache_mb) << 20));
+    if (param_.verbose) {
+      LOG(INFO) << "ImageRecordIOParser2: caching up to " << decode_cache_mb
+                << " MB of decoded images across epochs";
+    }
+  }
   if (param_.path_imglist.length() != 0) {
     label_map_.reset(new ImageLabelMap(param_.path_imglist.c_str(),
       param_.label_width, !param_.verbose));
@@ -189,10 +233,54 @@ inline void ImageRecordIOParser2<DType>::Init(
         record_param_.seed,
         batch_param_.batch_size));
   } else {
-    source_.reset(dmlc::InputSplit::Create(
-        param_.path_imgrec.c_str(), param_.part_index,
-        param_.num_parts, "recordio"));
-    if (record_param_.shuffle)
+    source_.reset();
+    // true when the source itself already yields records in shuffled order
+    bool record_shuffled = false;
+#if defined(__linux__)
+    if (dmlc::GetEnv("MXNET_RECORDIO_SHUFFLE_INDEX", false) && record_param_.shuffle) {
+      if (param_.path_imgrec.find("://") != std::string::npos) {
+        LOG(INFO) << "MXNET_RECORDIO_SHUFFLE_INDEX only applies to local "
+                     "record files, reading " << param_.path_imgrec
+                  << " through buffered streams";
+      } else if (param_.shuffle_chunk_size > 0) {
+        LOG(INFO) << "MXNET_RECORDIO_SHUFFLE_INDEX supersedes chunk "
+                     "shuffling, ignoring shuffle_chunk_size";
+        param_.shuffle_chunk_size = 0;
+      }
+      if (param_.path_imgrec.find("://") == std::string::npos) {
+        source_.reset(new ShuffledRecordIOSplit(
+            param_.path_imgrec, param_.part_index,
+            param_.num_parts, record_param_.seed));
+        record_shuffled = true;
+        if (param_.verbose) {
+          LOG(INFO) << "ImageRecordIOParser2: record-level shuffled sampling "
+                       "of " << param_.path_imgrec;
+        }
+      }
+    }
+    if (source_ == nullptr && dmlc::GetEnv("MXNET_RECORDIO_MMAP", false)) {
+      if (param_.path_imgrec.find("://") != std::string::npos) {
+        LOG(INFO) << "MXNET_RECORDIO_MMAP only applies to local record files, "
+                     "reading " << param_.path_imgrec << " through buffered streams";
+      } else if (param_.shuffle_chunk_size > 0) {
+        LOG(INFO) << "MXNET_RECORDIO_MMAP cannot be combined with chunk "
+                     "shuffling, falling back to buffered streams";
+      } else {
+        source_.reset(new MmapRecordIOSplit(
+            param_.path_imgrec, param_.part_index, param_.num_parts));
+        if (param_.verbose) {
+          LOG(INFO) << "ImageRecordIOParser2: decoding " << param_.path_imgrec
+                    << " zero-copy out of an mmap";
+        }
+      }
+    }
+#endif  // __linux__
+    if (source_ == nullptr) {
+      source_.reset(dmlc::InputSplit::Create(
+          param_.path_imgrec.c_str(), param_.part_index,
+          param_.num_parts, "recordio"));
+    }
+    if (record_param_.shuffle && !record_shuffled)
       legacy_shuffle_ = true;
     if (param_.shuffle_chunk_size > 0) {
       if (param_.shuffle_chunk_size > 4096) {
@@ -514,6 +602,13 @@ cv::Mat ImageRecordIOParser2<DType>::TJimdecode(cv::Mat image, int color) {
 template<typename DType>
 inline size_t ImageRecordIOParser2<DType>::ParseChunk(DType* data_dptr, real_t* label_dptr,
   const size_t current_size, dmlc::InputSplit::Blob * chunk) {
+  // bind from the thread that spawns the decode team, so the OMP workers
+  // inherit the "io" core set instead of competing with engine workers
+  static thread_local bool io_cores_applied = false;
+  if (!io_cores_applied) {
+    common::ThreadCoreBudget::ApplyToCurrentThread("io");
+    io_cores_applied = true;
+  }
   temp_.resize(param_.preprocess_threads);
 #if MXNET_USE_OPENCV
   // save opencv out
@@ -555,6 +650,22 @@ inline size_t ImageRecordIOParser2<DType>::ParseChunk(DType* data_dptr, real_t*
         prnds_[tid]->seed(idx + param_.seed_aug.value() + kRandMagic);
       }
 
+      // repeat epochs serve the decoded pixels of hot records from the cache
+      bool cache_hit = false;
+      if (decode_cache_ != nullptr) {
+        res = decode_cache_->Get(static_cast<size_t>(rec.image_index()));
+        cache_hit = !res.empty();
+      }
+      if (!cache_hit) {
+#if MXNET_USE_NVJPEG
+      // gray and BGR go through the GPU decoder; anything nvJPEG rejects
+      // (non-JPEG payloads, exotic subsamplings) falls back to the CPU path
+      if (!nvjpeg_decoders_.empty() && param_.data_shape[0] != 4) {
+        res = nvjpeg_decoders_[tid]->Decode(rec.content, rec.content_size,
+                                            param_.data_shape[0] == 1 ? 1 : 3);
+      }
+      if (res.empty()) {
+#endif
       switch (param_.data_shape[0]) {
        case 1:
 #if MXNET_USE_LIBJPEG_TURBO
@@ -580,6 +691,13 @@ inline size_t ImageRecordIOParser2<DType>::ParseChunk(DType* data_dptr, real_t*
        default:
         LOG(FATAL) << "Invalid output shape " << param_.data_shape;
       }
+#if MXNET_USE_NVJPEG
+      }
+#endif
+      if (decode_cache_ != nullptr) {
+        decode_cache_->Put(static_cast<size_t>(rec.image_index()), res);
+      }
+      }
       const int n_channels = res.channels();
       // load label before augmentations
       std::vector<float> label_buf;
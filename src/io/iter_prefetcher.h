@@ -35,6 +35,7 @@
 #include <climits>
 #include <utility>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <queue>
 #include <algorithm>
@@ -82,17 +83,54 @@ class PrefetcherIter : public IIterator<DataBatch> {
           (*dptr)->num_batch_padd = batch.num_batch_padd;
           (*dptr)->data.resize(batch.data.size());
           (*dptr)->index.resize(batch.batch_size);
+          Context data_ctx = Context::CPU();
+#if MXNET_USE_CUDA
+          if (param_.prefetch_device.has_value()) {
+            const int dev = param_.prefetch_device.value();
+            data_ctx = Context::GPU(dev);
+            // pinned staging buffers feeding the asynchronous H2D copies
+            std::vector<NDArray>& staging = staging_[*dptr];
+            staging.resize(batch.data.size());
+            for (size_t i = 0; i < batch.data.size(); ++i) {
+              auto dtype = param_.dtype
+                               ? param_.dtype.value()
+                               : batch.data[i].type_flag_;
+              staging[i] = NDArray(batch.data[i].shape_,
+                                   Context::CPUPinned(dev), false,
+                                   dtype);
+            }
+          }
+#endif  // MXNET_USE_CUDA
           for (size_t i = 0; i < batch.data.size(); ++i) {
             auto dtype = param_.dtype
                              ? param_.dtype.value()
                              : batch.data[i].type_flag_;
             (*dptr)->data.at(i) = NDArray(batch.data[i].shape_,
-                                          Context::CPU(), false,
+                                          data_ctx, false,
                                           dtype);
           }
         }
         CHECK(batch.data.size() == (*dptr)->data.size());
         // copy data over
+#if MXNET_USE_CUDA
+        if (param_.prefetch_device.has_value()) {
+          std::vector<NDArray>& staging = staging_[*dptr];
+          for (size_t i = 0; i < batch.data.size(); ++i) {
+            CHECK_EQ((*dptr)->data.at(i).shape(), batch.data[i].shape_);
+            // the H2D copy of the previous round reads the staging buffer;
+            // wait for it before overwriting the buffer outside the engine
+            staging[i].WaitToWrite();
+            MSHADOW_TYPE_SWITCH(batch.data[i].type_flag_, DType, {
+                mshadow::Copy(staging[i].data().FlatTo2D<cpu, DType>(),
+                          batch.data[i].FlatTo2D<cpu, DType>());
+            });
+            // async on the copy stream; the consumer blocks on the device
+            // array's var only if the copy has not finished by then
+            CopyFromTo(staging[i], &((*dptr)->data)[i]);
+            (*dptr)->num_batch_padd = batch.num_batch_padd;
+          }
+        } else {
+#endif  // MXNET_USE_CUDA
         for (size_t i = 0; i < batch.data.size(); ++i) {
           CHECK_EQ((*dptr)->data.at(i).shape(), batch.data[i].shape_);
           MSHADOW_TYPE_SWITCH(batch.data[i].type_flag_, DType, {
@@ -101,6 +139,9 @@ class PrefetcherIter : public IIterator<DataBatch> {
           });
           (*dptr)->num_batch_padd = batch.num_batch_padd;
         }
+#if MXNET_USE_CUDA
+        }
+#endif  // MXNET_USE_CUDA
         if (batch.inst_index) {
           std::copy(batch.inst_index,
                     batch.inst_index + batch.batch_size,
@@ -148,6 +189,10 @@ class PrefetcherIter : public IIterator<DataBatch> {
   DataBatch *out_;
   /*! \brief queue to be recycled */
   std::queue<DataBatch*> recycle_queue_;
+#if MXNET_USE_CUDA
+  /*! \brief pinned staging buffers of each batch for device prefetching */
+  std::unordered_map<DataBatch*, std::vector<NDArray> > staging_;
+#endif
 };
 }  // namespace io
 }  // namespace mxnet
@@ -0,0 +1,53 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file iter_push.cc
+ * \brief register the push iterator
+ */
+#include "./iter_push.h"
+
+namespace mxnet {
+namespace io {
+
+DMLC_REGISTER_PARAMETER(PushIterParam);
+
+MXNET_REGISTER_IO_ITER(PushIter)
+.describe(R"code(Returns a push-based data iterator.
+
+Unlike the other iterators, a ``PushIter`` does not read from a data source:
+an external producer hands ready batches over through ``MXDataIterPushNDArray``
+and marks the end of an epoch with ``MXDataIterPushEndOfData``. Only the
+NDArray handles change hands, so batches that were assembled outside of MXNet,
+for example in shared memory by a feature store, reach the consumer without a
+copy. On the consumer side a ``PushIter`` behaves like any native iterator:
+``next`` blocks until a batch was pushed or the end of data was signaled, and
+``reset`` starts the next epoch.
+
+The ``capacity`` parameter bounds how many pushed batches are buffered; a
+producer pushing into a full iterator blocks until the consumer catches up.
+)code" ADD_FILELINE)
+.add_arguments(PushIterParam::__FIELDS__())
+.set_body([]() {
+    return new PushDataIter();
+  });
+
+}  // namespace io
+}  // namespace mxnet
@@ -0,0 +1,142 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file iter_push.h
+ * \brief iterator fed batches by an external producer through the C API
+ */
+#ifndef MXNET_IO_ITER_PUSH_H_
+#define MXNET_IO_ITER_PUSH_H_
+
+#include <mxnet/io.h>
+#include <mxnet/ndarray.h>
+#include <dmlc/parameter.h>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mxnet {
+namespace io {
+
+/*! \brief parameters of the push iterator */
+struct PushIterParam : public dmlc::Parameter<PushIterParam> {
+  /*! \brief maximum number of batches buffered inside the iterator */
+  int capacity;
+  // declare parameters
+  DMLC_DECLARE_PARAMETER(PushIterParam) {
+    DMLC_DECLARE_FIELD(capacity).set_default(4).set_lower_bound(1)
+        .describe("Maximum number of batches buffered inside the iterator; "
+                  "pushing into a full iterator blocks the producer until "
+                  "the consumer catches up.");
+  }
+};
+
+/*!
+ * \brief An iterator whose batches are handed over by an external producer
+ *  instead of being read from a data source. The producer pushes NDArray
+ *  pairs through MXDataIterPushNDArray, which only copies the array headers,
+ *  so batches that already live in shared or pinned memory are served to the
+ *  consumer without a further copy. The consumer side is the ordinary
+ *  IIterator interface, so a push iterator plugs into everything a native
+ *  iterator does.
+ */
+class PushDataIter : public IIterator<DataBatch> {
+ public:
+  virtual ~PushDataIter() {}
+
+  virtual void Init(const std::vector<std::pair<std::string, std::string> >& kwargs) {
+    param_.InitAllowUnknown(kwargs);
+  }
+
+  virtual void BeforeFirst(void) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // drop batches of the previous epoch and let the producer push the next
+    std::queue<DataBatch> empty;
+    queue_.swap(empty);
+    end_of_data_ = false;
+    cv_not_full_.notify_all();
+  }
+
+  virtual bool Next(void) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_not_empty_.wait(lock, [this] {
+        return !queue_.empty() || end_of_data_;
+      });
+    if (queue_.empty()) return false;
+    out_ = std::move(queue_.front());
+    queue_.pop();
+    cv_not_full_.notify_one();
+    return true;
+  }
+
+  virtual const DataBatch &Value(void) const {
+    return out_;
+  }
+
+  /*!
+   * \brief hand one batch over to the consumer; blocks while the internal
+   *  buffer holds capacity batches
+   */
+  void Push(const NDArray& data, const NDArray& label, int num_batch_padd) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_not_full_.wait(lock, [this] {
+        return queue_.size() < static_cast<size_t>(param_.capacity);
+      });
+    CHECK(!end_of_data_)
+        << "PushIter: cannot push after the end of data was signaled, "
+           "call Reset to start the next epoch";
+    DataBatch batch;
+    batch.data.resize(2);
+    batch.data[0] = data;
+    batch.data[1] = label;
+    batch.num_batch_padd = num_batch_padd;
+    queue_.push(std::move(batch));
+    cv_not_empty_.notify_one();
+  }
+
+  /*! \brief signal that no further batch follows in this epoch */
+  void SignalEndOfData(void) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    end_of_data_ = true;
+    cv_not_empty_.notify_all();
+  }
+
+ private:
+  /*! \brief parameters */
+  PushIterParam param_;
+  /*! \brief batch served to the consumer */
+  DataBatch out_;
+  /*! \brief batches pushed but not yet consumed */
+  std::queue<DataBatch> queue_;
+  /*! \brief whether the producer signaled the end of the epoch */
+  bool end_of_data_{false};
+  /*! \brief protects the queue and the end flag */
+  std::mutex mutex_;
+  std::condition_variable cv_not_empty_;
+  std::condition_variable cv_not_full_;
+};  // class PushDataIter
+
+}  // namespace io
+}  // namespace mxnet
+
+#endif  // MXNET_IO_ITER_PUSH_H_
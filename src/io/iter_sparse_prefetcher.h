@@ -34,6 +34,7 @@
 #include <climits>
 #include <utility>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <queue>
 #include <algorithm>
@@ -56,6 +57,7 @@ class SparsePrefetcherIter : public PrefetcherIter {
     PrefetcherIter::InitParams(kwargs);
     // use the kwarg to init batch loader
     sparse_loader_->Init(kwargs);
+    use_arena_ = dmlc::GetEnv("MXNET_SPARSE_BATCH_ARENA", false);
     iter.Init([this](DataBatch **dptr) {
         if (!sparse_loader_->Next()) return false;
         const TBlobBatch& batch = sparse_loader_->Value();
@@ -75,21 +77,42 @@ class SparsePrefetcherIter : public PrefetcherIter {
             if (stype == kDefaultStorage) {
               (*dptr)->data.at(i) = NDArray(batch.data[data_iter].shape_,
                                             Context::CPU(), false, dtype);
-            } else {
+            } else if (!use_arena_) {
               (*dptr)->data.at(i) = NDArray(stype, this->GetShape(is_data),
                                             Context::CPU(), false, dtype);
             }
             data_iter += num_aux_data(stype) + 1;
           }
+          if (use_arena_) arenas_[*dptr].resize((*dptr)->data.size());
         }
         // copy data over
         size_t data_iter = 0;
         for (size_t i = 0; i < (*dptr)->data.size(); ++i) {
           auto& nd = ((*dptr)->data)[i];
-          auto stype = nd.storage_type();
+          // in arena mode the sparse outputs are rebuilt every batch, so the
+          // storage type comes from the loader rather than the placeholder
+          auto stype = use_arena_ ? this->GetStorageType(i == 0)
+                                  : nd.storage_type();
           auto& data_i = ((*dptr)->data)[i];
           if (stype == kDefaultStorage) {
             CopyFromTo(data_i.data(), batch.data[data_iter]);
+          } else if (stype == kCSRStorage && use_arena_) {
+            auto& values = batch.data[data_iter];
+            auto& indices = batch.data[data_iter + 1];
+            auto& indptr = batch.data[data_iter + 2];
+            CHECK_EQ(indices.shape_.Size(), values.shape_.Size());
+            // grow-only backing buffers whose capacity stays at its high
+            // watermark, so steady-state batches allocate nothing; the
+            // output wraps them without a further copy
+            CSRArena& arena = arenas_[*dptr][i];
+            TBlob values_blob = ArenaBlob(&arena.values, values);
+            TBlob indices_blob = ArenaBlob(&arena.indices, indices);
+            TBlob indptr_blob = ArenaBlob(&arena.indptr, indptr);
+            CopyFromTo(values_blob, values);
+            CopyFromTo(indices_blob, indices);
+            CopyFromTo(indptr_blob, indptr);
+            data_i = NDArray(kCSRStorage, this->GetShape(i == 0), values_blob,
+                             std::vector<TBlob>{indptr_blob, indices_blob}, 0);
           } else if (stype == kCSRStorage) {
             auto& values = batch.data[data_iter];
             auto& indices = batch.data[data_iter + 1];
@@ -141,6 +164,24 @@ class SparsePrefetcherIter : public PrefetcherIter {
  private:
   /*! \brief internal sparse batch loader */
   SparseIIterator<TBlobBatch>* sparse_loader_;
+  /*! \brief whether batches are built into retained arenas */
+  bool use_arena_{false};
+  /*! \brief grow-only backing buffers of one CSR output */
+  struct CSRArena {
+    std::vector<char> values;
+    std::vector<char> indices;
+    std::vector<char> indptr;
+  };
+  /*! \brief arenas of each in-flight batch, indexed like DataBatch::data */
+  std::unordered_map<DataBatch*, std::vector<CSRArena> > arenas_;
+
+  /*! \brief a TBlob shaped like src over the (grown if needed) buffer */
+  inline TBlob ArenaBlob(std::vector<char>* buf, const TBlob& src) {
+    const size_t nbytes = src.shape_.Size() * mshadow::mshadow_sizeof(src.type_flag_);
+    if (buf->size() < nbytes) buf->resize(nbytes);
+    return TBlob(static_cast<void*>(buf->data()), src.shape_,
+                 cpu::kDevMask, src.type_flag_, 0);
+  }
 
   inline void CopyFromTo(TBlob dst, const TBlob src) {
     MSHADOW_TYPE_SWITCH(src.type_flag_, DType, {
@@ -0,0 +1,181 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file mmap_recordio_split.h
+ * \brief InputSplit over a local RecordIO file backed by mmap
+ */
+#ifndef MXNET_IO_MMAP_RECORDIO_SPLIT_H_
+#define MXNET_IO_MMAP_RECORDIO_SPLIT_H_
+
+#if defined(__linux__)
+
+#include <dmlc/io.h>
+#include <dmlc/recordio.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+namespace mxnet {
+namespace io {
+
+/*!
+ * \brief InputSplit over a local RecordIO file backed by a read-only mmap.
+ *  Chunks handed out point straight into the mapping, so record payloads
+ *  are decoded out of the page cache without a copy into staging buffers.
+ *  Enabled for local .rec files with MXNET_RECORDIO_MMAP=1.
+ */
+class MmapRecordIOSplit : public dmlc::InputSplit {
+ public:
+  MmapRecordIOSplit(const std::string& path, unsigned part_index, unsigned num_parts) {
+    fd_ = open(path.c_str(), O_RDONLY);
+    CHECK_NE(fd_, -1) << "MmapRecordIOSplit: cannot open " << path
+                      << ": " << strerror(errno);
+    struct stat st;
+    CHECK_EQ(fstat(fd_, &st), 0)
+        << "MmapRecordIOSplit: cannot stat " << path << ": " << strerror(errno);
+    CHECK_GT(st.st_size, 0) << "MmapRecordIOSplit: " << path << " is empty";
+    size_ = static_cast<size_t>(st.st_size);
+    void* ptr = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    CHECK_NE(ptr, MAP_FAILED)
+        << "MmapRecordIOSplit: mmap failed with error " << strerror(errno);
+    base_ = static_cast<char*>(ptr);
+    // each partition is scanned front to back once per epoch
+    madvise(base_, size_, MADV_SEQUENTIAL);
+    ResetPartition(part_index, num_parts);
+  }
+
+  virtual ~MmapRecordIOSplit() {
+    munmap(base_, size_);
+    close(fd_);
+  }
+
+  size_t GetTotalSize(void) override {
+    return size_;
+  }
+
+  void BeforeFirst(void) override {
+    pos_ = begin_;
+  }
+
+  void ResetPartition(unsigned part_index, unsigned num_parts) override {
+    begin_ = SeekRecordBegin(size_ * part_index / num_parts);
+    end_ = SeekRecordBegin(size_ * (part_index + 1) / num_parts);
+    BeforeFirst();
+  }
+
+  void HintChunkSize(size_t chunk_size) override {
+    chunk_size_ = chunk_size;
+  }
+
+  bool NextRecord(Blob* out_rec) override {
+    if (pos_ >= end_) return false;
+    const size_t payload = pos_ + 2 * sizeof(uint32_t);
+    uint32_t cflag;
+    const size_t next = SkipRecord(pos_, &cflag);
+    CHECK_EQ(cflag, 0U)
+        << "MmapRecordIOSplit::NextRecord does not support multi-part records, "
+        << "use NextChunk with RecordIOChunkReader";
+    out_rec->dptr = base_ + payload;
+    out_rec->size = dmlc::RecordIOWriter::DecodeLength(ReadU32(pos_ + sizeof(uint32_t)));
+    pos_ = next;
+    return true;
+  }
+
+  bool NextChunk(Blob* out_chunk) override {
+    if (pos_ >= end_) return false;
+    const size_t begin = pos_;
+    // hand out whole logical records only; a chunk may end after a
+    // single-part record or the last part of a multi-part one
+    while (pos_ < end_) {
+      uint32_t cflag;
+      pos_ = SkipRecord(pos_, &cflag);
+      const bool complete = (cflag == 0U || cflag == 3U);
+      if (complete && pos_ - begin >= chunk_size_) break;
+    }
+    out_chunk->dptr = base_ + begin;
+    out_chunk->size = pos_ - begin;
+    return true;
+  }
+
+ private:
+  inline uint32_t ReadU32(size_t offset) const {
+    uint32_t value;
+    std::memcpy(&value, base_ + offset, sizeof(value));
+    return value;
+  }
+
+  /*!
+   * \brief find the first logical record starting at or after offset;
+   *  continuation parts of multi-part records are skipped
+   */
+  size_t SeekRecordBegin(size_t offset) const {
+    size_t pos = std::min((offset + 3) & ~static_cast<size_t>(3), size_);
+    while (pos + 2 * sizeof(uint32_t) <= size_) {
+      if (ReadU32(pos) == dmlc::RecordIOWriter::kMagic) {
+        const uint32_t cflag =
+            dmlc::RecordIOWriter::DecodeFlag(ReadU32(pos + sizeof(uint32_t)));
+        if (cflag == 0U || cflag == 1U) return pos;
+      }
+      pos += sizeof(uint32_t);
+    }
+    return size_;
+  }
+
+  /*! \brief validate the record header at pos and return the next position */
+  size_t SkipRecord(size_t pos, uint32_t* cflag) const {
+    CHECK_LE(pos + 2 * sizeof(uint32_t), size_) << "corrupted RecordIO file";
+    CHECK_EQ(ReadU32(pos), dmlc::RecordIOWriter::kMagic)
+        << "corrupted RecordIO file, invalid magic at offset " << pos;
+    const uint32_t lrec = ReadU32(pos + sizeof(uint32_t));
+    const size_t len = dmlc::RecordIOWriter::DecodeLength(lrec);
+    *cflag = dmlc::RecordIOWriter::DecodeFlag(lrec);
+    const size_t next = pos + 2 * sizeof(uint32_t) + ((len + 3U) & ~static_cast<size_t>(3));
+    CHECK_LE(next, size_) << "corrupted RecordIO file, record exceeds file size";
+    return next;
+  }
+
+  /*! \brief file descriptor of the record file */
+  int fd_;
+  /*! \brief base of the mapping */
+  char* base_;
+  /*! \brief size of the record file in bytes */
+  size_t size_;
+  /*! \brief begin of this partition */
+  size_t begin_;
+  /*! \brief end of this partition */
+  size_t end_;
+  /*! \brief current read position */
+  size_t pos_;
+  /*! \brief hinted chunk size */
+  size_t chunk_size_{8 << 20UL};
+};  // class MmapRecordIOSplit
+
+}  // namespace io
+}  // namespace mxnet
+
+#endif  // __linux__
+
+#endif  // MXNET_IO_MMAP_RECORDIO_SPLIT_H_
@@ -0,0 +1,131 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file nvjpeg_image_decoder.h
+ * \brief JPEG decoding on the GPU through nvJPEG, compiled with USE_NVJPEG=1
+ */
+#ifndef MXNET_IO_NVJPEG_IMAGE_DECODER_H_
+#define MXNET_IO_NVJPEG_IMAGE_DECODER_H_
+
+#if MXNET_USE_NVJPEG
+
+#include <cuda_runtime.h>
+#include <nvjpeg.h>
+#include <opencv2/opencv.hpp>
+#include "../common/cuda_utils.h"
+
+namespace mxnet {
+namespace io {
+
+/*!
+ * \brief Decodes one JPEG at a time on the GPU and hands the pixels back as a
+ *  cv::Mat, so the OpenCV augmentation stack downstream keeps working. Each
+ *  parser thread owns one decoder; the device scratch buffer grows to the
+ *  largest image seen and is reused across records.
+ */
+class NVJPEGDecoder {
+ public:
+  explicit NVJPEGDecoder(int device_id) : device_id_(device_id) {
+    mxnet::common::cuda::DeviceStore device_store(device_id_, true);
+    CHECK_EQ(nvjpegCreateSimple(&handle_), NVJPEG_STATUS_SUCCESS)
+        << "Failed to create nvJPEG handle";
+    CHECK_EQ(nvjpegJpegStateCreate(handle_, &state_), NVJPEG_STATUS_SUCCESS)
+        << "Failed to create nvJPEG state";
+    CUDA_CALL(cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking));
+  }
+
+  ~NVJPEGDecoder() {
+    mxnet::common::cuda::DeviceStore device_store(device_id_, true);
+    if (buffer_ != nullptr) {
+      MSHADOW_CATCH_ERROR(cudaFree(buffer_));
+    }
+    MSHADOW_CATCH_ERROR(cudaStreamDestroy(stream_));
+    nvjpegJpegStateDestroy(state_);
+    nvjpegDestroy(handle_);
+  }
+
+  /*!
+   * \brief Decode a JPEG into a gray or BGR cv::Mat.
+   * \param data encoded bytes
+   * \param size number of encoded bytes
+   * \param n_channels 1 for gray, 3 for BGR
+   * \return the decoded image, or an empty Mat when nvJPEG cannot handle the
+   *  stream and the caller should fall back to the CPU decoder
+   */
+  cv::Mat Decode(const unsigned char* data, size_t size, int n_channels) {
+    int widths[NVJPEG_MAX_COMPONENT];
+    int heights[NVJPEG_MAX_COMPONENT];
+    int components;
+    nvjpegChromaSubsampling_t subsampling;
+    if (nvjpegGetImageInfo(handle_, data, size, &components, &subsampling,
+                           widths, heights) != NVJPEG_STATUS_SUCCESS) {
+      return cv::Mat();
+    }
+    const int width = widths[0];
+    const int height = heights[0];
+    const size_t pitch = static_cast<size_t>(width) * n_channels;
+    const size_t nbytes = pitch * height;
+
+    mxnet::common::cuda::DeviceStore device_store(device_id_, true);
+    if (nbytes > capacity_) {
+      if (buffer_ != nullptr) CUDA_CALL(cudaFree(buffer_));
+      CUDA_CALL(cudaMalloc(&buffer_, nbytes));
+      capacity_ = nbytes;
+    }
+    nvjpegImage_t out{};
+    out.channel[0] = static_cast<unsigned char*>(buffer_);
+    out.pitch[0] = pitch;
+    const nvjpegOutputFormat_t fmt =
+        n_channels == 1 ? NVJPEG_OUTPUT_Y : NVJPEG_OUTPUT_BGRI;
+    if (nvjpegDecode(handle_, state_, data, size, fmt, &out, stream_) !=
+        NVJPEG_STATUS_SUCCESS) {
+      return cv::Mat();
+    }
+    cv::Mat res(height, width, n_channels == 1 ? CV_8UC1 : CV_8UC3);
+    CUDA_CALL(cudaMemcpyAsync(res.data, buffer_, nbytes,
+                              cudaMemcpyDeviceToHost, stream_));
+    CUDA_CALL(cudaStreamSynchronize(stream_));
+    return res;
+  }
+
+ private:
+  /*! \brief device the decoder runs on */
+  int device_id_;
+  /*! \brief nvJPEG library handle */
+  nvjpegHandle_t handle_;
+  /*! \brief per-decoder decode state */
+  nvjpegJpegState_t state_;
+  /*! \brief stream decode and copy-back are issued on */
+  cudaStream_t stream_;
+  /*! \brief device scratch buffer for the decoded image */
+  void* buffer_{nullptr};
+  /*! \brief capacity of the scratch buffer in bytes */
+  size_t capacity_{0};
+
+  DISALLOW_COPY_AND_ASSIGN(NVJPEGDecoder);
+};  // class NVJPEGDecoder
+
+}  // namespace io
+}  // namespace mxnet
+
+#endif  // MXNET_USE_NVJPEG
+
+#endif  // MXNET_IO_NVJPEG_IMAGE_DECODER_H_
@@ -0,0 +1,258 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file shuffled_recordio_split.h
+ * \brief record-level shuffled reading of RecordIO files over an offset index
+ */
+#ifndef MXNET_IO_SHUFFLED_RECORDIO_SPLIT_H_
+#define MXNET_IO_SHUFFLED_RECORDIO_SPLIT_H_
+
+#if defined(__linux__)
+
+#include <dmlc/io.h>
+#include <dmlc/recordio.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mxnet {
+namespace io {
+
+/*!
+ * \brief InputSplit that samples a RecordIO file at record granularity.
+ *  An offset table over the whole file is built on first use and persisted
+ *  next to the .rec as a .ridx sidecar, so later epochs and later runs pay
+ *  no scan. Every epoch draws a fresh global permutation of the partition's
+ *  records and batches are gathered with pread, sorted by offset within a
+ *  batch to keep the disk access pattern mostly ascending. Enabled with
+ *  MXNET_RECORDIO_SHUFFLE_INDEX=1.
+ */
+class ShuffledRecordIOSplit : public dmlc::InputSplit {
+ public:
+  ShuffledRecordIOSplit(const std::string& path, unsigned part_index,
+                        unsigned num_parts, int seed)
+      : rnd_(seed) {
+    fd_ = open(path.c_str(), O_RDONLY);
+    CHECK_NE(fd_, -1) << "ShuffledRecordIOSplit: cannot open " << path
+                      << ": " << strerror(errno);
+    struct stat st;
+    CHECK_EQ(fstat(fd_, &st), 0)
+        << "ShuffledRecordIOSplit: cannot stat " << path << ": " << strerror(errno);
+    CHECK_GT(st.st_size, 0) << "ShuffledRecordIOSplit: " << path << " is empty";
+    size_ = static_cast<size_t>(st.st_size);
+    if (!LoadIndex(path + ".ridx")) {
+      BuildIndex();
+      SaveIndex(path + ".ridx");
+    }
+    ResetPartition(part_index, num_parts);
+  }
+
+  virtual ~ShuffledRecordIOSplit() {
+    close(fd_);
+  }
+
+  size_t GetTotalSize(void) override {
+    return size_;
+  }
+
+  void BeforeFirst(void) override {
+    cur_ = 0;
+    std::shuffle(order_.begin(), order_.end(), rnd_);
+  }
+
+  void ResetPartition(unsigned part_index, unsigned num_parts) override {
+    const size_t begin = index_.size() * part_index / num_parts;
+    const size_t end = index_.size() * (part_index + 1) / num_parts;
+    order_.resize(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+      order_[i - begin] = i;
+    }
+    BeforeFirst();
+  }
+
+  void HintChunkSize(size_t chunk_size) override {
+    chunk_size_ = chunk_size;
+  }
+
+  bool NextRecord(Blob* out_rec) override {
+    if (cur_ >= order_.size()) return false;
+    const auto& entry = index_[order_[cur_++]];
+    buffer_.resize(entry.second);
+    ReadAt(buffer_.data(), entry.second, entry.first);
+    const uint32_t lrec = ReadU32(buffer_.data() + sizeof(uint32_t));
+    CHECK_EQ(dmlc::RecordIOWriter::DecodeFlag(lrec), 0U)
+        << "ShuffledRecordIOSplit::NextRecord does not support multi-part "
+        << "records, use NextChunk with RecordIOChunkReader";
+    out_rec->dptr = buffer_.data() + 2 * sizeof(uint32_t);
+    out_rec->size = dmlc::RecordIOWriter::DecodeLength(lrec);
+    return true;
+  }
+
+  bool NextChunk(Blob* out_chunk) override {
+    // records per chunk so that a chunk is roughly the hinted size
+    return NextBatch(out_chunk, std::max(chunk_size_ / AvgRecordSize(), size_t(1)));
+  }
+
+  bool NextBatch(Blob* out_chunk, size_t n_records) override {
+    if (cur_ >= order_.size()) return false;
+    n_records = std::min(n_records, order_.size() - cur_);
+    std::vector<size_t> ids(order_.begin() + cur_,
+                            order_.begin() + cur_ + n_records);
+    cur_ += n_records;
+    std::sort(ids.begin(), ids.end());
+
+    size_t total = 0;
+    for (size_t id : ids) total += index_[id].second;
+    buffer_.resize(total);
+    size_t off = 0;
+    for (size_t id : ids) {
+      ReadAt(buffer_.data() + off, index_[id].second, index_[id].first);
+      off += index_[id].second;
+    }
+    out_chunk->dptr = buffer_.data();
+    out_chunk->size = total;
+    return true;
+  }
+
+ private:
+  /*! \brief magic of the .ridx sidecar format */
+  static const uint64_t kIndexMagic = 0x6d786e657472697eULL;
+
+  static uint32_t ReadU32(const char* ptr) {
+    uint32_t value;
+    std::memcpy(&value, ptr, sizeof(value));
+    return value;
+  }
+
+  size_t AvgRecordSize() const {
+    return std::max(size_ / std::max(index_.size(), size_t(1)), size_t(1));
+  }
+
+  /*! \brief pread the full range, tolerating short reads */
+  void ReadAt(char* dst, size_t nbytes, size_t offset) const {
+    while (nbytes != 0) {
+      const ssize_t nread = pread(fd_, dst, nbytes, offset);
+      CHECK_GT(nread, 0) << "ShuffledRecordIOSplit: pread failed with error "
+                         << strerror(errno);
+      dst += nread;
+      offset += nread;
+      nbytes -= nread;
+    }
+  }
+
+  /*!
+   * \brief scan the record headers once and record (offset, length) of every
+   *  logical record; multi-part records form a single entry
+   */
+  void BuildIndex() {
+    void* ptr = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    CHECK_NE(ptr, MAP_FAILED)
+        << "ShuffledRecordIOSplit: mmap failed with error " << strerror(errno);
+    const char* base = static_cast<const char*>(ptr);
+    madvise(ptr, size_, MADV_SEQUENTIAL);
+    size_t pos = 0;
+    while (pos + 2 * sizeof(uint32_t) <= size_) {
+      const size_t begin = pos;
+      uint32_t cflag;
+      do {
+        CHECK_EQ(ReadU32(base + pos), dmlc::RecordIOWriter::kMagic)
+            << "corrupted RecordIO file, invalid magic at offset " << pos;
+        const uint32_t lrec = ReadU32(base + pos + sizeof(uint32_t));
+        const size_t len = dmlc::RecordIOWriter::DecodeLength(lrec);
+        cflag = dmlc::RecordIOWriter::DecodeFlag(lrec);
+        pos += 2 * sizeof(uint32_t) + ((len + 3U) & ~static_cast<size_t>(3));
+        CHECK_LE(pos, size_) << "corrupted RecordIO file, record exceeds file size";
+      } while (cflag != 0U && cflag != 3U);
+      index_.emplace_back(begin, pos - begin);
+    }
+    munmap(ptr, size_);
+  }
+
+  bool LoadIndex(const std::string& path) {
+    std::ifstream fin(path, std::ios::binary);
+    if (!fin.is_open()) return false;
+    uint64_t magic, file_size, num_records;
+    fin.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    fin.read(reinterpret_cast<char*>(&file_size), sizeof(file_size));
+    fin.read(reinterpret_cast<char*>(&num_records), sizeof(num_records));
+    // stale sidecars (e.g. after the .rec was rewritten) are rebuilt
+    if (!fin.good() || magic != kIndexMagic || file_size != size_) return false;
+    index_.resize(num_records);
+    fin.read(reinterpret_cast<char*>(index_.data()),
+             num_records * sizeof(index_[0]));
+    if (!fin.good()) {
+      index_.clear();
+      return false;
+    }
+    return true;
+  }
+
+  void SaveIndex(const std::string& path) const {
+    std::ofstream fout(path, std::ios::binary);
+    if (!fout.is_open()) {
+      // a read-only dataset directory is fine, the index is rebuilt next time
+      LOG(INFO) << "ShuffledRecordIOSplit: cannot write " << path
+                << ", the record index will be rebuilt on the next run";
+      return;
+    }
+    const uint64_t magic = kIndexMagic;
+    const uint64_t file_size = size_;
+    const uint64_t num_records = index_.size();
+    fout.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    fout.write(reinterpret_cast<const char*>(&file_size), sizeof(file_size));
+    fout.write(reinterpret_cast<const char*>(&num_records), sizeof(num_records));
+    fout.write(reinterpret_cast<const char*>(index_.data()),
+               index_.size() * sizeof(index_[0]));
+  }
+
+  /*! \brief file descriptor of the record file */
+  int fd_;
+  /*! \brief size of the record file in bytes */
+  size_t size_;
+  /*! \brief (offset, length) of every logical record in the file */
+  std::vector<std::pair<size_t, size_t> > index_;
+  /*! \brief shuffled order of this partition's records */
+  std::vector<size_t> order_;
+  /*! \brief next position in order_ */
+  size_t cur_{0};
+  /*! \brief gather buffer the batches are read into */
+  std::vector<char> buffer_;
+  /*! \brief hinted chunk size in bytes */
+  size_t chunk_size_{8 << 20UL};
+  /*! \brief random engine driving the per-epoch permutations */
+  std::mt19937 rnd_;
+};  // class ShuffledRecordIOSplit
+
+}  // namespace io
+}  // namespace mxnet
+
+#endif  // __linux__
+
+#endif  // MXNET_IO_SHUFFLED_RECORDIO_SPLIT_H_
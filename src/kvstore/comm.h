@@ -23,16 +23,19 @@
 #ifndef MXNET_KVSTORE_COMM_H_
 #define MXNET_KVSTORE_COMM_H_
 #include <dmlc/omp.h>
+#include <cmath>
 #include <string>
 #include <algorithm>
 #include <utility>
 #include <limits>
+#include <unordered_set>
 #include <vector>
 #include <tuple>
 #include <thread>
 #include "mxnet/ndarray.h"
 #include "gradient_compression.h"
 #include "../ndarray/ndarray_function.h"
+#include "../operator/contrib/multi_sum_sq-inl.h"
 #include "../operator/tensor/sparse_retain-inl.h"
 #include "./kvstore_utils.h"
 namespace mxnet {
@@ -75,6 +78,36 @@ class Comm {
                                   const std::vector<std::pair<NDArray*, NDArray>>& dst,
                                   const int priority) = 0;
 
+  /**
+   * \brief gather equally shaped parts living on different devices into the
+   * full array on every device, concatenating along the first axis; part i
+   * becomes rows [i*n, (i+1)*n) of each destination. Combined with an
+   * operator computing a shard of its output, this runs tensor-parallel
+   * layers without frontend copy glue.
+   * \param key the identifier key
+   * \param src one part per device, all with the same shape
+   * \param dst one full-size destination per device
+   * \param priority the priority of the operation
+   */
+  virtual void AllGather(int key, const std::vector<NDArray>& src,
+                         const std::vector<NDArray*>& dst, int priority) {
+    LOG(FATAL) << "allgather is not supported by this comm implementation";
+  }
+
+  /**
+   * \brief reduce src across devices and leave each device with an equally
+   * sized slice of the sum along the first axis: dst[i] receives rows
+   * [i*n, (i+1)*n) of the reduction.
+   * \param key the identifier key
+   * \param src one full-size source per device
+   * \param dst one part per device, all with the same shape
+   * \param priority the priority of the operation
+   */
+  virtual void ReduceScatter(int key, const std::vector<NDArray>& src,
+                             const std::vector<NDArray*>& dst, int priority) {
+    LOG(FATAL) << "reduce-scatter is not supported by this comm implementation";
+  }
+
   /**
    * \brief return a pinned contex
    */
@@ -90,6 +123,15 @@ class Comm {
     gc_ = gc;
   }
 
+  /**
+   * \brief Sets the global gradient-norm clipping threshold. Zero disables
+   * clipping. Only supported by comm implementations that fuse the norm
+   * computation into the reduction.
+   */
+  virtual void SetGradientClipping(float max_norm) {
+    LOG(FATAL) << "fused gradient clipping is not supported by this comm implementation";
+  }
+
  protected:
   Context pinned_ctx_;
 
@@ -107,6 +149,8 @@ class CommCPU : public Comm {
     bigarray_bound_ = dmlc::GetEnv("MXNET_KVSTORE_BIGARRAY_BOUND", 1000 * 1000);
     // TODO(junwu) delete the following data member, now for benchmark only
     is_serial_push_ = dmlc::GetEnv("MXNET_KVSTORE_SERIAL_PUSH", 0);
+    gpu_direct_reduce_ = dmlc::GetEnv("MXNET_KVSTORE_GPU_DIRECT_REDUCE", 0);
+    parallel_rowsparse_push_ = dmlc::GetEnv("MXNET_KVSTORE_PARALLEL_ROWSPARSE_PUSH", 0);
   }
   virtual ~CommCPU() { }
 
@@ -141,6 +185,9 @@ class CommCPU : public Comm {
     NDArray& buf_merged = buf.merged_buf(stype);
     // normal dense reduce
     if (stype == kDefaultStorage) {
+      if (gpu_direct_reduce_ && AllOnGpu(src)) {
+        return ReduceOnDevice(key, src, priority);
+      }
       std::vector<Engine::VarHandle> const_vars(src.size() - 1);
       std::vector<NDArray> reduce(src.size());
       CopyFromTo(src[0], &buf_merged, priority);
@@ -195,9 +242,13 @@ class CommCPU : public Comm {
       Engine::Get()->PushAsync(
         [reduce, buf_merged, rsc, this](RunContext rctx, Engine::CallbackOnComplete on_complete) {
           NDArray out = buf_merged;
-          is_serial_push_?
-            ReduceSumCPUExSerial(reduce, &out)
-            : mxnet::ndarray::ElementwiseSum(rctx.get_stream<cpu>(), rsc, reduce, &out);
+          if (is_serial_push_) {
+            ReduceSumCPUExSerial(reduce, &out);
+          } else if (parallel_rowsparse_push_) {
+            ReduceSumCPUExParallel(reduce, &out);
+          } else {
+            mxnet::ndarray::ElementwiseSum(rctx.get_stream<cpu>(), rsc, reduce, &out);
+          }
           on_complete();
         }, Context::CPU(), const_vars, {buf_merged.var(), rsc.var},
         FnProperty::kCPUPrioritized, priority, "KVStoreReduce");
@@ -206,6 +257,42 @@ class CommCPU : public Comm {
     return buf_merged;
   }
 
+  bool AllOnGpu(const std::vector<NDArray>& src) const {
+    for (const auto& s : src) {
+      if (s.ctx().dev_mask() != gpu::kDevMask) return false;
+    }
+    return true;
+  }
+
+  /**
+   * \brief reduce dense gradients from local GPUs on the first gradient's
+   * device and stage the sum into the pinned merged buffer with a single
+   * device-to-host copy. The default path copies every GPU's gradient to
+   * the host and sums there, which moves src.size() copies over PCIe;
+   * here the peer copies stay on the device side and only the reduced
+   * value crosses to the host.
+   */
+  const NDArray& ReduceOnDevice(int key, const std::vector<NDArray>& src,
+                                int priority) {
+    auto& buf = merge_buf_[key];
+    NDArray& buf_merged = buf.merged_buf(kDefaultStorage);
+    if (buf.device_buf.empty()) {
+      buf.device_buf.resize(src.size());
+      for (size_t j = 0; j < src.size(); ++j) {
+        buf.device_buf[j] = NDArray(src[0].shape(), src[0].ctx(),
+                                    false, src[0].dtype());
+      }
+    }
+    std::vector<NDArray> reduce(src.size());
+    for (size_t i = 0; i < src.size(); ++i) {
+      CopyFromTo(src[i], &(buf.device_buf[i]), priority);
+      reduce[i] = buf.device_buf[i];
+    }
+    ElementwiseSum(reduce, &reduce[0], priority);
+    CopyFromTo(reduce[0], &buf_merged, priority);
+    return buf_merged;
+  }
+
   void Broadcast(int key, const NDArray& src,
                  const std::vector<NDArray*> dst, int priority) override {
     int mask = src.ctx().dev_mask();
@@ -267,6 +354,42 @@ class CommCPU : public Comm {
     }
   }
 
+  void AllGather(int key, const std::vector<NDArray>& src,
+                 const std::vector<NDArray*>& dst, int priority) override {
+    CHECK_EQ(src.size(), dst.size());
+    CHECK_GT(src.size(), 0U);
+    CHECK_EQ(src[0].storage_type(), kDefaultStorage)
+      << "AllGather is only supported for dense NDArrays";
+    const index_t part_rows = src[0].shape()[0];
+    // gather through a pinned staging buffer, same route as Reduce
+    auto& buf = gather_buf_[key];
+    if (buf.is_none()) {
+      buf = NDArray(dst[0]->shape(), pinned_ctx_, false, dst[0]->dtype());
+    }
+    for (size_t i = 0; i < src.size(); ++i) {
+      CHECK_EQ(src[i].shape(), src[0].shape())
+        << "AllGather expects equally shaped parts";
+      NDArray part = buf.Slice(i * part_rows, (i + 1) * part_rows);
+      CopyFromTo(src[i], &part, priority);
+    }
+    for (auto d : dst) CopyFromTo(buf, d, priority);
+  }
+
+  void ReduceScatter(int key, const std::vector<NDArray>& src,
+                     const std::vector<NDArray*>& dst, int priority) override {
+    CHECK_EQ(src.size(), dst.size());
+    CHECK_GT(src.size(), 0U);
+    CHECK_EQ(src[0].storage_type(), kDefaultStorage)
+      << "ReduceScatter is only supported for dense NDArrays";
+    const NDArray& merged = Reduce(key, src, priority);
+    const index_t part_rows = dst[0]->shape()[0];
+    for (size_t i = 0; i < dst.size(); ++i) {
+      CHECK_EQ(dst[i]->shape()[0], part_rows)
+        << "ReduceScatter expects equally shaped parts";
+      CopyFromTo(merged.Slice(i * part_rows, (i + 1) * part_rows), dst[i], priority);
+    }
+  }
+
  private:
   // reduce sum into val[0]
   inline void ReduceSumCPU(const std::vector<NDArray> &in_data) {
@@ -354,6 +477,78 @@ class CommCPU : public Comm {
     });
   }
 
+  // row-parallel implementation of reduce sum for row sparse NDArray.
+  // Each merged row is owned by exactly one worker thread, so gradients
+  // touching disjoint rows accumulate concurrently without any locking;
+  // inputs are located per row by binary search in their sorted indices.
+  inline void ReduceSumCPUExParallel(const std::vector<NDArray> &in, NDArray *out) {
+    using namespace rowsparse;
+    using namespace mshadow;
+    auto stype = out->storage_type();
+    CHECK_EQ(stype, kRowSparseStorage) << "Unexpected storage type " << stype;
+    size_t total_num_rows = 0;
+    size_t num_in = in.size();
+    // skip the ones with empty indices and values
+    std::vector<bool> skip(num_in, false);
+    MSHADOW_TYPE_SWITCH(out->dtype(), DType, {
+      MSHADOW_IDX_TYPE_SWITCH(out->aux_type(kIdx), IType, {
+        std::vector<Tensor<cpu, 2, DType>> in_vals(num_in);
+        std::vector<Tensor<cpu, 1, IType>> in_indices(num_in);
+        std::vector<size_t> num_rows(num_in, 0);
+        for (size_t i = 0; i < num_in; i++) {
+          if (!in[i].storage_initialized()) {
+            skip[i] = true;
+            continue;
+          }
+          auto size = in[i].aux_shape(kIdx).Size();
+          num_rows[i] = size;
+          total_num_rows += size;
+          in_vals[i] = in[i].data().FlatTo2D<cpu, DType>();
+          in_indices[i] = in[i].aux_data(kIdx).FlatTo1D<cpu, IType>();
+        }
+        std::vector<IType> indices;
+        indices.reserve(total_num_rows);
+        // gather indices from all inputs
+        for (size_t i = 0; i < num_in; i++) {
+          for (size_t j = 0; j < num_rows[i]; j++) {
+            indices.emplace_back(in_indices[i][j]);
+          }
+        }
+        CHECK_EQ(indices.size(), total_num_rows);
+        // dedup indices
+        std::sort(indices.begin(), indices.end());
+        indices.resize(std::unique(indices.begin(), indices.end()) - indices.begin());
+        // the one left are unique non-zero rows
+        const long nnr = static_cast<long>(indices.size());  // NOLINT(*)
+        // allocate memory for output
+        out->CheckAndAlloc({Shape1(nnr)});
+        auto idx_data = out->aux_data(kIdx).FlatTo1D<cpu, IType>();
+        auto val_data = out->data().FlatTo2D<cpu, DType>();
+
+        #pragma omp parallel for schedule(static) num_threads(nthread_reduction_)
+        for (long i = 0; i < nnr; i++) {  // NOLINT(*)
+          idx_data[i] = indices[i];
+          bool zeros = true;
+          for (size_t j = 0; j < num_in; j++) {
+            if (skip[j]) continue;
+            const IType* begin = in_indices[j].dptr_;
+            const IType* end = begin + num_rows[j];
+            const IType* pos = std::lower_bound(begin, end, indices[i]);
+            if (pos != end && *pos == indices[i]) {
+              const size_t offset = pos - begin;
+              if (zeros) {
+                Copy(val_data[i], in_vals[j][offset], nullptr);
+                zeros = false;
+              } else {
+                val_data[i] += in_vals[j][offset];
+              }
+            }
+          }
+        }
+      });
+    });
+  }
+
   template<typename DType>
   inline static void ReduceSumCPU(
       const std::vector<DType*> &dptr, size_t offset, index_t size) {
@@ -415,6 +610,8 @@ class CommCPU : public Comm {
     NDArray merged;
     /// \brief the cpu buffer for gpu data
     std::vector<NDArray> copy_buf;
+    /// \brief the gpu staging buffers for device-side reduce
+    std::vector<NDArray> device_buf;
     /// \brief the merged buffer for the given storage type
     inline NDArray& merged_buf(NDArrayStorageType stype) {
       if (stype == kDefaultStorage) {
@@ -435,9 +632,17 @@ class CommCPU : public Comm {
     NDArray sparse_merged;
   };
   std::unordered_map<int, BufferEntry> merge_buf_;
+  /// \brief pinned staging buffers for AllGather, holding the full arrays
+  std::unordered_map<int, NDArray> gather_buf_;
   size_t bigarray_bound_;
   int nthread_reduction_;
   bool is_serial_push_;
+  // whether dense gradients from GPUs are reduced on device before the
+  // single host copy, instead of copied to the host one by one
+  bool gpu_direct_reduce_;
+  // whether row sparse gradients are merged with per-row thread ownership
+  // instead of the single-threaded sparse sum
+  bool parallel_rowsparse_push_;
 };
 
 /**
@@ -511,6 +716,16 @@ class CommDevice : public Comm {
     // avoid extra copy for single device, but it may bring problems for
     // abnormal usage of kvstore
     if (src.size() == 1) {
+      // with fused clipping the lone gradient still has to go through the
+      // merge buffer: the norm epilogue reads it there and the following
+      // broadcast rescales it there
+      if (clip_max_norm_ > 0.0f && src[0].storage_type() == kDefaultStorage) {
+        InitBuffersAndComm(src);
+        NDArray& buf_merged = merge_buf_[key].merged_buf(kDefaultStorage);
+        CopyFromTo(src[0], &buf_merged, priority);
+        ReduceNormEpilogue(key, buf_merged, priority);
+        return buf_merged;
+      }
       return src[0];
     }
 
@@ -542,6 +757,9 @@ class CommDevice : public Comm {
         reduce[i+1] = buf.copy_buf[i];
       }
       ElementwiseSum(reduce, &buf_merged, priority);
+      if (clip_max_norm_ > 0.0f) {
+        ReduceNormEpilogue(key, buf_merged, priority);
+      }
     } else {
       // sparse reduce
       buf_merged = ReduceRowSparse(key, src, priority);
@@ -549,6 +767,67 @@ class CommDevice : public Comm {
     return buf_merged;
   }
 
+  void SetGradientClipping(float max_norm) override {
+    clip_max_norm_ = max_norm;
+  }
+
+  /**
+   * \brief computes the squared norm of a freshly reduced gradient while it
+   * is still warm in cache, so global norm clipping needs no separate pass
+   * over all gradients
+   */
+  void ReduceNormEpilogue(int key, const NDArray& merged, int priority) {
+    CHECK_EQ(merged.dtype(), mshadow::kFloat32)
+        << "fused gradient clipping expects float32 gradients";
+    auto& buf = merge_buf_[key];
+    if (buf.sum_sq.is_none()) {
+      buf.sum_sq = NDArray(mshadow::Shape1(1), merged.ctx(), false, mshadow::kFloat32);
+    }
+    NDArray sum_sq = buf.sum_sq;
+    Engine::Get()->PushAsync(
+      [merged, sum_sq](RunContext rctx, Engine::CallbackOnComplete on_complete) {
+        std::vector<TBlob> inputs{merged.data()};
+        float* out_ptr = sum_sq.data().dptr<float>();
+        switch (merged.ctx().dev_mask()) {
+          case cpu::kDevMask: {
+            op::MultiSumSqRun<cpu>(inputs, 1, out_ptr, rctx.get_stream<cpu>());
+            break;
+          }
+#if MXNET_USE_CUDA
+          case gpu::kDevMask: {
+            mshadow::Stream<gpu>* s = rctx.get_stream<gpu>();
+            op::MultiSumSqRun<gpu>(inputs, 1, out_ptr, s);
+            s->Wait();
+            break;
+          }
+#endif
+          default: LOG(FATAL) << MXNET_GPU_NOT_ENABLED_ERROR;
+        }
+        on_complete();
+      }, merged.ctx(), {merged.var()}, {sum_sq.var()},
+      FnProperty::kNormal, priority, "KVStoreGradNorm");
+    norm_pending_keys_.push_back(key);
+  }
+
+  /**
+   * \brief folds the per-key squared norms accumulated during reduction into
+   * the global clipping scale for this step. Synchronizes on the scalar norm
+   * values only; the gradients themselves stay asynchronous.
+   */
+  void FinalizeGradientClipping() {
+    float total = 0.0f;
+    for (int key : norm_pending_keys_) {
+      float sum_sq = 0.0f;
+      merge_buf_[key].sum_sq.SyncCopyToCPU(&sum_sq, 1);
+      total += sum_sq;
+    }
+    const float norm = std::sqrt(total);
+    clip_scale_ = norm > clip_max_norm_ ? clip_max_norm_ / norm : 1.0f;
+    scale_pending_keys_.clear();
+    scale_pending_keys_.insert(norm_pending_keys_.begin(), norm_pending_keys_.end());
+    norm_pending_keys_.clear();
+  }
+
   const NDArray& ReduceCompressed(int key, const std::vector<NDArray>& src,
                                   int priority) {
     InitBuffersAndComm(src);
@@ -607,8 +886,15 @@ class CommDevice : public Comm {
         }
       }
     } else {
+      if (clip_max_norm_ > 0.0f && !norm_pending_keys_.empty()) {
+        FinalizeGradientClipping();
+      }
       auto& buf_merged = merge_buf_[key].merged_buf(src.storage_type());
       CopyFromTo(src, &buf_merged, priority);
+      if (scale_pending_keys_.erase(key) && clip_scale_ != 1.0f) {
+        // scale once in the merge buffer instead of once per destination
+        buf_merged *= clip_scale_;
+      }
       for (auto d : dst) {
         CopyFromTo(buf_merged, d, priority);
       }
@@ -673,6 +959,42 @@ class CommDevice : public Comm {
     }
   }
 
+  void AllGather(int key, const std::vector<NDArray>& src,
+                 const std::vector<NDArray*>& dst, int priority) override {
+    CHECK_EQ(src.size(), dst.size());
+    CHECK_GT(src.size(), 0U);
+    CHECK_EQ(src[0].storage_type(), kDefaultStorage)
+      << "AllGather is only supported for dense NDArrays";
+    InitBuffersAndComm(src);
+    const index_t part_rows = src[0].shape()[0];
+    // each part is copied peer-to-peer into its slice of every
+    // destination; the writes serialize on the destination's var, so
+    // readers of the gathered array see it complete
+    for (size_t i = 0; i < src.size(); ++i) {
+      CHECK_EQ(src[i].shape(), src[0].shape())
+        << "AllGather expects equally shaped parts";
+      for (auto d : dst) {
+        NDArray part = d->Slice(i * part_rows, (i + 1) * part_rows);
+        CopyFromTo(src[i], &part, priority);
+      }
+    }
+  }
+
+  void ReduceScatter(int key, const std::vector<NDArray>& src,
+                     const std::vector<NDArray*>& dst, int priority) override {
+    CHECK_EQ(src.size(), dst.size());
+    CHECK_GT(src.size(), 0U);
+    CHECK_EQ(src[0].storage_type(), kDefaultStorage)
+      << "ReduceScatter is only supported for dense NDArrays";
+    const NDArray& merged = Reduce(key, src, priority);
+    const index_t part_rows = dst[0]->shape()[0];
+    for (size_t i = 0; i < dst.size(); ++i) {
+      CHECK_EQ(dst[i]->shape()[0], part_rows)
+        << "ReduceScatter expects equally shaped parts";
+      CopyFromTo(merged.Slice(i * part_rows, (i + 1) * part_rows), dst[i], priority);
+    }
+  }
+
   using KeyAttrs = std::tuple<int, mxnet::TShape, int>;
   // try to allocate buff on device evenly
   void InitMergeBuffer(const std::vector<Context>& devs) {
@@ -760,6 +1082,9 @@ class CommDevice : public Comm {
   struct BufferEntry {
     /// \brief the dense merged value for reduce and broadcast operations
     NDArray merged;
+    /// \brief scalar squared norm of merged, filled by the reduce epilogue
+    /// when fused gradient clipping is enabled
+    NDArray sum_sq;
     /// \brief the gpu buffer for copy during reduce operation
     std::vector<NDArray> copy_buf;
     /// \brief the residual buffer for gradient compression
@@ -790,6 +1115,14 @@ class CommDevice : public Comm {
     NDArray sparse_merged;
   };
   std::unordered_map<int, BufferEntry> merge_buf_;
+  /// \brief global gradient-norm clipping threshold, 0 means disabled
+  float clip_max_norm_{0.0f};
+  /// \brief scale derived from the last finalized global norm
+  float clip_scale_{1.0f};
+  /// \brief keys reduced since the clipping scale was last finalized
+  std::vector<int> norm_pending_keys_;
+  /// \brief keys whose merge buffer still needs scaling this step
+  std::unordered_set<int> scale_pending_keys_;
 
  public:
   bool inited_;
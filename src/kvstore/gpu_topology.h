@@ -239,8 +239,17 @@ inline void GetP2PWeight(const std::vector<Context>& devs,
       matrix_value = (matrix_value == 1) ? 0 : matrix_value;
     }
   } else {
-    for (auto& matrix_value : *matrix) {
-      matrix_value = (matrix_value == 1) ? 1./num_gpus : matrix_value;
+    // The NVLink graph splits into islands connected only by PCI-E. All
+    // PCI-E links used to get the same weight, so the one cross-island
+    // exchange in each tree could land on a link routed through the CPU even
+    // when a GPUDirect-capable link exists. Rank GPUDirect PCI-E above
+    // CPU-routed PCI-E so the partitioner cuts between islands (both weights
+    // stay far below NVLink) and the spanning step picks a direct link for
+    // the inter-island hop.
+    for (unsigned i = 0; i < matrix->size(); ++i) {
+      if ((*matrix)[i] == 1) {
+        (*matrix)[i] = (p2p_matrix[i] > 0) ? 2./num_gpus : 1./num_gpus;
+      }
     }
   }
   if (kLogTree)
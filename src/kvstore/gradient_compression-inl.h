@@ -25,6 +25,12 @@
 #ifndef MXNET_KVSTORE_GRADIENT_COMPRESSION_INL_H_
 #define MXNET_KVSTORE_GRADIENT_COMPRESSION_INL_H_
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <unordered_set>
 #include <vector>
 #include "../operator/mxnet_op.h"
 
@@ -149,6 +155,89 @@ inline void Dequantize2BitImpl(mshadow::Stream<mshadow::cpu> *s,
                                const float threshold) {
   Dequantize2BitKernelLaunch(s, inputs, threshold);
 }
+
+/*!
+ * \brief compresses a gradient into k (index, value) pairs with error feedback.
+ * inputs[0] is the original gradient, inputs[1] the residual carrying the
+ * accumulated compression error, inputs[2] the compressed output of 2*k floats.
+ * The gradient is first added into the residual; then either the k largest
+ * magnitude entries (select_topk) or k uniformly sampled entries are emitted
+ * and zeroed in the residual, so everything not sent this round is retried in
+ * later rounds. Indices are stored as uint32 bit patterns in the float slots
+ * since float32 cannot represent positions above 2^24 exactly.
+ */
+inline void QuantizeSparseKImpl(mshadow::Stream<mshadow::cpu> *s,
+                                const std::vector<mxnet::TBlob> &inputs,
+                                const bool select_topk) {
+  float *grad = inputs[0].dptr<float>();
+  float *residual = inputs[1].dptr<float>();
+  float *out = inputs[2].dptr<float>();
+  const int64_t original_size = inputs[0].Size();
+  const int64_t k = inputs[2].Size() / 2;
+  CHECK_LE(static_cast<uint64_t>(original_size),
+           static_cast<uint64_t>(std::numeric_limits<uint32_t>::max()))
+    << "sparse-k gradient compression supports at most 2^32 elements per key";
+  // error feedback: accumulate this round's gradient into the residual
+  #pragma omp parallel for
+  for (int64_t i = 0; i < original_size; ++i) {
+    residual[i] += grad[i];
+  }
+  std::vector<int64_t> selected;
+  if (select_topk) {
+    std::vector<int64_t> index(original_size);
+    std::iota(index.begin(), index.end(), 0);
+    const int64_t nth = std::min(k, original_size);
+    std::nth_element(index.begin(), index.begin() + nth - 1, index.end(),
+      [residual](int64_t a, int64_t b) {
+        return std::abs(residual[a]) > std::abs(residual[b]);
+      });
+    selected.assign(index.begin(), index.begin() + nth);
+  } else {
+    // sample k distinct positions; expected O(k) draws since k << size
+    static thread_local std::mt19937 rng(std::random_device{}());
+    std::uniform_int_distribution<int64_t> dist(0, original_size - 1);
+    std::unordered_set<int64_t> picked;
+    while (picked.size() < static_cast<size_t>(std::min(k, original_size))) {
+      picked.insert(dist(rng));
+    }
+    selected.assign(picked.begin(), picked.end());
+  }
+  for (int64_t i = 0; i < k; ++i) {
+    if (i < static_cast<int64_t>(selected.size())) {
+      const uint32_t pos = static_cast<uint32_t>(selected[i]);
+      std::memcpy(out + 2 * i, &pos, sizeof(pos));
+      out[2 * i + 1] = residual[selected[i]];
+      residual[selected[i]] = 0.0f;
+    } else {
+      // pad when the array is smaller than k
+      const uint32_t pos = 0;
+      std::memcpy(out + 2 * i, &pos, sizeof(pos));
+      out[2 * i + 1] = 0.0f;
+    }
+  }
+}
+
+/*!
+ * \brief expands k (index, value) pairs back into a dense gradient.
+ * inputs[0] is the compressed array of 2*k floats, inputs[1] the dense output,
+ * which is zeroed first; duplicate indices (padding, random-k collisions
+ * across pairs do not occur but padding repeats index 0) accumulate.
+ */
+inline void DequantizeSparseKImpl(mshadow::Stream<mshadow::cpu> *s,
+                                  const std::vector<mxnet::TBlob> &inputs) {
+  const float *in = inputs[0].dptr<float>();
+  float *out = inputs[1].dptr<float>();
+  const int64_t original_size = inputs[1].Size();
+  const int64_t k = inputs[0].Size() / 2;
+  std::memset(out, 0, original_size * sizeof(float));
+  for (int64_t i = 0; i < k; ++i) {
+    uint32_t pos;
+    std::memcpy(&pos, in + 2 * i, sizeof(pos));
+    CHECK_LT(static_cast<int64_t>(pos), original_size)
+      << "corrupt index in sparse-k compressed gradient";
+    out[pos] += in[2 * i + 1];
+  }
+}
 }  // namespace kvstore
 }  // namespace mxnet
 
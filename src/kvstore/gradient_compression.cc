@@ -23,6 +23,8 @@
  * \author Rahul Huilgol
  */
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include "kvstore_local.h"
 #include "gradient_compression.h"
@@ -44,9 +46,18 @@ void GradientCompression::SetParams(const std::vector<std::pair<std::string, std
   CHECK_GT(params.threshold, 0) << "threshold must be greater than 0";
   if (params.type == "2bit") {
     SetTwoBitCompression(params.threshold);
+  } else if (params.type == "topk") {
+    CHECK(params.density > 0 && params.density <= 1)
+      << "density must be in (0, 1] for topk gradient compression";
+    SetTopKCompression(params.density);
+  } else if (params.type == "randomk") {
+    CHECK(params.density > 0 && params.density <= 1)
+      << "density must be in (0, 1] for randomk gradient compression";
+    SetRandomKCompression(params.density);
   } else {
     LOG(FATAL) << "Unknown type for gradient compression " << params.type;
   }
+  size_threshold_ = params.size_threshold;
 }
 
 CompressionType GradientCompression::get_type() {
@@ -62,11 +73,33 @@ void GradientCompression::SetTwoBitCompression(const float threshold) {
   threshold_ = threshold;
 }
 
+void GradientCompression::SetTopKCompression(const float density) {
+  type_ = CompressionType::kTopK;
+  density_ = density;
+}
+
+void GradientCompression::SetRandomKCompression(const float density) {
+  type_ = CompressionType::kRandomK;
+  density_ = density;
+}
+
+bool GradientCompression::ShouldCompress(const size_t num_elem) {
+  return num_elem >= size_threshold_;
+}
+
+bool GradientCompression::SupportsSharding() {
+  // (index, value) encodings carry positions absolute within the key and
+  // cannot be split across servers; the positional 2bit encoding can
+  return type_ != CompressionType::kTopK && type_ != CompressionType::kRandomK;
+}
+
 std::string GradientCompression::EncodeParams() {
   using namespace std;  // to reduce length of next line
   string rval = get_type_str();
   if (type_ == CompressionType::kTwoBit) {
     rval += "," + to_string(threshold_);
+  } else if (type_ == CompressionType::kTopK || type_ == CompressionType::kRandomK) {
+    rval += "," + to_string(threshold_) + "," + to_string(density_);
   }
   return rval;
 }
@@ -80,6 +113,11 @@ void GradientCompression::DecodeParams(const std::string &s) {
       threshold_ = stof(elems[1]);
     }
   }
+  if (elems.size() > 2) {
+    if (!elems[2].empty()) {
+      density_ = stof(elems[2]);
+    }
+  }
 }
 
 int GradientCompression::GetCompressionFactor() {
@@ -92,6 +130,12 @@ int GradientCompression::GetCompressionFactor() {
 }
 
 int64_t GradientCompression::GetCompressedSize(const int64_t original_size) {
+  if (type_ == CompressionType::kTopK || type_ == CompressionType::kRandomK) {
+    // k (index, value) pairs
+    const int64_t k = std::max<int64_t>(
+        1, static_cast<int64_t>(llround(original_size * static_cast<double>(density_))));
+    return 2 * std::min(k, original_size);
+  }
   const int bits = GetCompressionFactor();
   return ((original_size % bits == 0) ?
           original_size / bits :
@@ -130,6 +174,19 @@ void GradientCompression::Quantize(const mxnet::NDArray &from, mxnet::NDArray *t
     LOG(FATAL) << MXNET_GPU_NOT_ENABLED_ERROR;
 #endif
     }
+  } else if (type_ == CompressionType::kTopK || type_ == CompressionType::kRandomK) {
+    const bool select_topk = (type_ == CompressionType::kTopK);
+    if (a == mshadow::cpu::kDevMask && b == mshadow::cpu::kDevMask) {
+      mxnet::Engine::Get()->PushSync([from, to, residual, select_topk](mxnet::RunContext ctx) {
+        std::vector<mxnet::TBlob> inputs = {from.data(), residual->data(), to->data()};
+        QuantizeSparseKImpl(ctx.get_stream<mshadow::cpu>(), inputs, select_topk);
+      }, from.ctx(), {from.var()}, {to->var(), residual->var()},
+      mxnet::FnProperty::kNormal, priority, "QuantizeSparseKCPU");
+    } else {
+      // in the dist kvstore compression always runs on the pinned CPU
+      // staging buffers, so a device implementation has not been needed
+      LOG(FATAL) << "topk and randomk gradient compression are CPU only";
+    }
   } else {
     LOG(FATAL) << "Unsupported quantization of type " << get_type_str();
   }
@@ -166,6 +223,16 @@ void GradientCompression::Dequantize(const mxnet::NDArray &from, mxnet::NDArray
       LOG(FATAL) << MXNET_GPU_NOT_ENABLED_ERROR;
 #endif
     }
+  } else if (type_ == CompressionType::kTopK || type_ == CompressionType::kRandomK) {
+    if (a == mshadow::cpu::kDevMask && b == mshadow::cpu::kDevMask) {
+      mxnet::Engine::Get()->PushSync([from, to](mxnet::RunContext ctx) {
+        std::vector<mxnet::TBlob> inputs = {from.data(), to->data()};
+        DequantizeSparseKImpl(ctx.get_stream<mshadow::cpu>(), inputs);
+      }, from.ctx(), {from.var()}, {to->var()},
+      mxnet::FnProperty::kNormal, priority, "DequantizeSparseKCPU");
+    } else {
+      LOG(FATAL) << "topk and randomk gradient compression are CPU only";
+    }
   } else {
     LOG(FATAL) << "Unsupported dequantization of type " << get_type_str();
   }
@@ -35,17 +35,25 @@ namespace mxnet {
 namespace kvstore {
 
 enum class CompressionType {
-  kNone, kTwoBit
+  kNone, kTwoBit, kTopK, kRandomK
 };
 
 struct GradientCompressionParam : public dmlc::Parameter<GradientCompressionParam> {
   std::string type;
   float threshold;
+  float density;
+  uint64_t size_threshold;
   DMLC_DECLARE_PARAMETER(GradientCompressionParam) {
     DMLC_DECLARE_FIELD(type)
-      .describe("Type of gradient compression to use, like `2bit` for example");
+      .describe("Type of gradient compression to use, like `2bit`, "
+                "`topk` or `randomk`");
     DMLC_DECLARE_FIELD(threshold).set_default(0.5)
       .describe("Threshold to use for 2bit gradient compression");
+    DMLC_DECLARE_FIELD(density).set_default(0.01)
+      .describe("Fraction of gradient entries sent per round by topk and "
+                "randomk compression");
+    DMLC_DECLARE_FIELD(size_threshold).set_default(0)
+      .describe("Keys with fewer elements than this are sent uncompressed");
   }
 };
 
@@ -78,6 +86,31 @@ class GradientCompression {
    */
   void SetTwoBitCompression(const float threshold);
 
+  /*!
+   * \brief sets top-k sparsification with error feedback
+   * \param density fraction of entries sent per round
+   */
+  void SetTopKCompression(const float density);
+
+  /*!
+   * \brief sets random-k sparsification with error feedback
+   * \param density fraction of entries sent per round
+   */
+  void SetRandomKCompression(const float density);
+
+  /*!
+   * \brief whether a key of this size should be compressed; keys below
+   * the configured size threshold travel uncompressed
+   */
+  bool ShouldCompress(const size_t num_elem);
+
+  /*!
+   * \brief whether the compressed representation may be split across
+   * servers. Positional encodings like 2bit can; (index, value) pair
+   * encodings carry absolute positions and cannot.
+   */
+  bool SupportsSharding();
+
   /*!
    * \brief encodes parameters of gc into a string
    */
@@ -132,6 +165,16 @@ class GradientCompression {
    * all negative gradients will be thresholded to -1*`threshold_`
    */
   float threshold_ = 0;
+
+  /*!
+   * \brief fraction of entries sent per round by the sparsifying types
+   */
+  float density_ = 0;
+
+  /*!
+   * \brief keys with fewer elements than this are sent uncompressed
+   */
+  uint64_t size_threshold_ = 0;
 };
 }  // namespace kvstore
 }  // namespace mxnet
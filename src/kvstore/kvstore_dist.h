@@ -27,6 +27,15 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include "./kvstore_local.h"
 #include "mxnet/engine.h"
@@ -57,10 +66,41 @@ class KVStoreDist : public KVStoreLocal {
     }
     bigarray_bound_ = dmlc::GetEnv("MXNET_KVSTORE_BIGARRAY_BOUND", 1000 * 1000);
     log_verbose_ = dmlc::GetEnv("MXNET_KVSTORE_DIST_ROW_SPARSE_VERBOSE", false);
+    bucket_size_ = dmlc::GetEnv("MXNET_KVSTORE_BUCKET_SIZE", 0);
+    priority_send_ = dmlc::GetEnv("MXNET_KVSTORE_PRIORITY_SEND", false);
+    if (IsWorkerNode() && priority_send_) {
+      sender_ = std::thread(&KVStoreDist::SenderLoop, this);
+    }
+    const std::string wire = dmlc::GetEnv("MXNET_KVSTORE_WIRE_DTYPE", std::string("off"));
+    if (wire == "float16") {
+      wire_dtype_ = mshadow::kFloat16;
+    } else {
+      CHECK_EQ(wire, "off") << "unknown MXNET_KVSTORE_WIRE_DTYPE " << wire
+                            << ", valid values are off and float16";
+      wire_dtype_ = -1;
+    }
+    if (IsWorkerNode() && wire_dtype_ != -1 &&
+        get_rank() == 0 && ps_worker_->get_customer()->customer_id() == 0) {
+      // have the servers accumulate the half precision wire messages into a
+      // float32 master copy instead of updating in the wire dtype
+      SendCommandToServers(static_cast<int>(CommandType::kSetMultiPrecision), "");
+    }
+    bulk_init_ = dmlc::GetEnv("MXNET_KVSTORE_BULK_INIT", false);
+    light_barrier_ = dmlc::GetEnv("MXNET_KVSTORE_LIGHT_BARRIER", false);
+    balanced_sharding_ = dmlc::GetEnv("MXNET_KVSTORE_BALANCED_SHARDING", false);
+    delta_pull_ = dmlc::GetEnv("MXNET_KVSTORE_DELTA_PULL", false);
   }
 
   virtual ~KVStoreDist() {
     Engine::Get()->WaitForAll();
+    if (sender_.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        sender_stop_ = true;
+      }
+      send_cv_.notify_all();
+      sender_.join();
+    }
     customer_id_ = 0;
     if (IsWorkerNode()) {
       if (barrier_before_exit_) {
@@ -103,6 +143,14 @@ class KVStoreDist : public KVStoreLocal {
 
 
   void Barrier() override {
+    if (light_barrier_) {
+      // counting barrier held open by the servers until every worker has
+      // arrived; saves the scheduler round trips of the Postoffice barrier
+      CHECK_NOTNULL(ps_worker_);
+      ps_worker_->Wait(ps_worker_->Request(
+          static_cast<int>(CommandType::kBarrier), "", ps::kServerGroup));
+      return;
+    }
     ps::Postoffice::Get()->Barrier(ps_worker_->get_customer()->customer_id(), ps::kWorkerGroup);
   }
 
@@ -190,13 +238,36 @@ class KVStoreDist : public KVStoreLocal {
     CheckUnique(keys);
     for (size_t i = 0; i < keys.size(); ++i) {
       comm_->Init(keys[i], values[i].storage_type(), values[i].shape(), values[i].dtype());
+      // every worker assigns keys to buckets in the same init order, so the
+      // fused layout is identical across the cluster
+      if (BucketEligible(values[i])) AssignToBucket(keys[i], values[i]);
+      if (balanced_sharding_) AssignKeyHome(keys[i], values[i]);
     }
     if (get_rank() == 0 && this->ps_worker_->get_customer()->customer_id() == 0) {
-      Push_(keys, values, 0, false);
-      // wait until the push is finished
-      for (const int key : keys) {
-        comm_buf_[key].WaitToWrite();
-        compr_buf_[key].WaitToWrite();
+      std::vector<int> slow_keys;
+      std::vector<NDArray> slow_vals;
+      std::vector<int> bulk_keys;
+      std::vector<NDArray> bulk_vals;
+      for (size_t i = 0; i < keys.size(); ++i) {
+        if (BulkInitEligible(values[i]) && key_bucket_.find(keys[i]) == key_bucket_.end()) {
+          bulk_keys.push_back(keys[i]);
+          bulk_vals.push_back(values[i]);
+        } else {
+          slow_keys.push_back(keys[i]);
+          slow_vals.push_back(values[i]);
+        }
+      }
+      if (!bulk_keys.empty()) {
+        BulkInitPush(bulk_keys, bulk_vals);
+      }
+      if (!slow_keys.empty()) {
+        Push_(slow_keys, slow_vals, 0, false);
+        // wait until the push is finished
+        for (const int key : slow_keys) {
+          comm_buf_[key].WaitToWrite();
+          compr_buf_[key].WaitToWrite();
+          wire_buf_[key].WaitToWrite();
+        }
       }
     } else {
       // do nothing
@@ -206,6 +277,69 @@ class KVStoreDist : public KVStoreLocal {
     }
   }
 
+  /**
+   * \brief whether a key may be initialized through the fused bulk init
+   * message. Only small dense keys qualify: they live whole on a single
+   * server, so one message per server can carry them all. Big, compressed
+   * or wire-cast keys keep the per-key init path, whose layout the later
+   * pushes and pulls rely on.
+   */
+  bool BulkInitEligible(const NDArray& value) const {
+    return bulk_init_ && wire_dtype_ == -1 &&
+           gradient_compression_->get_type() == CompressionType::kNone &&
+           value.storage_type() == kDefaultStorage &&
+           value.shape().Size() < bigarray_bound_;
+  }
+
+  /**
+   * \brief initialize many small dense keys with one synchronous push per
+   * (home server, dtype) group instead of one round trip per key
+   */
+  void BulkInitPush(const std::vector<int>& keys, const std::vector<NDArray>& values) {
+    const auto& krs = ps::Postoffice::Get()->GetServerKeyRanges();
+    const int num_servers = krs.size();
+    CHECK_GT(num_servers, 0);
+    // group by the same single-server placement EncodeDefaultKey uses
+    std::map<std::pair<int, int>, std::vector<size_t> > groups;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      const int server = KeyHomeServer(keys[i], num_servers);
+      groups[std::make_pair(server, values[i].dtype())].push_back(i);
+    }
+    for (auto& group : groups) {
+      const int server = group.first.first;
+      const int dtype = group.first.second;
+      const int num_bytes = mshadow::mshadow_sizeof(dtype);
+      auto& members = group.second;
+      // ps-lite requires keys in ascending order within a message
+      std::sort(members.begin(), members.end(),
+                [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+      size_t total_elems = 0;
+      for (const size_t idx : members) {
+        total_elems += values[idx].shape().Size();
+      }
+      NDArray flat(mxnet::TShape({static_cast<nnvm::dim_t>(total_elems)}),
+                   pinned_ctx_, false, dtype);
+      ps::SArray<ps::Key> ps_keys;
+      ps::SArray<int> lens;
+      size_t offset = 0;
+      for (const size_t idx : members) {
+        const size_t num_elems = values[idx].shape().Size();
+        NDArray slice = flat.Slice(offset, offset + num_elems).Reshape(values[idx].shape());
+        CopyFromTo(values[idx], &slice);
+        ps::Key ps_key = krs[server].begin() + keys[idx];
+        CHECK_LT(ps_key, krs[server].end());
+        ps_keys.push_back(ps_key);
+        lens.push_back(num_elems * num_bytes);
+        offset += num_elems;
+      }
+      flat.WaitToRead();
+      ps::SArray<char> vals(static_cast<char*>(flat.data().dptr_),
+                            total_elems * num_bytes, false);
+      const int cmd = GetCommandType(RequestType::kBulkInitPushPull, dtype);
+      CHECK_NOTNULL(ps_worker_)->Wait(ps_worker_->ZPush(ps_keys, vals, lens, cmd));
+    }
+  }
+
   void PushPullImpl(const std::vector<int>& vkeys,
                     const std::vector<int>& okeys,
                     const std::vector<NDArray>& values,
@@ -216,6 +350,7 @@ class KVStoreDist : public KVStoreLocal {
     std::vector<std::vector<NDArray>> grouped_vals;
     std::vector<std::vector<NDArray*>> grouped_outs;
 
+    SealPendingBuckets();
     GroupKVPairsPush(vkeys, values, &uniq_vkeys, &grouped_vals, false);
     GroupKVPairsPull(okeys, outputs, &uniq_okeys, &grouped_outs, true);
     CHECK_EQ(uniq_vkeys.size(), uniq_okeys.size())
@@ -241,6 +376,16 @@ class KVStoreDist : public KVStoreLocal {
       const int pull_dtype = outs[0]->dtype();
       CHECK_EQ(push_dtype, pull_dtype) << "Output buffer dtype is different";
 
+      auto bucket_it = key_bucket_.find(key);
+      if (bucket_it != key_bucket_.end()) {
+        GradBucket& bucket = buckets_[bucket_it->second];
+        // the fused push is submitted before the fused pull when the last
+        // member of the bucket arrives, so the engine orders them correctly
+        HandleBucketPush(&bucket, key, merged, priority);
+        HandleBucketPull(&bucket, key, outs, priority);
+        continue;
+      }
+
       auto &comm_buf = comm_buf_[key];
       if (merged.ctx().dev_mask() == cpu::kDevMask) {
         comm_buf = merged;  // avoid memory copy
@@ -253,30 +398,42 @@ class KVStoreDist : public KVStoreLocal {
 
       CHECK(gradient_compression_->get_type() == CompressionType::kNone)
                << "Compression not supported with PushPull";
-      auto pushpull = [this, key, comm_buf](
+      // the round trip travels in the wire dtype when enabled; narrow the
+      // merged gradient before sending, widen the pulled weights after
+      NDArray wire_buf = comm_buf;
+      if (WireCastEligible(comm_buf)) {
+        wire_buf = WireBuf(key, comm_buf);
+        CopyFromTo(comm_buf, &wire_buf, priority);
+      }
+      auto pushpull = [this, key, wire_buf, priority](
           RunContext rctx, Engine::CallbackOnComplete cb) {
-        size_t size = comm_buf.shape().Size();
-        const int dtype = comm_buf.dtype();
+        size_t size = wire_buf.shape().Size();
+        const int dtype = wire_buf.dtype();
         const int num_bytes = mshadow::mshadow_sizeof(dtype);
         const int cmd = GetCommandType(RequestType::kDefaultPushPull, dtype);
 
-        PSKV& pskv = EncodeDefaultKey(key, size, num_bytes);
-        char* data = static_cast<char*>(comm_buf.data().dptr_);
+        PSKV* pskv = &EncodeDefaultKey(key, size, num_bytes);
+        char* data = static_cast<char*>(wire_buf.data().dptr_);
         auto vals = new ps::SArray<char>(data, size * num_bytes, false);
 
-        CHECK_NOTNULL(ps_worker_)->ZPushPull(
-          pskv.keys, *vals, vals, &pskv.lens, cmd, [vals, cb](){ delete vals; cb(); });
+        EnqueueSend(priority, [this, pskv, wire_buf, vals, cmd, cb]() {
+          CHECK_NOTNULL(ps_worker_)->ZPushPull(
+            pskv->keys, *vals, vals, &pskv->lens, cmd, [vals, cb](){ delete vals; cb(); });
+        });
       };
 
       CHECK_NOTNULL(Engine::Get())->PushAsync(
           pushpull,
           pinned_ctx_,
           {},
-          {comm_buf.var()},
+          {wire_buf.var()},
           FnProperty::kNormal,
           priority,
           "KVStoreDistDefaultStoragePushPull");
 
+      if (wire_buf.var() != comm_buf.var()) {
+        CopyFromTo(wire_buf, &comm_buf, priority);
+      }
       comm_->Broadcast(key, comm_buf, outs, priority);
     }
   }
@@ -284,6 +441,7 @@ class KVStoreDist : public KVStoreLocal {
   void PushImpl(const std::vector<int>& keys,
                 const std::vector<NDArray>& values,
                 int priority) override {
+    SealPendingBuckets();
     Push_(keys, values, priority, true);
   }
 
@@ -291,12 +449,18 @@ class KVStoreDist : public KVStoreLocal {
                 const std::vector<NDArray*>& values,
                 int priority, bool ignore_sparse) override {
     CHECK(ignore_sparse) << "dist kvstore pull doesn't support ignore_sparse=False";
+    SealPendingBuckets();
     std::vector<int> uniq_keys;
     std::vector<std::vector<NDArray*> > grouped_vals;
     GroupKVPairsPull(keys, values, &uniq_keys, &grouped_vals, true);
 
     for (size_t i = 0; i < uniq_keys.size(); ++i) {
       int key = uniq_keys[i];
+      auto bucket_it = key_bucket_.find(key);
+      if (bucket_it != key_bucket_.end()) {
+        HandleBucketPull(&buckets_[bucket_it->second], key, grouped_vals[i], priority);
+        continue;
+      }
       // use the same array for merging to guarantee that pull always happens
       // after the previous push on this key
       auto& recv_buf = comm_buf_[key];
@@ -308,35 +472,51 @@ class KVStoreDist : public KVStoreLocal {
         recv_buf = NDArray(grouped_vals[i][0]->shape(), pinned_ctx_,
                            true, grouped_vals[i][0]->dtype());
       }
-      auto pull_from_servers = [this, key, recv_buf](
+      // pulls travel in the wire dtype when enabled and are widened locally
+      const NDArray pull_buf =
+          WireCastEligible(recv_buf) ? WireBuf(key, recv_buf) : recv_buf;
+      auto pull_from_servers = [this, key, pull_buf, priority](
           RunContext rctx, Engine::CallbackOnComplete cb) {
         // convert to ps keys
-        size_t size = recv_buf.shape().Size();
-        const int dtype = recv_buf.dtype();
+        size_t size = pull_buf.shape().Size();
+        const int dtype = pull_buf.dtype();
         const int num_bytes = mshadow::mshadow_sizeof(dtype);
-        PSKV& pskv = (gradient_compression_->get_type() == CompressionType::kNone) ?
-                      EncodeDefaultKey(key, size, num_bytes) :
-                      EncodeCompressedKey(key, size, false, num_bytes);
-        char* data = static_cast<char*> (recv_buf.data().dptr_);
+        // match the push-side decision: compression applies only above the
+        // compressor's size threshold
+        const bool compressed =
+            gradient_compression_->get_type() != CompressionType::kNone &&
+            gradient_compression_->ShouldCompress(size);
+        // the encoded pskv lives in ps_kv_ and stays valid until the
+        // response arrives
+        PSKV* pskv = compressed ?
+                      &EncodeCompressedKey(key, size, false, num_bytes) :
+                      &EncodeDefaultKey(key, size, num_bytes);
+        char* data = static_cast<char*> (pull_buf.data().dptr_);
         // false means not to delete data when SArray is deleted
         auto vals = new ps::SArray<char>(data, size * num_bytes, false);
         // issue pull
-        RequestType mode = (gradient_compression_->get_type() != CompressionType::kNone) ?
+        RequestType mode = compressed ?
                   RequestType::kCompressedPushPull : RequestType::kDefaultPushPull;
         const int cmd = GetCommandType(mode, dtype);
-        CHECK_NOTNULL(ps_worker_)->ZPull(
-          pskv.keys, vals, &pskv.lens, cmd, [vals, cb](){ delete vals; cb(); });
+        EnqueueSend(priority, [this, pskv, pull_buf, vals, cmd, cb]() {
+          CHECK_NOTNULL(ps_worker_)->ZPull(
+            pskv->keys, vals, &pskv->lens, cmd, [vals, cb](){ delete vals; cb(); });
+        });
       };
 
       CHECK_NOTNULL(Engine::Get())->PushAsync(
           pull_from_servers,
           pinned_ctx_,
           {},
-          {recv_buf.var()},
+          {pull_buf.var()},
           FnProperty::kNormal,
           priority,
           "KVStoreDistDefaultStoragePull");
 
+      if (pull_buf.var() != recv_buf.var()) {
+        // widen back to float32 before handing out
+        CopyFromTo(pull_buf, &recv_buf, priority);
+      }
       comm_->Broadcast(key, recv_buf, grouped_vals[i], priority);
     }
   }
@@ -364,20 +544,48 @@ class KVStoreDist : public KVStoreLocal {
       }
       auto &target_val_rowids = grouped_val_rowids[i];
       const size_t num_vals = target_val_rowids.size();
-      for (size_t i = 0; i < num_vals; i++) {
-        auto &row_id = target_val_rowids[i].second;
-        target_val_rowids[i].second = Unique(row_id, pinned_ctx_, 0);
+      NDArray indices;
+      if (num_vals > 1) {
+        // concatenate all requested row ids and ship the union to the
+        // servers once, instead of one pull round trip per value array
+        size_t total_num_rows = 0;
+        for (size_t j = 0; j < num_vals; j++) {
+          total_num_rows += target_val_rowids[j].second.shape().Size();
+        }
+        NDArray all_row_ids(mshadow::Shape1(total_num_rows), pinned_ctx_,
+                            false, target_val_rowids[0].second.dtype());
+        size_t offset = 0;
+        for (size_t j = 0; j < num_vals; j++) {
+          const NDArray &row_id = target_val_rowids[j].second;
+          const size_t num_rows = row_id.shape().Size();
+          NDArray segment = all_row_ids.Slice(offset, offset + num_rows);
+          CopyFromTo(row_id, &segment, priority);
+          offset += num_rows;
+        }
+        for (size_t j = 0; j < num_vals; j++) {
+          auto &row_id = target_val_rowids[j].second;
+          target_val_rowids[j].second = Unique(row_id, pinned_ctx_, 0);
+        }
+        indices = Unique(all_row_ids, pinned_ctx_, priority);
+      } else {
+        auto &row_id = target_val_rowids[0].second;
+        target_val_rowids[0].second = Unique(row_id, pinned_ctx_, 0);
+        indices = target_val_rowids[0].second;
       }
-      CHECK_EQ(num_vals, 1) << "RowSparsePull with multiple values is not supported yet";
-      NDArray& indices = target_val_rowids[0].second;
       PullRowSparse_(key, recv_buf, indices, priority);
-      // The recv_buf contains values pulled from remote server with unique indices.
-      // Directly broadcast w/o rowids if num_vals == 1
-      auto get_val = [](const std::pair<NDArray*, NDArray>& p) { return p.first; };
-      std::vector<NDArray*> grouped_val(grouped_val_rowid.size());
-      std::transform(grouped_val_rowid.begin(), grouped_val_rowid.end(),
-                     grouped_val.begin(), get_val);
-      comm_->Broadcast(key, recv_buf, grouped_val, priority);
+      if (num_vals == 1) {
+        // The recv_buf contains values pulled from remote server with unique indices.
+        // Directly broadcast w/o rowids if num_vals == 1
+        auto get_val = [](const std::pair<NDArray*, NDArray>& p) { return p.first; };
+        std::vector<NDArray*> grouped_val(grouped_val_rowid.size());
+        std::transform(grouped_val_rowid.begin(), grouped_val_rowid.end(),
+                       grouped_val.begin(), get_val);
+        comm_->Broadcast(key, recv_buf, grouped_val, priority);
+      } else {
+        // recv_buf holds the union of all requested rows; slice each value
+        // array's rows out of it locally
+        comm_->BroadcastRowSparse(key, recv_buf, target_val_rowids, priority);
+      }
     }
   }
 
@@ -396,6 +604,16 @@ class KVStoreDist : public KVStoreLocal {
       const auto& vals = grouped_vals[i];
       NDArray merged = do_merge ? comm_->Reduce(key, vals, priority) : vals[0];
 
+      auto bucket_it = key_bucket_.find(key);
+      if (bucket_it != key_bucket_.end()) {
+        // init pushes (do_merge == false) were already stashed into the
+        // bucket when the key was assigned; only gradients go through here
+        if (do_merge) {
+          HandleBucketPush(&buckets_[bucket_it->second], key, merged, priority);
+        }
+        continue;
+      }
+
       const auto storage_type = merged.storage_type();
       auto &comm_buf = comm_buf_[key];
       if (merged.ctx().dev_mask() == cpu::kDevMask) {
@@ -418,9 +636,23 @@ class KVStoreDist : public KVStoreLocal {
       const int num_bytes = mshadow::mshadow_sizeof(dtype);
       // push to servers
       if (storage_type == kDefaultStorage) {
-        if (gradient_compression_->get_type() == CompressionType::kNone) {
-          PSKV& pskv = EncodeDefaultKey(key, comm_buf.shape().Size(), num_bytes);
-          PushDefault(key, comm_buf, pskv, priority);
+        // keys below the compressor's size threshold travel uncompressed
+        const bool compress =
+            gradient_compression_->get_type() != CompressionType::kNone &&
+            gradient_compression_->ShouldCompress(comm_buf.shape().Size());
+        if (!compress) {
+          if (WireCastEligible(comm_buf)) {
+            // cast to the wire dtype; the server accumulates into its
+            // float32 master copy (see kSetMultiPrecision in the ctor)
+            NDArray wire_buf = WireBuf(key, comm_buf);
+            CopyFromTo(comm_buf, &wire_buf, priority);
+            const int wire_bytes = mshadow::mshadow_sizeof(wire_dtype_);
+            PSKV& pskv = EncodeDefaultKey(key, wire_buf.shape().Size(), wire_bytes);
+            PushDefault(key, wire_buf, pskv, priority);
+          } else {
+            PSKV& pskv = EncodeDefaultKey(key, comm_buf.shape().Size(), num_bytes);
+            PushDefault(key, comm_buf, pskv, priority);
+          }
         } else {
           CHECK_EQ(dtype, mshadow::kFloat32) << "Gradient compression is only supported for "
                                              << "float32 type of parameters";
@@ -448,6 +680,209 @@ class KVStoreDist : public KVStoreLocal {
     }
   }
 
+  /**
+   * \brief whether pushes and pulls of this buffer should travel in the
+   * reduced wire dtype. Only float32 dense values qualify, and the 2-bit
+   * compression path keeps its own encoding.
+   */
+  bool WireCastEligible(const NDArray& buf) const {
+    return wire_dtype_ != -1 &&
+           gradient_compression_->get_type() == CompressionType::kNone &&
+           buf.storage_type() == kDefaultStorage &&
+           buf.dtype() == mshadow::kFloat32;
+  }
+
+  /**
+   * \brief staging buffer holding the wire-dtype rendition of a key
+   */
+  const NDArray& WireBuf(int key, const NDArray& buf) {
+    auto& wire_buf = wire_buf_[key];
+    if (wire_buf.is_none()) {
+      wire_buf = NDArray(buf.shape(), pinned_ctx_, false, wire_dtype_);
+    }
+    return wire_buf;
+  }
+
+  /**
+   * \brief hand a network request to the priority sender, or run it inline
+   * when MXNET_KVSTORE_PRIORITY_SEND is off.
+   *
+   * The engine's worker pool dequeues ready operations roughly in the order
+   * they became ready, which during backward is reverse layer order; routing
+   * the ZPush/ZPull calls through a queue ordered by the priority that
+   * Push/Pull already carry lets the first layers' traffic overtake the last
+   * layers' even though their gradients finished later, so their pulls can
+   * start the next forward before the whole backward drains.
+   */
+  void EnqueueSend(int priority, std::function<void()> fn) {
+    if (!priority_send_) {
+      fn();
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(send_mutex_);
+      send_queue_.emplace(priority, std::move(fn));
+    }
+    send_cv_.notify_one();
+  }
+
+  void SenderLoop() {
+    std::unique_lock<std::mutex> lock(send_mutex_);
+    while (true) {
+      send_cv_.wait(lock, [this]() { return sender_stop_ || !send_queue_.empty(); });
+      if (send_queue_.empty()) {
+        if (sender_stop_) return;
+        continue;
+      }
+      auto fn = std::move(send_queue_.begin()->second);
+      send_queue_.erase(send_queue_.begin());
+      lock.unlock();
+      fn();
+      lock.lock();
+    }
+  }
+
+  /**
+   * \brief a fusion buffer that carries several small dense keys as one
+   * ps-lite key. Keys are assigned greedily in init order until the buffer
+   * reaches MXNET_KVSTORE_BUCKET_SIZE bytes; pushes copy each merged
+   * gradient into its slice and the fused message is sent when the last
+   * member of the bucket arrives, pulls work the same way in reverse.
+   */
+  struct GradBucket {
+    int fused_key;
+    int dtype{-1};
+    size_t size{0};  // total elements
+    bool sealed{false};
+    NDArray buf;     // flat fusion buffer on pinned_ctx_
+    std::vector<int> members;
+    // key -> (element offset, original shape)
+    std::unordered_map<int, std::pair<size_t, mxnet::TShape> > layout;
+    // initial weights stashed until the bucket is sealed and sent fused
+    std::unordered_map<int, NDArray> init_vals;
+    size_t pushed{0};
+    std::vector<std::pair<int, std::vector<NDArray*> > > pending_pulls;
+  };
+
+  bool BucketEligible(const NDArray& value) const {
+    return bucket_size_ > 0 &&
+           gradient_compression_->get_type() == CompressionType::kNone &&
+           value.storage_type() == kDefaultStorage &&
+           value.shape().Size() * mshadow::mshadow_sizeof(value.dtype()) <
+               static_cast<size_t>(bucket_size_);
+  }
+
+  void AssignToBucket(int key, const NDArray& value) {
+    if (key_bucket_.count(key)) return;
+    if (buckets_.empty() || buckets_.back().sealed ||
+        buckets_.back().dtype != value.dtype()) {
+      buckets_.emplace_back();
+      // synthetic keys grow downwards from INT_MAX; user keys this large
+      // would collide, which training scripts do not use in practice
+      buckets_.back().fused_key =
+          std::numeric_limits<int>::max() - static_cast<int>(buckets_.size()) + 1;
+      buckets_.back().dtype = value.dtype();
+    }
+    GradBucket& bucket = buckets_.back();
+    key_bucket_[key] = buckets_.size() - 1;
+    bucket.members.push_back(key);
+    bucket.layout[key] = std::make_pair(bucket.size, value.shape());
+    bucket.size += value.shape().Size();
+    bucket.init_vals[key] = value;
+    if (bucket.size * mshadow::mshadow_sizeof(bucket.dtype) >=
+        static_cast<size_t>(bucket_size_)) {
+      SealBucket(&bucket);
+    }
+  }
+
+  NDArray BucketSlice(const GradBucket& bucket, int key) const {
+    const auto& layout = bucket.layout.at(key);
+    return bucket.buf.Slice(layout.first, layout.first + layout.second.Size())
+        .Reshape(layout.second);
+  }
+
+  void SealBucket(GradBucket* bucket) {
+    bucket->sealed = true;
+    bucket->buf = NDArray(mxnet::TShape({static_cast<nnvm::dim_t>(bucket->size)}),
+                          pinned_ctx_, false, bucket->dtype);
+    for (int key : bucket->members) {
+      NDArray slice = BucketSlice(*bucket, key);
+      CopyFromTo(bucket->init_vals[key], &slice);
+    }
+    // like InitImpl, only one worker seeds the server with the initial weights
+    if (get_rank() == 0 && ps_worker_->get_customer()->customer_id() == 0) {
+      const int num_bytes = mshadow::mshadow_sizeof(bucket->dtype);
+      PSKV& pskv = EncodeDefaultKey(bucket->fused_key, bucket->size, num_bytes);
+      PushDefault(bucket->fused_key, bucket->buf, pskv, 0);
+      bucket->buf.WaitToWrite();
+    }
+    bucket->init_vals.clear();
+  }
+
+  void SealPendingBuckets() {
+    bool sealed_any = false;
+    for (auto& bucket : buckets_) {
+      if (!bucket.sealed) {
+        SealBucket(&bucket);
+        sealed_any = true;
+      }
+    }
+    // make sure the server holds the fused weights before any worker pulls
+    if (sealed_any && !ps::Postoffice::Get()->is_recovery()) {
+      Barrier();
+    }
+  }
+
+  void HandleBucketPush(GradBucket* bucket, int key,
+                        const NDArray& merged, int priority) {
+    NDArray slice = BucketSlice(*bucket, key);
+    CopyFromTo(merged, &slice, priority);
+    if (++bucket->pushed == bucket->members.size()) {
+      bucket->pushed = 0;
+      const int num_bytes = mshadow::mshadow_sizeof(bucket->dtype);
+      PSKV& pskv = EncodeDefaultKey(bucket->fused_key, bucket->size, num_bytes);
+      PushDefault(bucket->fused_key, bucket->buf, pskv, priority);
+    }
+  }
+
+  void HandleBucketPull(GradBucket* bucket, int key,
+                        const std::vector<NDArray*>& dsts, int priority) {
+    bucket->pending_pulls.emplace_back(key, dsts);
+    // defer the fused pull until every member is requested so that it is
+    // submitted after the fused push of this round
+    if (bucket->pending_pulls.size() < bucket->members.size()) return;
+    const NDArray recv_buf = bucket->buf;
+    const int fused_key = bucket->fused_key;
+    const size_t size = bucket->size;
+    const int dtype = bucket->dtype;
+    auto pull_from_servers = [this, fused_key, recv_buf, size, dtype, priority](
+        RunContext rctx, Engine::CallbackOnComplete cb) {
+      const int num_bytes = mshadow::mshadow_sizeof(dtype);
+      PSKV* pskv = &EncodeDefaultKey(fused_key, size, num_bytes);
+      char* data = static_cast<char*>(recv_buf.data().dptr_);
+      // false means not to delete data when SArray is deleted
+      auto vals = new ps::SArray<char>(data, size * num_bytes, false);
+      const int cmd = GetCommandType(RequestType::kDefaultPushPull, dtype);
+      EnqueueSend(priority, [this, pskv, recv_buf, vals, cmd, cb]() {
+        CHECK_NOTNULL(ps_worker_)->ZPull(
+          pskv->keys, vals, &pskv->lens, cmd, [vals, cb](){ delete vals; cb(); });
+      });
+    };
+    CHECK_NOTNULL(Engine::Get())->PushAsync(
+        pull_from_servers,
+        pinned_ctx_,
+        {},
+        {recv_buf.var()},
+        FnProperty::kNormal,
+        priority,
+        "KVStoreDistBucketPull");
+    for (const auto& pending : bucket->pending_pulls) {
+      comm_->Broadcast(pending.first, BucketSlice(*bucket, pending.first),
+                       pending.second, priority);
+    }
+    bucket->pending_pulls.clear();
+  }
+
   void PushCompressed(int key, const NDArray& comm_buf, const PSKV& pskv, int priority) {
     auto &small_buf = compr_buf_[key];
     auto &res_buf = residual_[key];
@@ -485,7 +920,7 @@ class KVStoreDist : public KVStoreLocal {
 
   void PushDefault(int key, const NDArray &send_buf, const PSKV& pskv, int priority) {
     auto push_to_servers =
-        [this, key, pskv, send_buf](RunContext rctx, Engine::CallbackOnComplete cb) {
+        [this, key, pskv, send_buf, priority](RunContext rctx, Engine::CallbackOnComplete cb) {
           const int dtype = send_buf.dtype();
           // convert to ps keys
           const size_t size = send_buf.shape().Size() * mshadow::mshadow_sizeof(dtype);
@@ -493,9 +928,11 @@ class KVStoreDist : public KVStoreLocal {
           // do push. false means no delete
           ps::SArray<char> vals(data, size, false);
           int cmd = GetCommandType(RequestType::kDefaultPushPull, dtype);
-          CHECK_NOTNULL(ps_worker_)->ZPush(
-              pskv.keys, vals, pskv.lens,
-              cmd, [cb]() { cb(); });
+          EnqueueSend(priority, [this, pskv, send_buf, vals, cmd, cb]() {
+            CHECK_NOTNULL(ps_worker_)->ZPush(
+                pskv.keys, vals, pskv.lens,
+                cmd, [cb]() { cb(); });
+          });
         };
     Engine::Get()->PushAsync(
         push_to_servers,
@@ -565,13 +1002,18 @@ class KVStoreDist : public KVStoreLocal {
         LOG(INFO) << "worker " << get_rank() << " pull lens: " << pskv.lens << " keys: "
                   << pskv.keys << " size: " << size;
       }
-      auto vals = new ps::SArray<char>(data, size * num_bytes, false);
-      const int cmd = GetCommandType(RequestType::kRowSparsePushPull, recv_buf.dtype());
       // copy indices to recv_buf. this needs to be done before ZPull
       // because after pull is done, the callback function returns and locks are released.
       // at this point, later functions may access the indices variable while copy happens
       mshadow::Copy(recv_buf.aux_data(kIdx).FlatTo1D<cpu, int64_t>(),
                     idx_data.FlatTo1D<cpu, int64_t>());
+      if (delta_pull_) {
+        PullRowSparseDelta(key, pskv, data, offsets, num_rows,
+                           unit_len * num_bytes, dtype, cb);
+        return;
+      }
+      auto vals = new ps::SArray<char>(data, size * num_bytes, false);
+      const int cmd = GetCommandType(RequestType::kRowSparsePushPull, recv_buf.dtype());
       CHECK_NOTNULL(ps_worker_)->ZPull(pskv.keys, vals, &pskv.lens,
                                        cmd,
                                        [vals, cb]() { delete vals; cb(); });
@@ -586,9 +1028,104 @@ class KVStoreDist : public KVStoreLocal {
       "KVStoreDistRowSparsePull");
   }
 
+  /**
+   * \brief delta variant of the row sparse pull. The request travels with
+   * the delta command, so the servers only ship rows that changed since
+   * this worker last received them; skipped rows are restored from
+   * delta_row_cache_. Response sizes are not known up front, so the
+   * values land in a server-sized buffer and are scattered into recv_buf
+   * afterwards instead of being pulled in place.
+   */
+  void PullRowSparseDelta(const int key, const PSKV& pskv, char* data,
+                          const int64_t* offsets, const size_t num_rows,
+                          const int unit_size, const int dtype,
+                          Engine::CallbackOnComplete cb) {
+    // entries in pskv that carry row payloads. Master keys have len 0 in
+    // the request, and in the response a zero len can also mean "row
+    // unchanged", so the positions must be recorded before the pull.
+    auto row_entries = std::make_shared<std::vector<size_t> >();
+    row_entries->reserve(num_rows);
+    for (size_t j = 0; j < pskv.lens.size(); ++j) {
+      if (pskv.lens[j] != 0) row_entries->push_back(j);
+    }
+    CHECK_EQ(row_entries->size(), num_rows);
+    const size_t num_entries = pskv.keys.size();
+    std::vector<int64_t> rows(offsets, offsets + num_rows);
+    // response-sized buffers; the servers decide how many bytes come back
+    auto vals = new ps::SArray<char>();
+    auto lens = new ps::SArray<int>();
+    const int cmd = GetCommandType(RequestType::kRowSparseDeltaPushPull, dtype);
+    CHECK_NOTNULL(ps_worker_)->ZPull(
+      pskv.keys, vals, lens, cmd,
+      [this, key, vals, lens, data, rows, row_entries, num_entries, unit_size, cb]() {
+        CHECK_EQ(lens->size(), num_entries);
+        std::lock_guard<std::mutex> lock(delta_mu_);
+        auto& cache = delta_row_cache_[key];
+        const char* src = vals->data();
+        size_t src_off = 0;
+        for (size_t i = 0; i < rows.size(); ++i) {
+          char* dst = data + i * unit_size;
+          if ((*lens)[(*row_entries)[i]] != 0) {
+            std::memcpy(dst, src + src_off, unit_size);
+            src_off += unit_size;
+            auto& row = cache[rows[i]];
+            row.assign(dst, dst + unit_size);
+          } else {
+            const auto it = cache.find(rows[i]);
+            CHECK(it != cache.end())
+              << "server omitted row " << rows[i] << " of key " << key
+              << " that this worker never pulled";
+            std::memcpy(dst, it->second.data(), unit_size);
+          }
+        }
+        delete vals;
+        delete lens;
+        cb();
+      });
+  }
+
   /**
    * \brief check if the keys are all unique
    */
+  /**
+   * \brief home server of a small key. Defaults to the hash placement;
+   * with MXNET_KVSTORE_BALANCED_SHARDING keys get a size-balanced
+   * placement computed deterministically at init time, so all workers
+   * agree on it the same way they agree on bucket layout.
+   */
+  int KeyHomeServer(const int key, const int num_servers) {
+    std::lock_guard<std::mutex> lock(home_mu_);
+    auto it = key_home_.find(key);
+    if (it != key_home_.end()) return it->second;
+    return (key * 9973) % num_servers;
+  }
+
+  /**
+   * \brief assign a small dense key to the least loaded server, measured
+   * in bytes stored. Called from InitImpl in init order, which is
+   * identical on every worker, so the resulting map is too. Big keys
+   * shard across all servers and need no balancing.
+   */
+  void AssignKeyHome(const int key, const NDArray& value) {
+    if (value.storage_type() != kDefaultStorage ||
+        value.shape().Size() >= bigarray_bound_) {
+      return;
+    }
+    const int num_servers = ps::Postoffice::Get()->GetServerKeyRanges().size();
+    CHECK_GT(num_servers, 0);
+    std::lock_guard<std::mutex> lock(home_mu_);
+    if (server_load_.size() < static_cast<size_t>(num_servers)) {
+      server_load_.resize(num_servers, 0);
+    }
+    int server = 0;
+    for (int i = 1; i < num_servers; ++i) {
+      if (server_load_[i] < server_load_[server]) server = i;
+    }
+    key_home_[key] = server;
+    server_load_[server] +=
+        value.shape().Size() * mshadow::mshadow_sizeof(value.dtype());
+  }
+
   void CheckUnique(const std::vector<int>& keys) {
     auto keys_copy = keys;
     auto last = std::unique(keys_copy.begin(), keys_copy.end());
@@ -620,7 +1157,7 @@ class KVStoreDist : public KVStoreLocal {
       // a simple heuristic for load balance
       if (num_arr_elems < bigarray_bound_) {
         // send it to a single random picked server
-        int server = (key * 9973) % num_servers;
+        int server = KeyHomeServer(key, num_servers);
         ps::Key ps_key = krs[server].begin() + key;
         CHECK_LT(ps_key, krs[server].end());
         pskv.keys.push_back(ps_key);
@@ -682,7 +1219,8 @@ class KVStoreDist : public KVStoreLocal {
       PSKV& push_pskv = compr_ps_kv_[key].push;
       mu_.unlock();
 
-      if (original_num_elem < bigarray_bound_) {
+      if (original_num_elem < bigarray_bound_ ||
+          !gradient_compression_->SupportsSharding()) {
         // a simple heuristic for load balancing
         // send it to a single random picked server
         const int server = (key * 9973) % num_servers;
@@ -830,11 +1368,71 @@ class KVStoreDist : public KVStoreLocal {
    * is push
    */
   std::unordered_map<int, NDArray> compr_buf_;
+  /**
+   * \brief staging buffers holding the wire-dtype rendition of each key
+   * when MXNET_KVSTORE_WIRE_DTYPE is set
+   */
+  std::unordered_map<int, NDArray> wire_buf_;
   /**
    * \brief residual buffer to accumulate quantization error
    * during gradient compression
    */
   std::unordered_map<int, NDArray> residual_;
+  /**
+   * \brief fusion buffers for small dense keys, in assignment order
+   */
+  std::vector<GradBucket> buckets_;
+  /**
+   * \brief maps a bucketed key to its index in buckets_
+   */
+  std::unordered_map<int, int> key_bucket_;
+  /**
+   * \brief target fusion buffer size in bytes, 0 disables bucketing
+   */
+  int bucket_size_;
+  /**
+   * \brief dedicated sender that issues queued ps-lite requests highest
+   * priority first; only started when MXNET_KVSTORE_PRIORITY_SEND is set
+   */
+  std::thread sender_;
+  std::mutex send_mutex_;
+  std::condition_variable send_cv_;
+  // ordered by descending priority; FIFO among equal priorities
+  std::multimap<int, std::function<void()>, std::greater<int> > send_queue_;
+  bool sender_stop_{false};
+  bool priority_send_;
+  /**
+   * \brief dtype values travel in on the network, -1 keeps the value dtype
+   */
+  int wire_dtype_;
+  /**
+   * \brief whether rank 0 initializes small dense keys with one fused
+   * message per server instead of one push per key
+   */
+  bool bulk_init_;
+  /**
+   * \brief whether Barrier() uses the server-side counting barrier
+   * instead of the Postoffice barrier through the scheduler
+   */
+  bool light_barrier_;
+  /**
+   * \brief whether small keys are placed on servers by accumulated size
+   * instead of by hash
+   */
+  bool balanced_sharding_;
+  // key -> home server for balanced placement, and bytes assigned per server
+  std::unordered_map<int, int> key_home_;
+  std::vector<size_t> server_load_;
+  std::mutex home_mu_;
+  /**
+   * \brief whether row_sparse pulls ask the servers for delta responses
+   * that omit rows unchanged since this worker's previous pull
+   */
+  bool delta_pull_;
+  // per key: row id -> bytes of the row as last received, used to fill
+  // in rows a delta response omitted
+  std::unordered_map<int, std::unordered_map<int64_t, std::vector<char> > > delta_row_cache_;
+  std::mutex delta_mu_;
   bool log_verbose_;
 };
 
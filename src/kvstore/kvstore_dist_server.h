@@ -27,6 +27,8 @@
 #include <mxnet/c_api.h>
 #include <mxnet/kvstore.h>
 #include <ps/ps.h>
+#include <algorithm>
+#include <cstring>
 #include <queue>
 #include <string>
 #include <mutex>
@@ -34,6 +36,8 @@
 #include <memory>
 #include <functional>
 #include <future>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include "../profiler/profiler.h"
 #include "../operator/tensor/elemwise_binary_op-inl.h"
@@ -45,11 +49,12 @@ namespace kvstore {
 // maintain same order in frontend.
 enum class CommandType {
   kController, kSetMultiPrecision, kStopServer, kSyncMode,
-  kSetGradientCompression, kSetProfilerParams
+  kSetGradientCompression, kSetProfilerParams, kBarrier
 };
 
 enum class RequestType {
-  kDefaultPushPull, kRowSparsePushPull, kCompressedPushPull
+  kDefaultPushPull, kRowSparsePushPull, kCompressedPushPull, kBulkInitPushPull,
+  kRowSparseDeltaPushPull
 };
 
 struct DataHandleType {
@@ -164,6 +169,8 @@ class KVStoreDistServer {
     sync_mode_ = false;
     gradient_compression_ = std::make_shared<GradientCompression>();
     log_verbose_ = dmlc::GetEnv("MXNET_KVSTORE_DIST_ROW_SPARSE_VERBOSE", false);
+    hash_rowsparse_merge_ = dmlc::GetEnv("MXNET_KVSTORE_HASH_ROWSPARSE_MERGE", false);
+    load_log_interval_ = dmlc::GetEnv("MXNET_KVSTORE_SERVER_LOAD_LOG_INTERVAL", 0);
   }
 
   ~KVStoreDistServer() {
@@ -196,6 +203,35 @@ class KVStoreDistServer {
     NDArray temp_array;
   };
 
+  /**
+   * \brief hash-indexed accumulator for row_sparse gradients of one key.
+   * Each distinct row id across all workers' pushes of a round gets one
+   * slot; duplicates add into it in place, so the per-round work scales
+   * with the rows actually touched rather than with push count times
+   * merged size.
+   */
+  struct RowHashAccum {
+    // row id -> byte offset of the row's slot in data
+    std::unordered_map<int64_t, size_t> slots;
+    std::vector<char> data;
+    size_t unit_len{0};
+  };
+
+  /**
+   * \brief per-row version stamps of one row_sparse key. The clock is
+   * bumped once per push and every pushed row takes the new value.
+   * sent_version remembers, per requesting worker, the version each row
+   * had when it was last shipped, so delta pulls can omit rows the
+   * worker already holds.
+   */
+  struct RowVersions {
+    uint64_t clock{0};
+    // row id -> version of the last push that touched the row
+    std::unordered_map<int64_t, uint64_t> row_version;
+    // worker (sender id) -> row id -> version the row was last sent at
+    std::unordered_map<int, std::unordered_map<int64_t, uint64_t> > sent_version;
+  };
+
   void CommandHandle(const ps::SimpleData& recved, ps::SimpleApp* app) {
     CommandType recved_type = static_cast<CommandType>(recved.head);
     switch (recved_type) {
@@ -229,6 +265,18 @@ class KVStoreDistServer {
             controller_(recved.head, recved.body);
           });
         break;
+      case CommandType::kBarrier:
+        // counting barrier between workers: hold every worker's request
+        // and release them all once the last worker has arrived. Cheaper
+        // than the Postoffice barrier, which round trips via the scheduler
+        barrier_reqs_.push_back(recved);
+        if (barrier_reqs_.size() == static_cast<size_t>(ps::NumWorkers())) {
+          for (const auto& req : barrier_reqs_) {
+            app->Response(req);
+          }
+          barrier_reqs_.clear();
+        }
+        return;
     }
     app->Response(recved);
   }
@@ -328,6 +376,7 @@ class KVStoreDistServer {
     DataHandleType type = DepairDataHandleType(req_meta.cmd);
     switch (type.requestType) {
       case RequestType::kRowSparsePushPull:
+      case RequestType::kRowSparseDeltaPushPull:
         DataHandleRowSparse(type, req_meta, req_data, server);
         break;
       case RequestType::kCompressedPushPull:
@@ -336,6 +385,9 @@ class KVStoreDistServer {
       case RequestType::kDefaultPushPull:
         DataHandleDefault(type, req_meta, req_data, server);
         break;
+      case RequestType::kBulkInitPushPull:
+        DataHandleBulkInit(type, req_meta, req_data, server);
+        break;
     }
   }
 
@@ -414,13 +466,68 @@ class KVStoreDistServer {
     updateBuf->merged.WaitToRead();
   }
 
+  void AccumulateHashedRows(const DataHandleType type,
+                            const ps::KVPairs<char>& req_data,
+                            const size_t num_rows,
+                            const int master_key,
+                            RowHashAccum* accum) {
+    const int num_bytes = mshadow::mshadow_sizeof(type.dtype);
+    accum->unit_len = req_data.lens[1] / num_bytes;
+    const int accum_dtype = has_multi_precision_copy(type) ? mshadow::kFloat32 : type.dtype;
+    const size_t unit_bytes = accum->unit_len * mshadow::mshadow_sizeof(accum_dtype);
+    MSHADOW_REAL_TYPE_SWITCH(accum_dtype, AType, {
+      MSHADOW_REAL_TYPE_SWITCH(type.dtype, DType, {
+        const DType* vals = reinterpret_cast<DType*>(req_data.vals.data());
+        for (size_t i = 1; i <= num_rows; ++i) {
+          const int64_t row_id = DecodeKey(req_data.keys[i]) - master_key;
+          auto it = accum->slots.find(row_id);
+          if (it == accum->slots.end()) {
+            it = accum->slots.emplace(row_id, accum->data.size()).first;
+            accum->data.resize(accum->data.size() + unit_bytes, 0);
+          }
+          AType* dst = reinterpret_cast<AType*>(accum->data.data() + it->second);
+          const DType* src = vals + (i - 1) * accum->unit_len;
+          for (size_t j = 0; j < accum->unit_len; ++j) {
+            dst[j] += static_cast<AType>(src[j]);
+          }
+        }
+      });
+    });
+  }
+
+  NDArray MaterializeHashedRows(const DataHandleType type,
+                                const mxnet::TShape& shape,
+                                RowHashAccum* accum) {
+    const int accum_dtype = has_multi_precision_copy(type) ? mshadow::kFloat32 : type.dtype;
+    NDArray merged(kRowSparseStorage, shape, Context(), true, accum_dtype);
+    const size_t nnr = accum->slots.size();
+    if (nnr == 0) return merged;  // every worker pushed all-zero gradients
+    // downstream kernels expect row ids in ascending order
+    std::vector<std::pair<int64_t, size_t> > rows(accum->slots.begin(), accum->slots.end());
+    std::sort(rows.begin(), rows.end());
+    merged.CheckAndAlloc({mshadow::Shape1(nnr)});
+    const size_t unit_bytes = accum->unit_len * mshadow::mshadow_sizeof(accum_dtype);
+    MSHADOW_IDX_TYPE_SWITCH(merged.aux_type(rowsparse::kIdx), IType, {
+      IType* idx = merged.aux_data(rowsparse::kIdx).dptr<IType>();
+      char* data = static_cast<char*>(merged.data().dptr_);
+      for (size_t i = 0; i < nnr; ++i) {
+        idx[i] = static_cast<IType>(rows[i].first);
+        std::memcpy(data + i * unit_bytes, accum->data.data() + rows[i].second, unit_bytes);
+      }
+    });
+    accum->slots.clear();
+    accum->data.clear();
+    return merged;
+  }
+
   void RowSparsePullResponse(const DataHandleType type,
                              const int master_key,
                              const size_t num_rows,
                              const ps::KVMeta& req_meta,
                              const ps::KVPairs<char>& req_data,
                              ps::KVServer<char>* server) {
-    if (log_verbose_) LOG(INFO) << "pull: " << master_key;
+    const bool delta = type.requestType == RequestType::kRowSparseDeltaPushPull;
+    if (log_verbose_) LOG(INFO) << "pull: " << master_key << (delta ? " (delta)" : "");
     ps::KVPairs<char> response;
     if (num_rows == 0) {
       std::vector<int> lens(req_data.keys.size(), 0);
@@ -437,22 +544,50 @@ class KVStoreDistServer {
     const int num_bytes = mshadow::mshadow_sizeof(type.dtype);
     const int unit_size = unit_len * num_bytes;
     const char* data = static_cast<char *> (stored.data().dptr_);
-    auto len = num_rows * unit_size;
+    std::vector<int> lens(req_data.keys.size(), unit_len);
+    lens[0] = 0;
+    // byte offset of each requested row in the response, -1 for rows a
+    // delta pull skips because this worker already holds their latest value
+    std::vector<int64_t> dst_off(num_rows);
+    size_t len = num_rows * unit_size;
+    if (delta) {
+      auto& versions = row_versions_[master_key];
+      auto& sent = versions.sent_version[req_meta.sender];
+      size_t shipped = 0;
+      for (size_t i = 1; i <= num_rows; i++) {
+        const int64_t row_id = DecodeKey(req_data.keys[i]) - master_key;
+        const auto vit = versions.row_version.find(row_id);
+        const uint64_t version = vit == versions.row_version.end() ? 0 : vit->second;
+        const auto sit = sent.find(row_id);
+        if (sit != sent.end() && sit->second >= version) {
+          lens[i] = 0;
+          dst_off[i - 1] = -1;
+        } else {
+          sent[row_id] = version;
+          dst_off[i - 1] = shipped * unit_size;
+          ++shipped;
+        }
+      }
+      len = shipped * unit_size;
+    } else {
+      for (size_t i = 0; i < num_rows; i++) {
+        dst_off[i] = i * unit_size;
+      }
+    }
     // concat values
     response.vals.resize(len);
     #pragma omp parallel for
     for (size_t i = 1; i <= num_rows; i++) {
+      if (dst_off[i - 1] < 0) continue;
       int key = DecodeKey(req_data.keys[i]);
       int64_t row_id = key - master_key;
       const auto src = data + row_id * unit_size;
-      auto begin = (i - 1) * unit_size;
-      auto end = i * unit_size;
+      auto begin = dst_off[i - 1];
+      auto end = begin + unit_size;
       response.vals.segment(begin, end).CopyFrom(src, unit_size);
     }
     // setup response
     response.keys = req_data.keys;
-    std::vector<int> lens(req_data.keys.size(), unit_len);
-    lens[0] = 0;
     response.lens.CopyFrom(lens.begin(), lens.end());
     server->Response(req_meta, response);
   }
@@ -523,6 +658,16 @@ class KVStoreDistServer {
         return;
       } else {
         if (log_verbose_) LOG(INFO) << "push: " << master_key << " " << req_data.keys;
+        // stamp the pushed rows so delta pulls can tell they changed; the
+        // entry only exists once a worker pulled the key with the delta
+        // command, which is also when rows start being skipped
+        const auto vit = row_versions_.find(master_key);
+        if (vit != row_versions_.end() && num_rows > 0) {
+          const uint64_t clock = ++vit->second.clock;
+          for (size_t i = 1; i <= num_rows; ++i) {
+            vit->second.row_version[DecodeKey(req_data.keys[i]) - master_key] = clock;
+          }
+        }
         auto& updates = update_buf_[master_key];
         if (sync_mode_ && updates.merged.is_none()) {
           updates.merged = NDArray(kRowSparseStorage, stored.shape(), Context(), true,
@@ -533,6 +678,23 @@ class KVStoreDistServer {
                                        mshadow::kFloat32);
         }
 
+        if (hash_rowsparse_merge_ && sync_mode_) {
+          // merge duplicate rows across workers into hash slots and build
+          // the merged row_sparse array once when the round is complete,
+          // instead of re-running a sparse add over the whole merged array
+          // for every worker's push
+          auto& accum = hash_accum_[master_key];
+          if (num_rows > 0) {
+            AccumulateHashedRows(type, req_data, num_rows, master_key, &accum);
+          }
+          updates.request.push_back(req_meta);
+          if (updates.request.size() == (size_t) ps::NumWorkers()) {
+            updates.merged = MaterializeHashedRows(type, stored.shape(), &accum);
+          }
+          ApplyUpdates(type, master_key, req_data, &updates, server);
+          return;
+        }
+
         if (num_rows == 0) {
           if (sync_mode_) {
             if (updates.request.empty()) {
@@ -688,6 +850,7 @@ class KVStoreDistServer {
       CHECK_EQ(req_data.vals.size(), (size_t)req_data.lens[0]);
     }
     int key = DecodeKey(req_data.keys[0]);
+    if (load_log_interval_ > 0) CountRequest(key);
     auto& stored = has_multi_precision_copy(type) ? store_realt_[key] : store_[key];
     // there used several WaitToRead, this is because \a recved's memory
     // could be deallocated when this function returns. so we need to make sure
@@ -749,11 +912,79 @@ class KVStoreDistServer {
     }
   }
 
+  /**
+   * \brief initializes many keys from one fused push. Each entry of
+   * req_data carries one dense key and its full value; keys that are
+   * already initialized are skipped so the message is idempotent on
+   * job restart. Responds once for the whole message.
+   */
+  void DataHandleBulkInit(const DataHandleType type, const ps::KVMeta& req_meta,
+                          const ps::KVPairs<char> &req_data,
+                          ps::KVServer<char>* server) {
+    CHECK(req_meta.push) << "bulk init requests must be pushes";
+    CHECK_EQ(req_data.keys.size(), req_data.lens.size());
+    const int num_bytes = mshadow::mshadow_sizeof(type.dtype);
+    size_t offset = 0;
+    for (size_t i = 0; i < req_data.keys.size(); ++i) {
+      const int key = DecodeKey(req_data.keys[i]);
+      const size_t len = req_data.lens[i];
+      size_t ds[] = {len / num_bytes};
+      mxnet::TShape dshape(ds, ds + 1);
+      TBlob recv_blob;
+      MSHADOW_REAL_TYPE_SWITCH(type.dtype, DType, {
+        recv_blob = TBlob(reinterpret_cast<DType*>(req_data.vals.data() + offset),
+                          dshape, cpu::kDevMask);
+      })
+      offset += len;
+      auto& stored = has_multi_precision_copy(type) ? store_realt_[key] : store_[key];
+      if (!stored.is_none()) continue;
+      NDArray recved = NDArray(recv_blob, 0);
+      stored = NDArray(dshape, Context(), false,
+                       has_multi_precision_copy(type) ? mshadow::kFloat32 : type.dtype);
+      CopyFromTo(recved, &stored, 0);
+      if (has_multi_precision_copy(type)) {
+        auto& stored_dtype = store_[key];
+        stored_dtype = NDArray(dshape, Context(), false, type.dtype);
+        CopyFromTo(stored, stored_dtype);
+        stored_dtype.WaitToRead();
+      }
+      // recved aliases req_data.vals, which is freed on return
+      stored.WaitToRead();
+    }
+    CHECK_EQ(offset, req_data.vals.size());
+    server->Response(req_meta);
+  }
+
   int DecodeKey(ps::Key key) {
     auto kr = ps::Postoffice::Get()->GetServerKeyRanges()[ps::MyRank()];
     return key - kr.begin();
   }
 
+  /**
+   * \brief per-key request-rate counter. Every load_log_interval_
+   * requests the hottest keys of this server are logged, so operators
+   * can spot load skew across servers and hot embedding keys.
+   */
+  void CountRequest(const int key) {
+    ++key_hits_[key];
+    if (++total_hits_ % load_log_interval_ != 0) return;
+    std::vector<std::pair<size_t, int> > hits;
+    hits.reserve(key_hits_.size());
+    for (const auto& kv : key_hits_) {
+      hits.push_back(std::make_pair(kv.second, kv.first));
+    }
+    const size_t top = std::min<size_t>(10, hits.size());
+    std::partial_sort(hits.begin(), hits.begin() + top, hits.end(),
+                      std::greater<std::pair<size_t, int> >());
+    std::string msg;
+    for (size_t i = 0; i < top; ++i) {
+      msg += " key " + std::to_string(hits[i].second) +
+             ": " + std::to_string(hits[i].first);
+    }
+    LOG(INFO) << "server " << ps::MyRank() << " handled " << total_hits_
+              << " requests, hottest keys:" << msg;
+  }
+
 
   /**
    * \brief user defined mode for push
@@ -775,6 +1006,19 @@ class KVStoreDistServer {
    */
   std::unordered_map<int, UpdateBuf> update_buf_;
 
+  /**
+   * \brief per-key hash accumulators for row_sparse gradients, used
+   * instead of sparse adds into update_buf_ when
+   * MXNET_KVSTORE_HASH_ROWSPARSE_MERGE is set
+   */
+  std::unordered_map<int, RowHashAccum> hash_accum_;
+
+  /**
+   * \brief per-key row version stamps backing delta pulls of row_sparse
+   * values. Only grows for keys pulled with the delta command.
+   */
+  std::unordered_map<int, RowVersions> row_versions_;
+
   /**
    * \brief decomp_buf_ is a buffer into which compressed values are
    * decompressed before merging to the store. used when compress_!='none'
@@ -784,9 +1028,21 @@ class KVStoreDistServer {
   Executor exec_;
   ps::KVServer<char>* ps_server_;
 
+  // worker requests held by the counting barrier until all workers arrive
+  std::vector<ps::SimpleData> barrier_reqs_;
+
+  // per-key request counters, kept when MXNET_KVSTORE_SERVER_LOAD_LOG_INTERVAL
+  // is set
+  std::unordered_map<int, size_t> key_hits_;
+  size_t total_hits_{0};
+  int load_log_interval_;
+
   // whether to LOG verbose information
   bool log_verbose_;
 
+  // whether to merge row_sparse pushes through hash accumulators
+  bool hash_rowsparse_merge_;
+
   /*
    * \brief whether to use multi precision mode.
    * in multi precision mode, all weights are stored as float32.
@@ -191,6 +191,43 @@ class KVStoreLocal : public KVStore {
     gradient_compression_->SetParams(kwargs);
   }
 
+  void SetGradientClipping(float max_norm) override {
+    // the fused path rescales merged gradients during the following pull;
+    // an updater would consume them unclipped during push and the scale
+    // would then corrupt the stored weights on broadcast
+    CHECK(max_norm <= 0.0f || (updater_ == nullptr && str_updater_ == nullptr))
+        << "fused gradient clipping cannot be combined with an updater "
+        << "(update_on_kvstore); clip gradients before pushing instead";
+    clip_max_norm_ = max_norm;
+    comm_->SetGradientClipping(max_norm);
+  }
+
+  void set_updater(const Updater& updater) override {
+    CHECK_LE(clip_max_norm_, 0.0f)
+        << "cannot register an updater while fused gradient clipping is "
+        << "enabled; it would consume unclipped gradients";
+    KVStore::set_updater(updater);
+  }
+
+  void set_updater(const StrUpdater& updater) override {
+    CHECK_LE(clip_max_norm_, 0.0f)
+        << "cannot register an updater while fused gradient clipping is "
+        << "enabled; it would consume unclipped gradients";
+    KVStore::set_updater(updater);
+  }
+
+  void AllGather(int key, const std::vector<NDArray>& values,
+                 const std::vector<NDArray*>& outs,
+                 int priority = 0) override {
+    comm_->AllGather(key, values, outs, priority);
+  }
+
+  void ReduceScatter(int key, const std::vector<NDArray>& values,
+                     const std::vector<NDArray*>& outs,
+                     int priority = 0) override {
+    comm_->ReduceScatter(key, values, outs, priority);
+  }
+
  private:
   virtual void InitImpl(const std::vector<int>& keys,
                         const std::vector<NDArray>& values) {
@@ -481,6 +518,8 @@ class KVStoreLocal : public KVStore {
   std::unordered_map<int, std::string> reverse_str_key_dict_;
   /// the next available integer for string->int key mapping
   int next_str_key_ = 0;
+  /// \brief global gradient-norm clipping threshold, 0 means disabled
+  float clip_max_norm_ = 0.0f;
   /// whether printed warning due to mismatch stype in each key
   std::unordered_set<int> warnings_printed_;
   /// whether int or string is used for keys
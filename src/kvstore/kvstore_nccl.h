@@ -66,12 +66,17 @@ class KVStoreNCCL : public KVStoreLocal {
     comm_ = nullptr;
     pinned_ctx_ = Context::CPUPinned(0);
     inited_ = false;
+    num_channels_ = dmlc::GetEnv("MXNET_KVSTORE_NCCL_NUM_CHANNELS", 1);
+    CHECK_GE(num_channels_, 1) << "MXNET_KVSTORE_NCCL_NUM_CHANNELS must be at least 1";
+    big_array_bound_ = dmlc::GetEnv("MXNET_KVSTORE_NCCL_BIGARRAY_BOUND", 1000 * 1000);
   }
 
   virtual ~KVStoreNCCL() {
     for (auto e : nccl_data_) {
-      cudaStreamDestroy(e.second.stream);
-      ncclCommDestroy(e.second.comm);
+      for (int c = 0; c < num_channels_; ++c) {
+        cudaStreamDestroy(e.second.streams[c]);
+        ncclCommDestroy(e.second.comms[c]);
+      }
     }
   }
 
@@ -216,6 +221,7 @@ class KVStoreNCCL : public KVStoreLocal {
                       std::vector<const NDArray*>* merged_ptrs) {
     std::vector<size_t> root_ids(keys.size());
     std::vector<NDArray> reduces(keys.size());
+    std::vector<int> channels(keys.size(), 0);
     merged_ptrs->resize(keys.size());
     std::vector<Engine::VarHandle> const_vars;
     std::vector<Engine::VarHandle> mutate_vars;
@@ -257,6 +263,7 @@ class KVStoreNCCL : public KVStoreLocal {
       (*merged_ptrs)[k] = &reduce;
       // Need to pass NDArrays by value to the engine
       reduces[k] = reduce;
+      channels[k] = KeyChannel(key, reduce.shape().Size());
 
       for (size_t i = 0; i < src.size(); ++i) {
         const_vars.push_back(src[i].var());
@@ -264,7 +271,7 @@ class KVStoreNCCL : public KVStoreLocal {
       mutate_vars.push_back(reduce.var());
     }
 
-    Engine::Get()->PushSync([srcs, reduces, root_ids, this](RunContext rctx) {
+    Engine::Get()->PushSync([srcs, reduces, root_ids, channels, this](RunContext rctx) {
         std::lock_guard<std::mutex> l(Storage::Get()->GetMutex(Context::kGPU));
 #if (NCCL_MAJOR > 2 || (NCCL_MAJOR == 2 && NCCL_MINOR > 1))
         ncclGroupStart();
@@ -273,6 +280,7 @@ class KVStoreNCCL : public KVStoreLocal {
           auto& src = srcs[k];
           auto& root_id = root_ids[k];
           auto& reduce = reduces[k];
+          auto& chan = channels[k];
           if (src.size() <= 1) {
             continue;
           }
@@ -288,8 +296,8 @@ class KVStoreNCCL : public KVStoreLocal {
                               GetNCCLType(src[i].dtype()),
                               ncclSum,
                               root,
-                              cur.comm,
-                              cur.stream););
+                              cur.comms[chan],
+                              cur.streams[chan]););
             } else {
             MSHADOW_TYPE_SWITCH(src[i].dtype(), DType,
             ncclReduce(src[i].data().dptr<DType>(),
@@ -298,8 +306,8 @@ class KVStoreNCCL : public KVStoreLocal {
                               GetNCCLType(src[i].dtype()),
                               ncclSum,
                               root,
-                              cur.comm,
-                              cur.stream););
+                              cur.comms[chan],
+                              cur.streams[chan]););
             }
           }
           ncclGroupEnd();
@@ -321,6 +329,7 @@ class KVStoreNCCL : public KVStoreLocal {
       const std::vector<std::vector<NDArray*>>& dsts,
       int priority) {
     std::vector<size_t> root_ids(keys.size());
+    std::vector<int> channels(keys.size(), 0);
     std::vector<Engine::VarHandle> const_vars;
     std::vector<Engine::VarHandle> mutable_vars;
 
@@ -354,6 +363,7 @@ class KVStoreNCCL : public KVStoreLocal {
         std::sort(dev_ids.begin(), dev_ids.end());
         CHECK(device_ids_ == dev_ids) << "NCCL KVStore supports only single set of devices";
 
+        channels[k] = KeyChannel(key, src.shape().Size());
         // On root perform simple copy to the output
         CopyFromTo(src, *dst[root_id], priority);
         for (size_t i = 0; i < dst.size(); ++i) {
@@ -380,7 +390,7 @@ class KVStoreNCCL : public KVStoreLocal {
       }
     }
 
-    Engine::Get()->PushSync([srcs, broadcasts, root_ids, this](RunContext rctx) {
+    Engine::Get()->PushSync([srcs, broadcasts, root_ids, channels, this](RunContext rctx) {
         std::lock_guard<std::mutex> l(Storage::Get()->GetMutex(Context::kGPU));
 #if (NCCL_MAJOR > 2 || (NCCL_MAJOR == 2 && NCCL_MINOR > 1))
         ncclGroupStart();
@@ -389,6 +399,7 @@ class KVStoreNCCL : public KVStoreLocal {
           auto& src = srcs[k];
           auto& dst = broadcasts[k];
           auto& root_id = root_ids[k];
+          auto& chan = channels[k];
           if (dst.size() <= 1) {
             continue;
           }
@@ -403,8 +414,8 @@ class KVStoreNCCL : public KVStoreLocal {
                   bcast.shape().Size(),
                   GetNCCLType(bcast.dtype()),
                   root,
-                  cur.comm,
-                  cur.stream););
+                  cur.comms[chan],
+                  cur.streams[chan]););
           }
           ncclGroupEnd();
         }
@@ -431,7 +442,9 @@ class KVStoreNCCL : public KVStoreLocal {
         mxnet::common::cuda::DeviceStore device_store;
         for (auto cur : nccl_data_) {
           device_store.SetDevice(cur.second.dev_id);
-          CUDA_CALL(cudaStreamSynchronize(cur.second.stream));
+          for (int c = 0; c < num_channels_; ++c) {
+            CUDA_CALL(cudaStreamSynchronize(cur.second.streams[c]));
+          }
         }
       },
       Context::CPU(),
@@ -478,18 +491,43 @@ class KVStoreNCCL : public KVStoreLocal {
     }
     std::sort(device_ids_.begin(), device_ids_.end());
     std::lock_guard<std::mutex> l(Storage::Get()->GetMutex(Context::kGPU));
-    std::vector<ncclComm_t> comms(devs.size());
-    ncclCommInitAll(&(comms[0]), devs.size(), &(device_ids_[0]));
     mxnet::common::cuda::DeviceStore device_store;
     for (size_t i = 0; i < devs.size(); ++i) {
       NCCLEntry e;
       e.dev_id = device_ids_[i];
-      e.comm = comms[i];
       e.rank = i;
-      device_store.SetDevice(e.dev_id);
-      cudaStreamCreate(&(e.stream));
+      e.comms.resize(num_channels_);
+      e.streams.resize(num_channels_);
       nccl_data_[device_ids_[i]] = e;
     }
+    // each channel gets its own communicator clique and streams so that
+    // collectives on different channels can run concurrently
+    for (int c = 0; c < num_channels_; ++c) {
+      std::vector<ncclComm_t> comms(devs.size());
+      ncclCommInitAll(&(comms[0]), devs.size(), &(device_ids_[0]));
+      for (size_t i = 0; i < devs.size(); ++i) {
+        auto& e = nccl_data_[device_ids_[i]];
+        e.comms[c] = comms[i];
+        device_store.SetDevice(e.dev_id);
+        cudaStreamCreate(&(e.streams[c]));
+      }
+    }
+  }
+
+  // Which channel a key's collectives run on. Reductions at least
+  // big_array_bound_ elements large own channel 0; smaller latency-bound
+  // ones are spread round robin over the remaining channels so they do
+  // not queue behind the big gradients.
+  int KeyChannel(int key, size_t num_elems) {
+    if (num_channels_ <= 1 || num_elems >= static_cast<size_t>(big_array_bound_)) {
+      return 0;
+    }
+    auto it = key_channel_.find(key);
+    if (it == key_channel_.end()) {
+      const int chan = 1 + (next_small_channel_++ % (num_channels_ - 1));
+      it = key_channel_.emplace(key, chan).first;
+    }
+    return it->second;
   }
 
   using KeyAttrs = std::tuple<int, mxnet::TShape, int>;
@@ -536,18 +574,26 @@ class KVStoreNCCL : public KVStoreLocal {
   struct NCCLEntry {
     /// \brief device ID
     int dev_id;
-    /// \brief NCCL commmunicator
-    ncclComm_t comm;
+    /// \brief NCCL communicators, one per channel
+    std::vector<ncclComm_t> comms;
     /// \brief NCCL rank
     int rank;
-    /// \brief GPU stream to use with NCCL
-    cudaStream_t stream;
+    /// \brief GPU streams to use with NCCL, one per channel
+    std::vector<cudaStream_t> streams;
   };
   std::unordered_map<int, BufferEntry> merge_buf_;
   std::unordered_map<int, NCCLEntry> nccl_data_;
   bool inited_;
   // \brief devices used with this KVStore
   std::vector<int> device_ids_;
+  // \brief number of communicator groups with their own streams
+  int num_channels_;
+  // \brief element count above which a reduction stays on channel 0
+  int big_array_bound_;
+  // \brief stable channel assignment of small keys
+  std::unordered_map<int, int> key_channel_;
+  // \brief round robin cursor for assigning small keys to channels
+  size_t next_small_channel_ = 0;
 };
 }  // namespace kvstore
 }  // namespace mxnet
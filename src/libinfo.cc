@@ -26,8 +26,20 @@
 
 #include "mxnet/libinfo.h"
 #include <bitset>
+#include <cstdint>
 #include "mxnet/base.h"
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define MXNET_HOST_CPUID 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define MXNET_HOST_CPUID 0
+#endif
+
 namespace mxnet {
 namespace features {
 
@@ -67,6 +79,9 @@ class FeatureSet {
 #if __AVX2__
     feature_bits.set(CPU_AVX2);
 #endif
+#if __AVX512F__
+    feature_bits.set(CPU_AVX512F);
+#endif
 
     // CPU
     feature_bits.set(OPENMP, MXNET_USE_OPENMP);
@@ -115,6 +130,112 @@ bool is_enabled(const unsigned feat) {
   return featureSet.is_enabled(feat);
 }
 
+#if MXNET_HOST_CPUID
+static bool CpuId(uint32_t leaf, uint32_t subleaf,
+                  uint32_t* eax, uint32_t* ebx, uint32_t* ecx, uint32_t* edx) {
+#if defined(_MSC_VER)
+  int regs[4];
+  __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+  *eax = regs[0]; *ebx = regs[1]; *ecx = regs[2]; *edx = regs[3];
+  return true;
+#else
+  if (__get_cpuid_max(leaf & 0x80000000u, nullptr) < leaf)
+    return false;
+  __cpuid_count(leaf, subleaf, *eax, *ebx, *ecx, *edx);
+  return true;
+#endif
+}
+
+static uint64_t Xgetbv() {
+#if defined(_MSC_VER)
+  return _xgetbv(0);
+#else
+  uint32_t eax, edx;
+  __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+#endif  // MXNET_HOST_CPUID
+
+/*!
+ * \brief ISA features actually supported by the CPU this process runs on,
+ *  as opposed to FeatureSet which records what the binary was compiled for.
+ */
+class HostCpuFeatures {
+ public:
+  HostCpuFeatures() :
+      feature_bits() {
+#if MXNET_HOST_CPUID
+    uint32_t eax, ebx, ecx, edx;
+    if (CpuId(1, 0, &eax, &ebx, &ecx, &edx)) {
+      feature_bits.set(CPU_SSE, edx & (1u << 25));
+      feature_bits.set(CPU_SSE2, edx & (1u << 26));
+      feature_bits.set(CPU_SSE3, ecx & (1u << 0));
+      feature_bits.set(CPU_SSE4_1, ecx & (1u << 19));
+      feature_bits.set(CPU_SSE4_2, ecx & (1u << 20));
+      feature_bits.set(F16C, ecx & (1u << 29));
+      // AVX needs OS support for the extended state, checked through xgetbv
+      const bool osxsave = ecx & (1u << 27);
+      const uint64_t xcr0 = osxsave ? Xgetbv() : 0;
+      const bool avx_os = osxsave && (xcr0 & 0x6) == 0x6;
+      feature_bits.set(CPU_AVX, avx_os && (ecx & (1u << 28)));
+      if (CpuId(7, 0, &eax, &ebx, &ecx, &edx)) {
+        feature_bits.set(CPU_AVX2, avx_os && (ebx & (1u << 5)));
+        feature_bits.set(CPU_AVX512F, (xcr0 & 0xe6) == 0xe6 && (ebx & (1u << 16)));
+      }
+    }
+    if (CpuId(0x80000001u, 0, &eax, &ebx, &ecx, &edx)) {
+      feature_bits.set(CPU_SSE4A, ecx & (1u << 6));
+    }
+#else
+    // cpuid is x86 only; on other architectures the compile baseline is assumed valid
+    feature_bits.set();
+#endif
+  }
+  bool is_supported(const unsigned feat) const {
+    CHECK_LT(feat, MAX_FEATURES);
+    return feature_bits.test(feat);
+  }
+
+ private:
+  std::bitset<MAX_FEATURES> feature_bits;
+};
+
+static HostCpuFeatures hostCpuFeatures;
+
+bool is_supported_on_host(const unsigned feat) {
+  switch (feat) {
+    case CPU_SSE:
+    case CPU_SSE2:
+    case CPU_SSE3:
+    case CPU_SSE4_1:
+    case CPU_SSE4_2:
+    case CPU_SSE4A:
+    case CPU_AVX:
+    case CPU_AVX2:
+    case CPU_AVX512F:
+    case F16C:
+      return hostCpuFeatures.is_supported(feat);
+    default:
+      // features that are not processor ISA extensions are host independent
+      return true;
+  }
+}
+
+void check_host_cpu_features() {
+  static const unsigned isa_features[] = {
+    CPU_SSE, CPU_SSE2, CPU_SSE3, CPU_SSE4_1, CPU_SSE4_2,
+    CPU_SSE4A, CPU_AVX, CPU_AVX2, CPU_AVX512F
+  };
+  for (unsigned feat : isa_features) {
+    if (is_enabled(feat) && !is_supported_on_host(feat)) {
+      LOG(WARNING) << "This binary was compiled with " << EnumNames::names[feat]
+                   << " but the host CPU does not support it; "
+                   << "operators may fail with illegal instruction errors.";
+    }
+  }
+}
+
 LibInfo::LibInfo() {
     for (size_t i = 0; i < MAX_FEATURES; ++i) {
         m_lib_features[i].name = EnumNames::names[i].c_str();
@@ -144,6 +265,7 @@ const std::vector<std::string> EnumNames::names = {
   "CPU_SSE4A",
   "CPU_AVX",
   "CPU_AVX2",
+  "CPU_AVX512F",
   "OPENMP",
   "SSE",
   "F16C",
@@ -26,11 +26,18 @@
 #include <dmlc/memory_io.h>
 #include <dmlc/logging.h>
 #include <dmlc/registry.h>
+#include <dmlc/thread_local.h>
 #include <mxnet/base.h>
 #include <mxnet/ndarray.h>
 #include <mxnet/resource.h>
 #include <mxnet/imperative.h>
 #include <mshadow/tensor.h>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include "./ndarray_function.h"
 #include "../common/utils.h"
 #include "../operator/tensor/matrix_op-inl.h"
@@ -41,6 +48,13 @@
 #include <opencv2/opencv.hpp>
 #endif  // MXNET_USE_OPENCV
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif  // defined(__unix__) || defined(__APPLE__)
+
 namespace dmlc {
 DMLC_REGISTRY_ENABLE(::mxnet::NDArrayFunctionReg);
 }  // namespace dmlc
@@ -87,9 +101,9 @@ NDArray::NDArray(const NDArrayStorageType stype, const mxnet::TShape &shape, Con
     }
   }
   if (stype == kDefaultStorage)
-    ptr_ = std::make_shared<Chunk>(shape, ctx, delay_alloc, dtype);
+    ptr_ = MakeChunk(shape, ctx, delay_alloc, dtype);
   else
-    ptr_ = std::make_shared<Chunk>(stype, storage_shape, ctx, delay_alloc,
+    ptr_ = MakeChunk(stype, storage_shape, ctx, delay_alloc,
         dtype, aux_types, aux_shapes);
 }
 
@@ -108,6 +122,82 @@ struct ChunkMem {
 #endif
 };
 
+namespace {
+
+/*!
+ * \brief Batches engine var deletions from chunk destructors.
+ *
+ *  Freeing a model with millions of NDArrays pushes one DeleteVariable
+ *  op per array through the scheduler. When
+ *  MXNET_ENGINE_BATCHED_VAR_DELETE is set, destructed chunks are instead
+ *  collected here and released with a single Engine::DeleteVariables op
+ *  per batch. Memory of up to kBatchSize - 1 arrays may be held until
+ *  the next deletion arrives.
+ */
+class VarDeleteBatcher {
+ public:
+  static VarDeleteBatcher* Get() {
+    static VarDeleteBatcher inst;
+    return &inst;
+  }
+
+  static bool Enabled() {
+    static bool enabled = dmlc::GetEnv("MXNET_ENGINE_BATCHED_VAR_DELETE", false);
+    return enabled;
+  }
+
+  void Append(const std::shared_ptr<Engine>& engine, Engine::VarHandle var,
+              const ChunkMem& mem, bool skip_free, Context ctx,
+              std::function<void()> deleter = nullptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // a batch shares one execution context
+    if (!vars_.empty() && ctx != ctx_) FlushLocked(engine);
+    ctx_ = ctx;
+    vars_.push_back(var);
+    entries_.push_back(Entry{mem, skip_free, std::move(deleter)});
+    if (vars_.size() >= kBatchSize) FlushLocked(engine);
+  }
+
+ private:
+  struct Entry {
+    ChunkMem mem;
+    bool skip_free;
+    std::function<void()> deleter;
+  };
+
+  void FlushLocked(const std::shared_ptr<Engine>& engine) {
+    if (vars_.empty()) return;
+    auto entries = std::make_shared<std::vector<Entry>>(std::move(entries_));
+    engine->DeleteVariables([entries](RunContext s) {
+        for (const Entry& e : *entries) {
+          if (!e.skip_free) {
+#if MXNET_USE_MKLDNN == 1
+            if (e.mem.mem) {
+              CHECK_LE(e.mem.mem->GetSize(), e.mem.h.size);
+              CHECK_EQ(e.mem.mem->GetDataHandle(), e.mem.h.dptr);
+            }
+#endif
+            Storage::Get()->Free(e.mem.h);
+            for (const auto &aux : e.mem.aux_h) {
+              Storage::Get()->Free(aux);
+            }
+          }
+          if (e.deleter) e.deleter();
+        }
+      }, ctx_, vars_);
+    vars_.clear();
+    entries_ = std::vector<Entry>();
+  }
+
+  static constexpr size_t kBatchSize = 64;
+  std::mutex mutex_;
+  Context ctx_;
+  std::vector<Engine::VarHandle> vars_;
+  std::vector<Entry> entries_;
+};
+
+}  // namespace
+
 NDArray::Chunk::~Chunk() {
   bool skip_free = static_data || delay_alloc;
   ChunkMem mem;
@@ -117,8 +207,14 @@ NDArray::Chunk::~Chunk() {
   // We want to delete mkldnn memory after deleting the variable.
   mem.mem = this->mkl_mem_;
 #endif
+  std::function<void()> ext_deleter = std::move(this->external_deleter);
   if (auto engine = engine_ref_.lock()) {
-    engine->DeleteVariable([mem, skip_free](RunContext s) {
+    if (VarDeleteBatcher::Enabled()) {
+      VarDeleteBatcher::Get()->Append(engine, var, mem, skip_free, shandle.ctx,
+                                      std::move(ext_deleter));
+      return;
+    }
+    engine->DeleteVariable([mem, skip_free, ext_deleter](RunContext s) {
       if (skip_free == false) {
 #if MXNET_USE_MKLDNN == 1
         if (mem.mem) {
@@ -131,7 +227,12 @@ NDArray::Chunk::~Chunk() {
           Storage::Get()->Free(aux);
         }
       }
+      // release externally owned data only after all reads/writes finished
+      if (ext_deleter) ext_deleter();
     }, shandle.ctx, var);
+  } else if (ext_deleter) {
+    // the engine is already gone, nothing can be in flight
+    ext_deleter();
   }
 }
 
@@ -183,7 +284,7 @@ NDArray::NDArray(const mkldnn::memory::desc &md)
     : storage_type_(kDefaultStorage), entry_(nullptr) {
   shape_ = mxnet::TShape(md.data.dims, md.data.dims + md.data.ndims);
   dtype_ = get_mxnet_type(md.data.data_type);
-  ptr_ = std::make_shared<Chunk>(shape_, Context::CPU(), true, dtype_);
+  ptr_ = MakeChunk(shape_, Context::CPU(), true, dtype_);
   ptr_->CheckAndAlloc(md.get_size());
   ptr_->mkl_mem_ = std::make_shared<MKLDNNMemory>(md, ptr_->shandle.dptr);
 }
@@ -193,7 +294,7 @@ NDArray::NDArray(const std::shared_ptr<mkldnn::memory> &mkldnn_mem)
   auto mem_desc = mkldnn_mem->get_desc();
   shape_ = mxnet::TShape(mem_desc.data.dims, mem_desc.data.dims + mem_desc.data.ndims);
   dtype_ = get_mxnet_type(mem_desc.data.data_type);
-  ptr_ = std::make_shared<Chunk>(shape_, Context::CPU(), true, dtype_);
+  ptr_ = MakeChunk(shape_, Context::CPU(), true, dtype_);
   ptr_->shandle.dptr = mkldnn_mem->get_data_handle();
   ptr_->shandle.size = mem_desc.get_size();
   ptr_->delay_alloc = false;
@@ -241,6 +342,40 @@ NDArray NDArray::MKLDNNDataReshape(const mxnet::TShape &shape) const {
 }
 #endif
 
+namespace {
+// Views themselves are cheap (they share the Chunk and its engine var), but
+// recording one re-parses the attribute dict through the op's attr_parser on
+// every call. Attention-style code creates hundreds of near-identical views
+// per step, so memoize the parsed attrs per thread.
+nnvm::NodeAttrs ViewOpAttrs(const nnvm::Op* op,
+                            std::unordered_map<std::string, std::string>&& dict) {
+  static const bool cache_enabled =
+      dmlc::GetEnv("MXNET_VIEW_OP_ATTRS_CACHE", true);
+  if (!cache_enabled) {
+    nnvm::NodeAttrs attrs;
+    attrs.op = op;
+    attrs.dict = std::move(dict);
+    op->attr_parser(&attrs);
+    return attrs;
+  }
+  using AttrsCache = std::unordered_map<std::string, nnvm::NodeAttrs>;
+  std::ostringstream key;
+  key << op->name;
+  for (const auto& kv : dict) key << ';' << kv.first << '=' << kv.second;
+  AttrsCache* cache = dmlc::ThreadLocalStore<AttrsCache>::Get();
+  auto it = cache->find(key.str());
+  if (it == cache->end()) {
+    nnvm::NodeAttrs attrs;
+    attrs.op = op;
+    attrs.dict = std::move(dict);
+    op->attr_parser(&attrs);
+    if (cache->size() >= 4096) cache->clear();
+    it = cache->emplace(key.str(), std::move(attrs)).first;
+  }
+  return it->second;
+}
+}  // namespace
+
 NDArray NDArray::Reshape(const mxnet::TShape &shape) const {
   CHECK(!is_none()) << "NDArray is not initialized";
   CHECK_GE(shape_.Size(), shape.Size())
@@ -263,12 +398,10 @@ NDArray NDArray::ReshapeWithRecord(const mxnet::TShape &shape) {
   CHECK_EQ(shape_.Size(), shape.Size())
     << "NDArray.Reshape: target shape must have the same size as "
     << "current shape when recording with autograd.";
-  nnvm::NodeAttrs attrs;
-  attrs.op = nnvm::Op::Get("Reshape");;
   std::ostringstream os;
   os << shape;
-  attrs.dict.insert({"shape", os.str()});
-  attrs.op->attr_parser(&attrs);
+  nnvm::NodeAttrs attrs = ViewOpAttrs(nnvm::Op::Get("Reshape"),
+                                      {{"shape", os.str()}});
   std::vector<NDArray*> inputs(1, this), outputs(1, &ret);
   Imperative::Get()->RecordOp(std::move(attrs), inputs, outputs);
   return ret;
@@ -294,12 +427,10 @@ NDArray NDArray::SliceWithRecord(index_t begin, index_t end) {
   NDArray ret = this->Slice(begin, end);
   if (!Imperative::Get()->is_recording()) return ret;
   // fake a slice_axis op
-  nnvm::NodeAttrs attrs;
-  attrs.op = nnvm::Op::Get("slice_axis");
-  attrs.dict.insert({"axis", "0"});
-  attrs.dict.insert({"begin", std::to_string(begin)});
-  attrs.dict.insert({"end", std::to_string(end)});
-  attrs.op->attr_parser(&attrs);
+  nnvm::NodeAttrs attrs = ViewOpAttrs(nnvm::Op::Get("slice_axis"),
+                                      {{"axis", "0"},
+                                       {"begin", std::to_string(begin)},
+                                       {"end", std::to_string(end)}});
   std::vector<NDArray*> inputs(1, this), outputs(1, &ret);
   Imperative::Get()->RecordOp(std::move(attrs), inputs, outputs);
   return ret;
@@ -375,7 +506,13 @@ NDArray NDArray::FromDLPack(const DLManagedTensor* tensor, bool transient_handle
       delete tensor_copy;
     }
   };
-  return NDArray(TBlob(tensor_copy->dl_tensor), tensor_copy->dl_tensor.ctx.device_id, deleter);
+  TBlob data(tensor_copy->dl_tensor);
+  // NDArray storage carries no strides, so only stride-aware kernels could
+  // read such an array correctly; keep the compactness requirement here.
+  CHECK(data.CheckContiguous())
+      << "NDArray only supports compact DLPack tensors; "
+      << "strided views can only be consumed at the TBlob level";
+  return NDArray(data, tensor_copy->dl_tensor.ctx.device_id, deleter);
 }
 
 bool NDArray::fresh_out_grad() const {
@@ -1711,6 +1848,56 @@ bool NDArray::LegacyLoad(dmlc::Stream *strm, const uint32_t magic) {
   }
 }
 
+namespace {
+
+/*! \brief Whether deserialized parameters are deduplicated process-wide */
+bool DedupLoadedParams() {
+  static const bool dedup = dmlc::GetEnv("MXNET_DEDUP_LOADED_PARAMS", false);
+  return dedup;
+}
+
+/*! \brief FNV-1a over a tensor's raw bytes */
+uint64_t HashBytes(const void *data, const size_t size) {
+  const uint8_t *bytes = static_cast<const uint8_t*>(data);
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+/*!
+ * \brief Process-wide content-addressed store for deserialized parameters.
+ *  When several models share most of their weights (fine-tuned variants of
+ *  one base model), each load of a tensor whose bytes match an earlier one
+ *  returns an NDArray sharing the existing chunk instead of keeping its own
+ *  copy. Hash collisions are ruled out by comparing the actual bytes before
+ *  sharing. The store retains its arrays for the process lifetime and the
+ *  returned aliases share storage, so this is only enabled via
+ *  MXNET_DEDUP_LOADED_PARAMS and meant for parameters that stay read-only
+ *  after loading, as inference parameters do.
+ */
+NDArray DedupLoadedArray(NDArray&& loaded) {
+  static std::mutex mutex;
+  static std::unordered_multimap<uint64_t, NDArray> store;
+  const TBlob data = loaded.data();
+  const size_t nbytes = data.Size() * mshadow::mshadow_sizeof(data.type_flag_);
+  const uint64_t hash = HashBytes(data.dptr_, nbytes);
+  std::lock_guard<std::mutex> lock(mutex);
+  const auto range = store.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    const NDArray &candidate = it->second;
+    if (candidate.shape() == loaded.shape() && candidate.dtype() == loaded.dtype() &&
+        std::memcmp(candidate.data().dptr_, data.dptr_, nbytes) == 0) {
+      return candidate;
+    }
+  }
+  store.emplace(hash, loaded);
+  return std::move(loaded);
+}
+
+}  // namespace
+
 bool NDArray::Load(dmlc::Stream *strm) {
   uint32_t magic;
   if (strm->Read(&magic, sizeof(uint32_t)) != sizeof(uint32_t)) return false;
@@ -1804,6 +1991,12 @@ bool NDArray::Load(dmlc::Stream *strm) {
     }
   }
 
+  // share storage with an identical tensor loaded earlier (dense CPU only;
+  // the bytes are final at this point)
+  if (0 == nad && DedupLoadedParams()) {
+    temp = DedupLoadedArray(std::move(temp));
+  }
+
   if (ctx.dev_mask() == cpu::kDevMask) {
     *this = std::move(temp); return true;
   } else {
@@ -1833,6 +2026,141 @@ void NDArray::Save(dmlc::Stream* fo,
   fo->Write(names);
 }
 
+namespace {
+
+/*!
+ * \brief Background writer used by NDArray::SaveAsync. Holds the staged
+ *        snapshot copies, waits for their engine copies to finish and
+ *        streams them to disk, while the submitting thread returns as soon
+ *        as the copies are pushed.
+ */
+class AsyncCheckpointWriter {
+ public:
+  static AsyncCheckpointWriter* Get() {
+    static AsyncCheckpointWriter writer;
+    return &writer;
+  }
+
+  void Push(const std::string& fname,
+            std::vector<NDArray> data,
+            std::vector<std::string> names) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // double buffering: at most two snapshots in flight at once
+    cv_slot_.wait(lock, [this]() { return queue_.size() < 2; });
+    queue_.push_back(Task{fname, std::move(data), std::move(names)});
+    if (!worker_.joinable()) {
+      worker_ = std::thread([this]() { this->Run(); });
+    }
+    cv_work_.notify_one();
+  }
+
+  void WaitAll() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_slot_.wait(lock, [this]() { return queue_.empty() && !busy_; });
+  }
+
+  /*!
+   * \brief Record the version last checkpointed for this key
+   * \return whether the content changed since the previous checkpoint
+   */
+  bool VersionChanged(const std::string& key, size_t version) {
+    std::lock_guard<std::mutex> lock(version_mutex_);
+    auto it = last_versions_.find(key);
+    const bool changed = it == last_versions_.end() || it->second != version;
+    last_versions_[key] = version;
+    return changed;
+  }
+
+  ~AsyncCheckpointWriter() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_work_.notify_one();
+    if (worker_.joinable()) worker_.join();
+  }
+
+ private:
+  struct Task {
+    std::string fname;
+    std::vector<NDArray> data;
+    std::vector<std::string> names;
+  };
+
+  void Run() {
+    for (;;) {
+      Task task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_work_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+        // pending checkpoints are still written out on shutdown
+        if (queue_.empty()) return;
+        task = std::move(queue_.front());
+        queue_.pop_front();
+        busy_ = true;
+      }
+      Write(task);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        busy_ = false;
+      }
+      cv_slot_.notify_all();
+    }
+  }
+
+  void Write(const Task& task) {
+    try {
+      // the staged copies were pushed before this task was queued; waiting
+      // here only stalls the writer thread, not training
+      for (const NDArray& nd : task.data) {
+        nd.WaitToRead();
+      }
+      std::unique_ptr<dmlc::Stream> fo(dmlc::Stream::Create(task.fname.c_str(), "w"));
+      NDArray::Save(fo.get(), task.data, task.names);
+    } catch (const dmlc::Error& e) {
+      LOG(WARNING) << "Asynchronous checkpoint to '" << task.fname << "' failed: " << e.what();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_work_;
+  std::condition_variable cv_slot_;
+  std::deque<Task> queue_;
+  std::thread worker_;
+  bool busy_{false};
+  bool stop_{false};
+  std::mutex version_mutex_;
+  std::unordered_map<std::string, size_t> last_versions_;
+};
+
+}  // namespace
+
+void NDArray::SaveAsync(const std::string& fname,
+                        const std::vector<NDArray>& data,
+                        const std::vector<std::string>& names,
+                        bool delta_only) {
+  CHECK(names.size() == 0 || names.size() == data.size())
+      << "Invalid number of names for the arrays to be saved";
+  CHECK(!delta_only || names.size() == data.size())
+      << "delta checkpoints require a name for every array";
+  AsyncCheckpointWriter* writer = AsyncCheckpointWriter::Get();
+  std::vector<NDArray> staged;
+  std::vector<std::string> staged_names;
+  staged.reserve(data.size());
+  for (size_t i = 0; i < data.size(); ++i) {
+    if (delta_only && !writer->VersionChanged(names[i], data[i].version())) continue;
+    // the copy carries a read dependency on the source, so it sees the
+    // values as of this call no matter when the disk write happens
+    staged.push_back(data[i].Copy(Context::CPU()));
+    if (names.size()) staged_names.push_back(names[i]);
+  }
+  writer->Push(fname, std::move(staged), std::move(staged_names));
+}
+
+void NDArray::WaitAllSaveAsync() {
+  AsyncCheckpointWriter::Get()->WaitAll();
+}
+
 void NDArray::Load(dmlc::Stream* fi,
                    std::vector<NDArray>* data,
                    std::vector<std::string>* keys) {
@@ -1851,6 +2179,155 @@ void NDArray::Load(dmlc::Stream* fi,
       << "Invalid NDArray file format";
 }
 
+#if defined(__unix__) || defined(__APPLE__)
+
+namespace {
+
+/*! \brief reference counted private mapping of a parameter file, unmapped
+ *         once the last NDArray pointing into it has been destroyed */
+struct MappedParameterFile {
+  MappedParameterFile(void* addr, size_t size) : addr(addr), size(size) {}
+  ~MappedParameterFile() {
+    munmap(addr, size);
+  }
+  void* addr;
+  size_t size;
+};
+
+/*!
+ * \brief Parse one saved NDArray record, pointing the array at the mapped
+ *        payload instead of copying it out. Returns false when the record
+ *        cannot be mapped (legacy format, sparse storage or misaligned
+ *        payload); the caller then rewinds the stream and takes the
+ *        copying path for that record.
+ */
+bool LoadMappedNDArray(dmlc::SeekStream* strm, char* base,
+                       const std::shared_ptr<MappedParameterFile>& file,
+                       NDArray* out) {
+  uint32_t magic;
+  if (strm->Read(&magic, sizeof(magic)) != sizeof(magic)) return false;
+  if (magic != NDARRAY_V2_MAGIC && magic != NDARRAY_V3_MAGIC) return false;
+  if (magic == NDARRAY_V3_MAGIC) {
+    CHECK(Imperative::Get()->is_np_shape())
+        << "ndarray was saved in np shape semantics, must be loaded in the same semantics."
+           " Please turn on np shape semantics in Python using `with np_shape(True)`"
+           " or decorator `use_np_shape` to scope the code of loading the ndarray.";
+  } else {
+    CHECK(Imperative::Get()->is_np_shape() == GlobalOn || !Imperative::Get()->is_np_shape())
+        << "ndarray was not saved in np shape semantics, but being loaded in np shape semantics."
+           " Please turn off np shape semantics in Python using `with np_shape(False)`"
+           " to scope the code of loading the ndarray.";
+  }
+  // sparse records keep the copying path
+  int32_t stype;
+  if (strm->Read(&stype, sizeof(stype)) != sizeof(stype)) return false;
+  if (num_aux_data(static_cast<NDArrayStorageType>(stype)) > 0) return false;
+
+  mxnet::TShape shape;
+  if (!shape.Load(strm)) return false;
+  if (Imperative::Get()->is_np_shape()) {
+    if (!shape_is_known(shape)) {
+      *out = NDArray(); return true;
+    }
+  } else if (shape.ndim() == 0) {
+    *out = NDArray(); return true;
+  }
+
+  Context ctx;
+  if (!ctx.Load(strm)) return false;
+
+  int32_t type_flag;
+  if (strm->Read(&type_flag, sizeof(type_flag)) != sizeof(type_flag)) return false;
+
+  const size_t type_size = mshadow::mshadow_sizeof(type_flag);
+  const size_t nread = type_size * shape.Size();
+  const size_t offset = strm->Tell();
+  if (offset % type_size != 0 || offset + nread > file->size) return false;
+  strm->Seek(offset + nread);
+
+  TBlob blob(base + offset, shape, cpu::kDevMask, type_flag, 0);
+  // the deleter owns the mapping; it runs once the engine variable is
+  // destroyed, i.e. after all pending reads and writes have completed
+  NDArray temp(blob, 0, [file]() {});
+  if (ctx.dev_mask() == cpu::kDevMask) {
+    *out = std::move(temp); return true;
+  } else {
+#if MXNET_USE_CUDA
+    int device_count = -1;
+    cudaGetDeviceCount(&device_count);
+    if (device_count > 0) {
+      *out = temp.Copy(ctx); return true;
+    } else {
+      *out = std::move(temp); return true;
+    }
+#else
+    *out = std::move(temp); return true;
+#endif
+  }
+}
+
+}  // namespace
+
+bool NDArray::LoadMemoryMapped(const std::string& fname,
+                               std::vector<NDArray>* data,
+                               std::vector<std::string>* keys) {
+  static const bool enabled = dmlc::GetEnv("MXNET_MMAP_NDARRAY_LOAD", false);
+  if (!enabled) return false;
+  const int fd = open(fname.c_str(), O_RDONLY);
+  if (fd < 0) return false;  // non-local URI or unreadable file
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return false;
+  }
+  const size_t size = static_cast<size_t>(st.st_size);
+  // map copy-on-write so loaded arrays stay writable without touching the file
+  void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) return false;
+  auto file = std::make_shared<MappedParameterFile>(addr, size);
+
+  char* base = static_cast<char*>(addr);
+  dmlc::MemoryFixedSizeStream strm(addr, size);
+  uint64_t header, reserved;
+  if (strm.Read(&header, sizeof(header)) != sizeof(header) ||
+      strm.Read(&reserved, sizeof(reserved)) != sizeof(reserved) ||
+      header != kMXAPINDArrayListMagic) {
+    return false;
+  }
+  uint64_t ndata;
+  if (strm.Read(&ndata, sizeof(ndata)) != sizeof(ndata)) return false;
+  data->resize(ndata);
+  for (uint64_t i = 0; i < ndata; ++i) {
+    const size_t record_start = strm.Tell();
+    if (!LoadMappedNDArray(&strm, base, file, &(*data)[i])) {
+      strm.Seek(record_start);
+      if (!(*data)[i].Load(&strm)) {
+        data->clear();
+        return false;
+      }
+    }
+  }
+  if (!strm.Read(keys)) {
+    data->clear();
+    keys->clear();
+    return false;
+  }
+  CHECK(keys->size() == 0 || keys->size() == data->size())
+      << "Invalid NDArray file format";
+  return true;
+}
+
+#else
+
+bool NDArray::LoadMemoryMapped(const std::string& fname,
+                               std::vector<NDArray>* data,
+                               std::vector<std::string>* keys) {
+  return false;
+}
+
+#endif  // defined(__unix__) || defined(__APPLE__)
+
 NDArray NDArray::Copy(Context ctx) const {
   NDArray ret;
   if (kDefaultStorage == storage_type()) {
@@ -2049,6 +2526,57 @@ void NDArray::SyncCopyToCPU(void *data, size_t size) const {
   }
 }
 
+void NDArray::AsyncCopyToCPU(void *data, size_t size, std::function<void()> callback) const {
+  mxnet::TShape dshape = this->shape();
+  if (!features::is_enabled(features::INT64_TENSOR_SIZE)) {
+    CHECK_LT(size, (int64_t{1} << 31) - 1) <<
+              "[AsyncCopyToCPU] Size of tensor you are trying to allocate is larger than "
+              "2^31 elements. Please build with flag USE_INT64_TENSOR_SIZE=1";
+  }
+  CHECK_EQ(dshape.Size(), size)
+      << "Memory size do not match";
+  // zero-size array, nothing to wait for
+  if (size == 0U) {
+    callback();
+    return;
+  }
+  TBlob dst(data, dshape, cpu::kDevMask, this->dtype_, 0); // NOLINT(*)
+  // the source is captured by value so it stays alive until the engine runs
+  // the copy; the caller owns the destination buffer until the callback fires
+  NDArray src = *this;
+
+  if (this->ctx().dev_mask() == cpu::kDevMask) {
+    Engine::Get()->PushAsync(
+      [src, dst, callback](RunContext rctx, Engine::CallbackOnComplete on_complete) mutable {
+        NDArray from = src;
+#if MXNET_USE_MKLDNN == 1
+        if (from.IsMKLDNNData())
+          from = src.Reorder2Default();
+#endif
+        ndarray::Copy<cpu, cpu>(from.data(), &dst,
+                                Context::CPU(), Context::CPU(), rctx);
+        callback();
+        on_complete();
+      }, this->ctx(), {this->var()}, {},
+      FnProperty::kNormal, 0, "AsyncCopyCPU2CPU");
+  } else {
+#if MXNET_USE_CUDA
+    Engine::Get()->PushAsync(
+      [src, dst, callback](RunContext rctx, Engine::CallbackOnComplete on_complete) mutable {
+        ndarray::Copy<gpu, cpu>(src.data(), &dst,
+                                src.ctx(), Context::CPU(), rctx);
+        // Wait GPU kernel to complete
+        rctx.get_stream<gpu>()->Wait();
+        callback();
+        on_complete();
+      }, this->ctx(), {this->var()}, {},
+      FnProperty::kCopyFromGPU, 0, "AsyncCopyGPU2CPU");
+#else
+    LOG(FATAL) << "GPU is not enabled";
+#endif
+  }
+}
+
 void NDArray::SyncCheckFormat(const bool full_check) const {
   int32_t err = kNormalErr;
   TBlob err_cpu(&err, mshadow::Shape1(1), cpu::kDevMask, 0);
@@ -48,9 +48,11 @@ void Copy<cpu, cpu>(const TBlob &from, TBlob *to,
                << " bytes, to: " << to->Size() * sizeof(DType) << " bytes.";
       common::ParallelCopy(to->dptr<DType>(), from.dptr<DType>(), size);
     } else {
+      const index_t size = static_cast<index_t>(from.Size());
+      CHECK_EQ(size, to->Size()) << "copying size mismatch, from: " << size
+               << " elements, to: " << to->Size() << " elements.";
       MSHADOW_TYPE_SWITCH_WITH_BOOL(from.type_flag_, SrcDType, {
-          to->FlatTo1D<cpu, DType>() =
-              mshadow::expr::tcast<DType>(from.FlatTo1D<cpu, SrcDType>());
+          common::ParallelCastCopy(to->dptr<DType>(), from.dptr<SrcDType>(), size);
       })
     }
   })
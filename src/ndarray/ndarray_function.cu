@@ -25,6 +25,8 @@
 // this will be invoked by nvcc and compile GPU version
 #include <cub/cub.cuh>
 #include <dmlc/logging.h>
+#include <mxnet/storage.h>
+#include <cstring>
 #include "../operator/tensor/elemwise_binary_op-inl.h"
 #include "../operator/tensor/elemwise_sum.h"
 #include "../operator/tensor/indexing_op.h"
@@ -35,19 +37,69 @@
 #include "./ndarray_function.h"
 #include "./ndarray_function-inl.h"
 #include "./ndarray_function-inl.cuh"
+#include "./pinned_copy_ring.h"
 
 namespace mxnet {
 namespace ndarray {
+
+// Route a small same-dtype transfer through the per-device ring of pinned
+// staging slots, so the DMA engine can access the host side directly
+// instead of the driver staging every chunk of pageable memory behind an
+// implicit synchronization. Returns false when the transfer does not
+// qualify and the caller should take the regular mshadow::Copy path.
+inline bool SmallCopyStaged(void* dst, const void* src, size_t bytes,
+                            int dev_id, cudaMemcpyKind kind,
+                            mshadow::Stream<gpu>* s) {
+  const size_t slot_bytes = PinnedCopyRing::SlotBytes();
+  if (bytes == 0 || bytes > slot_bytes) return false;
+  PinnedCopyRing* ring = PinnedCopyRing::Get(dev_id);
+  const int slot = ring->Acquire();
+  void* staged = ring->Data(slot);
+  if (kind == cudaMemcpyHostToDevice) {
+    std::memcpy(staged, src, bytes);
+    CUDA_CALL(cudaMemcpyAsync(dst, staged, bytes, kind, s->stream_));
+    // the slot may not be recycled while the DMA is still reading it
+    s->Wait();
+  } else {
+    CUDA_CALL(cudaMemcpyAsync(staged, src, bytes, kind, s->stream_));
+    s->Wait();
+    std::memcpy(dst, staged, bytes);
+  }
+  ring->Release(slot);
+  return true;
+}
+
 template<>
 void Copy<cpu, gpu>(const TBlob &from, TBlob *to,
                     Context from_ctx, Context to_ctx,
                     RunContext ctx) {
-  CHECK_EQ(to->type_flag_, from.type_flag_)
-    << "Source and target must have the same data type when copying across devices.";
+  mshadow::Stream<gpu>* s = ctx.get_stream<gpu>();
   MSHADOW_TYPE_SWITCH_WITH_BOOL(to->type_flag_, DType, {
-    mshadow::Copy(to->FlatTo1D<gpu, DType>(),
-                  from.FlatTo1D<cpu, DType>(),
-                  ctx.get_stream<gpu>());
+    if (to->type_flag_ == from.type_flag_) {
+      if (!(from.CheckContiguous() && to->CheckContiguous() &&
+            SmallCopyStaged(to->dptr_, from.dptr_, from.Size() * sizeof(DType),
+                            to_ctx.dev_id, cudaMemcpyHostToDevice, s))) {
+        mshadow::Copy(to->FlatTo1D<gpu, DType>(s),
+                      from.FlatTo1D<cpu, DType>(),
+                      s);
+      }
+    } else {
+      // fused cast+copy: ship the bytes in the source dtype and cast on
+      // the device, so the host never traverses the data a second time
+      MSHADOW_TYPE_SWITCH_WITH_BOOL(from.type_flag_, SrcDType, {
+        const size_t size = from.Size();
+        Storage::Handle handle =
+          Storage::Get()->Alloc(size * sizeof(SrcDType), Context::GPU(to_ctx.dev_id));
+        mshadow::Tensor<gpu, 1, SrcDType> staged(
+          static_cast<SrcDType*>(handle.dptr), mshadow::Shape1(size), s);
+        mshadow::Copy(staged, from.FlatTo1D<cpu, SrcDType>(), s);
+        to->FlatTo1D<gpu, DType>(s) = mshadow::expr::tcast<DType>(staged);
+        // the cast kernel is asynchronous; the staging buffer may not go
+        // back to the pool until it has been consumed
+        s->Wait();
+        Storage::Get()->Free(handle);
+      })
+    }
   });
 }
 
@@ -55,12 +107,32 @@ template<>
 void Copy<gpu, cpu>(const TBlob &from, TBlob *to,
                     Context from_ctx, Context to_ctx,
                     RunContext ctx) {
-  CHECK_EQ(to->type_flag_, from.type_flag_)
-    << "Source and target must have the same data type when copying across devices.";
+  mshadow::Stream<gpu>* s = ctx.get_stream<gpu>();
   MSHADOW_TYPE_SWITCH_WITH_BOOL(to->type_flag_, DType, {
-    mshadow::Copy(to->FlatTo1D<cpu, DType>(),
-                  from.FlatTo1D<gpu, DType>(),
-                  ctx.get_stream<gpu>());
+    if (to->type_flag_ == from.type_flag_) {
+      if (!(from.CheckContiguous() && to->CheckContiguous() &&
+            SmallCopyStaged(to->dptr_, from.dptr_, from.Size() * sizeof(DType),
+                            from_ctx.dev_id, cudaMemcpyDeviceToHost, s))) {
+        mshadow::Copy(to->FlatTo1D<cpu, DType>(),
+                      from.FlatTo1D<gpu, DType>(s),
+                      s);
+      }
+    } else {
+      // fused cast+copy: cast on the device into a staging buffer of the
+      // target dtype, then ship those bytes, so the host never traverses
+      // the data a second time
+      MSHADOW_TYPE_SWITCH_WITH_BOOL(from.type_flag_, SrcDType, {
+        const size_t size = from.Size();
+        Storage::Handle handle =
+          Storage::Get()->Alloc(size * sizeof(DType), Context::GPU(from_ctx.dev_id));
+        mshadow::Tensor<gpu, 1, DType> staged(
+          static_cast<DType*>(handle.dptr), mshadow::Shape1(size), s);
+        staged = mshadow::expr::tcast<DType>(from.FlatTo1D<gpu, SrcDType>(s));
+        mshadow::Copy(to->FlatTo1D<cpu, DType>(), staged, s);
+        s->Wait();
+        Storage::Get()->Free(handle);
+      })
+    }
   });
 }
 
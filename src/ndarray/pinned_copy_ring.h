@@ -0,0 +1,122 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2020 by Contributors
+ * \file pinned_copy_ring.h
+ * \brief Ring of pre-pinned host staging slots for small device copies.
+ *
+ * A cudaMemcpy from pageable host memory makes the driver stage the data
+ * through an internal pinned buffer and synchronize on every chunk, which
+ * is pure overhead for the many small transfers (scalars, index arrays,
+ * sequence lengths) an imperative workload issues. Routing those copies
+ * through a persistent ring of pre-pinned slots lets the DMA engine read
+ * or write the host side directly. One ring is kept per device and shared
+ * by the engine's copy threads; slots are handed out round-robin and a
+ * caller holds its slot only for the duration of one transfer.
+ */
+#ifndef MXNET_NDARRAY_PINNED_COPY_RING_H_
+#define MXNET_NDARRAY_PINNED_COPY_RING_H_
+
+#if MXNET_USE_CUDA
+
+#include <mxnet/base.h>
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
+#include "../common/cuda_utils.h"
+
+namespace mxnet {
+namespace ndarray {
+
+class PinnedCopyRing {
+ public:
+  /*!
+   * \brief Largest transfer (in bytes) routed through the ring.
+   *  Controlled by MXNET_GPU_SMALL_COPY_BYTES; 0 disables staging.
+   */
+  static size_t SlotBytes() {
+    static const size_t bytes =
+        static_cast<size_t>(dmlc::GetEnv("MXNET_GPU_SMALL_COPY_BYTES", 1 << 16));
+    return bytes;
+  }
+  /*! \brief Get the ring for a device, creating it on first use. */
+  static PinnedCopyRing* Get(int dev_id) {
+    static std::mutex rings_mutex;
+    static std::unordered_map<int, PinnedCopyRing*> rings;
+    std::lock_guard<std::mutex> l(rings_mutex);
+    PinnedCopyRing*& ring = rings[dev_id];
+    if (ring == nullptr) ring = new PinnedCopyRing();
+    return ring;
+  }
+  /*!
+   * \brief Take a free slot, blocking until one is available.
+   * \return the slot index, to be passed to Data() and Release().
+   */
+  int Acquire() {
+    std::unique_lock<std::mutex> l(mutex_);
+    cv_.wait(l, [this]() { return free_mask_ != 0; });
+    for (int s = 0; s < kNumSlots; ++s) {
+      if (free_mask_ & (1U << s)) {
+        free_mask_ &= ~(1U << s);
+        return s;
+      }
+    }
+    LOG(FATAL) << "unreachable";
+    return -1;
+  }
+  /*! \brief Host pointer of a held slot. */
+  void* Data(int slot) {
+    return static_cast<char*>(base_) + static_cast<size_t>(slot) * SlotBytes();
+  }
+  /*!
+   * \brief Return a slot to the ring. The caller must have synchronized the
+   *  transfer using the slot before releasing it.
+   */
+  void Release(int slot) {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      free_mask_ |= (1U << slot);
+    }
+    cv_.notify_one();
+  }
+
+ private:
+  PinnedCopyRing() {
+    CUDA_CALL(cudaHostAlloc(&base_, SlotBytes() * kNumSlots, cudaHostAllocPortable));
+  }
+  // The per-device rings live for the whole process; freeing pinned memory
+  // at static destruction time can race CUDA runtime teardown, so the
+  // singletons are never destroyed and the allocation is reclaimed by the
+  // OS at exit.
+  ~PinnedCopyRing() = default;
+
+  static const int kNumSlots = 8;
+  void* base_{nullptr};
+  uint32_t free_mask_{(1U << kNumSlots) - 1};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+}  // namespace ndarray
+}  // namespace mxnet
+
+#endif  // MXNET_USE_CUDA
+
+#endif  // MXNET_NDARRAY_PINNED_COPY_RING_H_
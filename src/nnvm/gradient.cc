@@ -125,8 +125,9 @@ Graph Gradient(Graph src) {
   std::unordered_map<Node*, std::vector<GradEntry> > output_grads;
 
   DFSVisit(ys, [&](const NodePtr& node) {
-      if (output_grads.count(node.get()) == 0) {
-        output_grads[node.get()].resize(node->num_outputs());
+      auto ins = output_grads.emplace(node.get(), std::vector<GradEntry>());
+      if (ins.second) {
+        ins.first->second.resize(node->num_outputs());
       }
       topo_order.push_back(node);
     });
@@ -147,6 +148,7 @@ Graph Gradient(Graph src) {
   // construct mirror as memory reduction strategy if needed
   std::unordered_map<Node*, NodePtr> mirror_map;
   if (mirror_fun != nullptr) {
+    mirror_map.reserve(topo_order.size());
     for (const NodePtr& node_ptr : topo_order) {
       if (mirror_fun(*node_ptr)) {
         NodePtr new_node = Node::Create();
@@ -193,15 +195,18 @@ Graph Gradient(Graph src) {
             << "Gradient function not returning enough gradient";
       } else if (CheckGradAllZero(out_agg_grads, zero_ops)) {
         for (size_t i = 0; i < fwd_node->num_inputs(); ++i) {
-          std::ostringstream os;
+          // plain concatenation; ostringstream costs several allocations per name
+          std::string name = fwd_node->attrs.name;
           if (1 == fwd_node->num_inputs()) {
-            os << fwd_node->attrs.name << "_backward";
+            name += "_backward";
           } else {
-            os << fwd_node->attrs.name << "_in" << i << "_backward";
+            name += "_in";
+            name += std::to_string(i);
+            name += "_backward";
           }
           auto p = Node::Create();
           p->attrs.op = zero_ops[0];
-          p->attrs.name = os.str();
+          p->attrs.name = std::move(name);
           p->inputs.push_back(fwd_node->inputs[i]);
           p->control_deps.emplace_back(fwd_node);
           if (p->op()->attr_parser != nullptr) {
@@ -247,11 +252,13 @@ Graph Gradient(Graph src) {
         unique_grads.emplace(std::move(entry.sum), std::make_pair(1, counter));
       } else {
         NodePtr copy_node = Node::Create();
-        std::ostringstream os;
-        os << entry.sum.node->attrs.name << "_" << kv->second.first << "_copy";
+        std::string name = entry.sum.node->attrs.name;
+        name += '_';
+        name += std::to_string(kv->second.first);
+        name += "_copy";
         kv->second.first++;
         copy_node->attrs.op = copy_op;
-        copy_node->attrs.name = os.str();
+        copy_node->attrs.name = std::move(name);
         copy_node->inputs.emplace_back(entry.sum);
         if (copy_node->attrs.op->attr_parser != nullptr) {
             copy_node->attrs.op->attr_parser(&(copy_node->attrs));
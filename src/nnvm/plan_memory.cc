@@ -81,6 +81,35 @@ class GraphAllocator {
     // TODO(tqchen) add size of the dtype, assume 4 bytes for now
     size_t size = shape.Size() * 4;
     if (match_range_ == 0) return this->Alloc(dev_id, size);
+    if (best_fit_) {
+      // byte-accurate sizing so entries of different dtypes (e.g. fp16
+      // activations next to fp32 buffers) can share the same storage.
+      size = shape.Size() * GetDTypeSize(dtype);
+      // best-fit strategy: take the smallest free block that already fits,
+      // regardless of the size ratio to the request.
+      for (auto it = free_.lower_bound(size); it != free_.end(); ++it) {
+        StorageEntry *e = it->second;
+        if (e->device_id != dev_id) continue;
+        if (node_color_.size() != 0 &&
+            node_color_[e->released_by_node] != node_color_[node_id]) continue;
+        e->max_bytes = std::max(size, e->max_bytes);
+        free_.erase(it);
+        return e->id;
+      }
+      // nothing fits, grow the largest free block instead of allocating a
+      // fresh one; growing by (size - max_bytes) never costs more than a
+      // new allocation of size bytes.
+      for (auto it = free_.rbegin(); it != free_.rend(); ++it) {
+        StorageEntry *e = it->second;
+        if (e->device_id != dev_id) continue;
+        if (node_color_.size() != 0 &&
+            node_color_[e->released_by_node] != node_color_[node_id]) continue;
+        e->max_bytes = std::max(size, e->max_bytes);
+        free_.erase(std::next(it).base());
+        return e->id;
+      }
+      return this->Alloc(dev_id, size);
+    }
     auto begin = free_.lower_bound(size / match_range_);
     auto mid = free_.lower_bound(size);
     auto end = free_.upper_bound(size * match_range_);
@@ -140,6 +169,7 @@ class GraphAllocator {
   void Init(const size_t match_range, const uint32_t num_match_color) {
     match_range_ = match_range;
     num_match_color_ = num_match_color;
+    best_fit_ = dmlc::GetEnv("NNVM_EXEC_MEM_PLAN_BESTFIT", false);
     if (num_match_color_ > 1) {
       std::vector<uint32_t> importance(idx_->num_nodes(), 0);
       for (uint32_t nid = 0; nid < idx_->num_nodes(); ++nid) {
@@ -173,6 +203,8 @@ class GraphAllocator {
   };
   // scale used for rough match
   size_t match_range_;
+  // whether to use dtype-aware best-fit matching instead of the range match
+  bool best_fit_{false};
   // whether use color based match algorithm
   uint32_t num_match_color_{1};
   // the size of each dtype
@@ -374,6 +406,10 @@ Graph PlanMemory(Graph ret) {
   size_t max_match_range = dmlc::GetEnv("NNVM_EXEC_MATCH_RANGE", 16);
   size_t min_match_range =
          dmlc::GetEnv("NNVM_AUTO_SEARCH_MATCH_RANGE", false) ? 1 : max_match_range;
+  // the best-fit planner ignores the match range, so a single pass suffices
+  if (dmlc::GetEnv("NNVM_EXEC_MEM_PLAN_BESTFIT", false)) {
+    min_match_range = max_match_range;
+  }
   for (size_t match_range = min_match_range; match_range <= max_match_range; match_range *= 2) {
     // Make a copy of related fields
     StorageVector storage_vec(storage);
@@ -22,12 +22,32 @@
 */
 
 #include "./boolean_mask-inl.h"
+#include "../tensor/util/tensor_util-inl.h"
 
 namespace mxnet {
 namespace op {
 
 DMLC_REGISTER_PARAMETER(BooleanMaskParam);
 
+namespace {
+// flag the mask elements in parallel, then turn the flags into the
+// inclusive prefix sum the copy kernels index with
+struct MarkMaskKernel {
+  template<typename DType>
+  MSHADOW_XINLINE static void Map(int i, int32_t* flg, const DType* idx) {
+    flg[i] = idx[i] ? 1 : 0;
+  }
+};
+
+template<typename DType>
+inline int32_t MaskPrefixSum(const DType* idx_dptr, int32_t* prefix_sum,
+                             const size_t idx_size, mshadow::Stream<cpu>* s) {
+  mxnet_op::Kernel<MarkMaskKernel, cpu>::Launch(s, idx_size, prefix_sum, idx_dptr);
+  ParallelInclusiveScan(prefix_sum, static_cast<nnvm::dim_t>(idx_size));
+  return prefix_sum[idx_size - 1];
+}
+}  // namespace
+
 bool BooleanMaskType(const nnvm::NodeAttrs& attrs,
                      std::vector<int> *in_attrs,
                      std::vector<int> *out_attrs) {
@@ -115,13 +135,10 @@ inline void BooleanMaskForward<cpu>(const nnvm::NodeAttrs& attrs,
   std::vector<int32_t> prefix_sum(idx_size, 0);
   size_t valid_num = 0;
   // Calculate prefix sum
+  mshadow::Stream<cpu> *stream = ctx.get_stream<cpu>();
   MSHADOW_TYPE_SWITCH_WITH_BOOL(idx.dtype(), DType, {
-    DType* idx_dptr = idx.data().dptr<DType>();
-    for (size_t i = 0; i < idx_size; i++) {
-      prefix_sum[i] = (i == 0) ? 0 : prefix_sum[i - 1];
-      prefix_sum[i] += (idx_dptr[i]) ? 1 : 0;
-    }
-    valid_num = prefix_sum[idx_size - 1];
+    valid_num = MaskPrefixSum(idx.data().dptr<DType>(), prefix_sum.data(),
+                              idx_size, stream);
   });
   // set the output shape forcefully
   mxnet::TShape s = data.shape();
@@ -132,7 +149,6 @@ inline void BooleanMaskForward<cpu>(const nnvm::NodeAttrs& attrs,
   MSHADOW_TYPE_SWITCH_WITH_BOOL(data.dtype(), DType, {
     size_t input_size = data.shape().Size();
     size_t col_size = input_size / idx_size;
-    mshadow::Stream<cpu> *stream = ctx.get_stream<cpu>();
     mxnet_op::Kernel<BooleanMaskForwardCPUKernel, cpu>::Launch(
       stream, idx_size, out.data().dptr<DType>(), data.data().dptr<DType>(),
       prefix_sum.data(), col_size);
@@ -159,12 +175,8 @@ inline void BooleanMaskBackward<cpu>(const nnvm::NodeAttrs& attrs,
       size_t idx_size = idx.shape()[0];
       size_t col_size = input_size / idx_size;
       std::vector<int32_t> prefix_sum(idx_size, 0);
-      IType* idx_dptr = idx.data().dptr<IType>();
-      for (size_t i = 0; i < idx_size; i++) {
-        prefix_sum[i] = (i == 0) ? 0 : prefix_sum[i - 1];
-        prefix_sum[i] += (idx_dptr[i]) ? 1 : 0;
-      }
       mshadow::Stream<cpu> *stream = ctx.get_stream<cpu>();
+      MaskPrefixSum(idx.data().dptr<IType>(), prefix_sum.data(), idx_size, stream);
       if (req[0] == kAddTo) {
         mxnet_op::Kernel<BooleanMaskBackwardKernel, cpu>::Launch(
           stream, idx_size, igrad_data.data().dptr<DType>(), req[0],
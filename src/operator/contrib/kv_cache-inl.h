@@ -0,0 +1,68 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Copyright (c) 2020 by Contributors
+ * \file kv_cache-inl.h
+ * \brief parameters for the key/value cache operators used in
+ *  autoregressive decoding
+ *
+ *  A cache is a preallocated tensor of shape (batch, max_length, dim)
+ *  that the frontend threads through every decode step. The append
+ *  operator writes the new step's keys or values into their slot in
+ *  place, and the attend operator runs scaled dot-product attention
+ *  over the filled prefix, so a decode step costs O(cur_length) instead
+ *  of the O(cur_length) copy plus reallocation a concat per step makes.
+ */
+#ifndef MXNET_OPERATOR_CONTRIB_KV_CACHE_INL_H_
+#define MXNET_OPERATOR_CONTRIB_KV_CACHE_INL_H_
+
+#include <dmlc/parameter.h>
+#include "../mshadow_op.h"
+#include "../mxnet_op.h"
+#include "../operator_common.h"
+
+namespace mxnet {
+namespace op {
+
+struct KVCacheAppendParam : public dmlc::Parameter<KVCacheAppendParam> {
+  int position;
+  DMLC_DECLARE_PARAMETER(KVCacheAppendParam) {
+    DMLC_DECLARE_FIELD(position)
+    .set_lower_bound(0)
+    .describe("Index along the length axis of the cache at which the "
+              "new steps are written. position + step_length must not "
+              "exceed the cache length.");
+  }
+};
+
+struct KVCacheAttendParam : public dmlc::Parameter<KVCacheAttendParam> {
+  int valid_length;
+  DMLC_DECLARE_PARAMETER(KVCacheAttendParam) {
+    DMLC_DECLARE_FIELD(valid_length)
+    .set_lower_bound(1)
+    .describe("Number of filled positions at the front of the cache. "
+              "Attention only reads keys and values below this index.");
+  }
+};
+
+}  // namespace op
+}  // namespace mxnet
+
+#endif  // MXNET_OPERATOR_CONTRIB_KV_CACHE_INL_H_
@@ -0,0 +1,248 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Copyright (c) 2020 by Contributors
+ * \file kv_cache.cc
+ * \brief CPU implementation of the key/value cache operators used in
+ *  autoregressive decoding
+ */
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include "./kv_cache-inl.h"
+#include "../elemwise_op_common.h"
+#include "../math_functions-inl.h"
+
+namespace mxnet {
+namespace op {
+
+DMLC_REGISTER_PARAMETER(KVCacheAppendParam);
+DMLC_REGISTER_PARAMETER(KVCacheAttendParam);
+
+static bool KVCacheAppendShape(const nnvm::NodeAttrs& attrs,
+                               mxnet::ShapeVector* in_shape,
+                               mxnet::ShapeVector* out_shape) {
+  const auto& param = nnvm::get<KVCacheAppendParam>(attrs.parsed);
+  CHECK_EQ(in_shape->size(), 2U) << "Input:[cache, data]";
+  const auto& cache_shape = in_shape->at(0);
+  const auto& data_shape = in_shape->at(1);
+  if (!mxnet::ndim_is_known(cache_shape)) return false;
+  CHECK_EQ(cache_shape.ndim(), 3)
+    << "cache should be 3D in batch-max_length-dim, currently is "
+    << cache_shape.ndim() << "D";
+  CHECK_EQ(data_shape.ndim(), 3)
+    << "data should be 3D in batch-step_length-dim, currently is "
+    << data_shape.ndim() << "D";
+  CHECK_EQ(data_shape[0], cache_shape[0])
+    << "cache and data disagree on the batch size: "
+    << cache_shape[0] << " vs. " << data_shape[0];
+  CHECK_EQ(data_shape[2], cache_shape[2])
+    << "cache and data disagree on the feature dim: "
+    << cache_shape[2] << " vs. " << data_shape[2];
+  CHECK_LE(param.position + data_shape[1], cache_shape[1])
+    << "appending " << data_shape[1] << " steps at position "
+    << param.position << " overflows a cache of length " << cache_shape[1];
+  out_shape->resize(1);
+  SHAPE_ASSIGN_CHECK(*out_shape, 0, cache_shape);
+  return shape_is_known(out_shape->at(0));
+}
+
+static bool KVCacheAttendShape(const nnvm::NodeAttrs& attrs,
+                               mxnet::ShapeVector* in_shape,
+                               mxnet::ShapeVector* out_shape) {
+  const auto& param = nnvm::get<KVCacheAttendParam>(attrs.parsed);
+  CHECK_EQ(in_shape->size(), 3U) << "Input:[query, keys, values]";
+  const auto& q_shape = in_shape->at(0);
+  const auto& k_shape = in_shape->at(1);
+  const auto& v_shape = in_shape->at(2);
+  if (!mxnet::ndim_is_known(q_shape)) return false;
+  CHECK_EQ(q_shape.ndim(), 3)
+    << "query should be 3D in batch-query_length-dim, currently is "
+    << q_shape.ndim() << "D";
+  CHECK_EQ(k_shape.ndim(), 3)
+    << "keys should be 3D in batch-max_length-dim, currently is "
+    << k_shape.ndim() << "D";
+  CHECK_EQ(k_shape, v_shape)
+    << "keys and values should have the same shape, currently are "
+    << k_shape << " and " << v_shape;
+  CHECK_EQ(q_shape[0], k_shape[0])
+    << "query and the caches disagree on the batch size: "
+    << q_shape[0] << " vs. " << k_shape[0];
+  CHECK_EQ(q_shape[2], k_shape[2])
+    << "query and the caches disagree on the feature dim: "
+    << q_shape[2] << " vs. " << k_shape[2];
+  CHECK_LE(param.valid_length, k_shape[1])
+    << "valid_length " << param.valid_length
+    << " exceeds the cache length " << k_shape[1];
+  out_shape->resize(1);
+  SHAPE_ASSIGN_CHECK(*out_shape, 0, q_shape);
+  return shape_is_known(out_shape->at(0));
+}
+
+void KVCacheAppendCPU(const nnvm::NodeAttrs& attrs, const OpContext& ctx,
+                      const std::vector<TBlob>& inputs,
+                      const std::vector<OpReqType>& req,
+                      const std::vector<TBlob>& outputs) {
+  const auto& param = nnvm::get<KVCacheAppendParam>(attrs.parsed);
+  const auto& cache = inputs[0];
+  const auto& data = inputs[1];
+  const auto& out = outputs[0];
+  if (req[0] == kNullOp) return;
+  const index_t batch = cache.shape_[0];
+  const index_t max_len = cache.shape_[1];
+  const index_t step_len = data.shape_[1];
+  const index_t dim = cache.shape_[2];
+  MSHADOW_REAL_TYPE_SWITCH(out.type_flag_, DType, {
+    DType* odata = out.dptr<DType>();
+    if (req[0] != kWriteInplace) {
+      std::memcpy(odata, cache.dptr<DType>(), cache.Size() * sizeof(DType));
+    }
+    const DType* ndata = data.dptr<DType>();
+    for (index_t b = 0; b < batch; ++b) {
+      std::memcpy(odata + (b * max_len + param.position) * dim,
+                  ndata + b * step_len * dim,
+                  step_len * dim * sizeof(DType));
+    }
+  });
+}
+
+void KVCacheAttendCPU(const nnvm::NodeAttrs& attrs, const OpContext& ctx,
+                      const std::vector<TBlob>& inputs,
+                      const std::vector<OpReqType>& req,
+                      const std::vector<TBlob>& outputs) {
+  using namespace mshadow;
+  const auto& param = nnvm::get<KVCacheAttendParam>(attrs.parsed);
+  const auto& query = inputs[0];
+  const auto& out = outputs[0];
+  if (req[0] == kNullOp) return;
+  CHECK_NE(req[0], kAddTo) << "kv_cache_attend does not support kAddTo";
+  Stream<cpu>* s = ctx.get_stream<cpu>();
+  const index_t batch = query.shape_[0];
+  const index_t qlen = query.shape_[1];
+  const index_t max_len = inputs[1].shape_[1];
+  const index_t dim = query.shape_[2];
+  const index_t valid = param.valid_length;
+  const index_t rows = batch * qlen;
+  MSHADOW_REAL_TYPE_SWITCH(out.type_flag_, DType, {
+    Tensor<cpu, 1, DType> scores = ctx.requested[0]
+      .get_space_typed<cpu, 1, DType>(Shape1(rows * valid), s);
+    const DType* qdata = query.dptr<DType>();
+    const DType* kdata = inputs[1].dptr<DType>();
+    const DType* vdata = inputs[2].dptr<DType>();
+    DType* odata = out.dptr<DType>();
+    const DType scale = DType(1.0f / std::sqrt(static_cast<float>(dim)));
+    const int omp_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+#pragma omp parallel for num_threads(omp_threads)
+    for (index_t r = 0; r < rows; ++r) {
+      const index_t b = r / qlen;
+      const DType* qrow = qdata + r * dim;
+      const DType* keys = kdata + b * max_len * dim;
+      const DType* values = vdata + b * max_len * dim;
+      DType* sc = scores.dptr_ + r * valid;
+      for (index_t j = 0; j < valid; ++j) {
+        DType dot = 0;
+        for (index_t d = 0; d < dim; ++d) {
+          dot += qrow[d] * keys[j * dim + d];
+        }
+        sc[j] = dot * scale;
+      }
+      DType smax = sc[0];
+      for (index_t j = 1; j < valid; ++j) {
+        smax = std::max(smax, sc[j]);
+      }
+      DType denom = 0;
+      for (index_t j = 0; j < valid; ++j) {
+        sc[j] = math::exp(sc[j] - smax);
+        denom += sc[j];
+      }
+      DType* orow = odata + r * dim;
+      for (index_t d = 0; d < dim; ++d) {
+        orow[d] = 0;
+      }
+      for (index_t j = 0; j < valid; ++j) {
+        const DType w = sc[j] / denom;
+        for (index_t d = 0; d < dim; ++d) {
+          orow[d] += w * values[j * dim + d];
+        }
+      }
+    }
+  });
+}
+
+NNVM_REGISTER_OP(_contrib_kv_cache_append)
+.describe(R"code(Write a decode step's keys or values into a preallocated cache in place.
+
+The cache has shape (batch, max_length, dim) and is allocated once per
+sequence by the frontend. Each decode step appends its (batch,
+step_length, dim) projections at `position` along the length axis
+instead of concatenating a fresh tensor, so a step costs
+O(step_length * dim) regardless of how much of the sequence is already
+cached. Pass the same array as input and output to update it in place.
+
+Intended for inference; the operator has no gradient.
+)code" ADD_FILELINE)
+.set_num_inputs(2)
+.set_num_outputs(1)
+.set_attr_parser(ParamParser<KVCacheAppendParam>)
+.set_attr<nnvm::FListInputNames>("FListInputNames", [](const NodeAttrs& attrs) {
+  return std::vector<std::string>{"cache", "data"};
+})
+.set_attr<mxnet::FInferShape>("FInferShape", KVCacheAppendShape)
+.set_attr<nnvm::FInferType>("FInferType", ElemwiseType<2, 1>)
+.set_attr<nnvm::FInplaceOption>("FInplaceOption", [](const NodeAttrs& attrs) {
+  return std::vector<std::pair<int, int> >{{0, 0}};
+})
+.set_attr<FCompute>("FCompute<cpu>", KVCacheAppendCPU)
+.set_attr<nnvm::FGradient>("FGradient", MakeZeroGradNodes)
+.add_argument("cache", "NDArray-or-Symbol", "Cache of shape (batch, max_length, dim)")
+.add_argument("data", "NDArray-or-Symbol", "New steps of shape (batch, step_length, dim)")
+.add_arguments(KVCacheAppendParam::__FIELDS__());
+
+NNVM_REGISTER_OP(_contrib_kv_cache_attend)
+.describe(R"code(Scaled dot-product attention over the filled prefix of a key/value cache.
+
+Computes softmax(query * keys[:, :valid_length]^T / sqrt(dim)) *
+values[:, :valid_length] without slicing or concatenating the caches,
+reading only the first `valid_length` positions. Together with
+kv_cache_append this keeps per-step decode cost linear in the current
+sequence length.
+
+Intended for inference; the operator has no gradient.
+)code" ADD_FILELINE)
+.set_num_inputs(3)
+.set_num_outputs(1)
+.set_attr_parser(ParamParser<KVCacheAttendParam>)
+.set_attr<nnvm::FListInputNames>("FListInputNames", [](const NodeAttrs& attrs) {
+  return std::vector<std::string>{"query", "keys", "values"};
+})
+.set_attr<mxnet::FInferShape>("FInferShape", KVCacheAttendShape)
+.set_attr<nnvm::FInferType>("FInferType", ElemwiseType<3, 1>)
+.set_attr<FResourceRequest>("FResourceRequest", [](const NodeAttrs& attrs) {
+  return std::vector<ResourceRequest>{ResourceRequest::kTempSpace};
+})
+.set_attr<FCompute>("FCompute<cpu>", KVCacheAttendCPU)
+.set_attr<nnvm::FGradient>("FGradient", MakeZeroGradNodes)
+.add_argument("query", "NDArray-or-Symbol", "Queries of shape (batch, query_length, dim)")
+.add_argument("keys", "NDArray-or-Symbol", "Key cache of shape (batch, max_length, dim)")
+.add_argument("values", "NDArray-or-Symbol", "Value cache of shape (batch, max_length, dim)")
+.add_arguments(KVCacheAttendParam::__FIELDS__());
+
+}  // namespace op
+}  // namespace mxnet
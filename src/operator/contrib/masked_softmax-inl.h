@@ -0,0 +1,191 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file masked_softmax-inl.h
+ * \brief fused softmax with an inline boolean mask.
+ *
+ * Attention softmax otherwise needs a where/broadcast_add materializing
+ * a full-precision mask tensor before softmax; here the mask is applied
+ * during the max and sum passes, masked positions produce exact zeros,
+ * and rows that are masked out entirely come out as all zeros. The
+ * length-based variant of this fusion already exists as softmax with
+ * use_length; this operator covers arbitrary per-element masks.
+ */
+#ifndef MXNET_OPERATOR_CONTRIB_MASKED_SOFTMAX_INL_H_
+#define MXNET_OPERATOR_CONTRIB_MASKED_SOFTMAX_INL_H_
+
+#include <mxnet/operator_util.h>
+#include <vector>
+#include "../mxnet_op.h"
+#include "../operator_common.h"
+
+namespace mxnet {
+namespace op {
+
+struct MaskedSoftmaxParam : public dmlc::Parameter<MaskedSoftmaxParam> {
+  int axis;
+  dmlc::optional<double> temperature;
+  DMLC_DECLARE_PARAMETER(MaskedSoftmaxParam) {
+    DMLC_DECLARE_FIELD(axis).set_default(-1)
+    .describe("The axis along which to compute softmax.");
+    DMLC_DECLARE_FIELD(temperature).set_default(dmlc::optional<double>())
+    .describe("Temperature parameter in softmax");
+  }
+};
+
+/*!
+ * \brief view shape as (leading, M, trailing) around the softmax axis,
+ * so a row of the softmax starts at (i / trailing) * M * trailing +
+ * i % trailing and iterates with stride trailing
+ */
+inline void MaskedSoftmaxFlatten(const mxnet::TShape& shape, const int axis,
+                                 index_t* leading, index_t* M,
+                                 index_t* trailing) {
+  *leading = 1;
+  *trailing = 1;
+  for (int i = 0; i < axis; ++i) *leading *= shape[i];
+  *M = shape[axis];
+  for (int i = axis + 1; i < shape.ndim(); ++i) *trailing *= shape[i];
+}
+
+struct MaskedSoftmaxFwdKernel {
+  // one thread per softmax row
+  template<typename DType, typename MType>
+  MSHADOW_XINLINE static void Map(index_t i, DType* out, const DType* in,
+                                  const MType* mask, const index_t M,
+                                  const index_t trailing,
+                                  const float temperature) {
+    const index_t base = (i / trailing) * M * trailing + (i % trailing);
+    float mmax = 0.0f;
+    bool any = false;
+    for (index_t j = 0; j < M; ++j) {
+      const index_t idx = base + j * trailing;
+      if (mask[idx] != MType(0)) {
+        const float val = static_cast<float>(in[idx]);
+        mmax = any ? (val > mmax ? val : mmax) : val;
+        any = true;
+      }
+    }
+    if (!any) {
+      for (index_t j = 0; j < M; ++j) {
+        out[base + j * trailing] = DType(0.0f);
+      }
+      return;
+    }
+    float sum = 0.0f;
+    for (index_t j = 0; j < M; ++j) {
+      const index_t idx = base + j * trailing;
+      if (mask[idx] != MType(0)) {
+        sum += expf((static_cast<float>(in[idx]) - mmax) / temperature);
+      }
+    }
+    for (index_t j = 0; j < M; ++j) {
+      const index_t idx = base + j * trailing;
+      out[idx] = mask[idx] != MType(0) ?
+          DType(expf((static_cast<float>(in[idx]) - mmax) / temperature) / sum) :
+          DType(0.0f);
+    }
+  }
+};
+
+struct MaskedSoftmaxBwdKernel {
+  // one thread per softmax row; inputs follow {ograd, out, mask}
+  template<typename DType, typename MType>
+  MSHADOW_XINLINE static void Map(index_t i, DType* igrad, const DType* ograd,
+                                  const DType* out, const MType* mask,
+                                  const index_t M, const index_t trailing,
+                                  const float temperature) {
+    const index_t base = (i / trailing) * M * trailing + (i % trailing);
+    float sum = 0.0f;
+    for (index_t j = 0; j < M; ++j) {
+      const index_t idx = base + j * trailing;
+      if (mask[idx] != MType(0)) {
+        sum += static_cast<float>(ograd[idx]) * static_cast<float>(out[idx]);
+      }
+    }
+    for (index_t j = 0; j < M; ++j) {
+      const index_t idx = base + j * trailing;
+      igrad[idx] = mask[idx] != MType(0) ?
+          DType(static_cast<float>(out[idx]) *
+                (static_cast<float>(ograd[idx]) - sum) / temperature) :
+          DType(0.0f);
+    }
+  }
+};
+
+template<typename xpu>
+void MaskedSoftmaxCompute(const nnvm::NodeAttrs& attrs,
+                          const OpContext& ctx,
+                          const std::vector<TBlob>& inputs,
+                          const std::vector<OpReqType>& req,
+                          const std::vector<TBlob>& outputs) {
+  using namespace mxnet_op;
+  CHECK_EQ(inputs.size(), 2U);
+  CHECK_EQ(outputs.size(), 1U);
+  if (req[0] == kNullOp || inputs[0].Size() == 0U) return;
+  CHECK_NE(req[0], kAddTo) << "kAddTo is not supported for masked_softmax";
+  const MaskedSoftmaxParam& param = nnvm::get<MaskedSoftmaxParam>(attrs.parsed);
+  const float temperature = param.temperature.has_value() ?
+      static_cast<float>(param.temperature.value()) : 1.0f;
+  const int axis = CheckAxis(param.axis, inputs[0].ndim());
+  index_t leading, M, trailing;
+  MaskedSoftmaxFlatten(inputs[0].shape_, axis, &leading, &M, &trailing);
+  mshadow::Stream<xpu>* s = ctx.get_stream<xpu>();
+  MSHADOW_REAL_TYPE_SWITCH(inputs[0].type_flag_, DType, {
+    MSHADOW_TYPE_SWITCH(inputs[1].type_flag_, MType, {
+      Kernel<MaskedSoftmaxFwdKernel, xpu>::Launch(
+          s, leading * trailing, outputs[0].dptr<DType>(),
+          inputs[0].dptr<DType>(), inputs[1].dptr<MType>(),
+          M, trailing, temperature);
+    });
+  });
+}
+
+template<typename xpu>
+void MaskedSoftmaxGradCompute(const nnvm::NodeAttrs& attrs,
+                              const OpContext& ctx,
+                              const std::vector<TBlob>& inputs,
+                              const std::vector<OpReqType>& req,
+                              const std::vector<TBlob>& outputs) {
+  using namespace mxnet_op;
+  CHECK_EQ(inputs.size(), 3U);
+  CHECK_EQ(outputs.size(), 1U);
+  if (req[0] == kNullOp || inputs[0].Size() == 0U) return;
+  CHECK_NE(req[0], kAddTo) << "kAddTo is not supported for masked_softmax";
+  const MaskedSoftmaxParam& param = nnvm::get<MaskedSoftmaxParam>(attrs.parsed);
+  const float temperature = param.temperature.has_value() ?
+      static_cast<float>(param.temperature.value()) : 1.0f;
+  const int axis = CheckAxis(param.axis, inputs[0].ndim());
+  index_t leading, M, trailing;
+  MaskedSoftmaxFlatten(inputs[0].shape_, axis, &leading, &M, &trailing);
+  mshadow::Stream<xpu>* s = ctx.get_stream<xpu>();
+  MSHADOW_REAL_TYPE_SWITCH(inputs[0].type_flag_, DType, {
+    MSHADOW_TYPE_SWITCH(inputs[2].type_flag_, MType, {
+      Kernel<MaskedSoftmaxBwdKernel, xpu>::Launch(
+          s, leading * trailing, outputs[0].dptr<DType>(),
+          inputs[0].dptr<DType>(), inputs[1].dptr<DType>(),
+          inputs[2].dptr<MType>(), M, trailing, temperature);
+    });
+  });
+}
+
+}  // namespace op
+}  // namespace mxnet
+#endif  // MXNET_OPERATOR_CONTRIB_MASKED_SOFTMAX_INL_H_
@@ -0,0 +1,102 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file masked_softmax.cc
+ * \brief CPU implementation of fused masked softmax
+ */
+#include "./masked_softmax-inl.h"
+#include "../tensor/elemwise_unary_op.h"
+
+namespace mxnet {
+namespace op {
+
+DMLC_REGISTER_PARAMETER(MaskedSoftmaxParam);
+
+static bool MaskedSoftmaxOpType(const nnvm::NodeAttrs& attrs,
+                                std::vector<int>* in_attrs,
+                                std::vector<int>* out_attrs) {
+  CHECK_EQ(in_attrs->size(), 2U);
+  CHECK_EQ(out_attrs->size(), 1U);
+  TYPE_ASSIGN_CHECK(*out_attrs, 0, in_attrs->at(0));
+  TYPE_ASSIGN_CHECK(*in_attrs, 0, out_attrs->at(0));
+  return (*out_attrs)[0] != -1 && (*in_attrs)[1] != -1;
+}
+
+NNVM_REGISTER_OP(_contrib_masked_softmax)
+.describe(R"code(Applies the softmax function with an inline boolean mask.
+
+Positions where `mask` is zero are excluded from the max and from the
+normalizing sum and produce exact zeros in the output; rows whose mask is
+zero everywhere come out as all zeros. This fuses the usual
+where/broadcast_add + softmax sequence of masked attention into one pass
+over the data. `mask` must have the same shape as `data`; any dtype whose
+zero/non-zero pattern encodes the mask works, boolean or uint8 keep the
+memory traffic lowest.
+
+Example::
+
+  data = [[ 1.  2.  3.]]
+  mask = [[ 1   1   0 ]]
+
+  masked_softmax(data, mask) = [[ 0.26894143  0.7310586  0. ]]
+
+)code" ADD_FILELINE)
+.set_attr_parser(ParamParser<MaskedSoftmaxParam>)
+.set_num_inputs(2)
+.set_num_outputs(1)
+.set_attr<nnvm::FListInputNames>("FListInputNames",
+  [](const NodeAttrs& attrs) {
+    return std::vector<std::string>{"data", "mask"};
+  })
+.set_attr<mxnet::FInferShape>("FInferShape", ElemwiseShape<2, 1>)
+.set_attr<nnvm::FInferType>("FInferType", MaskedSoftmaxOpType)
+.set_attr<FCompute>("FCompute<cpu>", MaskedSoftmaxCompute<cpu>)
+.set_attr<nnvm::FGradient>("FGradient",
+  [](const nnvm::NodePtr& n, const std::vector<nnvm::NodeEntry>& ograds) {
+    // gradient needs ograd, the forward output and the mask
+    std::vector<nnvm::NodeEntry> heads{ograds[0], nnvm::NodeEntry{n, 0, 0},
+                                       n->inputs[1]};
+    auto p = MakeNode("_backward_contrib_masked_softmax",
+                      n->attrs.name + "_backward", &heads, &n->attrs.dict, &n);
+    std::vector<nnvm::NodeEntry> ret;
+    ret.emplace_back(p);
+    ret.emplace_back(MakeNode("zeros_like", n->attrs.name + "_backward_mask",
+                              {n->inputs[1]}, nullptr, &n));
+    return ret;
+  })
+.set_attr<nnvm::FInplaceOption>("FInplaceOption",
+  [](const NodeAttrs& attrs) {
+    return std::vector<std::pair<int, int> >{{0, 0}};
+  })
+.add_argument("data", "NDArray-or-Symbol", "The input array.")
+.add_argument("mask", "NDArray-or-Symbol",
+              "Boolean mask with the same shape as data; zero excludes a "
+              "position from the softmax.")
+.add_arguments(MaskedSoftmaxParam::__FIELDS__());
+
+NNVM_REGISTER_OP(_backward_contrib_masked_softmax)
+.set_attr_parser(ParamParser<MaskedSoftmaxParam>)
+.set_num_inputs(3)
+.set_num_outputs(1)
+.set_attr<nnvm::TIsBackward>("TIsBackward", true)
+.set_attr<FCompute>("FCompute<cpu>", MaskedSoftmaxGradCompute<cpu>);
+
+}  // namespace op
+}  // namespace mxnet
@@ -23,12 +23,388 @@
  * \brief CPU implementation of the operators used in Transformer
  */
 #include <mxnet/base.h>
+#include <cmath>
 #include "./transformer-inl.h"
 #include "../tensor/elemwise_unary_op.h"
 
 namespace mxnet {
 namespace op {
 
+DMLC_REGISTER_PARAMETER(InterleavedMatMulParam);
+
+static bool InterleavedMatMulSelfAttQKShape(const NodeAttrs& attrs,
+                                            mxnet::ShapeVector* in_shape,
+                                            mxnet::ShapeVector* out_shape) {
+  const auto& params = nnvm::get<InterleavedMatMulParam>(attrs.parsed);
+  CHECK_EQ(in_shape->size(), 1U) << "Input:[queries_keys_values] currently have, "
+                                 << in_shape->size() << " inputs";
+  auto qkv_shape = in_shape->at(0);
+  CHECK_EQ(qkv_shape.ndim(), 3U)
+    << "Input queries_keys_values should be 3D in seq_length-batch-proj_dim, "
+    << "currently is: " << qkv_shape.ndim() << "D";
+  out_shape->resize(1);
+  SHAPE_ASSIGN_CHECK(*out_shape, 0,
+    mxnet::TShape({qkv_shape[1] * params.heads, qkv_shape[0], qkv_shape[0]}));
+  return true;
+}
+
+static bool InterleavedMatMulSelfAttValAttShape(const NodeAttrs& attrs,
+                                               mxnet::ShapeVector* in_shape,
+                                               mxnet::ShapeVector* out_shape) {
+  const auto& params = nnvm::get<InterleavedMatMulParam>(attrs.parsed);
+  CHECK_EQ(in_shape->size(), 2U) << "Input:[queries_keys_values, attention] currently have "
+                                 << in_shape->size() << " inputs";
+  auto qkv_shape = in_shape->at(0);
+  auto att_shape = in_shape->at(1);
+  CHECK_EQ(qkv_shape.ndim(), 3U)
+    << "Input queries_keys_values should be 3D in seq_length-batch-3*proj_dim, "
+    << "currently is: " << qkv_shape.ndim() << "D";
+  CHECK_EQ(att_shape.ndim(), 3U)
+    << "Input attention should be 3D in batch-seq_length-seq_length, "
+    << "currently is: " << att_shape.ndim() << "D";
+  CHECK_EQ(qkv_shape[0], att_shape[1])
+    << "queries_keys_values.shape[0] and attention.shape[1] should be the same, "
+    << "currently are " << qkv_shape[0] << " and " << att_shape[1];
+  CHECK_EQ(qkv_shape[0], att_shape[2])
+    << "queries_keys_values.shape[0] and attention.shape[2] should be the same, "
+    << "currently are " << qkv_shape[0] << " and " << att_shape[2];
+  CHECK_EQ(qkv_shape[2] % 3, 0)
+    << "queries_keys_values.shape[2] should be a multiple of 3, "
+    << "currently is " << qkv_shape[2];
+  CHECK_EQ(att_shape[0], qkv_shape[1] * params.heads)
+    << "attention.shape[0] should be equal to queries_keys_values.shape[1] * heads, "
+    << "currently are: " << att_shape[0] << " and " << qkv_shape[1];
+  out_shape->resize(1);
+  SHAPE_ASSIGN_CHECK(*out_shape, 0,
+    mxnet::TShape({qkv_shape[0], qkv_shape[1], qkv_shape[2] / 3}));
+  return true;
+}
+
+#if (MSHADOW_USE_CBLAS == 1 || MSHADOW_USE_MKL == 1)
+
+// Strided batched gemm on the interleaved QKV layout, row-major semantics.
+// With MKL the whole batch is handed over in one cblas_sgemm_batch call;
+// with plain cblas we fall back to a serial loop of sgemms.
+static void StridedBatchSgemm(bool transA, bool transB,
+                              index_t m, index_t n, index_t k, float alpha,
+                              const float* a, index_t lda, index_t stride_a,
+                              const float* b, index_t ldb, index_t stride_b,
+                              float beta, float* c, index_t ldc, index_t stride_c,
+                              index_t batch) {
+#if MSHADOW_USE_MKL == 1
+  const CBLAS_TRANSPOSE ta = transA ? CblasTrans : CblasNoTrans;
+  const CBLAS_TRANSPOSE tb = transB ? CblasTrans : CblasNoTrans;
+  const MKL_INT m_ = m, n_ = n, k_ = k, lda_ = lda, ldb_ = ldb, ldc_ = ldc;
+  const MKL_INT batch_ = batch;
+  std::vector<const float*> pa(batch);
+  std::vector<const float*> pb(batch);
+  std::vector<float*> pc(batch);
+  for (index_t i = 0; i < batch; ++i) {
+    pa[i] = a + i * stride_a;
+    pb[i] = b + i * stride_b;
+    pc[i] = c + i * stride_c;
+  }
+  cblas_sgemm_batch(CblasRowMajor, &ta, &tb, &m_, &n_, &k_, &alpha,
+                    pa.data(), &lda_, pb.data(), &ldb_, &beta,
+                    pc.data(), &ldc_, 1, &batch_);
+#else
+  for (index_t i = 0; i < batch; ++i) {
+    cblas_sgemm(CblasRowMajor,
+                transA ? CblasTrans : CblasNoTrans,
+                transB ? CblasTrans : CblasNoTrans,
+                m, n, k, alpha, a + i * stride_a, lda, b + i * stride_b, ldb,
+                beta, c + i * stride_c, ldc);
+  }
+#endif  // MSHADOW_USE_MKL == 1
+}
+
+void InterleavedMatMulSelfAttQKCPU(const nnvm::NodeAttrs& attrs,
+                                   const OpContext &ctx,
+                                   const std::vector<TBlob> &inputs,
+                                   const std::vector<OpReqType> &req,
+                                   const std::vector<TBlob> &outputs) {
+  const auto& params = nnvm::get<InterleavedMatMulParam>(attrs.parsed);
+  if (req[0] == kNullOp) return;
+  CHECK_EQ(inputs[0].type_flag_, mshadow::kFloat32)
+    << "interleaved_matmul_selfatt_qk only supports float32 on CPU";
+  const index_t qkv_seq_len    = inputs[0].shape_[0];
+  const index_t sequences      = inputs[0].shape_[1];
+  const index_t output_lin_dim = inputs[0].shape_[2];
+  const index_t embed_dim      = output_lin_dim / 3;
+  const index_t head_dim       = embed_dim / params.heads;
+  const index_t attn_batches   = params.heads * sequences;
+  const index_t lead_dim       = attn_batches * 3 * head_dim;
+  const index_t batch_stride   = 3 * head_dim;
+  const float scale = 1.f / sqrtf(static_cast<float>(head_dim));
+  const float beta = req[0] == kAddTo ? 1.f : 0.f;
+  const float* qkv = inputs[0].dptr<float>();
+  float* output = outputs[0].dptr<float>();
+  // scores = scale * Q * K^T per (batch, head) chunk of the interleaved input
+  StridedBatchSgemm(false, true,
+                    qkv_seq_len, qkv_seq_len, head_dim, scale,
+                    qkv, lead_dim, batch_stride,
+                    qkv + head_dim, lead_dim, batch_stride,
+                    beta, output, qkv_seq_len, qkv_seq_len * qkv_seq_len,
+                    attn_batches);
+}
+
+void BackwardInterleavedMatMulSelfAttQKCPU(const nnvm::NodeAttrs& attrs,
+                                           const OpContext &ctx,
+                                           const std::vector<TBlob> &inputs,
+                                           const std::vector<OpReqType> &req,
+                                           const std::vector<TBlob> &outputs) {
+  const auto& params = nnvm::get<InterleavedMatMulParam>(attrs.parsed);
+  if (req[0] == kNullOp) return;
+  CHECK_EQ(inputs[0].type_flag_, mshadow::kFloat32)
+    << "interleaved_matmul_selfatt_qk only supports float32 on CPU";
+  mshadow::Stream<cpu>* s = ctx.get_stream<cpu>();
+  const index_t qkv_seq_len    = inputs[1].shape_[0];
+  const index_t sequences      = inputs[1].shape_[1];
+  const index_t output_lin_dim = inputs[1].shape_[2];
+  const index_t embed_dim      = output_lin_dim / 3;
+  const index_t head_dim       = embed_dim / params.heads;
+  const index_t attn_batches   = params.heads * sequences;
+  const index_t lead_dim       = attn_batches * 3 * head_dim;
+  const index_t batch_stride   = 3 * head_dim;
+  const float scale = 1.f / sqrtf(static_cast<float>(head_dim));
+  const float* ograd = inputs[0].dptr<float>();
+  const float* qkv = inputs[1].dptr<float>();
+  float* dqkv = outputs[0].dptr<float>();
+  // the value projections receive no gradient from this op, so for kWriteTo
+  // the whole strided output is zeroed first and the gemms accumulate
+  if (req[0] == kWriteTo) {
+    mxnet_op::Kernel<mxnet_op::set_zero, cpu>::Launch(s, outputs[0].Size(), dqkv);
+  }
+  // dQ = scale * dS * K
+  StridedBatchSgemm(false, false,
+                    qkv_seq_len, head_dim, qkv_seq_len, scale,
+                    ograd, qkv_seq_len, qkv_seq_len * qkv_seq_len,
+                    qkv + head_dim, lead_dim, batch_stride,
+                    1.f, dqkv, lead_dim, batch_stride, attn_batches);
+  // dK = scale * dS^T * Q
+  StridedBatchSgemm(true, false,
+                    qkv_seq_len, head_dim, qkv_seq_len, scale,
+                    ograd, qkv_seq_len, qkv_seq_len * qkv_seq_len,
+                    qkv, lead_dim, batch_stride,
+                    1.f, dqkv + head_dim, lead_dim, batch_stride, attn_batches);
+}
+
+void InterleavedMatMulSelfAttValAttCPU(const nnvm::NodeAttrs& attrs,
+                                       const OpContext &ctx,
+                                       const std::vector<TBlob> &inputs,
+                                       const std::vector<OpReqType> &req,
+                                       const std::vector<TBlob> &outputs) {
+  const auto& params = nnvm::get<InterleavedMatMulParam>(attrs.parsed);
+  if (req[0] == kNullOp) return;
+  CHECK_EQ(inputs[0].type_flag_, mshadow::kFloat32)
+    << "interleaved_matmul_selfatt_valatt only supports float32 on CPU";
+  const index_t qkv_seq_len    = inputs[0].shape_[0];
+  const index_t sequences      = inputs[0].shape_[1];
+  const index_t output_lin_dim = inputs[0].shape_[2];
+  const index_t embed_dim      = output_lin_dim / 3;
+  const index_t head_dim       = embed_dim / params.heads;
+  const index_t attn_batches   = params.heads * sequences;
+  const index_t lead_dim       = attn_batches * 3 * head_dim;
+  const index_t batch_stride   = 3 * head_dim;
+  const float beta = req[0] == kAddTo ? 1.f : 0.f;
+  const float* qkv = inputs[0].dptr<float>();
+  const float* att = inputs[1].dptr<float>();
+  float* output = outputs[0].dptr<float>();
+  // out = att * V, written back into the interleaved [qlen, batch, embed] layout
+  StridedBatchSgemm(false, false,
+                    qkv_seq_len, head_dim, qkv_seq_len, 1.f,
+                    att, qkv_seq_len, qkv_seq_len * qkv_seq_len,
+                    qkv + 2 * head_dim, lead_dim, batch_stride,
+                    beta, output, attn_batches * head_dim, head_dim,
+                    attn_batches);
+}
+
+void BackwardInterleavedMatMulSelfAttValAttCPU(const nnvm::NodeAttrs& attrs,
+                                               const OpContext &ctx,
+                                               const std::vector<TBlob> &inputs,
+                                               const std::vector<OpReqType> &req,
+                                               const std::vector<TBlob> &outputs) {
+  const auto& params = nnvm::get<InterleavedMatMulParam>(attrs.parsed);
+  CHECK_EQ(inputs[0].type_flag_, mshadow::kFloat32)
+    << "interleaved_matmul_selfatt_valatt only supports float32 on CPU";
+  mshadow::Stream<cpu>* s = ctx.get_stream<cpu>();
+  const index_t qkv_seq_len    = inputs[1].shape_[0];
+  const index_t sequences      = inputs[1].shape_[1];
+  const index_t output_lin_dim = inputs[1].shape_[2];
+  const index_t embed_dim      = output_lin_dim / 3;
+  const index_t head_dim       = embed_dim / params.heads;
+  const index_t attn_batches   = params.heads * sequences;
+  const index_t lead_dim       = attn_batches * 3 * head_dim;
+  const index_t batch_stride   = 3 * head_dim;
+  const float* ograd = inputs[0].dptr<float>();
+  const float* qkv = inputs[1].dptr<float>();
+  const float* att = inputs[2].dptr<float>();
+  if (req[0] != kNullOp) {
+    float* dqkv = outputs[0].dptr<float>();
+    // only the value projections get a gradient here
+    if (req[0] == kWriteTo) {
+      mxnet_op::Kernel<mxnet_op::set_zero, cpu>::Launch(s, outputs[0].Size(), dqkv);
+    }
+    // dV = att^T * dOut
+    StridedBatchSgemm(true, false,
+                      qkv_seq_len, head_dim, qkv_seq_len, 1.f,
+                      att, qkv_seq_len, qkv_seq_len * qkv_seq_len,
+                      ograd, attn_batches * head_dim, head_dim,
+                      1.f, dqkv + 2 * head_dim, lead_dim, batch_stride,
+                      attn_batches);
+  }
+  if (req[1] != kNullOp) {
+    float* datt = outputs[1].dptr<float>();
+    // dAtt = dOut * V^T
+    StridedBatchSgemm(false, true,
+                      qkv_seq_len, qkv_seq_len, head_dim, 1.f,
+                      ograd, attn_batches * head_dim, head_dim,
+                      qkv + 2 * head_dim, lead_dim, batch_stride,
+                      req[1] == kAddTo ? 1.f : 0.f,
+                      datt, qkv_seq_len, qkv_seq_len * qkv_seq_len,
+                      attn_batches);
+  }
+}
+
+#else
+
+static void InterleavedMatMulUnsupportedCPU() {
+  LOG(FATAL) << "interleaved_matmul_selfatt requires cblas or MKL on CPU";
+}
+
+void InterleavedMatMulSelfAttQKCPU(const nnvm::NodeAttrs& attrs,
+                                   const OpContext &ctx,
+                                   const std::vector<TBlob> &inputs,
+                                   const std::vector<OpReqType> &req,
+                                   const std::vector<TBlob> &outputs) {
+  InterleavedMatMulUnsupportedCPU();
+}
+
+void BackwardInterleavedMatMulSelfAttQKCPU(const nnvm::NodeAttrs& attrs,
+                                           const OpContext &ctx,
+                                           const std::vector<TBlob> &inputs,
+                                           const std::vector<OpReqType> &req,
+                                           const std::vector<TBlob> &outputs) {
+  InterleavedMatMulUnsupportedCPU();
+}
+
+void InterleavedMatMulSelfAttValAttCPU(const nnvm::NodeAttrs& attrs,
+                                       const OpContext &ctx,
+                                       const std::vector<TBlob> &inputs,
+                                       const std::vector<OpReqType> &req,
+                                       const std::vector<TBlob> &outputs) {
+  InterleavedMatMulUnsupportedCPU();
+}
+
+void BackwardInterleavedMatMulSelfAttValAttCPU(const nnvm::NodeAttrs& attrs,
+                                               const OpContext &ctx,
+                                               const std::vector<TBlob> &inputs,
+                                               const std::vector<OpReqType> &req,
+                                               const std::vector<TBlob> &outputs) {
+  InterleavedMatMulUnsupportedCPU();
+}
+
+#endif  // MSHADOW_USE_CBLAS == 1 || MSHADOW_USE_MKL == 1
+
+NNVM_REGISTER_OP(_contrib_interleaved_matmul_selfatt_qk)
+.describe(R"code(Compute the matrix multiplication between the projections of
+queries and keys in multihead attention use as self attention.
+
+the input must be a single tensor of interleaved projections
+of queries, keys and values following the layout:
+(seq_length, batch_size, num_heads * head_dim * 3)
+
+the equivalent code would be:
+tmp = mx.nd.reshape(queries_keys_values, shape=(0, 0, num_heads, 3, -1))
+q_proj = mx.nd.transpose(tmp[:,:,:,0,:], axes=(1, 2, 0, 3))
+q_proj = mx.nd.reshape(q_proj, shape=(-1, 0, 0), reverse=True)
+q_proj = mx.nd.contrib.div_sqrt_dim(q_proj)
+k_proj = mx.nd.transpose(tmp[:,:,:,1,:], axes=(1, 2, 0, 3))
+k_proj = mx.nd.reshap(k_proj, shape=(-1, 0, 0), reverse=True)
+output = mx.nd.batch_dot(q_proj, k_proj, transpose_b=True)
+
+)code" ADD_FILELINE)
+.set_num_inputs(1)
+.set_num_outputs(1)
+.set_attr_parser(ParamParser<InterleavedMatMulParam>)
+.set_attr<nnvm::FListInputNames>("FListInputNames", [](const NodeAttrs& attrs) {
+  return std::vector<std::string>{"queries_keys_values"};
+})
+.set_attr<mxnet::FInferShape>("FInferShape", InterleavedMatMulSelfAttQKShape)
+.set_attr<nnvm::FInferType>("FInferType", ElemwiseType<1, 1>)
+.set_attr<FCompute>("FCompute<cpu>", InterleavedMatMulSelfAttQKCPU)
+.set_attr<nnvm::FGradient>("FGradient",
+  [](const nnvm::NodePtr& n, const std::vector<nnvm::NodeEntry>& ograds) {
+    std::vector<nnvm::NodeEntry> heads{ograds[0], n->inputs[0]};
+    auto p = MakeNode("_backward_interleaved_matmul_selfatt_qk",
+                      n->attrs.name + "_backward", &heads, &n->attrs.dict, &n);
+    std::vector<nnvm::NodeEntry> ret;
+    ret.emplace_back(p);
+    return ret;
+  })
+.add_argument("queries_keys_values", "NDArray-or-Symbol",
+              "Interleaved queries, keys and values")
+.add_arguments(InterleavedMatMulParam::__FIELDS__());
+
+NNVM_REGISTER_OP(_backward_interleaved_matmul_selfatt_qk)
+.set_num_inputs(2)
+.set_num_outputs(1)
+.set_attr_parser(ParamParser<InterleavedMatMulParam>)
+.set_attr<nnvm::TIsBackward>("TIsBackward", true)
+.set_attr<FCompute>("FCompute<cpu>", BackwardInterleavedMatMulSelfAttQKCPU);
+
+NNVM_REGISTER_OP(_contrib_interleaved_matmul_selfatt_valatt)
+.describe(R"code(Compute the matrix multiplication between the projections of
+values and the attention weights in multihead attention use as self attention.
+
+the inputs must be a tensor of interleaved projections
+of queries, keys and values following the layout:
+(seq_length, batch_size, num_heads * head_dim * 3)
+
+and the attention weights following the layout:
+(batch_size, seq_length, seq_length)
+
+the equivalent code would be:
+tmp = mx.nd.reshape(queries_keys_values, shape=(0, 0, num_heads, 3, -1))
+v_proj = mx.nd.transpose(tmp[:,:,:,2,:], axes=(1, 2, 0, 3))
+v_proj = mx.nd.reshape(v_proj, shape=(-1, 0, 0), reverse=True)
+output = mx.nd.batch_dot(attention, v_proj)
+output = mx.nd.reshape(output, shape=(-1, num_heads, 0, 0), reverse=True)
+output = mx.nd.transpose(output, axes=(2, 0, 1, 3))
+output = mx.nd.reshape(output, shape=(0, 0, -1))
+
+)code" ADD_FILELINE)
+.set_num_inputs(2)
+.set_num_outputs(1)
+.set_attr_parser(ParamParser<InterleavedMatMulParam>)
+.set_attr<nnvm::FListInputNames>("FListInputNames", [](const NodeAttrs& attrs) {
+  return std::vector<std::string>{"queries_keys_values", "attention"};
+})
+.set_attr<mxnet::FInferShape>("FInferShape", InterleavedMatMulSelfAttValAttShape)
+.set_attr<nnvm::FInferType>("FInferType", ElemwiseType<2, 1>)
+.set_attr<FCompute>("FCompute<cpu>", InterleavedMatMulSelfAttValAttCPU)
+.set_attr<nnvm::FGradient>("FGradient",
+  [](const nnvm::NodePtr& n, const std::vector<nnvm::NodeEntry>& ograds) {
+    std::vector<nnvm::NodeEntry> heads{ograds[0], n->inputs[0], n->inputs[1]};
+    auto p = MakeNode("_backward_interleaved_matmul_selfatt_valatt",
+                      n->attrs.name + "_backward", &heads, &n->attrs.dict, &n);
+    std::vector<nnvm::NodeEntry> ret;
+    ret.emplace_back(nnvm::NodeEntry{p, 0, 0});
+    ret.emplace_back(nnvm::NodeEntry{p, 1, 0});
+    return ret;
+  })
+.add_argument("queries_keys_values", "NDArray-or-Symbol",
+              "Queries, keys and values interleaved")
+.add_argument("attention", "NDArray-or-Symbol", "Attention maps")
+.add_arguments(InterleavedMatMulParam::__FIELDS__());
+
+NNVM_REGISTER_OP(_backward_interleaved_matmul_selfatt_valatt)
+.set_num_inputs(3)
+.set_num_outputs(2)
+.set_attr_parser(ParamParser<InterleavedMatMulParam>)
+.set_attr<nnvm::TIsBackward>("TIsBackward", true)
+.set_attr<FCompute>("FCompute<cpu>", BackwardInterleavedMatMulSelfAttValAttCPU);
+
 // relu
 MXNET_OPERATOR_REGISTER_UNARY(_contrib_div_sqrt_dim)
 .describe(R"code(Rescale the input by the square root of the channel dimension.
@@ -23,11 +23,270 @@
  * \brief GPU implementation of the operators used in Transformer
  */
 #include <mxnet/base.h>
+#include <cmath>
+#include <type_traits>
 #include "./transformer-inl.h"
+#include "../../common/cuda_utils.h"
 
 namespace mxnet {
 namespace op {
 
+// Strided batched gemm on the interleaved QKV layout, row-major semantics
+// with fp32 accumulation for both fp16 and fp32 I/O. The row-major call is
+// mapped onto cublas' column-major interface by swapping the operands.
+template<typename DType>
+void StridedBatchedGemm(mshadow::Stream<gpu>* s, bool transA, bool transB,
+                        index_t m, index_t n, index_t k, float alpha,
+                        const DType* a, index_t lda, index_t stride_a,
+                        const DType* b, index_t ldb, index_t stride_b,
+                        float beta, DType* c, index_t ldc, index_t stride_c,
+                        index_t batch) {
+#if CUDA_VERSION >= 9010
+  using namespace mshadow::cuda;
+  auto blas_handle = mshadow::Stream<gpu>::GetBlasHandle(s);
+  bool use_tensor_ops = GetEnvAllowTensorCore();
+  auto cublas_math_mode =
+      use_tensor_ops ? CUBLAS_TENSOR_OP_MATH : CUBLAS_DEFAULT_MATH;
+  auto previous_math_mode = SetCublasMathMode(blas_handle, cublas_math_mode);
+  const cudaDataType_t data_type =
+      std::is_same<DType, mshadow::half::half_t>::value ? CUDA_R_16F : CUDA_R_32F;
+  CUBLAS_CALL(cublasGemmStridedBatchedEx(
+      blas_handle,
+      (transB ? CUBLAS_OP_T : CUBLAS_OP_N),
+      (transA ? CUBLAS_OP_T : CUBLAS_OP_N),
+      n, m, k, &alpha,
+      b, data_type, ldb, stride_b,
+      a, data_type, lda, stride_a,
+      &beta,
+      c, data_type, ldc, stride_c,
+      batch, CUDA_R_32F,
+      use_tensor_ops ? CUBLAS_GEMM_DEFAULT_TENSOR_OP : CUBLAS_GEMM_DEFAULT));
+  SetCublasMathMode(blas_handle, previous_math_mode);
+#else
+  LOG(FATAL) << "interleaved_matmul_selfatt requires CUDA >= 9.1";
+#endif  // CUDA_VERSION >= 9010
+}
+
+template<typename DType>
+void InterleavedMatMulSelfAttQKGPUImpl(mshadow::Stream<gpu>* s,
+                                       const InterleavedMatMulParam& params,
+                                       const std::vector<TBlob>& inputs,
+                                       const std::vector<OpReqType>& req,
+                                       const std::vector<TBlob>& outputs) {
+  const index_t qkv_seq_len  = inputs[0].shape_[0];
+  const index_t sequences    = inputs[0].shape_[1];
+  const index_t embed_dim    = inputs[0].shape_[2] / 3;
+  const index_t head_dim     = embed_dim / params.heads;
+  const index_t attn_batches = params.heads * sequences;
+  const index_t lead_dim     = attn_batches * 3 * head_dim;
+  const index_t batch_stride = 3 * head_dim;
+  const float scale = 1.f / sqrtf(static_cast<float>(head_dim));
+  const DType* qkv = inputs[0].dptr<DType>();
+  DType* output = outputs[0].dptr<DType>();
+  StridedBatchedGemm(s, false, true,
+                     qkv_seq_len, qkv_seq_len, head_dim, scale,
+                     qkv, lead_dim, batch_stride,
+                     qkv + head_dim, lead_dim, batch_stride,
+                     req[0] == kAddTo ? 1.f : 0.f,
+                     output, qkv_seq_len, qkv_seq_len * qkv_seq_len,
+                     attn_batches);
+}
+
+void InterleavedMatMulSelfAttQKGPU(const nnvm::NodeAttrs& attrs,
+                                   const OpContext &ctx,
+                                   const std::vector<TBlob> &inputs,
+                                   const std::vector<OpReqType> &req,
+                                   const std::vector<TBlob> &outputs) {
+  const auto& params = nnvm::get<InterleavedMatMulParam>(attrs.parsed);
+  if (req[0] == kNullOp) return;
+  mshadow::Stream<gpu>* s = ctx.get_stream<gpu>();
+  if (inputs[0].type_flag_ == mshadow::kFloat32) {
+    InterleavedMatMulSelfAttQKGPUImpl<float>(s, params, inputs, req, outputs);
+  } else if (inputs[0].type_flag_ == mshadow::kFloat16) {
+    InterleavedMatMulSelfAttQKGPUImpl<mshadow::half::half_t>(
+        s, params, inputs, req, outputs);
+  } else {
+    LOG(FATAL) << "interleaved_matmul_selfatt_qk only supports float16 and "
+               << "float32 on GPU";
+  }
+}
+
+template<typename DType>
+void BackwardInterleavedMatMulSelfAttQKGPUImpl(mshadow::Stream<gpu>* s,
+                                               const InterleavedMatMulParam& params,
+                                               const std::vector<TBlob>& inputs,
+                                               const std::vector<OpReqType>& req,
+                                               const std::vector<TBlob>& outputs) {
+  const index_t qkv_seq_len  = inputs[1].shape_[0];
+  const index_t sequences    = inputs[1].shape_[1];
+  const index_t embed_dim    = inputs[1].shape_[2] / 3;
+  const index_t head_dim     = embed_dim / params.heads;
+  const index_t attn_batches = params.heads * sequences;
+  const index_t lead_dim     = attn_batches * 3 * head_dim;
+  const index_t batch_stride = 3 * head_dim;
+  const float scale = 1.f / sqrtf(static_cast<float>(head_dim));
+  const DType* ograd = inputs[0].dptr<DType>();
+  const DType* qkv = inputs[1].dptr<DType>();
+  DType* dqkv = outputs[0].dptr<DType>();
+  // the value projections receive no gradient from this op, so for kWriteTo
+  // the whole strided output is zeroed first and the gemms accumulate
+  if (req[0] == kWriteTo) {
+    mxnet_op::Kernel<mxnet_op::set_zero, gpu>::Launch(s, outputs[0].Size(), dqkv);
+  }
+  // dQ = scale * dS * K
+  StridedBatchedGemm(s, false, false,
+                     qkv_seq_len, head_dim, qkv_seq_len, scale,
+                     ograd, qkv_seq_len, qkv_seq_len * qkv_seq_len,
+                     qkv + head_dim, lead_dim, batch_stride,
+                     1.f, dqkv, lead_dim, batch_stride, attn_batches);
+  // dK = scale * dS^T * Q
+  StridedBatchedGemm(s, true, false,
+                     qkv_seq_len, head_dim, qkv_seq_len, scale,
+                     ograd, qkv_seq_len, qkv_seq_len * qkv_seq_len,
+                     qkv, lead_dim, batch_stride,
+                     1.f, dqkv + head_dim, lead_dim, batch_stride, attn_batches);
+}
+
+void BackwardInterleavedMatMulSelfAttQKGPU(const nnvm::NodeAttrs& attrs,
+                                           const OpContext &ctx,
+                                           const std::vector<TBlob> &inputs,
+                                           const std::vector<OpReqType> &req,
+                                           const std::vector<TBlob> &outputs) {
+  const auto& params = nnvm::get<InterleavedMatMulParam>(attrs.parsed);
+  if (req[0] == kNullOp) return;
+  mshadow::Stream<gpu>* s = ctx.get_stream<gpu>();
+  if (inputs[0].type_flag_ == mshadow::kFloat32) {
+    BackwardInterleavedMatMulSelfAttQKGPUImpl<float>(
+        s, params, inputs, req, outputs);
+  } else if (inputs[0].type_flag_ == mshadow::kFloat16) {
+    BackwardInterleavedMatMulSelfAttQKGPUImpl<mshadow::half::half_t>(
+        s, params, inputs, req, outputs);
+  } else {
+    LOG(FATAL) << "interleaved_matmul_selfatt_qk only supports float16 and "
+               << "float32 on GPU";
+  }
+}
+
+template<typename DType>
+void InterleavedMatMulSelfAttValAttGPUImpl(mshadow::Stream<gpu>* s,
+                                           const InterleavedMatMulParam& params,
+                                           const std::vector<TBlob>& inputs,
+                                           const std::vector<OpReqType>& req,
+                                           const std::vector<TBlob>& outputs) {
+  const index_t qkv_seq_len  = inputs[0].shape_[0];
+  const index_t sequences    = inputs[0].shape_[1];
+  const index_t embed_dim    = inputs[0].shape_[2] / 3;
+  const index_t head_dim     = embed_dim / params.heads;
+  const index_t attn_batches = params.heads * sequences;
+  const index_t lead_dim     = attn_batches * 3 * head_dim;
+  const index_t batch_stride = 3 * head_dim;
+  const DType* qkv = inputs[0].dptr<DType>();
+  const DType* att = inputs[1].dptr<DType>();
+  DType* output = outputs[0].dptr<DType>();
+  // out = att * V, written back into the interleaved [qlen, batch, embed] layout
+  StridedBatchedGemm(s, false, false,
+                     qkv_seq_len, head_dim, qkv_seq_len, 1.f,
+                     att, qkv_seq_len, qkv_seq_len * qkv_seq_len,
+                     qkv + 2 * head_dim, lead_dim, batch_stride,
+                     req[0] == kAddTo ? 1.f : 0.f,
+                     output, attn_batches * head_dim, head_dim,
+                     attn_batches);
+}
+
+void InterleavedMatMulSelfAttValAttGPU(const nnvm::NodeAttrs& attrs,
+                                       const OpContext &ctx,
+                                       const std::vector<TBlob> &inputs,
+                                       const std::vector<OpReqType> &req,
+                                       const std::vector<TBlob> &outputs) {
+  const auto& params = nnvm::get<InterleavedMatMulParam>(attrs.parsed);
+  if (req[0] == kNullOp) return;
+  mshadow::Stream<gpu>* s = ctx.get_stream<gpu>();
+  if (inputs[0].type_flag_ == mshadow::kFloat32) {
+    InterleavedMatMulSelfAttValAttGPUImpl<float>(s, params, inputs, req, outputs);
+  } else if (inputs[0].type_flag_ == mshadow::kFloat16) {
+    InterleavedMatMulSelfAttValAttGPUImpl<mshadow::half::half_t>(
+        s, params, inputs, req, outputs);
+  } else {
+    LOG(FATAL) << "interleaved_matmul_selfatt_valatt only supports float16 and "
+               << "float32 on GPU";
+  }
+}
+
+template<typename DType>
+void BackwardInterleavedMatMulSelfAttValAttGPUImpl(
+    mshadow::Stream<gpu>* s,
+    const InterleavedMatMulParam& params,
+    const std::vector<TBlob>& inputs,
+    const std::vector<OpReqType>& req,
+    const std::vector<TBlob>& outputs) {
+  const index_t qkv_seq_len  = inputs[1].shape_[0];
+  const index_t sequences    = inputs[1].shape_[1];
+  const index_t embed_dim    = inputs[1].shape_[2] / 3;
+  const index_t head_dim     = embed_dim / params.heads;
+  const index_t attn_batches = params.heads * sequences;
+  const index_t lead_dim     = attn_batches * 3 * head_dim;
+  const index_t batch_stride = 3 * head_dim;
+  const DType* ograd = inputs[0].dptr<DType>();
+  const DType* qkv = inputs[1].dptr<DType>();
+  const DType* att = inputs[2].dptr<DType>();
+  if (req[0] != kNullOp) {
+    DType* dqkv = outputs[0].dptr<DType>();
+    // only the value projections get a gradient here
+    if (req[0] == kWriteTo) {
+      mxnet_op::Kernel<mxnet_op::set_zero, gpu>::Launch(s, outputs[0].Size(), dqkv);
+    }
+    // dV = att^T * dOut
+    StridedBatchedGemm(s, true, false,
+                       qkv_seq_len, head_dim, qkv_seq_len, 1.f,
+                       att, qkv_seq_len, qkv_seq_len * qkv_seq_len,
+                       ograd, attn_batches * head_dim, head_dim,
+                       1.f, dqkv + 2 * head_dim, lead_dim, batch_stride,
+                       attn_batches);
+  }
+  if (req[1] != kNullOp) {
+    DType* datt = outputs[1].dptr<DType>();
+    // dAtt = dOut * V^T
+    StridedBatchedGemm(s, false, true,
+                       qkv_seq_len, qkv_seq_len, head_dim, 1.f,
+                       ograd, attn_batches * head_dim, head_dim,
+                       qkv + 2 * head_dim, lead_dim, batch_stride,
+                       req[1] == kAddTo ? 1.f : 0.f,
+                       datt, qkv_seq_len, qkv_seq_len * qkv_seq_len,
+                       attn_batches);
+  }
+}
+
+void BackwardInterleavedMatMulSelfAttValAttGPU(const nnvm::NodeAttrs& attrs,
+                                               const OpContext &ctx,
+                                               const std::vector<TBlob> &inputs,
+                                               const std::vector<OpReqType> &req,
+                                               const std::vector<TBlob> &outputs) {
+  const auto& params = nnvm::get<InterleavedMatMulParam>(attrs.parsed);
+  mshadow::Stream<gpu>* s = ctx.get_stream<gpu>();
+  if (inputs[0].type_flag_ == mshadow::kFloat32) {
+    BackwardInterleavedMatMulSelfAttValAttGPUImpl<float>(
+        s, params, inputs, req, outputs);
+  } else if (inputs[0].type_flag_ == mshadow::kFloat16) {
+    BackwardInterleavedMatMulSelfAttValAttGPUImpl<mshadow::half::half_t>(
+        s, params, inputs, req, outputs);
+  } else {
+    LOG(FATAL) << "interleaved_matmul_selfatt_valatt only supports float16 and "
+               << "float32 on GPU";
+  }
+}
+
+NNVM_REGISTER_OP(_contrib_interleaved_matmul_selfatt_qk)
+.set_attr<FCompute>("FCompute<gpu>", InterleavedMatMulSelfAttQKGPU);
+
+NNVM_REGISTER_OP(_backward_interleaved_matmul_selfatt_qk)
+.set_attr<FCompute>("FCompute<gpu>", BackwardInterleavedMatMulSelfAttQKGPU);
+
+NNVM_REGISTER_OP(_contrib_interleaved_matmul_selfatt_valatt)
+.set_attr<FCompute>("FCompute<gpu>", InterleavedMatMulSelfAttValAttGPU);
+
+NNVM_REGISTER_OP(_backward_interleaved_matmul_selfatt_valatt)
+.set_attr<FCompute>("FCompute<gpu>", BackwardInterleavedMatMulSelfAttValAttGPU);
+
 // relu
 NNVM_REGISTER_OP(_contrib_div_sqrt_dim)
 .set_attr<FCompute>("FCompute<gpu>", DivSqrtDimForward_<gpu>);
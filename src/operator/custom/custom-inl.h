@@ -33,6 +33,7 @@
 #include <mxnet/imperative.h>
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <vector>
 #include <string>
 #include <utility>
@@ -100,7 +101,11 @@ class CustomOperator {
       return;
     }
     std::unique_lock<std::mutex> lock(mutex_);
-    q_.push([=]() mutable {
+    // each op type gets its own task queue and worker pool, so an op type
+    // whose callbacks serialize (e.g. on the Python GIL) does not delay
+    // dispatch of other custom op types
+    TaskQueue* tq = GetQueue(op_type);
+    tq->q.push([=]() mutable {
       bool prev_recording = Imperative::Get()->set_is_recording(recording);
       bool prev_training = Imperative::Get()->set_is_training(training);
 
@@ -160,9 +165,9 @@ class CustomOperator {
           ctx.run_ctx.ctx, vars, vars2, FnProperty::kNoSkip, 0, "CustomOperatorWait");
     });
     // increase num_threads if there is not enough threads to execute custom operator
-    if (q_.size() > num_free_threads_)
-      CreateThreads(q_.size() - num_free_threads_);
-    cv_.notify_all();
+    if (tq->q.size() > tq->num_free_threads)
+      CreateThreads(tq, tq->q.size() - tq->num_free_threads);
+    tq->cv.notify_all();
   }
 
   static CustomOperator* Get() {
@@ -171,7 +176,6 @@ class CustomOperator {
   }
 
   void Start() {
-    num_free_threads_ = 0;
     destructing_ = false;
     naive_engine_ = true;
     exception_ = nullptr;
@@ -185,11 +189,14 @@ class CustomOperator {
     {
       std::unique_lock<std::mutex> lock(mutex_);
       destructing_ = true;
-      cv_.notify_all();
+      for (auto &kv : queues_)
+        kv.second->cv.notify_all();
     }
-    for (auto &worker : workers_)
-      worker.join();
-    workers_.clear();
+    for (auto &kv : queues_) {
+      for (auto &worker : kv.second->workers)
+        worker.join();
+    }
+    queues_.clear();
   }
 
   inline void Throw() {
@@ -201,40 +208,53 @@ class CustomOperator {
   }
 
  private:
+  // task queue and worker pool of one custom op type
+  struct TaskQueue {
+    std::condition_variable cv;
+    std::vector<std::thread> workers;
+    std::atomic<uint32_t> num_free_threads{0};
+    std::queue<std::function<void(void)> > q;
+  };
+
   CustomOperator() {
     this->Start();
   }
-  void ThreadTarget() {
+  // must be called with mutex_ held
+  TaskQueue* GetQueue(const std::string &op_type) {
+    auto it = queues_.find(op_type);
+    if (it == queues_.end()) {
+      it = queues_.emplace(op_type, std::unique_ptr<TaskQueue>(new TaskQueue())).first;
+    }
+    return it->second.get();
+  }
+  void ThreadTarget(TaskQueue* tq) {
     std::unique_lock<std::mutex> lock(mutex_);
-    while (!q_.empty() || !destructing_) {
-      cv_.wait(lock, [&] {return !q_.empty() || destructing_;});
-      while (!q_.empty()) {
-        --num_free_threads_;
-        auto fn = q_.front();
-        q_.pop();
+    while (!tq->q.empty() || !destructing_) {
+      tq->cv.wait(lock, [&] {return !tq->q.empty() || destructing_;});
+      while (!tq->q.empty()) {
+        --tq->num_free_threads;
+        auto fn = tq->q.front();
+        tq->q.pop();
         lock.unlock();
         fn();
-        ++num_free_threads_;
+        ++tq->num_free_threads;
         lock.lock();
       }
     }
   }
-  void SetNumThreads(int num_threads) {
-    for (int i = workers_.size(); i < num_threads; ++i) {
-      workers_.emplace_back(std::thread([this]{this->ThreadTarget();}));
-      ++num_free_threads_;
+  void SetNumThreads(TaskQueue* tq, int num_threads) {
+    for (int i = tq->workers.size(); i < num_threads; ++i) {
+      tq->workers.emplace_back(std::thread([this, tq]{this->ThreadTarget(tq);}));
+      ++tq->num_free_threads;
     }
   }
-  void CreateThreads(int num_new_threads) {
-    SetNumThreads(workers_.size() + num_new_threads);
+  void CreateThreads(TaskQueue* tq, int num_new_threads) {
+    SetNumThreads(tq, tq->workers.size() + num_new_threads);
   }
   std::mutex mutex_;
   std::map<std::string, CustomOpPropCreator> registry_;
-  // async worker
-  std::condition_variable cv_;
-  std::vector<std::thread> workers_;
-  std::atomic<uint32_t> num_free_threads_;
-  std::queue<std::function<void(void)> > q_;
+  // async workers, one pool per op type
+  std::map<std::string, std::unique_ptr<TaskQueue> > queues_;
   std::shared_ptr<std::exception_ptr> exception_;
   bool naive_engine_;
   bool destructing_;
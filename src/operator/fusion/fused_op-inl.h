@@ -24,8 +24,6 @@
 #include <map>
 #include <vector>
 
-#if MXNET_USE_CUDA
-
 namespace mxnet {
 
 namespace fusion {
@@ -231,6 +229,31 @@ const std::map<std::string, std::string> slice_ops = {
   {"broadcast_like"   , ""},
 };
 
+// Binary broadcast ops. They are only fused as first nodes of the
+// subgraph, with both operands being subgraph inputs, because the rest
+// of the fused kernel indexes every tensor with the flat offset of the
+// broadcasted shape.
+const std::map<std::string, std::string> broadcast_ops = {
+  {"broadcast_add"     , "add"},
+  {"broadcast_plus"    , "add"},
+  {"broadcast_sub"     , "sub"},
+  {"broadcast_minus"   , "sub"},
+  {"broadcast_mul"     , "mul"},
+  {"broadcast_div"     , "div"},
+  {"broadcast_maximum" , "max"},
+  {"broadcast_minimum" , "min"},
+  {"broadcast_power"   , "power"},
+  {"broadcast_hypot"   , "hypot"},
+};
+
+// Reductions over the innermost axis. They are only fused as the final
+// node of the subgraph, turning the fused kernel into one thread per
+// output element looping over the reduced axis.
+const std::map<std::string, std::string> reduce_ops = {
+  {"sum"  , ""},
+  {"mean" , ""},
+};
+
 const std::vector<std::string> variable_io_ops = {
   "add_n",
   "_backward_Activation",
@@ -281,6 +304,18 @@ struct VectorConfig {
     using IndexType = float;
 };
 
+// nvec == 1 is used by the reduction kernels, where loads of a single
+// half or int8 element fall below the 4B of the generic VectorConfig
+template <>
+struct VectorConfig<1> {
+    using IndexType = char;
+};
+
+template <>
+struct VectorConfig<2> {
+    using IndexType = unsigned short;
+};
+
 template <>
 struct VectorConfig<8> {
     using IndexType = double;
@@ -446,6 +481,29 @@ inline VectorType<DType, nvec> fast_load_slice(const DType * input, const Shape<
   return global_load_index<nvec>(input, idx, shape);
 }
 
+template <int nvec, typename DType, int ndim>
+inline VectorType<DType, nvec> load_broadcast(const DType * input, const Shape<ndim>& shape,
+                                              const Shape<ndim>& ref_shape, int offset) {
+  VectorType<DType, nvec> ret;
+  #pragma unroll
+  for (int j = 0; j < nvec; j++) {
+    int idx = 0;
+    int ref_idx = offset + j;
+    int stride = 1;
+    #pragma unroll
+    for (int dim = ndim-1; dim >= 0; dim--) {
+      const int dim_idx = ref_idx % ref_shape[dim];
+      if (shape[dim] > 1) {
+        idx += dim_idx * stride;
+      }
+      stride *= shape[dim];
+      ref_idx /= ref_shape[dim];
+    }
+    ret.x[j] = *(input + idx);
+  }
+  return ret;
+}
+
 template <int nvec, typename DType, int ndim>
 inline void store_index(const VectorType<DType, nvec> value, int i,
                         DType * output, const Shape<ndim>& shape) {
@@ -994,6 +1052,4 @@ const char kernel_end[] = R"code(
 
 }  // namespace mxnet
 
-#endif  // MXNET_USE_CUDA
-
 #endif  // MXNET_OPERATOR_FUSION_FUSED_OP_INL_H_
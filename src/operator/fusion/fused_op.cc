@@ -20,11 +20,10 @@
 #include <tuple>
 
 #include "./fused_op.h"
+#include "./fused_op-inl.h"
 #include "../operator_common.h"
 #include "../../executor/exec_pass.h"
 
-#if MXNET_USE_CUDA
-
 namespace mxnet {
 
 DMLC_REGISTER_PARAMETER(FusedOpConfig);
@@ -55,8 +54,20 @@ FusedOp::FusedOp(const nnvm::NodeAttrs* attrs, const FusedOpConfig& config) {
   this->subgraph_ = nnvm::Graph();
   this->subgraph_.outputs = attrs->subgraphs[0]->outputs;
   this->initialized_ = false;
+  this->tail_reduction_ = false;
+  this->specialize_shapes_ = dmlc::GetEnv("MXNET_FUSION_STATIC_SHAPES", false);
+  const auto& g = this->subgraph_.indexed_graph();
+  if (g.outputs().size() == 1) {
+    const auto* source = g[g.outputs()[0].node_id].source;
+    if (source != nullptr && !source->is_variable() &&
+        fusion::reduce_ops.count(source->op()->name)) {
+      this->tail_reduction_ = true;
+    }
+  }
   this->cc_major_ = -1;
   this->cc_minor_ = -1;
+  this->cpu_num_slots_ = 0;
+  this->cpu_initialized_ = false;
 }
 
 bool FusedOp::InferShape(const nnvm::NodeAttrs &attrs,
@@ -303,5 +314,3 @@ NNVM_REGISTER_OP(_FusedOpOutHelper)
 .set_attr<exec::FAccessSubgraphType>("FAccessSubgraphType", FusedOpOutHelperType);
 
 }  // namespace mxnet
-
-#endif  // MXNET_USE_CUDA
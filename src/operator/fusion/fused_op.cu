@@ -134,6 +134,21 @@ std::string ParseOpDescription(const std::vector<std::string>& op_desc,
   return fmt;
 }
 
+std::string ShapeLiteral(const mxnet::TShape& shape) {
+  const int ndim = shape.ndim();
+  std::string ret = "{";
+  if (ndim > 0) {
+    ret += "{";
+    for (int i = 0; i < ndim; ++i) {
+      if (i > 0) ret += ", ";
+      ret += std::to_string(shape[i]);
+    }
+    ret += "}, ";
+  }
+  ret += std::to_string(shape.Size()) + "}";
+  return ret;
+}
+
 void AddShape(const mxnet::TShape& shape,
               std::vector<std::vector<int>>* shapes) {
   // We need alignment to 8 bytes for size_t in the Shape struct
@@ -180,8 +195,11 @@ void FusedOp::GenerateCode(int kernel_index, const std::vector<OpReqType> &req,
   int temp_name_counter = 0;
   using NodeEntry = nnvm::IndexedGraph::NodeEntry;
   std::map<std::pair<int, int>, std::string> variables;
+  std::map<int, std::vector<std::string>> broadcast_vecs;
   std::map<int, int> load_index;
   bool check_shapes_compile = true;
+  const int reduce_nid = tail_reduction_ ?
+                         static_cast<int>(g.outputs()[0].node_id) : -1;
 
   std::vector<uint32_t> outputs(g.num_nodes());
 
@@ -205,9 +223,33 @@ void FusedOp::GenerateCode(int kernel_index, const std::vector<OpReqType> &req,
             if (fusion::slice_ops.find(op_name) != fusion::slice_ops.end()) {
                 load_index[node.inputs[0].node_id] = 0;
             }
+            if (fusion::broadcast_ops.find(op_name) != fusion::broadcast_ops.end()) {
+                load_index[node.inputs[0].node_id] = 0;
+                load_index[node.inputs[1].node_id] = 0;
+            }
         }
     }
   }
+
+  if (tail_reduction_) {
+    // one thread per element of the reduced output, looping over the
+    // innermost axis of the reduction input; the loads and the
+    // pointwise body below are emitted inside this loop and the final
+    // node of the subgraph accumulates instead of storing
+    const auto& red_node = g[reduce_nid];
+    const uint32_t red_in_eid = g.entry_id(red_node.inputs[0]);
+    if (std::find(extra_shape_args_.begin(), extra_shape_args_.end(), red_in_eid) ==
+        extra_shape_args_.end()) {
+      extra_shape_args_.push_back(red_in_eid);
+    }
+    const int red_ndim = node_shapes[red_in_eid].ndim();
+    const std::string red_shape_name = "extra_" + std::to_string(red_in_eid) + "_shape";
+    code += "const int red_size = " + red_shape_name + "[" +
+            std::to_string(red_ndim - 1) + "];\n";
+    code += "op::LoadType<DType_output0>::Type red_acc = 0;\n";
+    code += "for (int red_i = 0; red_i < red_size; ++red_i) {\n";
+    code += "const int offset = i * red_size + red_i;\n";
+  }
   for (size_t i = 0; i < g.num_nodes(); ++i) {
     const auto& node = g[i];
     const auto* source = node.source;
@@ -311,6 +353,29 @@ void FusedOp::GenerateCode(int kernel_index, const std::vector<OpReqType> &req,
           variables[{i, 0}] = vec_name;
           continue;
         }
+        if (fusion::broadcast_ops.find(op_name) != fusion::broadcast_ops.end()) {
+          // both operands are subgraph inputs and are loaded with the
+          // index math of the broadcasted (output) shape of this node
+          const uint32_t out_entry_id = g.entry_id(i, 0);
+          if (std::find(extra_shape_args_.begin(), extra_shape_args_.end(), out_entry_id) ==
+              extra_shape_args_.end()) {
+            extra_shape_args_.push_back(out_entry_id);
+          }
+          const std::string ref_shape_name = "extra_" + std::to_string(out_entry_id) + "_shape";
+          for (size_t arg = 0; arg < 2; ++arg) {
+            const int node_id = node.inputs[arg].node_id;
+            const auto& var_name = g[node_id].source->attrs.name;
+            const auto vec_name = "vec_" + var_name + "_" + std::to_string(i) +
+                                  "_" + std::to_string(arg);
+            load_index[node_id] = 0;
+            code += "const auto " + vec_name + " = op::load_broadcast<nvec>(" +
+                    var_name + ", " + var_name + "_shape, " + ref_shape_name +
+                    ", offset);\n";
+            broadcast_vecs[i].push_back(vec_name);
+          }
+          CHECK_EQ(outputs[i], 1);
+          continue;
+        }
       }
     }
   }
@@ -320,17 +385,20 @@ void FusedOp::GenerateCode(int kernel_index, const std::vector<OpReqType> &req,
   }
 
   size_t counter = 0;
-  for (const auto& entry : g.outputs()) {
-    std::string var_name = "output" + std::to_string(counter);
-    code += "op::VectorType<DType_" + var_name + \
-            ", nvec> vec_" + var_name + ";\n";
-    ++counter;
+  if (!tail_reduction_) {
+    for (const auto& entry : g.outputs()) {
+      std::string var_name = "output" + std::to_string(counter);
+      code += "op::VectorType<DType_" + var_name + \
+              ", nvec> vec_" + var_name + ";\n";
+      ++counter;
+    }
   }
 
   code += "for (int j = 0; j < nvec; j++ ) {\n";
 
 
   for (size_t i = 0; i < g.num_nodes(); ++i) {
+    if (static_cast<int>(i) == reduce_nid) continue;
     const auto& node = g[i];
     const auto* source = node.source;
     if (source != nullptr) {
@@ -365,6 +433,14 @@ void FusedOp::GenerateCode(int kernel_index, const std::vector<OpReqType> &req,
           continue;
         }
 
+        if (fusion::broadcast_ops.find(op_name) != fusion::broadcast_ops.end()) {
+          const auto& vecs = broadcast_vecs.at(i);
+          code += "const auto " + var_name + " = op::" + fusion::broadcast_ops.at(op_name) +
+                  "(op::load(" + vecs[0] + ".x[j]), op::load(" + vecs[1] + ".x[j]));\n";
+          variables[{i, 0}] = var_name;
+          continue;
+        }
+
 
         // Special cases with variable number
         // of inputs/outputs, listed in
@@ -429,34 +505,56 @@ void FusedOp::GenerateCode(int kernel_index, const std::vector<OpReqType> &req,
     }
   }
 
-  counter = 0;
-  for (const auto& entry : g.outputs()) {
-    const std::string& var = variables[{entry.node_id, entry.index}];
-    const auto var_name = "output" + std::to_string(counter);
-    code += "vec_" + var_name + ".x[j] = op::store("+ var +", " + var_name + ");\n";
-    ++counter;
-  }
-
-  code += "}\n";
-
-  counter = 0;
-
-  for (const auto& entry : g.outputs()) {
-    const std::string& var = variables[{entry.node_id, entry.index}];
-    if (req[counter] == kWriteTo || req[counter] == kWriteInplace) {
-      const auto var_name = "output" + std::to_string(counter);
-      code += "op::store_index(vec_" + var_name + ", i, " + var_name + ", " +
-              var_name + "_shape);\n";
-    } else if (req[counter] == kAddTo) {
-      const auto var_name = "output" + std::to_string(counter);
-      code += "op::store_add_index(vec_" + var_name + ", i, " + var_name + ", " +
-              var_name + "_shape);\n";
-    } else if (req[counter] == kNullOp) {
+  if (tail_reduction_) {
+    const auto& red_node = g[reduce_nid];
+    const std::string& var = variables[{red_node.inputs[0].node_id,
+                                        red_node.inputs[0].index}];
+    code += "red_acc = op::add(red_acc, " + var + ");\n";
+    code += "}\n";
+    // close the loop over the reduced axis
+    code += "}\n";
+    if (red_node.source->op()->name == "mean") {
+      code += "red_acc = red_acc / red_size;\n";
+    }
+    if (req[0] == kWriteTo || req[0] == kWriteInplace) {
+      code += "output0[i] = op::store(red_acc, output0);\n";
+    } else if (req[0] == kAddTo) {
+      code += "output0[i] = op::store(op::add(op::load(output0[i]), red_acc), output0);\n";
+    } else if (req[0] == kNullOp) {
       // NULL req, do not do anything
     } else {
       LOG(FATAL) << "Encountered unexpected req.";
     }
-    ++counter;
+  } else {
+    counter = 0;
+    for (const auto& entry : g.outputs()) {
+      const std::string& var = variables[{entry.node_id, entry.index}];
+      const auto var_name = "output" + std::to_string(counter);
+      code += "vec_" + var_name + ".x[j] = op::store("+ var +", " + var_name + ");\n";
+      ++counter;
+    }
+
+    code += "}\n";
+
+    counter = 0;
+
+    for (const auto& entry : g.outputs()) {
+      const std::string& var = variables[{entry.node_id, entry.index}];
+      if (req[counter] == kWriteTo || req[counter] == kWriteInplace) {
+        const auto var_name = "output" + std::to_string(counter);
+        code += "op::store_index(vec_" + var_name + ", i, " + var_name + ", " +
+                var_name + "_shape);\n";
+      } else if (req[counter] == kAddTo) {
+        const auto var_name = "output" + std::to_string(counter);
+        code += "op::store_add_index(vec_" + var_name + ", i, " + var_name + ", " +
+                var_name + "_shape);\n";
+      } else if (req[counter] == kNullOp) {
+        // NULL req, do not do anything
+      } else {
+        LOG(FATAL) << "Encountered unexpected req.";
+      }
+      ++counter;
+    }
   }
 
   this->code_[kernel_index] = code;
@@ -467,6 +565,7 @@ void FusedOp::GenerateCode(int kernel_index, const std::vector<OpReqType> &req,
   }
   std::string kernel_params = "";
   std::string tensor_params = "";
+  std::string shape_init = "";
   nnvm::Symbol sym;
   sym.outputs = this->subgraph_.outputs;
   const std::vector<std::string> input_names = sym.ListInputNames(nnvm::Symbol::kAll);
@@ -474,11 +573,27 @@ void FusedOp::GenerateCode(int kernel_index, const std::vector<OpReqType> &req,
   size_t i = 0;
   std::string aux_code = "static const int nvec = " + std::to_string(nvec) + ";\n";
 
+  if (specialize_shapes_) {
+    // shapes and the loop bound become compile-time constants folded into
+    // the index math, so the kernel only receives the tensor pointers
+    size_t max_size = 0;
+    for (const auto& entry : g.outputs()) {
+      max_size = std::max(max_size, node_shapes[g.entry_id(entry)].Size());
+    }
+    const size_t n_elems = (max_size + nvec - 1) / nvec;
+    shape_init += "const size_t N = " + std::to_string(n_elems) + ";\n";
+  }
+
   for (const auto &shape_id : extra_shape_args_) {
       std::string shape_name = "extra_" + std::to_string(shape_id) + "_shape";
       int ndim = node_shapes[shape_id].ndim();
-      kernel_params += " const op::Shape<" + std::to_string(ndim) + "> " + shape_name;
-      kernel_params += ", ";
+      if (specialize_shapes_) {
+        shape_init += "const op::Shape<" + std::to_string(ndim) + "> " + shape_name +
+                      " = " + ShapeLiteral(node_shapes[shape_id]) + ";\n";
+      } else {
+        kernel_params += " const op::Shape<" + std::to_string(ndim) + "> " + shape_name;
+        kernel_params += ", ";
+      }
   }
   for (const auto &type : in_dtypes) {
     std::string type_name = mshadowTypeToString(type);
@@ -488,12 +603,18 @@ void FusedOp::GenerateCode(int kernel_index, const std::vector<OpReqType> &req,
     aux_code = "using " + dtype_var + " = " + type_name + ";\n" + aux_code;
     aux_code = "static const int " + dim_var + " = " + dim_val + ";\n" + aux_code;
     tensor_params += dtype_var + "* " +input_names[i];
-    kernel_params += " const op::Shape<" + dim_val + "> " + input_names[i]+"_shape";
+    if (specialize_shapes_) {
+      const auto& shape = node_shapes[g.entry_id(g.input_nodes()[i], 0)];
+      shape_init += "const op::Shape<" + dim_val + "> " + input_names[i] +
+                    "_shape = " + ShapeLiteral(shape) + ";\n";
+    } else {
+      kernel_params += " const op::Shape<" + dim_val + "> " + input_names[i]+"_shape";
+      kernel_params += ", ";
+    }
     ++i;
     if (i < num_params) {
       tensor_params += ", ";
     }
-    kernel_params += ", ";
   }
   for (const auto &type : out_dtypes) {
     std::string type_name = mshadowTypeToString(type);
@@ -504,12 +625,18 @@ void FusedOp::GenerateCode(int kernel_index, const std::vector<OpReqType> &req,
     aux_code = "static const int " + dim_var + " = " + dim_val + ";\n" + aux_code;
     aux_code = "using " + dtype_var + " = " + type_name + ";\n" + aux_code;
     tensor_params += dtype_var + "* " + out_name;
-    kernel_params += " const op::Shape<" + dim_val + "> " + out_name+"_shape";
+    if (specialize_shapes_) {
+      const auto& shape = node_shapes[g.entry_id(g.outputs()[i - in_dtypes.size()])];
+      shape_init += "const op::Shape<" + dim_val + "> " + out_name +
+                    "_shape = " + ShapeLiteral(shape) + ";\n";
+    } else {
+      kernel_params += " const op::Shape<" + dim_val + "> " + out_name+"_shape";
+      kernel_params += ", ";
+    }
     ++i;
     if (i < num_params) {
       tensor_params += ", ";
     }
-    kernel_params += ", ";
   }
   kernel_params += tensor_params;
 
@@ -520,7 +647,8 @@ void FusedOp::GenerateCode(int kernel_index, const std::vector<OpReqType> &req,
           aux_code + "\n" +
           "__launch_bounds__(" + std::to_string(FusedOp::NTHREADS) + ")\n" +
           "__global__ void FusedKernel_" + kernel_name +
-          "(size_t N, " + kernel_params + ") {\n" +
+          (specialize_shapes_ ? "(" : "(size_t N, ") + kernel_params + ") {\n" +
+          shape_init +
           fusion::kernel_begin + "\n" +
           code_[kernel_index] + "\n" +
           fusion::kernel_end;
@@ -625,6 +753,16 @@ void FusedOp::CheckShapesAndTypes(const std::vector<TBlob> &inputs,
     *nvec = max(*nvec, mshadowTypeToVectorLength(blob.type_flag_));
   }
 
+  if (specialize_shapes_) {
+    // shape constants are baked into the compiled kernel, so a shape
+    // change has to trigger a recompile rather than new kernel arguments
+    initialized_ = initialized_ &&
+                   in_shapes == saved_in_shapes_ &&
+                   out_shapes == saved_out_shapes_;
+    saved_in_shapes_ = in_shapes;
+    saved_out_shapes_ = out_shapes;
+  }
+
   for (auto it = intermediate_shapes_.begin();
        it != intermediate_shapes_.end();
        ++it) {
@@ -662,6 +800,10 @@ void FusedOp::Forward<gpu>(const nnvm::NodeAttrs& attrs,
   CheckShapesAndTypes(inputs, outputs, &in_dtypes, &in_ndims,
                       &out_dtypes, &out_ndims, &nvec);
 
+  // the reduction kernel parallelizes over the reduced output and
+  // walks the reduced axis sequentially, so it cannot vectorize
+  if (tail_reduction_) nvec = 1;
+
   const auto& node_shapes = intermediate_shapes_[0].internal_attr;
   const auto& node_dtypes = intermediate_dtypes_[0].internal_attr;
 
@@ -690,7 +832,9 @@ void FusedOp::Forward<gpu>(const nnvm::NodeAttrs& attrs,
     N = std::max(N, output.shape_.Size());
   }
   N = (N + nvec - 1)/nvec;
-  args.push_back(&N);
+  if (!specialize_shapes_) {
+    args.push_back(&N);
+  }
 
   unsigned int num_blocks = (N + FusedOp::NTHREADS - 1) / FusedOp::NTHREADS;
 
@@ -707,8 +851,10 @@ void FusedOp::Forward<gpu>(const nnvm::NodeAttrs& attrs,
     AddPointerAndShape(data, &ptrs, &shapes, s);
   }
 
-  for (auto &tensor_shapes : shapes) {
-    args.push_back(tensor_shapes.data());
+  if (!specialize_shapes_) {
+    for (auto &tensor_shapes : shapes) {
+      args.push_back(tensor_shapes.data());
+    }
   }
   for (auto &ptr : ptrs) {
     args.push_back(reinterpret_cast<void *>(&ptr));
@@ -29,11 +29,16 @@
 #include <mutex>
 #include <tuple>
 
-#if MXNET_USE_CUDA
-
-
 namespace mxnet {
 
+namespace fusion {
+/*!
+ * \brief whether the CPU interpreter in fused_op_cpu.cc has a kernel
+ * for this operator
+ */
+bool SupportedByCPUInterpreter(const std::string& op_name);
+}  // namespace fusion
+
 struct FusedOpConfig : public dmlc::Parameter<FusedOpConfig> {
   int num_inputs;
   int num_outputs;
@@ -173,13 +178,41 @@ class FusedOp {
   std::vector<uint32_t> extra_shape_args_;
   std::vector<uint32_t> check_shape_args_;
 
+  // when MXNET_FUSION_STATIC_SHAPES is set, shapes and loop bounds are
+  // compiled into the kernel as constants; the shapes of the last
+  // compilation are kept so that a change forces a recompile
+  bool specialize_shapes_;
+  std::vector<mxnet::TShape> saved_in_shapes_;
+  std::vector<mxnet::TShape> saved_out_shapes_;
+
   std::string ptx_[2];
   std::string kernel_name_[2];
+#if MXNET_USE_CUDA
   CUfunction kernel_[2];
+#endif  // MXNET_USE_CUDA
   bool initialized_;
+  // whether the single output of the subgraph is a reduction
+  // over the innermost axis
+  bool tail_reduction_;
   int cc_major_;
   int cc_minor_;
 
+  // instruction tape for the interpreted CPU path (fused_op_cpu.cc);
+  // slots index the subgraph's node entries, each entry gets one
+  // cache-blocked scratch buffer during execution
+  struct CPUInstr {
+    int opcode;
+    uint32_t out;
+    uint32_t lhs;
+    uint32_t rhs;
+    float scalar;
+  };
+  std::vector<CPUInstr> cpu_tape_;
+  std::vector<uint32_t> cpu_input_slots_;
+  std::vector<uint32_t> cpu_output_slots_;
+  uint32_t cpu_num_slots_;
+  bool cpu_initialized_;
+
   static std::mutex mutex_;
   std::mutex my_mutex_;
 };
@@ -199,5 +232,4 @@ using FusedOpHelperParamPtr = std::shared_ptr<FusedOpHelperParam>;
 
 }  // namespace mxnet
 
-#endif  // MXNET_USE_CUDA
 #endif  // MXNET_OPERATOR_FUSION_FUSED_OP_H_
@@ -0,0 +1,323 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file fused_op_cpu.cc
+ * \brief CPU execution of pointwise fused subgraphs.
+ *
+ * The GPU side of _FusedOp generates and compiles a kernel with nvrtc.
+ * There is no runtime compiler on the CPU side, so the subgraph is
+ * lowered once into a short instruction tape and interpreted per cache
+ * block: a block of every intermediate entry lives in a per-thread
+ * scratch buffer, so a fused region makes one pass over the tensors in
+ * memory no matter how long the chain is. Intermediates are computed in
+ * float32 regardless of the tensor dtypes, which matches the pseudo-fp16
+ * convention used elsewhere on the CPU path.
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "./fused_op.h"
+#include "./fused_op-inl.h"
+#include "../operator_common.h"
+#include "../../engine/openmp.h"
+
+namespace mxnet {
+
+namespace fusion {
+
+namespace {
+
+enum CPUOpcode {
+  kAdd, kSub, kMul, kDiv, kMax, kMin, kPower,
+  kRelu, kSigmoid, kTanh, kExp, kLog, kSqrt, kSquare, kNegative, kCopy,
+  kAddScalar, kRMinusScalar, kMulScalar, kRDivScalar,
+  kPowerScalar, kRPowerScalar
+};
+
+// how the "scalar" attribute is folded into the tape at build time;
+// subtraction becomes an add and division a multiply, like the GPU
+// generated code does
+enum class ScalarTransform { kNone, kNegate, kReciprocal };
+
+struct CPUOpDesc {
+  int opcode;
+  int num_inputs;
+  ScalarTransform transform;
+};
+
+const std::unordered_map<std::string, CPUOpDesc>& CPUOpDescriptions() {
+  static const std::unordered_map<std::string, CPUOpDesc> descs = {
+    {"elemwise_add"   , {kAdd, 2, ScalarTransform::kNone}},
+    {"_plus"          , {kAdd, 2, ScalarTransform::kNone}},
+    {"_Plus"          , {kAdd, 2, ScalarTransform::kNone}},
+    {"_add"           , {kAdd, 2, ScalarTransform::kNone}},
+    {"elemwise_sub"   , {kSub, 2, ScalarTransform::kNone}},
+    {"_minus"         , {kSub, 2, ScalarTransform::kNone}},
+    {"_Minus"         , {kSub, 2, ScalarTransform::kNone}},
+    {"_sub"           , {kSub, 2, ScalarTransform::kNone}},
+    {"elemwise_mul"   , {kMul, 2, ScalarTransform::kNone}},
+    {"_mul"           , {kMul, 2, ScalarTransform::kNone}},
+    {"_Mul"           , {kMul, 2, ScalarTransform::kNone}},
+    {"elemwise_div"   , {kDiv, 2, ScalarTransform::kNone}},
+    {"_div"           , {kDiv, 2, ScalarTransform::kNone}},
+    {"_Div"           , {kDiv, 2, ScalarTransform::kNone}},
+    {"_Maximum"       , {kMax, 2, ScalarTransform::kNone}},
+    {"_maximum"       , {kMax, 2, ScalarTransform::kNone}},
+    {"_Minimum"       , {kMin, 2, ScalarTransform::kNone}},
+    {"_minimum"       , {kMin, 2, ScalarTransform::kNone}},
+    {"_Power"         , {kPower, 2, ScalarTransform::kNone}},
+    {"_power"         , {kPower, 2, ScalarTransform::kNone}},
+    {"relu"           , {kRelu, 1, ScalarTransform::kNone}},
+    {"sigmoid"        , {kSigmoid, 1, ScalarTransform::kNone}},
+    {"tanh"           , {kTanh, 1, ScalarTransform::kNone}},
+    {"exp"            , {kExp, 1, ScalarTransform::kNone}},
+    {"log"            , {kLog, 1, ScalarTransform::kNone}},
+    {"sqrt"           , {kSqrt, 1, ScalarTransform::kNone}},
+    {"square"         , {kSquare, 1, ScalarTransform::kNone}},
+    {"negative"       , {kNegative, 1, ScalarTransform::kNone}},
+    {"_copy"          , {kCopy, 1, ScalarTransform::kNone}},
+    {"_plus_scalar"   , {kAddScalar, 1, ScalarTransform::kNone}},
+    {"_PlusScalar"    , {kAddScalar, 1, ScalarTransform::kNone}},
+    {"_minus_scalar"  , {kAddScalar, 1, ScalarTransform::kNegate}},
+    {"_MinusScalar"   , {kAddScalar, 1, ScalarTransform::kNegate}},
+    {"_rminus_scalar" , {kRMinusScalar, 1, ScalarTransform::kNone}},
+    {"_RMinusScalar"  , {kRMinusScalar, 1, ScalarTransform::kNone}},
+    {"_mul_scalar"    , {kMulScalar, 1, ScalarTransform::kNone}},
+    {"_MulScalar"     , {kMulScalar, 1, ScalarTransform::kNone}},
+    {"_div_scalar"    , {kMulScalar, 1, ScalarTransform::kReciprocal}},
+    {"_DivScalar"     , {kMulScalar, 1, ScalarTransform::kReciprocal}},
+    {"_rdiv_scalar"   , {kRDivScalar, 1, ScalarTransform::kNone}},
+    {"_RDivScalar"    , {kRDivScalar, 1, ScalarTransform::kNone}},
+    {"_power_scalar"  , {kPowerScalar, 1, ScalarTransform::kNone}},
+    {"_PowerScalar"   , {kPowerScalar, 1, ScalarTransform::kNone}},
+    {"_rpower_scalar" , {kRPowerScalar, 1, ScalarTransform::kNone}},
+    {"_RPowerScalar"  , {kRPowerScalar, 1, ScalarTransform::kNone}},
+  };
+  return descs;
+}
+
+inline void RunInstr(const int opcode, const float alpha,
+                     const float* lhs, const float* rhs,
+                     float* out, const index_t len) {
+  switch (opcode) {
+    case kAdd:
+      for (index_t j = 0; j < len; ++j) out[j] = lhs[j] + rhs[j];
+      break;
+    case kSub:
+      for (index_t j = 0; j < len; ++j) out[j] = lhs[j] - rhs[j];
+      break;
+    case kMul:
+      for (index_t j = 0; j < len; ++j) out[j] = lhs[j] * rhs[j];
+      break;
+    case kDiv:
+      for (index_t j = 0; j < len; ++j) out[j] = lhs[j] / rhs[j];
+      break;
+    case kMax:
+      for (index_t j = 0; j < len; ++j) out[j] = std::max(lhs[j], rhs[j]);
+      break;
+    case kMin:
+      for (index_t j = 0; j < len; ++j) out[j] = std::min(lhs[j], rhs[j]);
+      break;
+    case kPower:
+      for (index_t j = 0; j < len; ++j) out[j] = std::pow(lhs[j], rhs[j]);
+      break;
+    case kRelu:
+      for (index_t j = 0; j < len; ++j) out[j] = lhs[j] > 0.f ? lhs[j] : 0.f;
+      break;
+    case kSigmoid:
+      for (index_t j = 0; j < len; ++j) out[j] = 1.f / (1.f + std::exp(-lhs[j]));
+      break;
+    case kTanh:
+      for (index_t j = 0; j < len; ++j) out[j] = std::tanh(lhs[j]);
+      break;
+    case kExp:
+      for (index_t j = 0; j < len; ++j) out[j] = std::exp(lhs[j]);
+      break;
+    case kLog:
+      for (index_t j = 0; j < len; ++j) out[j] = std::log(lhs[j]);
+      break;
+    case kSqrt:
+      for (index_t j = 0; j < len; ++j) out[j] = std::sqrt(lhs[j]);
+      break;
+    case kSquare:
+      for (index_t j = 0; j < len; ++j) out[j] = lhs[j] * lhs[j];
+      break;
+    case kNegative:
+      for (index_t j = 0; j < len; ++j) out[j] = -lhs[j];
+      break;
+    case kCopy:
+      for (index_t j = 0; j < len; ++j) out[j] = lhs[j];
+      break;
+    case kAddScalar:
+      for (index_t j = 0; j < len; ++j) out[j] = lhs[j] + alpha;
+      break;
+    case kRMinusScalar:
+      for (index_t j = 0; j < len; ++j) out[j] = alpha - lhs[j];
+      break;
+    case kMulScalar:
+      for (index_t j = 0; j < len; ++j) out[j] = lhs[j] * alpha;
+      break;
+    case kRDivScalar:
+      for (index_t j = 0; j < len; ++j) out[j] = alpha / lhs[j];
+      break;
+    case kPowerScalar:
+      for (index_t j = 0; j < len; ++j) out[j] = std::pow(lhs[j], alpha);
+      break;
+    case kRPowerScalar:
+      for (index_t j = 0; j < len; ++j) out[j] = std::pow(alpha, lhs[j]);
+      break;
+    default:
+      LOG(FATAL) << "Unknown opcode " << opcode << " in the CPU fused op tape";
+  }
+}
+
+}  // namespace
+
+bool SupportedByCPUInterpreter(const std::string& op_name) {
+  return CPUOpDescriptions().count(op_name) > 0;
+}
+
+}  // namespace fusion
+
+template <>
+void FusedOp::Forward<cpu>(const nnvm::NodeAttrs& attrs,
+                           const OpContext &ctx,
+                           const std::vector<TBlob> &inputs,
+                           const std::vector<OpReqType> &req,
+                           const std::vector<TBlob> &outputs) {
+  using namespace fusion;
+  {
+    std::lock_guard<std::mutex> lock(my_mutex_);
+    if (!cpu_initialized_) {
+      const auto& g = this->subgraph_.indexed_graph();
+      cpu_num_slots_ = g.num_node_entries();
+      for (const auto nid : g.input_nodes()) {
+        cpu_input_slots_.push_back(g.entry_id(nid, 0));
+      }
+      for (uint32_t nid = 0; nid < g.num_nodes(); ++nid) {
+        const auto& node = g[nid];
+        if (node.source->is_variable()) continue;
+        const std::string& op_name = node.source->op()->name;
+        const auto it = CPUOpDescriptions().find(op_name);
+        CHECK(it != CPUOpDescriptions().end())
+          << "Operator " << op_name << " is not supported by the CPU fused op";
+        const CPUOpDesc& desc = it->second;
+        CHECK_EQ(node.inputs.size(), static_cast<size_t>(desc.num_inputs))
+          << "Wrong number of inputs of the operator " << op_name;
+        CPUInstr instr;
+        instr.opcode = desc.opcode;
+        instr.out = g.entry_id(nid, 0);
+        instr.lhs = g.entry_id(node.inputs[0]);
+        instr.rhs = node.inputs.size() > 1 ? g.entry_id(node.inputs[1]) : instr.lhs;
+        instr.scalar = 0.f;
+        const auto sit = node.source->attrs.dict.find("scalar");
+        if (sit != node.source->attrs.dict.end()) {
+          instr.scalar = std::stof(sit->second);
+        }
+        if (desc.transform == ScalarTransform::kNegate) {
+          instr.scalar = -instr.scalar;
+        } else if (desc.transform == ScalarTransform::kReciprocal) {
+          instr.scalar = 1.f / instr.scalar;
+        }
+        cpu_tape_.push_back(instr);
+      }
+      for (const auto& e : g.outputs()) {
+        cpu_output_slots_.push_back(g.entry_id(e));
+      }
+      cpu_initialized_ = true;
+    }
+  }
+  CHECK_GE(outputs.size(), 1U);
+  const index_t size = outputs[0].Size();
+  if (size == 0) return;
+  // the CPU pass only fuses same-shape pointwise chains, so all tensors
+  // share one flat index space
+  for (const auto& blob : inputs) {
+    CHECK_EQ(blob.Size(), size) << "CPU fused op expects same-shape pointwise inputs";
+  }
+  for (const auto& blob : outputs) {
+    CHECK_EQ(blob.Size(), size) << "CPU fused op expects same-shape pointwise outputs";
+  }
+  // one block of every subgraph entry stays resident in the per-thread
+  // scratch while the tape runs over it
+  const index_t block = 1024;
+  const index_t nblocks = (size + block - 1) / block;
+  const int nthreads = std::min(
+      static_cast<index_t>(engine::OpenMP::Get()->GetRecommendedOMPThreadCount()),
+      nblocks);
+  #pragma omp parallel num_threads(nthreads)
+  {
+    std::vector<float> scratch(static_cast<size_t>(cpu_num_slots_) * block);
+    #pragma omp for
+    for (index_t b = 0; b < nblocks; ++b) {
+      const index_t begin = b * block;
+      const index_t len = std::min(block, size - begin);
+      for (size_t i = 0; i < inputs.size(); ++i) {
+        float* dst = scratch.data() + cpu_input_slots_[i] * block;
+        MSHADOW_TYPE_SWITCH(inputs[i].type_flag_, DType, {
+          const DType* src = inputs[i].dptr<DType>() + begin;
+          for (index_t j = 0; j < len; ++j) {
+            dst[j] = static_cast<float>(src[j]);
+          }
+        });
+      }
+      for (const auto& instr : cpu_tape_) {
+        RunInstr(instr.opcode, instr.scalar,
+                 scratch.data() + instr.lhs * block,
+                 scratch.data() + instr.rhs * block,
+                 scratch.data() + instr.out * block, len);
+      }
+      for (size_t i = 0; i < outputs.size(); ++i) {
+        if (req[i] == kNullOp) continue;
+        const float* src = scratch.data() + cpu_output_slots_[i] * block;
+        MSHADOW_TYPE_SWITCH(outputs[i].type_flag_, DType, {
+          DType* dst = outputs[i].dptr<DType>() + begin;
+          if (req[i] == kAddTo) {
+            for (index_t j = 0; j < len; ++j) {
+              dst[j] += static_cast<DType>(src[j]);
+            }
+          } else {
+            for (index_t j = 0; j < len; ++j) {
+              dst[j] = static_cast<DType>(src[j]);
+            }
+          }
+        });
+      }
+    }
+  }
+}
+
+void FusedOpForwardCPU(const nnvm::NodeAttrs& attrs,
+                       const OpContext &ctx,
+                       const std::vector<TBlob> &inputs,
+                       const std::vector<OpReqType> &req,
+                       const std::vector<TBlob> &outputs) {
+  const FusedOpPtr& op = nnvm::get<FusedOpPtr>(attrs.parsed);
+  op->Forward<cpu>(attrs, ctx, inputs, req, outputs);
+}
+
+NNVM_REGISTER_OP(_FusedOp)
+.set_attr<FCompute>("FCompute<cpu>", FusedOpForwardCPU);
+
+}  // namespace mxnet
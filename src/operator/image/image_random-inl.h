@@ -752,7 +752,7 @@ inline void AdjustSaturationImpl(const float& alpha_s,
     for (int l = 0; l < length; ++l) {
       float gray = 0.f;
       for (int c = 0; c < 3; ++c) {
-        gray = input[l*3 + c] * coef[c];
+        gray += input[l*3 + c] * coef[c];
       }
       gray *= alpha_o;
       for (int c = 0; c < 3; ++c) {
@@ -1073,11 +1073,14 @@ inline void RandomLighting(const nnvm::NodeAttrs &attrs,
   .add_argument("data", "NDArray-or-Symbol", "The input.")
 
 
+// the temp space holds the device-side random draw (and partial sums)
+// for the GPU implementations; the CPU paths only use the random resource
 #define MXNET_REGISTER_IMAGE_RND_AUG_OP(name)                               \
   MXNET_REGISTER_IMAGE_AUG_OP(name)                                         \
   .set_attr<FResourceRequest>("FResourceRequest",                           \
     [](const NodeAttrs& attrs) {                                            \
-      return std::vector<ResourceRequest>{ResourceRequest::kRandom};        \
+      return std::vector<ResourceRequest>{ResourceRequest::kRandom,         \
+                                          ResourceRequest::kTempSpace};     \
     })
 
 }  // namespace image
@@ -239,6 +239,263 @@ void NormalizeBackwardImplCUDA(mshadow::Stream<gpu> *s,
     MSHADOW_CUDA_POST_KERNEL_CHECK(NormalizeBackwardCudaKernel);
 }
 
+template<typename DType>
+MSHADOW_XINLINE DType CudaSaturateCast(const float src) {
+  return static_cast<DType>(src);
+}
+
+template<>
+MSHADOW_XINLINE uint8_t CudaSaturateCast(const float src) {
+  return ::fminf(::fmaxf(src, 0.f), 255.f);
+}
+
+// Flip the middle axis of a (head, mid, tail) view by swapping mirrored
+// pairs. One launch covers head * ceil(mid / 2) * tail pairs and stays
+// correct when the operator runs in place.
+struct FlipPairsKernel {
+  template<typename DType>
+  MSHADOW_XINLINE static void Map(index_t i, DType* out, const DType* in,
+                                  const index_t mid, const index_t tail,
+                                  const index_t half) {
+    const index_t t = i % tail;
+    const index_t j = (i / tail) % half;
+    const index_t h = i / tail / half;
+    const index_t lo = (h * mid + j) * tail + t;
+    const index_t hi = (h * mid + (mid - 1 - j)) * tail + t;
+    const DType a = in[lo];
+    const DType b = in[hi];
+    out[lo] = b;
+    out[hi] = a;
+  }
+};
+
+// Same as FlipPairsKernel, but the flip happens only when the device-side
+// coin (sampled once per launch from the op's random resource) comes up;
+// otherwise the pair is copied through. The branch is uniform across the
+// launch, so there is no divergence.
+struct RandomFlipPairsKernel {
+  template<typename DType>
+  MSHADOW_XINLINE static void Map(index_t i, DType* out, const DType* in,
+                                  const float* coin, const index_t mid,
+                                  const index_t tail, const index_t half) {
+    const index_t t = i % tail;
+    const index_t j = (i / tail) % half;
+    const index_t h = i / tail / half;
+    const index_t lo = (h * mid + j) * tail + t;
+    const index_t hi = (h * mid + (mid - 1 - j)) * tail + t;
+    const DType a = in[lo];
+    const DType b = in[hi];
+    if (coin[0] < 0.5f) {
+      out[lo] = b;
+      out[hi] = a;
+    } else {
+      out[lo] = a;
+      out[hi] = b;
+    }
+  }
+};
+
+struct RandomBrightnessKernel {
+  template<typename DType>
+  MSHADOW_XINLINE static void Map(index_t i, DType* out, const DType* in,
+                                  const float* u, const float min_factor,
+                                  const float max_factor) {
+    const float alpha = min_factor + u[0] * (max_factor - min_factor);
+    out[i] = CudaSaturateCast<DType>(static_cast<float>(in[i]) * alpha);
+  }
+};
+
+// Partial gray sums for the contrast adjustment; sum holds a single float
+// zeroed before the launch.
+struct GraySumKernel {
+  template<typename DType>
+  MSHADOW_XINLINE static void Map(index_t l, float* sum, const DType* in,
+                                  const int nchannels) {
+    float gray;
+    if (nchannels > 1) {
+      gray = static_cast<float>(in[l * 3]) * 0.299f
+           + static_cast<float>(in[l * 3 + 1]) * 0.587f
+           + static_cast<float>(in[l * 3 + 2]) * 0.114f;
+    } else {
+      gray = static_cast<float>(in[l]);
+    }
+    atomicAdd(sum, gray);
+  }
+};
+
+struct RandomContrastKernel {
+  template<typename DType>
+  MSHADOW_XINLINE static void Map(index_t i, DType* out, const DType* in,
+                                  const float* u, const float* gray_sum,
+                                  const float inv_length,
+                                  const float min_factor,
+                                  const float max_factor) {
+    const float alpha = min_factor + u[0] * (max_factor - min_factor);
+    const float beta = (1.f - alpha) * gray_sum[0] * inv_length;
+    out[i] = CudaSaturateCast<DType>(static_cast<float>(in[i]) * alpha + beta);
+  }
+};
+
+// One thread per pixel; blends each channel with the pixel's gray value.
+struct RandomSaturationKernel {
+  template<typename DType>
+  MSHADOW_XINLINE static void Map(index_t l, DType* out, const DType* in,
+                                  const float* u, const float min_factor,
+                                  const float max_factor) {
+    const float alpha = min_factor + u[0] * (max_factor - min_factor);
+    const float gray = (static_cast<float>(in[l * 3]) * 0.299f
+                      + static_cast<float>(in[l * 3 + 1]) * 0.587f
+                      + static_cast<float>(in[l * 3 + 2]) * 0.114f)
+                       * (1.f - alpha);
+    for (int c = 0; c < 3; ++c) {
+      out[l * 3 + c] = CudaSaturateCast<DType>(
+          gray + static_cast<float>(in[l * 3 + c]) * alpha);
+    }
+  }
+};
+
+// axis 0 flips the height of the (h, w, c) image, axis 1 the width
+inline void FlipExtents(const mxnet::TShape &shape, int axis,
+                        index_t *mid, index_t *tail, index_t *half) {
+  *mid = shape[axis];
+  *tail = axis == 0 ? shape[1] * shape[2] : shape[2];
+  *half = (*mid + 1) / 2;
+}
+
+template<int axis>
+void FlipCuda(const nnvm::NodeAttrs &attrs,
+              const OpContext &ctx,
+              const std::vector<TBlob> &inputs,
+              const std::vector<OpReqType> &req,
+              const std::vector<TBlob> &outputs) {
+  Stream<gpu> *s = ctx.get_stream<gpu>();
+  index_t mid, tail, half;
+  FlipExtents(inputs[0].shape_, axis, &mid, &tail, &half);
+  const index_t head = inputs[0].Size() / (mid * tail);
+  MSHADOW_TYPE_SWITCH(outputs[0].type_flag_, DType, {
+    mxnet_op::Kernel<FlipPairsKernel, gpu>::Launch(
+        s, head * half * tail, outputs[0].dptr<DType>(),
+        inputs[0].dptr<DType>(), mid, tail, half);
+  });
+}
+
+template<int axis>
+void RandomFlipCuda(const nnvm::NodeAttrs &attrs,
+                    const OpContext &ctx,
+                    const std::vector<TBlob> &inputs,
+                    const std::vector<OpReqType> &req,
+                    const std::vector<TBlob> &outputs) {
+  Stream<gpu> *s = ctx.get_stream<gpu>();
+  Random<gpu, float> *prnd = ctx.requested[0].get_random<gpu, float>(s);
+  Tensor<gpu, 1, float> coin =
+      ctx.requested[1].get_space_typed<gpu, 1, float>(Shape1(1), s);
+  prnd->SampleUniform(&coin, 0.f, 1.f);
+  index_t mid, tail, half;
+  FlipExtents(inputs[0].shape_, axis, &mid, &tail, &half);
+  const index_t head = inputs[0].Size() / (mid * tail);
+  MSHADOW_TYPE_SWITCH(outputs[0].type_flag_, DType, {
+    mxnet_op::Kernel<RandomFlipPairsKernel, gpu>::Launch(
+        s, head * half * tail, outputs[0].dptr<DType>(),
+        inputs[0].dptr<DType>(), coin.dptr_, mid, tail, half);
+  });
+}
+
+void RandomBrightnessCuda(const nnvm::NodeAttrs &attrs,
+                          const OpContext &ctx,
+                          const std::vector<TBlob> &inputs,
+                          const std::vector<OpReqType> &req,
+                          const std::vector<TBlob> &outputs) {
+  const RandomEnhanceParam &param = nnvm::get<RandomEnhanceParam>(attrs.parsed);
+  Stream<gpu> *s = ctx.get_stream<gpu>();
+  Random<gpu, float> *prnd = ctx.requested[0].get_random<gpu, float>(s);
+  Tensor<gpu, 1, float> u =
+      ctx.requested[1].get_space_typed<gpu, 1, float>(Shape1(1), s);
+  prnd->SampleUniform(&u, 0.f, 1.f);
+  MSHADOW_TYPE_SWITCH(outputs[0].type_flag_, DType, {
+    mxnet_op::Kernel<RandomBrightnessKernel, gpu>::Launch(
+        s, inputs[0].Size(), outputs[0].dptr<DType>(), inputs[0].dptr<DType>(),
+        u.dptr_, param.min_factor, param.max_factor);
+  });
+}
+
+void RandomContrastCuda(const nnvm::NodeAttrs &attrs,
+                        const OpContext &ctx,
+                        const std::vector<TBlob> &inputs,
+                        const std::vector<OpReqType> &req,
+                        const std::vector<TBlob> &outputs) {
+  const RandomEnhanceParam &param = nnvm::get<RandomEnhanceParam>(attrs.parsed);
+  Stream<gpu> *s = ctx.get_stream<gpu>();
+  Random<gpu, float> *prnd = ctx.requested[0].get_random<gpu, float>(s);
+  // space[0] holds the uniform draw, space[1] the gray sum
+  Tensor<gpu, 1, float> space =
+      ctx.requested[1].get_space_typed<gpu, 1, float>(Shape1(2), s);
+  Tensor<gpu, 1, float> u = space.Slice(0, 1);
+  prnd->SampleUniform(&u, 0.f, 1.f);
+  cudaStream_t stream = Stream<gpu>::GetStream(s);
+  CUDA_CALL(cudaMemsetAsync(space.dptr_ + 1, 0, sizeof(float), stream));
+  const index_t length = inputs[0].shape_[0] * inputs[0].shape_[1];
+  const int nchannels = inputs[0].shape_[2];
+  MSHADOW_TYPE_SWITCH(outputs[0].type_flag_, DType, {
+    mxnet_op::Kernel<GraySumKernel, gpu>::Launch(
+        s, length, space.dptr_ + 1, inputs[0].dptr<DType>(), nchannels);
+    mxnet_op::Kernel<RandomContrastKernel, gpu>::Launch(
+        s, inputs[0].Size(), outputs[0].dptr<DType>(), inputs[0].dptr<DType>(),
+        space.dptr_, space.dptr_ + 1, 1.f / static_cast<float>(length),
+        param.min_factor, param.max_factor);
+  });
+}
+
+void RandomSaturationCuda(const nnvm::NodeAttrs &attrs,
+                          const OpContext &ctx,
+                          const std::vector<TBlob> &inputs,
+                          const std::vector<OpReqType> &req,
+                          const std::vector<TBlob> &outputs) {
+  const RandomEnhanceParam &param = nnvm::get<RandomEnhanceParam>(attrs.parsed);
+  Stream<gpu> *s = ctx.get_stream<gpu>();
+  const index_t length = inputs[0].shape_[0] * inputs[0].shape_[1];
+  const int nchannels = inputs[0].shape_[2];
+  MSHADOW_TYPE_SWITCH(outputs[0].type_flag_, DType, {
+    if (nchannels == 1) {
+      if (outputs[0].dptr_ != inputs[0].dptr_) {
+        CUDA_CALL(cudaMemcpyAsync(outputs[0].dptr<DType>(),
+                                  inputs[0].dptr<DType>(),
+                                  inputs[0].Size() * sizeof(DType),
+                                  cudaMemcpyDeviceToDevice,
+                                  Stream<gpu>::GetStream(s)));
+      }
+      return;
+    }
+    Random<gpu, float> *prnd = ctx.requested[0].get_random<gpu, float>(s);
+    Tensor<gpu, 1, float> u =
+        ctx.requested[1].get_space_typed<gpu, 1, float>(Shape1(1), s);
+    prnd->SampleUniform(&u, 0.f, 1.f);
+    mxnet_op::Kernel<RandomSaturationKernel, gpu>::Launch(
+        s, length, outputs[0].dptr<DType>(), inputs[0].dptr<DType>(),
+        u.dptr_, param.min_factor, param.max_factor);
+  });
+}
+
+NNVM_REGISTER_OP(_image_flip_left_right)
+.set_attr<FCompute>("FCompute<gpu>", FlipCuda<1>);
+
+NNVM_REGISTER_OP(_image_random_flip_left_right)
+.set_attr<FCompute>("FCompute<gpu>", RandomFlipCuda<1>);
+
+NNVM_REGISTER_OP(_image_flip_top_bottom)
+.set_attr<FCompute>("FCompute<gpu>", FlipCuda<0>);
+
+NNVM_REGISTER_OP(_image_random_flip_top_bottom)
+.set_attr<FCompute>("FCompute<gpu>", RandomFlipCuda<0>);
+
+NNVM_REGISTER_OP(_image_random_brightness)
+.set_attr<FCompute>("FCompute<gpu>", RandomBrightnessCuda);
+
+NNVM_REGISTER_OP(_image_random_contrast)
+.set_attr<FCompute>("FCompute<gpu>", RandomContrastCuda);
+
+NNVM_REGISTER_OP(_image_random_saturation)
+.set_attr<FCompute>("FCompute<gpu>", RandomSaturationCuda);
+
 NNVM_REGISTER_OP(_image_to_tensor)
 .set_attr<FCompute>("FCompute<gpu>", ToTensorOpForward<gpu>);
 
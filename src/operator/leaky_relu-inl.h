@@ -40,10 +40,27 @@
 #include "./random/sampler.h"
 #include "./random/sample_op.h"
 #include "./tensor/elemwise_binary_broadcast_op.h"
+#include "./tensor/elemwise_simd-inl.h"
 
 namespace mxnet {
 namespace op {
 
+/*!
+ * \brief Turn a uniform [0, 1) sample in mask into the random slope
+ *  lower + u * (upper - lower) and apply it to data in the same pass,
+ *  replacing the scale, shift and xelu launches rrelu used to make.
+ */
+template<int req>
+struct rrelu_apply {
+  template<typename DType>
+  MSHADOW_XINLINE static void Map(index_t i, DType* out, DType* mask, const DType* data,
+                                  const DType lower, const DType range) {
+    const DType slope = lower + mask[i] * range;
+    mask[i] = slope;
+    KERNEL_ASSIGN(out[i], req, mshadow_op::xelu::Map(data[i], slope));
+  }
+};
+
 namespace leakyrelu {
 enum LeakyReLUOpInputs {kData, kGamma};
 enum LeakyReLUOpOutputs {kOut, kMask};
@@ -150,21 +167,12 @@ class LeakyReLUOp : public Operator {
           mxnet::op::GetSamplingTempData<xpu, DType>(DType(0.0f), DType(1.0f), ctx, &low, &high);
           mxnet::common::random::RandGenerator<xpu, DType> *pgen =
             ctx.requested[0].get_parallel_random<xpu, DType>();
-          Tensor<xpu, 1, DType> out = mask.FlatTo1D();
-          sampler.Sample(low, high, out, pgen, s);
-          MXNET_ASSIGN_REQ_SWITCH(req[leakyrelu::kMask], Req, {
-            mxnet_op::Kernel<mxnet_op::op_with_req<mshadow_op::mul, Req>, xpu>::Launch(
-              s, mask.size(0) * mask.size(1) * mask.size(2), mask.dptr_, mask.dptr_,
-              DType(param_.upper_bound - param_.lower_bound));
-          });
-          MXNET_ASSIGN_REQ_SWITCH(req[leakyrelu::kMask], Req, {
-            mxnet_op::Kernel<mxnet_op::op_with_req<mshadow_op::plus, Req>, xpu>::Launch(
-              s, mask.size(0) * mask.size(1) * mask.size(2), mask.dptr_, mask.dptr_,
-              DType(param_.lower_bound));
-          });
+          Tensor<xpu, 1, DType> sampled = mask.FlatTo1D();
+          sampler.Sample(low, high, sampled, pgen, s);
           MXNET_ASSIGN_REQ_SWITCH(req[leakyrelu::kOut], Req, {
-            mxnet_op::Kernel<mxnet_op::op_with_req<mshadow_op::xelu, Req>, xpu>::Launch(
-              s, mask.size(0) * mask.size(1) * mask.size(2), out.dptr_, data.dptr_, mask.dptr_);
+            mxnet_op::Kernel<rrelu_apply<Req>, xpu>::Launch(
+              s, mask.size(0) * mask.size(1) * mask.size(2), out.dptr_, mask.dptr_, data.dptr_,
+              DType(param_.lower_bound), DType(param_.upper_bound - param_.lower_bound));
           });
         } else {
           const float slope = (param_.lower_bound + param_.upper_bound) / 2.0f;
@@ -236,10 +244,16 @@ class LeakyReLUOp : public Operator {
     switch (param_.act_type) {
       case leakyrelu::kLeakyReLU: {
         MXNET_ASSIGN_REQ_SWITCH(req[leakyrelu::kData], Req, {
-          mxnet_op::Kernel<mxnet_op::op_with_req<
-            mxnet_op::backward_grad_tuned<mshadow_op::xelu_grad>, Req>, xpu>::Launch(
-              s, gdata.size(0) * gdata.size(1) * gdata.size(2), gdata.dptr_, grad.dptr_,
-              output.dptr_, DType(param_.slope));
+          const bool vectorized = Req == kWriteTo &&
+            simd::SIMDActBackward<xpu, mshadow_op::xelu_grad, DType>::Run(
+              gdata.dptr_, grad.dptr_, output.dptr_, DType(param_.slope),
+              gdata.size(0) * gdata.size(1) * gdata.size(2));
+          if (!vectorized) {
+            mxnet_op::Kernel<mxnet_op::op_with_req<
+              mxnet_op::backward_grad_tuned<mshadow_op::xelu_grad>, Req>, xpu>::Launch(
+                s, gdata.size(0) * gdata.size(1) * gdata.size(2), gdata.dptr_, grad.dptr_,
+                output.dptr_, DType(param_.slope));
+          }
         });
         break;
       }
@@ -278,10 +292,16 @@ class LeakyReLUOp : public Operator {
       }
       case leakyrelu::kELU: {
         MXNET_ASSIGN_REQ_SWITCH(req[leakyrelu::kData], Req, {
-          mxnet_op::Kernel<mxnet_op::op_with_req<
-            mxnet_op::backward_grad_tuned<mshadow_op::elu_grad>, Req>, xpu>::Launch(
-              s, gdata.size(0) * gdata.size(1) * gdata.size(2), gdata.dptr_, grad.dptr_,
-              output.dptr_, DType(param_.slope));
+          const bool vectorized = Req == kWriteTo &&
+            simd::SIMDActBackward<xpu, mshadow_op::elu_grad, DType>::Run(
+              gdata.dptr_, grad.dptr_, output.dptr_, DType(param_.slope),
+              gdata.size(0) * gdata.size(1) * gdata.size(2));
+          if (!vectorized) {
+            mxnet_op::Kernel<mxnet_op::op_with_req<
+              mxnet_op::backward_grad_tuned<mshadow_op::elu_grad>, Req>, xpu>::Launch(
+                s, gdata.size(0) * gdata.size(1) * gdata.size(2), gdata.dptr_, grad.dptr_,
+                output.dptr_, DType(param_.slope));
+          }
         });
         break;
       }
@@ -28,6 +28,7 @@
 #include <mxnet/operator_util.h>
 #include <vector>
 #include "./mshadow_op.h"
+#include "./mxnet_op.h"
 #include "./elemwise_op_common.h"
 
 namespace mxnet {
@@ -47,6 +48,185 @@ inline bool SoftmaxCrossEntropyShape(const nnvm::NodeAttrs& attrs,
   return true;
 }
 
+/*!
+ * \brief Fused per-row loss: one pass over the logits with an online max and
+ *  normalizer, writing -log softmax(row)[label] without materializing the
+ *  probability tensor.
+ */
+struct SoftmaxCrossEntropyRowLoss {
+  template<typename DType>
+  MSHADOW_XINLINE static void Map(index_t i, DType* row_loss, const DType* data,
+                                  const DType* label, const index_t nclass) {
+    const DType* row = data + i * nclass;
+    real_t vmax = static_cast<real_t>(row[0]);
+    real_t vsum = 0.0f;
+    for (index_t j = 0; j < nclass; ++j) {
+      const real_t x = static_cast<real_t>(row[j]);
+      if (x > vmax) {
+        vsum = vsum * expf(vmax - x) + 1.0f;
+        vmax = x;
+      } else {
+        vsum += expf(x - vmax);
+      }
+    }
+    const index_t t = static_cast<index_t>(label[i]);
+    row_loss[i] = static_cast<DType>(logf(vsum) + vmax - static_cast<real_t>(row[t]));
+  }
+};
+
+/*!
+ * \brief Fused per-row gradient: recompute the row's max and normalizer and
+ *  write (softmax - onehot) * scale directly, again without a probability
+ *  tensor.
+ */
+template<int req>
+struct SoftmaxCrossEntropyRowGrad {
+  template<typename DType>
+  MSHADOW_XINLINE static void Map(index_t i, DType* igrad, const DType* data,
+                                  const DType* label, const DType* scale,
+                                  const index_t nclass) {
+    const DType* row = data + i * nclass;
+    DType* grow = igrad + i * nclass;
+    real_t vmax = static_cast<real_t>(row[0]);
+    real_t vsum = 0.0f;
+    for (index_t j = 0; j < nclass; ++j) {
+      const real_t x = static_cast<real_t>(row[j]);
+      if (x > vmax) {
+        vsum = vsum * expf(vmax - x) + 1.0f;
+        vmax = x;
+      } else {
+        vsum += expf(x - vmax);
+      }
+    }
+    const index_t t = static_cast<index_t>(label[i]);
+    const real_t gscale = static_cast<real_t>(scale[0]);
+    for (index_t j = 0; j < nclass; ++j) {
+      real_t p = expf(static_cast<real_t>(row[j]) - vmax) / vsum;
+      if (j == t) p -= 1.0f;
+      KERNEL_ASSIGN(grow[j], req, static_cast<DType>(p * gscale));
+    }
+  }
+};
+
+template<typename DType>
+inline void SoftmaxCERowLoss(mshadow::Stream<cpu> *s, const DType* data,
+                             const DType* label, DType* row_loss,
+                             const index_t nbatch, const index_t nclass) {
+  mxnet_op::Kernel<SoftmaxCrossEntropyRowLoss, cpu>::Launch(
+      s, nbatch, row_loss, data, label, nclass);
+}
+
+template<typename DType>
+inline void SoftmaxCERowGrad(mshadow::Stream<cpu> *s, const DType* data,
+                             const DType* label, const DType* scale, DType* igrad,
+                             const index_t nbatch, const index_t nclass,
+                             const OpReqType req) {
+  MXNET_ASSIGN_REQ_SWITCH(req, Req, {
+    mxnet_op::Kernel<SoftmaxCrossEntropyRowGrad<Req>, cpu>::Launch(
+        s, nbatch, igrad, data, label, scale, nclass);
+  });
+}
+
+#ifdef __CUDACC__
+
+const int softmax_ce_x_bits = 8;
+
+template<int x_bits, typename DType>
+__global__ void softmax_ce_row_loss_kernel(const DType *data, const DType *label,
+                                           DType *row_loss, const index_t nclass) {
+  const unsigned x_size = 1 << x_bits;
+  __shared__ real_t smem[x_size];
+  const DType *row = data + static_cast<index_t>(blockIdx.x) * nclass;
+  const index_t x = threadIdx.x;
+
+  mshadow::red::maximum::SetInitValue(smem[x]);
+  for (index_t i = x; i < nclass; i += x_size) {
+    smem[x] = ::max(smem[x], static_cast<real_t>(row[i]));
+  }
+  __syncthreads();
+  mshadow::cuda::Reduce1D<mshadow::red::maximum, x_bits>(smem);
+  __syncthreads();
+  const real_t vmax = smem[0];
+  __syncthreads();
+
+  mshadow::red::sum::SetInitValue(smem[x]);
+  for (index_t i = x; i < nclass; i += x_size) {
+    smem[x] += expf(static_cast<real_t>(row[i]) - vmax);
+  }
+  __syncthreads();
+  mshadow::cuda::Reduce1D<mshadow::red::sum, x_bits>(smem);
+  __syncthreads();
+
+  if (x == 0) {
+    const index_t t = static_cast<index_t>(label[blockIdx.x]);
+    row_loss[blockIdx.x] = static_cast<DType>(
+        logf(smem[0]) + vmax - static_cast<real_t>(row[t]));
+  }
+}
+
+template<int x_bits, int req, typename DType>
+__global__ void softmax_ce_row_grad_kernel(const DType *data, const DType *label,
+                                           const DType *scale, DType *igrad,
+                                           const index_t nclass) {
+  const unsigned x_size = 1 << x_bits;
+  __shared__ real_t smem[x_size];
+  const DType *row = data + static_cast<index_t>(blockIdx.x) * nclass;
+  DType *grow = igrad + static_cast<index_t>(blockIdx.x) * nclass;
+  const index_t x = threadIdx.x;
+
+  mshadow::red::maximum::SetInitValue(smem[x]);
+  for (index_t i = x; i < nclass; i += x_size) {
+    smem[x] = ::max(smem[x], static_cast<real_t>(row[i]));
+  }
+  __syncthreads();
+  mshadow::cuda::Reduce1D<mshadow::red::maximum, x_bits>(smem);
+  __syncthreads();
+  const real_t vmax = smem[0];
+  __syncthreads();
+
+  mshadow::red::sum::SetInitValue(smem[x]);
+  for (index_t i = x; i < nclass; i += x_size) {
+    smem[x] += expf(static_cast<real_t>(row[i]) - vmax);
+  }
+  __syncthreads();
+  mshadow::cuda::Reduce1D<mshadow::red::sum, x_bits>(smem);
+  __syncthreads();
+  const real_t vsum = smem[0];
+
+  const index_t t = static_cast<index_t>(label[blockIdx.x]);
+  const real_t gscale = static_cast<real_t>(scale[0]);
+  for (index_t i = x; i < nclass; i += x_size) {
+    real_t p = expf(static_cast<real_t>(row[i]) - vmax) / vsum;
+    if (i == t) p -= 1.0f;
+    KERNEL_ASSIGN(grow[i], req, static_cast<DType>(p * gscale));
+  }
+}
+
+template<typename DType>
+inline void SoftmaxCERowLoss(mshadow::Stream<gpu> *s, const DType* data,
+                             const DType* label, DType* row_loss,
+                             const index_t nbatch, const index_t nclass) {
+  softmax_ce_row_loss_kernel<softmax_ce_x_bits>
+      <<<nbatch, 1 << softmax_ce_x_bits, 0, mshadow::Stream<gpu>::GetStream(s)>>>(
+          data, label, row_loss, nclass);
+  MSHADOW_CUDA_POST_KERNEL_CHECK(softmax_ce_row_loss_kernel);
+}
+
+template<typename DType>
+inline void SoftmaxCERowGrad(mshadow::Stream<gpu> *s, const DType* data,
+                             const DType* label, const DType* scale, DType* igrad,
+                             const index_t nbatch, const index_t nclass,
+                             const OpReqType req) {
+  MXNET_ASSIGN_REQ_SWITCH(req, Req, {
+    softmax_ce_row_grad_kernel<softmax_ce_x_bits, Req>
+        <<<nbatch, 1 << softmax_ce_x_bits, 0, mshadow::Stream<gpu>::GetStream(s)>>>(
+            data, label, scale, igrad, nclass);
+    MSHADOW_CUDA_POST_KERNEL_CHECK(softmax_ce_row_grad_kernel);
+  });
+}
+
+#endif  // __CUDACC__
+
 template<typename xpu>
 void SoftmaxCrossEntropyForward(const nnvm::NodeAttrs& attrs,
                                 const OpContext& ctx,
@@ -63,20 +243,14 @@ void SoftmaxCrossEntropyForward(const nnvm::NodeAttrs& attrs,
     mshadow::Tensor<xpu, 1, DType> out = outputs[0].get<xpu, 1, DType>(s);
     mshadow::Tensor<xpu, 1, DType> mlabel = inputs[1].get<xpu, 1, DType>(s);
     mshadow::Tensor<xpu, 2, DType> mdata = inputs[0].get<xpu, 2, DType>(s);
+    // fused one-pass loss; the workspace holds one value per row instead of
+    // a full probability tensor
     mshadow::Tensor<xpu, 1, DType> workspace = ctx.requested[0].get_space_typed<xpu, 1, DType>(
-        mshadow::Shape1(mdata.shape_.Size() + mlabel.size(0)), s);
-    mshadow::Tensor<xpu, 2, DType> temp1(workspace.dptr_, mdata.shape_, s);
-    mshadow::Tensor<xpu, 2, DType> temp2(workspace.dptr_ + mdata.shape_.Size(),
+        mshadow::Shape1(mlabel.size(0)), s);
+    SoftmaxCERowLoss(s, mdata.dptr_, mlabel.dptr_, workspace.dptr_,
+                     mdata.size(0), mdata.size(1));
+    mshadow::Tensor<xpu, 2, DType> temp2(workspace.dptr_,
         mshadow::Shape2(1, mlabel.size(0)), s);
-    // calculate softmax on temp
-    // TODO(tqchen): change to SoftmaxLog later
-    mshadow::Softmax(temp1, mdata);
-    // choose the softmax rows
-    mshadow::Tensor<xpu, 1, DType> tdst = temp2[0];
-    tdst = F<mshadow_op::negation>(
-        F<mshadow_op::log>(
-            F<mshadow_op::maximum>(mat_choose_row_element(temp1, mlabel),
-                                   scalar<DType>(1e-8f))));
     ASSIGN_DISPATCH(out, req[0], sumall_except_dim<0>(temp2));
   });
 }
@@ -96,11 +270,9 @@ void SoftmaxCrossEntropyBackward(const nnvm::NodeAttrs& attrs,
     mshadow::Tensor<xpu, 2, DType> mdata = inputs[1].get<xpu, 2, DType>(s);
     mshadow::Tensor<xpu, 2, DType> mdata_grad = outputs[0].get<xpu, 2, DType>(s);
     mshadow::Tensor<xpu, 1, DType> mscale = inputs[0].get<xpu, 1, DType>(s);
-    mshadow::Tensor<xpu, 2, DType> temp = ctx.requested[0].get_space_typed<xpu, 2, DType>(
-        mdata.shape_, s);
-    mshadow::Softmax(temp, mdata);
-    mshadow::SoftmaxGrad(temp, temp, mlabel);
-    ASSIGN_DISPATCH(mdata_grad, req[0], broadcast_scalar(mscale, temp.shape_) * temp);
+    // fused one-pass gradient, written directly without a probability temp
+    SoftmaxCERowGrad(s, mdata.dptr_, mlabel.dptr_, mscale.dptr_, mdata_grad.dptr_,
+                     mdata.size(0), mdata.size(1), req[0]);
   });
 }
 
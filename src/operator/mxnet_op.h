@@ -1002,7 +1002,12 @@ struct Kernel<OP, cpu> {
         OP::Map(i, args...);
       }
     } else {
-      #pragma omp parallel for num_threads(omp_threads)
+      // scale the thread count to the measured workload of this (op, size)
+      // so small kernels don't spread over more cores than they can amortize
+      const int num_threads = OperatorTuneByType<DType>::ThreadCount(
+        static_cast<size_t>(omp_threads),
+        static_cast<uint64_t>(N) * tuned_op<PRIMITIVE_OP, DType>::workload_[0]);
+      #pragma omp parallel for num_threads(num_threads)
       for (index_t i = 0; i < static_cast<index_t>(N); ++i) {
         OP::Map(i, args...);
       }
@@ -74,6 +74,7 @@ struct BatchNormParam : public dmlc::Parameter<BatchNormParam> {
   bool output_mean_var;
   int axis;
   bool cudnn_off;
+  bool fuse_relu;
 
   dmlc::optional<float> min_calib_range;  // min float value calculated from calibration dataset
   dmlc::optional<float> max_calib_range;  // max float value calculated from calibration dataset
@@ -96,6 +97,10 @@ struct BatchNormParam : public dmlc::Parameter<BatchNormParam> {
     .describe("Specify which shape axis the channel is specified");
     DMLC_DECLARE_FIELD(cudnn_off).set_default(false)
     .describe("Do not select CUDNN operator, if available");
+    DMLC_DECLARE_FIELD(fuse_relu).set_default(false)
+    .describe("Apply a relu activation to the normalized output. "
+              "Only supported for inference; usually set by the "
+              "BatchNorm+relu fusion pass rather than by hand.");
     DMLC_DECLARE_FIELD(min_calib_range)
     .set_default(dmlc::optional<float>())
     .describe("The minimum scalar value in the form of float32 obtained "
@@ -116,6 +121,7 @@ struct BatchNormParam : public dmlc::Parameter<BatchNormParam> {
                 this->use_global_stats == other.use_global_stats &&
                 this->output_mean_var == other.output_mean_var && this->axis == other.axis &&
                 this->cudnn_off == other.cudnn_off &&
+                this->fuse_relu == other.fuse_relu &&
                 this->min_calib_range.has_value() == other.min_calib_range.has_value() &&
                 this->max_calib_range.has_value() == other.max_calib_range.has_value();
     if (this->min_calib_range.has_value() && other.min_calib_range.has_value() &&
@@ -140,6 +146,7 @@ struct hash<mxnet::op::BatchNormParam> {
     ret = dmlc::HashCombine(ret, val.use_global_stats);
     ret = dmlc::HashCombine(ret, val.output_mean_var);
     ret = dmlc::HashCombine(ret, val.axis);
+    ret = dmlc::HashCombine(ret, val.fuse_relu);
     return ret;
   }
 };
@@ -113,6 +113,9 @@ void BatchNormForwardImpl(mshadow::Stream<cpu> *,
   AccReal  *var = varianceVector.dptr<AccReal>();
 
   const bool is_train_and_not_global_stats = ctx.is_train && !param_.use_global_stats;
+  const bool fuse_relu = param_.fuse_relu;
+  CHECK(!fuse_relu || !ctx.is_train)
+    << "fuse_relu is only supported for inference";
   const size_t channelCount = inputData.ChannelCount();
   const size_t itemCountPerChannel = inputData.Size() / channelCount;
 
@@ -166,10 +169,11 @@ void BatchNormForwardImpl(mshadow::Stream<cpu> *,
     if (!param_.fix_gamma) {
       if (IsBNWriting(req[batchnorm::kData])) {
         ForEachFast(inputData, outputData, channel,
-                    [thisWeight, thisBias, thisMean, thisInvstd](const DType *in_data,
-                                                                 DType *out_data) {
-                      *out_data = static_cast<DType>(
+                    [thisWeight, thisBias, thisMean, thisInvstd, fuse_relu](const DType *in_data,
+                                                                            DType *out_data) {
+                      const DType out = static_cast<DType>(
                         ((*in_data - thisMean) * thisInvstd) * thisWeight + thisBias);
+                      *out_data = fuse_relu && out < DType(0) ? DType(0) : out;
                     });
       }
     } else {
@@ -178,10 +182,11 @@ void BatchNormForwardImpl(mshadow::Stream<cpu> *,
       }
       if (IsBNWriting(req[batchnorm::kData])) {
         ForEachFast(inputData, outputData, channel,
-                    [thisWeight, thisBias, thisMean, thisInvstd](const DType *in_data,
-                                                                 DType *out_data) {
-                      *out_data = static_cast<DType>(
+                    [thisWeight, thisBias, thisMean, thisInvstd, fuse_relu](const DType *in_data,
+                                                                            DType *out_data) {
+                      const DType out = static_cast<DType>(
                         ((*in_data - thisMean) * thisInvstd) + thisBias);
+                      *out_data = fuse_relu && out < DType(0) ? DType(0) : out;
                     });
       }
     }
@@ -384,6 +389,7 @@ static inline bool SupportMKLDNNBN(const NDArray &input, const BatchNormParam &p
   mxnet::TShape shape = input.shape();
   return SupportMKLDNN(input) && shape.ndim() == 4
       && param.axis == mxnet::op::batchnorm::DEFAULT_AXIS
+      && !param.fuse_relu
       && !mxnet::op::batchnorm::disable_mkl;
 }
 
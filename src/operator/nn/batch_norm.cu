@@ -34,6 +34,7 @@
 #define FIX_GAMMA_FLAG        8
 #define IS_TRAINING_FLAG      16
 #define USE_GLOBAL_STATS_FLAG 32
+#define FUSE_RELU_FLAG        64
 
 #if MXNET_USE_CUDNN == 1
 #include "./cudnn/cudnn_batch_norm-inl.h"
@@ -237,8 +238,11 @@ __global__ void BatchNormalizationUpdateOutputInferenceKernel(
   for (int batch = 0, nbatch = input.OuterSize(); batch < nbatch; ++batch) {
     for (int x = threadIdx.x, nx = input.InnerSize(); x < nx; x += blockDim.x) {
       const DType inp = input.get_ref(batch, plane, x);
-      output.get_ref(batch, plane, x) =
-        ScalarConvert<AccReal, DType>::to(gamma * (inp - mean) * invstd + beta);
+      AccReal out = gamma * (inp - mean) * invstd + beta;
+      if ((flags & FUSE_RELU_FLAG) != 0 && out < AccReal(0)) {
+        out = AccReal(0);
+      }
+      output.get_ref(batch, plane, x) = ScalarConvert<AccReal, DType>::to(out);
     }
   }
 }
@@ -516,6 +520,8 @@ static void BatchNormalizationUpdateOutput(mshadow::Stream<gpu> *s,
       input, output, runningMean, runningVar, saveMean,
         saveInvStd, weight, bias, eps, flags);
   } else {
+    CHECK_EQ(flags & FUSE_RELU_FLAG, 0U)
+      << "fuse_relu is only supported for inference";
     dim3 blocks(input.ChannelCount());
     dim3 threads(batchnorm::cuda::getNumThreads(input.InnerSize(), false));
     BatchNormalizationUpdateOutputKernel<DType, AccReal, DeviceTensor1,
@@ -583,6 +589,7 @@ static inline uint32_t SetupFlags(const OpContext &ctx,
   flags |= ctx.is_train ? IS_TRAINING_FLAG : 0;
   flags |= params.fix_gamma ? FIX_GAMMA_FLAG : 0;
   flags |= params.use_global_stats ? USE_GLOBAL_STATS_FLAG : 0;
+  flags |= params.fuse_relu ? FUSE_RELU_FLAG : 0;
   if (IsBNWriting(req[batchnorm::kData])) {
     flags |= WRITE_DATA_FLAG;
   }
@@ -668,7 +675,7 @@ void BatchNormCompute<gpu>(const nnvm::NodeAttrs& attrs,
 
   param.axis = mxnet::op::batchnorm::GetRealAxis(shape, param.axis);
 #if MXNET_USE_CUDNN == 1
-  if (!param.use_global_stats && !param.cudnn_off
+  if (!param.use_global_stats && !param.cudnn_off && !param.fuse_relu
       && param.axis == mxnet::op::batchnorm::DEFAULT_AXIS) {
     MSHADOW_REAL_TYPE_SWITCH(dtype, DType, {
       GetCuDNNOp<DType>(param).Forward(ctx, in_data, req, outputs, aux_states);
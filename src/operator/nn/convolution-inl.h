@@ -43,6 +43,8 @@
 #include "../operator_common.h"
 #include "../linalg.h"
 #include "./im2col.h"
+#include "./winograd_conv-inl.h"
+#include "./depthwise_convolution_cpu-inl.h"
 
 
 namespace mxnet {
@@ -204,6 +206,16 @@ class ConvolutionOp {
           linalg_gemm(weight_3d[g], input_3d[g], output_3d[g], false, false, s, req[conv::kOut]);
         }
       }
+    } else if (DepthwiseConvolutionForwardCpu<xpu, DType>(ctx, param_, in_data[conv::kData],
+                                                          in_data[conv::kWeight],
+                                                          out_data[conv::kOut])) {
+      // depthwise convolution handled by the direct kernel; im2col would
+      // run one tiny gemm per group here. Bias is added below.
+    } else if (WinogradConvolutionForward<xpu, DType>(ctx, param_, in_data[conv::kData],
+                                                      in_data[conv::kWeight],
+                                                      out_data[conv::kOut])) {
+      // 3x3 stride-1 convolution handled by the Winograd kernels;
+      // bias is added below like on the other paths
     } else {
       // allocate workspace for col_buffer
       Tensor<xpu, 1, DType> workspace = ctx.requested[conv::kTempSpace]
@@ -26,7 +26,11 @@
 #ifndef MXNET_OPERATOR_NN_CUDNN_CUDNN_ALGOREG_INL_H_
 #define MXNET_OPERATOR_NN_CUDNN_CUDNN_ALGOREG_INL_H_
 
+#include <dmlc/io.h>
 #include <algorithm>
+#include <cstdio>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -71,6 +75,20 @@ class CuDNNAlgoReg {
                             CuDNNAlgo<cudnnConvolutionBwdDataAlgo_t> *,
                             CuDNNAlgo<cudnnConvolutionBwdFilterAlgo_t> *)>;
 
+  /*!
+   * \brief construct a registry; when MXNET_CUDNN_ALGO_CACHE_FILE is set,
+   *  algo selections are loaded from and persisted to <prefix>.<name> so a
+   *  process restart skips re-tuning the convolutions it already knows
+   */
+  explicit CuDNNAlgoReg(const std::string& name) {
+    const std::string prefix =
+        dmlc::GetEnv("MXNET_CUDNN_ALGO_CACHE_FILE", std::string());
+    if (!prefix.empty()) {
+      cache_file_ = prefix + "." + name;
+      this->LoadCache();
+    }
+  }
+
   void FindOrElseRegister(const ParamType &param,
             const mxnet::ShapeVector &in_shape,
             const mxnet::ShapeVector &out_shape,
@@ -113,6 +131,7 @@ class CuDNNAlgoReg {
       algo_setter(fwd, bwd, flt);
       // Save result so future lookups hit in this registry
       reg_.insert(std::pair<ParamKey, CudnnAlgorithms>(key, CudnnAlgorithms{*fwd, *bwd, *flt}));
+      if (!cache_file_.empty()) this->SaveCache();
     }
   }
 
@@ -163,9 +182,117 @@ class CuDNNAlgoReg {
     }
   };
 
+  /*! \brief rewrite the cache file from the registry, called with lock_ held */
+  void SaveCache() {
+    const std::string tmp = cache_file_ + ".tmp";
+    std::unique_ptr<dmlc::Stream> strm(dmlc::Stream::Create(tmp.c_str(), "w", true));
+    if (strm == nullptr) {
+      if (!is_warning_cache_file_) {
+        LOG(INFO) << "cuDNN algo cache: cannot write to " << tmp
+                  << ", algo selections will not be persisted";
+        is_warning_cache_file_ = true;
+      }
+      return;
+    }
+    strm->Write(kCacheMagic);
+    strm->Write(static_cast<uint64_t>(CUDNN_VERSION));
+    strm->Write(static_cast<uint64_t>(reg_.size()));
+    for (const auto& kv : reg_) {
+      const ParamKey& key = kv.first;
+      const CudnnAlgorithms& algos = kv.second;
+      ParamType param = key.param;
+      std::map<std::string, std::string> dict = param.__DICT__();
+      strm->Write(static_cast<uint64_t>(dict.size()));
+      for (const auto& field : dict) {
+        strm->Write(field.first);
+        strm->Write(field.second);
+      }
+      key.data_shape.Save(strm.get());
+      key.weight_shape.Save(strm.get());
+      key.out_shape.Save(strm.get());
+      strm->Write(static_cast<int32_t>(key.cudnn_data_type));
+      strm->Write(static_cast<int32_t>(key.cudnn_forward_compute_type));
+      strm->Write(static_cast<int32_t>(key.cudnn_backward_compute_type));
+      strm->Write(static_cast<int32_t>(key.sm_arch));
+      strm->Write(key.add_to_weight);
+      strm->Write(static_cast<int32_t>(algos.fwd.AlgoNumber()));
+      strm->Write(algos.fwd.IsTensorCoreAlgo());
+      strm->Write(static_cast<int32_t>(algos.bwd.AlgoNumber()));
+      strm->Write(algos.bwd.IsTensorCoreAlgo());
+      strm->Write(static_cast<int32_t>(algos.flt.AlgoNumber()));
+      strm->Write(algos.flt.IsTensorCoreAlgo());
+    }
+    strm.reset();
+    // publish atomically so a concurrent reader never sees a partial file
+    std::rename(tmp.c_str(), cache_file_.c_str());
+  }
+
+  /*! \brief seed the registry from the cache file, called from the constructor */
+  void LoadCache() {
+    std::unique_ptr<dmlc::Stream> strm(
+        dmlc::Stream::Create(cache_file_.c_str(), "r", true));
+    if (strm == nullptr) return;
+    try {
+      uint64_t magic = 0, version = 0, n = 0;
+      if (!strm->Read(&magic) || magic != kCacheMagic) return;
+      // selections tuned on another cuDNN do not carry over
+      if (!strm->Read(&version) || version != static_cast<uint64_t>(CUDNN_VERSION)) return;
+      if (!strm->Read(&n)) return;
+      for (uint64_t i = 0; i < n; ++i) {
+        ParamKey key;
+        CudnnAlgorithms algos;
+        uint64_t ndict = 0;
+        CHECK(strm->Read(&ndict));
+        std::vector<std::pair<std::string, std::string> > kwargs(ndict);
+        for (auto& field : kwargs) {
+          CHECK(strm->Read(&field.first));
+          CHECK(strm->Read(&field.second));
+        }
+        key.param.InitAllowUnknown(kwargs);
+        CHECK(key.data_shape.Load(strm.get()));
+        CHECK(key.weight_shape.Load(strm.get()));
+        CHECK(key.out_shape.Load(strm.get()));
+        int32_t val = 0;
+        CHECK(strm->Read(&val));
+        key.cudnn_data_type = static_cast<cudnnDataType_t>(val);
+        CHECK(strm->Read(&val));
+        key.cudnn_forward_compute_type = static_cast<cudnnDataType_t>(val);
+        CHECK(strm->Read(&val));
+        key.cudnn_backward_compute_type = static_cast<cudnnDataType_t>(val);
+        CHECK(strm->Read(&val));
+        key.sm_arch = val;
+        CHECK(strm->Read(&key.add_to_weight));
+        int32_t algo = 0;
+        bool tensor_core = false;
+        CHECK(strm->Read(&algo));
+        CHECK(strm->Read(&tensor_core));
+        algos.fwd.Set(static_cast<cudnnConvolutionFwdAlgo_t>(algo), tensor_core);
+        CHECK(strm->Read(&algo));
+        CHECK(strm->Read(&tensor_core));
+        algos.bwd.Set(static_cast<cudnnConvolutionBwdDataAlgo_t>(algo), tensor_core);
+        CHECK(strm->Read(&algo));
+        CHECK(strm->Read(&tensor_core));
+        algos.flt.Set(static_cast<cudnnConvolutionBwdFilterAlgo_t>(algo), tensor_core);
+        reg_.insert(std::pair<ParamKey, CudnnAlgorithms>(key, algos));
+      }
+      LOG(INFO) << "Loaded " << reg_.size() << " cuDNN algo selections from "
+                << cache_file_;
+    } catch (const dmlc::Error& e) {
+      reg_.clear();
+      LOG(INFO) << "Ignoring unreadable cuDNN algo cache " << cache_file_
+                << ": " << e.what();
+    }
+  }
+
+  /*! \brief magic of the cache file, bumped when the layout changes */
+  static const uint64_t kCacheMagic = 0x6d786e6574636e31ULL;  // "mxnetcn1"
+
   std::mutex lock_;
   std::unordered_map<ParamKey, CudnnAlgorithms, ParamHash> reg_;
+  /*! \brief path of the persisted cache, empty when persistence is disabled */
+  std::string cache_file_;
   bool is_warning_autotune_ = false;
+  bool is_warning_cache_file_ = false;
 };
 
 typedef CuDNNAlgoReg<ConvolutionParam> CuDNNConvAlgoReg;
@@ -35,13 +35,13 @@ namespace op {
 #if MXNET_USE_CUDNN == 1
 template<>
 CuDNNAlgoReg<ConvolutionParam> *CuDNNAlgoReg<ConvolutionParam>::Get() {
-  static CuDNNAlgoReg<ConvolutionParam> inst;
+  static CuDNNAlgoReg<ConvolutionParam> inst("conv");
   return &inst;
 }
 
 template<>
 CuDNNAlgoReg<DeconvolutionParam> *CuDNNAlgoReg<DeconvolutionParam>::Get() {
-  static CuDNNAlgoReg<DeconvolutionParam> inst;
+  static CuDNNAlgoReg<DeconvolutionParam> inst("deconv");
   return &inst;
 }
 #endif  // CUDNN
@@ -0,0 +1,76 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file depthwise_convolution_cpu-inl.h
+ * \brief direct depthwise convolution for the CPU path.
+ *
+ * Depthwise convolutions (num_group == channels) degenerate to one
+ * 1xK*K gemm per group on the im2col path, so the gemm never amortizes
+ * its setup. The direct kernel loops kernel taps outside and output
+ * pixels inside, which keeps the inner loop contiguous and
+ * vectorizable. The CUDA path has its own kernels in
+ * depthwise_convolution-inl.h; implementation of this one lives in
+ * depthwise_convolution_cpu.cc.
+ */
+#ifndef MXNET_OPERATOR_NN_DEPTHWISE_CONVOLUTION_CPU_INL_H_
+#define MXNET_OPERATOR_NN_DEPTHWISE_CONVOLUTION_CPU_INL_H_
+
+#include <mxnet/base.h>
+#include <mxnet/op_attr_types.h>
+
+namespace mxnet {
+namespace op {
+
+struct ConvolutionParam;
+
+/*!
+ * \brief run a depthwise convolution through the direct CPU kernel.
+ * Returns false when the configuration is not covered (not 2D NCHW
+ * depthwise with channel multiplier 1, or not a real dtype on cpu), in
+ * which case the caller falls back to im2col+gemm. Bias is left to the
+ * caller.
+ */
+template<typename xpu, typename DType>
+inline bool DepthwiseConvolutionForwardCpu(const OpContext& ctx,
+                                           const ConvolutionParam& param,
+                                           const TBlob& data,
+                                           const TBlob& weight,
+                                           const TBlob& out) {
+  return false;
+}
+
+template<>
+bool DepthwiseConvolutionForwardCpu<cpu, float>(const OpContext& ctx,
+                                                const ConvolutionParam& param,
+                                                const TBlob& data,
+                                                const TBlob& weight,
+                                                const TBlob& out);
+
+template<>
+bool DepthwiseConvolutionForwardCpu<cpu, double>(const OpContext& ctx,
+                                                 const ConvolutionParam& param,
+                                                 const TBlob& data,
+                                                 const TBlob& weight,
+                                                 const TBlob& out);
+
+}  // namespace op
+}  // namespace mxnet
+
+#endif  // MXNET_OPERATOR_NN_DEPTHWISE_CONVOLUTION_CPU_INL_H_
@@ -0,0 +1,142 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file depthwise_convolution_cpu.cc
+ * \brief direct depthwise convolution CPU kernels.
+ */
+
+#include <algorithm>
+
+#include "./convolution-inl.h"
+#include "./depthwise_convolution_cpu-inl.h"
+#include "../../engine/openmp.h"
+
+namespace mxnet {
+namespace op {
+
+namespace {
+
+// one (image, channel) plane: kernel taps outside, output pixels inside.
+// Out-of-bounds taps contribute zero, so each tap just trims its output
+// range instead of branching per pixel; the inner loop stays contiguous
+// for stride 1 and the compiler vectorizes it.
+template<typename DType>
+void DepthwisePlane(const DType* in, const DType* kernel, DType* out,
+                    const index_t H, const index_t W,
+                    const index_t Ho, const index_t Wo,
+                    const index_t kh, const index_t kw,
+                    const index_t sh, const index_t sw,
+                    const index_t ph, const index_t pw,
+                    const index_t dh, const index_t dw) {
+  for (index_t oy = 0; oy < Ho; ++oy) {
+    DType* orow = out + oy * Wo;
+    for (index_t ox = 0; ox < Wo; ++ox) {
+      orow[ox] = DType(0);
+    }
+    for (index_t ki = 0; ki < kh; ++ki) {
+      const index_t y = oy * sh - ph + ki * dh;
+      if (y < 0 || y >= H) continue;
+      const DType* irow = in + y * W;
+      for (index_t kj = 0; kj < kw; ++kj) {
+        const DType wval = kernel[ki * kw + kj];
+        const index_t off = kj * dw - pw;
+        // x = ox * sw + off must stay within [0, W)
+        index_t lo = 0;
+        if (off < 0) {
+          lo = (-off + sw - 1) / sw;
+        }
+        index_t hi = Wo;
+        if (off + (Wo - 1) * sw >= W) {
+          hi = (W - off + sw - 1) / sw;
+        }
+        if (sw == 1) {
+          const DType* seg = irow + off;
+          for (index_t ox = lo; ox < hi; ++ox) {
+            orow[ox] += wval * seg[ox];
+          }
+        } else {
+          for (index_t ox = lo; ox < hi; ++ox) {
+            orow[ox] += wval * irow[ox * sw + off];
+          }
+        }
+      }
+    }
+  }
+}
+
+template<typename DType>
+bool DepthwiseForwardImpl(const OpContext& ctx,
+                          const ConvolutionParam& param,
+                          const TBlob& data,
+                          const TBlob& weight,
+                          const TBlob& out) {
+  if (param.kernel.ndim() != 2 ||
+      param.layout.value() != mshadow::kNCHW ||
+      static_cast<index_t>(param.num_group) != data.shape_[1] ||
+      out.shape_[1] != data.shape_[1]) {
+    return false;
+  }
+  const index_t num = data.shape_[0];
+  const index_t C = data.shape_[1];
+  const index_t H = data.shape_[2];
+  const index_t W = data.shape_[3];
+  const index_t Ho = out.shape_[2];
+  const index_t Wo = out.shape_[3];
+  const index_t kh = param.kernel[0];
+  const index_t kw = param.kernel[1];
+  const DType* in_ptr = data.dptr<DType>();
+  const DType* w_ptr = weight.dptr<DType>();
+  DType* out_ptr = out.dptr<DType>();
+  const int nthreads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+  #pragma omp parallel for num_threads(nthreads)
+  for (index_t nc = 0; nc < num * C; ++nc) {
+    const index_t c = nc % C;
+    DepthwisePlane(in_ptr + nc * H * W, w_ptr + c * kh * kw,
+                   out_ptr + nc * Ho * Wo,
+                   H, W, Ho, Wo, kh, kw,
+                   param.stride[0], param.stride[1],
+                   param.pad[0], param.pad[1],
+                   param.dilate[0], param.dilate[1]);
+  }
+  return true;
+}
+
+}  // namespace
+
+template<>
+bool DepthwiseConvolutionForwardCpu<cpu, float>(const OpContext& ctx,
+                                                const ConvolutionParam& param,
+                                                const TBlob& data,
+                                                const TBlob& weight,
+                                                const TBlob& out) {
+  return DepthwiseForwardImpl<float>(ctx, param, data, weight, out);
+}
+
+template<>
+bool DepthwiseConvolutionForwardCpu<cpu, double>(const OpContext& ctx,
+                                                 const ConvolutionParam& param,
+                                                 const TBlob& data,
+                                                 const TBlob& weight,
+                                                 const TBlob& out) {
+  return DepthwiseForwardImpl<double>(ctx, param, data, weight, out);
+}
+
+}  // namespace op
+}  // namespace mxnet
@@ -57,6 +57,32 @@ enum DropoutOpInputs {kData};
 enum DropoutOpOutputs {kOut, kMask};
 enum DropoutOpForwardResource {kRandom};
 enum DropoutOpMode {kTraining, kAlways};
+
+/*!
+ * \brief Philox4x32-10 keyed on (seed, element index). Counter-based, so
+ *  backward can regenerate the exact mask of the forward pass from the seed
+ *  alone instead of reading a stored mask tensor; used when
+ *  MXNET_DROPOUT_RNG_RECOMPUTE is set.
+ */
+MSHADOW_XINLINE uint32_t PhiloxRandom(const uint64_t seed, const uint64_t idx) {
+  uint32_t c0 = static_cast<uint32_t>(idx);
+  uint32_t c1 = static_cast<uint32_t>(idx >> 32);
+  uint32_t c2 = 0x9E3779B9U;
+  uint32_t c3 = 0xBB67AE85U;
+  uint32_t k0 = static_cast<uint32_t>(seed);
+  uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+  for (int round = 0; round < 10; ++round) {
+    const uint64_t p0 = static_cast<uint64_t>(0xD2511F53U) * c0;
+    const uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57U) * c2;
+    c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+    c1 = static_cast<uint32_t>(p1);
+    c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+    c3 = static_cast<uint32_t>(p0);
+    k0 += 0x9E3779B9U;
+    k1 += 0xBB67AE85U;
+  }
+  return c0;
+}
 }  // namespace dropout
 
 namespace mxnet {
@@ -197,6 +223,39 @@ class DropoutOp {
       });
     }
   };
+  /*!
+   * \brief Dropout kernel for the RNG-replay mode: the mask value is derived
+   *  from a counter-based generator keyed on the replay seed and the element
+   *  index, and is not written anywhere. Backward replays the same seed.
+   */
+  struct DropoutReplayKernel {
+    MSHADOW_XINLINE static void Map(index_t id,
+                                    const uint64_t seed,
+                                    DType *dropout_out,
+                                    const DType *input_data,
+                                    const real_t pkeep) {
+      const real_t rand_num = static_cast<real_t>(dropout::PhiloxRandom(seed, id)) *
+                              (1.0f / 4294967296.0f);
+      dropout_out[id] = input_data[id] *
+          mshadow_op::threshold_eq::Map<real_t>(rand_num, pkeep) * (1.0f / pkeep);
+    }
+  };
+  /*! \brief Backward of DropoutReplayKernel, regenerating the same mask */
+  template<int req>
+  struct DropoutReplayGradKernel {
+    MSHADOW_XINLINE static void Map(index_t id,
+                                    const uint64_t seed,
+                                    DType *igrad,
+                                    const DType *ograd,
+                                    const real_t pkeep) {
+      const real_t rand_num = static_cast<real_t>(dropout::PhiloxRandom(seed, id)) *
+                              (1.0f / 4294967296.0f);
+      KERNEL_ASSIGN(igrad[id], req,
+                    ograd[id] *
+                    mshadow_op::threshold_eq::Map<real_t>(rand_num, pkeep) *
+                    (1.0f / pkeep));
+    }
+  };
   struct BernoulliKernel {
     /*! \brief Bernoulli kernel for generating mask */
     MSHADOW_XINLINE static void Map(index_t id,
@@ -217,6 +276,9 @@ class DropoutOp {
     this->mode_ = static_cast<dropout::DropoutOpMode>(param.mode);
     this->axes_ = param.axes;
     this->dropout_passthrough_ = true;
+    this->rng_recompute_ = dmlc::GetEnv("MXNET_DROPOUT_RNG_RECOMPUTE", false) &&
+                           param.axes.ndim() == 0;
+    this->replay_seed_ = 0;
 #if MXNET_USE_CUDNN_DROPOUT
     this->cudnn_off_ = param.cudnn_off && param.cudnn_off.value();
     this->ctx_ = ctx;
@@ -350,6 +412,21 @@ class DropoutOp {
       if (this->pkeep_ < 1 && (ctx.is_train || this->mode_ == dropout::kAlways)) {
         this->dropout_passthrough_ = false;
         if (this->axes_.ndim() == 0) {
+          if (this->rng_recompute_) {
+            // stamp a fresh replay seed; backward regenerates the mask from
+            // it, so the mask tensor is neither written here nor kept alive
+            RandGenerator<xpu, DType> *pgen =
+                ctx.requested[0].get_parallel_random<xpu, DType>();
+            CHECK_NOTNULL(pgen);
+            CHECK(req[dropout::kOut] != kAddTo);
+            this->replay_seed_ =
+                (static_cast<uint64_t>(pgen->GetSeed()) << 32) |
+                common::random::NextCounterTicket();
+            mxnet_op::Kernel<DropoutReplayKernel, xpu>::Launch(
+                s, out.Size(), this->replay_seed_, out.dptr<DType>(),
+                in.dptr<DType>(), this->pkeep_);
+            return;
+          }
 #if MXNET_USE_MKL_DROPOUT
           if (MKLAvailable()) {
             MKLForward(ctx, in_data, out_data);
@@ -425,6 +502,16 @@ class DropoutOp {
       this->dropout_passthrough_ = true;
       const TBlob &gdata = in_grad[dropout::kData];
       const TBlob &grad = out_grad[dropout::kOut];
+      if (this->rng_recompute_) {
+        // regenerate the forward mask from the replay seed instead of
+        // reading a stored mask tensor
+        MXNET_ASSIGN_REQ_SWITCH(req[dropout::kData], Req, {
+          mxnet_op::Kernel<DropoutReplayGradKernel<Req>, xpu>::Launch(
+              s, gdata.Size(), this->replay_seed_, gdata.dptr<DType>(),
+              grad.dptr<DType>(), this->pkeep_);
+        });
+        return;
+      }
       const TBlob &mask = out_data[dropout::kMask];
       if (this->axes_.ndim() == 0) {
 #if MXNET_USE_MKL_DROPOUT
@@ -487,6 +574,11 @@ class DropoutOp {
   mxnet::TShape axes_;
   /*! \brief Flag to record whether forward is executed in pass-through mode */
   bool dropout_passthrough_;
+  /*! \brief Regenerate the mask in backward from a counter-based RNG instead
+   *  of storing it; see MXNET_DROPOUT_RNG_RECOMPUTE */
+  bool rng_recompute_;
+  /*! \brief Seed the last forward derived its mask from, replayed in backward */
+  uint64_t replay_seed_;
 #if MXNET_USE_CUDNN_DROPOUT
   bool cudnn_off_;
   Context ctx_;
@@ -516,13 +608,17 @@ void DropoutGradCompute(const OpStatePtr& state,
                         const std::vector<TBlob>& inputs,
                         const std::vector<OpReqType>& req,
                         const std::vector<TBlob>& outputs) {
-  CHECK_EQ(inputs.size(), 2U);
+  // the mask input is absent when MXNET_DROPOUT_RNG_RECOMPUTE is set and the
+  // mask is regenerated from the replay seed instead
+  CHECK(inputs.size() == 2U || inputs.size() == 1U);
   CHECK_EQ(outputs.size(), 1);
   CHECK_EQ(req.size(), 1);
   std::vector<TBlob> out_grads(2);
   std::vector<TBlob> out_data(2);
   out_grads[dropout::kOut] = inputs[0];
-  out_data[dropout::kMask] = inputs[1];
+  if (inputs.size() == 2U) {
+    out_data[dropout::kMask] = inputs[1];
+  }
 
   MSHADOW_REAL_TYPE_SWITCH(inputs[0].type_flag_, DType, {
     DropoutOp<xpu, DType>& op = state.get_state<DropoutOp<xpu, DType>>();
@@ -49,13 +49,25 @@ OpStatePtr CreateDropoutState(const nnvm::NodeAttrs &attrs,
   return OpStatePtr();  // should never reach here
 }
 
+// whether the backward pass regenerates the mask from the forward's replay
+// seed instead of consuming the stored mask tensor
+inline bool DropoutRecomputesMask(const nnvm::NodeAttrs& attrs) {
+  static const bool rng_recompute = dmlc::GetEnv("MXNET_DROPOUT_RNG_RECOMPUTE", false);
+  const DropoutParam& param = nnvm::get<DropoutParam>(attrs.parsed);
+  return rng_recompute && param.axes.ndim() == 0;
+}
+
 struct DropoutGrad {
   const char *op_name;
   std::vector<nnvm::NodeEntry> operator()(const nnvm::NodePtr& n,
                                           const std::vector<nnvm::NodeEntry>& ograds) const {
     std::vector<nnvm::NodeEntry> heads;
     heads.push_back(ograds[0]);
-    heads.emplace_back(n, dropout::kMask, 0);
+    // without the mask head, the mask tensor has no consumers and is not
+    // kept alive between the forward and backward passes
+    if (!DropoutRecomputesMask(n->attrs)) {
+      heads.emplace_back(n, dropout::kMask, 0);
+    }
     return MakeGradNode(op_name, n, heads, n->attrs.dict);
   }
 };
@@ -150,7 +162,9 @@ Example::
     std::vector<ResourceRequest> request;
     const DropoutParam& param = nnvm::get<DropoutParam>(attrs.parsed);
     if (param.p == 0) return request;
-    if (dev_mask == kGPU) {
+    // mask replay draws its seed from the parallel random resource and
+    // bypasses the cudnn path
+    if (dev_mask == kGPU && !DropoutRecomputesMask(attrs)) {
 #if MXNET_USE_CUDNN_DROPOUT
       // if cudnn is used, parallel random is not needed.
       if (1.0f - param.p > 0
@@ -171,7 +185,9 @@ Example::
 .add_arguments(DropoutParam::__FIELDS__());
 
 NNVM_REGISTER_OP(_backward_Dropout)
-.set_num_inputs(2)
+.set_num_inputs([](const NodeAttrs& attrs) {
+  return DropoutRecomputesMask(attrs) ? 1 : 2;
+})
 .set_num_outputs(1)
 .set_attr<bool>("TIsLayerOpBackward", true)
 .set_attr<nnvm::TIsBackward>("TIsBackward", true)
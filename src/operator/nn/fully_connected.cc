@@ -22,9 +22,14 @@
  * \file fully_connected.cc
  * \brief fully connect operator
 */
+#include <chrono>
+#include <sstream>
 #include "./fully_connected-inl.h"
 #include "./mkldnn/mkldnn_ops-inl.h"
 #include "./mkldnn/mkldnn_base-inl.h"
+#if MXNET_USE_MKLDNN == 1
+#include "./mkldnn/mkldnn_auto_dispatch.h"
+#endif  // MXNET_USE_MKLDNN
 #if MXNET_USE_NNPACK == 1
 #include "../nnpack/nnpack_fully_connected-inl.h"
 #endif  // MXNET_USE_NNPACK
@@ -38,6 +43,24 @@ bool SupportMKLDNNFC(const NDArray& input) {
          input.storage_type() == kDefaultStorage;
 }
 
+#if MXNET_USE_MKLDNN == 1
+// op + shape bucket identifier for profile-guided dispatch. Batch-like
+// sizes are bucketed; the layer dimensions are fixed per layer and kept
+// exact so different layers get independent decisions.
+static std::string FCDispatchKey(const FullyConnectedParam& param,
+                                 const NDArray& data) {
+  const mxnet::TShape& dshape = data.shape();
+  const index_t num_input = param.flatten ?
+      dshape.ProdShape(1, dshape.ndim()) : dshape[dshape.ndim() - 1];
+  const index_t batch = num_input > 0 ? dshape.Size() / num_input : 0;
+  std::ostringstream os;
+  os << "FullyConnected:t" << data.dtype()
+     << ":b" << MKLDNNAutoDispatch::Bucket(batch)
+     << ":i" << num_input << ":o" << param.num_hidden;
+  return os.str();
+}
+#endif  // MXNET_USE_MKLDNN
+
 static bool FullyConnectedShape(const nnvm::NodeAttrs& attrs,
                                 mxnet::ShapeVector *in_shape,
                                 mxnet::ShapeVector *out_shape) {
@@ -101,10 +124,28 @@ void FullyConnectedComputeExCPU(const nnvm::NodeAttrs& attrs,
   if (common::ContainsOnlyStorage(inputs, kDefaultStorage) &&
       common::ContainsOnlyStorage(outputs, kDefaultStorage)) {
     if (SupportMKLDNNFC(inputs[0])) {
-      MKLDNN_OPCHECK_INIT(false, outputs.size(), inputs, outputs);
-      MKLDNNFCForward(attrs, ctx, inputs, req, outputs);
-      MKLDNN_OPCHECK_RUN(FullyConnectedCompute<cpu>, attrs, ctx, inputs, req,
-                         outputs);
+      bool use_mkldnn = true;
+      bool timed = false;
+      std::string dispatch_key;
+      if (MKLDNNAutoDispatch::Enabled()) {
+        dispatch_key = FCDispatchKey(param, inputs[0]);
+        timed = MKLDNNAutoDispatch::Begin(dispatch_key, &use_mkldnn);
+      }
+      const auto start = std::chrono::high_resolution_clock::now();
+      if (use_mkldnn) {
+        MKLDNN_OPCHECK_INIT(false, outputs.size(), inputs, outputs);
+        MKLDNNFCForward(attrs, ctx, inputs, req, outputs);
+        MKLDNN_OPCHECK_RUN(FullyConnectedCompute<cpu>, attrs, ctx, inputs, req,
+                           outputs);
+      } else {
+        FallBackCompute(FullyConnectedCompute<cpu>, attrs, ctx, inputs, req, outputs);
+      }
+      if (timed) {
+        const auto stop = std::chrono::high_resolution_clock::now();
+        MKLDNNAutoDispatch::End(
+          dispatch_key, use_mkldnn,
+          std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+      }
     } else {
       FallBackCompute(FullyConnectedCompute<cpu>, attrs, ctx, inputs, req, outputs);
     }
@@ -25,7 +25,11 @@
 
 #include "layer_norm-inl.h"
 #include <nnvm/op_attr_types.h>
+#include <dmlc/omp.h>
+#include <cmath>
+#include <cstring>
 #include "../elemwise_op_common.h"
+#include "../../engine/openmp.h"
 
 #if MSHADOW_USE_MKL == 1
 #include "../mkl_functions-inl.h"
@@ -65,11 +69,129 @@ static bool LayerNormShape(const nnvm::NodeAttrs& attrs,
   return true;
 }
 
+/*!
+ * \brief single-pass layer norm over the last axis. Each row computes
+ * mean and variance with Welford's algorithm, so the data is read once
+ * instead of once for the mean and again for the variance, and the
+ * normalization reuses the row while it is still in cache.
+ */
+template<typename DType>
+static void LayerNormCPUKernel(const size_t nrows, const size_t nchannels,
+                               const DType eps, const DType* in,
+                               const DType* gamma, const DType* beta,
+                               DType* out, DType* mean, DType* std) {
+  const int nthreads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+#pragma omp parallel for num_threads(nthreads)
+  for (index_t i = 0; i < static_cast<index_t>(nrows); ++i) {
+    const DType* row = in + i * nchannels;
+    DType m = 0;
+    DType m2 = 0;
+    for (size_t j = 0; j < nchannels; ++j) {
+      const DType x = row[j];
+      const DType delta = x - m;
+      m += delta / static_cast<DType>(j + 1);
+      m2 += delta * (x - m);
+    }
+    const DType sd = std::sqrt(m2 / static_cast<DType>(nchannels) + eps);
+    const DType invstd = DType(1) / sd;
+    mean[i] = m;
+    std[i] = sd;
+    DType* orow = out + i * nchannels;
+    for (size_t j = 0; j < nchannels; ++j) {
+      orow[j] = gamma[j] * ((row[j] - m) * invstd) + beta[j];
+    }
+  }
+}
+
+/*!
+ * \brief fused layer norm backward over the last axis. One traversal of
+ * the data produces the data gradient and per-thread partial gamma/beta
+ * gradients; the partials are summed across threads at the end. scratch
+ * must hold 2 * nthreads * nchannels elements.
+ */
+template<typename DType>
+static void LayerNormGradCPUKernel(const size_t nrows, const size_t nchannels,
+                                   const DType* ograd, const DType* in,
+                                   const DType* gamma, const DType* mean,
+                                   const DType* std, DType* data_grad,
+                                   DType* gamma_grad, DType* beta_grad,
+                                   DType* scratch) {
+  const int nthreads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+  memset(scratch, 0, 2 * nthreads * nchannels * sizeof(DType));
+#pragma omp parallel num_threads(nthreads)
+  {
+    DType* gamma_part = scratch + 2 * omp_get_thread_num() * nchannels;
+    DType* beta_part = gamma_part + nchannels;
+#pragma omp for
+    for (index_t i = 0; i < static_cast<index_t>(nrows); ++i) {
+      const DType* og = ograd + i * nchannels;
+      const DType* row = in + i * nchannels;
+      const DType m = mean[i];
+      const DType invstd = DType(1) / std[i];
+      DType acc_w = 0;
+      DType acc_wx = 0;
+      for (size_t j = 0; j < nchannels; ++j) {
+        const DType xbar = (row[j] - m) * invstd;
+        const DType w = og[j] * gamma[j] * invstd;
+        acc_w += w;
+        acc_wx += w * xbar;
+        gamma_part[j] += og[j] * xbar;
+        beta_part[j] += og[j];
+      }
+      if (data_grad != nullptr) {
+        const DType mean_w = acc_w / static_cast<DType>(nchannels);
+        const DType mean_wx = acc_wx / static_cast<DType>(nchannels);
+        DType* dg = data_grad + i * nchannels;
+        for (size_t j = 0; j < nchannels; ++j) {
+          const DType xbar = (row[j] - m) * invstd;
+          const DType w = og[j] * gamma[j] * invstd;
+          dg[j] = w - mean_w - xbar * mean_wx;
+        }
+      }
+    }
+  }
+  for (size_t j = 0; j < nchannels; ++j) {
+    DType gsum = 0;
+    DType bsum = 0;
+    for (int t = 0; t < nthreads; ++t) {
+      gsum += scratch[2 * t * nchannels + j];
+      bsum += scratch[(2 * t + 1) * nchannels + j];
+    }
+    if (gamma_grad != nullptr) gamma_grad[j] = gsum;
+    if (beta_grad != nullptr) beta_grad[j] = bsum;
+  }
+}
+
 template<>
 void LayerNormCompute<cpu>(const nnvm::NodeAttrs& attrs,
                            const OpContext& ctx, const std::vector<TBlob>& inputs,
                            const std::vector<OpReqType>& req,
                            const std::vector<TBlob>& outputs) {
+  const LayerNormParam& param = nnvm::get<LayerNormParam>(attrs.parsed);
+  if (req[0] == kNullOp || inputs[0].Size() == 0U) return;
+  CHECK_NE(req[0], kAddTo);
+  const int axis = GetRealAxis(param.axis, inputs[0].ndim());
+  // the last axis is contiguous, so the whole op collapses to independent
+  // rows and the single-pass kernel applies
+  if (axis == inputs[0].ndim() - 1 &&
+      (inputs[0].type_flag_ == mshadow::kFloat32 ||
+       inputs[0].type_flag_ == mshadow::kFloat64)) {
+    mxnet::TShape red_src_shape, red_dst_shape;
+    BroadcastReduceShapeCompact(inputs[0].shape_, outputs[layernorm::kMean].shape_,
+                                &red_src_shape, &red_dst_shape);
+    const size_t nrows = red_dst_shape.Size();
+    const size_t nchannels = red_src_shape.Size() / nrows;
+    MSHADOW_SGL_DBL_TYPE_SWITCH(inputs[0].type_flag_, DType, {
+      LayerNormCPUKernel<DType>(nrows, nchannels, static_cast<DType>(param.eps),
+                                inputs[layernorm::kData].dptr<DType>(),
+                                inputs[layernorm::kGamma].dptr<DType>(),
+                                inputs[layernorm::kBeta].dptr<DType>(),
+                                outputs[layernorm::kOut].dptr<DType>(),
+                                outputs[layernorm::kMean].dptr<DType>(),
+                                outputs[layernorm::kStd].dptr<DType>());
+    });
+    return;
+  }
   return LayerNormComputeGeneral<cpu>(attrs, ctx, inputs, req, outputs);
 }
 
@@ -123,6 +245,38 @@ void LayerNormGradCompute<cpu>(const nnvm::NodeAttrs& attrs,
                                const OpContext& ctx, const std::vector<TBlob>& inputs,
                                const std::vector<OpReqType>& req,
                                const std::vector<TBlob>& outputs) {
+  const LayerNormParam& param = nnvm::get<LayerNormParam>(attrs.parsed);
+  const int axis = GetRealAxis(param.axis, inputs[0].ndim());
+  const bool fast_reqs =
+      (req[0] == kWriteTo || req[0] == kNullOp) &&
+      (req[1] == kWriteTo || req[1] == kNullOp) &&
+      (req[2] == kWriteTo || req[2] == kNullOp);
+  if (axis == inputs[0].ndim() - 1 && fast_reqs && inputs[0].Size() != 0U &&
+      (inputs[0].type_flag_ == mshadow::kFloat32 ||
+       inputs[0].type_flag_ == mshadow::kFloat64)) {
+    const TBlob& mean = inputs[3];
+    mxnet::TShape red_src_shape, red_dst_shape;
+    BroadcastReduceShapeCompact(inputs[0].shape_, mean.shape_,
+                                &red_src_shape, &red_dst_shape);
+    const size_t nrows = red_dst_shape.Size();
+    const size_t nchannels = red_src_shape.Size() / nrows;
+    const int nthreads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+    mshadow::Stream<cpu>* s = ctx.get_stream<cpu>();
+    MSHADOW_SGL_DBL_TYPE_SWITCH(inputs[0].type_flag_, DType, {
+      mshadow::Tensor<cpu, 1, DType> scratch =
+          ctx.requested[0].get_space_typed<cpu, 1, DType>(
+              mshadow::Shape1(2 * nthreads * nchannels), s);
+      LayerNormGradCPUKernel<DType>(
+          nrows, nchannels, inputs[0].dptr<DType>(), inputs[1].dptr<DType>(),
+          inputs[2].dptr<DType>(), inputs[3].dptr<DType>(),
+          inputs[4].dptr<DType>(),
+          req[0] == kNullOp ? nullptr : outputs[0].dptr<DType>(),
+          req[1] == kNullOp ? nullptr : outputs[1].dptr<DType>(),
+          req[2] == kNullOp ? nullptr : outputs[2].dptr<DType>(),
+          scratch.dptr_);
+    });
+    return;
+  }
   return LayerNormGradComputeGeneral<cpu>(attrs, ctx, inputs, req, outputs);
 }
 
@@ -127,22 +127,22 @@ const inline mkldnn::eltwise_forward &MKLDNNActForward::GetFwd() const {
 MKLDNNActForward &GetActForward(const MKLDNNActParam& param,
                                 const OpContext &ctx, const NDArray &in_data,
                                 const mkldnn::memory &in_mem) {
+  using act_fwd_cache = MKLDNNPrimitiveCache<MKLDNNActSignature, MKLDNNActForward, OpHash>;
 #if DMLC_CXX11_THREAD_LOCAL
-  static thread_local std::unordered_map<MKLDNNActSignature, MKLDNNActForward, OpHash> fwds;
+  static thread_local act_fwd_cache fwds;
 #else
-  static MX_THREAD_LOCAL std::unordered_map<MKLDNNActSignature, MKLDNNActForward, OpHash> fwds;
+  static MX_THREAD_LOCAL act_fwd_cache fwds;
 #endif
   MKLDNNActSignature key(param);
   key.AddSign(ctx.is_train);
   key.AddSign(static_cast<int>(param.alg));
   key.AddSign(param.slope);
   key.AddSign(in_data);
-  auto it = fwds.find(key);
-  if (it == fwds.end()) {
-    MKLDNNActForward fwd(param, ctx.is_train, in_data, in_mem);
-    it = AddToCache(&fwds, key, fwd);
+  MKLDNNActForward *fwd = fwds.Find(key);
+  if (fwd == nullptr) {
+    fwd = &fwds.Insert(key, MKLDNNActForward(param, ctx.is_train, in_data, in_mem));
   }
-  return it->second;
+  return *fwd;
 }
 
 void MKLDNNActivationForward(const nnvm::NodeAttrs& attrs, const OpContext &ctx,
@@ -216,21 +216,21 @@ static inline MKLDNNActBackward &GetActBackward(const MKLDNNActParam &param,
                                                 const NDArray &in_data,
                                                 const NDArray &out_grad,
                                                 const mkldnn::memory &in_mem) {
+  using act_bwd_cache = MKLDNNPrimitiveCache<MKLDNNActSignature, MKLDNNActBackward, OpHash>;
 #if DMLC_CXX11_THREAD_LOCAL
-  static thread_local std::unordered_map<MKLDNNActSignature, MKLDNNActBackward, OpHash> bwds;
+  static thread_local act_bwd_cache bwds;
 #else
-  static MX_THREAD_LOCAL std::unordered_map<MKLDNNActSignature, MKLDNNActBackward, OpHash> bwds;
+  static MX_THREAD_LOCAL act_bwd_cache bwds;
 #endif
   MKLDNNActSignature key(param);
   key.AddSign(in_data);
   key.AddSign(out_grad);
 
-  auto it = bwds.find(key);
-  if (it == bwds.end()) {
-    MKLDNNActBackward bwd(param, in_data, in_mem, *out_grad.GetMKLDNNData());
-    it = AddToCache(&bwds, key, bwd);
+  MKLDNNActBackward *bwd = bwds.Find(key);
+  if (bwd == nullptr) {
+    bwd = &bwds.Insert(key, MKLDNNActBackward(param, in_data, in_mem, *out_grad.GetMKLDNNData()));
   }
-  return it->second;
+  return *bwd;
 }
 
 // For backward relu activation, it's okay to pass "out_data" as "in_data" to this
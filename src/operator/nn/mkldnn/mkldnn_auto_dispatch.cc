@@ -0,0 +1,124 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2020 by Contributors
+ * \file mkldnn_auto_dispatch.cc
+ * \brief Profile-guided choice between MKLDNN primitives and native kernels.
+ */
+
+#if MXNET_USE_MKLDNN == 1
+
+#include "./mkldnn_auto_dispatch.h"
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../../operator_tune.h"
+
+namespace mxnet {
+namespace op {
+namespace {
+
+// type_flag marking dispatch decisions in the tuning cache file; tuning
+// measurements use mshadow type flags and -1 for the OMP overhead
+constexpr int kDispatchCacheFlag = -2;
+// timed invocations of each path before a winner is picked
+constexpr size_t kSamples = 5;
+
+double Median(std::vector<double>* v) {
+  std::sort(v->begin(), v->end());
+  return (*v)[v->size() / 2];
+}
+
+class DispatchRegistry : protected OperatorTuneBase {
+ public:
+  static DispatchRegistry* Get() {
+    static DispatchRegistry registry;
+    return &registry;
+  }
+
+  bool Begin(const std::string& key, bool* use_mkldnn) {
+    std::lock_guard<std::mutex> lock(mu_);
+    Entry& e = entries_[key];
+    if (!e.decided) {
+      float cached;
+      if (CacheLookup(kDispatchCacheFlag, key, &cached)) {
+        e.decided = true;
+        e.use_mkldnn = cached >= 0.5f;
+      }
+    }
+    if (e.decided) {
+      *use_mkldnn = e.use_mkldnn;
+      return false;
+    }
+    *use_mkldnn = e.next_mkldnn;
+    e.next_mkldnn = !e.next_mkldnn;
+    return true;
+  }
+
+  void End(const std::string& key, bool used_mkldnn, double elapsed_ns) {
+    std::lock_guard<std::mutex> lock(mu_);
+    Entry& e = entries_[key];
+    if (e.decided) {
+      return;  // another thread finished the measuring phase meanwhile
+    }
+    (used_mkldnn ? e.mkldnn_ns : e.native_ns).push_back(elapsed_ns);
+    if (e.mkldnn_ns.size() >= kSamples && e.native_ns.size() >= kSamples) {
+      e.use_mkldnn = Median(&e.mkldnn_ns) <= Median(&e.native_ns);
+      e.decided = true;
+      CacheStore(kDispatchCacheFlag, key, e.use_mkldnn ? 1.0f : 0.0f);
+      CacheSave();
+    }
+  }
+
+ private:
+  struct Entry {
+    std::vector<double> mkldnn_ns;
+    std::vector<double> native_ns;
+    bool decided{false};
+    bool use_mkldnn{true};
+    // paths alternate while measuring so neither gets all the cold calls
+    bool next_mkldnn{true};
+  };
+  std::mutex mu_;
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+}  // namespace
+
+bool MKLDNNAutoDispatch::Enabled() {
+  static const bool enabled = dmlc::GetEnv("MXNET_MKLDNN_AUTO_DISPATCH", false);
+  return enabled;
+}
+
+bool MKLDNNAutoDispatch::Begin(const std::string& key, bool* use_mkldnn) {
+  return DispatchRegistry::Get()->Begin(key, use_mkldnn);
+}
+
+void MKLDNNAutoDispatch::End(const std::string& key, bool used_mkldnn,
+                             double elapsed_ns) {
+  DispatchRegistry::Get()->End(key, used_mkldnn, elapsed_ns);
+}
+
+}  // namespace op
+}  // namespace mxnet
+
+#endif  // MXNET_USE_MKLDNN == 1
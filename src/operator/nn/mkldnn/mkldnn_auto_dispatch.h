@@ -0,0 +1,80 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2020 by Contributors
+ * \file mkldnn_auto_dispatch.h
+ * \brief Profile-guided choice between MKLDNN primitives and native kernels.
+ */
+
+#ifndef MXNET_OPERATOR_NN_MKLDNN_MKLDNN_AUTO_DISPATCH_H_
+#define MXNET_OPERATOR_NN_MKLDNN_MKLDNN_AUTO_DISPATCH_H_
+#if MXNET_USE_MKLDNN == 1
+
+#include <mxnet/base.h>
+#include <string>
+
+namespace mxnet {
+namespace op {
+
+/*!
+ * \brief Profile-guided dispatch between an MKLDNN primitive and the native
+ *        kernel of the same operator. For some shapes (small batch
+ *        FullyConnected, tiny convolutions) the primitive loses to the
+ *        native path, but the static Support* checks cannot know that.
+ *        The first invocations of each op + shape bucket alternate between
+ *        the two paths and are timed; once both paths have enough samples
+ *        the faster one wins, and the decision is persisted in the operator
+ *        tuning cache so later processes on the same host skip the
+ *        measuring phase. Gated by MXNET_MKLDNN_AUTO_DISPATCH.
+ */
+class MKLDNNAutoDispatch {
+ public:
+  /*! \brief whether MXNET_MKLDNN_AUTO_DISPATCH is set */
+  static bool Enabled();
+  /*!
+   * \brief Decide which path this invocation takes.
+   * \param key op + shape bucket identifier
+   * \param use_mkldnn set to whether the MKLDNN path should run
+   * \return true if the caller must time the invocation and report it via End()
+   */
+  static bool Begin(const std::string& key, bool* use_mkldnn);
+  /*!
+   * \brief Report a timed invocation started with Begin().
+   * \param key the key passed to Begin()
+   * \param used_mkldnn which path actually ran
+   * \param elapsed_ns wall time of the invocation in nanoseconds
+   */
+  static void End(const std::string& key, bool used_mkldnn, double elapsed_ns);
+  /*!
+   * \brief Round up to the next power of two; the shape bucket for
+   *        batch-like dimensions, so nearby sizes share a decision.
+   */
+  static index_t Bucket(index_t n) {
+    index_t b = 1;
+    while (b < n) b <<= 1;
+    return b;
+  }
+};
+
+}  // namespace op
+}  // namespace mxnet
+
+#endif  // MXNET_USE_MKLDNN == 1
+#endif  // MXNET_OPERATOR_NN_MKLDNN_MKLDNN_AUTO_DISPATCH_H_
@@ -49,6 +49,7 @@
 #if MXNET_USE_MKLDNN == 1
 #include <algorithm>
 #include <iterator>
+#include <list>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -165,6 +166,63 @@ static typename std::unordered_map<S, I, H>::iterator AddToCache(
   return ins_return.first;
 }
 
+/*!
+ * \brief per-thread LRU cache for MKL-DNN primitives.
+ *
+ * The plain unordered_map caches above evict an arbitrary entry once
+ * MXNET_MKLDNN_CACHE_NUM is exceeded, which can drop the hot shape
+ * bucket under shape-varied serving. This cache evicts the least
+ * recently used entry instead and keeps hit statistics; with
+ * MXNET_MKLDNN_CACHE_STATS=1 the per-thread counters are logged every
+ * 10000 lookups. Instances are meant to be declared thread_local like
+ * the maps they replace, so no locking is involved. References returned
+ * by Find/Insert stay valid until the entry itself is evicted.
+ */
+template<typename S, typename I, typename H>
+class MKLDNNPrimitiveCache {
+ public:
+  /*! \brief look up a primitive; marks the entry most recently used */
+  I* Find(const S &key) {
+    ++lookups_;
+    MaybeLogStats();
+    auto it = index_.find(key);
+    if (it == index_.end()) return nullptr;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    ++hits_;
+    return &entries_.front().second;
+  }
+
+  /*! \brief insert a primitive, evicting the least recently used entry
+   * when the MXNET_MKLDNN_CACHE_NUM cap is reached */
+  I& Insert(const S &key, const I &item) {
+    const int cap = GetMKLDNNCacheSize();
+    if (cap != -1 && static_cast<int>(entries_.size()) >= cap) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+      ++evictions_;
+    }
+    entries_.emplace_front(key, item);
+    index_[key] = entries_.begin();
+    return entries_.front().second;
+  }
+
+ private:
+  void MaybeLogStats() {
+    static const bool stats = dmlc::GetEnv("MXNET_MKLDNN_CACHE_STATS", false);
+    if (stats && lookups_ % 10000 == 0) {
+      LOG(INFO) << "mkldnn primitive cache: size=" << entries_.size()
+                << " lookups=" << lookups_ << " hits=" << hits_
+                << " evictions=" << evictions_;
+    }
+  }
+
+  std::list<std::pair<S, I>> entries_;
+  std::unordered_map<S, typename std::list<std::pair<S, I>>::iterator, H> index_;
+  size_t lookups_ = 0;
+  size_t hits_ = 0;
+  size_t evictions_ = 0;
+};
+
 /*
  * This is to align address to a certain alignment.
  */
@@ -320,11 +320,11 @@ MKLDNNConvForward::MKLDNNConvForward(const MKLDNNConvFullParam &param, const boo
 MKLDNNConvForward &GetConvFwd(const MKLDNNConvFullParam &param, const bool is_train,
                               const NDArray &data, const NDArray &weight, const NDArray *bias,
                               const NDArray &output) {
-  using conv_fwd_map = std::unordered_map<MKLDNNConvSignature, MKLDNNConvForward, OpHash>;
+  using conv_fwd_cache = MKLDNNPrimitiveCache<MKLDNNConvSignature, MKLDNNConvForward, OpHash>;
 #if DMLC_CXX11_THREAD_LOCAL
-  static thread_local conv_fwd_map fwds;
+  static thread_local conv_fwd_cache fwds;
 #else
-  static MX_THREAD_LOCAL conv_fwd_map fwds;
+  static MX_THREAD_LOCAL conv_fwd_cache fwds;
 #endif
   // TODO(zhennan): Hash conv_param for now, need to hash full param if we want to enable cache for
   // fused conv
@@ -337,12 +337,11 @@ MKLDNNConvForward &GetConvFwd(const MKLDNNConvFullParam &param, const bool is_tr
   key.AddSign(output);
   if (bias) key.AddSign(*bias);
 
-  auto it = fwds.find(key);
-  if (it == fwds.end()) {
-    auto fwd = MKLDNNConvForward(param, is_train, data, weight, bias, output);
-    it = AddToCache(&fwds, key, fwd);
+  MKLDNNConvForward *fwd = fwds.Find(key);
+  if (fwd == nullptr) {
+    fwd = &fwds.Insert(key, MKLDNNConvForward(param, is_train, data, weight, bias, output));
   }
-  return it->second;
+  return *fwd;
 }
 
 void MKLDNNConvolutionForwardFullFeature(const MKLDNNConvFullParam &param, const OpContext &ctx,
@@ -426,11 +425,11 @@ MKLDNNConvBackward::MKLDNNConvBackward(const MKLDNNConvFullParam &param, const N
 static inline MKLDNNConvBackward &GetConvBwd(const MKLDNNConvFullParam &param, const NDArray &data,
                                              const NDArray &weight, const NDArray *bias,
                                              const NDArray &output) {
-  using mkldnn_conv_bwd_map = std::unordered_map<MKLDNNConvSignature, MKLDNNConvBackward, OpHash>;
+  using conv_bwd_cache = MKLDNNPrimitiveCache<MKLDNNConvSignature, MKLDNNConvBackward, OpHash>;
 #if DMLC_CXX11_THREAD_LOCAL
-  static thread_local mkldnn_conv_bwd_map bwds;
+  static thread_local conv_bwd_cache bwds;
 #else
-  static MX_THREAD_LOCAL mkldnn_conv_bwd_map bwds;
+  static MX_THREAD_LOCAL conv_bwd_cache bwds;
 #endif
   // TODO(zhennan): Hash conv_param for now, need to hash full param if we want to enable cache for
   // fused conv
@@ -442,12 +441,11 @@ static inline MKLDNNConvBackward &GetConvBwd(const MKLDNNConvFullParam &param, c
   key.AddSign(output);
   if (bias) key.AddSign(*bias);
 
-  auto it = bwds.find(key);
-  if (it == bwds.end()) {
-    auto bwd = MKLDNNConvBackward(param, data, weight, bias, output);
-    it = AddToCache(&bwds, key, bwd);
+  MKLDNNConvBackward *bwd = bwds.Find(key);
+  if (bwd == nullptr) {
+    bwd = &bwds.Insert(key, MKLDNNConvBackward(param, data, weight, bias, output));
   }
-  return it->second;
+  return *bwd;
 }
 
 void MKLDNNConvolutionBackward(const nnvm::NodeAttrs& attrs, const OpContext &ctx,
@@ -135,12 +135,12 @@ MKLDNNFullyConnectedForward &GetFCFwd(
     const FullyConnectedParam &param, const bool is_train,
     const NDArray &data, const NDArray &weight,
     const NDArray *bias, const mkldnn::memory::desc &out_md) {
+  using fc_fwd_cache = MKLDNNPrimitiveCache<MKLDNNFullyconSignature,
+              MKLDNNFullyConnectedForward, OpHash>;
 #if DMLC_CXX11_THREAD_LOCAL
-  static thread_local std::unordered_map<MKLDNNFullyconSignature,
-              MKLDNNFullyConnectedForward, OpHash> fcFwds;
+  static thread_local fc_fwd_cache fcFwds;
 #else
-  static MX_THREAD_LOCAL std::unordered_map<MKLDNNFullyconSignature,
-              MKLDNNFullyConnectedForward, OpHash> fcFwds;
+  static MX_THREAD_LOCAL fc_fwd_cache fcFwds;
 #endif
   MKLDNNFullyconSignature key(param);
   key.AddSign(is_train);
@@ -149,15 +149,15 @@ MKLDNNFullyConnectedForward &GetFCFwd(
   if (bias)
     key.AddSign(*bias);
 
-  auto it = fcFwds.find(key);
-  if (it == fcFwds.end()) {
+  MKLDNNFullyConnectedForward *fcFwd = fcFwds.Find(key);
+  if (fcFwd == nullptr) {
     MKLDNNFCFullParam full_param;
     full_param.default_param = param;
     full_param.mkldnn_param.Init(std::unordered_map<std::string, std::string>());
-    MKLDNNFullyConnectedForward fcFwd(full_param, is_train, data, weight, bias, out_md);
-    it = AddToCache(&fcFwds, key, fcFwd);
+    fcFwd = &fcFwds.Insert(key,
+        MKLDNNFullyConnectedForward(full_param, is_train, data, weight, bias, out_md));
   }
-  return it->second;
+  return *fcFwd;
 }
 
 void MKLDNNFCFlattenData(const FullyConnectedParam &param,
@@ -0,0 +1,66 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file winograd_conv-inl.h
+ * \brief Winograd F(2x2,3x3) convolution for the native CPU path.
+ *
+ * im2col+gemm does 2.25x the multiplications a 3x3 stride-1 convolution
+ * needs. The Winograd path transforms 4x4 input tiles and the weights
+ * into 16 per-position matrices, runs one gemm per position and
+ * transforms the 2x2 output tiles back. Implementation lives in
+ * winograd_conv.cc.
+ */
+#ifndef MXNET_OPERATOR_NN_WINOGRAD_CONV_INL_H_
+#define MXNET_OPERATOR_NN_WINOGRAD_CONV_INL_H_
+
+#include <mxnet/base.h>
+#include <mxnet/op_attr_types.h>
+
+namespace mxnet {
+namespace op {
+
+struct ConvolutionParam;
+
+/*!
+ * \brief run the convolution through the Winograd F(2x2,3x3) kernels.
+ * Returns false when the configuration is not covered (kernel shape,
+ * stride, dilation, grouping, layout, dtype or device), in which case
+ * the caller falls back to im2col+gemm. Bias is left to the caller.
+ */
+template<typename xpu, typename DType>
+inline bool WinogradConvolutionForward(const OpContext& ctx,
+                                       const ConvolutionParam& param,
+                                       const TBlob& data,
+                                       const TBlob& weight,
+                                       const TBlob& out) {
+  return false;
+}
+
+template<>
+bool WinogradConvolutionForward<cpu, float>(const OpContext& ctx,
+                                            const ConvolutionParam& param,
+                                            const TBlob& data,
+                                            const TBlob& weight,
+                                            const TBlob& out);
+
+}  // namespace op
+}  // namespace mxnet
+
+#endif  // MXNET_OPERATOR_NN_WINOGRAD_CONV_INL_H_
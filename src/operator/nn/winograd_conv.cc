@@ -0,0 +1,213 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file winograd_conv.cc
+ * \brief Winograd F(2x2,3x3) CPU convolution kernels.
+ *
+ * Layout of the transformed buffers: for each of the 16 tile positions
+ * there is one weight matrix U[pos] of shape K x C, one input matrix
+ * V[pos] of shape C x T and one product M[pos] = U[pos] * V[pos] of
+ * shape K x T, where T is the number of 2x2 output tiles of one image.
+ * The transforms are cache-blocked implicitly: each (channel, tile)
+ * pair is handled as one 4x4 stack-resident patch.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "./convolution-inl.h"
+#include "./winograd_conv-inl.h"
+#include "../linalg.h"
+#include "../../engine/openmp.h"
+
+namespace mxnet {
+namespace op {
+
+namespace {
+
+inline bool WinogradEnabled() {
+  static const bool enabled = dmlc::GetEnv("MXNET_CONV_WINOGRAD", true);
+  return enabled;
+}
+
+// U = G g G^T for one 3x3 kernel, G = [[1,0,0],[.5,.5,.5],[.5,-.5,.5],[0,0,1]]
+inline void TransformWeight3x3(const float* g, float* u, const index_t stride) {
+  float t[4][3];
+  for (int j = 0; j < 3; ++j) {
+    const float g0 = g[0 * 3 + j];
+    const float g1 = g[1 * 3 + j];
+    const float g2 = g[2 * 3 + j];
+    t[0][j] = g0;
+    t[1][j] = 0.5f * (g0 + g1 + g2);
+    t[2][j] = 0.5f * (g0 - g1 + g2);
+    t[3][j] = g2;
+  }
+  for (int i = 0; i < 4; ++i) {
+    const float t0 = t[i][0];
+    const float t1 = t[i][1];
+    const float t2 = t[i][2];
+    u[(i * 4 + 0) * stride] = t0;
+    u[(i * 4 + 1) * stride] = 0.5f * (t0 + t1 + t2);
+    u[(i * 4 + 2) * stride] = 0.5f * (t0 - t1 + t2);
+    u[(i * 4 + 3) * stride] = t2;
+  }
+}
+
+// V = B^T d B for one 4x4 input patch,
+// B^T = [[1,0,-1,0],[0,1,1,0],[0,-1,1,0],[0,1,0,-1]]
+inline void TransformInput4x4(const float d[4][4], float* v, const index_t stride) {
+  float w[4][4];
+  for (int j = 0; j < 4; ++j) {
+    w[0][j] = d[0][j] - d[2][j];
+    w[1][j] = d[1][j] + d[2][j];
+    w[2][j] = d[2][j] - d[1][j];
+    w[3][j] = d[1][j] - d[3][j];
+  }
+  for (int i = 0; i < 4; ++i) {
+    v[(i * 4 + 0) * stride] = w[i][0] - w[i][2];
+    v[(i * 4 + 1) * stride] = w[i][1] + w[i][2];
+    v[(i * 4 + 2) * stride] = w[i][2] - w[i][1];
+    v[(i * 4 + 3) * stride] = w[i][1] - w[i][3];
+  }
+}
+
+// Y = A^T m A for one 4x4 product tile, A^T = [[1,1,1,0],[0,1,-1,-1]]
+inline void TransformOutput4x4(const float* m, const index_t stride, float y[2][2]) {
+  float z[2][4];
+  for (int j = 0; j < 4; ++j) {
+    const float m0 = m[(0 * 4 + j) * stride];
+    const float m1 = m[(1 * 4 + j) * stride];
+    const float m2 = m[(2 * 4 + j) * stride];
+    const float m3 = m[(3 * 4 + j) * stride];
+    z[0][j] = m0 + m1 + m2;
+    z[1][j] = m1 - m2 - m3;
+  }
+  for (int i = 0; i < 2; ++i) {
+    y[i][0] = z[i][0] + z[i][1] + z[i][2];
+    y[i][1] = z[i][1] - z[i][2] - z[i][3];
+  }
+}
+
+}  // namespace
+
+template<>
+bool WinogradConvolutionForward<cpu, float>(const OpContext& ctx,
+                                            const ConvolutionParam& param,
+                                            const TBlob& data,
+                                            const TBlob& weight,
+                                            const TBlob& out) {
+  using namespace mshadow;
+  if (!WinogradEnabled()) return false;
+  if (param.kernel.ndim() != 2 ||
+      param.kernel[0] != 3 || param.kernel[1] != 3 ||
+      param.stride[0] != 1 || param.stride[1] != 1 ||
+      param.dilate[0] != 1 || param.dilate[1] != 1 ||
+      param.num_group != 1 ||
+      param.layout.value() != mshadow::kNCHW) {
+    return false;
+  }
+  const index_t num = data.shape_[0];
+  const index_t C = data.shape_[1];
+  const index_t H = data.shape_[2];
+  const index_t W = data.shape_[3];
+  const index_t K = out.shape_[1];
+  const index_t Ho = out.shape_[2];
+  const index_t Wo = out.shape_[3];
+  const index_t ph = param.pad[0];
+  const index_t pw = param.pad[1];
+  const index_t tiles_h = (Ho + 1) / 2;
+  const index_t tiles_w = (Wo + 1) / 2;
+  const index_t T = tiles_h * tiles_w;
+  // param.workspace is in elements at this point (converted in Init)
+  const size_t needed = 16 * (static_cast<size_t>(K) * C +
+                              static_cast<size_t>(C) * T +
+                              static_cast<size_t>(K) * T);
+  if (needed > param.workspace) return false;
+
+  Stream<cpu>* s = ctx.get_stream<cpu>();
+  Tensor<cpu, 1, float> workspace = ctx.requested[conv::kTempSpace]
+    .get_space_typed<cpu, 1, float>(Shape1(needed), s);
+  float* U = workspace.dptr_;
+  float* V = U + 16 * K * C;
+  float* M = V + 16 * C * T;
+  const int nthreads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+
+  // U[pos] is K x C: entry (k, c) of position pos at U[(pos * K + k) * C + c]
+  #pragma omp parallel for num_threads(nthreads)
+  for (index_t kc = 0; kc < K * C; ++kc) {
+    const index_t k = kc / C;
+    const index_t c = kc % C;
+    TransformWeight3x3(weight.dptr<float>() + kc * 9, U + k * C + c, K * C);
+  }
+
+  for (index_t n = 0; n < num; ++n) {
+    const float* img = data.dptr<float>() + n * C * H * W;
+    // V[pos] is C x T: entry (c, t) of position pos at V[(pos * C + c) * T + t]
+    #pragma omp parallel for num_threads(nthreads)
+    for (index_t c = 0; c < C; ++c) {
+      const float* channel = img + c * H * W;
+      for (index_t ty = 0; ty < tiles_h; ++ty) {
+        for (index_t tx = 0; tx < tiles_w; ++tx) {
+          float d[4][4];
+          for (int i = 0; i < 4; ++i) {
+            const index_t y = ty * 2 + i - ph;
+            for (int j = 0; j < 4; ++j) {
+              const index_t x = tx * 2 + j - pw;
+              d[i][j] = (y >= 0 && y < H && x >= 0 && x < W) ?
+                        channel[y * W + x] : 0.f;
+            }
+          }
+          TransformInput4x4(d, V + c * T + ty * tiles_w + tx, C * T);
+        }
+      }
+    }
+
+    for (int pos = 0; pos < 16; ++pos) {
+      Tensor<cpu, 2, float> u_mat(U + pos * K * C, Shape2(K, C), s);
+      Tensor<cpu, 2, float> v_mat(V + pos * C * T, Shape2(C, T), s);
+      Tensor<cpu, 2, float> m_mat(M + pos * K * T, Shape2(K, T), s);
+      linalg_gemm(u_mat, v_mat, m_mat, false, false, s, kWriteTo);
+    }
+
+    float* dst = out.dptr<float>() + n * K * Ho * Wo;
+    #pragma omp parallel for num_threads(nthreads)
+    for (index_t k = 0; k < K; ++k) {
+      for (index_t ty = 0; ty < tiles_h; ++ty) {
+        for (index_t tx = 0; tx < tiles_w; ++tx) {
+          float y[2][2];
+          TransformOutput4x4(M + k * T + ty * tiles_w + tx, K * T, y);
+          for (int i = 0; i < 2; ++i) {
+            const index_t oy = ty * 2 + i;
+            if (oy >= Ho) continue;
+            for (int j = 0; j < 2; ++j) {
+              const index_t ox = tx * 2 + j;
+              if (ox >= Wo) continue;
+              dst[(k * Ho + oy) * Wo + ox] = y[i][j];
+            }
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace op
+}  // namespace mxnet
@@ -408,13 +408,16 @@ inline std::vector<nnvm::NodeEntry> MakeZeroGradNodes(
     const std::vector<nnvm::NodeEntry>& ograds) {
   std::vector<nnvm::NodeEntry> ret;
   for (uint32_t i = 0; i < n->num_inputs(); ++i) {
-    std::ostringstream os;
+    // plain concatenation; ostringstream costs several allocations per name
+    std::string name = n->attrs.name;
     if (1 == n->num_inputs()) {
-      os << n->attrs.name << "_backward";
+      name += "_backward";
     } else {
-      os << n->attrs.name << "_in" << i << "_backward";
+      name += "_in";
+      name += std::to_string(i);
+      name += "_backward";
     }
-    ret.emplace_back(MakeNode("zeros_like", os.str(), {n->inputs[i]}, nullptr, &n));
+    ret.emplace_back(MakeNode("zeros_like", name, {n->inputs[i]}, nullptr, &n));
   }
   return ret;
 }
@@ -113,7 +113,23 @@ class OperatorTune : public OperatorTuneByType<DType> {
    * \brief Constructor
    */
   OperatorTune() {
-    TuneAll();
+    // Tuning is normally deferred until the first UseOMP() query for this data
+    // type (see EnsureTuned()), so that short-lived processes which never
+    // launch a CPU kernel of the type don't pay the tuning cost at library
+    // load. Set MXNET_EAGER_OPERATOR_TUNING=1 to tune at load time as before,
+    // so that the first operator call doesn't absorb the tuning cost.
+    if (dmlc::GetEnv("MXNET_EAGER_OPERATOR_TUNING", false)) {
+      TuneAll();
+    }
+  }
+
+  /*!
+   * \brief Run any tuning passes for this data type that haven't run yet
+   * \return true (usable as a static initializer)
+   */
+  static bool EnsureTuned() {
+    static const bool tuned = TuneAll();
+    return tuned;
   }
 
   /*!
@@ -171,7 +187,16 @@ class OperatorTune : public OperatorTuneByType<DType> {
         if (!config.empty() && ::isdigit(config[0]) && std::atoi(config.c_str()) == 0) {
           OperatorTuneBase::omp_overhead_ns_ = INT_MAX;
         } else {
-          OperatorTuneBase::omp_overhead_ns_ = GetOMPLoopOverhead();
+          // The measured OMP overhead is persisted along with the kernel
+          // workloads, so subsequent runs on this host skip the timing loops
+          float cached_overhead;
+          if (OperatorTuneBase::CacheLookup(-1, "omp_overhead_ns", &cached_overhead)) {
+            OperatorTuneBase::omp_overhead_ns_ = static_cast<duration_t>(cached_overhead);
+          } else {
+            OperatorTuneBase::omp_overhead_ns_ = GetOMPLoopOverhead();
+            OperatorTuneBase::CacheStore(-1, "omp_overhead_ns",
+                                         static_cast<float>(OperatorTuneBase::omp_overhead_ns_));
+          }
         }
         ParseEnablerConfig(config);
       }
@@ -239,6 +264,20 @@ class OperatorTune : public OperatorTuneByType<DType> {
                 << " took " << (duration / 1000000) << " ms";
     }
     CHECK_EQ(size_save, tl->size()) << "Tuning list size should not have changed while tuning";
+    // Persist anything measured during this pass. If the values instead came
+    // from an aging cache file, re-measure them on a background thread so the
+    // stale numbers keep being used now but the file gets refreshed for the
+    // next run, without this one paying the warmup.
+    OperatorTuneBase::CacheSave();
+    if (!tl->empty() && OperatorTuneBase::CacheNeedsRefresh()) {
+      std::thread([](const std::list<void (*)()> &refresh_list) {
+        OperatorTuneBase::CacheBypassThisThread();
+        for (auto i : refresh_list) {
+          (*i)();
+        }
+        OperatorTuneBase::CacheSave();
+      }, *tl).detach();
+    }
     tl->clear();
     return true;
   }
@@ -642,7 +681,14 @@ class UnaryOpTune : public OperatorTune<DType> {
    */
   template<typename OP>
   static void TuneBlankOperator() {
-    mxnet::op::mxnet_op::tuned_op<OP, DType>::workload_[0] = GetBlankWorkload<OP>();
+    float workload;
+    if (!Super::CacheLookup(mshadow::DataType<DType>::kFlag,
+                            Super::template type_name<OP>(), &workload)) {
+      workload = GetBlankWorkload<OP>();
+      Super::CacheStore(mshadow::DataType<DType>::kFlag,
+                        Super::template type_name<OP>(), workload);
+    }
+    mxnet::op::mxnet_op::tuned_op<OP, DType>::workload_[0] = workload;
     if (Super::output_tuning_data_) {
       std::cout << "IMPLEMENT_UNARY_WORKLOAD_FWD("
                 << Super::template type_name<OP>()
@@ -658,7 +704,14 @@ class UnaryOpTune : public OperatorTune<DType> {
    */
   template<typename OP>
   static void TuneUnaryOperator() {
-    mxnet::op::mxnet_op::tuned_op<OP, DType>::workload_[0] = GetUnaryWorkload<OP>();
+    float workload;
+    if (!Super::CacheLookup(mshadow::DataType<DType>::kFlag,
+                            Super::template type_name<OP>(), &workload)) {
+      workload = GetUnaryWorkload<OP>();
+      Super::CacheStore(mshadow::DataType<DType>::kFlag,
+                        Super::template type_name<OP>(), workload);
+    }
+    mxnet::op::mxnet_op::tuned_op<OP, DType>::workload_[0] = workload;
     if (Super::output_tuning_data_) {
       std::cout << "IMPLEMENT_UNARY_WORKLOAD_FWD("
                 << Super::template type_name<OP>()
@@ -674,8 +727,15 @@ class UnaryOpTune : public OperatorTune<DType> {
    */
   template<typename OP>
   static void TuneUnaryBackwardOperator() {
-    mxnet::op::mxnet_op::tuned_op<mxnet_op::backward_grad_tuned<OP>, DType>::workload_[0] =
-      GetBinaryWorkload<mxnet::op::mxnet_op::backward_grad_tuned<OP>>();
+    typedef mxnet::op::mxnet_op::backward_grad_tuned<OP> BwdOP;
+    float workload;
+    if (!Super::CacheLookup(mshadow::DataType<DType>::kFlag,
+                            Super::template type_name<BwdOP>(), &workload)) {
+      workload = GetBinaryWorkload<BwdOP>();
+      Super::CacheStore(mshadow::DataType<DType>::kFlag,
+                        Super::template type_name<BwdOP>(), workload);
+    }
+    mxnet::op::mxnet_op::tuned_op<BwdOP, DType>::workload_[0] = workload;
     if (Super::output_tuning_data_) {
       std::cout << "IMPLEMENT_UNARY_WORKLOAD_BWD("
                 << Super::template type_name<OP>()
@@ -692,7 +752,14 @@ class UnaryOpTune : public OperatorTune<DType> {
    */
   template<typename OP>
   static void TuneBlankOperatorEx() {
-    mxnet::op::mxnet_op::tuned_op<OP, DType>::workload_[0] = GetBlankWorkloadEx<OP>();
+    float workload;
+    if (!Super::CacheLookup(mshadow::DataType<DType>::kFlag,
+                            Super::template type_name<OP>(), &workload)) {
+      workload = GetBlankWorkloadEx<OP>();
+      Super::CacheStore(mshadow::DataType<DType>::kFlag,
+                        Super::template type_name<OP>(), workload);
+    }
+    mxnet::op::mxnet_op::tuned_op<OP, DType>::workload_[0] = workload;
     if (Super::output_tuning_data_) {
       std::cout << "IMPLEMENT_BLANK_WORKLOAD_FWD("
                 << Super::template type_name<OP>()
@@ -710,6 +777,7 @@ class UnaryOpTune : public OperatorTune<DType> {
    */
   template<typename OP>
   inline static bool UseOMP(size_t N, size_t thread_count) {
+      OperatorTune<DType>::EnsureTuned();
       return OperatorTune<DType>::UseOMP(N,
                                          thread_count,
                                          static_cast<uint64_t>(N) * OP::workload_[0]);
@@ -732,7 +800,14 @@ class BinaryOpTune : public UnaryOpTune<DType> {
    */
   template<typename OP>
   static void TuneBinaryOperator() {
-    mxnet_op::tuned_op<OP, DType>::workload_[0] = Super::template GetBinaryWorkload<OP>();
+    float workload;
+    if (!Super::CacheLookup(mshadow::DataType<DType>::kFlag,
+                            Super::template type_name<OP>(), &workload)) {
+      workload = Super::template GetBinaryWorkload<OP>();
+      Super::CacheStore(mshadow::DataType<DType>::kFlag,
+                        Super::template type_name<OP>(), workload);
+    }
+    mxnet_op::tuned_op<OP, DType>::workload_[0] = workload;
     if (Super::Super::output_tuning_data_) {
       std::cout << "IMPLEMENT_BINARY_WORKLOAD_FWD("
                 << Super::template type_name<OP>()
@@ -746,8 +821,15 @@ class BinaryOpTune : public UnaryOpTune<DType> {
    */
   template<typename OP>
   static void TuneBinaryBackwardOperator() {
-    mxnet::op::mxnet_op::tuned_op<mxnet_op::backward_grad_tuned<OP>, DType>::workload_[0] =
-      Super::template GetTertiaryWorkload<mxnet::op::mxnet_op::backward_grad_tuned<OP>>();
+    typedef mxnet::op::mxnet_op::backward_grad_tuned<OP> BwdOP;
+    float workload;
+    if (!Super::CacheLookup(mshadow::DataType<DType>::kFlag,
+                            Super::template type_name<BwdOP>(), &workload)) {
+      workload = Super::template GetTertiaryWorkload<BwdOP>();
+      Super::CacheStore(mshadow::DataType<DType>::kFlag,
+                        Super::template type_name<BwdOP>(), workload);
+    }
+    mxnet::op::mxnet_op::tuned_op<BwdOP, DType>::workload_[0] = workload;
     if (Super::Super::output_tuning_data_) {
       std::cout << "IMPLEMENT_BINARY_WORKLOAD_BWD("
                 << Super::template type_name<OP>()
@@ -17,7 +17,19 @@
  * under the License.
  */
 #include <float.h>
+#if defined(_WIN32) || defined(_WIN64) || defined(__WINDOWS__)
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
 #include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
 #include "./mxnet_op.h"
 #include "./mshadow_op.h"
 #include "./tensor/init_op.h"
@@ -34,6 +46,232 @@ std::atomic<bool> OperatorTuneBase::calculated_(false);
 bool OperatorTuneBase::verbose_tuning_info_ = false;
 double OperatorTuneBase::tuning_weight_scale_ = 0.0;
 
+namespace {
+
+/*!
+ * \brief Per-host persistence for tuning measurements
+ *
+ * Measurements are written to a small text file (by default
+ * $HOME/.mxnet/operator_tuning.cache) keyed by CPU model, core count and
+ * library version, and read back on the next process start so that the
+ * tuning warmup is skipped and threading decisions don't drift with
+ * machine noise between runs. A mismatched key invalidates the whole
+ * file, and entries older than MXNET_OPERATOR_TUNING_CACHE_TTL hours are
+ * re-measured in the background while the stale values keep being used.
+ */
+class TuningCache {
+ public:
+  static TuningCache *Get() {
+    static TuningCache inst;
+    return &inst;
+  }
+
+  bool Lookup(const int type_flag, const std::string &op_name, float *workload) {
+    if (!enabled_ || bypass_this_thread_) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(EntryKey(type_flag, op_name));
+    if (it == entries_.end()) {
+      return false;
+    }
+    *workload = it->second;
+    return true;
+  }
+
+  void Store(const int type_flag, const std::string &op_name, const float workload) {
+    if (!enabled_) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[EntryKey(type_flag, op_name)] = workload;
+    dirty_ = true;
+  }
+
+  void Save() {
+    if (!enabled_) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!dirty_) {
+      return;
+    }
+#if defined(_WIN32) || defined(_WIN64) || defined(__WINDOWS__)
+    _mkdir(dir_.c_str());
+#else
+    mkdir(dir_.c_str(), 0700);
+#endif
+    std::ofstream file(path_, std::ios::trunc);
+    if (!file) {
+      // Not being able to persist (read-only home, etc.) only costs the warmup
+      enabled_ = false;
+      return;
+    }
+    file << "version " << MXNET_VERSION << '\n'
+         << "cpu " << cpu_model_ << '\n'
+         << "cores " << omp_get_num_procs() << '\n'
+         << "saved " << NowInSeconds() << '\n';
+    for (const auto &kv : entries_) {
+      // key is "<type flag>:<op name>", stored as "<type flag>\t<workload>\t<op name>"
+      const size_t colon = kv.first.find(':');
+      file << kv.first.substr(0, colon) << '\t' << kv.second << '\t'
+           << kv.first.substr(colon + 1) << '\n';
+    }
+    saved_at_ = NowInSeconds();
+    dirty_ = false;
+  }
+
+  bool NeedsRefresh() const {
+    if (!enabled_ || !loaded_ || refresh_ttl_hours_ <= 0) {
+      return false;
+    }
+    return NowInSeconds() - saved_at_ > static_cast<int64_t>(refresh_ttl_hours_) * 3600;
+  }
+
+  void BypassThisThread() {
+    bypass_this_thread_ = true;
+  }
+
+ private:
+  TuningCache() {
+    if (!dmlc::GetEnv("MXNET_USE_OPERATOR_TUNING_CACHE", true)) {
+      return;
+    }
+    std::string dir = dmlc::GetEnv("MXNET_OPERATOR_TUNING_CACHE_DIR", std::string());
+    if (dir.empty()) {
+      const char *home = getenv("HOME");
+      if (!home) {
+        home = getenv("USERPROFILE");
+      }
+      if (!home) {
+        return;  // nowhere to put the cache, run with measurement as before
+      }
+      dir = std::string(home) + "/.mxnet";
+    }
+    dir_ = dir;
+    path_ = dir + "/operator_tuning.cache";
+    cpu_model_ = CpuModel();
+    refresh_ttl_hours_ = dmlc::GetEnv("MXNET_OPERATOR_TUNING_CACHE_TTL", 168);
+    enabled_ = true;
+    Load();
+  }
+
+  static std::string EntryKey(const int type_flag, const std::string &op_name) {
+    return std::to_string(type_flag) + ":" + op_name;
+  }
+
+  static int64_t NowInSeconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+  }
+
+  /*!
+   * \brief Host CPU model string, used to invalidate measurements taken on
+   *        different hardware sharing the same home directory
+   */
+  static std::string CpuModel() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+      if (line.compare(0, 10, "model name") == 0) {
+        const size_t colon = line.find(':');
+        if (colon != std::string::npos) {
+          return line.substr(colon + 2);
+        }
+      }
+    }
+    return "unknown";
+  }
+
+  void Load() {
+    std::ifstream file(path_);
+    if (!file) {
+      return;
+    }
+    std::string keyword;
+    int version = 0, cores = 0;
+    std::string cpu;
+    file >> keyword >> version;
+    file >> keyword;
+    std::getline(file, cpu);
+    if (!cpu.empty() && cpu[0] == ' ') {
+      cpu.erase(0, 1);
+    }
+    file >> keyword >> cores;
+    file >> keyword >> saved_at_;
+    if (version != MXNET_VERSION || cpu != cpu_model_ || cores != omp_get_num_procs()) {
+      // Different release or hardware: measurements aren't transferable
+      saved_at_ = 0;
+      return;
+    }
+    std::string line;
+    std::getline(file, line);  // consume remainder of the 'saved' line
+    while (std::getline(file, line)) {
+      std::istringstream iss(line);
+      int type_flag;
+      float workload;
+      std::string op_name;
+      if (iss >> type_flag >> workload && std::getline(iss, op_name)) {
+        if (!op_name.empty() && op_name[0] == '\t') {
+          op_name.erase(0, 1);
+        }
+        entries_[EntryKey(type_flag, op_name)] = workload;
+      }
+    }
+    loaded_ = !entries_.empty();
+  }
+
+  /*! \brief Guards entries_ and the cache file against the refresh thread */
+  std::mutex mutex_;
+  /*! \brief Whether the cache can be used (env setting and a writable path) */
+  bool enabled_{false};
+  /*! \brief Whether a valid cache file was read at startup */
+  bool loaded_{false};
+  /*! \brief Whether entries_ holds measurements not yet written to the file */
+  bool dirty_{false};
+  /*! \brief Directory holding the cache file, created on first save */
+  std::string dir_;
+  /*! \brief Full path of the cache file */
+  std::string path_;
+  /*! \brief CPU model string of this host */
+  std::string cpu_model_;
+  /*! \brief When the loaded cache file was written (unix seconds) */
+  int64_t saved_at_{0};
+  /*! \brief Hours before cached entries are re-measured in the background */
+  int refresh_ttl_hours_{0};
+  /*! \brief Set on background refresh threads so they measure instead of
+   *         reading back their own cached values */
+  static thread_local bool bypass_this_thread_;
+  /*! \brief Cached measurements, keyed by "<type flag>:<op name>" */
+  std::unordered_map<std::string, float> entries_;
+};
+
+thread_local bool TuningCache::bypass_this_thread_ = false;
+
+}  // namespace
+
+bool OperatorTuneBase::CacheLookup(const int type_flag, const std::string &op_name,
+                                   float *workload) {
+  return TuningCache::Get()->Lookup(type_flag, op_name, workload);
+}
+
+void OperatorTuneBase::CacheStore(const int type_flag, const std::string &op_name,
+                                  const float workload) {
+  TuningCache::Get()->Store(type_flag, op_name, workload);
+}
+
+void OperatorTuneBase::CacheSave() {
+  TuningCache::Get()->Save();
+}
+
+bool OperatorTuneBase::CacheNeedsRefresh() {
+  return TuningCache::Get()->NeedsRefresh();
+}
+
+void OperatorTuneBase::CacheBypassThisThread() {
+  TuningCache::Get()->BypassThisThread();
+}
+
 /*!
  * \brief Instantiate static variables for OperatorTune<DType>, where 'DType' is specified
  */
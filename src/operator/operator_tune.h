@@ -19,6 +19,7 @@
 #ifndef MXNET_OPERATOR_OPERATOR_TUNE_H_
 #define MXNET_OPERATOR_OPERATOR_TUNE_H_
 
+#include <dmlc/parameter.h>
 #include <mshadow/base.h>
 #include <mshadow/tensor.h>
 #include <vector>
@@ -78,6 +79,36 @@ class OperatorTuneBase {
   /*! \brief Tuning scale factor */
   static double tuning_weight_scale_;
 
+  /*!
+   * \brief Look up a persisted tuning measurement from the per-host cache file.
+   *        The cache is keyed by CPU model, core count and library version, so
+   *        entries saved by a different host or release are never applied.
+   * \param type_flag mshadow type flag the measurement was taken for (-1 for
+   *        type-independent values such as the OMP overhead)
+   * \param op_name Demangled name of the tuned kernel operator
+   * \param workload Output workload value on a cache hit
+   * \return true if a cached measurement was found
+   */
+  static bool CacheLookup(int type_flag, const std::string &op_name, float *workload);
+  /*!
+   * \brief Record a fresh tuning measurement for later persisting via CacheSave()
+   * \param type_flag mshadow type flag the measurement was taken for (-1 for
+   *        type-independent values such as the OMP overhead)
+   * \param op_name Demangled name of the tuned kernel operator
+   * \param workload Measured workload value
+   */
+  static void CacheStore(int type_flag, const std::string &op_name, float workload);
+  /*! \brief Write the cache file if any new measurements were stored */
+  static void CacheSave();
+  /*!
+   * \brief Whether the loaded cache entries are older than the refresh period
+   *        and should be re-measured in the background
+   */
+  static bool CacheNeedsRefresh();
+  /*! \brief Make CacheLookup() miss on the calling thread, so that a
+   *         background refresh re-measures instead of reading its own cache */
+  static void CacheBypassThisThread();
+
  public:
   typedef std::chrono::high_resolution_clock::time_point Tick;
 
@@ -155,6 +186,34 @@ class OperatorTuneBase {
     }
     return false;
   }
+
+  /*!
+   * \brief Choose how many OMP threads to use for the given workload
+   * \remarks Using every available core only pays off when each thread's
+   *          share of the work clearly exceeds the measured fork/join
+   *          overhead. For mid-sized kernels the count is scaled down so
+   *          that each thread still has at least one overhead's worth of
+   *          compute, which keeps mixed-size graphs from losing small-op
+   *          throughput to the OMP barrier while big kernels still get all
+   *          cores. Set MXNET_OMP_ADAPTIVE_THREADS=0 to always use the full
+   *          recommended thread count as before.
+   * \param thread_count Number of OMP threads available to perform the iterations
+   * \param serial_workload Estimated serial workload (same scaling as IsOMPFaster)
+   * \return Number of threads to use, in the range [1, thread_count]
+   */
+  inline static int OMPThreadCount(size_t thread_count, const uint64_t serial_workload) {
+    static const bool adaptive = dmlc::GetEnv("MXNET_OMP_ADAPTIVE_THREADS", true);
+    const uint64_t overhead_ns = static_cast<uint64_t>(omp_overhead_ns_);
+    if (!adaptive || !overhead_ns || !serial_workload) {
+      return static_cast<int>(thread_count);
+    }
+    const uint64_t total_serial_time_ns = serial_workload >> WORKLOAD_COUNT_SHIFT;
+    const uint64_t max_useful_threads = total_serial_time_ns / overhead_ns;
+    if (max_useful_threads >= thread_count) {
+      return static_cast<int>(thread_count);
+    }
+    return max_useful_threads > 1 ? static_cast<int>(max_useful_threads) : 1;
+  }
 };
 
 namespace tune {
@@ -210,6 +269,31 @@ class OperatorTuneByType : public OperatorTuneBase {
 #endif
   }
 
+  /*!
+   * \brief Choose how many of the available OMP threads to use, based upon
+   *        both timing and configuration. Only the kAuto mode scales the
+   *        count down for small workloads; the forced modes keep the legacy
+   *        all-or-nothing behavior.
+   * \param thread_count Number of OMP threads available to perform the iterations
+   * \param serial_workload Estimated serial workload (same scaling as IsOMPFaster)
+   * \return Number of threads to use, in the range [1, thread_count]
+   */
+  inline static int ThreadCount(size_t thread_count, const uint64_t serial_workload) {
+#ifdef MXNET_USE_OPERATOR_TUNING
+    switch (tuning_mode()) {
+      case tune::kAuto:
+        return OperatorTuneBase::OMPThreadCount(thread_count, serial_workload);
+      case tune::kNeverOMP:
+        return 1;
+      case tune::kAlwaysOMP:
+      default:
+        return static_cast<int>(thread_count);
+    }
+#else
+    return static_cast<int>(thread_count);
+#endif
+  }
+
  protected:
   /*! \brief Tuning mode */
   static volatile tune::TuningMode tuning_mode_;
@@ -32,6 +32,7 @@
 #include <mshadow/base.h>
 #include <nnvm/op.h>
 #include <nnvm/op_attr_types.h>
+#include <algorithm>
 #include <vector>
 #include "./operator_common.h"
 #include "./mshadow_op.h"
@@ -140,6 +141,45 @@ struct MultiSGDMomParam : public dmlc::Parameter<MultiSGDMomParam> {
   }
 };
 
+struct MultiAdamParam : public dmlc::Parameter<MultiAdamParam> {
+  mxnet::Tuple<float> lrs;
+  mxnet::Tuple<float> wds;
+  float beta1;
+  float beta2;
+  float epsilon;
+  float rescale_grad;
+  float clip_gradient;
+  int num_weights;
+  DMLC_DECLARE_PARAMETER(MultiAdamParam) {
+    DMLC_DECLARE_FIELD(lrs)
+    .describe("Learning rates.");
+    DMLC_DECLARE_FIELD(wds)
+    .describe("Weight decay augments the objective function with a "
+              "regularization term that penalizes large weights. "
+              "The penalty scales with the square of the magnitude of each weight.");
+    DMLC_DECLARE_FIELD(beta1)
+    .set_default(0.9f)
+    .describe("The decay rate for the 1st moment estimates.");
+    DMLC_DECLARE_FIELD(beta2)
+    .set_default(0.999f)
+    .describe("The decay rate for the 2nd moment estimates.");
+    DMLC_DECLARE_FIELD(epsilon)
+    .set_default(1e-8f)
+    .describe("A small constant for numerical stability.");
+    DMLC_DECLARE_FIELD(rescale_grad)
+    .set_default(1.0f)
+    .describe("Rescale gradient to grad = rescale_grad*grad.");
+    DMLC_DECLARE_FIELD(clip_gradient)
+    .set_default(-1.0f)
+    .describe("Clip gradient to the range of [-clip_gradient, clip_gradient] "
+              "If clip_gradient <= 0, gradient clipping is turned off. "
+              "grad = max(min(grad, clip_gradient), -clip_gradient).");
+    DMLC_DECLARE_FIELD(num_weights)
+    .set_default(1)
+    .describe("Number of updated weights.");
+  }
+};
+
 
 template<typename ParamType, int input_stride>
 inline bool MultiSGDShape(const nnvm::NodeAttrs& attrs,
@@ -379,6 +419,125 @@ inline void MultiSGDMomUpdate(const nnvm::NodeAttrs& attrs,
   });
 }
 
+template<typename DType, typename MPDType>
+struct MultiAdamKernelParam {
+  static const int N = 60;
+  int count;
+  size_t max_size;
+  size_t sizes[N];
+  DType * weights[N];
+  DType * grads[N];
+  MPDType * mean[N];
+  MPDType * var[N];
+  MPDType * weights32[N];
+  DType * out_data[N];
+  MPDType lrs[N];
+  MPDType wds[N];
+  MPDType clip_gradient;
+  MPDType rescale_grad;
+  MPDType beta1;
+  MPDType beta2;
+  MPDType epsilon;
+};
+
+template <typename MPDType, bool has_mixed_precision>
+struct MultiAdamKernel {
+  template<typename DType>
+  MSHADOW_XINLINE static void Map(int i, const MultiAdamKernelParam<DType, MPDType>& param,
+    const OpReqType req) {
+    using namespace mshadow_op;
+    for (int index = 0; index < param.count; ++index) {
+      if ((size_t)i < param.sizes[index]) {
+        MPDType w = has_mixed_precision ? param.weights32[index][i] :
+                                          MPDType(param.weights[index][i]);
+        MPDType grad_rescaled = param.rescale_grad *
+                                static_cast<MPDType>(param.grads[index][i]) +
+                                param.wds[index] * w;
+        if (param.clip_gradient >= 0.0f) {
+          grad_rescaled = clip::Map(grad_rescaled, param.clip_gradient);
+        }
+        const MPDType mean = param.beta1 * param.mean[index][i] +
+                             (1.f - param.beta1) * grad_rescaled;
+        const MPDType var = param.beta2 * param.var[index][i] +
+                            (1.f - param.beta2) * grad_rescaled * grad_rescaled;
+        param.mean[index][i] = mean;
+        param.var[index][i] = var;
+        w = w - param.lrs[index] * mean / (square_root::Map(var) + param.epsilon);
+        if (has_mixed_precision) {
+          param.weights32[index][i] = w;
+        }
+        KERNEL_ASSIGN(param.out_data[index][i], req, w);
+      }
+    }
+  }
+};
+
+template<typename xpu, typename DType, typename MPDType, int input_stride>
+MultiAdamKernelParam<DType, MPDType> FillMultiAdamKernelParam(const nnvm::NodeAttrs& attrs,
+                                                              const OpContext &ctx,
+                                                              const std::vector<TBlob> &inputs,
+                                                              const std::vector<TBlob> &outputs,
+                                                              const int first_weight,
+                                                              const int num_weights) {
+  using namespace mxnet_op;
+  const MultiAdamParam& p = nnvm::get<MultiAdamParam>(attrs.parsed);
+  Stream<xpu>* s = ctx.get_stream<xpu>();
+  MultiAdamKernelParam<DType, MPDType> param;
+  param.clip_gradient = p.clip_gradient;
+  param.rescale_grad = p.rescale_grad;
+  param.beta1 = p.beta1;
+  param.beta2 = p.beta2;
+  param.epsilon = p.epsilon;
+  param.count = num_weights;
+  param.max_size = 0;
+  for (int i = 0; i < param.count; ++i) {
+    const int idx = first_weight + i;
+    param.sizes[i] = inputs[idx * input_stride].shape_.Size();
+    if (param.max_size < param.sizes[i]) {
+      param.max_size = param.sizes[i];
+    }
+    param.weights[i] = inputs[idx * input_stride].FlatTo2D<xpu, DType>(s).dptr_;
+    param.grads[i] = inputs[idx * input_stride + 1].FlatTo2D<xpu, DType>(s).dptr_;
+    param.mean[i] = inputs[idx * input_stride + 2].FlatTo2D<xpu, MPDType>(s).dptr_;
+    param.var[i] = inputs[idx * input_stride + 3].FlatTo2D<xpu, MPDType>(s).dptr_;
+    // if mixed precision, then the last input in a set
+    // is the 32-bit master copy of the weights
+    if (!std::is_same<DType, MPDType>::value) {
+      param.weights32[i] = inputs[idx * input_stride + input_stride - 1]
+                           .FlatTo2D<xpu, MPDType>(s).dptr_;
+    }
+    param.out_data[i] = outputs[idx].FlatTo2D<xpu, DType>(s).dptr_;
+    param.lrs[i] = p.lrs[idx];
+    param.wds[i] = p.wds[idx];
+  }
+  return param;
+}
+
+template<typename xpu, template<typename> class MPTypeChooser, int input_stride>
+inline void MultiAdamUpdate(const nnvm::NodeAttrs& attrs,
+                            const OpContext &ctx,
+                            const std::vector<TBlob> &inputs,
+                            const std::vector<OpReqType> &req,
+                            const std::vector<TBlob> &outputs) {
+  using namespace mxnet_op;
+  const MultiAdamParam& p = nnvm::get<MultiAdamParam>(attrs.parsed);
+  Stream<xpu>* s = ctx.get_stream<xpu>();
+  MSHADOW_REAL_TYPE_SWITCH(outputs[0].type_flag_, DType, {
+    using MPDType = typename MPTypeChooser<DType>::type;
+    // parameter lists longer than the kernel argument block are chained
+    // through back-to-back launches, still one op invocation overall
+    constexpr int N = MultiAdamKernelParam<DType, MPDType>::N;
+    for (int first = 0; first < p.num_weights; first += N) {
+      const int count = std::min(N, p.num_weights - first);
+      MultiAdamKernelParam<DType, MPDType> param =
+        FillMultiAdamKernelParam<xpu, DType, MPDType, input_stride>(
+          attrs, ctx, inputs, outputs, first, count);
+      Kernel<MultiAdamKernel<MPDType, !std::is_same<DType, MPDType>::value>,
+             xpu>::Launch(s, param.max_size, param, req[0]);
+    }
+  });
+}
+
 struct SGDKernel {
   template<typename DType>
   MSHADOW_XINLINE static void Map(int i, DType* out_data, const DType* weight_data,
@@ -1338,6 +1497,59 @@ inline void AdamUpdate(const nnvm::NodeAttrs& attrs,
   });
 }
 
+struct MP_AdamKernel {
+  template<typename DType>
+  MSHADOW_XINLINE static void Map(int i, DType* out_data, float* mean_data,
+    float* var_data, const DType* weight_data, const DType* grad_data, float* weight32,
+    const float clip_gradient, const float rescale_grad,
+    const float beta1, const float beta2,
+    const float lr, const float wd,
+    const float epsilon, const OpReqType req) {
+    using namespace mshadow_op;
+
+    float w = weight32[i];
+    float grad_rescaled = static_cast<float>(grad_data[i]) * rescale_grad + w * wd;
+    if (clip_gradient >= 0.f) {
+      grad_rescaled = clip::Map(grad_rescaled, clip_gradient);
+    }
+
+    float mean = beta1 * mean_data[i] + (1.f - beta1) * grad_rescaled;
+    float var = beta2 * var_data[i] + (1.f - beta2) * grad_rescaled * grad_rescaled;
+    mean_data[i] = mean;
+    var_data[i] = var;
+
+    w = w - lr * mean / (square_root::Map(var) + epsilon);
+    weight32[i] = w;
+    KERNEL_ASSIGN(out_data[i], req, (DType)w);
+  }
+};
+
+template<typename xpu>
+inline void MP_AdamUpdate(const nnvm::NodeAttrs& attrs,
+                          const OpContext &ctx,
+                          const std::vector<TBlob> &inputs,
+                          const std::vector<OpReqType> &req,
+                          const std::vector<TBlob> &outputs) {
+  using namespace mxnet_op;
+  const AdamParam& param = nnvm::get<AdamParam>(attrs.parsed);
+  Stream<xpu>* s = ctx.get_stream<xpu>();
+  MSHADOW_REAL_TYPE_SWITCH(inputs[0].type_flag_, DType, {
+    Tensor<xpu, 2, DType> weight = inputs[0].FlatTo2D<xpu, DType>(s);
+    Tensor<xpu, 2, DType> grad = inputs[1].FlatTo2D<xpu, DType>(s);
+    Tensor<xpu, 2, float> mean = inputs[2].FlatTo2D<xpu, float>(s);
+    Tensor<xpu, 2, float> var = inputs[3].FlatTo2D<xpu, float>(s);
+    Tensor<xpu, 2, float> weight32 = inputs[4].FlatTo2D<xpu, float>(s);
+    Tensor<xpu, 2, DType> out = outputs[0].FlatTo2D<xpu, DType>(s);
+
+    Kernel<MP_AdamKernel, xpu>::Launch(s, weight.shape_.Size(),
+          out.dptr_, mean.dptr_, var.dptr_, weight.dptr_, grad.dptr_, weight32.dptr_,
+          param.clip_gradient, param.rescale_grad,
+          param.beta1, param.beta2,
+          param.lr, param.wd,
+          param.epsilon, req[0]);
+  });
+}
+
 template<int req, typename xpu>
 struct AdamDnsRspDnsKernel;
 
@@ -33,6 +33,7 @@ DMLC_REGISTER_PARAMETER(SGDParam);
 DMLC_REGISTER_PARAMETER(SGDMomParam);
 DMLC_REGISTER_PARAMETER(MultiSGDParam);
 DMLC_REGISTER_PARAMETER(MultiSGDMomParam);
+DMLC_REGISTER_PARAMETER(MultiAdamParam);
 DMLC_REGISTER_PARAMETER(FTMLParam);
 DMLC_REGISTER_PARAMETER(AdamParam);
 DMLC_REGISTER_PARAMETER(NAGParam);
@@ -505,6 +506,113 @@ Where the parameter ``momentum`` is the decay rate of momentum estimates at each
 .add_argument("data", "NDArray-or-Symbol[]", "Weights")
 .add_arguments(MultiSGDMomParam::__FIELDS__());
 
+NNVM_REGISTER_OP(multi_adam_update)
+.describe(R"code(Update function for Adam optimizer operating on a whole list of
+weights at once, amortizing the kernel launch overhead of per-tensor updates.
+
+For each weight in the list the update is the same as ``adam_update``::
+
+ rescaled_grad = clip(rescale_grad * grad + wd * weight, clip_gradient)
+ m = beta1 * m + (1 - beta1) * rescaled_grad
+ v = beta2 * v + (1 - beta2) * (rescaled_grad**2)
+ w = w - learning_rate * m / (sqrt(v) + epsilon)
+
+Bias correction is expected to be folded into the per-weight learning rates.
+
+)code" ADD_FILELINE)
+.set_num_inputs([](const nnvm::NodeAttrs& attrs) {
+    const MultiAdamParam& param = dmlc::get<MultiAdamParam>(attrs.parsed);
+    return static_cast<uint32_t>(param.num_weights * 4);
+  })
+.set_num_outputs([](const nnvm::NodeAttrs& attrs) {
+    const MultiAdamParam& param = dmlc::get<MultiAdamParam>(attrs.parsed);
+    return static_cast<uint32_t>(param.num_weights);
+  })
+.set_attr_parser(ParamParser<MultiAdamParam>)
+.set_attr<mxnet::FInferShape>("FInferShape", MultiSGDShape<MultiAdamParam, 4>)
+.set_attr<nnvm::FInferType>("FInferType", ElemwiseType<-1, -1>)
+.set_attr<nnvm::FListInputNames>("FListInputNames",
+  [](const NodeAttrs& attrs) {
+    uint32_t num_args = dmlc::get<MultiAdamParam>(attrs.parsed).num_weights;
+    std::vector<std::string> ret;
+    for (uint32_t i = 0; i < num_args; ++i) {
+      ret.push_back(std::string("weight_") + std::to_string(i));
+      ret.push_back(std::string("grad_") + std::to_string(i));
+      ret.push_back(std::string("mean_") + std::to_string(i));
+      ret.push_back(std::string("var_") + std::to_string(i));
+    }
+    return ret;
+  })
+.set_attr<nnvm::FMutateInputs>("FMutateInputs",
+  [](const nnvm::NodeAttrs& attrs) {
+    std::vector<uint32_t> ret;
+    const MultiAdamParam& param = dmlc::get<MultiAdamParam>(attrs.parsed);
+    for (int i = 0; i < param.num_weights; ++i) {
+      ret.push_back(i * 4 + 2);
+      ret.push_back(i * 4 + 3);
+    }
+    return ret;
+  })
+.set_attr<FCompute>("FCompute<cpu>", MultiAdamUpdate<cpu, type_identity, 4>)
+.add_argument("data", "NDArray-or-Symbol[]", "Weights, gradients, means and variances")
+.add_arguments(MultiAdamParam::__FIELDS__());
+
+NNVM_REGISTER_OP(multi_mp_adam_update)
+.describe(R"code(Update function for multi-precision Adam optimizer operating on a
+whole list of weights at once, amortizing the kernel launch overhead of per-tensor
+updates.
+
+The moments and the master copy of the weights are kept in float32 while weights
+and gradients may be float16. For each weight in the list the update is the same
+as ``adam_update``::
+
+ rescaled_grad = clip(rescale_grad * grad + wd * weight, clip_gradient)
+ m = beta1 * m + (1 - beta1) * rescaled_grad
+ v = beta2 * v + (1 - beta2) * (rescaled_grad**2)
+ w = w - learning_rate * m / (sqrt(v) + epsilon)
+
+Bias correction is expected to be folded into the per-weight learning rates.
+
+)code" ADD_FILELINE)
+.set_num_inputs([](const nnvm::NodeAttrs& attrs) {
+    const MultiAdamParam& param = dmlc::get<MultiAdamParam>(attrs.parsed);
+    return static_cast<uint32_t>(param.num_weights * 5);
+  })
+.set_num_outputs([](const nnvm::NodeAttrs& attrs) {
+    const MultiAdamParam& param = dmlc::get<MultiAdamParam>(attrs.parsed);
+    return static_cast<uint32_t>(param.num_weights);
+  })
+.set_attr_parser(ParamParser<MultiAdamParam>)
+.set_attr<mxnet::FInferShape>("FInferShape", MultiSGDShape<MultiAdamParam, 5>)
+.set_attr<nnvm::FInferType>("FInferType", MP_MultiSGD_InferType<MultiAdamParam, 5, 3>)
+.set_attr<nnvm::FListInputNames>("FListInputNames",
+  [](const NodeAttrs& attrs) {
+    uint32_t num_args = dmlc::get<MultiAdamParam>(attrs.parsed).num_weights;
+    std::vector<std::string> ret;
+    for (uint32_t i = 0; i < num_args; ++i) {
+      ret.push_back(std::string("weight_") + std::to_string(i));
+      ret.push_back(std::string("grad_") + std::to_string(i));
+      ret.push_back(std::string("mean_") + std::to_string(i));
+      ret.push_back(std::string("var_") + std::to_string(i));
+      ret.push_back(std::string("weight32_") + std::to_string(i));
+    }
+    return ret;
+  })
+.set_attr<nnvm::FMutateInputs>("FMutateInputs",
+  [](const nnvm::NodeAttrs& attrs) {
+    std::vector<uint32_t> ret;
+    const MultiAdamParam& param = dmlc::get<MultiAdamParam>(attrs.parsed);
+    for (int i = 0; i < param.num_weights; ++i) {
+      ret.push_back(i * 5 + 2);
+      ret.push_back(i * 5 + 3);
+      ret.push_back(i * 5 + 4);
+    }
+    return ret;
+  })
+.set_attr<FCompute>("FCompute<cpu>", MultiAdamUpdate<cpu, single_precision, 5>)
+.add_argument("data", "NDArray-or-Symbol[]", "Weights")
+.add_arguments(MultiAdamParam::__FIELDS__());
+
 NNVM_REGISTER_OP(sgd_update)
 MXNET_ADD_SPARSE_OP_ALIAS(sgd_update)
 .describe(R"code(Update function for Stochastic Gradient Descent (SGD) optimizer.
@@ -706,6 +814,38 @@ only the row slices whose indices appear in grad.indices are updated (for w, m a
 .add_argument("var", "NDArray-or-Symbol", "Moving variance")
 .add_arguments(AdamParam::__FIELDS__());
 
+NNVM_REGISTER_OP(mp_adam_update)
+.describe(R"code(Update function for multi-precision Adam optimizer.
+
+The moments and the master copy of the weights are kept in float32 while weight
+and gradient may be float16. The update is applied to the float32 master weight
+and the result is cast back to the weight's type in the same pass, so no
+separate cast operations are needed::
+
+ rescaled_grad = clip(rescale_grad * grad + wd * weight32, clip_gradient)
+ m = beta1 * m + (1 - beta1) * rescaled_grad
+ v = beta2 * v + (1 - beta2) * (rescaled_grad**2)
+ weight32 = weight32 - learning_rate * m / (sqrt(v) + epsilon)
+ weight = weight32
+
+)code" ADD_FILELINE)
+.set_num_inputs(5)
+.set_num_outputs(1)
+.set_attr_parser(ParamParser<AdamParam>)
+.set_attr<mxnet::FInferShape>("FInferShape", ElemwiseShape<5, 1>)
+.set_attr<nnvm::FInferType>("FInferType", MP_InferType<2, 1, 5>)
+.set_attr<nnvm::FMutateInputs>("FMutateInputs",
+  [](const nnvm::NodeAttrs& attrs) {
+    return std::vector<uint32_t>{2, 3, 4};
+  })
+.set_attr<FCompute>("FCompute<cpu>", MP_AdamUpdate<cpu>)
+.add_argument("weight", "NDArray-or-Symbol", "Weight")
+.add_argument("grad", "NDArray-or-Symbol", "Gradient")
+.add_argument("mean", "NDArray-or-Symbol", "Moving mean")
+.add_argument("var", "NDArray-or-Symbol", "Moving variance")
+.add_argument("weight32", "NDArray-or-Symbol", "Weight32")
+.add_arguments(AdamParam::__FIELDS__());
+
 
 NNVM_REGISTER_OP(nag_mom_update)
 .describe(R"code(Update function for Nesterov Accelerated Gradient( NAG) optimizer.
@@ -0,0 +1,55 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Copyright (c) 2020 by Contributors
+ * \file quantile_sketch-inl.h
+ * \brief Streaming KLL quantile sketch for calibration and drift monitoring
+ */
+#ifndef MXNET_OPERATOR_QUANTIZATION_QUANTILE_SKETCH_INL_H_
+#define MXNET_OPERATOR_QUANTIZATION_QUANTILE_SKETCH_INL_H_
+
+#include <vector>
+#include "../mxnet_op.h"
+#include "./quantization_utils.h"
+
+namespace mxnet {
+namespace op {
+
+/*
+ * Sketch buffer layout, float32 with shape (num_levels + 1, k):
+ *   row 0 is the header: header[0] is the total number of items observed,
+ *   header[1 + l] is the number of valid items in level l.
+ *   row 1 + l holds level l's items left-justified; an item at level l
+ *   represents 2^l original values.
+ * A zeroed buffer is an empty sketch.
+ */
+
+struct QuantileSketchQueryParam : public dmlc::Parameter<QuantileSketchQueryParam> {
+  mxnet::Tuple<float> quantiles;
+  DMLC_DECLARE_PARAMETER(QuantileSketchQueryParam) {
+    DMLC_DECLARE_FIELD(quantiles)
+      .describe("The rank fractions in [0, 1] to estimate, e.g. (0.001, 0.999) "
+                "for calibration thresholds or (0.5,) for drift monitoring.");
+  }
+};
+
+}  // namespace op
+}  // namespace mxnet
+#endif  // MXNET_OPERATOR_QUANTIZATION_QUANTILE_SKETCH_INL_H_
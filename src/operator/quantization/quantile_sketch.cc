@@ -0,0 +1,253 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Copyright (c) 2020 by Contributors
+ * \file quantile_sketch.cc
+ * \brief Streaming KLL quantile sketch for calibration and drift monitoring
+ */
+
+#include <algorithm>
+#include <random>
+#include "./quantile_sketch-inl.h"
+
+namespace mxnet {
+namespace op {
+
+DMLC_REGISTER_PARAMETER(QuantileSketchQueryParam);
+
+namespace {
+
+// Compact level l by sorting it and keeping every other item with a random
+// parity, promoting the survivors to level l + 1. Cascades upwards when the
+// next level is also full. Items at the top level are never dropped; the
+// level count bounds the stream length to k * 2^num_levels items.
+void CompactLevel(float* sketch, const int k, const int num_levels, const int l,
+                  std::minstd_rand* rng) {
+  float* header = sketch;
+  float* level = sketch + (l + 1) * k;
+  int size = static_cast<int>(header[1 + l]);
+  if (size < 2) return;
+  if (l + 1 >= num_levels) {
+    LOG(FATAL) << "quantile sketch overflow: the stream is too long for "
+               << num_levels << " levels of capacity " << k;
+  }
+  std::sort(level, level + size);
+  const int parity = static_cast<int>((*rng)()) & 1;
+  float* next = sketch + (l + 2) * k;
+  int next_size = static_cast<int>(header[2 + l]);
+  for (int i = parity; i < size; i += 2) {
+    if (next_size == k) {
+      header[2 + l] = next_size;
+      CompactLevel(sketch, k, num_levels, l + 1, rng);
+      next_size = static_cast<int>(header[2 + l]);
+    }
+    next[next_size++] = level[i];
+  }
+  header[1 + l] = 0;
+  header[2 + l] = next_size;
+}
+
+}  // namespace
+
+void QuantileSketchUpdateCPU(const nnvm::NodeAttrs& attrs, const OpContext& ctx,
+                             const std::vector<TBlob>& inputs,
+                             const std::vector<OpReqType>& req,
+                             const std::vector<TBlob>& outputs) {
+  const auto& data = inputs[0];
+  const auto& in_sketch = inputs[1];
+  const auto& out_sketch = outputs[0];
+  const int num_levels = in_sketch.shape_[0] - 1;
+  const int k = in_sketch.shape_[1];
+  CHECK_GE(num_levels, 2) << "sketch needs at least two levels";
+  float* sketch = out_sketch.dptr<float>();
+  if (req[0] != kWriteInplace) {
+    std::copy(in_sketch.dptr<float>(), in_sketch.dptr<float>() + in_sketch.Size(), sketch);
+  }
+  float* header = sketch;
+  float* level0 = sketch + k;
+  int size0 = static_cast<int>(header[1]);
+  // seed from the running count so replayed streams produce identical sketches
+  std::minstd_rand rng(static_cast<uint32_t>(header[0]) + 1);
+  MSHADOW_REAL_TYPE_SWITCH(data.type_flag_, DType, {
+    const DType* in = data.dptr<DType>();
+    const size_t n = data.Size();
+    for (size_t i = 0; i < n; ++i) {
+      if (size0 == k) {
+        header[1] = size0;
+        CompactLevel(sketch, k, num_levels, 0, &rng);
+        size0 = static_cast<int>(header[1]);
+      }
+      level0[size0++] = static_cast<float>(in[i]);
+    }
+    header[0] += static_cast<float>(n);
+    header[1] = size0;
+  });
+}
+
+void QuantileSketchQueryCPU(const nnvm::NodeAttrs& attrs, const OpContext& ctx,
+                            const std::vector<TBlob>& inputs,
+                            const std::vector<OpReqType>& req,
+                            const std::vector<TBlob>& outputs) {
+  const auto& param = nnvm::get<QuantileSketchQueryParam>(attrs.parsed);
+  const auto& in_sketch = inputs[0];
+  const int num_levels = in_sketch.shape_[0] - 1;
+  const int k = in_sketch.shape_[1];
+  const float* sketch = in_sketch.dptr<float>();
+  const float* header = sketch;
+  float* out = outputs[0].dptr<float>();
+
+  // gather (value, weight) pairs; an item at level l stands for 2^l values
+  std::vector<std::pair<float, float>> items;
+  for (int l = 0; l < num_levels; ++l) {
+    const int size = static_cast<int>(header[1 + l]);
+    const float weight = static_cast<float>(1 << l);
+    const float* level = sketch + (l + 1) * k;
+    for (int i = 0; i < size; ++i) {
+      items.emplace_back(level[i], weight);
+    }
+  }
+  const index_t num_quantiles = param.quantiles.ndim();
+  if (items.empty()) {
+    for (index_t i = 0; i < num_quantiles; ++i) out[i] = 0.f;
+    return;
+  }
+  std::sort(items.begin(), items.end());
+  float total = 0.f;
+  for (const auto& it : items) total += it.second;
+  for (index_t i = 0; i < num_quantiles; ++i) {
+    const float q = param.quantiles[i];
+    CHECK(q >= 0.f && q <= 1.f) << "quantile " << q << " is out of [0, 1]";
+    const float target = q * total;
+    float cum = 0.f;
+    float value = items.back().first;
+    for (const auto& it : items) {
+      cum += it.second;
+      if (cum >= target) {
+        value = it.first;
+        break;
+      }
+    }
+    out[i] = value;
+  }
+}
+
+static inline bool QuantileSketchUpdateShape(const nnvm::NodeAttrs& attrs,
+                                             std::vector<TShape>* in_attrs,
+                                             std::vector<TShape>* out_attrs) {
+  CHECK_EQ(in_attrs->size(), 2U);
+  CHECK_EQ(out_attrs->size(), 1U);
+  if (!shape_is_none(in_attrs->at(1))) {
+    CHECK_EQ(in_attrs->at(1).ndim(), 2U) << "sketch must be 2D (num_levels + 1, k)";
+  }
+  SHAPE_ASSIGN_CHECK(*out_attrs, 0, in_attrs->at(1));
+  SHAPE_ASSIGN_CHECK(*in_attrs, 1, out_attrs->at(0));
+  return (!shape_is_none(in_attrs->at(0))) && (!shape_is_none(in_attrs->at(1)));
+}
+
+static inline bool QuantileSketchUpdateType(const nnvm::NodeAttrs& attrs,
+                                            std::vector<int>* in_attrs,
+                                            std::vector<int>* out_attrs) {
+  CHECK_EQ(in_attrs->size(), 2U);
+  CHECK_EQ(out_attrs->size(), 1U);
+  TYPE_ASSIGN_CHECK(*in_attrs, 1, mshadow::kFloat32);
+  TYPE_ASSIGN_CHECK(*out_attrs, 0, mshadow::kFloat32);
+  return in_attrs->at(0) != -1;
+}
+
+static inline bool QuantileSketchQueryShape(const nnvm::NodeAttrs& attrs,
+                                            std::vector<TShape>* in_attrs,
+                                            std::vector<TShape>* out_attrs) {
+  const auto& param = nnvm::get<QuantileSketchQueryParam>(attrs.parsed);
+  CHECK_EQ(in_attrs->size(), 1U);
+  CHECK_EQ(out_attrs->size(), 1U);
+  if (!shape_is_none(in_attrs->at(0))) {
+    CHECK_EQ(in_attrs->at(0).ndim(), 2U) << "sketch must be 2D (num_levels + 1, k)";
+  }
+  SHAPE_ASSIGN_CHECK(*out_attrs, 0, TShape(1, param.quantiles.ndim()));
+  return !shape_is_none(in_attrs->at(0));
+}
+
+static inline bool QuantileSketchQueryType(const nnvm::NodeAttrs& attrs,
+                                           std::vector<int>* in_attrs,
+                                           std::vector<int>* out_attrs) {
+  CHECK_EQ(in_attrs->size(), 1U);
+  CHECK_EQ(out_attrs->size(), 1U);
+  TYPE_ASSIGN_CHECK(*in_attrs, 0, mshadow::kFloat32);
+  TYPE_ASSIGN_CHECK(*out_attrs, 0, mshadow::kFloat32);
+  return true;
+}
+
+NNVM_REGISTER_OP(_contrib_quantile_sketch_update)
+.describe(R"code(Merge the values of `data` into a streaming KLL quantile sketch.
+
+The sketch is a float32 array of shape (num_levels + 1, k); a zeroed array is
+an empty sketch. Each call folds one batch of activations into the sketch in a
+single pass, so calibration data or production traffic can be summarized
+alongside inference without retaining the activations. Use
+``_contrib_quantile_sketch_query`` to read quantile estimates back out.
+
+The update runs in place when the output shares storage with the sketch input.
+
+.. Note::
+    This operator only supports forward propagation. DO NOT use it in training.)code" ADD_FILELINE)
+.set_num_inputs(2)
+.set_num_outputs(1)
+.set_attr<nnvm::FListInputNames>("FListInputNames", [](const NodeAttrs& attrs) {
+  return std::vector<std::string>{"data", "sketch"};
+})
+.set_attr<nnvm::FListOutputNames>("FListOutputNames", [](const NodeAttrs& attrs) {
+  return std::vector<std::string>{"out_sketch"};
+})
+.set_attr<nnvm::FInplaceOption>("FInplaceOption", [](const NodeAttrs& attrs) {
+  return std::vector<std::pair<int, int>>{{1, 0}};
+})
+.set_attr<mxnet::FInferShape>("FInferShape", QuantileSketchUpdateShape)
+.set_attr<nnvm::FInferType>("FInferType", QuantileSketchUpdateType)
+.set_attr<FCompute>("FCompute<cpu>", QuantileSketchUpdateCPU)
+.add_argument("data", "NDArray-or-Symbol", "Values to merge into the sketch")
+.add_argument("sketch", "NDArray-or-Symbol", "A ndarray/symbol of type `float32`");
+
+NNVM_REGISTER_OP(_contrib_quantile_sketch_query)
+.describe(R"code(Estimate quantiles from a KLL sketch built by
+``_contrib_quantile_sketch_update``.
+
+Returns one estimate per entry of `quantiles`. The rank error is roughly
+O(1/k) of the stream length, which is ample both for int8 calibration
+thresholds and for drift monitoring of activation distributions.
+
+.. Note::
+    This operator only supports forward propagation. DO NOT use it in training.)code" ADD_FILELINE)
+.set_attr_parser(ParamParser<QuantileSketchQueryParam>)
+.set_num_inputs(1)
+.set_num_outputs(1)
+.set_attr<nnvm::FListInputNames>("FListInputNames", [](const NodeAttrs& attrs) {
+  return std::vector<std::string>{"sketch"};
+})
+.set_attr<nnvm::FListOutputNames>("FListOutputNames", [](const NodeAttrs& attrs) {
+  return std::vector<std::string>{"quantile_values"};
+})
+.set_attr<mxnet::FInferShape>("FInferShape", QuantileSketchQueryShape)
+.set_attr<nnvm::FInferType>("FInferType", QuantileSketchQueryType)
+.set_attr<FCompute>("FCompute<cpu>", QuantileSketchQueryCPU)
+.add_argument("sketch", "NDArray-or-Symbol", "A ndarray/symbol of type `float32`")
+.add_arguments(QuantileSketchQueryParam::__FIELDS__());
+
+}  // namespace op
+}  // namespace mxnet
@@ -26,6 +26,7 @@
 
 #include <mxnet/base.h>
 #include <algorithm>
+#include <limits>
 #include "../mxnet_op.h"
 #include "../tensor/broadcast_reduce_op.h"
 
@@ -192,6 +193,37 @@ inline size_t ConfigReduce(mshadow::Stream<xpu>* s,
   return broadcast::ReduceWorkspaceSize<NDim, DType>(s, *dst_shape, kWriteTo, *src_shape);
 }
 
+/*!
+ * \brief Find the minimum and maximum of a dense array in a single pass.
+ *
+ * The uncalibrated (dynamic) quantization paths need the data range of every
+ * batch. Two separate reductions walk the tensor twice; this helper computes
+ * both bounds in one scan on CPU.
+ */
+template<typename DType>
+inline void FindMinMax(const DType *data, const size_t size,
+                       DType *min_out, DType *max_out) {
+  DType data_min = std::numeric_limits<DType>::max();
+  DType data_max = std::numeric_limits<DType>::lowest();
+  #pragma omp parallel num_threads(engine::OpenMP::Get()->GetRecommendedOMPThreadCount())
+  {
+    DType thread_min = data_min;
+    DType thread_max = data_max;
+    #pragma omp for nowait
+    for (index_t i = 0; i < static_cast<index_t>(size); ++i) {
+      thread_min = Min(thread_min, data[i]);
+      thread_max = Max(thread_max, data[i]);
+    }
+    #pragma omp critical
+    {
+      data_min = Min(data_min, thread_min);
+      data_max = Max(data_max, thread_max);
+    }
+  }
+  *min_out = data_min;
+  *max_out = data_max;
+}
+
 enum QuantizeOutType { kAuto = 0, kInt8, kUint8 };
 
 template<typename Param>
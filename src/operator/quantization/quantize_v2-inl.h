@@ -191,6 +191,24 @@ class QuantizeV2Operator {
         } else {
           LOG(FATAL) << "quantize op only supports int8 and uint8 as output type";
         }
+      } else if (std::is_same<xpu, cpu>::value) {
+        // dynamic quantization: the range is found in a single fused scan
+        // instead of launching one reduction per bound for every batch
+        float data_min, data_max;
+        FindMinMax(inputs[0].dptr<SrcDType>(), inputs[0].Size(), &data_min, &data_max);
+        if (out_type == mshadow::kUint8) {
+          Kernel<quantize_v2_unsigned, xpu>::Launch(
+              s, outputs[0].Size(), outputs[0].dptr<uint8_t>(), outputs[1].dptr<float>(),
+              outputs[2].dptr<float>(), inputs[0].dptr<SrcDType>(), data_min, data_max,
+              MinValue<uint8_t>(), MaxValue<uint8_t>());
+        } else if (out_type == mshadow::kInt8) {  // zero-centered quantization
+          Kernel<quantize_v2_zero_centered, xpu>::Launch(
+              s, outputs[0].Size(), outputs[0].dptr<int8_t>(), outputs[1].dptr<float>(),
+              outputs[2].dptr<float>(), inputs[0].dptr<SrcDType>(), data_min, data_max,
+              MinAbs(MaxValue<int8_t>(), MinValue<int8_t>()));
+        } else {
+          LOG(FATAL) << "quantize op only supports int8 and uint8 as output type";
+        }
       } else {  // model is not calibrated
         mxnet::TShape src_shape, dst_shape;
         const size_t actual_float_size = sizeof(float);
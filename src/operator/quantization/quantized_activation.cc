@@ -22,12 +22,20 @@
  * \file quantized_activation.cc
 */
 #include <mxnet/op_attr_types.h>
+#include <cmath>
 #include "../nn/activation-inl.h"
 #include "../elemwise_op_common.h"
+#include "./quantization_utils.h"
 
 namespace mxnet {
 namespace op {
 
+inline bool QuantizedActivationSupported(const ActivationParam& param) {
+  return param.act_type == activation::kReLU ||
+         param.act_type == activation::kSigmoid ||
+         param.act_type == activation::kTanh;
+}
+
 bool QuantizedActivationShape(const nnvm::NodeAttrs& attrs,
                               std::vector<TShape> *in_shape,
                               std::vector<TShape> *out_shape) {
@@ -50,8 +58,12 @@ bool QuantizedActivationType(const nnvm::NodeAttrs& attrs,
   CHECK_EQ(out_type->size(), 3U);
   if (param.act_type == activation::kReLU) {
     TYPE_ASSIGN_CHECK(*out_type, 0, mshadow::kInt8);
+  } else if (QuantizedActivationSupported(param)) {
+    // the lookup-table kernel only handles the zero-centered int8 layout
+    TYPE_ASSIGN_CHECK(*in_type, 0, mshadow::kInt8);
+    TYPE_ASSIGN_CHECK(*out_type, 0, mshadow::kInt8);
   } else {
-    LOG(FATAL) << "_contrib_quantized_act only supports act_type=relu for now";
+    LOG(FATAL) << "_contrib_quantized_act only supports act_type=relu/sigmoid/tanh for now";
   }
   TYPE_ASSIGN_CHECK(*in_type, 1, mshadow::kFloat32);
   TYPE_ASSIGN_CHECK(*in_type, 2, mshadow::kFloat32);
@@ -81,6 +93,50 @@ inline static bool QuantizedActivationStorageType(const nnvm::NodeAttrs &attrs,
   return true;
 }
 
+static void QuantizedActivationForwardCPU(const nnvm::NodeAttrs& attrs,
+                                          const OpContext& ctx,
+                                          const std::vector<TBlob>& inputs,
+                                          const std::vector<OpReqType>& req,
+                                          const std::vector<TBlob>& outputs) {
+  using mshadow::red::limits::MaxValue;
+  using mshadow::red::limits::MinValue;
+  const ActivationParam& param = nnvm::get<ActivationParam>(attrs.parsed);
+  CHECK_EQ(inputs[0].type_flag_, mshadow::kInt8)
+    << "native quantized activation only supports int8 input";
+  const int8_t *in = inputs[0].dptr<int8_t>();
+  int8_t *out = outputs[0].dptr<int8_t>();
+  const index_t size = static_cast<index_t>(inputs[0].Size());
+  const int omp_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+  const float quantized_range = MinAbs(MaxValue<int8_t>(), MinValue<int8_t>());
+  if (param.act_type == activation::kReLU) {
+    // relu is monotonic and keeps zero at zero, so the input scale carries over
+    #pragma omp parallel for num_threads(omp_threads)
+    for (index_t i = 0; i < size; ++i) {
+      out[i] = in[i] > 0 ? in[i] : 0;
+    }
+    outputs[1].dptr<float>()[0] = inputs[1].dptr<float>()[0];
+    outputs[2].dptr<float>()[0] = inputs[2].dptr<float>()[0];
+  } else {
+    // sigmoid/tanh saturate into [-1, 1], so the output is int8 with a fixed
+    // range and the non-linearity collapses into a 256-entry lookup table
+    const float data_absmax = MaxAbs(inputs[1].dptr<float>()[0], inputs[2].dptr<float>()[0]);
+    const float in_scale = data_absmax / quantized_range;
+    int8_t lut[256];
+    for (int q = -128; q <= 127; ++q) {
+      const float x = q * in_scale;
+      const float y = (param.act_type == activation::kSigmoid) ?
+          1.f / (1.f + std::exp(-x)) : std::tanh(x);
+      lut[q + 128] = static_cast<int8_t>(std::round(y * quantized_range));
+    }
+    #pragma omp parallel for num_threads(omp_threads)
+    for (index_t i = 0; i < size; ++i) {
+      out[i] = lut[in[i] + 128];
+    }
+    outputs[1].dptr<float>()[0] = -1.f;
+    outputs[2].dptr<float>()[0] = 1.f;
+  }
+}
+
 NNVM_REGISTER_OP(_contrib_quantized_act)
 .describe(R"code(Activation operator for input and output data type of int8.
 The input and output data comes with min and max thresholds for quantizing
@@ -88,7 +144,7 @@ the float32 data into int8.
 
 .. Note::
      This operator only supports forward propogation. DO NOT use it in training.
-     This operator only supports `relu`)code" ADD_FILELINE)
+     This operator only supports `relu`, `sigmoid` and `tanh`)code" ADD_FILELINE)
 .set_num_inputs(3)
 .set_num_outputs(3)
 .set_attr_parser(ParamParser<ActivationParam>)
@@ -103,11 +159,12 @@ the float32 data into int8.
 .set_attr<nnvm::FInferType>("FInferType", QuantizedActivationType)
 .set_attr<mxnet::FInferShape>("FInferShape", QuantizedActivationShape)
 .set_attr<FInferStorageType>("FInferStorageType", QuantizedActivationStorageType)
+.set_attr<FCompute>("FCompute<cpu>", QuantizedActivationForwardCPU)
 .set_attr<FNeedRequantize>("FNeedRequantize",
   [](const NodeAttrs& attrs) {
     const ActivationParam& param = nnvm::get<ActivationParam>(attrs.parsed);
-    CHECK(param.act_type == activation::kReLU)
-      << "_contrib_quantized_act only supports act_type=relu for now";
+    CHECK(QuantizedActivationSupported(param))
+      << "_contrib_quantized_act only supports act_type=relu/sigmoid/tanh for now";
     return false;
   })
 .add_argument("data", "NDArray-or-Symbol", "Input data.")
@@ -120,11 +177,11 @@ NNVM_REGISTER_OP(Activation)
 .set_attr<FQuantizedOp>("FQuantizedOp", [](const NodeAttrs& attrs) {
   const ActivationParam& param = nnvm::get<ActivationParam>(attrs.parsed);
   nnvm::NodePtr node = nnvm::Node::Create();
-  if (param.act_type == activation::kReLU) {
+  if (QuantizedActivationSupported(param)) {
     node->attrs.op = Op::Get("_contrib_quantized_act");
     node->attrs.name = "quantized_" + attrs.name;
   } else {
-    LOG(INFO) << "Currently, quantized activation only supports relu, exclude "
+    LOG(INFO) << "Currently, quantized activation only supports relu/sigmoid/tanh, exclude "
               << attrs.name << " which act_type is " << param.act_type;
     node->attrs.op = nullptr;
     node->attrs.name = attrs.name;
@@ -0,0 +1,187 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2020 by Contributors
+ * \file quantized_broadcast_add.cc
+ * \brief broadcast_add operator for int8 input, keeping residual blocks int8
+*/
+#include "../tensor/elemwise_binary_broadcast_op.h"
+#include "./quantized_elemwise_add-inl.h"
+#include "./quantization_utils.h"
+
+namespace mxnet {
+namespace op {
+
+static bool QuantizedBroadcastAddShape(const nnvm::NodeAttrs& attrs,
+                                       mxnet::ShapeVector* in_shape,
+                                       mxnet::ShapeVector* out_shape) {
+  // A, B, A_min, A_max, B_min, B_max
+  CHECK_EQ(in_shape->size(), 6U);
+  // C, C_min, C_max
+  CHECK_EQ(out_shape->size(), 3U);
+
+  mxnet::ShapeVector data_in = {(*in_shape)[0], (*in_shape)[1]};
+  mxnet::ShapeVector data_out = {(*out_shape)[0]};
+  bool ret = BinaryBroadcastShape(attrs, &data_in, &data_out);
+  SHAPE_ASSIGN_CHECK(*in_shape, 0, data_in[0]);
+  SHAPE_ASSIGN_CHECK(*in_shape, 1, data_in[1]);
+  SHAPE_ASSIGN_CHECK(*out_shape, 0, data_out[0]);
+
+  SHAPE_ASSIGN_CHECK(*in_shape, 2, TShape{1});
+  SHAPE_ASSIGN_CHECK(*in_shape, 3, TShape{1});
+  SHAPE_ASSIGN_CHECK(*in_shape, 4, TShape{1});
+  SHAPE_ASSIGN_CHECK(*in_shape, 5, TShape{1});
+  SHAPE_ASSIGN_CHECK(*out_shape, 1, TShape{1});
+  SHAPE_ASSIGN_CHECK(*out_shape, 2, TShape{1});
+  return ret;
+}
+
+static bool QuantizedBroadcastAddType(const nnvm::NodeAttrs& attrs,
+                                      std::vector<int>* in_type,
+                                      std::vector<int>* out_type) {
+  // A, B, A_min, A_max, B_min, B_max
+  CHECK_EQ(in_type->size(), 6U);
+  // C, C_min, C_max
+  CHECK_EQ(out_type->size(), 3U);
+
+  // the native kernel only supports the zero-centered int8 layout
+  TYPE_ASSIGN_CHECK(*in_type, 0, mshadow::kInt8);
+  TYPE_ASSIGN_CHECK(*in_type, 1, mshadow::kInt8);
+  TYPE_ASSIGN_CHECK(*in_type, 2, mshadow::kFloat32);
+  TYPE_ASSIGN_CHECK(*in_type, 3, mshadow::kFloat32);
+  TYPE_ASSIGN_CHECK(*in_type, 4, mshadow::kFloat32);
+  TYPE_ASSIGN_CHECK(*in_type, 5, mshadow::kFloat32);
+
+  TYPE_ASSIGN_CHECK(*out_type, 0, mshadow::kInt32);
+  TYPE_ASSIGN_CHECK(*out_type, 1, mshadow::kFloat32);
+  TYPE_ASSIGN_CHECK(*out_type, 2, mshadow::kFloat32);
+  return true;
+}
+
+namespace mxnet_op {
+template<int ndim>
+struct quantized_broadcast_add_kernel {
+  MSHADOW_XINLINE static void Map(index_t base, index_t length,
+                                  const Shape<ndim> &lstride, const Shape<ndim> &rstride,
+                                  const Shape<ndim> &oshape, const int8_t *lhs, const int8_t *rhs,
+                                  int32_t *out, const float lhs_scale, const float rhs_scale) {
+    Shape<ndim> coord = unravel(base, oshape);
+    auto lidx = static_cast<index_t>(dot(coord, lstride));
+    auto ridx = static_cast<index_t>(dot(coord, rstride));
+    out[base] = static_cast<int32_t>(lhs[lidx] * lhs_scale + rhs[ridx] * rhs_scale);
+    // starts from 1 to avoid extra inc at end of loop
+    for (index_t i = 1; i < length; ++i) {
+      inc(&coord, oshape, &lidx, lstride, &ridx, rstride);
+      out[base + i] = static_cast<int32_t>(lhs[lidx] * lhs_scale + rhs[ridx] * rhs_scale);
+    }
+  }
+};
+}  // namespace mxnet_op
+
+static void QuantizedBroadcastAddForward(const nnvm::NodeAttrs& attrs,
+                                         const OpContext& ctx,
+                                         const std::vector<TBlob>& inputs,
+                                         const std::vector<OpReqType>& req,
+                                         const std::vector<TBlob>& outputs) {
+  using namespace mshadow;
+  using namespace mxnet_op;
+  using quantized_elemwise_add_enum::kAMax;
+  using quantized_elemwise_add_enum::kAMin;
+  using quantized_elemwise_add_enum::kBMax;
+  using quantized_elemwise_add_enum::kBMin;
+  Stream<cpu> *s = ctx.get_stream<cpu>();
+
+  const float lhs_absmax = MaxAbs(inputs[kAMin].dptr<float>()[0], inputs[kAMax].dptr<float>()[0]);
+  const float rhs_absmax = MaxAbs(inputs[kBMin].dptr<float>()[0], inputs[kBMax].dptr<float>()[0]);
+  // the sum of the two input ranges bounds the float result, so the output
+  // is zero-centered int32 over that combined range like quantized_elemwise_add
+  const float out_absmax = lhs_absmax + rhs_absmax;
+  const float lhs_scale = (lhs_absmax / kInt8Range) * (kInt32Range / out_absmax);
+  const float rhs_scale = (rhs_absmax / kInt8Range) * (kInt32Range / out_absmax);
+  outputs[1].dptr<float>()[0] = -out_absmax;
+  outputs[2].dptr<float>()[0] = out_absmax;
+
+  if (outputs[0].shape_.Size() == 0U) return;
+  mxnet::TShape new_lshape, new_rshape, new_oshape;
+  int ndim = BinaryBroadcastShapeCompact(inputs[0].shape_, inputs[1].shape_, outputs[0].shape_,
+                                         &new_lshape, &new_rshape, &new_oshape);
+  if (!ndim) {
+    new_lshape = new_rshape = new_oshape = mxnet::TShape(1, outputs[0].shape_.Size());
+    ndim = 1;
+  }
+  BROADCAST_NDIM_SWITCH(ndim, NDim, {
+    Shape<NDim> oshape = new_oshape.get<NDim>();
+    Shape<NDim> lstride = calc_stride(new_lshape.get<NDim>());
+    Shape<NDim> rstride = calc_stride(new_rshape.get<NDim>());
+    Kernel<quantized_broadcast_add_kernel<NDim>, cpu>::
+    template LaunchEx(s, new_oshape.Size(), lstride, rstride, oshape,
+    inputs[0].dptr<int8_t>(), inputs[1].dptr<int8_t>(), outputs[0].dptr<int32_t>(),
+    lhs_scale, rhs_scale);
+  });
+}
+
+NNVM_REGISTER_OP(_contrib_quantized_broadcast_add)
+.describe(R"code(broadcast_add operator for input dataA and input dataB data type of int8,
+and accumulates in type int32 for the output. For each argument, two more arguments of type
+float32 must be provided representing the thresholds of quantizing argument from data
+type float32 to int8. The final outputs contain result in int32, and min
+and max thresholds representing the threholds for quantizing the float32 output into int32.
+
+.. Note::
+    This operator only supports forward propogation. DO NOT use it in training.
+
+)code" ADD_FILELINE)
+.set_num_inputs([](const NodeAttrs& attrs) {
+// A, B, A_min, A_max, B_min, B_max
+  return 6;
+})
+// C, C_min, C_max
+.set_num_outputs(3)
+.set_attr<nnvm::FListInputNames>("FListInputNames", [](const NodeAttrs& attrs) {
+  return std::vector<std::string>{"lhs", "rhs", "lhs_min", "lhs_max", "rhs_min", "rhs_max"};
+})
+.set_attr<nnvm::FListOutputNames>("FListOutputNames", [](const NodeAttrs& attrs) {
+  return std::vector<std::string>{"output", "min_output", "max_output"};
+})
+.set_attr<nnvm::FInferType>("FInferType", QuantizedBroadcastAddType)
+.set_attr<mxnet::FInferShape>("FInferShape", QuantizedBroadcastAddShape)
+.set_attr<FCompute>("FCompute<cpu>", QuantizedBroadcastAddForward)
+.set_attr<FNeedRequantize>("FNeedRequantize", [](const NodeAttrs& attrs) { return true; })
+.add_argument("lhs", "NDArray-or-Symbol", "first input")
+.add_argument("rhs", "NDArray-or-Symbol", "second input")
+.add_argument("lhs_min", "NDArray-or-Symbol", "3rd input")
+.add_argument("lhs_max", "NDArray-or-Symbol", "4th input")
+.add_argument("rhs_min", "NDArray-or-Symbol", "5th input")
+.add_argument("rhs_max", "NDArray-or-Symbol", "6th input");
+
+NNVM_REGISTER_OP(broadcast_add)
+.set_attr<FQuantizedOp>("FQuantizedOp", [](const NodeAttrs& attrs) {
+  nnvm::NodePtr node = nnvm::Node::Create();
+  node->attrs.op = Op::Get("_contrib_quantized_broadcast_add");
+  node->attrs.name = "quantized_" + attrs.name;
+  node->attrs.dict = attrs.dict;
+  if (node->op()->attr_parser != nullptr) {
+    node->op()->attr_parser(&(node->attrs));
+  }
+  return node;
+});
+
+}  // namespace op
+}  // namespace mxnet
@@ -26,6 +26,7 @@
 #include "../nn/convolution-inl.h"
 #include "./quantization_utils.h"
 #include "../tensor/matrix_op-inl.h"
+#include "../../common/utils.h"
 
 namespace mxnet {
 namespace op {
@@ -49,6 +50,163 @@ struct QuantizedBiasAddKernel {
   }
 };
 
+// rescale the output range from the input ranges and add the quantized bias;
+// shared by the cuDNN and the native dp4a convolution paths
+static void QuantizedConvRangeAndBias(const ConvolutionParam& param,
+                                      mshadow::Stream<gpu>* s,
+                                      const std::vector<TBlob>& in_data,
+                                      const std::vector<TBlob>& out_data) {
+  const TBlob& out = out_data[0];
+  const mxnet::TShape& oshape = out.shape_;
+  const size_t num_inputs = param.no_bias ? 2 : 3;
+  mxnet_op::Kernel<QuantizationRangeForS8S8MultiplicationStruct, gpu>::Launch(s, 1,
+    out_data[1].dptr<float>(), out_data[2].dptr<float>(),
+     in_data[num_inputs].dptr<float>(),  in_data[num_inputs+1].dptr<float>(),
+     in_data[num_inputs+2].dptr<float>(),  in_data[num_inputs+3].dptr<float>());
+
+  if (!param.no_bias) {
+    if (param.layout.has_value()) {
+      CHECK_EQ(param.layout.value(), mshadow::kNCHW)
+        << "quantized_conv only supports NCHW when there is a bias";
+    }
+    const TBlob& bias = in_data[2];
+    mxnet_op::Kernel<QuantizedBiasAddKernel, gpu>::Launch(s, out.Size(),
+        bias.Size(), out.dptr<int32_t>(), bias.dptr<int8_t>(),
+        out_data[1].dptr<float>(), out_data[2].dptr<float>(),
+        in_data[7].dptr<float>(),  in_data[8].dptr<float>(),
+        oshape[2] * oshape[3]);
+  }
+}
+
+/*!
+ * \brief Direct NHWC int8 convolution, one work item per output element.
+ *  The inner product runs over groups of four input channels packed into
+ *  one 32-bit word, issued as dp4a instructions on sm_61 and newer.
+ */
+struct QuantizedDP4AConvKernel {
+  MSHADOW_XINLINE static void Map(int i, int32_t *out,
+                                  const int8_t *data, const int8_t *filter,
+                                  const int height, const int width,
+                                  const int in_channels,
+                                  const int out_height, const int out_width,
+                                  const int out_channels,
+                                  const int kernel_h, const int kernel_w,
+                                  const int stride_h, const int stride_w,
+                                  const int pad_h, const int pad_w) {
+    const int oc = i % out_channels;
+    const int ow = (i / out_channels) % out_width;
+    const int oh = (i / out_channels / out_width) % out_height;
+    const int n  = i / out_channels / out_width / out_height;
+    const int8_t *frow = filter + oc * kernel_h * kernel_w * in_channels;
+    int32_t acc = 0;
+    for (int kh = 0; kh < kernel_h; ++kh) {
+      const int ih = oh * stride_h - pad_h + kh;
+      if (ih < 0 || ih >= height) continue;
+      for (int kw = 0; kw < kernel_w; ++kw) {
+        const int iw = ow * stride_w - pad_w + kw;
+        if (iw < 0 || iw >= width) continue;
+        const int8_t *dpos = data + ((n * height + ih) * width + iw) * in_channels;
+        const int8_t *fpos = frow + (kh * kernel_w + kw) * in_channels;
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 610
+        const int32_t *d4 = reinterpret_cast<const int32_t*>(dpos);
+        const int32_t *f4 = reinterpret_cast<const int32_t*>(fpos);
+        for (int c = 0; c < in_channels / 4; ++c) {
+          acc = __dp4a(d4[c], f4[c], acc);
+        }
+#else
+        for (int c = 0; c < in_channels; ++c) {
+          acc += static_cast<int32_t>(dpos[c]) * static_cast<int32_t>(fpos[c]);
+        }
+#endif
+      }
+    }
+    out[i] = acc;
+  }
+};
+
+// native int8 path: transpose to NHWC like the cuDNN path, run the direct
+// dp4a kernel, transpose the int32 result back to NCHW
+static void QuantizedDP4AConvForward(const ConvolutionParam& param,
+                                     const OpContext& ctx,
+                                     const std::vector<TBlob>& in_data,
+                                     const std::vector<TBlob>& out_data) {
+  using namespace mshadow;
+  Stream<gpu> *s = ctx.get_stream<gpu>();
+  const TBlob& data   = in_data[0];
+  const TBlob& filter = in_data[1];
+  const TBlob& out    = out_data[0];
+  const mxnet::TShape& dshape = data.shape_;
+  const mxnet::TShape& fshape = filter.shape_;
+  const mxnet::TShape& oshape = out.shape_;
+  const int dev_id = ctx.run_ctx.ctx.dev_id;
+  const int dev_mask = gpu::kDevMask;
+
+  mxnet::TShape stride = param.stride.ndim() == 0U ? mshadow::Shape2(1, 1) : param.stride;
+  mxnet::TShape pad = param.pad.ndim() == 0U ? mshadow::Shape2(0, 0) : param.pad;
+
+  const size_t data_size = dshape.Size();
+  const size_t weight_size = fshape.Size();
+  const size_t output_size = oshape.Size();
+  size_t total_temp_bytes = (data_size + weight_size) * sizeof(int8_t)
+                          + output_size * sizeof(int32_t);
+  Tensor<gpu, 1, char> temp_space =
+    ctx.requested[0].get_space_typed<gpu, 1, char>(mshadow::Shape1(total_temp_bytes), s);
+  char* temp_dptr = temp_space.dptr_;
+  TBlob data_(reinterpret_cast<int8_t*>(temp_dptr),
+              mxnet::TShape({dshape[0], dshape[2], dshape[3], dshape[1]}),
+              dev_mask, DataType<int8_t>::kFlag, dev_id);
+  temp_dptr += data_size * sizeof(int8_t);
+  TBlob filter_(reinterpret_cast<int8_t*>(temp_dptr),
+                mxnet::TShape({fshape[0], fshape[2], fshape[3], fshape[1]}),
+                dev_mask, DataType<int8_t>::kFlag, dev_id);
+  temp_dptr += weight_size * sizeof(int8_t);
+  TBlob out_(reinterpret_cast<int32_t*>(temp_dptr),
+             mxnet::TShape({oshape[0], oshape[2], oshape[3], oshape[1]}),
+             dev_mask, DataType<int32_t>::kFlag, dev_id);
+
+  TransposeImpl<gpu>(ctx.run_ctx, data,   data_,   mxnet::TShape({0, 2, 3, 1}));
+  TransposeImpl<gpu>(ctx.run_ctx, filter, filter_, mxnet::TShape({0, 2, 3, 1}));
+
+  mxnet_op::Kernel<QuantizedDP4AConvKernel, gpu>::Launch(s, output_size,
+      out_.dptr<int32_t>(), data_.dptr<int8_t>(), filter_.dptr<int8_t>(),
+      static_cast<int>(dshape[2]), static_cast<int>(dshape[3]),
+      static_cast<int>(dshape[1]),
+      static_cast<int>(oshape[2]), static_cast<int>(oshape[3]),
+      static_cast<int>(oshape[1]),
+      static_cast<int>(param.kernel[0]), static_cast<int>(param.kernel[1]),
+      static_cast<int>(stride[0]), static_cast<int>(stride[1]),
+      static_cast<int>(pad[0]), static_cast<int>(pad[1]));
+
+  TransposeImpl<gpu>(ctx.run_ctx, out_, out, mxnet::TShape({0, 3, 1, 2}));
+
+  QuantizedConvRangeAndBias(param, s, in_data, out_data);
+}
+
+// whether the direct dp4a kernel handles this convolution; when it does
+// not, the reason is reported so fallbacks never go unnoticed
+static bool QuantizedDP4AConvSupported(const ConvolutionParam& param,
+                                       const mxnet::TShape& dshape,
+                                       std::string* reason) {
+  if (param.layout.has_value() && param.layout.value() != mshadow::kNCHW) {
+    *reason = "layout is not NCHW";
+    return false;
+  }
+  if (param.num_group != 1) {
+    *reason = "grouped convolution";
+    return false;
+  }
+  if (param.dilate.ndim() != 0U && param.dilate.Size() != 1) {
+    *reason = "dilated convolution";
+    return false;
+  }
+  if (dshape[1] % 4 != 0) {
+    *reason = "input channel count " + std::to_string(dshape[1]) +
+              " is not a multiple of 4";
+    return false;
+  }
+  return true;
+}
+
 #if MXNET_USE_CUDNN == 1 && CUDA_VERSION >= 8000
 STATIC_ASSERT_CUDNN_VERSION_GE(6000);
 template<typename SrcType, typename DstType, typename CmpType>
@@ -174,24 +332,7 @@ class QuantizedCuDNNConvOp {
     // calculate the min/max range for out_data as it's a multiplication
     // of in_data[0] and in_data[1]. Need to rescale the min/max range of out_data
     // based on the min/max ranges of in_data[0] and in_data[1].
-    const size_t num_inputs = param_.no_bias ? 2 : 3;
-    mxnet_op::Kernel<QuantizationRangeForS8S8MultiplicationStruct, gpu>::Launch(s, 1,
-      out_data[1].dptr<float>(), out_data[2].dptr<float>(),
-       in_data[num_inputs].dptr<float>(),  in_data[num_inputs+1].dptr<float>(),
-       in_data[num_inputs+2].dptr<float>(),  in_data[num_inputs+3].dptr<float>());
-
-    if (!param_.no_bias) {
-      if (param_.layout.has_value()) {
-        CHECK_EQ(param_.layout.value(), mshadow::kNCHW)
-          << "quantized_conv only supports NCHW when there is a bias";
-      }
-      const TBlob& bias = in_data[2];
-      mxnet_op::Kernel<QuantizedBiasAddKernel, gpu>::Launch(s, out.Size(),
-          bias.Size(), out.dptr<int32_t>(), bias.dptr<int8_t>(),
-          out_data[1].dptr<float>(), out_data[2].dptr<float>(),
-          in_data[7].dptr<float>(),  in_data[8].dptr<float>(),
-          oshape[2] * oshape[3]);
-    }
+    QuantizedConvRangeAndBias(param_, s, in_data, out_data);
   }
 
   void InitDescriptors(const mxnet::ShapeVector& in_shape,
@@ -271,6 +412,16 @@ void QuantizedConvForwardGPU(const nnvm::NodeAttrs& attrs,
   const ConvolutionParam& param = nnvm::get<ConvolutionParam>(attrs.parsed);
   CHECK_EQ(param.kernel.ndim(), 2U)
     << "QuantizedConvForward<gpu> only supports 2D convolution for now";
+  static const bool use_dp4a = dmlc::GetEnv("MXNET_QUANTIZED_CONV_DP4A", false);
+  if (use_dp4a) {
+    std::string reason;
+    if (QuantizedDP4AConvSupported(param, inputs[0].shape_, &reason)) {
+      QuantizedDP4AConvForward(param, ctx, inputs, outputs);
+      return;
+    }
+    common::LogOnce("quantized_conv: native dp4a path requested but not applicable (" +
+                    reason + "), falling back to the cuDNN path");
+  }
 #if MXNET_USE_CUDNN == 1 && CUDA_VERSION >= 8000
   typedef QuantizedCuDNNConvOp<int8_t, float, int32_t> QuantizedConvOpInt8;
 #if DMLC_CXX11_THREAD_LOCAL
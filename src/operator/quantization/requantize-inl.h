@@ -127,6 +127,19 @@ void RequantizeForward(const nnvm::NodeAttrs& attrs,
         outputs[0].dptr<DstDType>(), outputs[1].dptr<float>(), outputs[2].dptr<float>(),
         inputs[0].dptr<SrcDType>(), inputs[1].dptr<float>(), inputs[2].dptr<float>(),
         MaxAbs(param.min_calib_range.value(), param.max_calib_range.value()));
+  } else if (std::is_same<xpu, cpu>::value) {
+    // dynamic requantization: find both bounds of the int32 data in a single
+    // scan and convert them on the host instead of running two reductions
+    SrcDType data_min, data_max;
+    FindMinMax(inputs[0].dptr<SrcDType>(), inputs[0].Size(), &data_min, &data_max);
+    const float actual_min = QuantizedToFloat<SrcDType>(
+        data_min, *inputs[1].dptr<float>(), *inputs[2].dptr<float>());
+    const float actual_max = QuantizedToFloat<SrcDType>(
+        data_max, *inputs[1].dptr<float>(), *inputs[2].dptr<float>());
+    Kernel<RequantizeKernel, xpu>::Launch(s, inputs[0].Size(),
+        outputs[0].dptr<DstDType>(), outputs[1].dptr<float>(), outputs[2].dptr<float>(),
+        inputs[0].dptr<SrcDType>(), inputs[1].dptr<float>(), inputs[2].dptr<float>(),
+        MaxAbs(actual_min, actual_max));
   } else {  // model is not calibrated
     mxnet::TShape src_shape, dst_shape;
     const size_t actual_float_size = sizeof(float);
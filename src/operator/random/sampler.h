@@ -51,6 +51,19 @@ inline static void LaunchRNG(mshadow::Stream<xpu> *s,
   }
   const index_t nloop = (N + RandGenerator<xpu>::kMinNumRandomPerThread - 1) /
                     RandGenerator<xpu>::kMinNumRandomPerThread;
+  // counter-based launches derive a private Philox stream per thread from
+  // (seed, launch ticket, thread id), so the width is not capped by the
+  // shared state array and no state is loaded or stored back
+  static const bool counter_based =
+      dmlc::GetEnv("MXNET_RNG_COUNTER_BASED", false);
+  if (RandGenerator<xpu>::kCounterStreams && counter_based) {
+    RandGenerator<xpu, GType> lgen = *gen;
+    lgen.SetCounterTicket(NextCounterTicket());
+    Kernel<OP, xpu>::Launch(s, nloop, lgen, N,
+        static_cast<index_t>(RandGenerator<xpu>::kMinNumRandomPerThread),
+        args...);
+    return;
+  }
   const index_t nthread = std::min(nloop,
                                    static_cast<index_t>(RandGenerator<xpu>::kNumRandomStates));
   const index_t step = (N + nthread - 1) / nthread;
@@ -1336,7 +1336,20 @@ class RNNOp {
       cudnnDataType_t dtype_with_fallback_ =
         (cudnnGetVersion() >= 7500 && dtype_ == CUDNN_DATA_HALF) ? CUDNN_DATA_FLOAT
                                                              : dtype_;
+      // cudnn's persistent kernels keep the recurrent weights resident on
+      // the SMs across timesteps instead of re-reading them every step.
+      // They only exist on sm60+ and only pay off while the weights fit,
+      // so the static plan is opt-in and limited to small hidden sizes.
+      // The padded-IO sequence length path requires the standard algo.
       cudnnRNNAlgo_t rnn_algo = CUDNN_RNN_ALGO_STANDARD;
+      if (dmlc::GetEnv("MXNET_CUDNN_RNN_USE_PERSISTENT", false) &&
+          !param_.use_sequence_length &&
+          !param_.projection_size.has_value() &&
+          param_.state_size <=
+            dmlc::GetEnv("MXNET_CUDNN_RNN_PERSISTENT_MAX_STATE_SIZE", 256) &&
+          ComputeCapabilityMajor(s->dev_id) >= 6) {
+        rnn_algo = CUDNN_RNN_ALGO_PERSIST_STATIC;
+      }
       dgrad_sync_needed_ = (rnn_algo == CUDNN_RNN_ALGO_STANDARD) && param_.bidirectional;
       CUDNN_CALL(cudnnSetRNNDescriptor_v6(s->dnn_handle_,
                                           rnn_desc_,
@@ -36,6 +36,7 @@
 #include <utility>
 #include <vector>
 #include "./mshadow_op.h"
+#include "./mxnet_op.h"
 #include "./operator_common.h"
 
 namespace mxnet {
@@ -44,7 +45,6 @@ namespace op {
 namespace seq_mask {
 enum SequenceMaskOpInputs { kData, kSequenceLength };
 enum SequenceMaskOpOutputs { kOut };
-enum SequenceMaskOpBackResource { kTempSpace };
 }
 
 struct SequenceMaskParam : public dmlc::Parameter<SequenceMaskParam> {
@@ -65,18 +65,38 @@ struct SequenceMaskParam : public dmlc::Parameter<SequenceMaskParam> {
   }
 };
 
-template<typename DType, typename IType>
-void SequenceMaskExec(const mshadow::Tensor<cpu, 3, DType> &data,
-                  const mshadow::Tensor<cpu, 1, IType> &indices,
-                  const OpReqType req, mshadow::Stream<cpu> *const s,
-                  int axis, DType val);
-#ifdef __CUDACC__
-template<typename DType, typename IType>
-void SequenceMaskExec(const mshadow::Tensor<gpu, 3, DType> &data,
-                  const mshadow::Tensor<gpu, 1, IType> &indices,
-                  const OpReqType req, mshadow::Stream<gpu> *const s,
-                  int axis, DType val);
-#endif
+// Fused copy-and-mask kernels. One launch covers the whole tensor with
+// element-level parallelism and writes each position exactly once, either
+// from the input or with the mask value, instead of copying everything
+// first and masking the padded tail in a second per-batch pass.
+
+// (seqlen, batch, rest) case
+template <int req>
+struct SequenceMask0FusedKernel {
+  template <typename DType, typename IType>
+  MSHADOW_XINLINE static void Map(index_t i, DType *out, const DType *in,
+                                  const IType *idx, index_t batch_size,
+                                  index_t restsize, DType value) {
+    const index_t batch = i / restsize % batch_size;
+    const index_t seq = i / restsize / batch_size;
+    const index_t seqpos = static_cast<index_t>(idx[batch]);
+    KERNEL_ASSIGN(out[i], req, seq < seqpos ? in[i] : value);
+  }
+};
+
+// (batch, seqlen, rest) case
+template <int req>
+struct SequenceMask1FusedKernel {
+  template <typename DType, typename IType>
+  MSHADOW_XINLINE static void Map(index_t i, DType *out, const DType *in,
+                                  const IType *idx, index_t max_s_len,
+                                  index_t restsize, DType value) {
+    const index_t batch = i / restsize / max_s_len;
+    const index_t seq = i / restsize % max_s_len;
+    const index_t seqpos = static_cast<index_t>(idx[batch]);
+    KERNEL_ASSIGN(out[i], req, seq < seqpos ? in[i] : value);
+  }
+};
 
 template <typename xpu, typename DType, typename IType>
 class SequenceMaskOp : public Operator {
@@ -105,12 +125,24 @@ class SequenceMaskOp : public Operator {
     Tensor<xpu, 3, DType> out =
         out_data[seq_mask::kOut].get_with_shape<xpu, 3, DType>(s3, s);
     // Actual implementation of masking
-    Assign(out, req[seq_mask::kOut], F<mshadow_op::identity>(data));
-    if (param_.use_sequence_length) {
+    if (req[seq_mask::kOut] == kNullOp) return;
+    if (!param_.use_sequence_length) {
+      Assign(out, req[seq_mask::kOut], F<mshadow_op::identity>(data));
+    } else {
       Tensor<xpu, 1, IType> indices =
           in_data[seq_mask::kSequenceLength].get<xpu, 1, IType>(s);
-      SequenceMaskExec<DType, IType>(out, indices, req[seq_mask::kOut], s,
-                   param_.axis, static_cast<DType>(param_.value));
+      // d1 is the batch size for axis 0 and the sequence length for axis 1
+      MXNET_ASSIGN_REQ_SWITCH(req[seq_mask::kOut], req_type, {
+        if (param_.axis == 1) {
+          mxnet_op::Kernel<SequenceMask1FusedKernel<req_type>, xpu>::Launch(
+              s, dsize, out.dptr_, data.dptr_, indices.dptr_, d1, rest_size,
+              static_cast<DType>(param_.value));
+        } else {
+          mxnet_op::Kernel<SequenceMask0FusedKernel<req_type>, xpu>::Launch(
+              s, dsize, out.dptr_, data.dptr_, indices.dptr_, d1, rest_size,
+              static_cast<DType>(param_.value));
+        }
+      });
     }
   }
 
@@ -146,19 +178,19 @@ class SequenceMaskOp : public Operator {
     } else {
       Tensor<xpu, 1, IType> indices =
           in_data[seq_mask::kSequenceLength].get<xpu, 1, IType>(s);
-      if (req[seq_mask::kData] == kAddTo) {
-        Tensor<xpu, 3, DType> out_g_temp =
-            ctx.requested[seq_mask::kTempSpace].get_space_typed<xpu, 3, DType>(
-                s3, s);
-        out_g_temp = F<mshadow_op::identity>(out_g);
-        out_g = out_g_temp;
-        SequenceMaskExec<DType, IType>(out_g, indices, kWriteInplace, s, param_.axis, DType(0.));
-        Assign(data_g, kAddTo, F<mshadow_op::identity>(out_g));
-      } else {
-        Assign(data_g, req[seq_mask::kData], F<mshadow_op::identity>(out_g));
-        SequenceMaskExec<DType, IType>(
-          data_g, indices, req[seq_mask::kData], s, param_.axis, DType(0.));
-      }
+      // The fused kernel writes the gradient or zero per element in one
+      // pass, so kAddTo no longer needs a masked copy in temp space.
+      MXNET_ASSIGN_REQ_SWITCH(req[seq_mask::kData], req_type, {
+        if (param_.axis == 1) {
+          mxnet_op::Kernel<SequenceMask1FusedKernel<req_type>, xpu>::Launch(
+              s, dsize, data_g.dptr_, out_g.dptr_, indices.dptr_, d1,
+              rest_size, DType(0.));
+        } else {
+          mxnet_op::Kernel<SequenceMask0FusedKernel<req_type>, xpu>::Launch(
+              s, dsize, data_g.dptr_, out_g.dptr_, indices.dptr_, d1,
+              rest_size, DType(0.));
+        }
+      });
     }
   }
 
@@ -249,11 +281,6 @@ class SequenceMaskProp : public OperatorProperty {
       return {out_grad[seq_mask::kOut]};
   }
 
-  std::vector<ResourceRequest> BackwardResource(
-      const mxnet::ShapeVector &in_shape) const override {
-    return {ResourceRequest::kTempSpace};
-  }
-
   std::vector<std::pair<int, void *> > BackwardInplaceOption(
       const std::vector<int> &out_grad, const std::vector<int> &in_data,
       const std::vector<int> &out_data,
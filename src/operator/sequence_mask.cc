@@ -28,69 +28,6 @@
 namespace mxnet {
 namespace op {
 
-// (seqlen, batch, rest) case
-template <int req>
-struct SequenceMask0CPUKernel {
-  template <typename DType, typename IType>
-  MSHADOW_XINLINE static void Map(int batch, DType *in, const IType *idx,
-                                  index_t max_s_len, index_t batch_size,
-                                  index_t restsize, DType value) {
-    const index_t seqpos = static_cast<int>(idx[batch]);
-#pragma unroll
-    for (index_t s = seqpos; s < max_s_len; ++s) {
-      index_t incr = (s * batch_size * restsize) + (batch * restsize);
-#pragma unroll
-      for (index_t r = 0; r < restsize; ++r)
-        KERNEL_ASSIGN(in[incr + r], req, value);
-    }
-  }
-};
-
-// (batch, seqlen, rest) case
-template <int req>
-struct SequenceMask1CPUKernel {
-  template <typename DType, typename IType>
-  MSHADOW_XINLINE static void Map(int batch, DType *in, const IType *idx,
-                                  index_t max_s_len, index_t batch_size,
-                                  index_t restsize, DType value) {
-    const index_t seqpos = static_cast<int>(idx[batch]);
-#pragma unroll
-    for (index_t s = seqpos; s < max_s_len; ++s) {
-      index_t incr = (batch * max_s_len * restsize) + (s * restsize);
-#pragma unroll
-      for (index_t r = 0; r < restsize; ++r)
-        KERNEL_ASSIGN(in[incr + r], req, value);
-    }
-  }
-};
-
-template<typename DType, typename IType>
-void SequenceMaskExec(
-       const mshadow::Tensor<cpu, 3, DType> &data,
-       const mshadow::Tensor<cpu, 1, IType> &indices,
-       const OpReqType req, mshadow::Stream<cpu> *const s,
-       int axis, DType val) {
-  using namespace mshadow;
-  using namespace mshadow::expr;
-  using namespace mxnet_op;
-
-  index_t batch = indices.size(0);
-  index_t max_seq_len = data.size(axis);
-  index_t restsize = data.size(2);
-
-  MXNET_ASSIGN_REQ_SWITCH(req, req_type, {
-    if (axis == 1) {
-      Kernel<SequenceMask1CPUKernel<req_type>, cpu>::Launch(
-        s, batch, data.dptr_, indices.dptr_, max_seq_len, batch, restsize,
-        val);
-    } else {
-      Kernel<SequenceMask0CPUKernel<req_type>, cpu>::Launch(
-        s, batch, data.dptr_, indices.dptr_, max_seq_len, batch, restsize,
-        val);
-    }
-  });
-}
-
 template <>
 Operator *CreateOp<cpu>(SequenceMaskParam param, int dtype, int itype) {
   Operator *op = nullptr;
@@ -0,0 +1,130 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file bulk_region_property.cc
+ * \brief Group connected regions of memory-bound operators into one
+ *  _CachedOp node, so a long elementwise tail costs a single engine push
+ *  with one set of var dependencies instead of one push per operator.
+ *  This is deeper than the linear segment bulking in CachedOp, which stops
+ *  at every segment boundary; a region here may span branches and joins.
+ *  Regions smaller than MXNET_BULK_REGION_MIN_OPS nodes are left alone,
+ *  since a _CachedOp has scheduling overhead of its own.
+ */
+
+#include <mxnet/op_attr_types.h>
+#include <nnvm/op_attr_types.h>
+#include <string>
+#include <utility>
+#include <vector>
+#include "./common.h"
+#include "./subgraph_property.h"
+#include "../../imperative/cached_op.h"
+
+namespace mxnet {
+namespace op {
+
+/*!
+ * \brief Whether an operator is cheap enough per element that its cost is
+ *  dominated by engine scheduling. Registered inplace options are used as
+ *  the signal: the elementwise and broadcast kernels carry FInplaceOption,
+ *  while compute-bound operators (convolution, FC, ...) do not. Operators
+ *  that mutate inputs or run asynchronously must keep their own engine op
+ *  so their dependencies stay explicit.
+ */
+inline bool IsMemoryBoundOp(const nnvm::Node &node) {
+  static const auto &finplace = Op::GetAttr<nnvm::FInplaceOption>("FInplaceOption");
+  static const auto &fmutate = Op::GetAttr<nnvm::FMutateInputs>("FMutateInputs");
+  static const auto &fexec = Op::GetAttr<FExecType>("FExecType");
+  if (node.is_variable()) return false;
+  const nnvm::Op *op = node.op();
+  if (!finplace.count(op) || fmutate.count(op)) return false;
+  return !fexec.count(op) || fexec[op](node.attrs) == ExecType::kSync;
+}
+
+/*
+ * This selects connected regions of memory-bound operators, growing via
+ * both input and output links. Regions below the configured minimum size
+ * are rejected in Filter(), leaving those nodes untouched.
+ */
+class BulkRegionSelector: public SubgraphSelectorV2 {
+ public:
+  explicit BulkRegionSelector(size_t min_ops)
+    : min_ops_(min_ops) {}
+
+  bool Select(const BiDirectedNode &sn) override {
+    return IsMemoryBoundOp(*sn.node);
+  }
+
+  bool SelectInput(const BiDirectedNode &sn, const BiDirectedNode &snew_node) override {
+    return IsMemoryBoundOp(*snew_node.node);
+  }
+
+  bool SelectOutput(const BiDirectedNode &sn, const BiDirectedNode &snew_node) override {
+    return IsMemoryBoundOp(*snew_node.node);
+  }
+
+  std::vector<BiDirectedNode*> Filter(const std::vector<BiDirectedNode*> &candidates) override {
+    // The cost model: a region only pays for the _CachedOp it becomes when
+    // it replaces enough engine pushes
+    if (candidates.size() < min_ops_) {
+      return std::vector<BiDirectedNode*>();
+    }
+    return candidates;
+  }
+
+ private:
+  /*! \brief smallest region worth replacing with a _CachedOp node */
+  const size_t min_ops_;
+};
+
+/*
+ * This subgraph property turns each sufficiently large region of
+ * memory-bound operators into a _CachedOp node, which the engine schedules
+ * as one op with a single set of var dependencies.
+ */
+class BulkRegionProperty: public SubgraphProperty {
+ public:
+  static SubgraphPropertyPtr Create() { return std::make_shared<BulkRegionProperty>(); }
+  nnvm::NodePtr CreateSubgraphNode(const nnvm::Symbol &sym,
+                                   const SubgraphSelectorPtr& subgraph_selector,
+                                   const int subgraph_id = 0) const override {
+    nnvm::NodePtr n = nnvm::Node::Create();
+    n->attrs.op = Op::Get("_CachedOp");
+    n->attrs.name = "_bulk_region_" + std::to_string(subgraph_id);
+    n->attrs.subgraphs.push_back(std::make_shared<nnvm::Symbol>(sym));
+
+    std::vector<std::pair<std::string, std::string> > flags{{"static_alloc", "true"}};
+    n->attrs.parsed = CachedOpPtr(new CachedOp(sym, flags));
+
+    return n;
+  }
+  SubgraphSelectorV2Ptr CreateSubgraphSelectorV2() const override {
+    return std::make_shared<BulkRegionSelector>(
+        dmlc::GetEnv("MXNET_BULK_REGION_MIN_OPS", 4));
+  }
+};
+
+MXNET_REGISTER_SUBGRAPH_BACKEND(bulk_region);
+
+MXNET_REGISTER_SUBGRAPH_PROPERTY(bulk_region, BulkRegionProperty);
+
+}  // namespace op
+}  // namespace mxnet
@@ -0,0 +1,125 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file pipeline_partition_property.cc
+ * \brief Partition a graph into pipeline stages along user annotations.
+ *  Nodes carrying the same "__pipeline_stage__" attribute are grouped into
+ *  one _CachedOp subgraph node per connected region. The stage's
+ *  "__ctx_group__" annotation, if any, is copied onto the subgraph node, so
+ *  binding with group2ctx places each stage on its own context and the
+ *  dependency engine overlaps stage N+1 of one batch with stage N of the
+ *  next.
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "./common.h"
+#include "./subgraph_property.h"
+#include "../../imperative/cached_op.h"
+
+namespace mxnet {
+namespace op {
+
+static const char kPipelineStageAttr[] = "__pipeline_stage__";
+static const char kCtxGroupAttr[] = "__ctx_group__";
+
+/*
+ * This selects connected regions of nodes that carry the same
+ * "__pipeline_stage__" attribute as the seed node, growing via both
+ * input and output links. Unannotated nodes are left outside.
+ */
+class PipelineStageSelector: public SubgraphSelectorV2 {
+ public:
+  bool Select(const BiDirectedNode &sn) override {
+    const auto &seed_node = *sn.node;
+    if (seed_node.is_variable()) return false;
+    const auto it = seed_node.attrs.dict.find(kPipelineStageAttr);
+    if (it == seed_node.attrs.dict.end()) return false;
+    stage_ = it->second;
+    return true;
+  }
+
+  bool SelectInput(const BiDirectedNode &sn, const BiDirectedNode &snew_node) override {
+    return SameStage(snew_node);
+  }
+
+  bool SelectOutput(const BiDirectedNode &sn, const BiDirectedNode &snew_node) override {
+    return SameStage(snew_node);
+  }
+
+ private:
+  bool SameStage(const BiDirectedNode &sn) const {
+    const auto &node = *sn.node;
+    if (node.is_variable()) return false;
+    const auto it = node.attrs.dict.find(kPipelineStageAttr);
+    return it != node.attrs.dict.end() && it->second == stage_;
+  }
+  /*! \brief pipeline stage of the seed node of the current subgraph */
+  std::string stage_;
+};
+
+/*
+ * This subgraph property turns each annotated pipeline stage into a
+ * _CachedOp node and forwards the stage's context-group annotation, so the
+ * regular group2ctx machinery assigns the stage to its device and cross
+ * device copies are inserted at the cuts.
+ */
+class PipelinePartitionProperty: public SubgraphProperty {
+ public:
+  static SubgraphPropertyPtr Create() { return std::make_shared<PipelinePartitionProperty>(); }
+  nnvm::NodePtr CreateSubgraphNode(const nnvm::Symbol &sym,
+                                   const SubgraphSelectorPtr& subgraph_selector,
+                                   const int subgraph_id = 0) const override {
+    std::string stage, ctx_group;
+    DFSVisit(sym.outputs, [&stage, &ctx_group](const nnvm::NodePtr &node) {
+      if (node->is_variable()) return;
+      const auto sit = node->attrs.dict.find(kPipelineStageAttr);
+      if (sit != node->attrs.dict.end()) stage = sit->second;
+      const auto cit = node->attrs.dict.find(kCtxGroupAttr);
+      if (cit != node->attrs.dict.end()) ctx_group = cit->second;
+    });
+
+    nnvm::NodePtr n = nnvm::Node::Create();
+    n->attrs.op = Op::Get("_CachedOp");
+    n->attrs.name = "_pipeline_stage_" + stage + "_" + std::to_string(subgraph_id);
+    n->attrs.subgraphs.push_back(std::make_shared<nnvm::Symbol>(sym));
+    n->attrs.dict[kPipelineStageAttr] = stage;
+    if (!ctx_group.empty()) {
+      n->attrs.dict[kCtxGroupAttr] = ctx_group;
+    }
+
+    std::vector<std::pair<std::string, std::string> > flags{{"static_alloc", "true"}};
+    n->attrs.parsed = CachedOpPtr(new CachedOp(sym, flags));
+
+    return n;
+  }
+  SubgraphSelectorV2Ptr CreateSubgraphSelectorV2() const override {
+    return std::make_shared<PipelineStageSelector>();
+  }
+};
+
+MXNET_REGISTER_SUBGRAPH_BACKEND(pipeline);
+
+MXNET_REGISTER_SUBGRAPH_PROPERTY(pipeline, PipelinePartitionProperty);
+
+}  // namespace op
+}  // namespace mxnet
@@ -42,12 +42,95 @@
 #include <onnx-tensorrt/PluginFactory.hpp>
 #include <onnx-tensorrt/plugin_common.hpp>
 
+#include <cuda_runtime_api.h>
+#if defined(_WIN32) || defined(_WIN64) || defined(__WINDOWS__)
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#include <functional>
+
 using std::cout;
 using std::cerr;
 using std::endl;
 
 namespace onnx_to_tensorrt {
 
+namespace {
+
+/*!
+ * \brief Path of the cached engine plan for a model and build configuration,
+ *  or an empty string when caching is off. Engine plans are only valid for
+ *  the exact TensorRT version and GPU architecture that produced them, so
+ *  both are part of the file name along with the model hash and the build
+ *  settings that shape the plan.
+ */
+std::string TrtPlanCachePath(const std::string& onnx_model,
+                             int32_t max_batch_size,
+                             size_t max_workspace_size) {
+  const std::string dir = dmlc::GetEnv("MXNET_TENSORRT_CACHE_DIR", std::string());
+  if (dir.empty()) {
+    return "";
+  }
+  int device = 0;
+  cudaDeviceProp prop;
+  if (cudaGetDevice(&device) != cudaSuccess ||
+      cudaGetDeviceProperties(&prop, device) != cudaSuccess) {
+    return "";
+  }
+  const bool use_fp16 = dmlc::GetEnv("MXNET_TENSORRT_USE_FP16", true);
+  std::ostringstream oss;
+  oss << dir << "/trt_" << std::hex << std::hash<std::string>()(onnx_model)
+      << std::dec << "_" << onnx_model.size()
+      << "_b" << max_batch_size
+      << "_w" << max_workspace_size
+      << (use_fp16 ? "_fp16" : "_fp32")
+      << "_v" << NV_TENSORRT_MAJOR << "." << NV_TENSORRT_MINOR << "." << NV_TENSORRT_PATCH
+      << "_sm" << prop.major << prop.minor
+      << ".plan";
+  return oss.str();
+}
+
+unique_ptr<nvinfer1::ICudaEngine> DeserializeCachedEngine(
+    const std::string& path,
+    TRT_Logger* trt_logger,
+    nvonnxparser::IPluginFactory* plugin_factory) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return nullptr;
+  }
+  std::string plan((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  auto trt_runtime = InferObject(nvinfer1::createInferRuntime(*trt_logger));
+  nvinfer1::ICudaEngine* engine =
+      trt_runtime->deserializeCudaEngine(plan.data(), plan.size(), plugin_factory);
+  if (!engine) {
+    // A stale or truncated plan: rebuild and overwrite it
+    LOG(WARNING) << "Could not deserialize cached TensorRT engine plan " << path
+                 << ", rebuilding the engine";
+    return nullptr;
+  }
+  return unique_ptr<nvinfer1::ICudaEngine>(engine, InferDeleter());
+}
+
+void SerializeEngineToCache(const std::string& path, nvinfer1::ICudaEngine* engine) {
+  const size_t slash = path.rfind('/');
+#if defined(_WIN32) || defined(_WIN64) || defined(__WINDOWS__)
+  _mkdir(path.substr(0, slash).c_str());
+#else
+  mkdir(path.substr(0, slash).c_str(), 0700);
+#endif
+  auto plan = InferObject(engine->serialize());
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    LOG(WARNING) << "Could not write TensorRT engine plan to " << path;
+    return;
+  }
+  file.write(static_cast<const char*>(plan->data()), plan->size());
+}
+
+}  // namespace
+
 std::string onnx_ir_version_string(int64_t ir_version = onnx::IR_VERSION) {
   int onnx_ir_major = ir_version / 1000000;
   int onnx_ir_minor = ir_version % 1000000 / 10000;
@@ -68,7 +151,8 @@ void PrintVersion() {
 
 std::tuple<unique_ptr<nvinfer1::ICudaEngine>,
            unique_ptr<nvonnxparser::IParser>,
-           std::unique_ptr<TRT_Logger> > onnxToTrtCtx(
+           std::unique_ptr<TRT_Logger>,
+           unique_ptr<nvonnxparser::IPluginFactory> > onnxToTrtCtx(
         const std::string& onnx_model,
         int32_t max_batch_size,
         size_t max_workspace_size,
@@ -77,6 +161,19 @@ std::tuple<unique_ptr<nvinfer1::ICudaEngine>,
   GOOGLE_PROTOBUF_VERIFY_VERSION;
 
   auto trt_logger = std::unique_ptr<TRT_Logger>(new TRT_Logger(verbosity));
+  const std::string plan_path =
+      TrtPlanCachePath(onnx_model, max_batch_size, max_workspace_size);
+  if (!plan_path.empty()) {
+    auto plugin_factory = InferObject(nvonnxparser::createPluginFactory(*trt_logger));
+    auto cached_engine =
+        DeserializeCachedEngine(plan_path, trt_logger.get(), plugin_factory.get());
+    if (cached_engine) {
+      return std::make_tuple(std::move(cached_engine),
+                             unique_ptr<nvonnxparser::IParser>(),
+                             std::move(trt_logger),
+                             std::move(plugin_factory));
+    }
+  }
   auto trt_builder = nvinfer1::createInferBuilder(*trt_logger);
   auto trt_network = trt_builder->createNetwork();
   auto trt_parser  = InferObject(nvonnxparser::createParser(*trt_network, *trt_logger));
@@ -127,7 +224,11 @@ std::tuple<unique_ptr<nvinfer1::ICudaEngine>,
   auto trt_engine = InferObject(trt_builder->buildCudaEngine(*trt_network));
   trt_builder->destroy();
   trt_network->destroy();
-  return std::make_tuple(std::move(trt_engine), std::move(trt_parser), std::move(trt_logger));
+  if (!plan_path.empty()) {
+    SerializeEngineToCache(plan_path, trt_engine.get());
+  }
+  return std::make_tuple(std::move(trt_engine), std::move(trt_parser), std::move(trt_logger),
+                         unique_ptr<nvonnxparser::IPluginFactory>());
 }
 
 }  // namespace onnx_to_tensorrt
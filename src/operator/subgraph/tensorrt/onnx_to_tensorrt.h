@@ -83,9 +83,20 @@ class TRT_Logger : public nvinfer1::ILogger {
   }
 };
 
+/*!
+ * \brief Build a TensorRT engine from a serialized ONNX model.
+ *
+ * When MXNET_TENSORRT_CACHE_DIR is set, the serialized engine plan is
+ * cached there keyed by model hash, build settings, TensorRT version and
+ * GPU compute capability, and later runs deserialize the plan instead of
+ * rebuilding the engine. On the cached path the parser element of the
+ * returned tuple is null and the plugin factory element holds the factory
+ * used for deserialization, which must outlive the engine.
+ */
 std::tuple<unique_ptr<nvinfer1::ICudaEngine>,
            unique_ptr<nvonnxparser::IParser>,
-           std::unique_ptr<TRT_Logger> > onnxToTrtCtx(
+           std::unique_ptr<TRT_Logger>,
+           unique_ptr<nvonnxparser::IPluginFactory> > onnxToTrtCtx(
         const std::string& onnx_model,
         int32_t max_batch_size = 32,
         size_t max_workspace_size = 1L << 30,
@@ -62,11 +62,13 @@ struct TRTEngineParam {
   TRTEngineParam(onnx_to_tensorrt::unique_ptr<nvinfer1::ICudaEngine> _trt_engine,
                  onnx_to_tensorrt::unique_ptr<nvonnxparser::IParser> _trt_parser,
                  std::unique_ptr<onnx_to_tensorrt::TRT_Logger> _trt_logger,
+                 onnx_to_tensorrt::unique_ptr<nvonnxparser::IPluginFactory> _trt_plugin_factory,
                  const std::unordered_map<std::string, uint32_t>& input_map,
                  const std::unordered_map<std::string, uint32_t>& output_map) {
     trt_engine = std::move(_trt_engine);
     trt_logger = std::move(_trt_logger);
     trt_parser = std::move(_trt_parser);
+    trt_plugin_factory = std::move(_trt_plugin_factory);
     binding_order = std::make_shared<std::vector<std::pair<uint32_t, bool> > >();
     bindings = std::make_shared<std::vector<void*> >();
     binding_order->reserve(trt_engine->getNbBindings());
@@ -85,6 +87,9 @@ struct TRTEngineParam {
   onnx_to_tensorrt::unique_ptr<nvinfer1::ICudaEngine> trt_engine;
   onnx_to_tensorrt::unique_ptr<nvinfer1::IExecutionContext> trt_executor;
   onnx_to_tensorrt::unique_ptr<nvonnxparser::IParser> trt_parser;
+  /*! \brief factory used when the engine was deserialized from a cached plan;
+   *         null when the engine was built from ONNX in this process */
+  onnx_to_tensorrt::unique_ptr<nvonnxparser::IPluginFactory> trt_plugin_factory;
   std::unique_ptr<onnx_to_tensorrt::TRT_Logger> trt_logger;
   std::shared_ptr<std::vector<std::pair<uint32_t, bool> > > binding_order;
   std::shared_ptr<std::vector<void*> > bindings;
@@ -315,6 +315,7 @@ OpStatePtr TRTCreateState(const nnvm::NodeAttrs& attrs, Context ctx,
   return OpStatePtr::Create<TRTEngineParam>(std::move(std::get<0>(trt_tuple)),
                                             std::move(std::get<1>(trt_tuple)),
                                             std::move(std::get<2>(trt_tuple)),
+                                            std::move(std::get<3>(trt_tuple)),
                                             inputs_to_idx, outputs_to_idx);
 }
 
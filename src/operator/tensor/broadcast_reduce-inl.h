@@ -196,12 +196,65 @@ void BinaryBroadcastComputeImpl(Stream<cpu> *s, const OpReqType req,
                            out.shape_.get<ndim>());
 }
 
+/*!
+ * \brief Two-level reduction for the case where the number of outputs is
+ * smaller than the number of cores: the reduction axis of every output is
+ * split into per-thread chunks reduced independently, and the partials are
+ * merged afterwards. Each partial keeps its own residual so stable reducers
+ * stay stable, and the merge order is fixed, so results are deterministic.
+ */
+template<typename Reducer, int ndim, typename AType, typename DType, typename OType, typename OP>
+void two_level_reduce_compute(const size_t N, const size_t M, const bool addto,
+                              const DType *big, OType *small, const Shape<ndim> bshape,
+                              const Shape<ndim> sshape, const Shape<ndim> rshape,
+                              const Shape<ndim> rstride, const size_t chunks,
+                              const int nthreads) {
+  const size_t chunk_len = (M + chunks - 1) / chunks;
+  std::vector<AType> vals(N * chunks);
+  std::vector<AType> residuals(N * chunks);
+  #pragma omp parallel for num_threads(nthreads)
+  for (index_t task = 0; task < static_cast<index_t>(N * chunks); ++task) {
+    const index_t idx = task / chunks;
+    const size_t k_begin = (task % chunks) * chunk_len;
+    const size_t k_end = std::min(M, k_begin + chunk_len);
+    const index_t j = ravel(unravel(idx, sshape), bshape);
+    AType val, residual;
+    Reducer::SetInitValue(val, residual);
+    for (size_t k = k_begin; k < k_end; ++k) {
+      Shape<ndim> coord = unravel(k, rshape);
+      Reducer::Reduce(val, AType(OP::Map(big[j + dot(coord, rstride)])), residual);
+    }
+    vals[task] = val;
+    residuals[task] = residual;
+  }
+  for (size_t idx = 0; idx < N; ++idx) {
+    AType val, residual;
+    Reducer::SetInitValue(val, residual);
+    for (size_t c = 0; c < chunks; ++c) {
+      Reducer::Merge(val, residual, vals[idx * chunks + c], residuals[idx * chunks + c]);
+    }
+    Reducer::Finalize(val, residual);
+    assign(&small[idx], addto, OType(val));
+  }
+}
+
 template<typename Reducer, int ndim, typename AType, typename DType, typename OType, typename OP>
 void seq_reduce_compute(const size_t N, const size_t M, const bool addto,
                         const DType *big, OType *small, const Shape<ndim> bshape,
                         const Shape<ndim> sshape, const Shape<ndim> rshape,
                         const Shape<ndim> rstride) {
-  #pragma omp parallel for num_threads(engine::OpenMP::Get()->GetRecommendedOMPThreadCount())
+  const int nthreads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+  // with fewer outputs than cores, parallelizing over outputs alone leaves
+  // most of the machine idle; split the reduction axis as well
+  if (N < static_cast<size_t>(nthreads) && N > 0) {
+    const size_t chunks = std::min(M, static_cast<size_t>(nthreads) / N);
+    if (chunks >= 2 && M >= 1024) {
+      two_level_reduce_compute<Reducer, ndim, AType, DType, OType, OP>(
+          N, M, addto, big, small, bshape, sshape, rshape, rstride, chunks, nthreads);
+      return;
+    }
+  }
+  #pragma omp parallel for num_threads(nthreads)
   for (index_t idx = 0; idx < static_cast<index_t>(N); ++idx) {
     seq_reduce_assign<Reducer, ndim, AType, DType, OType, OP>(idx, M, addto, big, small,
         bshape, sshape, rshape, rstride);
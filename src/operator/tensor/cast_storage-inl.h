@@ -28,9 +28,11 @@
 #include <mxnet/ndarray.h>
 #include <vector>
 #include <algorithm>
+#include <cstring>
 #include "../mxnet_op.h"
 #include "../operator_common.h"
 #include "../../src/operator/tensor/init_op.h"
+#include "./util/tensor_util-inl.h"
 #ifdef __CUDACC__
 #include "./cast_storage-inl.cuh"
 #endif  // __CUDACC__
@@ -99,14 +101,24 @@ inline void CastStorageDnsRspImpl(const OpContext& ctx,
       auto storage_shape = dns.shape_;
       storage_shape[0] = nnr;
       rsp->CheckAndAllocData(storage_shape);
-      auto dns_data = dns.get_with_shape<cpu, 2, DType>(Shape2(num_rows, row_length), s);
-      auto rsp_data = rsp->data().get_with_shape<cpu, 2, DType>(Shape2(nnr, row_length), s);
-      dim_t idx = 0;
+      const DType* dns_data = dns.dptr<DType>();
+      DType* rsp_data = rsp->data().dptr<DType>();
+      // an exclusive scan of the 0/1 row marks gives every non-zero row its
+      // destination slot, so the compaction can scatter rows in parallel
+      const int nthreads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+      std::vector<dim_t> pos(num_rows + 1, 0);
+      #pragma omp parallel for num_threads(nthreads)
       for (dim_t i = 0; i < num_rows; ++i) {
-        if (row_idx[i] > 0) {
+        pos[i + 1] = row_idx[i];
+      }
+      ParallelInclusiveScan(pos.data() + 1, num_rows);
+      #pragma omp parallel for num_threads(nthreads)
+      for (dim_t i = 0; i < num_rows; ++i) {
+        if (pos[i + 1] != pos[i]) {
+          const dim_t idx = pos[i];
           row_idx[idx] = i;
-          Copy(rsp_data[idx], dns_data[i], s);
-          ++idx;
+          std::memcpy(rsp_data + idx * row_length, dns_data + i * row_length,
+                      row_length * sizeof(DType));
         }
       }
     });
@@ -251,12 +263,10 @@ inline void CastStorageDnsCsrImpl(const OpContext& ctx,
         dim_t num_threads = num_rows;
         mxnet_op::Kernel<FillCsrIndPtr, cpu>::Launch(s, num_threads,
             indptr, dns_data, num_rows, num_cols);
-        // single thread to accumulate indptr
+        // parallel scan to accumulate indptr
         // indptr[num_rows] indicates the number of non-zero elements
         indptr[0] = 0;
-        for (dim_t i = 0; i < num_rows; ++i) {
-          indptr[i+1] += indptr[i];
-        }
+        ParallelInclusiveScan(indptr + 1, num_rows);
         // allocate column idx array and value array
         csr->CheckAndAllocAuxData(csr::kIdx, Shape1(static_cast<index_t>(indptr[num_rows])));
         csr->CheckAndAllocData(Shape1(static_cast<index_t>(indptr[num_rows])));
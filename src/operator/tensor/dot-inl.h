@@ -36,6 +36,8 @@
 #include "../elemwise_op_common.h"
 #include "./init_op.h"
 #include "../mxnet_op.h"
+#include "../linalg.h"
+#include "./elemwise_simd-inl.h"
 #ifdef __CUDACC__
 #include "./dot-inl.cuh"
 #endif  // __CUDACC__
@@ -348,6 +350,98 @@ inline bool DotBackwardInferStorageType(const nnvm::NodeAttrs& attrs,
   return dispatched;
 }
 
+#if defined(MXNET_SIMD_MULTIVERSION)
+namespace simd {
+
+/*!
+ * \brief AVX2 kernel for one CSR output row: the dense columns are walked in
+ * 32-wide register blocks that stay live across all non-zeros of the row, so
+ * the output row is loaded and stored once instead of once per non-zero.
+ */
+template<typename IType, typename CType>
+__attribute__((target("avx2,fma")))
+void DotCsrDnsRowAVX2(float* out_row, const float* data_l, const CType* col_idx,
+                      const float* data_r, const IType row_begin, const IType row_end,
+                      const nnvm::dim_t num_cols) {
+  nnvm::dim_t l = 0;
+  for (; l + 32 <= num_cols; l += 32) {
+    __m256 acc0 = _mm256_loadu_ps(out_row + l);
+    __m256 acc1 = _mm256_loadu_ps(out_row + l + 8);
+    __m256 acc2 = _mm256_loadu_ps(out_row + l + 16);
+    __m256 acc3 = _mm256_loadu_ps(out_row + l + 24);
+    for (IType k = row_begin; k < row_end; ++k) {
+      const __m256 val = _mm256_set1_ps(data_l[k]);
+      const float* r = data_r + static_cast<nnvm::dim_t>(col_idx[k]) * num_cols + l;
+      acc0 = _mm256_fmadd_ps(val, _mm256_loadu_ps(r), acc0);
+      acc1 = _mm256_fmadd_ps(val, _mm256_loadu_ps(r + 8), acc1);
+      acc2 = _mm256_fmadd_ps(val, _mm256_loadu_ps(r + 16), acc2);
+      acc3 = _mm256_fmadd_ps(val, _mm256_loadu_ps(r + 24), acc3);
+    }
+    _mm256_storeu_ps(out_row + l, acc0);
+    _mm256_storeu_ps(out_row + l + 8, acc1);
+    _mm256_storeu_ps(out_row + l + 16, acc2);
+    _mm256_storeu_ps(out_row + l + 24, acc3);
+  }
+  for (; l + 8 <= num_cols; l += 8) {
+    __m256 acc = _mm256_loadu_ps(out_row + l);
+    for (IType k = row_begin; k < row_end; ++k) {
+      const float* r = data_r + static_cast<nnvm::dim_t>(col_idx[k]) * num_cols + l;
+      acc = _mm256_fmadd_ps(_mm256_set1_ps(data_l[k]), _mm256_loadu_ps(r), acc);
+    }
+    _mm256_storeu_ps(out_row + l, acc);
+  }
+  for (; l < num_cols; ++l) {
+    float acc = out_row[l];
+    for (IType k = row_begin; k < row_end; ++k) {
+      acc += data_r[static_cast<nnvm::dim_t>(col_idx[k]) * num_cols + l] * data_l[k];
+    }
+    out_row[l] = acc;
+  }
+}
+
+/*! \brief AVX2 y += val * x over one dense row, used by the transposed kernel */
+__attribute__((target("avx2,fma")))
+inline void DotDnsAxpyAVX2(float* y, const float val, const float* x,
+                           const nnvm::dim_t n) {
+  const __m256 v = _mm256_set1_ps(val);
+  nnvm::dim_t l = 0;
+  for (; l + 8 <= n; l += 8) {
+    _mm256_storeu_ps(y + l, _mm256_fmadd_ps(v, _mm256_loadu_ps(x + l), _mm256_loadu_ps(y + l)));
+  }
+  for (; l < n; ++l) y[l] += x[l] * val;
+}
+
+}  // namespace simd
+
+// generic dtypes keep the scalar loops; float dispatches to the AVX2 kernels
+// once the cpuid check passes
+template<typename DType, typename IType, typename CType>
+inline bool DotCsrDnsRowSIMD(DType*, const DType*, const CType*, const DType*,
+                             IType, IType, nnvm::dim_t) {
+  return false;
+}
+
+template<typename IType, typename CType>
+inline bool DotCsrDnsRowSIMD(float* out_row, const float* data_l, const CType* col_idx,
+                             const float* data_r, IType row_begin, IType row_end,
+                             nnvm::dim_t num_cols) {
+  if (!simd::SupportsAVX2() || num_cols < 8) return false;
+  simd::DotCsrDnsRowAVX2(out_row, data_l, col_idx, data_r, row_begin, row_end, num_cols);
+  return true;
+}
+
+template<typename DType>
+inline bool DotDnsAxpySIMD(DType*, DType, const DType*, nnvm::dim_t) {
+  return false;
+}
+
+inline bool DotDnsAxpySIMD(float* y, float val, const float* x, nnvm::dim_t n) {
+  if (!simd::SupportsAVX2() || n < 8) return false;
+  simd::DotDnsAxpyAVX2(y, val, x, n);
+  return true;
+}
+#endif  // MXNET_SIMD_MULTIVERSION
+
 /*!
  * \brief CPU Kernel of dot(csr, dns1) = dns2
  * Parallelization by row blocks
@@ -374,6 +468,12 @@ struct DotCsrDnsDnsByRowBlocks {
     for (dim_t j = seg_start; j < seg_end; ++j) {
       if (indptr_l[j] == indptr_l[j+1]) continue;
       const dim_t offset_out = j * num_cols;
+#if defined(MXNET_SIMD_MULTIVERSION)
+      if (DotCsrDnsRowSIMD(out + offset_out, data_l, col_idx_l, data_r,
+                           indptr_l[j], indptr_l[j+1], num_cols)) {
+        continue;
+      }
+#endif  // MXNET_SIMD_MULTIVERSION
       for (IType k = indptr_l[j]; k < indptr_l[j+1]; ++k) {
         const DType val = data_l[k];
         const dim_t offset_r = col_idx_l[k] * num_cols;
@@ -417,6 +517,11 @@ struct DotCsrTransDnsDnsByRowBlocks {
         if (col_idx < seg_start || col_idx >= seg_end) continue;
         const dim_t offset_out = col_idx * num_cols;
         const DType val = data_l[k];
+#if defined(MXNET_SIMD_MULTIVERSION)
+        if (DotDnsAxpySIMD(out + offset_out, val, data_r + offset_r, num_cols)) {
+          continue;
+        }
+#endif  // MXNET_SIMD_MULTIVERSION
         for (dim_t l = 0; l < num_cols; ++l) {
           out[offset_out+l] += data_r[offset_r+l] * val;
         }
@@ -1386,25 +1491,11 @@ void BatchDotForward_(const nnvm::NodeAttrs& attrs,
         inputs[1].get_with_shape<xpu, 3, DType>(Shape3(batch_size,
                                                        inputs[1].shape_[ndim - 2],
                                                        inputs[1].shape_[ndim - 1]), s);
-    mshadow::Tensor<xpu, 1, DType*> workspace =
-        ctx.requested[0].get_space_typed<xpu, 1, DType*>(mshadow::Shape1(3 * out.size(0)), s);
-    if (param.transpose_a && param.transpose_b) {
-      mshadow::BatchGEMM<true, true>(out, mlhs, mrhs, (DType)1.0f,
-                                     (kAddTo == req[0]) ? (DType)1.0f : (DType)0.0f,
-                                     workspace);
-    } else if (!param.transpose_a && param.transpose_b) {
-      mshadow::BatchGEMM<false, true>(out, mlhs, mrhs, (DType)1.0f,
-                                     (kAddTo == req[0]) ? (DType)1.0f : (DType)0.0f,
-                                     workspace);
-    } else if (param.transpose_a && !param.transpose_b) {
-      mshadow::BatchGEMM<true, false>(out, mlhs, mrhs, (DType)1.0f,
-                                     (kAddTo == req[0]) ? (DType)1.0f : (DType)0.0f,
-                                     workspace);
-    } else {
-      mshadow::BatchGEMM<false, false>(out, mlhs, mrhs, (DType)1.0f,
-                                     (kAddTo == req[0]) ? (DType)1.0f : (DType)0.0f,
-                                     workspace);
-    }
+    // Strided-batch dispatch: cublas' strided batched gemm on GPU, MKL's
+    // batched gemm on CPU when available, a serial gemm loop otherwise.
+    linalg_batch_gemm(mlhs, mrhs, out, (DType)1.0f,
+                      (kAddTo == req[0]) ? (DType)1.0f : (DType)0.0f,
+                      param.transpose_a, param.transpose_b, s);
   });
 }
 
@@ -38,10 +38,44 @@
 #include "elemwise_unary_op.h"
 #include "../../common/utils.h"
 #include "./init_op.h"
+#include "./elemwise_simd-inl.h"
 
 namespace mxnet {
 namespace op {
 
+/*! \brief per-dimension element strides of a blob, explicit or compact row-major */
+template<int ndim>
+inline mshadow::Shape<ndim> ElemwiseStrides(const TBlob& blob) {
+  mshadow::Shape<ndim> strides;
+  if (blob.strides_.ndim() > 0) {
+    for (int i = 0; i < ndim; ++i) {
+      strides[i] = blob.strides_[i];
+    }
+  } else {
+    index_t expected = 1;
+    for (int i = ndim - 1; i >= 0; --i) {
+      strides[i] = expected;
+      expected *= blob.shape_[i];
+    }
+  }
+  return strides;
+}
+
+/*! \brief binary map over inputs that carry explicit stride descriptors */
+template<typename OP, int req, int ndim>
+struct binary_strided_kernel {
+  template<typename DType>
+  MSHADOW_XINLINE static void Map(index_t i, DType *out,
+                                  const DType *lhs, const DType *rhs,
+                                  const mshadow::Shape<ndim> oshape,
+                                  const mshadow::Shape<ndim> lstride,
+                                  const mshadow::Shape<ndim> rstride) {
+    const mshadow::Shape<ndim> coord = mxnet_op::unravel(i, oshape);
+    KERNEL_ASSIGN(out[i], req, OP::Map(lhs[mxnet_op::dot(coord, lstride)],
+                                       rhs[mxnet_op::dot(coord, rstride)]));
+  }
+};
+
 /*! Gather binary operator functions into ElemwiseBinaryOp class */
 class ElemwiseBinaryOp : public OpBase {
  public:
@@ -472,6 +506,35 @@ class ElemwiseBinaryOp : public OpBase {
                                        std::vector<int> *in_attrs,
                                        std::vector<int> *out_attrs);
 
+  /*!
+   * \brief Compute with inputs that carry explicit stride descriptors,
+   *  iterating in output order and gathering through the input strides.
+   *  Avoids materializing a transpose for e.g. column-major ingest views.
+   */
+  template<typename xpu, typename OP>
+  static void ComputeStrided(const nnvm::NodeAttrs &attrs,
+                             const OpContext &ctx,
+                             const std::vector<TBlob> &inputs,
+                             const std::vector<OpReqType> &req,
+                             const std::vector<TBlob> &outputs) {
+    using namespace mxnet_op;
+    CHECK(outputs[0].CheckContiguous())
+        << "elemwise output must be compact; only inputs may be strided";
+    Stream<xpu> *s = ctx.get_stream<xpu>();
+    MXNET_ASSIGN_REQ_SWITCH(req[0], Req, {
+      MSHADOW_TYPE_SWITCH(outputs[0].type_flag_, DType, {
+        MXNET_NDIM_SWITCH(outputs[0].ndim(), NDim, {
+          Kernel<binary_strided_kernel<OP, Req, NDim>, xpu>::Launch(
+              s, outputs[0].Size(), outputs[0].dptr<DType>(),
+              inputs[0].dptr<DType>(), inputs[1].dptr<DType>(),
+              outputs[0].shape_.get<NDim>(),
+              ElemwiseStrides<NDim>(inputs[0]),
+              ElemwiseStrides<NDim>(inputs[1]));
+        });
+      });
+    });
+  }
+
   template<typename xpu, typename OP>
   static void Compute(const nnvm::NodeAttrs &attrs,
                       const OpContext &ctx,
@@ -483,14 +546,26 @@ class ElemwiseBinaryOp : public OpBase {
       Stream<xpu> *s = ctx.get_stream<xpu>();
       CHECK_EQ(inputs.size(), 2U);
       CHECK_EQ(outputs.size(), 1U);
+      if (!inputs[0].CheckContiguous() || !inputs[1].CheckContiguous()) {
+        ComputeStrided<xpu, OP>(attrs, ctx, inputs, req, outputs);
+        return;
+      }
       MXNET_ASSIGN_REQ_SWITCH(req[0], Req, {
         MSHADOW_TYPE_SWITCH(outputs[0].type_flag_, DType, {
           const size_t size = (minthree(outputs[0].Size(), inputs[0].Size(), inputs[1].Size())
           + DataType<DType>::kLanes - 1) / DataType<DType>::kLanes;
           if (size != 0) {
-            Kernel<mxnet_op::op_with_req<OP, Req>, xpu>::Launch(s, size,
-            outputs[0].dptr<DType>(),
-            inputs[0].dptr<DType>(), inputs[1].dptr<DType>());
+            // hand-vectorized kernels for the hottest float32 ops; falls
+            // through to the generic kernel for every other case
+            const bool vectorized = Req == kWriteTo &&
+                simd::SIMDBinary<xpu, OP, DType>::Run(
+                    outputs[0].dptr<DType>(), inputs[0].dptr<DType>(),
+                    inputs[1].dptr<DType>(), size);
+            if (!vectorized) {
+              Kernel<mxnet_op::op_with_req<OP, Req>, xpu>::Launch(s, size,
+              outputs[0].dptr<DType>(),
+              inputs[0].dptr<DType>(), inputs[1].dptr<DType>());
+            }
           }
         });
       });
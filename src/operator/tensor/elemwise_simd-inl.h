@@ -0,0 +1,329 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file elemwise_simd-inl.h
+ * \brief runtime-dispatched SIMD kernels for dense elementwise binary ops.
+ *
+ * The generic Kernel::Launch path goes through mshadow expression
+ * templates, which the compiler does not always vectorize. For the
+ * hottest float32 binary ops this header provides hand-vectorized
+ * AVX-512 and AVX2 kernels compiled with per-function target attributes
+ * and selected at runtime from the CPU features, so a generic build
+ * still uses the widest vectors the machine has.
+ */
+#ifndef MXNET_OPERATOR_TENSOR_ELEMWISE_SIMD_INL_H_
+#define MXNET_OPERATOR_TENSOR_ELEMWISE_SIMD_INL_H_
+
+#include <dmlc/parameter.h>
+#include <mxnet/base.h>
+#include <algorithm>
+#include "../mshadow_op.h"
+#include "../../engine/openmp.h"
+
+// target attributes and __builtin_cpu_supports("avx512f") need gcc 5+
+// or clang; other toolchains (including the nvcc frontend) keep the
+// generic path
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(_MSC_VER) && \
+    !defined(__CUDACC__) && (defined(__clang__) || __GNUC__ >= 5)
+#define MXNET_SIMD_MULTIVERSION 1
+#include <immintrin.h>
+#endif
+
+namespace mxnet {
+namespace op {
+namespace simd {
+
+inline bool SIMDElemwiseEnabled() {
+  static const bool enabled = dmlc::GetEnv("MXNET_SIMD_ELEMWISE", true);
+  return enabled;
+}
+
+#if defined(MXNET_SIMD_MULTIVERSION)
+
+inline bool SupportsAVX512F() {
+  static const bool support = __builtin_cpu_supports("avx512f");
+  return support;
+}
+
+inline bool SupportsAVX2() {
+  static const bool support = __builtin_cpu_supports("avx2");
+  return support;
+}
+
+/*!
+ * \brief expands to the AVX-512, AVX2 and scalar versions of one float32
+ * binary kernel. The vector versions are compiled with target attributes
+ * so they are valid in a generic build and only run after the cpuid check.
+ */
+#define MXNET_SIMD_BINARY_KERNEL(name, vop512, vop256, sexpr)                  \
+  __attribute__((target("avx512f")))                                           \
+  inline void name##AVX512(float* out, const float* lhs, const float* rhs,     \
+                           size_t n) {                                         \
+    size_t i = 0;                                                              \
+    for (; i + 16 <= n; i += 16) {                                             \
+      const __m512 a = _mm512_loadu_ps(lhs + i);                               \
+      const __m512 b = _mm512_loadu_ps(rhs + i);                               \
+      _mm512_storeu_ps(out + i, vop512(a, b));                                 \
+    }                                                                          \
+    for (; i < n; ++i) out[i] = sexpr;                                         \
+  }                                                                            \
+  __attribute__((target("avx2")))                                              \
+  inline void name##AVX2(float* out, const float* lhs, const float* rhs,       \
+                         size_t n) {                                           \
+    size_t i = 0;                                                              \
+    for (; i + 8 <= n; i += 8) {                                               \
+      const __m256 a = _mm256_loadu_ps(lhs + i);                               \
+      const __m256 b = _mm256_loadu_ps(rhs + i);                               \
+      _mm256_storeu_ps(out + i, vop256(a, b));                                 \
+    }                                                                          \
+    for (; i < n; ++i) out[i] = sexpr;                                         \
+  }                                                                            \
+  inline void name##Scalar(float* out, const float* lhs, const float* rhs,     \
+                           size_t n) {                                         \
+    for (size_t i = 0; i < n; ++i) out[i] = sexpr;                             \
+  }                                                                            \
+  inline void name(float* out, const float* lhs, const float* rhs, size_t n) { \
+    if (SupportsAVX512F()) {                                                   \
+      name##AVX512(out, lhs, rhs, n);                                          \
+    } else if (SupportsAVX2()) {                                               \
+      name##AVX2(out, lhs, rhs, n);                                            \
+    } else {                                                                   \
+      name##Scalar(out, lhs, rhs, n);                                          \
+    }                                                                          \
+  }
+
+MXNET_SIMD_BINARY_KERNEL(PlusF32, _mm512_add_ps, _mm256_add_ps,
+                         lhs[i] + rhs[i])
+MXNET_SIMD_BINARY_KERNEL(MinusF32, _mm512_sub_ps, _mm256_sub_ps,
+                         lhs[i] - rhs[i])
+MXNET_SIMD_BINARY_KERNEL(MulF32, _mm512_mul_ps, _mm256_mul_ps,
+                         lhs[i] * rhs[i])
+MXNET_SIMD_BINARY_KERNEL(DivF32, _mm512_div_ps, _mm256_div_ps,
+                         lhs[i] / rhs[i])
+
+#undef MXNET_SIMD_BINARY_KERNEL
+
+/*!
+ * \brief per-op hook; ops without a hand-written kernel keep the
+ * generic Kernel::Launch path
+ */
+template<typename OP>
+struct SIMDBinaryKernel {
+  static const bool kImplemented = false;
+  inline static void Run(float*, const float*, const float*, size_t) {}
+};
+
+#define MXNET_SIMD_BINARY_OP(op, kernel)                                       \
+  template<>                                                                   \
+  struct SIMDBinaryKernel<op> {                                                \
+    static const bool kImplemented = true;                                     \
+    inline static void Run(float* out, const float* lhs, const float* rhs,     \
+                           size_t n) {                                         \
+      kernel(out, lhs, rhs, n);                                                \
+    }                                                                          \
+  };
+
+MXNET_SIMD_BINARY_OP(mshadow_op::plus, PlusF32)
+MXNET_SIMD_BINARY_OP(mshadow_op::minus, MinusF32)
+MXNET_SIMD_BINARY_OP(mshadow_op::mul, MulF32)
+MXNET_SIMD_BINARY_OP(mshadow_op::div, DivF32)
+
+#undef MXNET_SIMD_BINARY_OP
+
+/*!
+ * \brief expands to the AVX-512, AVX2 and scalar versions of one float32
+ * activation backward kernel computing gdata = grad * factor, where
+ * factor is 1 for positive outputs and the given negative-branch
+ * expression otherwise.
+ */
+#define MXNET_SIMD_ACT_BWD_KERNEL(name, vneg512, vneg256, sneg)                \
+  __attribute__((target("avx512f")))                                           \
+  inline void name##AVX512(float* gdata, const float* grad, const float* out,  \
+                           float slope, size_t n) {                            \
+    const __m512 vzero = _mm512_setzero_ps();                                  \
+    const __m512 vone = _mm512_set1_ps(1.f);                                   \
+    const __m512 vslope = _mm512_set1_ps(slope);                               \
+    size_t i = 0;                                                              \
+    for (; i + 16 <= n; i += 16) {                                             \
+      const __m512 o = _mm512_loadu_ps(out + i);                               \
+      const __m512 g = _mm512_loadu_ps(grad + i);                              \
+      const __mmask16 pos = _mm512_cmp_ps_mask(o, vzero, _CMP_GT_OQ);          \
+      const __m512 factor = _mm512_mask_blend_ps(pos, vneg512, vone);          \
+      _mm512_storeu_ps(gdata + i, _mm512_mul_ps(g, factor));                   \
+    }                                                                          \
+    for (; i < n; ++i)                                                         \
+      gdata[i] = grad[i] * (out[i] > 0.f ? 1.f : (sneg));                      \
+  }                                                                            \
+  __attribute__((target("avx2")))                                              \
+  inline void name##AVX2(float* gdata, const float* grad, const float* out,    \
+                         float slope, size_t n) {                              \
+    const __m256 vzero = _mm256_setzero_ps();                                  \
+    const __m256 vone = _mm256_set1_ps(1.f);                                   \
+    const __m256 vslope = _mm256_set1_ps(slope);                               \
+    size_t i = 0;                                                              \
+    for (; i + 8 <= n; i += 8) {                                               \
+      const __m256 o = _mm256_loadu_ps(out + i);                               \
+      const __m256 g = _mm256_loadu_ps(grad + i);                              \
+      const __m256 pos = _mm256_cmp_ps(o, vzero, _CMP_GT_OQ);                  \
+      const __m256 factor = _mm256_blendv_ps(vneg256, vone, pos);              \
+      _mm256_storeu_ps(gdata + i, _mm256_mul_ps(g, factor));                   \
+    }                                                                          \
+    for (; i < n; ++i)                                                         \
+      gdata[i] = grad[i] * (out[i] > 0.f ? 1.f : (sneg));                      \
+  }                                                                            \
+  inline void name##Scalar(float* gdata, const float* grad, const float* out,  \
+                           float slope, size_t n) {                            \
+    for (size_t i = 0; i < n; ++i)                                             \
+      gdata[i] = grad[i] * (out[i] > 0.f ? 1.f : (sneg));                      \
+  }                                                                            \
+  inline void name(float* gdata, const float* grad, const float* out,          \
+                   float slope, size_t n) {                                    \
+    if (SupportsAVX512F()) {                                                   \
+      name##AVX512(gdata, grad, out, slope, n);                                \
+    } else if (SupportsAVX2()) {                                               \
+      name##AVX2(gdata, grad, out, slope, n);                                  \
+    } else {                                                                   \
+      name##Scalar(gdata, grad, out, slope, n);                                \
+    }                                                                          \
+  }
+
+MXNET_SIMD_ACT_BWD_KERNEL(XeluGradF32, vslope, vslope, slope)
+MXNET_SIMD_ACT_BWD_KERNEL(EluGradF32, _mm512_add_ps(o, vslope),
+                          _mm256_add_ps(o, vslope), out[i] + slope)
+
+#undef MXNET_SIMD_ACT_BWD_KERNEL
+
+/*!
+ * \brief per-gradient-op hook; grads without a hand-written kernel keep
+ * the generic Kernel::Launch path
+ */
+template<typename GRAD_OP>
+struct SIMDActBackwardKernel {
+  static const bool kImplemented = false;
+  inline static void Run(float*, const float*, const float*, float, size_t) {}
+};
+
+#define MXNET_SIMD_ACT_BWD_OP(op, kernel)                                      \
+  template<>                                                                   \
+  struct SIMDActBackwardKernel<op> {                                           \
+    static const bool kImplemented = true;                                     \
+    inline static void Run(float* gdata, const float* grad, const float* out,  \
+                           float slope, size_t n) {                            \
+      kernel(gdata, grad, out, slope, n);                                      \
+    }                                                                          \
+  };
+
+MXNET_SIMD_ACT_BWD_OP(mshadow_op::xelu_grad, XeluGradF32)
+MXNET_SIMD_ACT_BWD_OP(mshadow_op::elu_grad, EluGradF32)
+
+#undef MXNET_SIMD_ACT_BWD_OP
+
+#endif  // MXNET_SIMD_MULTIVERSION
+
+/*!
+ * \brief run OP over contiguous float32 inputs with the widest SIMD
+ * kernel the CPU supports. Returns false when no hand-written kernel
+ * applies, in which case the caller falls back to Kernel::Launch.
+ * Only the write-to case is special-cased; accumulating requests are
+ * rare on this path and keep the generic kernels.
+ */
+template<typename xpu, typename OP, typename DType>
+struct SIMDBinary {
+  inline static bool Run(DType*, const DType*, const DType*, size_t) {
+    return false;
+  }
+};
+
+#if defined(MXNET_SIMD_MULTIVERSION)
+template<typename OP>
+struct SIMDBinary<cpu, OP, float> {
+  inline static bool Run(float* out, const float* lhs, const float* rhs,
+                         size_t n) {
+    if (!SIMDBinaryKernel<OP>::kImplemented || !SIMDElemwiseEnabled()) {
+      return false;
+    }
+    const int omp_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+    if (omp_threads < 2 || n < static_cast<size_t>(omp_threads) * 1024) {
+      SIMDBinaryKernel<OP>::Run(out, lhs, rhs, n);
+    } else {
+      // chunks stay multiples of a cache line so threads never split
+      // one vector's worth of output
+      const size_t chunk =
+          ((n / omp_threads + 63) / 64) * 64;
+      const int nchunks = static_cast<int>((n + chunk - 1) / chunk);
+#pragma omp parallel for num_threads(omp_threads)
+      for (int t = 0; t < nchunks; ++t) {
+        const size_t begin = static_cast<size_t>(t) * chunk;
+        const size_t end = std::min(n, begin + chunk);
+        SIMDBinaryKernel<OP>::Run(out + begin, lhs + begin, rhs + begin,
+                                  end - begin);
+      }
+    }
+    return true;
+  }
+};
+#endif  // MXNET_SIMD_MULTIVERSION
+
+/*!
+ * \brief run an activation backward (gdata = grad * GRAD_OP(out, slope))
+ * over contiguous float32 data with the widest SIMD kernel the CPU
+ * supports. Returns false when no hand-written kernel applies, in which
+ * case the caller falls back to Kernel::Launch. Write-to only, like
+ * SIMDBinary.
+ */
+template<typename xpu, typename GRAD_OP, typename DType>
+struct SIMDActBackward {
+  inline static bool Run(DType*, const DType*, const DType*, DType, size_t) {
+    return false;
+  }
+};
+
+#if defined(MXNET_SIMD_MULTIVERSION)
+template<typename GRAD_OP>
+struct SIMDActBackward<cpu, GRAD_OP, float> {
+  inline static bool Run(float* gdata, const float* grad, const float* out,
+                         float slope, size_t n) {
+    if (!SIMDActBackwardKernel<GRAD_OP>::kImplemented || !SIMDElemwiseEnabled()) {
+      return false;
+    }
+    const int omp_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+    if (omp_threads < 2 || n < static_cast<size_t>(omp_threads) * 1024) {
+      SIMDActBackwardKernel<GRAD_OP>::Run(gdata, grad, out, slope, n);
+    } else {
+      const size_t chunk =
+          ((n / omp_threads + 63) / 64) * 64;
+      const int nchunks = static_cast<int>((n + chunk - 1) / chunk);
+#pragma omp parallel for num_threads(omp_threads)
+      for (int t = 0; t < nchunks; ++t) {
+        const size_t begin = static_cast<size_t>(t) * chunk;
+        const size_t end = std::min(n, begin + chunk);
+        SIMDActBackwardKernel<GRAD_OP>::Run(gdata + begin, grad + begin,
+                                            out + begin, slope, end - begin);
+      }
+    }
+    return true;
+  }
+};
+#endif  // MXNET_SIMD_MULTIVERSION
+
+}  // namespace simd
+}  // namespace op
+}  // namespace mxnet
+#endif  // MXNET_OPERATOR_TENSOR_ELEMWISE_SIMD_INL_H_
@@ -34,15 +34,63 @@
 #include "../mshadow_op.h"
 #include "../mxnet_op.h"
 #include "../elemwise_op_common.h"
+#include "../../engine/openmp.h"
 #include "../../ndarray/ndarray_function.h"
 
 #if MSHADOW_USE_MKL == 1
 #include "../mkl_functions-inl.h"
 #endif  // MSHADOW_USE_MKL == 1
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif  // __SSE2__
+
 namespace mxnet {
 namespace op {
 
+/*!
+ * \brief Output size in bytes above which elementwise kernels write their
+ *  float32 results with streaming (non-temporal) stores. Outputs this large
+ *  are evicted before they are re-read, so keeping them out of the cache
+ *  avoids the read-for-ownership traffic that regular stores cost.
+ *  Set MXNET_NT_STORE_MIN_BYTES=0 to disable the streaming path.
+ */
+inline size_t NTStoreMinBytes() {
+  static const size_t min_bytes =
+    static_cast<size_t>(dmlc::GetEnv("MXNET_NT_STORE_MIN_BYTES", 1 << 26));
+  return min_bytes;
+}
+
+#if defined(__SSE2__)
+/*!
+ * \brief Apply OP elementwise, writing the output with streaming stores.
+ *  Each thread handles one contiguous block: scalar until its output pointer
+ *  is 16-byte aligned, then four elements per non-temporal store, scalar for
+ *  the tail.
+ */
+template<typename OP>
+inline void UnaryStreamingStoreLoop(const size_t size, float *out, const float *in) {
+  const size_t nthreads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+  #pragma omp parallel for num_threads(static_cast<int>(nthreads))
+  for (index_t t = 0; t < static_cast<index_t>(nthreads); ++t) {
+    size_t i = size * t / nthreads;
+    const size_t end = size * (t + 1) / nthreads;
+    for (; i < end && (reinterpret_cast<uintptr_t>(out + i) & 0xF); ++i) {
+      out[i] = OP::Map(in[i]);
+    }
+    for (; i + 4 <= end; i += 4) {
+      _mm_stream_ps(out + i, _mm_setr_ps(OP::Map(in[i]), OP::Map(in[i + 1]),
+                                         OP::Map(in[i + 2]), OP::Map(in[i + 3])));
+    }
+    for (; i < end; ++i) {
+      out[i] = OP::Map(in[i]);
+    }
+  }
+  // streaming stores are weakly ordered; fence before anyone reads the output
+  _mm_sfence();
+}
+#endif  // __SSE2__
+
 class OpBase {
  protected:
   /*! \brief simple kernel to set to a scalar value of arbitrary type */
@@ -234,6 +282,33 @@ class UnaryOp : public OpBase {
     }
   }
 
+  /*! \brief The streaming-store path never applies on GPU */
+  template<typename OP>
+  static bool TryStreamingStoreCompute(mshadow::Stream<gpu> *s, const TBlob &input,
+                                       const OpReqType req, const TBlob &output) {
+    return false;
+  }
+
+  /*!
+   * \brief Write the output with non-temporal stores when it is large enough
+   *  that caching it only costs bandwidth. Applies to freshly written
+   *  (kWriteTo) float32 outputs of at least MXNET_NT_STORE_MIN_BYTES.
+   * \return true if the operator was computed through the streaming path
+   */
+  template<typename OP>
+  static bool TryStreamingStoreCompute(mshadow::Stream<cpu> *s, const TBlob &input,
+                                       const OpReqType req, const TBlob &output) {
+#if defined(__SSE2__)
+    const size_t min_bytes = NTStoreMinBytes();
+    if (req == kWriteTo && output.type_flag_ == mshadow::kFloat32 &&
+        min_bytes != 0 && output.Size() * sizeof(float) >= min_bytes) {
+      UnaryStreamingStoreLoop<OP>(input.Size(), output.dptr<float>(), input.dptr<float>());
+      return true;
+    }
+#endif  // __SSE2__
+    return false;
+  }
+
   template<typename xpu, typename OP>
   static void Compute(const nnvm::NodeAttrs& attrs,
                       const OpContext& ctx,
@@ -241,6 +316,10 @@ class UnaryOp : public OpBase {
                       const std::vector<OpReqType>& req,
                       const std::vector<TBlob>& outputs) {
     mshadow::Stream<xpu> *s = ctx.get_stream<xpu>();
+    if (inputs[0].Size() != 0 &&
+        TryStreamingStoreCompute<OP>(s, inputs[0], req[0], outputs[0])) {
+      return;
+    }
     MSHADOW_TYPE_SWITCH(outputs[0].type_flag_, DType, {
       MXNET_ASSIGN_REQ_SWITCH(req[0], Req, {
         if (inputs[0].Size() != 0) {
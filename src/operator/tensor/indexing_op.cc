@@ -436,6 +436,10 @@ inline void SparseEmbeddingOpBackwardRspImpl<cpu>(const bool deterministic,
 }
 
 
+// below this many gathered elements the sort costs more than the atomics
+// it avoids
+static const index_t kGatherNDSortedAccessBound = 4096;
+
 template<typename DType, typename IType>
 inline typename std::enable_if<(!std::is_same<DType, mshadow::half::half_t>::value), void>::type
 GatherNDBackwardImpl(index_t N, index_t M, index_t K,
@@ -444,6 +448,51 @@ GatherNDBackwardImpl(index_t N, index_t M, index_t K,
                      const DType* data,
                      const IType* indices,
                      mshadow::Stream<cpu> *s) {
+  if (N >= kGatherNDSortedAccessBound) {
+    // sorted-access mode: sort gather positions by destination offset so
+    // duplicate indices form runs, then let each thread own the runs that
+    // start in its chunk. Accumulation needs no atomics and the writes
+    // walk the output in address order instead of jumping with every i.
+    std::vector<index_t> offsets(N);
+    std::vector<index_t> order(N);
+    const int nthread = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+#pragma omp parallel for num_threads(nthread)
+    for (index_t i = 0; i < N; ++i) {
+      index_t offset = 0;
+      for (index_t j = 0; j < M; ++j) {
+        offset += strides[j] * static_cast<index_t>(indices[j*N + i]);
+      }
+      offsets[i] = offset;
+      order[i] = i;
+    }
+    std::sort(order.begin(), order.end(),
+              [&offsets](index_t a, index_t b) { return offsets[a] < offsets[b]; });
+#pragma omp parallel num_threads(nthread)
+    {
+      const index_t chunk = (N + omp_get_num_threads() - 1) / omp_get_num_threads();
+      index_t begin = chunk * omp_get_thread_num();
+      const index_t end = std::min(N, begin + chunk);
+      // a run straddling the chunk boundary belongs to the thread owning
+      // its first element
+      while (begin > 0 && begin < end &&
+             offsets[order[begin]] == offsets[order[begin - 1]]) {
+        ++begin;
+      }
+      for (index_t i = begin; i < end;) {
+        const index_t offset = offsets[order[i]];
+        index_t r = i;
+        while (r < N && offsets[order[r]] == offset) {
+          const DType* src = data + order[r] * K;
+          for (index_t j = 0; j < K; ++j) {
+            out[offset + j] += src[j];
+          }
+          ++r;
+        }
+        i = r;
+      }
+    }
+    return;
+  }
 #pragma omp parallel for
   for (index_t i = 0; i < N; i++) {
     index_t offset = 0;
@@ -40,6 +40,7 @@
 #include "../mshadow_op.h"
 #include "../elemwise_op_common.h"
 #include "./util/tensor_util-inl.h"
+#include "./elemwise_unary_op.h"
 #include "../mxnet_op.h"
 #include "./sort_op.h"
 #include "./init_op.h"
@@ -139,6 +140,114 @@ inline void AddTakeGradLargeBatch(mshadow::Tensor<cpu, 2, DType> dst,
     dst[sorted[y]] += src[index[y]];
   }
 }
+
+/*!
+ * \brief CPU: Gradient accumulate of embedding matrix, dst[index[i]] += src[i],
+          parallelized by partitioning the destination rows across threads.
+          Each thread owns a contiguous row range and scans the whole index
+          list, applying only the updates that land in its range. The ranges
+          are disjoint, so no atomics are needed, and every destination row is
+          accumulated in index order by exactly one thread, so the result is
+          bitwise deterministic regardless of the thread count.
+ * \param dst destination
+ * \param index row index for each source row
+ * \param src source gradients
+ */
+template<bool clip = true, typename IndexType, typename DType>
+inline void AddTakeGradPartitioned(mshadow::Tensor<cpu, 2, DType> dst,
+                                   const mshadow::Tensor<cpu, 1, IndexType>& index,
+                                   const mshadow::Tensor<cpu, 2, DType>& src) {
+  const index_t K = dst.size(0);
+  const index_t num = index.size(0);
+  const index_t row_length = dst.size(1);
+  const int max_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+  const int nthreads = static_cast<int>(std::min<index_t>(max_threads, K));
+  // rescanning the index list per thread only pays off for sizable updates
+  if (nthreads < 2 || num * row_length < 65536) {
+    mshadow::AddTakeGrad<clip>(dst, index, src);
+    return;
+  }
+  const index_t chunk = (K + nthreads - 1) / nthreads;
+  #pragma omp parallel num_threads(nthreads)
+  {
+    const index_t row_begin = static_cast<index_t>(omp_get_thread_num()) * chunk;
+    const index_t row_end = std::min(K, row_begin + chunk);
+    for (index_t y = 0; y < num; ++y) {
+      index_t j = static_cast<index_t>(index[y]);
+      if (clip) {
+        if (j <= 0) j = 0;
+        else if (j >= K) j = K - 1;
+      } else {
+        j %= K;
+        if (j < 0) j += K;
+      }
+      if (j < row_begin || j >= row_end) continue;
+      DType* dst_row = dst[j].dptr_;
+      const DType* src_row = src[y].dptr_;
+      for (index_t x = 0; x < row_length; ++x) {
+        dst_row[x] += src_row[x];
+      }
+    }
+  }
+}
+
+template<bool clip = true, typename IndexType, typename DType>
+inline void AddTakeGradPartitioned(mshadow::Tensor<gpu, 2, DType> dst,
+                                   const mshadow::Tensor<gpu, 1, IndexType>& index,
+                                   const mshadow::Tensor<gpu, 2, DType>& src) {
+  mshadow::AddTakeGrad<clip>(dst, index, src);
+}
+
+/*!
+ * \brief CPU/GPU: Deterministic gradient accumulate of embedding matrix,
+          dst[index[i]] += src[i]. The indices are sorted together with their
+          original positions, then each destination row is reduced over its
+          sorted run in a fixed order by AddTakeGradLargeBatch, so no atomic
+          updates are involved and repeated runs produce bitwise identical
+          gradients while the sort and the segmented accumulation both stay
+          parallel. Selected on GPU when MXNET_ENFORCE_DETERMINISM is set.
+ * \param ctx operator context; temporary space is taken from the kTempSpace
+          resource requested by the backward op
+ * \param dst destination
+ * \param index row index for each source row
+ * \param src source gradients
+ */
+template<bool clip = true, typename xpu, typename IndexType, typename DType>
+inline void AddTakeGradSorted(const OpContext& ctx,
+                              mshadow::Tensor<xpu, 2, DType> dst,
+                              const mshadow::Tensor<xpu, 1, IndexType>& index,
+                              const mshadow::Tensor<xpu, 2, DType>& src) {
+  using namespace mxnet_op;
+  mshadow::Stream<xpu>* s = ctx.get_stream<xpu>();
+  const size_t num = index.size(0);
+  const size_t idx_bytes = num * sizeof(int);
+  const size_t temp_bytes = std::max(
+      SortByKeyWorkspaceSize<int, int, xpu>(num),
+      AddTakeGradLargeBatchWorkspaceSize<int, xpu>(num));
+  mshadow::Tensor<xpu, 1, char> workspace =
+      ctx.requested[0].get_space_typed<xpu, 1, char>(
+          mshadow::Shape1(2 * idx_bytes + temp_bytes), s);
+  int* sorted_idx_ptr = reinterpret_cast<int*>(workspace.dptr_);
+  int* original_idx_ptr = reinterpret_cast<int*>(workspace.dptr_ + idx_bytes);
+  mshadow::Tensor<xpu, 1, char> temp_storage(
+      workspace.dptr_ + 2 * idx_bytes, mshadow::Shape1(temp_bytes), s);
+  Kernel<mshadow_op::identity_with_cast, xpu>::Launch(
+      s, num, sorted_idx_ptr, index.dptr_);
+  if (clip) {
+    Kernel<op_with_req<mshadow_op::clip, kWriteTo>, xpu>::Launch(
+        s, num, sorted_idx_ptr, sorted_idx_ptr, 0, static_cast<int>(dst.size(0) - 1));
+  } else {
+    Kernel<op_with_req<mshadow_op::mod, kWriteTo>, xpu>::Launch(
+        s, num, sorted_idx_ptr, sorted_idx_ptr, static_cast<int>(dst.size(0)));
+  }
+  Kernel<range_fwd, xpu>::Launch(s, num, 1, 0, 1, kWriteTo, original_idx_ptr);
+  mshadow::Tensor<xpu, 1, int> sorted_idx(sorted_idx_ptr, mshadow::Shape1(num), s);
+  mshadow::Tensor<xpu, 1, int> original_idx(original_idx_ptr, mshadow::Shape1(num), s);
+  int num_bits = common::ilog2ui(static_cast<unsigned int>(num) - 1);
+  SortByKey(sorted_idx, original_idx, true, &temp_storage, 0, num_bits);
+  AddTakeGradLargeBatch(dst, sorted_idx, original_idx, src, &temp_storage);
+}
+
 template<typename ParamType>
 inline bool EmbeddingOpShape(const nnvm::NodeAttrs& attrs,
                              mxnet::ShapeVector *in_attrs,
@@ -538,7 +647,13 @@ void EmbeddingOpBackward(const nnvm::NodeAttrs& attrs,
         if (req[embedding::kWeight] == kWriteTo) {
           grad_in = scalar<DType>(0.0f);
         }
-        AddTakeGrad(grad_in, data, grad_out);
+        // the CPU path is already bitwise deterministic; on GPU the default
+        // atomic accumulation is not, so swap in the sort-based reduction
+        if (std::is_same<xpu, gpu>::value && common::EnforceDeterminism()) {
+          AddTakeGradSorted(ctx, grad_in, data, grad_out);
+        } else {
+          AddTakeGradPartitioned(grad_in, data, grad_out);
+        }
       } else {
         LOG(FATAL) << "wrong req";
       }
@@ -1055,10 +1170,16 @@ void TakeOpBackward(const nnvm::NodeAttrs& attrs,
           if (req[take_::kArr] == kWriteTo) {
             grad_in = scalar<DType>(0.0f);
           }
-          if (param.mode == take_::kClip) {
-            AddTakeGrad(grad_in, idx, grad_out);
+          if (std::is_same<xpu, gpu>::value && common::EnforceDeterminism()) {
+            if (param.mode == take_::kClip) {
+              AddTakeGradSorted(ctx, grad_in, idx, grad_out);
+            } else {
+              AddTakeGradSorted<false>(ctx, grad_in, idx, grad_out);
+            }
+          } else if (param.mode == take_::kClip) {
+            AddTakeGradPartitioned(grad_in, idx, grad_out);
           } else {
-            AddTakeGrad<false>(grad_in, idx, grad_out);
+            AddTakeGradPartitioned<false>(grad_in, idx, grad_out);
           }
         } else {
           LOG(FATAL) << "wrong req";
@@ -1232,6 +1353,58 @@ struct one_hot {
   }
 };
 
+/*!
+ * \brief Fused one_hot kernel writing a whole output row per index, so the
+ *  output is touched once instead of a full off_value fill followed by a
+ *  scatter of the on_values.
+ */
+struct one_hot_fill {
+  template<typename DType, typename IType>
+  MSHADOW_XINLINE static void Map(index_t i, DType* out, const IType* indices,
+                                  index_t depth, DType on_value, DType off_value) {
+    const index_t offset = i * depth;
+    const index_t j = static_cast<index_t>(indices[i]);
+    for (index_t k = 0; k < depth; ++k) {
+      out[offset + k] = (k == j) ? on_value : off_value;
+    }
+  }
+};
+
+#if defined(__SSE2__)
+/*!
+ * \brief one_hot for large float32 outputs: fill each row with streaming
+ *  stores so the mostly-off_value result does not displace the cache, then
+ *  drop the on_value in with a regular store.
+ */
+template<typename IType>
+inline void OneHotStreamingFill(float* out, const IType* indices,
+                                const index_t rows, const index_t depth,
+                                const float on_value, const float off_value) {
+  const int nthreads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+  const __m128 voff = _mm_set1_ps(off_value);
+  #pragma omp parallel for num_threads(nthreads)
+  for (index_t i = 0; i < rows; ++i) {
+    float* row = out + i * depth;
+    index_t k = 0;
+    for (; k < depth && (reinterpret_cast<uintptr_t>(row + k) & 0xF); ++k) {
+      row[k] = off_value;
+    }
+    for (; k + 4 <= depth; k += 4) {
+      _mm_stream_ps(row + k, voff);
+    }
+    for (; k < depth; ++k) {
+      row[k] = off_value;
+    }
+    const index_t j = static_cast<index_t>(indices[i]);
+    if (j >= 0 && j < depth) {
+      row[j] = on_value;
+    }
+  }
+  // streaming stores are weakly ordered; fence before anyone reads the output
+  _mm_sfence();
+}
+#endif  // __SSE2__
+
 template<typename xpu>
 void OneHotOpForward(const nnvm::NodeAttrs& attrs,
                      const OpContext& ctx,
@@ -1254,14 +1427,34 @@ void OneHotOpForward(const nnvm::NodeAttrs& attrs,
   using namespace mshadow::expr;
   mshadow::Stream<xpu> *s = ctx.get_stream<xpu>();
   MSHADOW_TYPE_SWITCH(outputs[0].type_flag_, DType, {  // output data type switch
-    mshadow::Tensor<xpu, 1, DType> out = outputs[0].FlatTo1D<xpu, DType>(s);
-    ASSIGN_DISPATCH(out, req[0], static_cast<DType>(off_value));
-    MXNET_ASSIGN_REQ_SWITCH(req[0], req_type, {  // request type switch
-      MSHADOW_TYPE_SWITCH(inputs[0].type_flag_, IType, {  // indices data type switch
-        Kernel<one_hot<req_type>, xpu>::Launch(s, inputs[0].Size(), outputs[0].dptr<DType>(),
-                                               inputs[0].dptr<IType>(), depth,
-                                               static_cast<DType>(on_value));
-      });
+    MSHADOW_TYPE_SWITCH(inputs[0].type_flag_, IType, {  // indices data type switch
+      if (std::is_same<xpu, cpu>::value && req[0] == kWriteTo) {
+        // fused fill+scatter: each row is written once instead of an
+        // off_value fill over the whole output followed by a scatter
+#if defined(__SSE2__)
+        if (std::is_same<DType, float>::value && depth >= 4 &&
+            outputs[0].Size() * sizeof(DType) >= NTStoreMinBytes()) {
+          OneHotStreamingFill(reinterpret_cast<float*>(outputs[0].dptr<DType>()),
+                              inputs[0].dptr<IType>(),
+                              static_cast<index_t>(inputs[0].Size()), depth,
+                              static_cast<float>(on_value),
+                              static_cast<float>(off_value));
+          return;
+        }
+#endif  // __SSE2__
+        Kernel<one_hot_fill, xpu>::Launch(s, inputs[0].Size(), outputs[0].dptr<DType>(),
+                                          inputs[0].dptr<IType>(), depth,
+                                          static_cast<DType>(on_value),
+                                          static_cast<DType>(off_value));
+      } else {
+        mshadow::Tensor<xpu, 1, DType> out = outputs[0].FlatTo1D<xpu, DType>(s);
+        ASSIGN_DISPATCH(out, req[0], static_cast<DType>(off_value));
+        MXNET_ASSIGN_REQ_SWITCH(req[0], req_type, {  // request type switch
+          Kernel<one_hot<req_type>, xpu>::Launch(s, inputs[0].Size(), outputs[0].dptr<DType>(),
+                                                 inputs[0].dptr<IType>(), depth,
+                                                 static_cast<DType>(on_value));
+        });
+      }
     });
   });
 }
@@ -38,6 +38,7 @@
 #include "./init_op.h"
 #include "../../common/static_array.h"
 #include "./slice-inl.h"
+#include "./elemwise_simd-inl.h"
 
 #if MXNET_USE_CUDA
 #include <thrust/device_vector.h>
@@ -263,6 +264,106 @@ struct TransposeParam : public dmlc::Parameter<TransposeParam> {
 };
 
 
+#if defined(MXNET_SIMD_MULTIVERSION)
+/*!
+ * \brief transpose one full 8x8 float tile entirely in ymm registers.
+ * Compiled with a target attribute so it is valid in a generic build;
+ * callers gate on simd::SupportsAVX2().
+ */
+__attribute__((target("avx2")))
+inline void Transpose8x8AVX2(const float* in, index_t ld_in,
+                             float* out, index_t ld_out) {
+  __m256 r0 = _mm256_loadu_ps(in + 0 * ld_in);
+  __m256 r1 = _mm256_loadu_ps(in + 1 * ld_in);
+  __m256 r2 = _mm256_loadu_ps(in + 2 * ld_in);
+  __m256 r3 = _mm256_loadu_ps(in + 3 * ld_in);
+  __m256 r4 = _mm256_loadu_ps(in + 4 * ld_in);
+  __m256 r5 = _mm256_loadu_ps(in + 5 * ld_in);
+  __m256 r6 = _mm256_loadu_ps(in + 6 * ld_in);
+  __m256 r7 = _mm256_loadu_ps(in + 7 * ld_in);
+  __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+  __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+  __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+  __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+  __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+  __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+  __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+  __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+  __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+  __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+  __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+  _mm256_storeu_ps(out + 0 * ld_out, _mm256_permute2f128_ps(s0, s4, 0x20));
+  _mm256_storeu_ps(out + 1 * ld_out, _mm256_permute2f128_ps(s1, s5, 0x20));
+  _mm256_storeu_ps(out + 2 * ld_out, _mm256_permute2f128_ps(s2, s6, 0x20));
+  _mm256_storeu_ps(out + 3 * ld_out, _mm256_permute2f128_ps(s3, s7, 0x20));
+  _mm256_storeu_ps(out + 4 * ld_out, _mm256_permute2f128_ps(s0, s4, 0x31));
+  _mm256_storeu_ps(out + 5 * ld_out, _mm256_permute2f128_ps(s1, s5, 0x31));
+  _mm256_storeu_ps(out + 6 * ld_out, _mm256_permute2f128_ps(s2, s6, 0x31));
+  _mm256_storeu_ps(out + 7 * ld_out, _mm256_permute2f128_ps(s3, s7, 0x31));
+}
+
+/*!
+ * \brief cache-blocked float transpose whose full tiles go through the
+ * 8x8 in-register kernel. The omp loops stay in this plain function:
+ * omp-outlined bodies do not inherit the callee's target attribute.
+ */
+inline void Transpose2DBlockedAVX2(const float* in, float* out,
+                                   index_t row, index_t col) {
+  const index_t blocksize = 64;
+  #ifdef _MSC_VER
+    #pragma omp parallel for
+  #else
+    #pragma omp parallel for collapse(2)
+  #endif  // _MSC_VER
+  for (index_t i = 0; i < row; i += blocksize) {
+    for (index_t j = 0; j < col; j += blocksize) {
+      const index_t row_end = std::min(row, i + blocksize);
+      const index_t col_end = std::min(col, j + blocksize);
+      index_t a = j;
+      for (; a + 8 <= col_end; a += 8) {
+        index_t b = i;
+        for (; b + 8 <= row_end; b += 8) {
+          Transpose8x8AVX2(in + b * col + a, col, out + a * row + b, row);
+        }
+        for (index_t aa = a; aa < a + 8; ++aa) {
+          for (index_t bb = b; bb < row_end; ++bb) {
+            out[aa * row + bb] = in[bb * col + aa];
+          }
+        }
+      }
+      for (; a < col_end; ++a) {
+        for (index_t b = i; b < row_end; ++b) {
+          out[a * row + b] = in[b * col + a];
+        }
+      }
+    }
+  }
+}
+#endif  // MXNET_SIMD_MULTIVERSION
+
+/*!
+ * \brief run the vectorized 2D transpose when a kernel exists for the
+ * dtype and the CPU supports it; returns false to keep the scalar
+ * blocked path otherwise.
+ */
+template<typename DType>
+inline bool Transpose2DSIMD(const DType*, DType*, index_t, index_t) {
+  return false;
+}
+
+#if defined(MXNET_SIMD_MULTIVERSION)
+inline bool Transpose2DSIMD(const float* in, float* out, index_t row, index_t col) {
+  if (!simd::SupportsAVX2() || row < 8 || col < 8) return false;
+  Transpose2DBlockedAVX2(in, out, row, col);
+  return true;
+}
+#endif  // MXNET_SIMD_MULTIVERSION
+
 /*!
  * \brief This function performs transpose operation on a 2D matrix by utilizing the L1 cache
  * \param in  input tensor
@@ -272,6 +373,10 @@ struct TransposeParam : public dmlc::Parameter<TransposeParam> {
  */
 template<typename DType>
 MSHADOW_XINLINE void Transpose2D(const DType *in, DType *out, index_t row, index_t col) {
+#if defined(MXNET_SIMD_MULTIVERSION)
+  // host-only; the guard keeps this call out of nvcc's device pass
+  if (Transpose2DSIMD(in, out, row, col)) return;
+#endif  // MXNET_SIMD_MULTIVERSION
   // ensure cache line hits and prevent cache miss for any configuration
   // L1 cache size to be utilized = 32kb = 2^15
   // Largest size of a single unit of any dtype <= 8 byte = 2^3
@@ -328,6 +433,29 @@ void TransposeImpl(RunContext ctx,
     return;
   }
 #endif
+  // batched last-two-axes swap, e.g. (0, 2, 1) or (0, 1, 3, 2): every
+  // leading slice is an independent contiguous 2D transpose, so reuse
+  // the blocked 2D kernel instead of the generic expression path
+  if (axes.ndim() >= 3 && ctx.get_ctx().dev_mask() == cpu::kDevMask) {
+    bool last_two_swap = axes[axes.ndim() - 2] == axes.ndim() - 1 &&
+                         axes[axes.ndim() - 1] == axes.ndim() - 2;
+    for (int i = 0; i < axes.ndim() - 2 && last_two_swap; ++i) {
+      last_two_swap = (axes[i] == i);
+    }
+    if (last_two_swap) {
+      const index_t batch = src.shape_.ProdShape(0, src.ndim() - 2);
+      const index_t row = src.shape_[src.ndim() - 2];
+      const index_t col = src.shape_[src.ndim() - 1];
+      MSHADOW_TYPE_SWITCH(ret.type_flag_, DType, {
+        const DType* in = src.dptr<DType>();
+        DType* out = ret.dptr<DType>();
+        for (index_t b = 0; b < batch; ++b) {
+          Transpose2D<DType>(in + b * row * col, out + b * row * col, row, col);
+        }
+      });
+      return;
+    }
+  }
   MSHADOW_TYPE_SWITCH(ret.type_flag_, DType, {
     switch (axes.ndim()) {
      case 0: {
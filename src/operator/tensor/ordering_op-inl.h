@@ -225,9 +225,13 @@ MSHADOW_FORCE_INLINE void TopKSort(const Tensor<cpu, 1, DType>& dat,
                   [&](const index_t& i1, const index_t& i2){
           return vals[i1] < vals[i2]; });
       } else {
-        std::partial_sort(indices, indices+K, indices+N,
-                          [&](const index_t& i1, const index_t& i2){
-          return vals[i1] < vals[i2]; });
+        // select the top-K in O(N), then sort only those K elements; the
+        // heap-based partial_sort is O(N log K) which hurts for small K
+        // over very wide axes
+        auto comp = [&](const index_t& i1, const index_t& i2){
+          return vals[i1] < vals[i2]; };
+        std::nth_element(indices, indices+K-1, indices+N, comp);
+        std::sort(indices, indices+K, comp);
       }
     } else {
       if (full_sort) {
@@ -235,9 +239,10 @@ MSHADOW_FORCE_INLINE void TopKSort(const Tensor<cpu, 1, DType>& dat,
                   [&](const index_t& i1, const index_t& i2){
           return vals[i1] > vals[i2]; });
       } else {
-        std::partial_sort(indices, indices+K, indices+N,
-                          [&](const index_t& i1, const index_t& i2){
-          return vals[i1] > vals[i2]; });
+        auto comp = [&](const index_t& i1, const index_t& i2){
+          return vals[i1] > vals[i2]; };
+        std::nth_element(indices, indices+K-1, indices+N, comp);
+        std::sort(indices, indices+K, comp);
       }
     }
     for (index_t j = 0; j < K; ++j) {
@@ -338,9 +343,15 @@ MSHADOW_FORCE_INLINE void TopKSort(const Tensor<gpu, 1, DType>& dat,
                                    const Tensor<gpu, 1, char>& work,
                                    index_t K, index_t N, bool is_ascend,
                                    Stream<gpu> *s) {
-  // Use full sort for all but very small K for which we
-  // can do a partial sort entirely within shared memory.
-  const bool full_sort(K > 5);
+  // Use the batched in-shared-memory selection whenever the per-block
+  // buffers fit; shrink the block if needed so that medium K values
+  // (e.g. top-10/top-20 ranking) avoid the three full device-wide sorts.
+  const size_t smem_limit = 44 * 1024;
+  int nthreads(mshadow::cuda::kBaseThreadNum);
+  while (nthreads > 64 && nthreads * K * (sizeof(index_t) + sizeof(DType)) > smem_limit) {
+    nthreads >>= 1;
+  }
+  const bool full_sort(nthreads * K * (sizeof(index_t) + sizeof(DType)) > smem_limit);
   // Batch size.
   const index_t M(dat.size(0)/N);
   if (full_sort) {
@@ -359,8 +370,7 @@ MSHADOW_FORCE_INLINE void TopKSort(const Tensor<gpu, 1, DType>& dat,
       mxnet::op::SortByKey(batch_id, ind, true, &sort_work);
     }
   } else {
-    const int nthreads(mshadow::cuda::kBaseThreadNum);
-    PartialSortSmallK<<<M, nthreads, nthreads*K*(sizeof(int)+sizeof(DType)),
+    PartialSortSmallK<<<M, nthreads, nthreads*K*(sizeof(index_t)+sizeof(DType)),
                         mshadow::Stream<gpu>::GetStream(s)>>>
                         (K, N, dat.dptr_, ind.dptr_, is_ascend);
   }
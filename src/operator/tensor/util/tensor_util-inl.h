@@ -27,10 +27,55 @@
 
 #include <mxnet/base.h>
 #include <mxnet/operator.h>
+#include <algorithm>
+#include <vector>
+#include "../../mxnet_op.h"
 
 namespace mxnet {
 namespace op {
 
+/*!
+ * \brief In-place parallel inclusive scan of x[0..n). Each thread scans one
+ * block, the per-block totals are scanned serially (one element per thread),
+ * then every block adds the offset of the blocks before it. Small inputs
+ * stay on the serial loop since a parallel region costs more than the scan.
+ */
+template<typename IType>
+inline void ParallelInclusiveScan(IType* x, const nnvm::dim_t n) {
+  using nnvm::dim_t;
+  const int max_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+  if (max_threads < 2 || n < (1 << 14)) {
+    for (dim_t i = 1; i < n; ++i) {
+      x[i] += x[i-1];
+    }
+    return;
+  }
+  std::vector<IType> block_sum(max_threads + 1, 0);
+  #pragma omp parallel num_threads(max_threads)
+  {
+    const int nt = omp_get_num_threads();
+    const int tid = omp_get_thread_num();
+    const dim_t block = (n + nt - 1) / nt;
+    const dim_t begin = std::min(block * tid, n);
+    const dim_t end = std::min(begin + block, n);
+    IType sum = 0;
+    for (dim_t i = begin; i < end; ++i) {
+      sum += x[i];
+      x[i] = sum;
+    }
+    block_sum[tid + 1] = sum;
+    #pragma omp barrier
+    #pragma omp single
+    for (int t = 0; t < nt; ++t) {
+      block_sum[t + 1] += block_sum[t];
+    }
+    const IType offset = block_sum[tid];
+    for (dim_t i = begin; i < end; ++i) {
+      x[i] += offset;
+    }
+  }
+}
+
 /*!
  * \brief kernel to flag indices that appear in row_idx array with 1.
  */
@@ -23,6 +23,7 @@
  * \brief implements profiler
  */
 #include <dmlc/base.h>
+#include <dmlc/json.h>
 #include <dmlc/logging.h>
 #include <mxnet/base.h>
 #include <fstream>
@@ -243,6 +244,46 @@ void AggregateStats::DumpJson(std::ostream& os, int sort_by, int ascending) {
   os.copyfmt(state);
 }
 
+void AggregateStats::DumpTuningHints(std::ostream& os) {
+  // operators whose average runtime is within a few dispatch overheads;
+  // their cost is dominated by scheduling, not compute
+  const uint64_t short_op_us = dmlc::GetEnv("MXNET_TUNING_SHORT_OP_US", 50);
+  uint64_t total_time = 0;
+  uint64_t short_time = 0;
+  {
+    std::unique_lock<std::mutex> lk(m_);
+    auto it = stats_.find("operator");
+    if (it != stats_.end()) {
+      for (const auto& kv : it->second) {
+        const StatData& data = kv.second;
+        if (data.type_ != StatData::kDuration || data.total_count_ == 0)
+          continue;
+        total_time += data.total_aggregate_;
+        if (data.total_aggregate_ / data.total_count_ <= short_op_us)
+          short_time += data.total_aggregate_;
+      }
+    }
+  }
+  const double short_fraction =
+      total_time != 0 ? static_cast<double>(short_time) / total_time : 0.0;
+  // more aggressive bulking and fusion the more time dispatch-bound ops eat;
+  // 15 matches the MXNET_EXEC_BULK_EXEC_MAX_NODE_TRAIN default
+  int bulk_size = 15;
+  if (short_fraction > 0.5) {
+    bulk_size = 64;
+  } else if (short_fraction > 0.2) {
+    bulk_size = 32;
+  }
+  std::map<std::string, int> hints;
+  hints["bulk_size"] = bulk_size;
+  hints["fuse_pointwise"] = short_fraction > 0.2 ? 1 : 0;
+  // diagnostic only; consumers ignore unknown keys
+  hints["short_op_permille"] = static_cast<int>(short_fraction * 1000);
+  dmlc::JSONWriter writer(&os);
+  writer.Write(hints);
+  os << std::endl;
+}
+
 void AggregateStats::clear() {
   std::unique_lock<std::mutex> lk(m_);
   stats_.clear();
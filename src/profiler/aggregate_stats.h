@@ -68,6 +68,12 @@ class AggregateStats {
    * \param ascending whether to sort ascendingly
    */
   void DumpJson(std::ostream& os, int sort_by, int ascending);
+  /*!
+   * \brief Emit machine-readable tuning hints derived from the collected
+   *  operator statistics, for consumption via MXNET_TUNING_HINTS_FILE
+   *  on the next startup.
+   */
+  void DumpTuningHints(std::ostream& os);
   /*!
    * \brief Delete all of the current statistics
    */
@@ -26,6 +26,7 @@
 #include <dmlc/logging.h>
 #include <dmlc/omp.h>
 #include <mxnet/base.h>
+#include <algorithm>
 #include <fstream>
 #include <thread>
 #include "./profiler.h"
@@ -79,6 +80,10 @@ Profiler::Profiler()
   this->profile_stat[cpu_num_ + gpu_num_ + 1].dev_name_ = "cpu shared/";
 
   this->mode_ = dmlc::GetEnv("MXNET_PROFILER_MODE", this->mode_);
+  this->sample_rate_ = static_cast<uint64_t>(
+      std::max(1, dmlc::GetEnv("MXNET_PROFILER_SAMPLE_RATE", 1)));
+  this->max_pending_records_ = static_cast<uint64_t>(
+      std::max(0, dmlc::GetEnv("MXNET_PROFILER_MAX_RECORDS", 0)));
   if (dmlc::GetEnv("MXNET_PROFILER_AUTOSTART", 0)) {
     this->state_ = ProfilerState::kRunning;
     this->enable_output_ = true;
@@ -112,6 +117,16 @@ Profiler* Profiler::Get(std::shared_ptr<Profiler> *sp) {
   return prof.get();
 }
 
+void Profiler::AggregateDropped(ProfileStat *stat) {
+  dropped_records_.fetch_add(1, std::memory_order_relaxed);
+  // Copy the shared pointer in case SetConfig() resets aggregate_stats_;
+  // OnProfileStat() itself is mutex-protected.
+  std::shared_ptr<AggregateStats> ptr_aggregate_stats = aggregate_stats_;
+  if (ptr_aggregate_stats) {
+    ptr_aggregate_stats->OnProfileStat(*stat);
+  }
+}
+
 void Profiler::SetState(ProfilerState state) {
   std::lock_guard<std::recursive_mutex> lock{this->m_};
   this->state_ = state;
@@ -206,6 +221,9 @@ void Profiler::DumpProfile(bool perform_cleanup) {
     ProfileStat *_opr_stat;
     while (d.opr_exec_stats_->try_dequeue(_opr_stat)) {
       CHECK_NOTNULL(_opr_stat);
+      if (max_pending_records_ != 0) {
+        pending_records_.fetch_sub(1, std::memory_order_relaxed);
+      }
       std::unique_ptr<ProfileStat> opr_stat(_opr_stat);  // manage lifecycle
       opr_stat->process_id_ = i;  // lie and set process id to be the device number
       file << ",\n" << std::endl;
@@ -221,6 +239,9 @@ void Profiler::DumpProfile(bool perform_cleanup) {
   ProfileStat *_profile_stat;
   while (general_stats_.opr_exec_stats_->try_dequeue(_profile_stat)) {
     CHECK_NOTNULL(_profile_stat);
+    if (max_pending_records_ != 0) {
+      pending_records_.fetch_sub(1, std::memory_order_relaxed);
+    }
     file << ",";
     std::unique_ptr<ProfileStat> profile_stat(_profile_stat);  // manage lifecycle
     CHECK_NE(profile_stat->categories_.c_str()[0], '\0') << "Category must be set";
@@ -248,6 +269,11 @@ void Profiler::DumpProfile(bool perform_cleanup) {
     file << "    ]," << std::endl;
     file << "    \"displayTimeUnit\": \"ms\"" << std::endl;
     file << "}" << std::endl;
+    const uint64_t dropped = dropped_records_.load(std::memory_order_relaxed);
+    if (dropped) {
+      LOG(INFO) << "Profiler dropped " << dropped << " records from the trace due to "
+                << "MXNET_PROFILER_MAX_RECORDS; they are still counted in aggregate stats.";
+    }
   }
   enable_output_ = continuous_dump_ && !last_pass;  // If we're appending, then continue.
                                                     // Otherwise, profiling stops.
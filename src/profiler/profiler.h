@@ -33,6 +33,7 @@
 #include <mutex>
 #include <memory>
 #include <array>
+#include <atomic>
 #include "./vtune.h"
 #include "./aggregate_stats.h"
 #include "./nvtx.h"
@@ -317,6 +318,10 @@ class Profiler {
   template<typename StatType, typename SetExtraInfoFunction, typename ...Args>
   void AddNewProfileStat(SetExtraInfoFunction set_extra_info_function, Args... args) {
     if (!paused_) {
+      if (sample_rate_ > 1 &&
+          event_counter_.fetch_add(1, std::memory_order_relaxed) % sample_rate_ != 0) {
+        return;
+      }
       std::unique_ptr<StatType> stat = CreateProfileStat<StatType>(args...);
       set_extra_info_function(stat.get());
       AddProfileStat(&stat);
@@ -426,9 +431,38 @@ class Profiler {
    */
   template<typename StatType>
   inline void AddProfileStat(std::unique_ptr<StatType> *stat) {
+    if (!ReserveRecordSlot()) {
+      AggregateDropped(stat->get());
+      return;
+    }
     general_stats_.opr_exec_stats_->enqueue(stat->release());
   }
 
+  /*!
+   * \brief Try to reserve one slot in the pending record budget
+   * \return true if the record may be enqueued, false if the cap is reached
+   * \note MXNET_PROFILER_MAX_RECORDS=0 disables the cap
+   */
+  inline bool ReserveRecordSlot() {
+    if (max_pending_records_ == 0) {
+      return true;
+    }
+    uint64_t cur = pending_records_.load(std::memory_order_relaxed);
+    while (cur < max_pending_records_) {
+      if (pending_records_.compare_exchange_weak(cur, cur + 1, std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /*!
+   * \brief Fold a record that exceeded the memory budget into the aggregate
+   *        statistics (if enabled) instead of keeping it for the trace
+   * \param stat The statistic object; still owned by the caller
+   */
+  void AggregateDropped(ProfileStat *stat);
+
   /*! \brief generate device information following chrome profile file format */
   void EmitPid(std::ostream *os, const std::string& name, size_t pid);
 
@@ -472,6 +506,16 @@ class Profiler {
   /*! \brief Maintain in-memory aggregate stats for print output.
    *  \warning This has a negative performance impact */
   std::shared_ptr<AggregateStats> aggregate_stats_ = nullptr;
+  /*! \brief record every Nth event (MXNET_PROFILER_SAMPLE_RATE, 1 = record all) */
+  uint64_t sample_rate_ = 1;
+  /*! \brief cap on records held in memory (MXNET_PROFILER_MAX_RECORDS, 0 = unbounded) */
+  uint64_t max_pending_records_ = 0;
+  /*! \brief events seen since startup, for sampling */
+  std::atomic<uint64_t> event_counter_{0};
+  /*! \brief records currently enqueued and awaiting a dump */
+  std::atomic<uint64_t> pending_records_{0};
+  /*! \brief records folded into aggregate stats instead of the trace */
+  std::atomic<uint64_t> dropped_records_{0};
   /*! \brief Asynchronous operation thread lifecycle control object */
   std::shared_ptr<dmlc::ThreadGroup> thread_group_ = std::make_shared<dmlc::ThreadGroup>();
   /* !\brief pids */
@@ -1306,6 +1350,10 @@ inline size_t Profiler::DeviceIndex(mxnet::Context::DeviceType dev_type, int32_t
 template<>
 inline void Profiler::AddProfileStat<ProfileOperator::OprExecStat>(
   std::unique_ptr<ProfileOperator::OprExecStat> *opr_stat) {
+  if (!ReserveRecordSlot()) {
+    AggregateDropped(opr_stat->get());
+    return;
+  }
   const size_t idx = DeviceIndex((*opr_stat)->dev_type_, (*opr_stat)->dev_id_);
   CHECK_LT(idx, DeviceCount());
   DeviceStats& dev_stat = profile_stat[idx];
@@ -0,0 +1,222 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2019 by Contributors
+ * \file runtime_stats.h
+ * \brief Always-on cumulative counters for production monitoring.
+ */
+#ifndef MXNET_PROFILER_RUNTIME_STATS_H_
+#define MXNET_PROFILER_RUNTIME_STATS_H_
+
+#include <dmlc/parameter.h>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <string>
+
+namespace mxnet {
+namespace profiler {
+
+/*!
+ * \brief Cumulative runtime counters cheap enough to stay enabled in
+ *  production, unlike the profiler which is built for traces.
+ *
+ *  Every update is one or two relaxed atomic adds, so the engine and
+ *  storage hot paths pay a few nanoseconds per event. The counters are
+ *  polled (and optionally reset) through MXRuntimeStatsDump; a snapshot
+ *  taken while the engine runs may be slightly inconsistent between
+ *  counters, which is fine for monitoring. Disable the clock reads and
+ *  updates entirely with MXNET_RUNTIME_STATS=0.
+ */
+class RuntimeStats {
+ public:
+  /*! \brief number of FnProperty values tracked per op class */
+  static constexpr int kNumOpClasses = 8;
+  /*! \brief number of scheduling lanes tracked (background, default, realtime) */
+  static constexpr int kNumLanes = 3;
+
+  /*!
+   * \brief scheduling lane of a push, from the sign of its priority.
+   *  Matches the named lanes on Engine: negative priorities are the
+   *  background lane, zero the default lane, positive the realtime lane.
+   * \param priority the effective push priority
+   * \return lane index in [0, kNumLanes)
+   */
+  static inline int LaneOf(int priority) {
+    return priority < 0 ? 0 : (priority == 0 ? 1 : 2);
+  }
+
+  /*! \return the singleton stats instance */
+  static RuntimeStats* Get() {
+    static RuntimeStats inst;
+    return &inst;
+  }
+
+  /*! \return whether stats collection is enabled */
+  inline bool enabled() const {
+    return enabled_;
+  }
+
+  /*! \return nanoseconds since the steady clock epoch */
+  static inline uint64_t NowNs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  /*! \brief an op was pushed to the engine */
+  inline void OpPushed() {
+    queue_depth_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief an op completed.
+   * \param op_class the FnProperty of the op, cast to int
+   * \param time_ns wall time from execution start to completion
+   */
+  inline void OpCompleted(int op_class, uint64_t time_ns) {
+    queue_depth_.fetch_sub(1, std::memory_order_relaxed);
+    if (op_class < 0 || op_class >= kNumOpClasses) op_class = 0;
+    op_count_[op_class].fetch_add(1, std::memory_order_relaxed);
+    op_time_ns_[op_class].fetch_add(time_ns, std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief an op was admitted to a scheduling lane.
+   *
+   *  The lane gauges stay live even with MXNET_RUNTIME_STATS=0: engine
+   *  admission control reads them, so unlike the cumulative counters
+   *  they are not optional instrumentation.
+   * \param lane lane index from LaneOf
+   */
+  inline void LanePushed(int lane) {
+    lane_depth_[lane].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief an op left its scheduling lane by completing.
+   * \param lane lane index from LaneOf
+   */
+  inline void LaneCompleted(int lane) {
+    lane_depth_[lane].fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  /*!
+   * \return ops admitted to the lane but not yet completed
+   * \param lane lane index from LaneOf
+   */
+  inline int64_t LaneDepth(int lane) const {
+    return lane_depth_[lane].load(std::memory_order_relaxed);
+  }
+
+  /*! \brief a fast-failing push was rejected by a lane depth limit */
+  inline void PushRejected() {
+    push_rejects_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief memory was requested from a storage manager.
+   * \param bytes size of the request
+   */
+  inline void RecordAlloc(size_t bytes) {
+    alloc_count_.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  /*! \brief a pooled allocation was served from the pool */
+  inline void PoolHit() {
+    pool_hits_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /*! \brief a pooled allocation had to fall through to the device */
+  inline void PoolMiss() {
+    pool_misses_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief Dump all counters as a single JSON object.
+   * \param reset whether to zero the cumulative counters after reading
+   * \return the JSON string
+   */
+  std::string Dump(bool reset) {
+    static const char* op_class_names[kNumOpClasses] = {
+      "Normal", "CopyFromGPU", "CopyToGPU", "CPUPrioritized",
+      "Async", "DeleteVar", "GPUPrioritized", "NoSkip"
+    };
+    std::ostringstream os;
+    os << "{\"queue_depth\":" << queue_depth_.load(std::memory_order_relaxed)
+       << ",\"op_classes\":{";
+    for (int c = 0; c < kNumOpClasses; ++c) {
+      if (c) os << ',';
+      os << '"' << op_class_names[c] << "\":{\"count\":"
+         << Read(&op_count_[c], reset) << ",\"time_ns\":"
+         << Read(&op_time_ns_[c], reset) << '}';
+    }
+    static const char* lane_names[kNumLanes] = {
+      "background", "default", "realtime"
+    };
+    os << "},\"lane_depth\":{";
+    for (int l = 0; l < kNumLanes; ++l) {
+      if (l) os << ',';
+      os << '"' << lane_names[l] << "\":"
+         << lane_depth_[l].load(std::memory_order_relaxed);
+    }
+    os << "},\"push_rejects\":" << Read(&push_rejects_, reset);
+    os << ",\"alloc\":{\"count\":" << Read(&alloc_count_, reset)
+       << ",\"bytes\":" << Read(&alloc_bytes_, reset)
+       << "},\"pool\":{\"hits\":" << Read(&pool_hits_, reset)
+       << ",\"misses\":" << Read(&pool_misses_, reset) << "}}";
+    return os.str();
+  }
+
+ private:
+  RuntimeStats() : enabled_(dmlc::GetEnv("MXNET_RUNTIME_STATS", true)) {}
+
+  static inline uint64_t Read(std::atomic<uint64_t>* counter, bool reset) {
+    return reset ? counter->exchange(0, std::memory_order_relaxed)
+                 : counter->load(std::memory_order_relaxed);
+  }
+
+  /*! \brief whether collection is enabled (MXNET_RUNTIME_STATS) */
+  const bool enabled_;
+  /*! \brief ops pushed but not yet completed; never reset */
+  std::atomic<int64_t> queue_depth_{0};
+  /*! \brief per-lane ops admitted but not yet completed; never reset */
+  std::atomic<int64_t> lane_depth_[kNumLanes]{};
+  /*! \brief fast-failing pushes rejected by a lane depth limit */
+  std::atomic<uint64_t> push_rejects_{0};
+  /*! \brief completed ops per FnProperty */
+  std::atomic<uint64_t> op_count_[kNumOpClasses]{};
+  /*! \brief cumulative push-to-completion wall time per FnProperty */
+  std::atomic<uint64_t> op_time_ns_[kNumOpClasses]{};
+  /*! \brief storage allocations served */
+  std::atomic<uint64_t> alloc_count_{0};
+  /*! \brief cumulative bytes requested from storage */
+  std::atomic<uint64_t> alloc_bytes_{0};
+  /*! \brief pooled allocations served from the pool */
+  std::atomic<uint64_t> pool_hits_{0};
+  /*! \brief pooled allocations that went to the device allocator */
+  std::atomic<uint64_t> pool_misses_{0};
+};
+
+}  // namespace profiler
+}  // namespace mxnet
+
+#endif  // MXNET_PROFILER_RUNTIME_STATS_H_
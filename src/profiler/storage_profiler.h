@@ -20,7 +20,13 @@
 #define MXNET_PROFILER_STORAGE_PROFILER_H_
 
 #include <mxnet/storage.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <ostream>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include "./profiler.h"
 
@@ -51,10 +57,44 @@ class DeviceStorageProfiler {
         const size_t idx = prof->DeviceIndex(handle.ctx.dev_type, handle.ctx.dev_id);
         CHECK_LT(idx, mem_counters_.size()) << "Invalid device index: " << idx;
         *mem_counters_[idx] += handle.size;
+        RecordAllocSite(handle);
       }
     }
   }
 
+  /*!
+   * \brief Name of the operator currently executing on the calling thread,
+   *  set by the engine around operator execution; nullptr outside of one.
+   *  Allocations are attributed to this name in the heap breakdown.
+   */
+  static const char*& CurrentScope() {
+    static MX_THREAD_LOCAL const char* scope = nullptr;
+    return scope;
+  }
+
+  /*!
+   * \brief Dump live bytes grouped by the operator that allocated them,
+   *  largest owner first
+   * \param os stream the breakdown is written to
+   */
+  static void DumpHeapBreakdown(std::ostream& os) {
+    std::lock_guard<std::mutex> lk(SiteMutex());
+    auto& site_bytes = SiteBytes();
+    std::vector<std::pair<std::string, size_t>> sites(site_bytes.begin(),
+                                                      site_bytes.end());
+    std::sort(sites.begin(), sites.end(),
+              [](const std::pair<std::string, size_t>& a,
+                 const std::pair<std::string, size_t>& b) {
+                return a.second > b.second;
+              });
+    os << "\nLive memory by operator\n"
+       << "=======================\n";
+    for (const auto& site : sites) {
+      if (site.second == 0) continue;
+      os << site.first << ": " << site.second << " bytes\n";
+    }
+  }
+
   /*!
    * \brief Called when memory has been freed in order to record the deallocation size
    * \param handle Handle to the allocated storage
@@ -71,11 +111,113 @@ class DeviceStorageProfiler {
         } else {
             *mem_counters_[idx] = 0;
         }
+        ReleaseAllocSite(handle);
       }
     }
   }
 
  private:
+  /*! \brief bookkeeping for one live allocation */
+  struct AllocInfo {
+    /*! \brief operator scope the allocation is attributed to */
+    std::string scope;
+    /*! \brief size of the allocation in bytes */
+    size_t size;
+    /*! \brief id pairing the lifetime begin and end trace events */
+    uint64_t id;
+  };
+
+  /*!
+   * \brief Chrome-trace async event marking one end of an allocation's
+   *  lifetime. Emitted as a 'b'/'e' pair sharing an id, which the trace
+   *  viewer renders as a bar from alloc to free under the allocating
+   *  operator's name.
+   */
+  struct AllocLifetimeStat : public profiler::ProfileStat {
+    /*! \brief size of the allocation in bytes */
+    size_t size_;
+    /*! \brief id shared by the begin and end events of one allocation */
+    uint64_t id_;
+    AllocLifetimeStat(const char *scope, size_t size, uint64_t id, bool begin)
+      : size_(size), id_(id) {
+      items_[0].enabled_ = true;
+      items_[0].event_type_ = begin ? kAsyncNestableStart : kAsyncNestableEnd;
+      items_[0].timestamp_ = NowInMicrosec();
+      name_.set(scope);
+      // lifetime pairs carry no duration of their own to aggregate
+      enable_aggregate_ = false;
+    }
+
+    void EmitExtra(std::ostream *os, size_t idx) override {
+      profiler::ProfileStat::EmitExtra(os, idx);
+      *os << "        \"id\": " << id_ << ",\n"
+          << "        \"args\": { \"size\": " << size_ << " },\n";
+    }
+  };
+
+  /*! \brief emit one side of an allocation lifetime pair into the trace */
+  static void EmitLifetime(const std::string &scope, size_t size, uint64_t id,
+                           bool begin) {
+    profiler::Profiler::Get()->AddNewProfileStat<AllocLifetimeStat>(
+      [](AllocLifetimeStat *stat) {
+        stat->categories_.set("Alloc lifetime");
+      }, scope.c_str(), size, id, begin);
+  }
+
+  /*! \brief attribute the allocation to the operator executing on this thread */
+  void RecordAllocSite(const Storage::Handle &handle) {
+    const char* scope = CurrentScope();
+    const std::string name = scope != nullptr ? scope : "<unattributed>";
+    const uint64_t id = NextAllocId().fetch_add(1, std::memory_order_relaxed);
+    {
+      std::lock_guard<std::mutex> lk(SiteMutex());
+      SiteBytes()[name] += handle.size;
+      LiveAllocs()[handle.dptr] = AllocInfo{name, handle.size, id};
+    }
+    EmitLifetime(name, handle.size, id, true);
+  }
+
+  /*! \brief return the freed bytes to the owning allocation site */
+  void ReleaseAllocSite(const Storage::Handle &handle) {
+    AllocInfo info;
+    {
+      std::lock_guard<std::mutex> lk(SiteMutex());
+      auto& live = LiveAllocs();
+      auto it = live.find(handle.dptr);
+      if (it == live.end()) return;
+      info = it->second;
+      auto& site_bytes = SiteBytes();
+      auto site = site_bytes.find(info.scope);
+      if (site != site_bytes.end()) {
+        if (site->second >= info.size) {
+          site->second -= info.size;
+        } else {
+          site->second = 0;
+        }
+      }
+      live.erase(it);
+    }
+    EmitLifetime(info.scope, info.size, info.id, false);
+  }
+
+  // the attribution state is shared by all profiler instances so the
+  // breakdown can be dumped without a handle on the storage singleton
+  static std::mutex& SiteMutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+  static std::unordered_map<std::string, size_t>& SiteBytes() {
+    static std::unordered_map<std::string, size_t> bytes;
+    return bytes;
+  }
+  static std::unordered_map<void*, AllocInfo>& LiveAllocs() {
+    static std::unordered_map<void*, AllocInfo> allocs;
+    return allocs;
+  }
+  static std::atomic<uint64_t>& NextAllocId() {
+    static std::atomic<uint64_t> id{1};
+    return id;
+  }
   /*!
    * \brief Lazy initialization.  No locks occur except for on the first pass
    * (or colliding parallel first passes)
@@ -33,6 +33,7 @@
 #include <limits>
 #include <atomic>
 #include "./common/lazy_alloc_array.h"
+#include "./common/temp_space_arena.h"
 #include "./common/utils.h"
 #include "./common/cuda_utils.h"
 
@@ -88,7 +89,11 @@ class ResourceManagerImpl : public ResourceManager {
  public:
   ResourceManagerImpl() noexcept(false)
       : global_seed_(0) {
-    cpu_temp_space_copy_ = dmlc::GetEnv("MXNET_CPU_TEMP_COPY", 4);
+    // with the arena enabled a copy only costs an engine var, not a buffer,
+    // so more copies dilute the false serialization between ops that land
+    // on the same workspace var
+    cpu_temp_space_copy_ = dmlc::GetEnv(
+        "MXNET_CPU_TEMP_COPY", common::TempSpaceArena::Enabled() ? 32 : 4);
     gpu_temp_space_copy_ = dmlc::GetEnv("MXNET_GPU_TEMP_COPY", 1);
     cpu_native_rand_copy_ = dmlc::GetEnv("MXNET_CPU_PARALLEL_RAND_COPY", 1);
     gpu_native_rand_copy_ = dmlc::GetEnv("MXNET_GPU_PARALLEL_RAND_COPY", 4);
@@ -411,7 +416,14 @@ class ResourceManagerImpl : public ResourceManager {
 }  // namespace resource
 
 void* Resource::get_space_internal(size_t size) const {
-  return static_cast<resource::SpaceAllocator*>(ptr_)->GetSpace(size);
+  auto *space = static_cast<resource::SpaceAllocator*>(ptr_);
+  // serve CPU workspaces from the per-thread arena when enabled; the
+  // pointer is only valid until the arena is reset at the next iteration
+  // boundary, which matches the temp space contract
+  if (common::TempSpaceArena::Enabled() && space->ctx.dev_mask() == cpu::kDevMask) {
+    return common::TempSpaceArena::Get()->Alloc(size);
+  }
+  return space->GetSpace(size);
 }
 
 void* Resource::get_host_space_internal(size_t size) const {
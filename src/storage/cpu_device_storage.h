@@ -26,9 +26,17 @@
 #define MXNET_STORAGE_CPU_DEVICE_STORAGE_H_
 
 #include <dmlc/logging.h>
+#include <dmlc/parameter.h>
 #include <cstdlib>
 #include <new>
 #include "mxnet/base.h"
+#if defined(__linux__) && !defined(_MSC_VER)
+#include <sys/mman.h>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <unordered_set>
+#endif  // defined(__linux__) && !defined(_MSC_VER)
 
 namespace mxnet {
 namespace storage {
@@ -60,8 +68,67 @@ class CPUDeviceStorage {
 #else
   static constexpr size_t alignment_ = 16;
 #endif
+#if defined(__linux__) && !defined(_MSC_VER)
+  /*! \brief huge page size on x86-64 and aarch64, also the backing threshold */
+  static constexpr size_t kHugePageSize = 2ul << 20;
+  /*!
+   * \brief huge page mode from MXNET_CPU_HUGE_PAGES:
+   * 0 disabled, 1 transparent (madvise), 2 explicit (MAP_HUGETLB)
+   */
+  inline static int HugePageMode() {
+    static const int mode = dmlc::GetEnv("MXNET_CPU_HUGE_PAGES", 0);
+    return mode;
+  }
+  /*! \brief pointers allocated with mmap, which must go back through munmap */
+  inline static std::unordered_set<void*>& MmapAllocs() {
+    static std::unordered_set<void*> allocs;
+    return allocs;
+  }
+  inline static std::mutex& MmapAllocsMutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+  /*!
+   * \brief Try to back the allocation with huge pages; falls back to the
+   * caller's path on failure.
+   * \param handle Handle struct.
+   * \return whether the allocation succeeded
+   */
+  inline static bool TryHugePageAlloc(Storage::Handle* handle);
+#endif  // defined(__linux__) && !defined(_MSC_VER)
 };  // class CPUDeviceStorage
 
+#if defined(__linux__) && !defined(_MSC_VER)
+inline bool CPUDeviceStorage::TryHugePageAlloc(Storage::Handle* handle) {
+  // hugetlb mappings must be a multiple of the huge page size
+  const size_t len =
+      ((handle->size + kHugePageSize - 1) / kHugePageSize) * kHugePageSize;
+  void* ptr = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+  if (HugePageMode() == 2) {
+    ptr = mmap(nullptr, len, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  }
+#endif  // defined(MAP_HUGETLB)
+  if (ptr == MAP_FAILED) {
+    // transparent huge pages; also the fallback when the hugetlb pool
+    // is exhausted or not configured
+    ptr = mmap(nullptr, len, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#if defined(MADV_HUGEPAGE)
+    if (ptr != MAP_FAILED) madvise(ptr, len, MADV_HUGEPAGE);
+#endif  // defined(MADV_HUGEPAGE)
+  }
+  if (ptr == MAP_FAILED) return false;
+  {
+    std::lock_guard<std::mutex> lock(MmapAllocsMutex());
+    MmapAllocs().insert(ptr);
+  }
+  handle->dptr = ptr;
+  return true;
+}
+#endif  // defined(__linux__) && !defined(_MSC_VER)
+
 inline void CPUDeviceStorage::Alloc(Storage::Handle* handle) {
   handle->dptr = nullptr;
   const size_t size = handle->size;
@@ -71,6 +138,11 @@ inline void CPUDeviceStorage::Alloc(Storage::Handle* handle) {
   handle->dptr = _aligned_malloc(size, alignment_);
   if (handle->dptr == nullptr) LOG(FATAL) << "Failed to allocate CPU Memory";
 #else
+#if defined(__linux__)
+  // mmap returns page-aligned memory, which satisfies alignment_
+  if (HugePageMode() != 0 && size >= kHugePageSize && TryHugePageAlloc(handle))
+    return;
+#endif  // defined(__linux__)
   int ret = posix_memalign(&handle->dptr, alignment_, size);
   if (ret != 0) LOG(FATAL) << "Failed to allocate CPU Memory";
 #endif
@@ -80,6 +152,22 @@ inline void CPUDeviceStorage::Free(Storage::Handle handle) {
 #if _MSC_VER
   _aligned_free(handle.dptr);
 #else
+#if defined(__linux__)
+  if (HugePageMode() != 0) {
+    bool mapped;
+    {
+      std::lock_guard<std::mutex> lock(MmapAllocsMutex());
+      mapped = MmapAllocs().erase(handle.dptr) != 0;
+    }
+    if (mapped) {
+      const size_t len =
+          ((handle.size + kHugePageSize - 1) / kHugePageSize) * kHugePageSize;
+      CHECK_EQ(munmap(handle.dptr, len), 0)
+          << "munmap failed: " << strerror(errno);
+      return;
+    }
+  }
+#endif  // defined(__linux__)
   free(handle.dptr);
 #endif
 }
@@ -33,7 +33,10 @@
 #include <process.h>
 #endif  // _WIN32
 
+#include <algorithm>
+#include <sstream>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include <atomic>
 #include <iostream>
@@ -54,7 +57,13 @@ class CPUSharedStorageManager final : public StorageManager {
   /*!
    * \brief Default constructor.
    */
-  CPUSharedStorageManager() : rand_gen_(std::random_device()()) {}
+  CPUSharedStorageManager() : rand_gen_(std::random_device()()) {
+#if defined(__linux__)
+    arena_enabled_ = dmlc::GetEnv("MXNET_CPU_SHARED_MEM_ARENA", false);
+    arena_slab_size_ =
+        dmlc::GetEnv("MXNET_CPU_SHARED_MEM_ARENA_SLAB_MB", 256ul) << 20;
+#endif  // __linux__
+  }
   /*!
    * \brief Default destructor.
    */
@@ -65,6 +74,15 @@ class CPUSharedStorageManager final : public StorageManager {
 #ifdef _WIN32
     CheckAndRealFree();
 #endif
+#if defined(__linux__)
+    for (const auto& slab : arena_slabs_) {
+      munmap(slab.base, slab.capacity);
+      close(slab.fd);
+    }
+    for (const auto& kv : arena_attach_) {
+      munmap(kv.second.first, kv.second.second);
+    }
+#endif  // __linux__
   }
 
   void Alloc(Storage::Handle* handle) override;
@@ -106,6 +124,65 @@ class CPUSharedStorageManager final : public StorageManager {
   void CheckAndRealFree();
 #endif
 
+#if defined(__linux__)
+  /*!
+   * \brief Header at the start of every arena slab, shared between processes.
+   *  std::atomic is address-free on Linux, so the spinlock and the free list
+   *  can be manipulated from every process that mapped the slab.
+   */
+  struct ArenaHeader {
+    std::atomic<int> lock;
+    uint32_t pad;
+    size_t capacity;
+    size_t brk;        // offset of the first never-used byte
+    size_t free_head;  // offset of the first free block header, 0 if none
+  };
+  /*!
+   * \brief Header preceding every arena allocation. The reference counter
+   *  sits at dptr - alignment_ so {In,De}crementRefCount work unchanged on
+   *  arena-backed handles.
+   */
+  struct ArenaBlock {
+    size_t size;       // total bytes including this header
+    size_t next_free;  // offset of the next free block header when free
+    std::atomic<int> refcount;
+    int pad[3];
+  };
+  static_assert(sizeof(ArenaBlock) == 2 * alignment_,
+                "refcount must land at dptr - alignment_");
+  struct ArenaSlab {
+    int fd;
+    void* base;
+    size_t capacity;
+  };
+
+  static void ArenaLock(std::atomic<int>* lock) {
+    int expected = 0;
+    while (!lock->compare_exchange_weak(expected, 1, std::memory_order_acquire)) {
+      expected = 0;
+    }
+  }
+  static void ArenaUnlock(std::atomic<int>* lock) {
+    lock->store(0, std::memory_order_release);
+  }
+
+  void ArenaAlloc(Storage::Handle* handle);
+  void ArenaAttach(Storage::Handle* handle);
+  void ArenaFree(const Storage::Handle& handle);
+  ArenaSlab* ArenaNewSlab(size_t min_capacity);
+
+  /*! \brief whether allocations are served from the slab arena */
+  bool arena_enabled_{false};
+  /*! \brief default capacity of a freshly created slab */
+  size_t arena_slab_size_{0};
+  /*! \brief slabs created by this process */
+  std::vector<ArenaSlab> arena_slabs_;
+  /*! \brief slabs of other processes this process attached, keyed by inode */
+  std::unordered_map<ino_t, std::pair<void*, size_t>> arena_attach_;
+  /*! \brief sequence number used to name the slabs of this process */
+  int arena_seq_{0};
+#endif  // __linux__
+
   std::string SharedHandleToString(int shared_pid, int shared_id) {
     std::stringstream name;
     name << "/mx_" << std::hex << shared_pid << "_" << std::hex << shared_id;
@@ -121,6 +198,17 @@ void CPUSharedStorageManager::Alloc(Storage::Handle* handle) {
   }
 
   std::lock_guard<std::recursive_mutex> lock(mutex_);
+#if defined(__linux__)
+  if (arena_enabled_) {
+    if (handle->shared_id == -1 && handle->shared_pid == -1) {
+      ArenaAlloc(handle);
+    } else {
+      ArenaAttach(handle);
+    }
+    pool_[handle->dptr] = *handle;
+    return;
+  }
+#endif  // __linux__
   std::uniform_int_distribution<> dis(0, std::numeric_limits<int>::max());
   int fid = -1;
   std::string filename;
@@ -214,6 +302,12 @@ void CPUSharedStorageManager::Alloc(Storage::Handle* handle) {
 }
 
 void CPUSharedStorageManager::FreeImpl(const Storage::Handle& handle) {
+#if defined(__linux__)
+  if (arena_enabled_) {
+    ArenaFree(handle);
+    return;
+  }
+#endif  // __linux__
   int count = DecrementRefCount(handle);
   CHECK_GE(count, 0);
 #ifdef _WIN32
@@ -241,6 +335,147 @@ void CPUSharedStorageManager::FreeImpl(const Storage::Handle& handle) {
 #endif  // _WIN32
 }
 
+#if defined(__linux__)
+inline CPUSharedStorageManager::ArenaSlab*
+CPUSharedStorageManager::ArenaNewSlab(size_t min_capacity) {
+  const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t capacity = std::max(arena_slab_size_, min_capacity);
+  capacity = (capacity + page - 1) / page * page;
+
+  int fid = -1;
+  std::string filename;
+  for (int i = 0; i < 10 && fid == -1; ++i) {
+    std::stringstream name;
+    name << "/mx_arena_" << std::hex << getpid() << "_" << arena_seq_++;
+    filename = name.str();
+    fid = shm_open(filename.c_str(), O_EXCL|O_CREAT|O_RDWR, 0666);
+  }
+  CHECK_NE(fid, -1)
+      << "Failed to create arena slab. shm_open failed with error "
+      << strerror(errno);
+  CHECK_EQ(ftruncate(fid, capacity), 0);
+
+  void* base = mmap(NULL, capacity, PROT_READ|PROT_WRITE, MAP_SHARED, fid, 0);
+  CHECK_NE(base, MAP_FAILED)
+      << "Failed to map arena slab. mmap failed with error " << strerror(errno);
+  CHECK_EQ(shm_unlink(filename.c_str()), 0)
+      << "Failed to unlink arena slab. shm_unlink failed with error "
+      << strerror(errno);
+
+  ArenaHeader* hdr = reinterpret_cast<ArenaHeader*>(base);
+  new (&hdr->lock) std::atomic<int>(0);
+  hdr->capacity = capacity;
+  hdr->brk = sizeof(ArenaHeader);
+  hdr->free_head = 0;
+  arena_slabs_.push_back(ArenaSlab{fid, base, capacity});
+  return &arena_slabs_.back();
+}
+
+inline void CPUSharedStorageManager::ArenaAlloc(Storage::Handle* handle) {
+  const size_t need =
+      (sizeof(ArenaBlock) + handle->size + alignment_ - 1) / alignment_ * alignment_;
+  size_t off = 0;
+  ArenaSlab* slab = nullptr;
+  for (auto& s : arena_slabs_) {
+    ArenaHeader* hdr = reinterpret_cast<ArenaHeader*>(s.base);
+    ArenaLock(&hdr->lock);
+    // first fit over the shared free list; blocks are reused whole, the
+    // arena targets many small arrays of recurring sizes
+    size_t prev = 0;
+    size_t cur = hdr->free_head;
+    while (cur != 0) {
+      auto* blk = reinterpret_cast<ArenaBlock*>(static_cast<char*>(s.base) + cur);
+      if (blk->size >= need) {
+        if (prev == 0) {
+          hdr->free_head = blk->next_free;
+        } else {
+          reinterpret_cast<ArenaBlock*>(static_cast<char*>(s.base) + prev)->next_free =
+              blk->next_free;
+        }
+        off = cur;
+        break;
+      }
+      prev = cur;
+      cur = blk->next_free;
+    }
+    if (off == 0 && hdr->brk + need <= hdr->capacity) {
+      off = hdr->brk;
+      hdr->brk += need;
+      reinterpret_cast<ArenaBlock*>(static_cast<char*>(s.base) + off)->size = need;
+    }
+    ArenaUnlock(&hdr->lock);
+    if (off != 0) {
+      slab = &s;
+      break;
+    }
+  }
+  if (off == 0) {
+    slab = ArenaNewSlab(sizeof(ArenaHeader) + need);
+    ArenaHeader* hdr = reinterpret_cast<ArenaHeader*>(slab->base);
+    ArenaLock(&hdr->lock);
+    off = hdr->brk;
+    hdr->brk += need;
+    reinterpret_cast<ArenaBlock*>(static_cast<char*>(slab->base) + off)->size = need;
+    ArenaUnlock(&hdr->lock);
+  }
+
+  auto* blk = reinterpret_cast<ArenaBlock*>(static_cast<char*>(slab->base) + off);
+  new (&blk->refcount) std::atomic<int>(1);
+  handle->dptr = reinterpret_cast<char*>(blk) + sizeof(ArenaBlock);
+  // the offset doubles as the shared handle; consumers recover the slab
+  // base as dptr - shared_pid
+  CHECK_LE(off + sizeof(ArenaBlock),
+           static_cast<size_t>(std::numeric_limits<int>::max()));
+  handle->shared_pid = static_cast<int>(off + sizeof(ArenaBlock));
+  handle->shared_id = dup(slab->fd);
+  CHECK_NE(handle->shared_id, -1)
+      << "Failed to dup arena slab descriptor with error " << strerror(errno);
+}
+
+inline void CPUSharedStorageManager::ArenaAttach(Storage::Handle* handle) {
+  CHECK_GT(handle->shared_pid, 0) << "Invalid arena offset from shared array.";
+  struct stat st;
+  CHECK_EQ(fstat(handle->shared_id, &st), 0)
+      << "Failed to stat arena slab. fstat failed with error " << strerror(errno);
+  void* base;
+  auto it = arena_attach_.find(st.st_ino);
+  if (it != arena_attach_.end()) {
+    // the slab is already mapped; attaching is just pointer arithmetic
+    base = it->second.first;
+  } else {
+    base = mmap(NULL, st.st_size, PROT_READ|PROT_WRITE, MAP_SHARED,
+                handle->shared_id, 0);
+    CHECK_NE(base, MAP_FAILED)
+        << "Failed to map arena slab. mmap failed with error " << strerror(errno);
+    arena_attach_.emplace(st.st_ino,
+                          std::make_pair(base, static_cast<size_t>(st.st_size)));
+  }
+  handle->dptr = static_cast<char*>(base) + handle->shared_pid;
+}
+
+inline void CPUSharedStorageManager::ArenaFree(const Storage::Handle& handle) {
+  int count = DecrementRefCount(handle);
+  CHECK_GE(count, 0);
+  if (count == 0) {
+    // return the block to the shared free list of its slab; any process
+    // that still maps the slab may do this
+    char* base = static_cast<char*>(handle.dptr) - handle.shared_pid;
+    auto* blk = reinterpret_cast<ArenaBlock*>(
+        static_cast<char*>(handle.dptr) - sizeof(ArenaBlock));
+    ArenaHeader* hdr = reinterpret_cast<ArenaHeader*>(base);
+    ArenaLock(&hdr->lock);
+    blk->next_free = hdr->free_head;
+    hdr->free_head = static_cast<size_t>(handle.shared_pid) - sizeof(ArenaBlock);
+    ArenaUnlock(&hdr->lock);
+  }
+  if (handle.shared_id != -1) {
+    CHECK_EQ(close(handle.shared_id), 0)
+        << "Failed to close shared memory. close failed with error "
+        << strerror(errno);
+  }
+}
+#endif  // __linux__
+
 #ifdef _WIN32
 inline void CPUSharedStorageManager::CheckAndRealFree() {
   std::lock_guard<std::recursive_mutex> lock(mutex_);
@@ -31,7 +31,10 @@
 #if MXNET_USE_CUDA
 #include <cuda_runtime.h>
 #endif  // MXNET_USE_CUDA
+#include <limits>
+#include <mutex>
 #include <new>
+#include <unordered_set>
 
 namespace mxnet {
 namespace storage {
@@ -53,6 +56,47 @@ class GPUDeviceStorage {
   inline static void Free(Storage::Handle handle);
 };  // class GPUDeviceStorage
 
+/*!
+ * \brief GPU storage implementation backed by CUDA unified (managed) memory.
+ *  Managed buffers may oversubscribe device memory; pages migrate on demand
+ *  between host and device. Selected with MXNET_GPU_MEM_POOL_TYPE=Managed.
+ */
+class GPUManagedDeviceStorage {
+ public:
+  /*!
+   * \brief Allocation.
+   * \param handle Handle struct.
+   */
+  inline static void Alloc(Storage::Handle* handle);
+  /*!
+   * \brief Deallocation.
+   * \param handle Handle struct.
+   */
+  inline static void Free(Storage::Handle handle);
+};  // class GPUManagedDeviceStorage
+
+/*!
+ * \brief GPU storage implementation backed by the CUDA stream-ordered
+ *  allocator (cudaMallocAsync / cudaFreeAsync). Allocations are served from
+ *  the device's default memory pool, so a cache hit is lock-free inside the
+ *  driver and a miss never triggers the device-wide synchronization that
+ *  cudaFree implies. Selected with MXNET_GPU_MEM_POOL_TYPE=Async; requires
+ *  CUDA 11.2 and a driver with memory pool support.
+ */
+class GPUAsyncDeviceStorage {
+ public:
+  /*!
+   * \brief Allocation.
+   * \param handle Handle struct.
+   */
+  inline static void Alloc(Storage::Handle* handle);
+  /*!
+   * \brief Deallocation.
+   * \param handle Handle struct.
+   */
+  inline static void Free(Storage::Handle handle);
+};  // class GPUAsyncDeviceStorage
+
 inline void GPUDeviceStorage::Alloc(Storage::Handle* handle) {
   handle->dptr = nullptr;
   const size_t size = handle->size;
@@ -88,6 +132,105 @@ inline void GPUDeviceStorage::Free(Storage::Handle handle) {
 #endif  // MXNET_USE_CUDA
 }
 
+inline void GPUManagedDeviceStorage::Alloc(Storage::Handle* handle) {
+  handle->dptr = nullptr;
+  const size_t size = handle->size;
+  if (size == 0) return;
+
+#if MXNET_USE_CUDA
+  const int dev_id = handle->ctx.real_dev_id();
+  mxnet::common::cuda::DeviceStore device_store(dev_id, true);
+#if MXNET_USE_NCCL
+  std::lock_guard<std::mutex> l(Storage::Get()->GetMutex(Context::kGPU));
+#endif  // MXNET_USE_NCCL
+  cudaError_t e = cudaMallocManaged(&handle->dptr, size, cudaMemAttachGlobal);
+  if (e != cudaSuccess && e != cudaErrorCudartUnloading)
+    LOG(FATAL) << "CUDA: " << cudaGetErrorString(e);
+  if (dmlc::GetEnv("MXNET_GPU_MANAGED_PREFETCH", true)) {
+    // Hint the driver that the owning device is the preferred home of the
+    // pages, and start migrating them there so the first kernel touching the
+    // buffer does not stall on page faults. Both calls are advisory; failures
+    // (e.g. on pre-Pascal hardware without on-demand paging) are ignored.
+    cudaMemAdvise(handle->dptr, size, cudaMemAdviseSetPreferredLocation, dev_id);
+    cudaMemPrefetchAsync(handle->dptr, size, dev_id, 0);
+    cudaGetLastError();
+  }
+#else   // MXNET_USE_CUDA
+  LOG(FATAL) << "Please compile with CUDA enabled";
+#endif  // MXNET_USE_CUDA
+}
+
+inline void GPUManagedDeviceStorage::Free(Storage::Handle handle) {
+#if MXNET_USE_CUDA
+  mxnet::common::cuda::DeviceStore device_store(handle.ctx.real_dev_id(), true);
+#if MXNET_USE_NCCL
+  std::lock_guard<std::mutex> l(Storage::Get()->GetMutex(Context::kGPU));
+#endif  // MXNET_USE_NCCL
+  cudaError_t err = cudaFree(handle.dptr);
+  // ignore unloading error, as memory has already been recycled
+  if (err != cudaSuccess && err != cudaErrorCudartUnloading) {
+    LOG(FATAL) << "CUDA: " << cudaGetErrorString(err);
+  }
+#else   // MXNET_USE_CUDA
+  LOG(FATAL) << "Please compile with CUDA enabled";
+#endif  // MXNET_USE_CUDA
+}
+
+inline void GPUAsyncDeviceStorage::Alloc(Storage::Handle* handle) {
+  handle->dptr = nullptr;
+  const size_t size = handle->size;
+  if (size == 0) return;
+
+#if MXNET_USE_CUDA && CUDART_VERSION >= 11020
+  const int dev_id = handle->ctx.real_dev_id();
+  mxnet::common::cuda::DeviceStore device_store(dev_id, true);
+  // Raise the release threshold of the device's default pool once per
+  // device, so freed blocks stay cached for reuse instead of being handed
+  // back to the driver at every synchronization point. Only this cold
+  // setup path takes a lock; steady-state allocation goes straight to the
+  // stream-ordered allocator.
+  static std::mutex pool_setup_mutex;
+  static std::unordered_set<int> pools_configured;
+  {
+    std::lock_guard<std::mutex> l(pool_setup_mutex);
+    if (pools_configured.insert(dev_id).second) {
+      cudaMemPool_t pool;
+      CUDA_CALL(cudaDeviceGetDefaultMemPool(&pool, dev_id));
+      uint64_t threshold = std::numeric_limits<uint64_t>::max();
+      CUDA_CALL(cudaMemPoolSetAttribute(
+          pool, cudaMemPoolAttrReleaseThreshold, &threshold));
+    }
+  }
+  // The storage API carries no stream, so allocation and free are ordered
+  // on the legacy default stream. The engine only frees a buffer after the
+  // work using it has completed, which keeps this ordering safe.
+  cudaError_t e = cudaMallocAsync(&handle->dptr, size, nullptr);
+  if (e != cudaSuccess && e != cudaErrorCudartUnloading)
+    LOG(FATAL) << "CUDA: " << cudaGetErrorString(e);
+#elif MXNET_USE_CUDA
+  LOG(FATAL) << "MXNET_GPU_MEM_POOL_TYPE=Async requires CUDA 11.2 or later";
+#else   // MXNET_USE_CUDA
+  LOG(FATAL) << "Please compile with CUDA enabled";
+#endif  // MXNET_USE_CUDA && CUDART_VERSION >= 11020
+}
+
+inline void GPUAsyncDeviceStorage::Free(Storage::Handle handle) {
+#if MXNET_USE_CUDA && CUDART_VERSION >= 11020
+  mxnet::common::cuda::DeviceStore device_store(handle.ctx.real_dev_id(), true);
+  // stream-ordered free never synchronizes the device, so the NCCL guard
+  // the cudaFree path needs does not apply here
+  cudaError_t err = cudaFreeAsync(handle.dptr, nullptr);
+  // ignore unloading error, as memory has already been recycled
+  if (err != cudaSuccess && err != cudaErrorCudartUnloading) {
+    LOG(FATAL) << "CUDA: " << cudaGetErrorString(err);
+  }
+#elif MXNET_USE_CUDA
+  LOG(FATAL) << "MXNET_GPU_MEM_POOL_TYPE=Async requires CUDA 11.2 or later";
+#else   // MXNET_USE_CUDA
+  LOG(FATAL) << "Please compile with CUDA enabled";
+#endif  // MXNET_USE_CUDA && CUDART_VERSION >= 11020
+}
+
 }  // namespace storage
 }  // namespace mxnet
 
@@ -0,0 +1,167 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * Copyright (c) 2020 by Contributors
+ * \file memory_budget.h
+ * \brief Per-invocation device memory budgets for request isolation.
+ */
+#ifndef MXNET_STORAGE_MEMORY_BUDGET_H_
+#define MXNET_STORAGE_MEMORY_BUDGET_H_
+
+#include <mxnet/storage.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace mxnet {
+namespace storage {
+
+/*!
+ * \brief Hard limit on the bytes one invocation may hold live through
+ *  Storage::Alloc. A scope is opened on the request thread around the
+ *  invocation and the engine carries it to the worker threads running the
+ *  pushed operators, so allocations made on the invocation's behalf are
+ *  charged to it wherever they happen. An allocation that would take the
+ *  tally past the limit fails the request with an exception instead of
+ *  exhausting the device for every other request in the process.
+ */
+class MemoryBudget {
+ public:
+  MemoryBudget(size_t limit, const std::string& tag)
+    : limit_(limit), tag_(tag) {}
+
+  /*!
+   * \brief the budget allocations on the calling thread are charged to,
+   *  null outside a budgeted invocation
+   */
+  static std::shared_ptr<MemoryBudget>& CurrentScope() {
+    static thread_local std::shared_ptr<MemoryBudget> scope;
+    return scope;
+  }
+
+  /*!
+   * \brief charge an allocation about to be made to the calling thread's
+   *  budget; no-op outside a scope. Called before the storage manager is
+   *  touched, so an over-budget request fails without consuming the device.
+   * \param size bytes about to be allocated
+   */
+  static void Charge(size_t size) {
+    const std::shared_ptr<MemoryBudget>& scope = CurrentScope();
+    if (scope == nullptr || size == 0) return;
+    const size_t used =
+        scope->used_.fetch_add(size, std::memory_order_relaxed) + size;
+    if (used > scope->limit_) {
+      scope->used_.fetch_sub(size, std::memory_order_relaxed);
+      LOG(FATAL) << "memory budget of " << scope->limit_
+                 << " bytes exceeded by " << scope->tag_ << ": "
+                 << used - size << " bytes live, " << size
+                 << " more requested";
+    }
+  }
+
+  /*!
+   * \brief remember the owner of a charged allocation, so the free can be
+   *  credited back to the right budget from any thread
+   * \param handle the successfully allocated storage
+   */
+  static void Commit(const Storage::Handle& handle) {
+    const std::shared_ptr<MemoryBudget>& scope = CurrentScope();
+    if (scope == nullptr || handle.size == 0) return;
+    std::lock_guard<std::mutex> lock(OwnerMutex());
+    Owners()[handle.dptr] = std::make_pair(scope, handle.size);
+    AnyOwned().store(true, std::memory_order_release);
+  }
+
+  /*!
+   * \brief return freed bytes to the budget they were charged to, if any
+   * \param handle the storage being freed
+   */
+  static void Refund(const Storage::Handle& handle) {
+    // single relaxed load on the fleet-wide free path when no budget has
+    // ever been used in the process
+    if (!AnyOwned().load(std::memory_order_acquire)) return;
+    std::lock_guard<std::mutex> lock(OwnerMutex());
+    auto& owners = Owners();
+    auto it = owners.find(handle.dptr);
+    if (it == owners.end()) return;
+    it->second.first->used_.fetch_sub(it->second.second,
+                                      std::memory_order_relaxed);
+    owners.erase(it);
+  }
+
+ private:
+  /*! \brief owning budget and charged size per live budgeted allocation */
+  using OwnerMap =
+      std::unordered_map<void*, std::pair<std::shared_ptr<MemoryBudget>, size_t> >;
+
+  static std::mutex& OwnerMutex() {
+    static std::mutex m;
+    return m;
+  }
+
+  static OwnerMap& Owners() {
+    static OwnerMap owners;
+    return owners;
+  }
+
+  static std::atomic<bool>& AnyOwned() {
+    static std::atomic<bool> any(false);
+    return any;
+  }
+
+  /*! \brief bytes currently live against the budget */
+  std::atomic<size_t> used_{0};
+  /*! \brief bytes the invocation may hold live */
+  const size_t limit_;
+  /*! \brief who the budget belongs to, for the error message */
+  const std::string tag_;
+};
+
+/*!
+ * \brief RAII scope installing a budget on the calling thread. The budget
+ *  outlives the scope through the engine operators that captured it, so
+ *  asynchronous work pushed inside the scope stays budgeted after the
+ *  scope closes.
+ */
+class MemoryBudgetScope {
+ public:
+  MemoryBudgetScope(size_t limit, const std::string& tag)
+    : saved_(MemoryBudget::CurrentScope()) {
+    MemoryBudget::CurrentScope() = std::make_shared<MemoryBudget>(limit, tag);
+  }
+
+  ~MemoryBudgetScope() {
+    MemoryBudget::CurrentScope() = saved_;
+  }
+
+ private:
+  /*! \brief budget of the enclosing scope, restored on exit */
+  std::shared_ptr<MemoryBudget> saved_;
+
+  DISALLOW_COPY_AND_ASSIGN(MemoryBudgetScope);
+};
+
+}  // namespace storage
+}  // namespace mxnet
+
+#endif  // MXNET_STORAGE_MEMORY_BUDGET_H_
@@ -39,6 +39,7 @@
 #include "./storage_manager.h"
 #include "../common/cuda_utils.h"
 #include "../common/utils.h"
+#include "../profiler/runtime_stats.h"
 
 
 namespace mxnet {
@@ -60,6 +61,7 @@ class GPUPooledStorageManager final : public StorageManager {
     initial_context_(initial_context) {
     reserve_ = dmlc::GetEnv("MXNET_GPU_MEM_POOL_RESERVE", 5);
     page_size_ = dmlc::GetEnv("MXNET_GPU_MEM_POOL_PAGE_SIZE", 4096);
+    cap_bytes_ = static_cast<size_t>(dmlc::GetEnv("MXNET_GPU_MEM_POOL_CAP_MB", 0)) << 20;
     large_alloc_round_size_ = dmlc::GetEnv("MXNET_GPU_MEM_LARGE_ALLOC_ROUND_SIZE", 2 * 1024 * 1024);
     if (large_alloc_round_size_ <= 0) {
       LOG(FATAL) << "MXNET_GPU_MEM_LARGE_ALLOC_ROUND_SIZE cannot be set to a value <= 0, found: "
@@ -87,6 +89,28 @@ class GPUPooledStorageManager final : public StorageManager {
 
   void ReleaseAll() override;
 
+  size_t CachedBytes() override {
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+    return cached_bytes_;
+  }
+
+  size_t UsedBytes() override {
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+    return used_memory_ - cached_bytes_;
+  }
+
+  size_t FragmentationBytes() override {
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+    return frag_bytes_;
+  }
+
+  void SetCapBytes(size_t cap_bytes) override {
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+    cap_bytes_ = cap_bytes;
+  }
+
+  void Trim(size_t target_bytes) override;
+
  private:
   void DirectFreeNoLock(Storage::Handle handle) {
     mxnet::common::cuda::DeviceStore device_store(handle.ctx.real_dev_id(), true);
@@ -97,6 +121,7 @@ class GPUPooledStorageManager final : public StorageManager {
       LOG(FATAL) << "CUDA: " << cudaGetErrorString(err);
     }
     used_memory_ -= size;
+    frag_bytes_ -= size - handle.size;
   }
 
   // Round a value 'x' up to the next multiple of 'multiple'
@@ -119,6 +144,12 @@ class GPUPooledStorageManager final : public StorageManager {
  private:
   // used memory
   size_t used_memory_ = 0;
+  // memory held in the free pool
+  size_t cached_bytes_ = 0;
+  // bytes lost to size rounding across live allocations
+  size_t frag_bytes_ = 0;
+  // hard cap on device bytes held by this manager; 0 means no cap
+  size_t cap_bytes_;
   // page size
   size_t page_size_;
   // size that large allocations should be rounded to, for proper freeing.
@@ -150,6 +181,14 @@ void GPUPooledStorageManager::Alloc(Storage::Handle* handle) {
     cudaMemGetInfo(&free, &total);
     if (free <= total * reserve_ / 100 || size > free - total * reserve_ / 100)
       ReleaseAll();
+    if (cap_bytes_ != 0 && used_memory_ + size > cap_bytes_) {
+      ReleaseAll();
+      if (used_memory_ + size > cap_bytes_) {
+        LOG(FATAL) << "Allocation of " << size << " bytes would exceed the GPU memory "
+                   << "pool cap of " << cap_bytes_ << " bytes. See MXNET_GPU_MEM_POOL_CAP_MB "
+                   << "and MXStorageSetMemoryPoolCap.";
+      }
+    }
 
     void* ret = nullptr;
     cudaError_t e = cudaMalloc(&ret, size);
@@ -166,12 +205,20 @@ void GPUPooledStorageManager::Alloc(Storage::Handle* handle) {
     }
     used_memory_ += size;
     handle->dptr = ret;
+    if (profiler::RuntimeStats::Get()->enabled()) {
+      profiler::RuntimeStats::Get()->PoolMiss();
+    }
   } else {
     auto&& reuse_pool = reuse_it->second;
     auto ret = reuse_pool.back();
     reuse_pool.pop_back();
+    cached_bytes_ -= size;
     handle->dptr = ret;
+    if (profiler::RuntimeStats::Get()->enabled()) {
+      profiler::RuntimeStats::Get()->PoolHit();
+    }
   }
+  frag_bytes_ += size - handle->size;
 }
 
 void GPUPooledStorageManager::Free(Storage::Handle handle) {
@@ -183,6 +230,8 @@ void GPUPooledStorageManager::Free(Storage::Handle handle) {
   size_t size = RoundAllocSize(handle.size);
   auto&& reuse_pool = memory_pool_[size];
   reuse_pool.push_back(handle.dptr);
+  cached_bytes_ += size;
+  frag_bytes_ -= size - handle.size;
 }
 
 void GPUPooledStorageManager::ReleaseAll() {
@@ -196,6 +245,24 @@ void GPUPooledStorageManager::ReleaseAll() {
     }
   }
   memory_pool_.clear();
+  cached_bytes_ = 0;
+}
+
+void GPUPooledStorageManager::Trim(size_t target_bytes) {
+  std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+  for (auto&& i : memory_pool_) {
+    auto&& reuse_pool = i.second;
+    while (cached_bytes_ > target_bytes && !reuse_pool.empty()) {
+      Storage::Handle handle;
+      handle.dptr = reuse_pool.back();
+      handle.size = i.first;
+      handle.ctx = initial_context_;
+      reuse_pool.pop_back();
+      DirectFreeNoLock(handle);
+      cached_bytes_ -= i.first;
+    }
+    if (cached_bytes_ <= target_bytes) break;
+  }
 }
 
 /*!
@@ -224,6 +291,7 @@ class GPUPooledRoundedStorageManager final : public StorageManager {
     reserve_ = dmlc::GetEnv("MXNET_GPU_MEM_POOL_RESERVE", 5);
     page_size_ = dmlc::GetEnv("MXNET_GPU_MEM_POOL_PAGE_SIZE", 4096);
     cut_off_ = dmlc::GetEnv("MXNET_GPU_MEM_POOL_ROUND_LINEAR_CUTOFF", 24);
+    cap_bytes_ = static_cast<size_t>(dmlc::GetEnv("MXNET_GPU_MEM_POOL_CAP_MB", 0)) << 20;
     if (page_size_ < 32) {
       LOG(FATAL) << "MXNET_GPU_MEM_POOL_PAGE_SIZE cannot be set to a value smaller than 32. " \
                  << "Got: " << page_size_ << ".";
@@ -261,6 +329,28 @@ class GPUPooledRoundedStorageManager final : public StorageManager {
 
   void ReleaseAll() override;
 
+  size_t CachedBytes() override {
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+    return cached_bytes_;
+  }
+
+  size_t UsedBytes() override {
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+    return used_memory_ - cached_bytes_;
+  }
+
+  size_t FragmentationBytes() override {
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+    return frag_bytes_;
+  }
+
+  void SetCapBytes(size_t cap_bytes) override {
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+    cap_bytes_ = cap_bytes;
+  }
+
+  void Trim(size_t target_bytes) override;
+
  private:
   inline int div_pow2_round_up(size_t s, int divisor_log2) {
     // (1025, 10) -> 2
@@ -292,6 +382,7 @@ class GPUPooledRoundedStorageManager final : public StorageManager {
       LOG(FATAL) << "CUDA: " << cudaGetErrorString(err);
     }
     used_memory_ -= size;
+    frag_bytes_ -= size - handle.size;
   }
 
  private:
@@ -303,6 +394,12 @@ class GPUPooledRoundedStorageManager final : public StorageManager {
   static const int addr_width = sizeof(size_t) * 8;
   // used memory
   size_t used_memory_ = 0;
+  // memory held in the free pool
+  size_t cached_bytes_ = 0;
+  // bytes lost to size rounding across live allocations
+  size_t frag_bytes_ = 0;
+  // hard cap on device bytes held by this manager; 0 means no cap
+  size_t cap_bytes_;
   // page size
   size_t page_size_;
   // log2 of memory size before switching to exponential mode to linear mode
@@ -333,6 +430,14 @@ void GPUPooledRoundedStorageManager::Alloc(Storage::Handle* handle) {
     cudaMemGetInfo(&free, &total);
     if (free <= total * reserve_ / 100 || size > free - total * reserve_ / 100)
       ReleaseAll();
+    if (cap_bytes_ != 0 && used_memory_ + size > cap_bytes_) {
+      ReleaseAll();
+      if (used_memory_ + size > cap_bytes_) {
+        LOG(FATAL) << "Allocation of " << size << " bytes would exceed the GPU memory "
+                   << "pool cap of " << cap_bytes_ << " bytes. See MXNET_GPU_MEM_POOL_CAP_MB "
+                   << "and MXStorageSetMemoryPoolCap.";
+      }
+    }
 
     void* ret = nullptr;
     cudaError_t e = cudaMalloc(&ret, size);
@@ -349,11 +454,19 @@ void GPUPooledRoundedStorageManager::Alloc(Storage::Handle* handle) {
     }
     used_memory_ += size;
     handle->dptr = ret;
+    if (profiler::RuntimeStats::Get()->enabled()) {
+      profiler::RuntimeStats::Get()->PoolMiss();
+    }
   } else {
     auto ret = reuse_pool.back();
     reuse_pool.pop_back();
+    cached_bytes_ -= size;
     handle->dptr = ret;
+    if (profiler::RuntimeStats::Get()->enabled()) {
+      profiler::RuntimeStats::Get()->PoolHit();
+    }
   }
+  frag_bytes_ += size - handle->size;
 }
 
 void GPUPooledRoundedStorageManager::Free(Storage::Handle handle) {
@@ -365,6 +478,8 @@ void GPUPooledRoundedStorageManager::Free(Storage::Handle handle) {
   int bucket = get_bucket(handle.size);
   auto&& reuse_pool = memory_pool_[bucket];
   reuse_pool.push_back(handle.dptr);
+  cached_bytes_ += get_size(bucket);
+  frag_bytes_ -= get_size(bucket) - handle.size;
 }
 
 void GPUPooledRoundedStorageManager::ReleaseAll() {
@@ -379,6 +494,443 @@ void GPUPooledRoundedStorageManager::ReleaseAll() {
     }
     memory_pool_[i].clear();
   }
+  cached_bytes_ = 0;
+}
+
+void GPUPooledRoundedStorageManager::Trim(size_t target_bytes) {
+  std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+  for (size_t i = 0; i < memory_pool_.size(); i++) {
+    const size_t size = get_size(i);
+    auto&& reuse_pool = memory_pool_[i];
+    while (cached_bytes_ > target_bytes && !reuse_pool.empty()) {
+      Storage::Handle handle;
+      handle.size = size;
+      handle.dptr = reuse_pool.back();
+      handle.ctx = initial_context_;
+      reuse_pool.pop_back();
+      DirectFreeNoLock(handle);
+      cached_bytes_ -= size;
+    }
+    if (cached_bytes_ <= target_bytes) break;
+  }
+}
+
+/*!
+ * \brief Storage manager with jemalloc-style geometric size classes, on gpu.
+ *
+ * Buckets grow by a configurable factor instead of doubling, so the worst
+ * case internal fragmentation is (factor - 1) rather than 2x. This suits
+ * variable-length workloads (e.g. NLP) where pow2 rounding wastes a large
+ * fraction of memory and exact-size pooling never reuses anything.
+ * Adjacent-block coalescing is not possible on top of cudaMalloc, which
+ * hands out unrelated device ranges; the tight size classes are what keeps
+ * fragmentation bounded here.
+ *
+ * \param growth factor between consecutive size classes, set through
+ * MXNET_GPU_MEM_POOL_GROWTH_FACTOR (default 1.25, must be > 1.0).
+ * Class sizes are multiples of MXNET_GPU_MEM_POOL_PAGE_SIZE.
+ */
+class GPUPooledSizeClassStorageManager final : public StorageManager {
+ public:
+  /*!
+   * \brief Default constructor.
+   *
+   * \param initial_context context used by this Storage Manager
+   */
+  explicit GPUPooledSizeClassStorageManager(Context initial_context) :
+    initial_context_(initial_context) {
+    reserve_ = dmlc::GetEnv("MXNET_GPU_MEM_POOL_RESERVE", 5);
+    page_size_ = dmlc::GetEnv("MXNET_GPU_MEM_POOL_PAGE_SIZE", 4096);
+    const double growth =
+        dmlc::GetEnv("MXNET_GPU_MEM_POOL_GROWTH_FACTOR", 1.25);
+    cap_bytes_ = static_cast<size_t>(dmlc::GetEnv("MXNET_GPU_MEM_POOL_CAP_MB", 0)) << 20;
+    if (page_size_ < NDEV) {
+      LOG(FATAL) << "MXNET_GPU_MEM_POOL_PAGE_SIZE cannot be set to a value smaller than " << NDEV \
+                 << ". Got " << page_size_ << ".";
+    }
+    if (growth <= 1.0) {
+      LOG(FATAL) << "MXNET_GPU_MEM_POOL_GROWTH_FACTOR must be greater than 1.0. Got: "
+                 << growth << ".";
+    }
+    // precompute the class sizes: multiples of page_size_, geometric with
+    // the configured factor, up to kMaxPoolSize
+    size_t size = page_size_;
+    while (size < kMaxPoolSize) {
+      class_sizes_.push_back(size);
+      size_t next = static_cast<size_t>(size * growth);
+      // round up to the next page multiple and force progress
+      next = ((next + page_size_ - 1) / page_size_) * page_size_;
+      if (next <= size) next = size + page_size_;
+      size = next;
+    }
+    class_sizes_.push_back(kMaxPoolSize);
+    memory_pool_ = std::vector<std::vector<void*>>(class_sizes_.size());
+  }
+  /*!
+   * \brief Default destructor.
+   */
+  ~GPUPooledSizeClassStorageManager() {
+    ReleaseAll();
+  }
+
+  void Alloc(Storage::Handle* handle) override;
+  void Free(Storage::Handle handle) override;
+
+  void DirectFree(Storage::Handle handle) override {
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+    DirectFreeNoLock(handle);
+  }
+
+  void ReleaseAll() override;
+
+  size_t CachedBytes() override {
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+    return cached_bytes_;
+  }
+
+  size_t UsedBytes() override {
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+    return used_memory_ - cached_bytes_;
+  }
+
+  size_t FragmentationBytes() override {
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+    return frag_bytes_;
+  }
+
+  void SetCapBytes(size_t cap_bytes) override {
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+    cap_bytes_ = cap_bytes;
+  }
+
+  void Trim(size_t target_bytes) override;
+
+ private:
+  inline size_t get_bucket(size_t s) {
+    auto it = std::lower_bound(class_sizes_.begin(), class_sizes_.end(), s);
+    CHECK(it != class_sizes_.end())
+        << "Allocation of " << s << " bytes exceeds the maximum pooled size "
+        << kMaxPoolSize << ".";
+    return it - class_sizes_.begin();
+  }
+  inline size_t get_size(size_t bucket) {
+    return class_sizes_[bucket];
+  }
+
+  void DirectFreeNoLock(Storage::Handle handle) {
+    mxnet::common::cuda::DeviceStore device_store(handle.ctx.real_dev_id(), true);
+    cudaError_t err = cudaFree(handle.dptr);
+    size_t size = get_size(get_bucket(handle.size));
+    // ignore unloading error, as memory has already been recycled
+    if (err != cudaSuccess && err != cudaErrorCudartUnloading) {
+      LOG(FATAL) << "CUDA: " << cudaGetErrorString(err);
+    }
+    used_memory_ -= size;
+    frag_bytes_ -= size - handle.size;
+  }
+
+ private:
+  // number of devices
+  const size_t NDEV = 32;
+  // maximum pooled allocation size. 16GB
+  static constexpr size_t kMaxPoolSize = 1ul << 34;
+  // used memory
+  size_t used_memory_ = 0;
+  // memory held in the free pool
+  size_t cached_bytes_ = 0;
+  // bytes lost to size rounding across live allocations
+  size_t frag_bytes_ = 0;
+  // hard cap on device bytes held by this manager; 0 means no cap
+  size_t cap_bytes_;
+  // page size
+  size_t page_size_;
+  // percentage of reserved memory
+  int reserve_;
+  // context used by this Storage Manager
+  const Context initial_context_;
+  // precomputed size classes, ascending
+  std::vector<size_t> class_sizes_;
+  // memory pool, one free list per size class
+  std::vector<std::vector<void*>> memory_pool_;
+  DISALLOW_COPY_AND_ASSIGN(GPUPooledSizeClassStorageManager);
+};  // class GPUPooledSizeClassStorageManager
+
+void GPUPooledSizeClassStorageManager::Alloc(Storage::Handle* handle) {
+  // Set dptr to nullptr when handle size is 0.
+  if (handle->size == 0) {
+    handle->dptr = nullptr;
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+  const size_t bucket = get_bucket(handle->size);
+  const size_t size = get_size(bucket);
+  auto&& reuse_pool = memory_pool_[bucket];
+  if (reuse_pool.size() == 0) {
+    mxnet::common::cuda::DeviceStore device_store(handle->ctx.real_dev_id(), true);
+    size_t free, total;
+    cudaMemGetInfo(&free, &total);
+    if (free <= total * reserve_ / 100 || size > free - total * reserve_ / 100)
+      ReleaseAll();
+    if (cap_bytes_ != 0 && used_memory_ + size > cap_bytes_) {
+      ReleaseAll();
+      if (used_memory_ + size > cap_bytes_) {
+        LOG(FATAL) << "Allocation of " << size << " bytes would exceed the GPU memory "
+                   << "pool cap of " << cap_bytes_ << " bytes. See MXNET_GPU_MEM_POOL_CAP_MB "
+                   << "and MXStorageSetMemoryPoolCap.";
+      }
+    }
+
+    void* ret = nullptr;
+    cudaError_t e = cudaMalloc(&ret, size);
+    if (e != cudaSuccess) {
+      if (e == cudaErrorMemoryAllocation) {
+        ReleaseAll();
+        e = cudaMalloc(&ret, size);
+        if (e != cudaSuccess && e != cudaErrorCudartUnloading) {
+          LOG(FATAL) << "cudaMalloc retry failed: " << cudaGetErrorString(e);
+        }
+      } else if (e != cudaErrorCudartUnloading) {
+        LOG(FATAL) << "cudaMalloc failed: " << cudaGetErrorString(e);
+      }
+    }
+    used_memory_ += size;
+    handle->dptr = ret;
+    if (profiler::RuntimeStats::Get()->enabled()) {
+      profiler::RuntimeStats::Get()->PoolMiss();
+    }
+  } else {
+    auto ret = reuse_pool.back();
+    reuse_pool.pop_back();
+    cached_bytes_ -= size;
+    handle->dptr = ret;
+    if (profiler::RuntimeStats::Get()->enabled()) {
+      profiler::RuntimeStats::Get()->PoolHit();
+    }
+  }
+  frag_bytes_ += size - handle->size;
+}
+
+void GPUPooledSizeClassStorageManager::Free(Storage::Handle handle) {
+  // Do nothing if dptr is nullptr. Otherwise, nullptr may be reused
+  // which can cause illegal memory access error.
+  if (handle.dptr == nullptr) return;
+
+  std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+  const size_t bucket = get_bucket(handle.size);
+  memory_pool_[bucket].push_back(handle.dptr);
+  cached_bytes_ += get_size(bucket);
+  frag_bytes_ -= get_size(bucket) - handle.size;
+}
+
+void GPUPooledSizeClassStorageManager::ReleaseAll() {
+  for (size_t i = 0; i < memory_pool_.size(); i++) {
+    const size_t size = get_size(i);
+    for (auto& j : memory_pool_[i]) {
+      Storage::Handle handle;
+      handle.size = size;
+      handle.dptr = j;
+      handle.ctx = initial_context_;
+      DirectFreeNoLock(handle);
+    }
+    memory_pool_[i].clear();
+  }
+  cached_bytes_ = 0;
+}
+
+void GPUPooledSizeClassStorageManager::Trim(size_t target_bytes) {
+  std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+  for (size_t i = 0; i < memory_pool_.size(); i++) {
+    const size_t size = get_size(i);
+    auto&& reuse_pool = memory_pool_[i];
+    while (cached_bytes_ > target_bytes && !reuse_pool.empty()) {
+      Storage::Handle handle;
+      handle.size = size;
+      handle.dptr = reuse_pool.back();
+      handle.ctx = initial_context_;
+      reuse_pool.pop_back();
+      DirectFreeNoLock(handle);
+      cached_bytes_ -= size;
+    }
+    if (cached_bytes_ <= target_bytes) break;
+  }
+}
+
+/*!
+ * \brief Storage manager with a memory pool for pinned host memory.
+ *
+ * cudaHostAlloc pays page-locking and device registration cost on every
+ * call, which data pipelines hit once per batch when buffer sizes vary.
+ * Chunks are reused based on exact size match after rounding to the page
+ * size, mirroring GPUPooledStorageManager.
+ */
+class PinnedMemoryPooledStorageManager final : public StorageManager {
+ public:
+  /*!
+   * \brief Default constructor.
+   */
+  PinnedMemoryPooledStorageManager() {
+    page_size_ = dmlc::GetEnv("MXNET_CPU_PINNED_MEM_POOL_PAGE_SIZE", 4096);
+    if (page_size_ == 0) {
+      LOG(FATAL) << "MXNET_CPU_PINNED_MEM_POOL_PAGE_SIZE cannot be set to 0.";
+    }
+  }
+  /*!
+   * \brief Default destructor.
+   */
+  ~PinnedMemoryPooledStorageManager() {
+    ReleaseAll();
+  }
+
+  void Alloc(Storage::Handle* handle) override;
+  void Free(Storage::Handle handle) override;
+
+  void DirectFree(Storage::Handle handle) override {
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kCPU));
+    DirectFreeNoLock(handle);
+  }
+
+  void ReleaseAll() override;
+
+  size_t CachedBytes() override {
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kCPU));
+    return cached_bytes_;
+  }
+
+  size_t UsedBytes() override {
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kCPU));
+    return used_memory_ - cached_bytes_;
+  }
+
+  size_t FragmentationBytes() override {
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kCPU));
+    return frag_bytes_;
+  }
+
+  void Trim(size_t target_bytes) override;
+
+ private:
+  cudaError_t HostAllocNoLock(void** ret, size_t size, const Context& ctx) {
+#if MXNET_USE_NCCL
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+#endif  // MXNET_USE_NCCL
+    mxnet::common::cuda::DeviceStore device_store(ctx.real_dev_id(), true);
+    // make the memory available across all devices
+    return cudaHostAlloc(ret, size, cudaHostAllocPortable);
+  }
+
+  void DirectFreeNoLock(Storage::Handle handle) {
+#if MXNET_USE_NCCL
+    std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kGPU));
+#endif  // MXNET_USE_NCCL
+    mxnet::common::cuda::DeviceStore device_store(handle.ctx.real_dev_id(), true);
+    cudaError_t err = cudaFreeHost(handle.dptr);
+    size_t size = RoundToMultiple(handle.size, page_size_);
+    // ignore unloading error, as memory has already been recycled
+    if (err != cudaSuccess && err != cudaErrorCudartUnloading) {
+      LOG(FATAL) << "CUDA: " << cudaGetErrorString(err);
+    }
+    used_memory_ -= size;
+    frag_bytes_ -= size - handle.size;
+  }
+
+  // Round a value 'x' up to the next multiple of 'multiple'
+  size_t RoundToMultiple(size_t x, size_t multiple) {
+    return ((x + multiple - 1) / multiple) * multiple;
+  }
+
+ private:
+  // used memory
+  size_t used_memory_ = 0;
+  // memory held in the free pool
+  size_t cached_bytes_ = 0;
+  // bytes lost to size rounding across live allocations
+  size_t frag_bytes_ = 0;
+  // page size
+  size_t page_size_;
+  // memory pool
+  std::unordered_map<size_t, std::vector<void*>> memory_pool_;
+  DISALLOW_COPY_AND_ASSIGN(PinnedMemoryPooledStorageManager);
+};  // class PinnedMemoryPooledStorageManager
+
+void PinnedMemoryPooledStorageManager::Alloc(Storage::Handle* handle) {
+  // Set dptr to nullptr when handle size is 0.
+  if (handle->size == 0) {
+    handle->dptr = nullptr;
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kCPU));
+  size_t size = RoundToMultiple(handle->size, page_size_);
+  auto&& reuse_it = memory_pool_.find(size);
+  if (reuse_it == memory_pool_.end() || reuse_it->second.size() == 0) {
+    void* ret = nullptr;
+    cudaError_t e = HostAllocNoLock(&ret, size, handle->ctx);
+    if (e == cudaErrorMemoryAllocation) {
+      ReleaseAll();
+      e = HostAllocNoLock(&ret, size, handle->ctx);
+    }
+    if (e != cudaSuccess && e != cudaErrorCudartUnloading) {
+      LOG(FATAL) << "cudaHostAlloc failed: " << cudaGetErrorString(e);
+    }
+    used_memory_ += size;
+    handle->dptr = ret;
+    if (profiler::RuntimeStats::Get()->enabled()) {
+      profiler::RuntimeStats::Get()->PoolMiss();
+    }
+  } else {
+    auto&& reuse_pool = reuse_it->second;
+    auto ret = reuse_pool.back();
+    reuse_pool.pop_back();
+    cached_bytes_ -= size;
+    handle->dptr = ret;
+    if (profiler::RuntimeStats::Get()->enabled()) {
+      profiler::RuntimeStats::Get()->PoolHit();
+    }
+  }
+  frag_bytes_ += size - handle->size;
+}
+
+void PinnedMemoryPooledStorageManager::Free(Storage::Handle handle) {
+  // Do nothing if dptr is nullptr. Otherwise, nullptr may be reused
+  // which can cause illegal memory access error.
+  if (handle.dptr == nullptr) return;
+
+  std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kCPU));
+  size_t size = RoundToMultiple(handle.size, page_size_);
+  auto&& reuse_pool = memory_pool_[size];
+  reuse_pool.push_back(handle.dptr);
+  cached_bytes_ += size;
+  frag_bytes_ -= size - handle.size;
+}
+
+void PinnedMemoryPooledStorageManager::ReleaseAll() {
+  for (auto&& i : memory_pool_) {
+    for (auto&& j : i.second) {
+      Storage::Handle handle;
+      handle.dptr = j;
+      handle.size = i.first;
+      DirectFreeNoLock(handle);
+    }
+  }
+  memory_pool_.clear();
+  cached_bytes_ = 0;
+}
+
+void PinnedMemoryPooledStorageManager::Trim(size_t target_bytes) {
+  std::lock_guard<std::mutex> lock(Storage::Get()->GetMutex(Context::kCPU));
+  for (auto&& i : memory_pool_) {
+    auto&& reuse_pool = i.second;
+    while (cached_bytes_ > target_bytes && !reuse_pool.empty()) {
+      Storage::Handle handle;
+      handle.dptr = reuse_pool.back();
+      handle.size = i.first;
+      reuse_pool.pop_back();
+      DirectFreeNoLock(handle);
+      cached_bytes_ -= i.first;
+    }
+    if (cached_bytes_ <= target_bytes) break;
+  }
 }
 
 #endif  // MXNET_USE_CUDA
@@ -21,6 +21,10 @@
  * Copyright (c) 2015 by Contributors
  */
 #include <mxnet/storage.h>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+#include <unordered_map>
 #include "./storage_manager.h"
 #include "./naive_storage_manager.h"
 #include "./pooled_storage_manager.h"
@@ -28,8 +32,10 @@
 #include "./cpu_device_storage.h"
 #include "./gpu_device_storage.h"
 #include "./pinned_memory_storage.h"
+#include "./memory_budget.h"
 #include "../common/lazy_alloc_array.h"
 #include "../profiler/storage_profiler.h"
+#include "../profiler/runtime_stats.h"
 
 namespace mxnet {
 
@@ -40,30 +46,110 @@ class StorageImpl : public Storage {
   void Free(Handle handle) override;
   void DirectFree(Handle handle) override;
   void ReleaseAll(Context ctx) override;
+  void GetMemoryPoolStats(Context ctx, size_t* used_bytes, size_t* cached_bytes,
+                          size_t* fragmentation_bytes) override;
+  void SetMemoryPoolCap(Context ctx, size_t cap_bytes) override;
   void SharedIncrementRefCount(Handle handle) override;
-  StorageImpl() {}
-  virtual ~StorageImpl() = default;
+  StorageImpl() {
+#if MXNET_USE_CUDA
+    trim_high_watermark_ = static_cast<size_t>(
+        dmlc::GetEnv("MXNET_GPU_MEM_POOL_TRIM_HIGH_WATERMARK_MB", 0)) << 20;
+    trim_low_watermark_ = static_cast<size_t>(
+        dmlc::GetEnv("MXNET_GPU_MEM_POOL_TRIM_LOW_WATERMARK_MB", 0)) << 20;
+    trim_delay_sec_ = dmlc::GetEnv("MXNET_GPU_MEM_POOL_TRIM_DELAY_SEC", 10);
+    if (trim_high_watermark_ > 0) {
+      if (trim_low_watermark_ == 0) {
+        trim_low_watermark_ = trim_high_watermark_ / 2;
+      }
+      CHECK_LE(trim_low_watermark_, trim_high_watermark_)
+          << "MXNET_GPU_MEM_POOL_TRIM_LOW_WATERMARK_MB cannot exceed "
+          << "MXNET_GPU_MEM_POOL_TRIM_HIGH_WATERMARK_MB";
+      trimmer_ = std::thread(&StorageImpl::TrimLoop, this);
+    }
+#endif  // MXNET_USE_CUDA
+  }
+  virtual ~StorageImpl() {
+#if MXNET_USE_CUDA
+    if (trimmer_.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock(trim_mutex_);
+        trim_exit_ = true;
+      }
+      trim_cv_.notify_all();
+      trimmer_.join();
+    }
+#endif  // MXNET_USE_CUDA
+  }
 
  private:
   static constexpr size_t kMaxNumberOfDevices = Context::kMaxDevType + 1;
 #if MXNET_USE_CUDA
   static int num_gpu_device;
+
+  /*! \brief background loop releasing pooled GPU memory above the watermark */
+  void TrimLoop();
 #endif  // MXNET_USE_CUDA
 
+  /*! \brief key identifying a device across all device types */
+  static int64_t DevKey(const Context& ctx) {
+    return (static_cast<int64_t>(ctx.dev_type) << 32) | ctx.real_dev_id();
+  }
+
   // internal storage managers
   std::array<common::LazyAllocArray<storage::StorageManager>,
              kMaxNumberOfDevices> storage_managers_;
   storage::DeviceStorageProfiler profiler_;
+  // caps set through SetMemoryPoolCap before the manager existed,
+  // applied when the manager is created on first allocation
+  std::mutex pending_cap_mutex_;
+  std::unordered_map<int64_t, size_t> pending_cap_;
+#if MXNET_USE_CUDA
+  // per-device pooled bytes above which trimming kicks in; 0 disables it
+  size_t trim_high_watermark_;
+  // per-device pooled bytes the trimmer releases down to
+  size_t trim_low_watermark_;
+  // seconds a pool must stay above the high watermark before it is trimmed
+  int trim_delay_sec_;
+  std::mutex trim_mutex_;
+  std::condition_variable trim_cv_;
+  bool trim_exit_ = false;
+  std::thread trimmer_;
+#endif  // MXNET_USE_CUDA
 };  // struct Storage::Impl
 #if MXNET_USE_CUDA
 int StorageImpl::num_gpu_device = 0;
+
+void StorageImpl::TrimLoop() {
+  // time at which each device pool first exceeded the high watermark
+  std::unordered_map<size_t, std::chrono::steady_clock::time_point> above_since;
+  std::unique_lock<std::mutex> lock(trim_mutex_);
+  while (!trim_exit_) {
+    trim_cv_.wait_for(lock, std::chrono::seconds(1));
+    if (trim_exit_) break;
+    const auto now = std::chrono::steady_clock::now();
+    storage_managers_.at(Context::kGPU).ForEach(
+      [&](size_t i, storage::StorageManager *manager) {
+        if (manager->CachedBytes() <= trim_high_watermark_) {
+          above_since.erase(i);
+          return;
+        }
+        auto it = above_since.find(i);
+        if (it == above_since.end()) {
+          above_since[i] = now;
+        } else if (now - it->second >= std::chrono::seconds(trim_delay_sec_)) {
+          manager->Trim(trim_low_watermark_);
+          above_since.erase(it);
+        }
+      });
+  }
+}
 #endif  // MXNET_USE_CUDA
 
 void StorageImpl::Alloc(Storage::Handle* handle) {
   // space already recycled, ignore request
   auto&& device = storage_managers_.at(handle->ctx.dev_type);
   std::shared_ptr<storage::StorageManager> manager = device.Get(
-      handle->ctx.real_dev_id(), [handle]() {
+      handle->ctx.real_dev_id(), [handle, this]() {
         storage::StorageManager *ptr = nullptr;
         switch (handle->ctx.dev_type) {
           case Context::kCPU: {
@@ -86,7 +172,17 @@ void StorageImpl::Alloc(Storage::Handle* handle) {
               num_gpu_device = 0;
             }
             if (num_gpu_device > 0) {
-              ptr = new storage::NaiveStorageManager<storage::PinnedMemoryStorage>();
+              const std::string strategy =
+                  dmlc::GetEnv("MXNET_CPU_PINNED_MEM_POOL_TYPE", std::string("Unpooled"));
+              if (strategy == "Naive") {
+                ptr = new storage::PinnedMemoryPooledStorageManager();
+                LOG(INFO) << "Using PinnedMemoryPooledStorageManager.";
+              } else if (strategy == "Unpooled") {
+                ptr = new storage::NaiveStorageManager<storage::PinnedMemoryStorage>();
+              } else {
+                LOG(FATAL) << "Unknown pinned memory pool strategy specified: "
+                           << strategy << ".";
+              }
             } else {
               ptr = new storage::NaiveStorageManager<storage::CPUDeviceStorage>();
             }
@@ -108,10 +204,19 @@ void StorageImpl::Alloc(Storage::Handle* handle) {
             if (strategy == "Round") {
               ptr = new storage::GPUPooledRoundedStorageManager(handle->ctx);
               LOG(INFO) << "Using GPUPooledRoundedStorageManager.";
+            } else if (strategy == "SizeClass") {
+              ptr = new storage::GPUPooledSizeClassStorageManager(handle->ctx);
+              LOG(INFO) << "Using GPUPooledSizeClassStorageManager.";
             } else if (strategy == "Naive") {
               ptr = new storage::GPUPooledStorageManager(handle->ctx);
             } else if (strategy == "Unpooled") {
               ptr = new storage::NaiveStorageManager<storage::GPUDeviceStorage>();
+            } else if (strategy == "Managed") {
+              ptr = new storage::NaiveStorageManager<storage::GPUManagedDeviceStorage>();
+              LOG(INFO) << "Using CUDA managed (unified) memory for GPU storage.";
+            } else if (strategy == "Async") {
+              ptr = new storage::NaiveStorageManager<storage::GPUAsyncDeviceStorage>();
+              LOG(INFO) << "Using the CUDA stream-ordered allocator for GPU storage.";
             } else {
               LOG(FATAL) << "Unknown memory pool strategy specified: " << strategy << ".";
             }
@@ -122,11 +227,27 @@ void StorageImpl::Alloc(Storage::Handle* handle) {
           }
           default: LOG(FATAL) <<  "Unimplemented device " << handle->ctx.dev_type;
         }
+        {
+          std::lock_guard<std::mutex> lock(pending_cap_mutex_);
+          auto it = pending_cap_.find(DevKey(handle->ctx));
+          if (it != pending_cap_.end()) {
+            ptr->SetCapBytes(it->second);
+            pending_cap_.erase(it);
+          }
+        }
         return ptr;
       });
 
+  // charged before the manager is touched, so an over-budget request fails
+  // without consuming the device
+  storage::MemoryBudget::Charge(handle->size);
   manager->Alloc(handle);
+  storage::MemoryBudget::Commit(*handle);
   profiler_.OnAlloc(*handle);
+  profiler::RuntimeStats* stats = profiler::RuntimeStats::Get();
+  if (stats->enabled()) {
+    stats->RecordAlloc(handle->size);
+  }
 }
 
 void StorageImpl::Free(Storage::Handle handle) {
@@ -143,6 +264,7 @@ void StorageImpl::Free(Storage::Handle handle) {
       });
 
   manager->Free(handle);
+  storage::MemoryBudget::Refund(handle);
   profiler_.OnFree(handle);
 }
 
@@ -160,6 +282,7 @@ void StorageImpl::DirectFree(Storage::Handle handle) {
       });
 
   manager->DirectFree(handle);
+  storage::MemoryBudget::Refund(handle);
   profiler_.OnFree(handle);
 }
 
@@ -173,6 +296,31 @@ void StorageImpl::ReleaseAll(Context ctx) {
   manager->ReleaseAll();
 }
 
+void StorageImpl::GetMemoryPoolStats(Context ctx, size_t* used_bytes,
+                                     size_t* cached_bytes,
+                                     size_t* fragmentation_bytes) {
+  auto&& device = storage_managers_.at(ctx.dev_type);
+  // peek without creating the manager
+  std::shared_ptr<storage::StorageManager> manager = device.Get(
+      ctx.real_dev_id(), []() -> storage::StorageManager* { return nullptr; });
+  *used_bytes = manager ? manager->UsedBytes() : 0;
+  *cached_bytes = manager ? manager->CachedBytes() : 0;
+  *fragmentation_bytes = manager ? manager->FragmentationBytes() : 0;
+}
+
+void StorageImpl::SetMemoryPoolCap(Context ctx, size_t cap_bytes) {
+  auto&& device = storage_managers_.at(ctx.dev_type);
+  std::shared_ptr<storage::StorageManager> manager = device.Get(
+      ctx.real_dev_id(), []() -> storage::StorageManager* { return nullptr; });
+  if (manager) {
+    manager->SetCapBytes(cap_bytes);
+  } else {
+    // the manager does not exist yet; apply the cap when it is created
+    std::lock_guard<std::mutex> lock(pending_cap_mutex_);
+    pending_cap_[DevKey(ctx)] = cap_bytes;
+  }
+}
+
 void StorageImpl::SharedIncrementRefCount(Storage::Handle handle) {
   CHECK_EQ(handle.ctx.dev_type, Context::kCPUShared);
   auto&& device = storage_managers_.at(Context::kCPUShared);
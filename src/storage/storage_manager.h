@@ -60,6 +60,47 @@ class StorageManager {
   * For non-pool memory managers this has no effect.
   */
   virtual void ReleaseAll() {}
+  /*!
+   * \brief Number of bytes held in the free pool, waiting for reuse.
+   *
+   * Returns 0 for non-pool storage managers.
+   */
+  virtual size_t CachedBytes() {
+    return 0;
+  }
+  /*!
+   * \brief Number of bytes currently handed out to live allocations,
+   * including rounding overhead. Returns 0 for non-pool storage managers.
+   */
+  virtual size_t UsedBytes() {
+    return 0;
+  }
+  /*!
+   * \brief Bytes lost to size rounding across live allocations, i.e. the
+   * internal fragmentation of the pool. Returns 0 for non-pool storage
+   * managers.
+   */
+  virtual size_t FragmentationBytes() {
+    return 0;
+  }
+  /*!
+   * \brief Set a hard cap on the bytes this manager may hold from the
+   * device, pooled and live together. 0 removes the cap. For non-pool
+   * memory managers this has no effect.
+   *
+   * \param cap_bytes the cap in bytes
+   */
+  virtual void SetCapBytes(size_t cap_bytes) {}
+  /*!
+   * \brief Release cached memory until at most target_bytes remain pooled.
+   *
+   * Unlike ReleaseAll this keeps part of the pool warm, so it can be
+   * called periodically without destroying reuse. For non-pool memory
+   * managers this has no effect.
+   *
+   * \param target_bytes pooled bytes to keep
+   */
+  virtual void Trim(size_t target_bytes) {}
   /*!
    * \brief Destructor.
    */
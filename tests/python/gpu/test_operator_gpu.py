@@ -2076,6 +2076,23 @@ def test_cuda_rtc():
     assert (y.asnumpy() == 12).all()
 
 
+@with_seed()
+def test_cross_device_astype():
+    # cast and device transfer fused into one copy
+    for src_dtype, dst_dtype in [('float32', 'float16'), ('float16', 'float32'),
+                                 ('float32', 'int32')]:
+        x = mx.nd.array(np.random.uniform(-10, 10, (5, 7)).astype(src_dtype))
+        y = x.astype(dst_dtype, ctx=mx.gpu(0))
+        assert y.context == mx.gpu(0)
+        assert y.dtype == np.dtype(dst_dtype)
+        assert_almost_equal(y.asnumpy(), x.asnumpy().astype(dst_dtype))
+        # and back, casting on the device before the transfer
+        z = y.astype(src_dtype, ctx=mx.cpu(0))
+        assert z.context == mx.cpu(0)
+        assert z.dtype == np.dtype(src_dtype)
+        assert_almost_equal(z.asnumpy(), y.asnumpy().astype(src_dtype))
+
+
 @with_seed()
 def test_cross_device_autograd():
     x = mx.nd.random.uniform(shape=(10,))
@@ -341,6 +341,53 @@ def test_quantized_elemwise_add():
         check_quantized_elemwise_add((32, 56, 64, 11), qtype)
 
 
+@with_seed()
+def test_quantized_broadcast_add():
+    def check_quantized_broadcast_add(lhs_shape, rhs_shape):
+        if is_test_for_gpu():
+            print('skipped testing quantized_broadcast_add for gpu since it is not supported yet')
+            return
+
+        lhs = mx.sym.Variable(name='lhs', shape=lhs_shape, dtype='float32')
+        rhs = mx.sym.Variable(name='rhs', shape=rhs_shape, dtype='float32')
+        broadcast_add_fp32 = mx.sym.broadcast_add(lhs, rhs)
+        broadcast_add_fp32_exe = broadcast_add_fp32.simple_bind(ctx=mx.current_context(),
+                                                                grad_req='null')
+        lhs_val = mx.nd.random.uniform(low=-127.0, high=127.0, shape=lhs_shape).astype('int32')
+        rhs_val = mx.nd.random.uniform(low=-127.0, high=127.0, shape=rhs_shape).astype('int32')
+        broadcast_add_fp32_exe.arg_dict['lhs'][:] = lhs_val
+        broadcast_add_fp32_exe.arg_dict['rhs'][:] = rhs_val
+        output = broadcast_add_fp32_exe.forward()[0]
+
+        qlhs = mx.sym.Variable(name='qlhs', shape=lhs_shape, dtype='int8')
+        qrhs = mx.sym.Variable(name='qrhs', shape=rhs_shape, dtype='int8')
+        min_lhs = mx.sym.Variable(name='min_lhs')
+        max_lhs = mx.sym.Variable(name='max_lhs')
+        min_rhs = mx.sym.Variable(name='min_rhs')
+        max_rhs = mx.sym.Variable(name='max_rhs')
+        quantized_broadcast_add = mx.sym.contrib.quantized_broadcast_add(qlhs, qrhs, min_lhs,
+                                                                         max_lhs, min_rhs, max_rhs)
+        broadcast_add_int8_exe = quantized_broadcast_add.simple_bind(ctx=mx.current_context(),
+                                                                     grad_req='null')
+        broadcast_add_int8_exe.arg_dict['qlhs'][:] = lhs_val.astype('int8')
+        broadcast_add_int8_exe.arg_dict['qrhs'][:] = rhs_val.astype('int8')
+        broadcast_add_int8_exe.arg_dict['min_lhs'][:] = -127.0
+        broadcast_add_int8_exe.arg_dict['max_lhs'][:] = 127.0
+        broadcast_add_int8_exe.arg_dict['min_rhs'][:] = -127.0
+        broadcast_add_int8_exe.arg_dict['max_rhs'][:] = 127.0
+        qoutput, min_range, max_range = broadcast_add_int8_exe.forward()
+        max_val = max_range.asnumpy().tolist()[0]
+
+        fp32_rslt = output.asnumpy()
+        int8_rslt = qoutput.asnumpy() * max_val / 0x7fffffff
+        assert_almost_equal(int8_rslt, fp32_rslt, atol=1)
+
+    check_quantized_broadcast_add((4, 6), (4, 6))
+    check_quantized_broadcast_add((3, 4, 56, 56), (1, 4, 56, 56))
+    check_quantized_broadcast_add((3, 4, 56, 56), (3, 4, 1, 1))
+    check_quantized_broadcast_add((32, 56, 64, 11), (32, 1, 64, 11))
+
+
 @with_seed()
 def test_quantized_pooling():
     def check_quantized_pooling(data_shape, kernel, pool_type, pad, stride, global_pool, qdtype, convention='valid'):
@@ -1126,6 +1173,23 @@ def test_get_optimal_thresholds():
         assert_almost_equal(np.array([th_dict['layer1'][1]]), expected_threshold, rtol=1e-2, atol=1e-4)
 
 
+@with_seed()
+def test_quantile_sketch():
+    num_levels = 16
+    k = 128
+    sketch = mx.nd.zeros((num_levels + 1, k), dtype=np.float32)
+    data = mx.nd.uniform(low=-10.0, high=10.0, shape=(64, 1000), dtype=np.float32)
+    # stream the rows in separately to exercise the merge path
+    for i in range(data.shape[0]):
+        sketch = mx.nd.contrib.quantile_sketch_update(data[i], sketch)
+    quantiles = (0.01, 0.5, 0.99)
+    estimates = mx.nd.contrib.quantile_sketch_query(sketch, quantiles=quantiles).asnumpy()
+    expected = np.quantile(data.asnumpy(), quantiles)
+    # KLL rank error is O(1/k); allow a generous tolerance on the values
+    assert_almost_equal(estimates, expected, rtol=0.1, atol=0.5)
+    assert np.all(np.diff(estimates) >= 0)
+
+
 if __name__ == "__main__":
     import nose
     nose.runmodule()
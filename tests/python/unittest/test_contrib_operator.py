@@ -445,6 +445,134 @@ def test_modulated_deformable_convolution():
                             rtol, atol = 0.05, 1e-3
 
 
+def test_masked_softmax():
+    def ref_masked_softmax(data, mask, axis, temperature):
+        neg = np.full_like(data, -1e30)
+        masked = np.where(mask != 0, data / temperature, neg)
+        masked = masked - masked.max(axis=axis, keepdims=True)
+        e = np.exp(masked) * (mask != 0)
+        s = e.sum(axis=axis, keepdims=True)
+        with np.errstate(invalid='ignore'):
+            out = np.where(s > 0, e / s, np.zeros_like(e))
+        return out
+
+    for axis in [-1, 0, 1]:
+        for temperature in [1.0, 2.5]:
+            shape = (4, 5, 6)
+            data_np = np.random.randn(*shape).astype(np.float32)
+            mask_np = (np.random.rand(*shape) > 0.3).astype(np.int32)
+            # fully masked rows must come out as exact zeros
+            mask_np[0] = 0
+            expected = ref_masked_softmax(data_np, mask_np, axis, temperature)
+
+            out = mx.nd.contrib.masked_softmax(mx.nd.array(data_np),
+                                               mx.nd.array(mask_np),
+                                               axis=axis, temperature=temperature)
+            assert_almost_equal(out.asnumpy(), expected, rtol=1e-4, atol=1e-5)
+
+            # gradients match the composed where + softmax reference
+            data = mx.nd.array(data_np)
+            data.attach_grad()
+            with mx.autograd.record():
+                y = mx.nd.contrib.masked_softmax(data, mx.nd.array(mask_np),
+                                                 axis=axis, temperature=temperature)
+            ograd_np = np.random.randn(*shape).astype(np.float32)
+            y.backward(mx.nd.array(ograd_np))
+            s = np.sum(ograd_np * expected, axis=axis, keepdims=True)
+            backward_expected = expected * (ograd_np - s) / temperature
+            assert_almost_equal(data.grad.asnumpy(), backward_expected,
+                                rtol=1e-4, atol=1e-5)
+
+def test_interleaved_matmul_selfatt():
+    qlen, bsz, heads, hdim = 3, 2, 2, 4
+    embed = heads * hdim
+
+    def ref_qk(qkv):
+        tmp = qkv.reshape(qlen, bsz, heads, 3, hdim)
+        q = tmp[:, :, :, 0, :].reshape(qlen, bsz * heads, hdim)
+        k = tmp[:, :, :, 1, :].reshape(qlen, bsz * heads, hdim)
+        q = mx.nd.transpose(q, axes=(1, 0, 2))
+        k = mx.nd.transpose(k, axes=(1, 0, 2))
+        return mx.nd.batch_dot(q, k, transpose_b=True) / np.sqrt(hdim)
+
+    def ref_valatt(qkv, att):
+        tmp = qkv.reshape(qlen, bsz, heads, 3, hdim)
+        v = tmp[:, :, :, 2, :].reshape(qlen, bsz * heads, hdim)
+        v = mx.nd.transpose(v, axes=(1, 0, 2))
+        out = mx.nd.batch_dot(att, v)
+        out = mx.nd.transpose(out, axes=(1, 0, 2))
+        return out.reshape(qlen, bsz, embed)
+
+    qkv_np = np.random.rand(qlen, bsz, 3 * embed).astype(np.float32)
+    att_np = np.random.rand(bsz * heads, qlen, qlen).astype(np.float32)
+
+    # forward and backward of qk against the reshape/transpose/batch_dot chain
+    qkv, qkv_ref = mx.nd.array(qkv_np), mx.nd.array(qkv_np)
+    qkv.attach_grad()
+    qkv_ref.attach_grad()
+    with mx.autograd.record():
+        scores = mx.nd.contrib.interleaved_matmul_selfatt_qk(qkv, heads=heads)
+        scores_ref = ref_qk(qkv_ref)
+    assert_almost_equal(scores.asnumpy(), scores_ref.asnumpy(),
+                        rtol=1e-4, atol=1e-5)
+    ograd = mx.nd.array(np.random.rand(*scores.shape).astype(np.float32))
+    scores.backward(ograd)
+    scores_ref.backward(ograd)
+    assert_almost_equal(qkv.grad.asnumpy(), qkv_ref.grad.asnumpy(),
+                        rtol=1e-4, atol=1e-5)
+
+    # forward and backward of valatt
+    qkv, qkv_ref = mx.nd.array(qkv_np), mx.nd.array(qkv_np)
+    att, att_ref = mx.nd.array(att_np), mx.nd.array(att_np)
+    for arr in [qkv, qkv_ref, att, att_ref]:
+        arr.attach_grad()
+    with mx.autograd.record():
+        out = mx.nd.contrib.interleaved_matmul_selfatt_valatt(qkv, att,
+                                                              heads=heads)
+        out_ref = ref_valatt(qkv_ref, att_ref)
+    assert_almost_equal(out.asnumpy(), out_ref.asnumpy(), rtol=1e-4, atol=1e-5)
+    ograd = mx.nd.array(np.random.rand(*out.shape).astype(np.float32))
+    out.backward(ograd)
+    out_ref.backward(ograd)
+    assert_almost_equal(qkv.grad.asnumpy(), qkv_ref.grad.asnumpy(),
+                        rtol=1e-4, atol=1e-5)
+    assert_almost_equal(att.grad.asnumpy(), att_ref.grad.asnumpy(),
+                        rtol=1e-4, atol=1e-5)
+
+@with_seed()
+def test_kv_cache_ops():
+    batch, max_len, dim = 2, 16, 8
+    key_cache = mx.nd.zeros((batch, max_len, dim))
+    value_cache = mx.nd.zeros((batch, max_len, dim))
+    keys_np = np.random.rand(batch, max_len, dim).astype(np.float32)
+    values_np = np.random.rand(batch, max_len, dim).astype(np.float32)
+
+    # append one step at a time and attend over the filled prefix
+    for step in range(max_len):
+        key_cache = mx.nd.contrib.kv_cache_append(
+            key_cache, mx.nd.array(keys_np[:, step:step+1, :]), position=step)
+        value_cache = mx.nd.contrib.kv_cache_append(
+            value_cache, mx.nd.array(values_np[:, step:step+1, :]), position=step)
+    assert_almost_equal(key_cache.asnumpy(), keys_np)
+    assert_almost_equal(value_cache.asnumpy(), values_np)
+
+    query_np = np.random.rand(batch, 1, dim).astype(np.float32)
+    for valid in [1, max_len // 2, max_len]:
+        out = mx.nd.contrib.kv_cache_attend(
+            mx.nd.array(query_np), key_cache, value_cache, valid_length=valid)
+        scores = np.matmul(query_np, keys_np[:, :valid, :].transpose(0, 2, 1))
+        scores /= np.sqrt(dim)
+        scores = np.exp(scores - scores.max(axis=-1, keepdims=True))
+        scores /= scores.sum(axis=-1, keepdims=True)
+        expected = np.matmul(scores, values_np[:, :valid, :])
+        assert_almost_equal(out.asnumpy(), expected, rtol=1e-5, atol=1e-6)
+
+    # appending a multi-step chunk matches per-step appends
+    chunk_cache = mx.nd.zeros((batch, max_len, dim))
+    chunk_cache = mx.nd.contrib.kv_cache_append(
+        chunk_cache, mx.nd.array(keys_np[:, :4, :]), position=0)
+    assert_almost_equal(chunk_cache.asnumpy()[:, :4, :], keys_np[:, :4, :])
+
 if __name__ == '__main__':
     import nose
     nose.runmodule()
@@ -165,6 +165,29 @@ def test_reshape():
     assert np.all(new_exe.arg_arrays[1].asnumpy() == 1)
 
 
+@with_seed()
+def test_row_sparse_pull_plan():
+    # weight consumed only through its index input -> plannable
+    data = mx.sym.Variable('data')
+    weight = mx.sym.Variable('weight', stype='row_sparse')
+    embed = mx.sym.sparse.Embedding(data=data, weight=weight,
+                                    input_dim=10, output_dim=4)
+    exe = embed.simple_bind(mx.cpu(), data=(5,), grad_req='null')
+    assert exe.row_sparse_pull_plan() == {'weight': 'data'}
+
+    # a second consumer that reads all rows disqualifies the parameter
+    out = embed + mx.sym.sum(mx.sym.sparse.cast_storage(weight, 'default'))
+    exe = out.simple_bind(mx.cpu(), data=(5,), grad_req='null')
+    assert exe.row_sparse_pull_plan() == {}
+
+    # dense parameters never appear in the plan
+    dense_weight = mx.sym.Variable('dense_weight')
+    embed = mx.sym.Embedding(data=data, weight=dense_weight,
+                             input_dim=10, output_dim=4)
+    exe = embed.simple_bind(mx.cpu(), data=(5,), grad_req='null')
+    assert exe.row_sparse_pull_plan() == {}
+
+
 if __name__ == "__main__":
     import nose
     nose.runmodule()
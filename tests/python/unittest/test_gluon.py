@@ -1703,6 +1703,28 @@ def test_hybrid_static_memory_switching():
     check_hybrid_static_memory_switching(static_alloc=True)
     check_hybrid_static_memory_switching(static_alloc=True, static_shape=True)
 
+@with_seed()
+def test_hybrid_memory_budget():
+    net = nn.HybridSequential()
+    with net.name_scope():
+        net.add(nn.Dense(64), nn.Dense(64))
+    net.initialize()
+    x = mx.nd.random.uniform(shape=(8, 32))
+    expected = net(x).asnumpy()
+
+    # a generous budget leaves the result alone
+    net.hybridize(mem_budget=1 << 30)
+    assert_almost_equal(net(x).asnumpy(), expected)
+
+    # a call that allocates past its budget fails without taking down the
+    # process
+    net.hybridize(mem_budget=16)
+    assert_raises(mx.base.MXNetError, lambda: net(x).asnumpy())
+
+    # the process stays usable after the failed call
+    net.hybridize(mem_budget=1 << 30)
+    assert_almost_equal(net(x).asnumpy(), expected)
+
 @with_seed()
 def test_hook():
     global hook_call_count
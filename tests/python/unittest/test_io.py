@@ -443,6 +443,51 @@ def test_CSVIter():
     for dtype in ['int32', 'int64', 'float32']:
         check_CSVIter_synthetic(dtype=dtype)
 
+def test_ColumnarIter():
+    import struct
+    dtype_flags = {'float32': 0, 'int32': 4, 'int64': 6}
+
+    def write_columnar(path, data, label, widths, rows_per_page, dtype):
+        num_rows = data.shape[0]
+        with open(path, 'wb') as fout:
+            fout.write(struct.pack('<IIQIIII', 0x4D584346, 1, num_rows,
+                                   len(widths), rows_per_page, label.shape[1],
+                                   dtype_flags[dtype]))
+            for width in widths:
+                fout.write(struct.pack('<I', width))
+            cols = np.split(data, np.cumsum(widths)[:-1], axis=1)
+            for start in range(0, num_rows, rows_per_page):
+                end = min(start + rows_per_page, num_rows)
+                for col in cols:
+                    page = np.ascontiguousarray(col[start:end]).tobytes()
+                    fout.write(struct.pack('<IQ', 0, len(page)) + page)
+                page = np.ascontiguousarray(label[start:end]).tobytes()
+                fout.write(struct.pack('<IQ', 0, len(page)) + page)
+
+    def check_ColumnarIter_synthetic(dtype='float32'):
+        path = os.path.join(os.getcwd(), 'data.mxcf')
+        widths = [3, 1, 4]
+        num_rows, rows_per_page, batch_size = 250, 64, 50
+        data = np.arange(num_rows * sum(widths)).reshape(
+            (num_rows, sum(widths))).astype(dtype)
+        label = np.arange(num_rows).astype('float32').reshape((num_rows, 1))
+        write_columnar(path, data, label, widths, rows_per_page, dtype)
+
+        data_train = mx.io.ColumnarIter(path=path, batch_size=batch_size)
+        num_batches = 0
+        for batch in iter(data_train):
+            start = num_batches * batch_size
+            data_batch = batch.data[0].asnumpy()
+            assert data_batch.dtype == data.dtype
+            assert_almost_equal(data_batch, data[start:start + batch_size])
+            assert_almost_equal(batch.label[0].asnumpy(),
+                                label[start:start + batch_size])
+            num_batches += 1
+        assert num_batches == num_rows // batch_size
+
+    for dtype in ['float32', 'int32', 'int64']:
+        check_ColumnarIter_synthetic(dtype=dtype)
+
 def test_ImageRecordIter_seed_augmentation():
     get_cifar10()
     seed_aug = 3
@@ -1698,6 +1698,18 @@ def test_ndarray_astype():
     y = x.astype(np.int32, copy=False)
     assert (id(x) == id(y))
 
+    # Test the fused cast+copy with an explicit target context
+    x = mx.nd.arange(0, 6, dtype='int32').reshape((2, 3))
+    y = x.astype('float32', ctx=x.context)
+    assert (y.dtype == np.float32)
+    assert (y.context == x.context)
+    assert same(x.asnumpy().astype(np.float32), y.asnumpy())
+
+    # same dtype and context with copy=False returns the array itself
+    x = mx.nd.zeros((2, 3), dtype='int32')
+    y = x.astype('int32', copy=False, ctx=x.context)
+    assert (id(x) == id(y))
+
 
 @with_seed()
 def test_norm(ctx=default_context()):
@@ -1221,6 +1221,109 @@ def test_adadelta():
                 kwarg.update({'multi_precision': True})
             compare_optimizer(opt1(**kwarg), opt2(**kwarg), shape, dtype)
 
+@with_seed()
+def test_mp_adam_update():
+    shape = (3, 4, 5)
+    kwargs = {'lr': 0.1, 'beta1': 0.9, 'beta2': 0.999, 'epsilon': 1e-8,
+              'wd': 0.01, 'rescale_grad': 0.5, 'clip_gradient': 0.4}
+    weight32 = mx.nd.random.uniform(-1.0, 1.0, shape)
+    weight16 = weight32.astype('float16')
+    grad16 = mx.nd.random.uniform(-1.0, 1.0, shape).astype('float16')
+    mean = mx.nd.zeros(shape)
+    var = mx.nd.zeros(shape)
+    ref_weight = weight32.copy()
+    ref_mean = mean.copy()
+    ref_var = var.copy()
+
+    out16 = mx.nd.mp_adam_update(weight16, grad16, mean, var, weight32, **kwargs)
+    ref_out = mx.nd.adam_update(ref_weight, grad16.astype('float32'),
+                                ref_mean, ref_var, **kwargs)
+
+    assert_almost_equal(weight32.asnumpy(), ref_out.asnumpy(), rtol=1e-5, atol=1e-5)
+    assert_almost_equal(mean.asnumpy(), ref_mean.asnumpy(), rtol=1e-5, atol=1e-5)
+    assert_almost_equal(var.asnumpy(), ref_var.asnumpy(), rtol=1e-5, atol=1e-5)
+    assert_almost_equal(out16.asnumpy(), ref_out.astype('float16').asnumpy(),
+                        rtol=1e-3, atol=1e-3)
+
+@with_seed()
+def test_multi_adam_update():
+    def flatten(groups):
+        return [arr for group in groups for arr in group]
+
+    kwargs = {'beta1': 0.9, 'beta2': 0.999, 'epsilon': 1e-8,
+              'rescale_grad': 0.5, 'clip_gradient': 0.4}
+
+    def check_multi_adam(num_weights, dtype):
+        shapes = [(np.random.randint(1, 5), np.random.randint(1, 5))
+                  for _ in range(num_weights)]
+        lrs = tuple(0.1 * ((i % 3) + 1) for i in range(num_weights))
+        wds = tuple(0.01 * (i % 2) for i in range(num_weights))
+        weights = [mx.nd.random.uniform(-1.0, 1.0, s).astype(dtype) for s in shapes]
+        grads = [mx.nd.random.uniform(-1.0, 1.0, s).astype(dtype) for s in shapes]
+        means = [mx.nd.zeros(s, dtype=dtype) for s in shapes]
+        variances = [mx.nd.zeros(s, dtype=dtype) for s in shapes]
+        ref_weights = [w.copy() for w in weights]
+        ref_means = [m.copy() for m in means]
+        ref_vars = [v.copy() for v in variances]
+
+        mx.nd.multi_adam_update(*flatten(zip(weights, grads, means, variances)),
+                                out=weights, num_weights=num_weights,
+                                lrs=lrs, wds=wds, **kwargs)
+        for i in range(num_weights):
+            mx.nd.adam_update(ref_weights[i], grads[i], ref_means[i], ref_vars[i],
+                              out=ref_weights[i], lr=lrs[i], wd=wds[i], **kwargs)
+
+        rtol, atol = (1e-3, 1e-3) if dtype == 'float16' else (1e-5, 1e-6)
+        for i in range(num_weights):
+            assert_almost_equal(weights[i].asnumpy(), ref_weights[i].asnumpy(),
+                                rtol=rtol, atol=atol)
+            assert_almost_equal(means[i].asnumpy(), ref_means[i].asnumpy(),
+                                rtol=rtol, atol=atol)
+            assert_almost_equal(variances[i].asnumpy(), ref_vars[i].asnumpy(),
+                                rtol=rtol, atol=atol)
+
+    def check_multi_mp_adam(num_weights):
+        shapes = [(np.random.randint(1, 5), np.random.randint(1, 5))
+                  for _ in range(num_weights)]
+        lrs = tuple(0.1 * ((i % 3) + 1) for i in range(num_weights))
+        wds = tuple(0.01 * (i % 2) for i in range(num_weights))
+        weights32 = [mx.nd.random.uniform(-1.0, 1.0, s) for s in shapes]
+        weights16 = [w.astype('float16') for w in weights32]
+        grads16 = [mx.nd.random.uniform(-1.0, 1.0, s).astype('float16')
+                   for s in shapes]
+        means = [mx.nd.zeros(s) for s in shapes]
+        variances = [mx.nd.zeros(s) for s in shapes]
+        ref_weights = [w.copy() for w in weights32]
+        ref_means = [m.copy() for m in means]
+        ref_vars = [v.copy() for v in variances]
+
+        mx.nd.multi_mp_adam_update(
+            *flatten(zip(weights16, grads16, means, variances, weights32)),
+            out=weights16, num_weights=num_weights, lrs=lrs, wds=wds, **kwargs)
+        for i in range(num_weights):
+            mx.nd.adam_update(ref_weights[i], grads16[i].astype('float32'),
+                              ref_means[i], ref_vars[i], out=ref_weights[i],
+                              lr=lrs[i], wd=wds[i], **kwargs)
+
+        for i in range(num_weights):
+            assert_almost_equal(weights32[i].asnumpy(), ref_weights[i].asnumpy(),
+                                rtol=1e-5, atol=1e-5)
+            assert_almost_equal(means[i].asnumpy(), ref_means[i].asnumpy(),
+                                rtol=1e-5, atol=1e-5)
+            assert_almost_equal(variances[i].asnumpy(), ref_vars[i].asnumpy(),
+                                rtol=1e-5, atol=1e-5)
+            assert_almost_equal(weights16[i].asnumpy(),
+                                ref_weights[i].astype('float16').asnumpy(),
+                                rtol=1e-3, atol=1e-3)
+
+    # 70 weights exercises the chained launches above the 60-tensor
+    # per-kernel limit
+    for num_weights in [1, 5, 70]:
+        check_multi_adam(num_weights, 'float32')
+        check_multi_mp_adam(num_weights)
+    for dtype in ['float16', 'float64']:
+        check_multi_adam(5, dtype)
+
 
 def test_factor_scheduler():
     base_lr = 1